@@ -0,0 +1,104 @@
+﻿/*!
+* \file BindBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Benchmarks binding and unbinding columns and parameters.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/ColumnBuffer.h"
+#include "exodbc/SpecializedExceptions.h"
+#include "boost/format.hpp"
+
+// System headers
+#include <vector>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace std;
+using namespace exodbc;
+using namespace exodbctest;
+
+namespace exodbcbench
+{
+	// Bind and unbind the 4 columns of integertypes
+	BENCHMARK_DEFINE_F(DbFixture, BindUnbindColumns)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		try
+		{
+			string sql = boost::str(boost::format(u8"SELECT * FROM %s") % PrependSchemaOrCatalogName(m_pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES)));
+			ExecutableStatement stmt(m_pDb);
+			stmt.Prepare(sql);
+			vector<ColumnBufferPtrVariant> columns;
+			for (SQLUSMALLINT i = 0; i < 4; ++i)
+			{
+				columns.push_back(LongColumnBuffer::Create(u8"", SQL_INTEGER));
+			}
+			for (auto _ : state)
+			{
+				for (SQLUSMALLINT i = 0; i < columns.size(); ++i)
+				{
+					stmt.BindColumn(columns[i], i + 1);
+				}
+				stmt.UnbindColumns();
+			}
+			state.SetItemsProcessed(state.iterations() * columns.size());
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, BindUnbindColumns);
+
+
+	// Bind and unbind the 4 parameters of an insert into integertypes_tmp. If state.range(0)
+	// is 0, the parameter descriptions are queried from the driver.
+	BENCHMARK_DEFINE_F(DbFixture, BindUnbindParams)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		bool neverQueryParamDesc = state.range(0) != 0;
+		state.SetLabel(neverQueryParamDesc ? u8"neverQueryParamDesc" : u8"describeParam");
+		try
+		{
+			string sql = boost::str(boost::format(u8"INSERT INTO %s VALUES(?, ?, ?, ?)") % PrependSchemaOrCatalogName(m_pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES_TMP)));
+			ExecutableStatement stmt(m_pDb);
+			stmt.Prepare(sql);
+			vector<ColumnBufferPtrVariant> params;
+			params.push_back(LongColumnBuffer::Create(u8"", SQL_INTEGER));
+			params.push_back(ShortColumnBuffer::Create(u8"", SQL_SMALLINT));
+			params.push_back(LongColumnBuffer::Create(u8"", SQL_INTEGER));
+			params.push_back(BigIntColumnBuffer::Create(u8"", SQL_BIGINT));
+			for (auto _ : state)
+			{
+				for (SQLUSMALLINT i = 0; i < params.size(); ++i)
+				{
+					stmt.BindParameter(params[i], i + 1, neverQueryParamDesc);
+				}
+				stmt.UnbindParams();
+			}
+			state.SetItemsProcessed(state.iterations() * params.size());
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, BindUnbindParams)->Arg(0)->Arg(1);
+}
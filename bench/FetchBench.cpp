@@ -0,0 +1,149 @@
+﻿/*!
+* \file FetchBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Benchmarks fetching result sets, per column type.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/RowRange.h"
+#include "exodbc/SpecializedExceptions.h"
+#include "boost/format.hpp"
+
+// Debug
+#include "DebugNew.h"
+
+using namespace std;
+using namespace exodbc;
+using namespace exodbctest;
+
+namespace exodbcbench
+{
+	// Select all rows of a table, using the ColumnBuffers created by Table::Open()
+	BENCHMARK_DEFINE_F(DbFixture, FetchTable)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		TableId tableId = (TableId)state.range(0);
+		state.SetLabel(GetTableName(tableId));
+		try
+		{
+			Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(tableId));
+			table.Open(TableOpenFlag::TOF_CHECK_EXISTANCE | TableOpenFlag::TOF_SKIP_UNSUPPORTED_COLUMNS);
+			int64_t rows = 0;
+			for (auto _ : state)
+			{
+				table.Select();
+				while (table.SelectNext())
+				{
+					++rows;
+				}
+				table.SelectClose();
+			}
+			state.SetItemsProcessed(rows);
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, FetchTable)
+		->Arg((int64_t)TableId::INTEGERTYPES)
+		->Arg((int64_t)TableId::FLOATTYPES)
+		->Arg((int64_t)TableId::NUMERICTYPES)
+		->Arg((int64_t)TableId::CHARTYPES)
+		->Arg((int64_t)TableId::DATETYPES)
+		->Arg((int64_t)TableId::BLOBTYPES)
+		->Arg((int64_t)TableId::UNICODE_TABLE);
+
+
+	// Fetch the id column of a table using RowRange with different block sizes
+	BENCHMARK_DEFINE_F(DbFixture, FetchRows)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		SQLULEN blockSize = (SQLULEN)state.range(0);
+		try
+		{
+			string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+			string sql = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % PrependSchemaOrCatalogName(m_pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES)));
+			ExecutableStatement stmt(m_pDb);
+			int64_t rows = 0;
+			for (auto _ : state)
+			{
+				stmt.ExecuteDirect(sql);
+				for (const RowView& row : stmt.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, blockSize))
+				{
+					benchmark::DoNotOptimize(row);
+					++rows;
+				}
+			}
+			state.SetItemsProcessed(rows);
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, FetchRows)->Arg(1)->Arg(4)->Arg(64);
+
+
+	// Fetch the id column of a table using the read-only cursor profiles, one row per fetch
+	BENCHMARK_DEFINE_F(DbFixture, FetchCursorProfile)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		CursorType type = (CursorType)state.range(0);
+		CursorProfile profile(type, CursorConcurrency::READ_ONLY);
+		state.SetLabel(profile.ToString());
+		if (!m_pDb->GetSupportsCursorProfile(profile))
+		{
+			state.SkipWithError(u8"Cursor profile not supported by the Database");
+			return;
+		}
+		try
+		{
+			string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+			string sql = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % PrependSchemaOrCatalogName(m_pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES)));
+			LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_UNKNOWN_TYPE);
+			ExecutableStatement stmt(m_pDb, profile);
+			stmt.BindColumn(pIdCol, 1);
+			int64_t rows = 0;
+			for (auto _ : state)
+			{
+				stmt.ExecuteDirect(sql);
+				while (stmt.SelectNext())
+				{
+					benchmark::DoNotOptimize(pIdCol->GetValue());
+					++rows;
+				}
+				stmt.SelectClose();
+			}
+			state.SetItemsProcessed(rows);
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, FetchCursorProfile)
+		->Arg((int64_t)CursorType::FORWARD_ONLY)
+		->Arg((int64_t)CursorType::STATIC)
+		->Arg((int64_t)CursorType::KEYSET_DRIVEN)
+		->Arg((int64_t)CursorType::DYNAMIC);
+}
@@ -0,0 +1,107 @@
+﻿/*!
+* \file ModifyBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Benchmarks inserting and updating rows.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/SpecializedExceptions.h"
+
+// Debug
+#include "DebugNew.h"
+
+using namespace std;
+using namespace exodbc;
+using namespace exodbctest;
+
+namespace exodbcbench
+{
+	// Insert one row per iteration, committing every state.range(0) rows
+	BENCHMARK_DEFINE_F(DbFixture, Insert)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		int64_t commitEvery = state.range(0);
+		try
+		{
+			ClearTmpTable(TableId::INTEGERTYPES_TMP);
+			Table table(m_pDb, TableAccessFlag::AF_INSERT, GetTableName(TableId::INTEGERTYPES_TMP));
+			table.Open();
+			LongColumnBufferPtr pId = table.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			LongColumnBufferPtr pInt = table.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+			int64_t rows = 0;
+			for (auto _ : state)
+			{
+				++rows;
+				pId->SetValue((SQLINTEGER)rows);
+				pInt->SetValue((SQLINTEGER)rows);
+				table.Insert();
+				if (rows % commitEvery == 0)
+				{
+					m_pDb->CommitTrans();
+				}
+			}
+			m_pDb->CommitTrans();
+			state.SetItemsProcessed(rows);
+			ClearTmpTable(TableId::INTEGERTYPES_TMP);
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, Insert)->Arg(1)->Arg(100);
+
+
+	// Update one row by its primary key per iteration
+	BENCHMARK_DEFINE_F(DbFixture, UpdateByPk)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		try
+		{
+			ClearTmpTable(TableId::INTEGERTYPES_TMP);
+			string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+			{
+				Table table(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+				table.Open();
+				table.GetColumnBufferPtr<LongColumnBufferPtr>(0)->SetValue(1);
+				table.GetColumnBufferPtr<LongColumnBufferPtr>(2)->SetValue(0);
+				table.Insert();
+				m_pDb->CommitTrans();
+			}
+			Table table(m_pDb, TableAccessFlag::AF_UPDATE_PK, tableName);
+			table.Open();
+			LongColumnBufferPtr pId = table.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			LongColumnBufferPtr pInt = table.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+			pId->SetValue(1);
+			SQLINTEGER value = 0;
+			for (auto _ : state)
+			{
+				pInt->SetValue(++value);
+				table.UpdateByPkValues();
+				m_pDb->CommitTrans();
+			}
+			state.SetItemsProcessed(state.iterations());
+			ClearTmpTable(TableId::INTEGERTYPES_TMP);
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, UpdateByPk);
+}
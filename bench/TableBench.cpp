@@ -0,0 +1,140 @@
+﻿/*!
+* \file TableBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Benchmarks opening Tables and reading the catalog.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/DatabaseCatalog.h"
+#include "exodbc/SpecializedExceptions.h"
+
+// Debug
+#include "DebugNew.h"
+
+using namespace std;
+using namespace exodbc;
+using namespace exodbctest;
+
+namespace exodbcbench
+{
+	// Construct and Open() a Table, state.range(0) selects the TableOpenFlags
+	BENCHMARK_DEFINE_F(DbFixture, OpenTable)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		TableOpenFlags openFlags = TableOpenFlag::TOF_CHECK_EXISTANCE;
+		TableAccessFlags accessFlags = TableAccessFlag::AF_READ;
+		switch (state.range(0))
+		{
+		case 0:
+			state.SetLabel(u8"checkExistance");
+			break;
+		case 1:
+			state.SetLabel(u8"readWithoutPk");
+			accessFlags = TableAccessFlag::AF_READ_WITHOUT_PK;
+			break;
+		case 2:
+			state.SetLabel(u8"checkDbTypeInfos");
+			openFlags = TableOpenFlag::TOF_CHECK_EXISTANCE | TableOpenFlag::TOF_CHECK_DB_TYPE_INFOS;
+			break;
+		default:
+			state.SetLabel(u8"readWrite");
+			accessFlags = TableAccessFlag::AF_READ_WRITE;
+			break;
+		}
+		try
+		{
+			string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+			for (auto _ : state)
+			{
+				Table table(m_pDb, accessFlags, tableName);
+				table.Open(openFlags);
+			}
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, OpenTable)->DenseRange(0, 3);
+
+
+	BENCHMARK_DEFINE_F(DbFixture, SearchTables)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		try
+		{
+			DatabaseCatalogPtr pCatalog = m_pDb->GetDbCatalog();
+			string tableName = GetTableName(TableId::INTEGERTYPES);
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(pCatalog->SearchTables(tableName));
+			}
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, SearchTables);
+
+
+	BENCHMARK_DEFINE_F(DbFixture, ReadColumnInfo)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		try
+		{
+			DatabaseCatalogPtr pCatalog = m_pDb->GetDbCatalog();
+			TableInfo tableInfo = pCatalog->FindOneTable(GetTableName(TableId::CHARTYPES));
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(pCatalog->ReadColumnInfo(tableInfo));
+			}
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, ReadColumnInfo);
+
+
+	BENCHMARK_DEFINE_F(DbFixture, ReadPrimaryKeyInfo)(benchmark::State& state)
+	{
+		if (!CheckDb(state))
+		{
+			return;
+		}
+		try
+		{
+			DatabaseCatalogPtr pCatalog = m_pDb->GetDbCatalog();
+			TableInfo tableInfo = pCatalog->FindOneTable(GetTableName(TableId::MULTIKEY));
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(pCatalog->ReadPrimaryKeyInfo(tableInfo));
+			}
+		}
+		catch (const Exception& ex)
+		{
+			state.SkipWithError(ex.ToString().c_str());
+		}
+	}
+	BENCHMARK_REGISTER_F(DbFixture, ReadPrimaryKeyInfo);
+}
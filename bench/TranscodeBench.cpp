@@ -0,0 +1,71 @@
+﻿/*!
+* \file TranscodeBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Benchmarks converting strings between UTF-8 and UTF-16. No database is required.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/exOdbc.h"
+
+// System headers
+#include <string>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace std;
+using namespace exodbc;
+
+namespace exodbcbench
+{
+	namespace
+	{
+		/*!
+		* \brief	A UTF-8 string of length characters, non-ASCII if ascii is false.
+		*/
+		string CreateUtf8(int64_t length, bool ascii)
+		{
+			const wstring pattern = ascii ? L"abcdefghij" : L"\u00e4\u00f6\u00fc\u20ac\u4e2d";
+			wstring ws;
+			while (ws.length() < (size_t)length)
+			{
+				ws += pattern;
+			}
+			ws.resize((size_t)length);
+			return utf16ToUtf8(ws);
+		}
+	}
+
+
+	// state.range(0) is the length in characters, state.range(1) is 1 for ASCII only
+	void Utf8ToUtf16(benchmark::State& state)
+	{
+		string s = CreateUtf8(state.range(0), state.range(1) != 0);
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(utf8ToUtf16(s));
+		}
+		state.SetBytesProcessed(state.iterations() * s.length());
+	}
+	BENCHMARK(Utf8ToUtf16)->ArgNames({ u8"length", u8"ascii" })->ArgsProduct({ { 8, 128, 4096 }, { 0, 1 } });
+
+
+	void Utf16ToUtf8(benchmark::State& state)
+	{
+		wstring ws = utf8ToUtf16(CreateUtf8(state.range(0), state.range(1) != 0));
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(utf16ToUtf8(ws));
+		}
+		state.SetBytesProcessed(state.iterations() * ws.length() * sizeof(wchar_t));
+	}
+	BENCHMARK(Utf16ToUtf8)->ArgNames({ u8"length", u8"ascii" })->ArgsProduct({ { 8, 128, 4096 }, { 0, 1 } });
+}
@@ -0,0 +1,225 @@
+﻿/*!
+* \file exOdbcBench.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Defines the entry point for the benchmark application.
+*/
+
+// Own header
+#include "exOdbcBench.h"
+
+// Same component headers
+
+// Other headers
+#include "exodbc/LogManager.h"
+#include "exodbc/SpecializedExceptions.h"
+#include "boost/filesystem.hpp"
+#include "boost/format.hpp"
+#include "boost/algorithm/string.hpp"
+
+// System headers
+#include <vector>
+#include <string>
+
+// Debug
+#include "DebugNew.h"
+
+// Globals
+// -------
+namespace exodbctest
+{
+	// Read by the helpers shared with exodbctest, like OpenTestDb()
+	TestParams g_odbcInfo;
+}
+
+using namespace std;
+using namespace exodbc;
+using namespace exodbctest;
+
+namespace exodbcbench
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void DbFixture::SetUp(const benchmark::State& state)
+	{
+		m_error.clear();
+		if (!g_odbcInfo.IsUsable())
+		{
+			m_error = u8"No DSN or connection string configured";
+			return;
+		}
+		try
+		{
+			m_pEnv = CreateEnv(OdbcVersion::V_3);
+			m_pDb = OpenTestDb(m_pEnv);
+		}
+		catch (const Exception& ex)
+		{
+			m_pDb.reset();
+			m_error = ex.ToString();
+		}
+	}
+
+
+	void DbFixture::TearDown(const benchmark::State& state)
+	{
+		m_pDb.reset();
+		m_pEnv.reset();
+	}
+
+
+	bool DbFixture::CheckDb(benchmark::State& state)
+	{
+		if (!m_pDb)
+		{
+			state.SkipWithError(m_error.c_str());
+			return false;
+		}
+		return true;
+	}
+}
+
+
+void printHelp()
+{
+	WRITE_STDOUT_ENDL(u8"Usage: exodbcbench [BENCHMARK OPTION]... [-DSN <dsn> [-U <user>] [-P <pass>] | -CS <connectionString>] [--case <u|l>]");
+	WRITE_STDOUT_ENDL(u8"");
+	WRITE_STDOUT_ENDL(u8"Run benchmarks against the test database of exodbctest.");
+	WRITE_STDOUT_ENDL(u8"If no argument '-DSN' or '-CS' is passed, the executable directory and its");
+	WRITE_STDOUT_ENDL(u8"parents are searched for a file 'TestSettings.xml', like exodbctest does.");
+	WRITE_STDOUT_ENDL(u8"Benchmarks that do not need a database run in any case.");
+	WRITE_STDOUT_ENDL(u8"");
+	WRITE_STDOUT_ENDL(u8"Results are written to stdout and as JSON to 'exodbcbench.json', unless");
+	WRITE_STDOUT_ENDL(u8"the option '--benchmark_out=<file>' is passed.");
+	WRITE_STDOUT_ENDL(u8"");
+	WRITE_STDOUT_ENDL(u8"BENCHMARK OPTION is any option of Google Benchmark, see '--help'.");
+	WRITE_STDOUT_ENDL(u8" -help              Show this text.");
+	WRITE_STDOUT_ENDL(u8"");
+}
+
+
+int main(int argc, char* argv[])
+{
+	namespace fs = boost::filesystem;
+
+	// Consume our arguments, pass all others to benchmark
+	string dsnValue, userValue, passValue, csValue;
+	Case caseValue = Case::LOWER;
+	bool haveOut = false;
+	vector<char*> benchmarkArgs;
+	benchmarkArgs.push_back(argv[0]);
+	for (int i = 1; i < argc; i++)
+	{
+		string arg(argv[i]);
+		string argNext = i + 1 < argc ? argv[i + 1] : u8"";
+		if (arg == u8"-help")
+		{
+			printHelp();
+			return 0;
+		}
+		else if (arg == u8"-DSN" && !argNext.empty())
+		{
+			dsnValue = argNext;
+			++i;
+		}
+		else if (arg == u8"-U" && !argNext.empty())
+		{
+			userValue = argNext;
+			++i;
+		}
+		else if (arg == u8"-P" && !argNext.empty())
+		{
+			passValue = argNext;
+			++i;
+		}
+		else if (arg == u8"-CS" && !argNext.empty())
+		{
+			csValue = argNext;
+			++i;
+		}
+		else if (arg == u8"--case" && !argNext.empty())
+		{
+			caseValue = boost::algorithm::iequals(argNext, u8"u") ? Case::UPPER : Case::LOWER;
+			++i;
+		}
+		else
+		{
+			if (arg.compare(0, 16, u8"--benchmark_out=") == 0)
+			{
+				haveOut = true;
+			}
+			benchmarkArgs.push_back(argv[i]);
+		}
+	}
+
+	if (!csValue.empty())
+	{
+		g_odbcInfo = TestParams(csValue, caseValue);
+	}
+	else if (!dsnValue.empty())
+	{
+		g_odbcInfo = TestParams(dsnValue, userValue, passValue, caseValue);
+	}
+	else
+	{
+		try
+		{
+			fs::path exePath(argv[0]);
+			fs::path confDir = exePath.is_absolute() ? exePath.parent_path() : fs::current_path();
+			fs::path settingsPath = confDir / u8"TestSettings.xml";
+			while (!fs::exists(settingsPath) && confDir.has_parent_path())
+			{
+				confDir = confDir.parent_path();
+				settingsPath = confDir / u8"TestSettings.xml";
+			}
+			if (fs::exists(settingsPath))
+			{
+				LOG_INFO(boost::str(boost::format(u8"Using settings from %1%") % settingsPath));
+				vector<string> skipNames;
+				g_odbcInfo.Load(settingsPath, skipNames);
+			}
+			else
+			{
+				LOG_WARNING(u8"No TestSettings.xml file found, only benchmarks not requiring a database will run");
+			}
+		}
+		catch (const Exception& ex)
+		{
+			LOG_ERROR(ex.ToString());
+			return 10;
+		}
+	}
+
+	// Always write JSON results, so runs can be compared
+	string outArg = u8"--benchmark_out=exodbcbench.json";
+	string outFormatArg = u8"--benchmark_out_format=json";
+	if (!haveOut)
+	{
+		benchmarkArgs.push_back(&outArg[0]);
+		benchmarkArgs.push_back(&outFormatArg[0]);
+	}
+	int benchmarkArgc = (int)benchmarkArgs.size();
+	benchmarkArgs.push_back(NULL);
+
+	benchmark::Initialize(&benchmarkArgc, benchmarkArgs.data());
+	if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, benchmarkArgs.data()))
+	{
+		printHelp();
+		return 1;
+	}
+	benchmark::AddCustomContext(u8"exodbc_connection", g_odbcInfo.HasConnectionString() ? u8"connection string" : g_odbcInfo.m_dsn);
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,59 @@
+﻿/*!
+* \file exOdbcBench.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* Helpers common to all benchmarks of exodbcbench.
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "benchmark/benchmark.h"
+#include "exodbc/Environment.h"
+#include "exodbc/Database.h"
+
+// System headers
+#include <string>
+
+// Forward declarations
+// --------------------
+
+namespace exodbcbench
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+
+	/*!
+	* \class DbFixture
+	* \brief Opens the test database configured like for exodbctest before a benchmark is run.
+	* \details Benchmarks must call CheckDb() before doing anything else.
+	*/
+	class DbFixture : public benchmark::Fixture
+	{
+	public:
+		using benchmark::Fixture::SetUp;
+		using benchmark::Fixture::TearDown;
+
+		void SetUp(const benchmark::State& state) override;
+		void TearDown(const benchmark::State& state) override;
+
+	protected:
+		/*!
+		* \brief	Returns false and marks the benchmark as failed if the database could not be opened.
+		*/
+		bool CheckDb(benchmark::State& state);
+
+		exodbc::EnvironmentPtr m_pEnv;
+		exodbc::DatabasePtr m_pDb;
+		std::string m_error;
+	};
+
+} // namespace exodbcbench
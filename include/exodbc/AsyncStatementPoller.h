@@ -0,0 +1,138 @@
+﻿/*!
+* \file AsyncStatementPoller.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the AsyncStatementPoller class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+
+// Other headers
+// System headers
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	/*!
+	* \class AsyncStatementPoller
+	*
+	* \brief Drives ODBC functions executed asynchronously until they have completed.
+	* \details	If SQL_ATTR_ASYNC_ENABLE is set on a statement handle, an ODBC function
+	*			called on that handle returns SQL_STILL_EXECUTING as long as the operation
+	*			has not completed. The function must then be called again with the same
+	*			arguments until it returns something different.
+	*
+	*			The AsyncStatementPoller owns a single background thread that calls the
+	*			submitted PollFunctions in a round robin until they no longer return
+	*			SQL_STILL_EXECUTING, and then calls the CompletionHandler with the final
+	*			return value. If all submitted operations are still executing, the thread
+	*			sleeps for the poll interval before polling again. One thread can this way
+	*			drive many statements in flight.
+	*
+	*			The background thread is started on the first Submit(). On destruction,
+	*			the thread keeps polling until all submitted operations have completed.
+	*			The class is thread-safe. Use Get() to get the instance shared by all
+	*			ExecutableStatements.
+	*/
+	class EXODBCAPI AsyncStatementPoller
+	{
+	public:
+		/*!
+		* \brief Function repeating the asynchronous ODBC call. Must return SQL_STILL_EXECUTING
+		*		as long as the operation has not completed.
+		*/
+		typedef std::function<SQLRETURN()> PollFunction;
+
+		/*!
+		* \brief Function called from the poll-thread with the final SQLRETURN of the PollFunction.
+		*/
+		typedef std::function<void(SQLRETURN)> CompletionHandler;
+
+		/*!
+		* \brief	Create a poller, the background thread is not started until the first
+		*			operation is submitted.
+		*/
+		AsyncStatementPoller(std::chrono::microseconds pollInterval = std::chrono::microseconds(1000));
+
+		// Prevent copies.
+		AsyncStatementPoller(const AsyncStatementPoller& other) = delete;
+		AsyncStatementPoller& operator=(const AsyncStatementPoller& other) = delete;
+
+		/*!
+		* \brief	Stops the background thread after all submitted operations have completed.
+		*/
+		~AsyncStatementPoller();
+
+
+		/*!
+		* \brief Get the instance shared by all ExecutableStatements.
+		*/
+		static AsyncStatementPoller& Get();
+
+
+		/*!
+		* \brief	Submit an operation whose initial call has returned SQL_STILL_EXECUTING.
+		* \details	pollFunction is called from the poll-thread until it returns something
+		*			different than SQL_STILL_EXECUTING. onComplete is then called from the
+		*			poll-thread with that value. Exceptions thrown by onComplete are logged and
+		*			swallowed.
+		*/
+		void Submit(PollFunction pollFunction, CompletionHandler onComplete);
+
+
+		/*!
+		* \brief	Get the number of operations submitted that have not completed yet.
+		*/
+		size_t GetPendingCount() const;
+
+
+		/*!
+		* \brief	Set the time to sleep between polls, if all operations are still executing.
+		*/
+		void SetPollInterval(std::chrono::microseconds pollInterval);
+
+
+		/*!
+		* \brief	Get the time to sleep between polls, if all operations are still executing.
+		*/
+		std::chrono::microseconds GetPollInterval() const;
+
+	private:
+		struct Operation
+		{
+			PollFunction m_pollFunction;
+			CompletionHandler m_onComplete;
+		};
+
+		void Run();
+
+		std::vector<Operation> m_submitted;	///< Operations submitted but not yet picked up by the poll-thread.
+		size_t m_pendingCount;
+		std::chrono::microseconds m_pollInterval;
+		bool m_stop;
+
+		std::thread m_thread;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_submittedCondition;
+	};
+} // namespace exodbc
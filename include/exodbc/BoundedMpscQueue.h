@@ -0,0 +1,158 @@
+﻿/*!
+* \file BoundedMpscQueue.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the BoundedMpscQueue class template.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "AssertionException.h"
+
+// Other headers
+// System headers
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	/*!
+	* \class BoundedMpscQueue
+	*
+	* \brief A bounded, lock-free queue for many producers and a single consumer.
+	* \details	The queue is a ring buffer of a fixed capacity (a power of two).
+	*			Every slot carries a sequence number telling whether it is ready to be
+	*			written or read: Producers claim a slot with a compare-and-swap on the
+	*			enqueue position, the consumer owns the dequeue position. No locks are
+	*			taken and no memory is allocated after construction (except by moving T).
+	*
+	*			TryPush() fails if the queue is full, TryPop() fails if it is empty:
+	*			Callers decide whether to drop, retry or wait.
+	*/
+	template<typename T>
+	class BoundedMpscQueue
+	{
+	public:
+		/*!
+		* \brief	Create a queue holding capacity elements.
+		* \throw	AssertionException If capacity is not a power of two greater than 1.
+		*/
+		explicit BoundedMpscQueue(size_t capacity)
+			: m_cells(capacity)
+			, m_mask(capacity - 1)
+			, m_enqueuePos(0)
+			, m_dequeuePos(0)
+		{
+			exASSERT_MSG(capacity >= 2 && (capacity & (capacity - 1)) == 0, u8"Capacity must be a power of two");
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+			}
+		};
+
+		BoundedMpscQueue(const BoundedMpscQueue& other) = delete;
+		BoundedMpscQueue& operator=(const BoundedMpscQueue& other) = delete;
+
+
+		/*!
+		* \brief	Move value into the queue. Can be called from any thread.
+		* \return	False if the queue is full, value is left untouched then.
+		*/
+		bool TryPush(T& value)
+		{
+			Cell* pCell = NULL;
+			size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+			while (true)
+			{
+				pCell = &m_cells[pos & m_mask];
+				size_t seq = pCell->m_sequence.load(std::memory_order_acquire);
+				std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+				if (diff == 0)
+				{
+					if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					// The consumer has not yet read the slot one round ago: full
+					return false;
+				}
+				else
+				{
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+			pCell->m_value = std::move(value);
+			pCell->m_sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		};
+
+
+		/*!
+		* \brief	Move the oldest element into value. Must only be called from one thread.
+		* \return	False if the queue is empty.
+		*/
+		bool TryPop(T& value)
+		{
+			size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+			Cell& cell = m_cells[pos & m_mask];
+			size_t seq = cell.m_sequence.load(std::memory_order_acquire);
+			if ((std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1) < 0)
+			{
+				return false;
+			}
+			value = std::move(cell.m_value);
+			m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+			cell.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+			return true;
+		};
+
+
+		/*!
+		* \brief	Number of elements the queue can hold.
+		*/
+		size_t GetCapacity() const noexcept { return m_mask + 1; };
+
+
+		/*!
+		* \brief	Approximate number of elements in the queue.
+		*/
+		size_t GetSizeApprox() const noexcept
+		{
+			size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+			size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+			return enqueued > dequeued ? enqueued - dequeued : 0;
+		};
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> m_sequence;
+			T m_value;
+		};
+
+		std::vector<Cell> m_cells;
+		const size_t m_mask;
+		// Keep producers and the consumer on different cache lines
+		alignas(64) std::atomic<size_t> m_enqueuePos;
+		alignas(64) std::atomic<size_t> m_dequeuePos;
+	};
+} // namespace exodbc
@@ -0,0 +1,284 @@
+﻿/*!
+* \file BulkRowset.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the BulkRowset class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Table.h"
+#include "ExecutableStatement.h"
+#include "RowRange.h"
+#include "CursorProfile.h"
+#include "ParameterDescription.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+
+	/*!
+	* \class BulkRowset
+	*
+	* \brief Modifies the rows of a Table a block of rows at a time.
+	* \details	The selected columns of the Table are fetched blockwise into a rowset of
+	*			GetRowsetSize() rows, like Table::Rows() does. The values of the rowset can
+	*			be changed in place, and rows can be marked to be updated or deleted.
+	*			ApplyChanges() sends all marked rows to the database at once:
+	*
+	*			- If the driver reports a CursorProfile that is not read-only and supports
+	*			  SQL_CA1_POS_UPDATE and SQL_CA1_POS_DELETE for its cursor type, the rows are
+	*			  selected on an updatable cursor and changed using SQLSetPos on the rowset.
+	*			  If the cursor type also supports SQL_CA1_BOOKMARK, SQL_CA1_BULK_UPDATE_BY_BOOKMARK
+	*			  and SQL_CA1_BULK_DELETE_BY_BOOKMARK, bookmarks are fetched with the rows and the
+	*			  rows are changed using SQLBulkOperations(SQL_UPDATE_BY_BOOKMARK / SQL_DELETE_BY_BOOKMARK)
+	*			  instead, see ExecutableStatement::BindBookmarkArray().
+	*			  New rows are added using SQLBulkOperations(SQL_ADD) if SQL_CA1_BULK_ADD
+	*			  is supported.
+	*			- Else the rows are changed by prepared UPDATE / DELETE statements with a
+	*			  WHERE clause on the primary key columns, and added by a prepared INSERT.
+	*			  The marked rows are bound as parameter arrays, see ExecutableStatement::ExecutePreparedArray().
+	*			  The primary key columns of the Table must be selected. As the statements
+	*			  are executed while the cursor is open, the driver must support more than
+	*			  one active statement per connection.
+	*
+	*			Both ways send one round trip per rowset instead of one per row. Use
+	*			IsPositioned() to find out which way is used. Nothing is committed.
+	*
+	*			Values of primary key columns can only be set on rows being added.
+	*/
+	class EXODBCAPI BulkRowset
+	{
+	public:
+		BulkRowset() = delete;
+
+		/*!
+		* \brief	Create a BulkRowset on the open table, fetching rowsetSize rows at once.
+		* \details	If allowPositioned is false, the rows are always changed using
+		*			statements on the primary key. If allowBookmarks is false, rows of an
+		*			updatable cursor are always changed using SQLSetPos.
+		* \throw	Exception If allocating the statement fails.
+		*/
+		BulkRowset(const Table& table, SQLULEN rowsetSize = DEFAULT_ROW_BLOCK_SIZE, bool allowPositioned = true, bool allowBookmarks = true);
+
+		BulkRowset(const BulkRowset& other) = delete;
+		BulkRowset& operator=(const BulkRowset& other) = delete;
+
+
+		/*!
+		* \brief	True if rows are changed using SQLSetPos on an updatable cursor.
+		*/
+		bool IsPositioned() const noexcept { return m_positioned; };
+
+
+		/*!
+		* \brief	True if the rows of the updatable cursor are changed using SQLBulkOperations
+		*			with SQL_UPDATE_BY_BOOKMARK and SQL_DELETE_BY_BOOKMARK instead of SQLSetPos.
+		*/
+		bool IsByBookmark() const noexcept { return m_byBookmark; };
+
+
+		/*!
+		* \brief	True if rows are added using SQLBulkOperations.
+		*/
+		bool IsBulkAdd() const noexcept { return m_bulkAdd; };
+
+
+		/*!
+		* \brief	The CursorProfile the rows are selected with.
+		*/
+		const CursorProfile& GetCursorProfile() const noexcept { return m_profile; };
+
+
+		/*!
+		* \brief	Maximum number of rows in the rowset.
+		*/
+		SQLULEN GetRowsetSize() const noexcept { return m_rowsetSize; };
+
+
+		/*!
+		* \brief	Execute a SELECT on the selected columns of the Table, discarding the
+		*			current rowset. The first rowset is fetched by FetchNext().
+		* \details	To only add rows, select an empty result set, for example using "1 = 0".
+		* \throw	Exception If changes are pending or executing fails.
+		*/
+		void Select(const std::string& whereStatement = u8"", const std::string& orderStatement = u8"");
+
+
+		/*!
+		* \brief	Fetch the next rowset.
+		* \return	False if no more rows are available.
+		* \throw	Exception If changes are pending, no result set is open or fetching fails.
+		*/
+		bool FetchNext();
+
+
+		/*!
+		* \brief	Number of rows in the current rowset, or the number of rows passed to
+		*			BeginAdd() while adding.
+		*/
+		SQLULEN GetRowCount() const noexcept;
+
+
+		/*!
+		* \brief	Return the zero-based index of the column with the passed queryName.
+		* \throw	NotFoundException If no such column exists.
+		*/
+		SQLUSMALLINT GetColumnIndex(const std::string& queryName) const;
+
+
+		/*!
+		* \brief	A view on row rowIndex of the current rowset.
+		*/
+		RowView GetRow(SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Set the value of column columnIndex in row rowIndex.
+		* \details	T must match the SQL C Type the column is bound as, see RowValueTraits.
+		*			The row must still be marked using MarkUpdated(), unless it is being added.
+		* \throw	AssertionException If T does not match the SQL C Type, or the column is a
+		*			primary key column and no rows are being added.
+		*/
+		template<typename T>
+		void SetValue(SQLUSMALLINT columnIndex, SQLULEN rowIndex, const T& value)
+		{
+			AssertWritable(columnIndex, rowIndex);
+			RowBlock& block = m_pRows->GetBlock();
+			exASSERT(RowValueTraits<T>::Accepts(block.GetColumnDefinition(columnIndex).m_sqlCType));
+			memcpy(block.GetDataPtr(columnIndex, rowIndex), &value, sizeof(T));
+			*block.GetIndicatorPtr(columnIndex, rowIndex) = (SQLLEN)sizeof(T);
+		};
+
+
+		/*!
+		* \brief	Set the value of the SQL_C_CHAR column columnIndex in row rowIndex.
+		* \throw	AssertionException If the column is not bound as SQL_C_CHAR or is a
+		*			primary key column and no rows are being added.
+		* \throw	Exception If value does not fit into the column.
+		*/
+		void SetString(SQLUSMALLINT columnIndex, SQLULEN rowIndex, const std::string& value);
+
+
+		/*!
+		* \brief	Set column columnIndex in row rowIndex to NULL.
+		* \throw	AssertionException If the column is a primary key column and no rows are being added.
+		*/
+		void SetNull(SQLUSMALLINT columnIndex, SQLULEN rowIndex);
+
+
+		/*!
+		* \brief	Mark row rowIndex of the current rowset to be updated by ApplyChanges().
+		*/
+		void MarkUpdated(SQLULEN rowIndex);
+
+
+		/*!
+		* \brief	Mark row rowIndex of the current rowset to be deleted by ApplyChanges().
+		*			A row marked as updated and deleted is only deleted.
+		*/
+		void MarkDeleted(SQLULEN rowIndex);
+
+
+		/*!
+		* \brief	True if rows of the current rowset have been marked.
+		*/
+		bool HasPendingChanges() const noexcept { return m_pendingChanges; };
+
+
+		/*!
+		* \brief	Update and delete the marked rows of the current rowset.
+		* \return	Number of rows updated or deleted.
+		* \throw	Exception If the driver reports an error, or if statements on the primary
+		*			key are used and no primary key column is selected.
+		*/
+		SQLULEN ApplyChanges();
+
+
+		/*!
+		* \brief	Start adding rowCount rows: The values of the first rowCount rows of the
+		*			rowset are set to NULL and can then be set using SetValue(), etc.
+		* \details	A result set must have been selected using Select(). The current rowset is discarded.
+		* \throw	Exception If changes are pending.
+		*/
+		void BeginAdd(SQLULEN rowCount);
+
+
+		/*!
+		* \brief	Insert the rows started by BeginAdd().
+		* \details	The result set is closed, call Select() to continue.
+		* \return	Number of rows added.
+		* \throw	Exception If the driver reports an error.
+		*/
+		SQLULEN AddRows();
+
+	private:
+		struct BulkColumn
+		{
+			std::string m_queryName;
+			RowColumnDefinition m_definition;
+			ParameterDescription m_paramDesc;
+			bool m_primaryKey;
+		};
+
+		enum class RowMark : unsigned char
+		{
+			NONE,
+			UPDATED,
+			DELETED
+		};
+
+		void AssertWritable(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+		void ClampIndicators(SQLULEN rowIndex);
+		std::vector<SQLULEN> GetMarkedRows(RowMark mark) const;
+		ParameterArray CompactColumn(SQLUSMALLINT columnIndex, const std::vector<SQLULEN>& rows, size_t paramIndex);
+		ExecutableStatementPtr PrepareStatement(const std::string& sql);
+		SQLULEN ApplyPositioned();
+		SQLULEN ApplyStatements();
+		void ClearMarks();
+
+		const Table& m_table;
+		ConstDatabasePtr m_pDb;
+		SQLULEN m_rowsetSize;
+		CursorProfile m_profile;
+		bool m_positioned;
+		bool m_byBookmark;
+		bool m_bulkAdd;
+		std::vector<BulkColumn> m_columns;
+
+		ExecutableStatement m_stmt;
+		std::unique_ptr<RowRange> m_pRows;	///< Bound to m_stmt, must be released before it.
+		bool m_fetched;
+		SQLULEN m_addCount;
+		std::vector<RowMark> m_marks;
+		bool m_pendingChanges;
+		std::vector<SQLCHAR> m_bookmarks;	///< One bookmark of ExecutableStatement::MAX_BOOKMARK_LENGTH bytes per row, if m_byBookmark.
+		std::vector<SQLLEN> m_bookmarkIndicators;
+
+		ExecutableStatementPtr m_pUpdateStmt;
+		ExecutableStatementPtr m_pDeleteStmt;
+		ExecutableStatementPtr m_pInsertStmt;
+		std::vector<std::vector<SQLCHAR>> m_paramData;
+		std::vector<std::vector<SQLLEN>> m_paramIndicators;
+	};
+} // namespace exodbc
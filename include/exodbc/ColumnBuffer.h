@@ -18,6 +18,7 @@
 #include "SqlHandle.h"
 #include "LogManagerOdbcMacros.h"
 #include "SetDescriptionFieldWrapper.h"
+#include "OdbcTrace.h"
 
 // Other headers
 #include <boost/variant.hpp>
@@ -295,7 +296,7 @@ namespace exodbc
 			exASSERT(bufferLen > 0);
 			exASSERT(pCb != NULL);
 
-			SQLRETURN ret = SQLBindCol(pHStmt->GetHandle(), columnNr, sqlCType, pBuffer, bufferLen, pCb);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLBindCol, pHStmt->GetHandle(), columnNr, sqlCType, pBuffer, bufferLen, pCb);
 			THROW_IFN_SUCCESS(SQLBindCol, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
 
 			// get a notification if unbound
@@ -310,7 +311,7 @@ namespace exodbc
 		/*!
 		* \brief Binds passed buffer as parameter using information passed.
 		*/
-		void BindParamImpl(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, SQLSMALLINT sqlCType, SQLPOINTER pBuffer, SQLLEN bufferLen, SQLLEN* pCb, const ParameterDescription& paramDesc)
+		void BindParamImpl(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, SQLSMALLINT sqlCType, SQLPOINTER pBuffer, SQLLEN bufferLen, SQLLEN* pCb, const ParameterDescription& paramDesc, ParameterDirection direction)
 		{
 			exASSERT(paramNr >= 1);
 			exASSERT(pHStmt != NULL);
@@ -321,7 +322,7 @@ namespace exodbc
 			exASSERT(paramDesc.GetSqlType() != SQL_UNKNOWN_TYPE);
 
 			// bind using the information passed
-			SQLRETURN ret = SQLBindParameter(pHStmt->GetHandle(), paramNr, SQL_PARAM_INPUT, sqlCType, paramDesc.GetSqlType(), paramDesc.GetCharSize(), paramDesc.GetDecimalDigits(), pBuffer, bufferLen, pCb);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLBindParameter, pHStmt->GetHandle(), paramNr, (SQLSMALLINT)direction, sqlCType, paramDesc.GetSqlType(), paramDesc.GetCharSize(), paramDesc.GetDecimalDigits(), pBuffer, bufferLen, pCb);
 			THROW_IFN_SUCCESS(SQLBindParameter, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
 
 			// Connect a signal that we are bound to this handle now and get notified if params get reseted
@@ -622,18 +623,19 @@ namespace exodbc
 		};
 
 		/*!
-		* \brief	Calls SqlBindParameter with SQL_PARAM_INPUT to bind the passed parameter as input parameter
-		*			on the passed statement handle.
+		* \brief	Calls SqlBindParameter to bind the passed parameter as input, input/output or output
+		*			parameter on the passed statement handle.
 		* \details	Optionally queries the database about the parameter, using SQLDescribeParam.
 		*			Connects a signal on the passed statement handle to be notified if the params of the
 		*			handle get reseted.
 		* \param	paramNr 1-indexed parameter of the statement to be executed.
 		* \param	pHStmt Statement to bind against.
 		* \param	paramDesc	Description of the parameter.
+		* \param	direction	Direction of the parameter.
 		*/
-		void BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc)
+		void BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc, ParameterDirection direction = ParameterDirection::INPUT)
 		{
-			BindParamImpl(paramNr, pHStmt, sqlCType, (SQLPOINTER*)&m_buffer[0], GetBufferLength(), &m_cb, paramDesc);
+			BindParamImpl(paramNr, pHStmt, sqlCType, (SQLPOINTER*)&m_buffer[0], GetBufferLength(), &m_cb, paramDesc, direction);
 		}
 
 
@@ -681,9 +683,9 @@ namespace exodbc
 
 
 	template<> inline
-	void ColumnBuffer<SQL_NUMERIC_STRUCT, SQL_C_NUMERIC>::BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc)
+	void ColumnBuffer<SQL_NUMERIC_STRUCT, SQL_C_NUMERIC>::BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc, ParameterDirection direction)
 	{
-		BindParamImpl(paramNr, pHStmt, SQL_C_NUMERIC, (SQLPOINTER*)&m_buffer, GetBufferLength(), &m_cb, paramDesc);
+		BindParamImpl(paramNr, pHStmt, SQL_C_NUMERIC, (SQLPOINTER*)&m_buffer, GetBufferLength(), &m_cb, paramDesc, direction);
 
 		// Do some additional steps for numeric types
 		SqlDescHandle hDesc(pHStmt, SqlDescHandle::RowDescriptorType::PARAM);
@@ -861,8 +863,8 @@ namespace exodbc
 		}
 
 		/*!
-		* \brief	Calls SqlBindParameter with SQL_PARAM_INPUT to bind the passed parameter as input parameter
-		*			on the passed statement handle.
+		* \brief	Calls SqlBindParameter to bind the passed parameter as input, input/output or output
+		*			parameter on the passed statement handle.
 		* \details	Optionally queries the database about the parameter, using SQLDescribeParam.
 		*			Connects a signal on the passed statement handle to be notified if the params of the
 		*			handle get reseted.
@@ -872,10 +874,11 @@ namespace exodbc
 		* \param	paramNr 1-indexed parameter of the statement to be executed.
 		* \param	pHStmt Statement to bind against.
 		* \param	paramDesc	Description of the parameter.
+		* \param	direction	Direction of the parameter.
 		*/
-		void BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc)
+		void BindParameter(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc, ParameterDirection direction = ParameterDirection::INPUT)
 		{
-			BindParamImpl(paramNr, pHStmt, GetSqlCType(), m_pBuffer, GetBufferLength(), &m_cb, paramDesc);
+			BindParamImpl(paramNr, pHStmt, GetSqlCType(), m_pBuffer, GetBufferLength(), &m_cb, paramDesc, direction);
 
 			if (m_sqlCType == SQL_C_NUMERIC)
 			{
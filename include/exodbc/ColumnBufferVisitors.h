@@ -61,30 +61,32 @@ namespace exodbc
 
 	/*!
 	* \class BindParamVisitor
-	* \brief Visitor to bind a ColumnBuffer to a statement handle as input parameter.
-	* \details On applying this visitor, it will call BindParameter(columnNr, pHStmt, paramDesc) on the ColumnBuffer.
+	* \brief Visitor to bind a ColumnBuffer to a statement handle as parameter.
+	* \details On applying this visitor, it will call BindParameter(columnNr, pHStmt, paramDesc, direction) on the ColumnBuffer.
 	*/
 	class BindParamVisitor
 		: public boost::static_visitor<void>
 	{
 	public:
 		BindParamVisitor() = delete;
-		BindParamVisitor(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc)
+		BindParamVisitor(SQLUSMALLINT paramNr, ConstSqlStmtHandlePtr pHStmt, const ParameterDescription& paramDesc, ParameterDirection direction = ParameterDirection::INPUT)
 			: m_paramNr(paramNr)
 			, m_pHStmt(pHStmt)
 			, m_paramDesc(paramDesc)
+			, m_direction(direction)
 		{};
 
 		template<typename T>
 		void operator()(T& t) const
 		{
-			t->BindParameter(m_paramNr, m_pHStmt, m_paramDesc);
+			t->BindParameter(m_paramNr, m_pHStmt, m_paramDesc, m_direction);
 		}
 
 	private:
 		SQLUSMALLINT m_paramNr;
 		ConstSqlStmtHandlePtr m_pHStmt;
 		ParameterDescription m_paramDesc;
+		ParameterDirection m_direction;
 	};
 
 	
@@ -276,4 +278,21 @@ namespace exodbc
 		}
 	};
 
+
+	/*!
+	* \class BufferLengthVisitor
+	* \brief Visitor to get the length of the buffer in bytes as SQLLEN.
+	* \details On applying this visitor, it will call GetBufferLength() on the ColumnBuffer.
+	*/
+	class BufferLengthVisitor
+		: public boost::static_visitor<SQLLEN>
+	{
+	public:
+		template<typename T>
+		SQLLEN operator()(T& t) const
+		{
+			return t->GetBufferLength();
+		}
+	};
+
 } // namespace exodbc
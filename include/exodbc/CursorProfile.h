@@ -0,0 +1,130 @@
+﻿/*!
+* \file CursorProfile.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for CursorProfile and the cursor enums.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+
+// Other headers
+// System headers
+#include <string>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \enum CursorType
+	* \brief Values of the statement attribute SQL_ATTR_CURSOR_TYPE.
+	*/
+	enum class CursorType
+	{
+		FORWARD_ONLY = SQL_CURSOR_FORWARD_ONLY,	///< Rows can only be fetched forward. The cheapest cursor, read-only it streams the result set.
+		STATIC = SQL_CURSOR_STATIC,	///< Scrollable, the result set is materialized on execution and does not see changes.
+		KEYSET_DRIVEN = SQL_CURSOR_KEYSET_DRIVEN,	///< Scrollable, the keys are materialized on execution, updates and deletes of other transactions are seen.
+		DYNAMIC = SQL_CURSOR_DYNAMIC	///< Scrollable, every fetch sees all changes of other transactions.
+	};
+
+
+	/*!
+	* \enum CursorConcurrency
+	* \brief Values of the statement attribute SQL_ATTR_CONCURRENCY.
+	*/
+	enum class CursorConcurrency
+	{
+		READ_ONLY = SQL_CONCUR_READ_ONLY,	///< Read-only, no locks are held on the fetched rows.
+		LOCK = SQL_CONCUR_LOCK,	///< Rows are locked to ensure they can be updated.
+		ROWVER = SQL_CONCUR_ROWVER,	///< Optimistic concurrency comparing row versions.
+		VALUES = SQL_CONCUR_VALUES	///< Optimistic concurrency comparing values.
+	};
+
+
+	/*!
+	* \enum CursorSensitivity
+	* \brief Values of the statement attribute SQL_ATTR_CURSOR_SENSITIVITY.
+	*/
+	enum class CursorSensitivity
+	{
+		UNSPECIFIED = SQL_UNSPECIFIED,	///< Let the driver choose, depending on type and concurrency.
+		INSENSITIVE = SQL_INSENSITIVE,	///< Changes made after executing are not seen. Requires read-only concurrency.
+		SENSITIVE = SQL_SENSITIVE	///< Changes made after executing are seen.
+	};
+
+
+	/*!
+	* \struct CursorProfile
+	* \brief The statement attributes SQL_ATTR_CURSOR_TYPE, SQL_ATTR_CONCURRENCY and
+	*		SQL_ATTR_CURSOR_SENSITIVITY to be set on an ExecutableStatement.
+	* \see	ExecutableStatement::SetCursorProfile()
+	*/
+	struct EXODBCAPI CursorProfile
+	{
+		/*!
+		* \brief Create a forward-only, read-only profile.
+		*/
+		CursorProfile()
+			: m_type(CursorType::FORWARD_ONLY)
+			, m_concurrency(CursorConcurrency::READ_ONLY)
+			, m_sensitivity(CursorSensitivity::UNSPECIFIED)
+		{ };
+
+
+		CursorProfile(CursorType type, CursorConcurrency concurrency, CursorSensitivity sensitivity = CursorSensitivity::UNSPECIFIED)
+			: m_type(type)
+			, m_concurrency(concurrency)
+			, m_sensitivity(sensitivity)
+		{ };
+
+
+		/*!
+		* \brief	Forward-only and read-only: The driver can stream the result set to the client
+		*			without keeping any state on the server (the "firehose" cursor), which is the
+		*			fastest way to read a result set once.
+		*/
+		static CursorProfile ForwardOnlyReadOnly() { return CursorProfile(); };
+
+
+		/*!
+		* \brief	Static and read-only: Scrollable, the cheapest scrollable cursor on most databases.
+		*/
+		static CursorProfile StaticReadOnly() { return CursorProfile(CursorType::STATIC, CursorConcurrency::READ_ONLY); };
+
+
+		/*!
+		* \brief	True if the cursor type is not CursorType::FORWARD_ONLY.
+		*/
+		bool IsScrollable() const noexcept { return m_type != CursorType::FORWARD_ONLY; };
+
+
+		/*!
+		* \brief	Returns a string like 'STATIC / READ_ONLY / UNSPECIFIED'.
+		*/
+		std::string ToString() const;
+
+
+		bool operator==(const CursorProfile& other) const noexcept
+		{
+			return m_type == other.m_type && m_concurrency == other.m_concurrency && m_sensitivity == other.m_sensitivity;
+		};
+		bool operator!=(const CursorProfile& other) const noexcept { return !(*this == other); };
+
+		CursorType m_type;	///< SQL_ATTR_CURSOR_TYPE.
+		CursorConcurrency m_concurrency;	///< SQL_ATTR_CONCURRENCY.
+		CursorSensitivity m_sensitivity;	///< SQL_ATTR_CURSOR_SENSITIVITY, not set if CursorSensitivity::UNSPECIFIED.
+	};
+
+} // namespace exodbc
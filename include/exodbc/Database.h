@@ -18,6 +18,8 @@
 #include "SqlHandle.h"
 #include "Environment.h"
 #include "SqlInfoProperty.h"
+#include "SqlStmtHandlePool.h"
+#include "ResultCache.h"
 
 // Other headers
 #if EXODBC_TEST
@@ -41,6 +43,7 @@ namespace exodbctest
 	class DatabaseTest_ReadDbInfo_Test;
 	class DatabaseTest_CommitTransaction_Test;
 	class DatabaseTest_RollbackTransaction_Test;
+	class DatabaseTest_ExecSqlBatchKeepsLaterResultSet_Test;
 }
 #endif
 
@@ -91,6 +94,7 @@ namespace exodbc
 		friend class exodbctest::DatabaseTest_ReadDbInfo_Test;
 		friend class exodbctest::DatabaseTest_CommitTransaction_Test;
 		friend class exodbctest::DatabaseTest_RollbackTransaction_Test;
+		friend class exodbctest::DatabaseTest_ExecSqlBatchKeepsLaterResultSet_Test;
 #endif
 	public:
 		/*!
@@ -201,6 +205,18 @@ namespace exodbc
 		void         Open(const std::string& dsn, const std::string& uid, const std::string& authStr);
 
 
+		/*!
+		* \brief	Create a new Database on the Environment of this Database and open it
+		*			using the same DSN and credentials or the same connection string.
+		* \details	Used to open additional connections to the same data source, for example
+		*			to run statements in parallel. The Sql2BufferTypeMap and the maximum number
+		*			of pooled statement handles are taken over, the commit mode is set to the
+		*			commit mode of this Database.
+		* \throw	Exception If this Database is not open or opening the new Database fails.
+		*/
+		std::shared_ptr<Database> OpenNewConnection() const;
+
+
 		/*!
 		 * \brief		If this database is open, closes the stmt-handle and the connection to the db.
 		 * \details	This function will fail if any of the handles cannot be freed.
@@ -222,6 +238,11 @@ namespace exodbc
 		 * \param	mode   	If FailOnNoData is set, Exception is thrown if SQL returns NO_DATA.
 		 * 					This happens for example on DB2 if you do a DELETE with a WHERE
 		 * 					clause and no records are deleted.
+		 * \details	If the driver supports batches, sqlStmt may hold several statements: Their results
+		 *			are read up to the first statement returning a result set, to report errors of
+		 *			the statements before. That result set is kept open and can be fetched using
+		 *			GetExecSqlHandle(). If no statement returns a result set, all results are read.
+		 * \see		ExecutableStatement::ExecuteBatch()
 		 * \throw	Exception If executing SQL failed, or depending on mode if no records are affected.
 		 */
 		void         ExecSql(const std::string& sqlStmt, ExecFailMode mode = ExecFailMode::NotFailOnNoData);
@@ -383,6 +404,50 @@ namespace exodbc
 		DatabaseProduct       GetDbms() const { return m_props.GetDbms(); };
 
 
+		/*!
+		* \brief	Returns true if the driver supports asynchronous execution on statement level.
+		* \see		SqlInfoProperties::GetSupportsAsyncStatements()
+		*/
+		bool		GetSupportsAsyncStatements() const { return m_props.GetSupportsAsyncStatements(); };
+
+
+		/*!
+		* \brief	Returns false if the driver reports that it does not support the passed CursorProfile.
+		* \see		SqlInfoProperties::GetSupportsCursorProfile()
+		*/
+		bool		GetSupportsCursorProfile(const CursorProfile& profile) const { return m_props.GetSupportsCursorProfile(profile); };
+
+
+		/*!
+		* \brief	Returns the SQL_CA1_xxx flags the driver reports for cursors of the passed type, or 0 if unknown.
+		* \see		SqlInfoProperties::GetCursorAttributes1()
+		*/
+		SQLUINTEGER	GetCursorAttributes1(CursorType type) const { return m_props.GetCursorAttributes1(type); };
+
+
+		/*!
+		* \brief	Returns true if the driver reports SQL_CA1_BOOKMARK for cursors of the passed type.
+		*/
+		bool		GetSupportsBookmarks(CursorType type) const { return (GetCursorAttributes1(type) & SQL_CA1_BOOKMARK) != 0; };
+
+
+		/*!
+		* \brief	Returns true if batches of statements can be executed in one round trip,
+		*			reporting the row count of every statement.
+		* \see		SqlInfoProperties::GetSupportsBatchRowCounts()
+		* \see		ExecutableStatement::ExecuteBatch()
+		*/
+		bool		GetSupportsBatches() const { return m_props.GetSupportsBatchRowCounts(); };
+
+
+		/*!
+		* \brief	Returns true if the driver supports calling procedures using the ODBC escape sequence.
+		* \see		SqlInfoProperties::GetSupportsProcedures()
+		* \see		ExecutableStatement::CreateCallStatement()
+		*/
+		bool		GetSupportsProcedures() const { return m_props.GetSupportsProcedures(); };
+
+
 		/*!
 		* \brief	Get the Environment this Database was created from.
 		* \return	Environment if set.
@@ -430,6 +495,55 @@ namespace exodbc
 		DatabaseCatalogPtr GetDbCatalog() const;
 
 
+		/*!
+		* \brief	Get the pool of statement handles of this Database.
+		* \details	ExecutableStatement acquires its handles from this pool and releases
+		*			them back to the pool if it is Reset() or destroyed.
+		* \throw	Exception if not Open()
+		*/
+		SqlStmtHandlePoolPtr GetStmtHandlePool() const;
+
+
+		/*!
+		* \brief	Set the maximum number of statement handles kept in the pool of this
+		*			Database. If the Database is not open, the value is applied during Open().
+		*			Set to 0 to disable pooling.
+		*/
+		void SetMaxPooledStmtHandles(size_t maxPooledHandles);
+
+
+		/*!
+		* \brief	Get the maximum number of statement handles kept in the pool of this Database.
+		*/
+		size_t GetMaxPooledStmtHandles() const noexcept { return m_maxPooledStmtHandles; };
+
+
+		/*!
+		* \brief	Set the ResultCache invalidated by writes through Tables on this Database.
+		* \details	Set to NULL to disable caching, which is the default. The cache is
+		*			shared with connections created using OpenNewConnection() afterwards.
+		*			Committing a transaction invalidates the tables written during the
+		*			transaction again, rolling back a transaction clears the cache.
+		*/
+		void SetResultCache(ResultCachePtr pResultCache) noexcept { m_pResultCache = pResultCache; };
+
+
+		/*!
+		* \brief	Get the ResultCache set on this Database, NULL if none is set.
+		*/
+		ResultCachePtr GetResultCache() const noexcept { return m_pResultCache; };
+
+
+		/*!
+		* \brief	Remove the results depending on tableName from the ResultCache, if one is set.
+		* \details	If the Database is in CommitMode::MANUAL, the write only becomes visible to
+		*			other connections sharing the cache on commit: Until then, they might read
+		*			the old rows and cache them again. The table is remembered and invalidated
+		*			again by CommitTrans().
+		*/
+		void InvalidateResultCache(const std::string& tableName) const;
+
+
 		/*!
 		* \brief Allocates a statement and tries to enable scrollable cursors.
 		* Returns true if enabling scrollable cursor succeeded, false otherwise.
@@ -472,6 +586,10 @@ namespace exodbc
 		SqlInfoProperties		m_props;	///< Properties read from SqlGetInfo
 		Sql2BufferTypeMapPtr	m_pSql2BufferTypeMap;	///< Sql2BufferTypeMap to be used from this Database. If none is set during OpenImp() a DefaultSql2BufferTypeMap is created.
 		DatabaseCatalogPtr		m_pDbCatalog;	///< The catalog of this Database. Initialized during OpenImpl(), freed on Close()
+		SqlStmtHandlePoolPtr	m_pStmtHandlePool;	///< Pool of statement handles used by ExecutableStatement. Initialized during OpenImpl(), closed on Close()
+		size_t					m_maxPooledStmtHandles;	///< Maximum number of handles kept in m_pStmtHandlePool
+		ResultCachePtr			m_pResultCache;	///< Cache of query results invalidated by Table writes, NULL if not caching
+		mutable std::set<std::string> m_writtenTables;	///< Tables invalidated during the current transaction, invalidated again on commit
 
 		SqlTypeInfoVector m_datatypes;	///< Queried from DB during Open
 		bool				m_dbIsOpen;			///< Set to true after SQLConnect was successful
@@ -18,6 +18,8 @@
 #include "PrimaryKeyInfo.h"
 #include "SqlTypeInfo.h"
 #include "SpecialColumnInfo.h"
+#include "IndexInfo.h"
+#include "ForeignKeyInfo.h"
 
 // Other headers
 // System headers
@@ -260,6 +262,31 @@ namespace exodbc
 			SpecialColumnInfo::RowIdScope scope, bool includeNullableColumns = true) const;
 
 
+		/*!
+		* \brief	Read the statistics and the indexes of a table.
+		* \details	This is a wrapper around SQLStatistics. The returned TableStatistics hold the
+		*			cardinality and number of pages of the table, if reported by the driver,
+		*			and the columns of all indexes of the table.
+		* \param	tableInfo	Identify the table to query database about.
+		* \param	uniqueOnly	If true, only unique indexes are returned (SQL_INDEX_UNIQUE), else all
+		*						indexes (SQL_INDEX_ALL).
+		* \param	quick		If true, the driver only returns cardinality and pages if they are
+		*						readily available (SQL_QUICK), the values might be outdated or missing.
+		*						Else the driver is asked to compute them (SQL_ENSURE), which might be
+		*						as expensive as reading the whole table.
+		*/
+		TableStatistics ReadStatistics(const TableInfo& tableInfo, bool uniqueOnly = false, bool quick = true) const;
+
+
+		/*!
+		* \brief	Read the foreign keys of a table, that is the columns of the table
+		*			referencing the primary keys of other tables.
+		* \details	This is a wrapper around SQLForeignKeys. The keys are ordered by the
+		*			referenced table and the key sequence.
+		*/
+		ForeignKeyInfoVector ReadForeignKeyInfo(const TableInfo& tableInfo) const;
+
+
 	private:
 		/*!
 		* \brief Searches for tables using the passed search-arguments.
@@ -328,6 +355,34 @@ namespace exodbc
 			SpecialColumnInfo::RowIdScope scope, bool includeNullableColumns, MetadataMode mode) const;
 
 
+		/*!
+		* \brief	Read the rows of SQLStatistics for a table.
+		* \details	If mode is set MetadataMode::PatternOrOrdinary, pTableName, pSchemaName and
+		*			pCatalogName are treated as ordinary value (OV) arguments. Strings are treated
+		*			literally and the case is significant.
+		*			If mode is set to MetadataMode::Identifier, all arguments are treated as
+		*			identifier values (ID).\n
+		*			pTableName is not allowed to be a null pointer.
+		*/
+		IndexInfoVector ReadStatistics(SQLAPICHARTYPE* pTableName, SQLAPICHARTYPE* pSchemaName, SQLAPICHARTYPE* pCatalogName,
+			bool uniqueOnly, bool quick, MetadataMode mode) const;
+
+
+		/*!
+		* \brief	Read foreign key information using SQLForeignKeys.
+		* \details	If the primary key table is set, the foreign keys of other tables referencing
+		*			its primary key are returned. If the foreign key table is set, its foreign keys
+		*			are returned. If both are set, the foreign keys of the foreign key table
+		*			referencing the primary key table are returned.\n
+		*			If mode is set MetadataMode::PatternOrOrdinary, all arguments are treated as
+		*			ordinary value (OV) arguments. If mode is set to MetadataMode::Identifier, all
+		*			arguments are treated as identifier values (ID).\n
+		*			pPkTableName and pFkTableName must not both be null pointers.
+		*/
+		ForeignKeyInfoVector ReadForeignKeyInfo(SQLAPICHARTYPE* pPkTableName, SQLAPICHARTYPE* pPkSchemaName, SQLAPICHARTYPE* pPkCatalogName,
+			SQLAPICHARTYPE* pFkTableName, SQLAPICHARTYPE* pFkSchemaName, SQLAPICHARTYPE* pFkCatalogName, MetadataMode mode) const;
+
+
 		ConstSqlDbcHandlePtr m_pHdbc;
 		SqlStmtHandlePtr m_pHStmt;
 		SqlInfoProperties m_props;
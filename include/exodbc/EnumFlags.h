@@ -170,6 +170,21 @@ namespace exodbc
 
 		/// If set, scrollable cursors are enabled.
 		TOF_SCROLLABLE_CURSORS = 0x80, 
+
+		/// If set, the SELECT statements use CursorProfile::ForwardOnlyReadOnly(), setting the cursor type and concurrency explicitly.
+		TOF_FORWARD_ONLY_READ_ONLY_CURSORS = 0x100,
+
+		/// If set, the SELECT statements use static, read-only cursors.
+		TOF_STATIC_CURSORS = 0x200,
+
+		/// If set, the SELECT statements use keyset-driven, read-only cursors.
+		TOF_KEYSET_CURSORS = 0x400,
+
+		/// If set, the SELECT statements use dynamic, read-only cursors.
+		TOF_DYNAMIC_CURSORS = 0x800,
+
+		/// If set, bookmarks are enabled on the SELECT statements. Requires a scrollable cursor.
+		TOF_BOOKMARKS = 0x1000,
 	};
 	template<>
 	struct enable_bitmask_operators<TableOpenFlag> {
@@ -118,6 +118,8 @@ namespace exodbc
 		*			SQL_OPT_TRACE_OFF, depending on enable.
 		* \details	Note that the trace option does not depend on any handle,
 		*			it will be activated globally for the running application.
+		*			To measure the calls exodbc makes without the overhead of the
+		*			driver manager trace, use the OdbcTracer.
 		* \throw	Exception
 		*/
 		static void SetTrace(bool enable);
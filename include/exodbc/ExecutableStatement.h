@@ -15,11 +15,18 @@
 #include "Database.h"
 #include "ParameterDescription.h"
 #include "ColumnDescription.h"
+#include "RowRange.h"
+#include "ExecutionScope.h"
+#include "CursorProfile.h"
 
 // Other headers
 // System headers
 #include <string>
 #include <memory>
+#include <future>
+#include <functional>
+#include <map>
+#include <vector>
 
 // Forward declarations
 // --------------------
@@ -32,6 +39,42 @@ namespace exodbc
 	// Structs
 	// -------
 
+	/*!
+	* \struct ParameterArray
+	* \brief An array of values bound column-wise as one parameter by ExecutableStatement::ExecutePreparedArray().
+	*/
+	struct EXODBCAPI ParameterArray
+	{
+		ParameterArray()
+			: m_sqlCType(SQL_UNKNOWN_TYPE)
+			, m_pData(NULL)
+			, m_elementLength(0)
+			, m_pIndicators(NULL)
+		{ };
+
+		ParameterArray(SQLSMALLINT sqlCType, const ParameterDescription& paramDesc, SQLPOINTER pData, SQLLEN elementLength, SQLLEN* pIndicators)
+			: m_sqlCType(sqlCType)
+			, m_paramDesc(paramDesc)
+			, m_pData(pData)
+			, m_elementLength(elementLength)
+			, m_pIndicators(pIndicators)
+		{ };
+
+		SQLSMALLINT m_sqlCType;	///< SQL C Type of the values.
+		ParameterDescription m_paramDesc;	///< SQL Type, column size and decimal digits of the parameter.
+		SQLPOINTER m_pData;	///< The first value, the values follow each other every m_elementLength bytes.
+		SQLLEN m_elementLength;	///< Number of bytes of one value.
+		SQLLEN* m_pIndicators;	///< One length / indicator per value.
+	};
+
+
+	/*!
+	* \typedef Bookmark
+	* \brief The variable-length bookmark of a row, see ExecutableStatement::GetBookmark().
+	*/
+	typedef std::vector<SQLCHAR> Bookmark;
+
+
 	// Classes
 	// -------
 	/*!
@@ -42,11 +85,41 @@ namespace exodbc
 	*			ColumnBuffer classes can be bound to retrieve the results of
 	*			that SQL statement, and / or as parameters for the statement.
 	*			On destruction, the columns and or params will be resetted
-	*			on the underlying handle and the handle will be freed.
+	*			on the underlying handle and the handle will be released to the
+	*			SqlStmtHandlePool of the Database.
+	*
+	*			ExecuteDirectAsync(), ExecutePreparedAsync() and SelectNextAsync()
+	*			execute asynchronously if the Database supports asynchronous execution
+	*			on statement level: The operation is driven by the AsyncStatementPoller
+	*			and a std::future is returned. No other function must be called on the
+	*			ExecutableStatement until that future is ready.
+	*
+	*			While the StatementMetricsRegistry is enabled, preparing, executing
+	*			and fetching is recorded on the StatementMetrics of the executed SQL.
+	*			While the SlowQueryLog is enabled, every execution is reported to it
+	*			together with the values of the bound parameters. While the SessionRecorder
+	*			is recording, every prepare and execution is written to the recording.
 	*/
 	class EXODBCAPI ExecutableStatement
 	{
 	public:
+		/*!
+		* \brief	Called once an asynchronously executed statement has completed.
+		*			Holds the exception if executing failed, or is null on success.
+		*/
+		typedef std::function<void(std::exception_ptr)> ExecuteCompletionHandler;
+
+		/*!
+		* \brief	Called once an asynchronous fetch has completed with true if a record
+		*			has been fetched. Holds the exception if fetching failed, or is null on success.
+		*/
+		typedef std::function<void(bool, std::exception_ptr)> FetchCompletionHandler;
+
+		/*!
+		* \brief	Size of the buffer the bookmark column is bound to, see SetUseBookmarks().
+		*/
+		static const SQLLEN MAX_BOOKMARK_LENGTH = 256;
+
 		/*!
 		* A static lists of drivers that do not support SqlDescribeParam.
 		* Unknown databases are expected to support it, so true is returned.
@@ -82,6 +155,13 @@ namespace exodbc
 		*/
 		ExecutableStatement(ConstDatabasePtr pDb);
 
+
+		/*!
+		* \brief Constructs a statement from the given Database, setting the passed CursorProfile.
+		* \see	SetCursorProfile()
+		*/
+		ExecutableStatement(ConstDatabasePtr pDb, const CursorProfile& cursorProfile);
+
 		
 		// Prevent copies.
 		ExecutableStatement(const ExecutableStatement& other) = delete;
@@ -89,7 +169,8 @@ namespace exodbc
 
 		/*!
 		* \brief	If parameters or columns have been bound on this statement, call UnbindColumns() or
-		*			ResetParams() on the internal statement on destruction.
+		*			ResetParams() on the internal statement on destruction. The statement handle is
+		*			released to the SqlStmtHandlePool it has been acquired from.
 		*/
 		virtual ~ExecutableStatement();
 
@@ -97,10 +178,18 @@ namespace exodbc
 		/*!
 		* \brief	Initialize the ExecutableStatement. Must be called only once, and only
 		*			if the default Constructor has been used, or after Reset() has been called.
+		* \details	The statement handle is acquired from the SqlStmtHandlePool of the passed Database.
 		*/
 		void Init(ConstDatabasePtr pDb, bool scrollableCursor);
 
 
+		/*!
+		* \brief	Same as Init(ConstDatabasePtr, bool), but sets the passed CursorProfile.
+		* \see		SetCursorProfile()
+		*/
+		void Init(ConstDatabasePtr pDb, const CursorProfile& cursorProfile);
+
+
 		/*!
 		* \brief	Returns true if Init() was called and m_pDb is not null.
 		*/
@@ -113,6 +202,7 @@ namespace exodbc
 		*			Reset() and you want to re-use the ExectuableStatement again.
 		* \details	If any params or columns have been bound using this ExcecutableStatement, 
 		*			the corresponding Unbind function is called on the Stmt-handle.
+		*			The Stmt-handle is released to the SqlStmtHandlePool it has been acquired from.
 		*/
 		void Reset();
 
@@ -142,6 +232,18 @@ namespace exodbc
 		void BindParameter(ColumnBufferPtrVariant column, SQLUSMALLINT paramNr, bool neverQueryParamDesc = false);
 
 
+		/*!
+		* \brief	Bind a ColumnBufferPtrVariant to a parameter marker ('?') of a procedure call
+		*			as input, input/output or output parameter.
+		* \details	Works like BindParameter(ColumnBufferPtrVariant, SQLUSMALLINT, bool). The
+		*			driver writes the values of input/output and output parameters to column
+		*			once all results of the call have been processed, see FinishResults().
+		*			Character and binary buffers must be large enough to hold the returned value.
+		* \see		CreateCallStatement()
+		*/
+		void BindParameter(ColumnBufferPtrVariant column, SQLUSMALLINT paramNr, ParameterDirection direction, bool neverQueryParamDesc = false);
+
+
 		/*!
 		* \brief	Execute the passed statement using SQLExecDirect.
 		* \details	Before the statement is executed an eventually open Cursor is closed.
@@ -162,12 +264,44 @@ namespace exodbc
 		bool IsPrepared() const noexcept { return m_isPrepared; };
 
 
+		/*!
+		* \brief	Returns the StatementMetrics of the statement executed last, or an
+		*			empty pointer if the StatementMetricsRegistry was disabled during that execution.
+		*/
+		StatementMetricsPtr GetMetrics() const noexcept { return m_pExecution ? m_pExecution->GetMetrics() : StatementMetricsPtr(); };
+
+
 		/*!
 		* \brief	Returns true if scrollable cursors are enabled
 		*/
 		bool IsForwardOnlyCursor() const noexcept { return m_scrollableCursor; };
 
 
+		/*!
+		* \brief	Set the statement attributes SQL_ATTR_CURSOR_TYPE, SQL_ATTR_CONCURRENCY and,
+		*			unless CursorSensitivity::UNSPECIFIED, SQL_ATTR_CURSOR_SENSITIVITY.
+		* \details	Must be called before the statement is prepared. An open cursor is closed.
+		*			The driver may substitute attributes it does not support by the closest
+		*			ones it supports: The attributes are read back, and if they differ from
+		*			cursorProfile a warning is logged. Use GetCursorProfile() to get the
+		*			attributes in effect.
+		*
+		*			CursorProfile::ForwardOnlyReadOnly() is the fastest profile to read a result
+		*			set once. Scrollable profiles let SelectFirst(), SelectAbsolute(), etc. be used.
+		* \throw	Exception If the Database reports no support for cursorProfile, or setting an attribute fails.
+		*/
+		void SetCursorProfile(const CursorProfile& cursorProfile);
+
+
+		/*!
+		* \brief	Read the statement attributes SQL_ATTR_CURSOR_TYPE, SQL_ATTR_CONCURRENCY and
+		*			SQL_ATTR_CURSOR_SENSITIVITY currently set on the handle.
+		* \details	If the driver fails to report the sensitivity, CursorSensitivity::UNSPECIFIED is returned.
+		* \throw	SqlResultException If reading the cursor type or concurrency fails.
+		*/
+		CursorProfile GetCursorProfile() const;
+
+
 		/*!
 		* \brief	Calls SQLDescribeParam for parameter at paramNr and the handle of this ExecutableStatement.
 		*/
@@ -192,6 +326,107 @@ namespace exodbc
 		void ExecutePrepared() const;
 
 
+		/*!
+		* \brief	Executes a statement that has been prepared using Prepare() once for each of
+		*			paramSetSize sets of parameters, binding params column-wise as parameter arrays.
+		* \details	params[0] is bound as the first parameter, etc. Parameters bound before
+		*			are unbound. The statement attributes SQL_ATTR_PARAMSET_SIZE and
+		*			SQL_ATTR_PARAM_STATUS_PTR are set for this execution only, the arrays are
+		*			unbound once it has completed. Rows are inserted, updated or deleted with one
+		*			round trip instead of one per row, if the driver supports parameter arrays.
+		* \return	Number of parameter sets processed.
+		* \throw	SqlResultException If executing fails.
+		* \throw	Exception If the driver reports an error for any parameter set.
+		*/
+		SQLULEN ExecutePreparedArray(const std::vector<ParameterArray>& params, SQLULEN paramSetSize);
+
+
+		/*!
+		* \brief	Calls SQLSetPos with the passed operation on the rowset of the open cursor.
+		* \details	The values are read from / written to the columns currently bound, usually
+		*			by a RowRange. rowNumber is one-based, 0 applies the operation to all rows
+		*			of the rowset. If pRowOperations is set, it must hold one SQL_ROW_PROCEED or
+		*			SQL_ROW_IGNORE per row of the rowset and is set as SQL_ATTR_ROW_OPERATION_PTR
+		*			for this call only. The cursor must have been opened with a CursorProfile
+		*			that is not read-only to update or delete rows.
+		* \throw	SqlResultException If SQLSetPos fails.
+		*/
+		void SetPos(SQLSETPOSIROW rowNumber, SQLUSMALLINT operation, SQLUSMALLINT* pRowOperations = NULL);
+
+
+		/*!
+		* \brief	Calls SQLBulkOperations with the passed operation on the open cursor.
+		* \details	SQL_ATTR_ROW_ARRAY_SIZE is set to rowCount for this call only, the values
+		*			are read from the columns currently bound. For SQL_ADD the first rowCount
+		*			rows of the bound arrays are inserted. SQL_UPDATE_BY_BOOKMARK and
+		*			SQL_DELETE_BY_BOOKMARK identify the rows by the bookmarks bound using
+		*			BindBookmarkArray(). If pRowOperations is set, it must hold one SQL_ROW_PROCEED
+		*			or SQL_ROW_IGNORE per row and is set as SQL_ATTR_ROW_OPERATION_PTR for this
+		*			call only.
+		* \throw	SqlResultException If SQLBulkOperations fails.
+		*/
+		void BulkOperations(SQLUSMALLINT operation, SQLULEN rowCount, SQLUSMALLINT* pRowOperations = NULL);
+
+
+		/*!
+		* \brief	Move to the next result of the statement executed, using SQLMoreResults.
+		* \details	Statement batches and procedures can return several results, each of them
+		*			either a result set or the number of rows affected by a statement. If
+		*			unbindColumns is set, the columns bound to the current result set are
+		*			unbound: Bind the columns of the next result set or use Rows() on it.
+		*			GetNrOfColumns() returns 0 if the next result is not a result set.
+		*			Once it returns false, the values of output parameters are available.
+		* \return	False if no more results are available, the cursor has been closed then.
+		* \throw	SqlResultException If the statement producing the next result failed.
+		*/
+		bool MoreResults(bool unbindColumns = true);
+
+
+		/*!
+		* \brief	Number of rows affected by the current result, using SQLRowCount.
+		* \return	-1 if the driver does not know the number, for example for most result sets.
+		* \throw	SqlResultException If SQLRowCount fails.
+		*/
+		SQLLEN GetRowCount() const;
+
+
+		/*!
+		* \brief	Execute statements using SQLExecDirect, in one round trip if the driver supports it.
+		* \details	If Database::GetSupportsBatches() is true, the statements are joined by ';'
+		*			and sent at once, then the result of every statement is read using
+		*			MoreResults(). Else every statement is executed on its own. Result sets
+		*			returned by the statements are discarded, the cursor is closed afterwards.
+		* \return	The number of rows affected by every statement, -1 if unknown. If the
+		*			driver returns less results than statements have been sent (for example
+		*			Microsoft SQL Server after SET NOCOUNT ON), the missing counts are -1.
+		* \throw	SqlResultException If a statement fails. The statements before have been executed.
+		*/
+		std::vector<SQLLEN> ExecuteBatch(const std::vector<std::string>& statements);
+
+
+		/*!
+		* \brief	Discard all remaining results of the statement executed, by calling
+		*			MoreResults() until it returns false.
+		* \details	Drivers only write the values of input/output and output parameters after
+		*			the last result of a procedure call has been processed. Call this after a
+		*			procedure call, once the result sets of interest have been read. Columns
+		*			bound are not unbound.
+		* \throw	SqlResultException If a statement producing one of the results failed.
+		*/
+		void FinishResults();
+
+
+		/*!
+		* \brief	Create the ODBC escape sequence calling procedureName, like
+		*			'{? = call procedureName(?, ?)}'.
+		* \param	procedureName	Name of the procedure, qualified and quoted as required.
+		* \param	nrOfParams		Number of parameter markers passed to the procedure.
+		* \param	returnValue		If true, a parameter marker for the return value is added:
+		*							It is parameter 1, bind it as ParameterDirection::OUTPUT.
+		*/
+		static std::string CreateCallStatement(const std::string& procedureName, SQLUSMALLINT nrOfParams, bool returnValue = false);
+
+
 		/*!
 		* \brief	Unbinds all columns bound to the handle held by this ExecutableStatement.
 		*/
@@ -253,18 +488,195 @@ namespace exodbc
 		bool SelectRelative(SQLLEN offset);
 
 
+		/*!
+		* \brief	Enable or disable bookmarks on the result sets of this statement.
+		* \details	Sets SQL_ATTR_USE_BOOKMARKS to SQL_UB_VARIABLE or SQL_UB_OFF, closing an open
+		*			cursor. If enabled, the bookmark column 0 is bound to a buffer of
+		*			MAX_BOOKMARK_LENGTH bytes held by this statement, filled on every fetch of a
+		*			single row. Bookmarks let a scrollable cursor return to a row in constant time,
+		*			without the driver counting rows like SelectAbsolute() might do.
+		*			Must be called before the statement is prepared. UnbindColumns() unbinds the
+		*			bookmark column, call SetUseBookmarks() again to bind it.
+		* \throw	Exception If setting the attribute or binding the column fails.
+		*/
+		void SetUseBookmarks(bool useBookmarks);
+
+
+		/*!
+		* \brief	Bind the bookmark column 0 to an array of one bookmark of elementLength bytes
+		*			per row of the rowset, for fetching blocks of rows.
+		* \details	Bookmarks must have been enabled using SetUseBookmarks(). Call after the
+		*			other columns have been bound, for example by Rows(), which unbinds the
+		*			bookmark column bound by SetUseBookmarks(). The bookmarks of the rows are then
+		*			fetched into pBookmarks and can be used by BulkOperations() with
+		*			SQL_UPDATE_BY_BOOKMARK or SQL_DELETE_BY_BOOKMARK. GetBookmark() is not
+		*			available while the array is bound.
+		* \throw	Exception If binding the column fails.
+		*/
+		void BindBookmarkArray(SQLPOINTER pBookmarks, SQLLEN elementLength, SQLLEN* pIndicators);
+
+
+		/*!
+		* \brief	True if SetUseBookmarks() has enabled bookmarks and the bookmark column is bound.
+		*/
+		bool GetUseBookmarks() const noexcept { return m_useBookmarks; };
+
+
+		/*!
+		* \brief	Get the bookmark of the current row.
+		* \throw	Exception If bookmarks are not enabled or no row is selected.
+		*/
+		Bookmark GetBookmark() const;
+
+
+		/*!
+		* \brief	Fetch the row with the passed bookmark, or the row offset rows away from it,
+		*			using SQLFetchScroll with SQL_FETCH_BOOKMARK.
+		* \details	The cursor must be scrollable and bookmarks must be enabled. A bookmark is
+		*			only valid on the result set it has been read from, unless the driver
+		*			reports SQL_BP_CLOSE in SQL_BOOKMARK_PERSISTENCE.
+		* \return	True if the row has been fetched, false if no such row is available.
+		*/
+		bool SelectBookmark(const Bookmark& bookmark, SQLLEN offset = 0);
+
+
+		/*!
+		* \brief	Asynchronous version of ExecuteDirect().
+		* \details	Sets SQL_ATTR_ASYNC_ENABLE to SQL_ASYNC_ENABLE_ON and calls SQLExecDirect.
+		*			If the statement is still executing, the AsyncStatementPoller drives it
+		*			to completion. SQL_ATTR_ASYNC_ENABLE is set back to SQL_ASYNC_ENABLE_OFF
+		*			before the returned future becomes ready.
+		*			If the Database does not report support for asynchronous execution on
+		*			statement level, or enabling it fails, the statement is executed blocking
+		*			and a future that is already ready is returned.
+		* \return	Future that holds a SqlResultException if executing failed.
+		*/
+		std::future<void> ExecuteDirectAsync(const std::string& sqlstmt);
+
+
+		/*!
+		* \brief	Same as ExecuteDirectAsync(), but onComplete is called once the statement has completed.
+		* \details	onComplete is called from the thread of the AsyncStatementPoller, or before this
+		*			function returns if the statement was executed blocking. It must not throw.
+		*/
+		void ExecuteDirectAsync(const std::string& sqlstmt, ExecuteCompletionHandler onComplete);
+
+
+		/*!
+		* \brief	Asynchronous version of ExecutePrepared().
+		* \see		ExecuteDirectAsync()
+		*/
+		std::future<void> ExecutePreparedAsync();
+
+
+		/*!
+		* \brief	Same as ExecutePreparedAsync(), but onComplete is called once the statement has completed.
+		* \see		ExecuteDirectAsync(const std::string&, ExecuteCompletionHandler)
+		*/
+		void ExecutePreparedAsync(ExecuteCompletionHandler onComplete);
+
+
+		/*!
+		* \brief	Asynchronous version of SelectNext().
+		* \see		ExecuteDirectAsync()
+		* \return	Future that holds true if a record has been fetched, false if no record is available.
+		*/
+		std::future<bool> SelectNextAsync();
+
+
+		/*!
+		* \brief	Same as SelectNextAsync(), but onComplete is called once fetching has completed.
+		* \see		ExecuteDirectAsync(const std::string&, ExecuteCompletionHandler)
+		*/
+		void SelectNextAsync(FetchCompletionHandler onComplete);
+
+
+		/*!
+		* \brief	Asynchronous version of RowBlock::NextBlock() on a block of a RowRange returned by Rows().
+		* \details	SQLFetch is only called if the current block of block has been consumed, else
+		*			the future is ready when this function returns. block must stay alive until
+		*			the future is ready.
+		* \see		ExecuteDirectAsync()
+		* \return	Future that holds true if a block has been fetched, false if no more rows are available.
+		*/
+		std::future<bool> NextBlockAsync(RowBlock& block);
+
+
+		/*!
+		* \brief	Same as NextBlockAsync(), but onComplete is called once fetching has completed.
+		* \see		ExecuteDirectAsync(const std::string&, ExecuteCompletionHandler)
+		*/
+		void NextBlockAsync(RowBlock& block, FetchCompletionHandler onComplete);
+
+
+		/*!
+		* \brief	Get an input range over the rows of the result set currently open.
+		* \details	All columns of the result set are described and bound as arrays of blockSize
+		*			elements, using the SQL C Type the Sql2BufferTypeMap of the Database maps the
+		*			SQL Type of the column to. Columns bound before are unbound.
+		*			The returned RowRange refers to the handle of this ExecutableStatement and
+		*			must not outlive it. Call no other function of this ExecutableStatement
+		*			until the RowRange has been destroyed.
+		*			Character and binary columns of unknown size or of a size larger than
+		*			SQL_NO_TOTAL_BUFFER_LENGTH (LOB columns like LONGTEXT or CLOB) are bound with
+		*			SQL_NO_TOTAL_BUFFER_LENGTH elements: Longer values are truncated, read such
+		*			columns using SQLGetData.
+		* \see		RowRange
+		* \throw	Exception If describing or binding the columns fails.
+		*/
+		RowRange Rows(SQLULEN blockSize = DEFAULT_ROW_BLOCK_SIZE);
+
+
+		/*!
+		* \brief	Same as Rows(SQLULEN), but the columns are bound as described by the passed columns.
+		* \details	columns[0] is bound to the first column of the result set, etc.
+		*/
+		RowRange Rows(const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize = DEFAULT_ROW_BLOCK_SIZE);
+
+
 	protected:
 		void SetCursorOptions(bool scrollableCursor);
 
 		bool SelectFetchScroll(SQLSMALLINT fetchOrientation, SQLLEN fetchOffset);
 
+		/*!
+		* \brief	Begin an operation on m_pExecution, creating it on first use.
+		* \details	The parameters currently bound are passed along with bytesBound. For
+		*			ExecutionType::ExecutePreparedArray, pass the parameter arrays and their size.
+		* \return	True if any ExecutionSink is interested in the operation.
+		*/
+		bool BeginExecution(ExecutionType type, const std::string& sql, SQLLEN bytesBound, const std::vector<ParameterArray>* pParamArrays = NULL, SQLULEN paramSetSize = 1) const;
+
+		/*!
+		* \brief	End the operation on m_pExecution, if any.
+		*/
+		void EndExecution() const noexcept;
+
+		/*!
+		* \brief	Unbind the parameter arrays bound by ExecutePreparedArray() and set the
+		*			statement back to execute with one set of parameters.
+		*/
+		void ResetParameterArrays() noexcept;
+
 		SqlStmtHandlePtr m_pHStmt;	///< The statement we operate on
+		SqlStmtHandlePoolPtr m_pHStmtPool;	///< The pool m_pHStmt has been acquired from
 		ConstDatabasePtr m_pDb;
 		bool m_isPrepared;
 		bool m_scrollableCursor;
 
 		bool m_boundColumns;
 		bool m_boundParams;
+
+		std::string m_preparedSql;
+		SQLLEN m_boundColumnBytes;
+		SQLLEN m_boundParamBytes;
+
+		bool m_useBookmarks;
+		SQLCHAR m_bookmarkBuffer[MAX_BOOKMARK_LENGTH];	///< Bound as column 0 if m_useBookmarks is set.
+		SQLLEN m_bookmarkCb;
+
+		std::map<SQLUSMALLINT, ColumnBufferPtrVariant> m_boundParamBuffers;	///< Passed to the ExecutionSinks when an execution begins.
+		mutable ExecutionTrackerPtr m_pExecution;	///< Reports to the StatementMetricsRegistry, SlowQueryLog and SessionRecorder. Created on the first prepare or execution.
 	};
 
 	typedef std::shared_ptr<ExecutableStatement> ExecutableStatementPtr;
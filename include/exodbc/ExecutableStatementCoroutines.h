@@ -0,0 +1,347 @@
+﻿/*!
+* \file ExecutableStatementCoroutines.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file with C++20 coroutine awaitables for the ExecutableStatement.
+* \copyright GNU Lesser General Public License Version 3
+*
+* All types declared in this file are header-only and only available if the
+* compiler including this header supports coroutines. EXODBC_HAS_COROUTINES is
+* set to 1 in that case. Configure with the CMake option EXODBC_ENABLE_COROUTINES
+* to build libexodbc and exodbctest as C++20, which also runs the coroutine tests.
+*
+* Note that the exodbc headers expect u8-literals to be of type char: When
+* compiling with C++20, disable char8_t using -fno-char8_t (gcc, clang) or
+* /Zc:char8_t- (msvc).
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ExecutableStatement.h"
+
+// Other headers
+// System headers
+#if defined(__has_include)
+	#if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+		#define EXODBC_HAS_COROUTINES 1
+	#endif
+#endif
+
+#if defined(EXODBC_ENABLE_COROUTINES) && !EXODBC_HAS_COROUTINES
+	#error "EXODBC_ENABLE_COROUTINES is set, but the compiler does not support coroutines"
+#endif
+
+#if EXODBC_HAS_COROUTINES
+
+#include <coroutine>
+#include <atomic>
+#include <exception>
+#include <string>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Classes
+	// -------
+
+	/*!
+	* \class InlineExecutor
+	* \brief Executor that resumes the awaiting coroutine directly on the thread that
+	*		completed the operation (the thread of the AsyncStatementPoller).
+	* \details An executor is any copyable type that can be called with a std::coroutine_handle<>
+	*		and arranges for that handle to be resumed, for example by posting it to the
+	*		event loop of the application.
+	*/
+	struct InlineExecutor
+	{
+		void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+	};
+
+
+	/*!
+	* \class AsyncStatementAwaitable
+	* \brief Base for the awaitables: Starts the operation on suspension and resumes
+	*		the awaiting coroutine through TExecutor once the operation has completed.
+	* \details If the operation completes before the coroutine has been suspended (for
+	*		example because it was executed blocking as the driver does not support
+	*		asynchronous execution), the coroutine is not suspended at all.
+	*/
+	template<typename TExecutor>
+	class AsyncStatementAwaitable
+	{
+	public:
+		AsyncStatementAwaitable(ExecutableStatement& stmt, TExecutor executor)
+			: m_stmt(stmt)
+			, m_executor(executor)
+			, m_completed(false)
+			, m_fetched(false)
+		{ }
+
+		bool await_ready() const noexcept { return false; }
+
+	protected:
+		/*!
+		* \brief Called from the completion handler. Whoever comes second, this
+		*		or Suspended(), continues the coroutine.
+		*/
+		void Completed(std::coroutine_handle<> handle, bool fetched, std::exception_ptr pEx)
+		{
+			m_fetched = fetched;
+			m_pEx = pEx;
+			if (m_completed.exchange(true))
+			{
+				m_executor(handle);
+			}
+		}
+
+		/*!
+		* \brief Called at the end of await_suspend(). Returns false if the operation has
+		*		already completed and the coroutine must not be suspended.
+		*/
+		bool Suspended() noexcept
+		{
+			return !m_completed.exchange(true);
+		}
+
+		void RethrowIfFailed() const
+		{
+			if (m_pEx)
+			{
+				std::rethrow_exception(m_pEx);
+			}
+		}
+
+		ExecutableStatement& m_stmt;
+		TExecutor m_executor;
+		std::atomic<bool> m_completed;
+		bool m_fetched;
+		std::exception_ptr m_pEx;
+	};
+
+
+	/*!
+	* \class ExecuteAwaitable
+	* \brief Awaitable executing a statement using ExecuteDirectAsync() or, if no
+	*		statement is passed, ExecutePreparedAsync().
+	* \details co_await throws the SqlResultException if executing failed.
+	*/
+	template<typename TExecutor>
+	class ExecuteAwaitable
+		: public AsyncStatementAwaitable<TExecutor>
+	{
+	public:
+		ExecuteAwaitable(ExecutableStatement& stmt, const std::string& sqlstmt, TExecutor executor)
+			: AsyncStatementAwaitable<TExecutor>(stmt, executor)
+			, m_sqlstmt(sqlstmt)
+		{ }
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			auto onComplete = [this, handle](std::exception_ptr pEx) { this->Completed(handle, false, pEx); };
+			if (m_sqlstmt.empty())
+				this->m_stmt.ExecutePreparedAsync(onComplete);
+			else
+				this->m_stmt.ExecuteDirectAsync(m_sqlstmt, onComplete);
+			return this->Suspended();
+		}
+
+		void await_resume() const
+		{
+			this->RethrowIfFailed();
+		}
+
+	private:
+		std::string m_sqlstmt;
+	};
+
+
+	/*!
+	* \class FetchAwaitable
+	* \brief Awaitable fetching the next record using SelectNextAsync().
+	* \details co_await returns true if a record has been fetched into the bound
+	*		columns, false if no more records are available. It throws the
+	*		SqlResultException if fetching failed.
+	*/
+	template<typename TExecutor>
+	class FetchAwaitable
+		: public AsyncStatementAwaitable<TExecutor>
+	{
+	public:
+		FetchAwaitable(ExecutableStatement& stmt, TExecutor executor)
+			: AsyncStatementAwaitable<TExecutor>(stmt, executor)
+		{ }
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			this->m_stmt.SelectNextAsync([this, handle](bool fetched, std::exception_ptr pEx) { this->Completed(handle, fetched, pEx); });
+			return this->Suspended();
+		}
+
+		bool await_resume() const
+		{
+			this->RethrowIfFailed();
+			return this->m_fetched;
+		}
+	};
+
+
+	/*!
+	* \class BlockFetchAwaitable
+	* \brief Awaitable moving a RowBlock to its next block using NextBlockAsync().
+	* \details co_await returns true if the next block holds rows, false if no more
+	*		rows are available. It throws the SqlResultException if fetching failed.
+	*/
+	template<typename TExecutor>
+	class BlockFetchAwaitable
+		: public AsyncStatementAwaitable<TExecutor>
+	{
+	public:
+		BlockFetchAwaitable(ExecutableStatement& stmt, RowBlock& block, TExecutor executor)
+			: AsyncStatementAwaitable<TExecutor>(stmt, executor)
+			, m_block(block)
+		{ }
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			this->m_stmt.NextBlockAsync(m_block, [this, handle](bool fetched, std::exception_ptr pEx) { this->Completed(handle, fetched, pEx); });
+			return this->Suspended();
+		}
+
+		bool await_resume() const
+		{
+			this->RethrowIfFailed();
+			return this->m_fetched;
+		}
+
+	private:
+		RowBlock& m_block;
+	};
+
+
+	/*!
+	* \class AsyncRowStream
+	* \brief Streams the records of the current result set of an ExecutableStatement
+	*		into the bound columns:
+	*		\code
+	*		AsyncRowStream<MyExecutor> rows(stmt, executor);
+	*		while (co_await rows.Next())
+	*		{
+	*			// read the bound columns
+	*		}
+	*		\endcode
+	*/
+	template<typename TExecutor = InlineExecutor>
+	class AsyncRowStream
+	{
+	public:
+		AsyncRowStream(ExecutableStatement& stmt, TExecutor executor = TExecutor())
+			: m_stmt(stmt)
+			, m_executor(executor)
+		{ }
+
+		/*!
+		* \brief Fetch the next record.
+		*/
+		FetchAwaitable<TExecutor> Next() { return FetchAwaitable<TExecutor>(m_stmt, m_executor); }
+
+	private:
+		ExecutableStatement& m_stmt;
+		TExecutor m_executor;
+	};
+
+
+	/*!
+	* \class AsyncBlockStream
+	* \brief Streams the rows of a RowRange returned by ExecutableStatement::Rows()
+	*		block by block, one asynchronous SQLFetch per block instead of per row:
+	*		\code
+	*		AsyncBlockStream<MyExecutor> blocks(stmt, stmt.Rows(), executor);
+	*		ColumnAccessor<SQLINTEGER> id = blocks.GetRange().GetAccessor<SQLINTEGER>(u8"idintegertypes");
+	*		while (co_await blocks.Next())
+	*		{
+	*			const RowBlock& block = blocks.GetBlock();
+	*			for (SQLULEN i = 0; i < block.GetRowsFetched(); ++i)
+	*			{
+	*				SQLINTEGER value = id(RowView(&block, i));
+	*			}
+	*		}
+	*		\endcode
+	*/
+	template<typename TExecutor = InlineExecutor>
+	class AsyncBlockStream
+	{
+	public:
+		AsyncBlockStream(ExecutableStatement& stmt, RowRange rows, TExecutor executor = TExecutor())
+			: m_stmt(stmt)
+			, m_rows(rows)
+			, m_executor(executor)
+		{ }
+
+		/*!
+		* \brief Move to the next block of rows.
+		*/
+		BlockFetchAwaitable<TExecutor> Next() { return BlockFetchAwaitable<TExecutor>(m_stmt, m_rows.GetBlock(), m_executor); }
+
+		/*!
+		* \brief The RowRange streamed, to create ColumnAccessors.
+		*/
+		const RowRange& GetRange() const noexcept { return m_rows; }
+
+		/*!
+		* \brief The block holding the rows fetched by the last Next().
+		*/
+		const RowBlock& GetBlock() const noexcept { return m_rows.GetBlock(); }
+
+	private:
+		ExecutableStatement& m_stmt;
+		RowRange m_rows;
+		TExecutor m_executor;
+	};
+
+
+	/*!
+	* \brief co_await the execution of sqlstmt on stmt, resuming through executor.
+	*/
+	template<typename TExecutor = InlineExecutor>
+	ExecuteAwaitable<TExecutor> AsyncExecuteDirect(ExecutableStatement& stmt, const std::string& sqlstmt, TExecutor executor = TExecutor())
+	{
+		exASSERT(!sqlstmt.empty());
+		return ExecuteAwaitable<TExecutor>(stmt, sqlstmt, executor);
+	}
+
+
+	/*!
+	* \brief co_await the execution of the statement prepared on stmt, resuming through executor.
+	*/
+	template<typename TExecutor = InlineExecutor>
+	ExecuteAwaitable<TExecutor> AsyncExecutePrepared(ExecutableStatement& stmt, TExecutor executor = TExecutor())
+	{
+		return ExecuteAwaitable<TExecutor>(stmt, std::string(), executor);
+	}
+
+
+	/*!
+	* \brief co_await fetching the next record on stmt, resuming through executor.
+	*/
+	template<typename TExecutor = InlineExecutor>
+	FetchAwaitable<TExecutor> AsyncSelectNext(ExecutableStatement& stmt, TExecutor executor = TExecutor())
+	{
+		return FetchAwaitable<TExecutor>(stmt, executor);
+	}
+
+
+	/*!
+	* \brief co_await moving block, a block of stmt, to its next block, resuming through executor.
+	*/
+	template<typename TExecutor = InlineExecutor>
+	BlockFetchAwaitable<TExecutor> AsyncNextBlock(ExecutableStatement& stmt, RowBlock& block, TExecutor executor = TExecutor())
+	{
+		return BlockFetchAwaitable<TExecutor>(stmt, block, executor);
+	}
+} // namespace exodbc
+
+#endif // EXODBC_HAS_COROUTINES
@@ -0,0 +1,163 @@
+﻿/*!
+* \file ExecutionScope.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the ExecutionTracker and ExecutionScope classes.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ExecutionSink.h"
+#include "StatementMetrics.h"
+
+// Other headers
+// System headers
+#include <memory>
+#include <vector>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+
+	/*!
+	* \class ExecutionTracker
+	*
+	* \brief Reports the prepares, executions and fetches of one statement to the ExecutionSinks.
+	* \details	Owns one sink per consumer: The StatementMetricsSink records on the
+	*			StatementMetricsRegistry, the SlowQueryTracker reports to the SlowQueryLog
+	*			and the SessionTracker writes to the SessionRecorder. Each sink decides
+	*			on its own in ExecutionSink::Begin() whether it is interested in an operation.
+	*			Used by ExecutableStatement, RowBlock and Database::ExecSql(), which
+	*			measure the time spent in the driver using an ExecutionScope.
+	*/
+	class EXODBCAPI ExecutionTracker
+	{
+	public:
+		ExecutionTracker();
+
+		ExecutionTracker(const ExecutionTracker& other) = delete;
+		ExecutionTracker& operator=(const ExecutionTracker& other) = delete;
+
+		/*!
+		* \brief	Calls End().
+		*/
+		~ExecutionTracker();
+
+
+		/*!
+		* \brief	Start an operation on all sinks. An operation not yet ended is ended first.
+		* \return	True if any sink is interested in the operation.
+		*/
+		bool Begin(const ExecutionContext& context);
+
+
+		/*!
+		* \brief	True if any sink is active.
+		*/
+		bool IsActive() const noexcept;
+
+
+		/*!
+		* \brief	Add time spent preparing or executing to all active sinks.
+		*/
+		void AddExecute(std::chrono::nanoseconds elapsed) noexcept;
+
+
+		/*!
+		* \brief	Add time spent fetching rows rows to all active sinks.
+		*/
+		void AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept;
+
+
+		/*!
+		* \brief	End the current operation on all sinks.
+		*/
+		void End() noexcept;
+
+
+		/*!
+		* \brief	Returns the StatementMetrics of the statement executed last, see StatementMetricsSink::GetMetrics().
+		*/
+		StatementMetricsPtr GetMetrics() const noexcept;
+
+	private:
+		std::vector<std::unique_ptr<ExecutionSink>> m_sinks;
+		StatementMetricsSink* m_pMetricsSink;	///< Owned by m_sinks.
+	};
+	typedef std::shared_ptr<ExecutionTracker> ExecutionTrackerPtr;
+
+
+	/*!
+	* \class ExecutionScope
+	*
+	* \brief Measures one call to the driver and reports it to an ExecutionTracker.
+	* \details	The clock is only read if the ExecutionTracker has an active sink, so disabled
+	*			metrics, slow query log and recorder do not cost more than testing a few flags.
+	*			The time is reported on Stop(), or when the scope is destroyed:
+	*			\code
+	*			ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Fetch);
+	*			SQLRETURN ret = SQLFetch(hStmt);
+	*			scope.SetFetched(SQL_SUCCEEDED(ret) ? 1 : 0, !SQL_SUCCEEDED(ret));
+	*			\endcode
+	*/
+	class EXODBCAPI ExecutionScope
+	{
+	public:
+		/*!
+		* \enum Phase
+		* \brief What is measured.
+		*/
+		enum class Phase
+		{
+			Execute,	///< Preparing or executing, reported using ExecutionTracker::AddExecute().
+			Fetch	///< Fetching, reported using ExecutionTracker::AddFetch().
+		};
+
+		/*!
+		* \brief	Start measuring, if pExecution has an active sink.
+		*/
+		ExecutionScope(ExecutionTrackerPtr pExecution, Phase phase);
+
+		ExecutionScope(const ExecutionScope& other) = delete;
+		ExecutionScope& operator=(const ExecutionScope& other) = delete;
+
+		/*!
+		* \brief	Calls Stop().
+		*/
+		~ExecutionScope();
+
+
+		/*!
+		* \brief	Set the number of rows fetched. If endOfResult is true, the operation
+		*			on the ExecutionTracker is ended once the fetch has been reported.
+		*/
+		void SetFetched(unsigned long long rows, bool endOfResult) noexcept { m_rows = rows; m_endOfResult = endOfResult; };
+
+
+		/*!
+		* \brief	Stop measuring and report the time spent. Does nothing if already stopped.
+		*/
+		void Stop() noexcept;
+
+	private:
+		ExecutionTrackerPtr m_pExecution;	///< Reset once stopped, or if no sink is active.
+		Phase m_phase;
+		std::chrono::steady_clock::time_point m_start;
+		unsigned long long m_rows;
+		bool m_endOfResult;
+	};
+} // namespace exodbc
@@ -0,0 +1,122 @@
+﻿/*!
+* \file ExecutionSink.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the ExecutionSink interface.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ColumnBuffer.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <map>
+#include <vector>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	struct ParameterArray;
+
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \enum ExecutionType
+	* \brief The operations reported to an ExecutionSink.
+	*/
+	enum class ExecutionType
+	{
+		Prepare,	///< A statement is prepared using SQLPrepare.
+		ExecuteDirect,	///< A statement is executed using SQLExecDirect.
+		ExecutePrepared,	///< A prepared statement is executed using SQLExecute.
+		ExecutePreparedArray	///< A prepared statement is executed using SQLExecute with arrays of parameters.
+	};
+
+
+	/*!
+	* \struct ExecutionContext
+	* \brief Describes an operation starting, passed to ExecutionSink::Begin().
+	* \details Only valid during the call to ExecutionSink::Begin().
+	*/
+	struct EXODBCAPI ExecutionContext
+	{
+		ExecutionContext(ExecutionType type, const std::string& sql)
+			: m_type(type)
+			, m_sql(sql)
+			, m_pParams(NULL)
+			, m_pParamArrays(NULL)
+			, m_paramSetSize(1)
+			, m_bytesBound(0)
+		{ };
+
+		ExecutionType m_type;	///< The operation.
+		const std::string& m_sql;	///< The SQL prepared or executed.
+		const std::map<SQLUSMALLINT, ColumnBufferPtrVariant>* m_pParams;	///< The parameters bound, or NULL if none are bound.
+		const std::vector<ParameterArray>* m_pParamArrays;	///< The parameter arrays bound for ExecutionType::ExecutePreparedArray, else NULL.
+		SQLULEN m_paramSetSize;	///< Number of elements of every parameter array, 1 if no arrays are bound.
+		SQLLEN m_bytesBound;	///< Sum of the sizes of the bound column and parameter buffers.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class ExecutionSink
+	*
+	* \brief Receives the prepares, executions and fetches of one statement.
+	* \details	An operation starts with Begin() and lasts until End(). In between, the time
+	*			spent preparing or executing is reported using AddExecute() and the time spent
+	*			fetching using AddFetch(). Fetches are also reported after End() while the
+	*			sink IsActive(), for example the fetches of a further result set.
+	*			Sinks are owned by an ExecutionTracker.
+	*/
+	class EXODBCAPI ExecutionSink
+	{
+	public:
+		virtual ~ExecutionSink() {};
+
+
+		/*!
+		* \brief	Start an operation.
+		* \return	True if the sink is interested in the operation.
+		*/
+		virtual bool Begin(const ExecutionContext& context) = 0;
+
+
+		/*!
+		* \brief	True if the sink wants AddExecute() and AddFetch() to be called.
+		*/
+		virtual bool IsActive() const noexcept = 0;
+
+
+		/*!
+		* \brief	Add time spent preparing or executing.
+		*/
+		virtual void AddExecute(std::chrono::nanoseconds elapsed) noexcept = 0;
+
+
+		/*!
+		* \brief	Add time spent fetching rows rows.
+		*/
+		virtual void AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept = 0;
+
+
+		/*!
+		* \brief	End the current operation. Does nothing if no operation has begun.
+		*/
+		virtual void End() noexcept = 0;
+	};
+} // namespace exodbc
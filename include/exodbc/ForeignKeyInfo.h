@@ -0,0 +1,231 @@
+﻿/*!
+* \file ForeignKeyInfo.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for ForeignKeyInfo.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "AssertionException.h"
+#include "SqlHandle.h"
+#include "SqlInfoProperty.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	/*!
+	* \class	ForeignKeyInfo
+	* \brief	One column of a foreign key as fetched using SQLForeignKeys.
+	* \details	The foreign key table references the primary key table: Rows of the primary
+	*			key table must exist before rows referencing them can be inserted into the
+	*			foreign key table.
+	* \see		DatabaseCatalog::ReadForeignKeyInfo()
+	* \see		https://docs.microsoft.com/en-us/sql/odbc/reference/syntax/sqlforeignkeys-function
+	*/
+	class EXODBCAPI ForeignKeyInfo
+	{
+	public:
+		/*!
+		* \enum		ReferentialAction
+		* \brief	Action applied to the foreign key table if a referenced row is updated or deleted.
+		*/
+		enum class ReferentialAction
+		{
+			CASCADE = SQL_CASCADE,	///< The foreign key is updated or the referencing row deleted.
+			RESTRICT = SQL_RESTRICT,	///< The operation on the primary key table is rejected.
+			SET_NULL = SQL_SET_NULL,	///< The foreign key is set to NULL.
+			NO_ACTION = SQL_NO_ACTION,	///< The operation on the primary key table is rejected.
+			SET_DEFAULT = SQL_SET_DEFAULT	///< The foreign key is set to its default value.
+		};
+
+
+		/*!
+		* \brief Default constructor, all members are set to empty values, null flags are set to true.
+		*/
+		ForeignKeyInfo();
+
+
+		/*!
+		* \brief Use passed values to init members. Null flags for catalogs, schemas, rules and key names are set.
+		*/
+		ForeignKeyInfo(const std::string& pkTableName, const std::string& pkColumnName, const std::string& fkTableName,
+			const std::string& fkColumnName, SQLSMALLINT keySequence);
+
+
+		/*!
+		* \brief Create from a statement that is assumed to hold the results of SQLForeignKeys. The cursor must
+		*		be positioned at the row and is not modified, but column values are read.
+		* \throw Exception If reading any value fails, or if props does not hold all required properties.
+		*/
+		ForeignKeyInfo(ConstSqlStmtHandlePtr pStmt, const SqlInfoProperties& props);
+
+
+		/*!
+		* \return Catalog name of the primary key table. Empty value might be returned.
+		*/
+		std::string GetPkCatalog() const noexcept { return m_pkCatalogName; };
+
+
+		/*!
+		* \return Schema name of the primary key table. Empty value might be returned.
+		*/
+		std::string GetPkSchema() const noexcept { return m_pkSchemaName; };
+
+
+		/*!
+		* \return Name of the primary key table.
+		*/
+		std::string GetPkTable() const noexcept { return m_pkTableName; };
+
+
+		/*!
+		* \return Name of the referenced primary key column.
+		*/
+		std::string GetPkColumnName() const noexcept { return m_pkColumnName; };
+
+
+		/*!
+		* \return Catalog name of the foreign key table. Empty value might be returned.
+		*/
+		std::string GetFkCatalog() const noexcept { return m_fkCatalogName; };
+
+
+		/*!
+		* \return Schema name of the foreign key table. Empty value might be returned.
+		*/
+		std::string GetFkSchema() const noexcept { return m_fkSchemaName; };
+
+
+		/*!
+		* \return Name of the foreign key table.
+		*/
+		std::string GetFkTable() const noexcept { return m_fkTableName; };
+
+
+		/*!
+		* \return Name of the foreign key column.
+		*/
+		std::string GetFkColumnName() const noexcept { return m_fkColumnName; };
+
+
+		/*!
+		* \return Column sequence number in the key, starting with 1 (0 if not set).
+		*/
+		SQLSMALLINT GetKeySequence() const noexcept { return m_keySequence; };
+
+
+		/*!
+		* \return Action applied to the foreign key table if a referenced primary key is updated.
+		* \throw AssertionException If the rule is not set.
+		*/
+		ReferentialAction GetUpdateRule() const { exASSERT(!m_isUpdateRuleNull); return (ReferentialAction) m_updateRule; };
+
+
+		/*!
+		* \return Action applied to the foreign key table if a referenced row is deleted.
+		* \throw AssertionException If the rule is not set.
+		*/
+		ReferentialAction GetDeleteRule() const { exASSERT(!m_isDeleteRuleNull); return (ReferentialAction) m_deleteRule; };
+
+
+		/*!
+		* \return Foreign key name.
+		* \throw AssertionException If IsFkNameNull().
+		*/
+		std::string GetFkName() const { exASSERT(!m_isFkNameNull); return m_fkName; };
+
+
+		/*!
+		* \return Name of the referenced primary key.
+		* \throw AssertionException If IsPkNameNull().
+		*/
+		std::string GetPkName() const { exASSERT(!m_isPkNameNull); return m_pkName; };
+
+
+		/*!
+		* \return SQL_INITIALLY_DEFERRED, SQL_INITIALLY_IMMEDIATE or SQL_NOT_DEFERRABLE.
+		* \throw AssertionException If the deferrability is not set.
+		*/
+		SQLSMALLINT GetDeferrability() const { exASSERT(!m_isDeferrabilityNull); return m_deferrability; };
+
+
+		/*!
+		* \return True if the primary key table has a catalog name.
+		*/
+		bool HasPkCatalog() const noexcept { return !m_isPkCatalogNull && !m_pkCatalogName.empty(); };
+
+
+		/*!
+		* \return True if the primary key table has a schema name.
+		*/
+		bool HasPkSchema() const noexcept { return !m_isPkSchemaNull && !m_pkSchemaName.empty(); };
+
+
+		/*!
+		* \return True if the foreign key table has a catalog name.
+		*/
+		bool HasFkCatalog() const noexcept { return !m_isFkCatalogNull && !m_fkCatalogName.empty(); };
+
+
+		/*!
+		* \return True if the foreign key table has a schema name.
+		*/
+		bool HasFkSchema() const noexcept { return !m_isFkSchemaNull && !m_fkSchemaName.empty(); };
+
+
+		/*!
+		* \brief True if null flag for FK_NAME is set.
+		*/
+		bool IsFkNameNull() const noexcept { return m_isFkNameNull; };
+
+
+		/*!
+		* \brief True if null flag for PK_NAME is set.
+		*/
+		bool IsPkNameNull() const noexcept { return m_isPkNameNull; };
+
+	private:
+		std::string		m_pkCatalogName;	///< PKTABLE_CAT [Nullable]. Primary key table catalog name.
+		std::string		m_pkSchemaName;	///< PKTABLE_SCHEM [Nullable]. Primary key table schema name.
+		std::string		m_pkTableName;	///< PKTABLE_NAME. Primary key table name.
+		std::string		m_pkColumnName;	///< PKCOLUMN_NAME. Primary key column name.
+		std::string		m_fkCatalogName;	///< FKTABLE_CAT [Nullable]. Foreign key table catalog name.
+		std::string		m_fkSchemaName;	///< FKTABLE_SCHEM [Nullable]. Foreign key table schema name.
+		std::string		m_fkTableName;	///< FKTABLE_NAME. Foreign key table name.
+		std::string		m_fkColumnName;	///< FKCOLUMN_NAME. Foreign key column name.
+		SQLSMALLINT		m_keySequence;	///< KEY_SEQ. Column sequence number in key (starting with 1).
+		SQLSMALLINT		m_updateRule;	///< UPDATE_RULE [Nullable]. Action applied on update.
+		SQLSMALLINT		m_deleteRule;	///< DELETE_RULE [Nullable]. Action applied on delete.
+		std::string		m_fkName;	///< FK_NAME [Nullable]. Foreign key name.
+		std::string		m_pkName;	///< PK_NAME [Nullable]. Primary key name.
+		SQLSMALLINT		m_deferrability;	///< DEFERRABILITY [Nullable]. Deferrability of the constraint.
+
+		bool			m_isPkCatalogNull;	///< True if PKTABLE_CAT is Null.
+		bool			m_isPkSchemaNull;	///< True if PKTABLE_SCHEM is Null.
+		bool			m_isFkCatalogNull;	///< True if FKTABLE_CAT is Null.
+		bool			m_isFkSchemaNull;	///< True if FKTABLE_SCHEM is Null.
+		bool			m_isUpdateRuleNull;	///< True if UPDATE_RULE is Null.
+		bool			m_isDeleteRuleNull;	///< True if DELETE_RULE is Null.
+		bool			m_isFkNameNull;	///< True if FK_NAME is Null.
+		bool			m_isPkNameNull;	///< True if PK_NAME is Null.
+		bool			m_isDeferrabilityNull;	///< True if DEFERRABILITY is Null.
+	};
+
+	/*!
+	* \typedef ForeignKeyInfoVector
+	* \brief std::vector of ForeignKeyInfo objects.
+	*/
+	typedef std::vector<ForeignKeyInfo> ForeignKeyInfoVector;
+}
@@ -0,0 +1,284 @@
+﻿/*!
+* \file IndexInfo.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for IndexInfo and TableStatistics.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "AssertionException.h"
+#include "SqlHandle.h"
+#include "SqlInfoProperty.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	/*!
+	* \class	IndexInfo
+	* \brief	One row of the result of SQLStatistics: Either a column of an index, or the
+	*			statistics of the table itself (if GetType() is IndexType::TABLE_STAT).
+	* \see		DatabaseCatalog::ReadStatistics()
+	* \see		https://docs.microsoft.com/en-us/sql/odbc/reference/syntax/sqlstatistics-function
+	*/
+	class EXODBCAPI IndexInfo
+	{
+	public:
+		/*!
+		* \enum		IndexType
+		* \brief	Type of information returned by a row of SQLStatistics.
+		*/
+		enum class IndexType
+		{
+			TABLE_STAT = SQL_TABLE_STAT,	///< Statistics of the table itself, no index.
+			CLUSTERED = SQL_INDEX_CLUSTERED,	///< A clustered index.
+			HASHED = SQL_INDEX_HASHED,	///< A hashed index.
+			OTHER = SQL_INDEX_OTHER	///< Any other type of index.
+		};
+
+
+		/*!
+		* \brief Default constructor, all members are set to empty values, null flags are set to true.
+		*/
+		IndexInfo();
+
+
+		/*!
+		* \brief Create from a statement that is assumed to hold the results of SQLStatistics. The cursor must
+		*		be positioned at the row and is not modified, but column values are read.
+		* \throw Exception If reading any value fails, or if props does not hold all required properties.
+		*/
+		IndexInfo(ConstSqlStmtHandlePtr pStmt, const SqlInfoProperties& props);
+
+
+		/*!
+		* \return Catalog name. Empty value might be returned.
+		* \see HasCatalog()
+		*/
+		std::string GetCatalog() const noexcept { return m_catalogName; };
+
+
+		/*!
+		* \return Schema name. Empty value might be returned.
+		* \see HasSchema()
+		*/
+		std::string GetSchema() const noexcept { return m_schemaName; };
+
+
+		/*!
+		* \return Table name.
+		*/
+		std::string GetTable() const noexcept { return m_tableName; };
+
+
+		/*!
+		* \return Type of the row.
+		*/
+		IndexType GetType() const noexcept { return m_type; };
+
+
+		/*!
+		* \return True if the row holds the statistics of the table itself, and not a column of an index.
+		*/
+		bool IsTableStatistics() const noexcept { return m_type == IndexType::TABLE_STAT; };
+
+
+		/*!
+		* \return True if the index does not allow duplicate values.
+		* \throw AssertionException If the row holds the statistics of the table.
+		*/
+		bool IsUnique() const { exASSERT(!m_isNonUniqueNull); return !m_nonUnique; };
+
+
+		/*!
+		* \return Identifier used to qualify the index name when doing a DROP INDEX. Empty value might be returned.
+		*/
+		std::string GetIndexQualifier() const noexcept { return m_indexQualifier; };
+
+
+		/*!
+		* \return Index name.
+		* \throw AssertionException If the row holds the statistics of the table.
+		*/
+		std::string GetIndexName() const { exASSERT(!m_isIndexNameNull); return m_indexName; };
+
+
+		/*!
+		* \return Position of the column in the index, starting with 1.
+		* \throw AssertionException If the row holds the statistics of the table.
+		*/
+		SQLSMALLINT GetOrdinalPosition() const { exASSERT(!m_isOrdinalPositionNull); return m_ordinalPosition; };
+
+
+		/*!
+		* \return Column name. Can also be an expression, like SALARY + BENEFITS.
+		* \throw AssertionException If the row holds the statistics of the table.
+		*/
+		std::string GetColumnName() const { exASSERT(!m_isColumnNameNull); return m_columnName; };
+
+
+		/*!
+		* \return 'A' for ascending, 'D' for descending or an empty string if the sort sequence is not supported.
+		*/
+		std::string GetAscOrDesc() const noexcept { return m_ascOrDesc; };
+
+
+		/*!
+		* \return Number of rows in the table, or number of unique values in the index.
+		* \throw AssertionException If the value is not available.
+		*/
+		SQLINTEGER GetCardinality() const { exASSERT(!m_isCardinalityNull); return m_cardinality; };
+
+
+		/*!
+		* \return Number of pages used to store the table or the index.
+		* \throw AssertionException If the value is not available.
+		*/
+		SQLINTEGER GetPages() const { exASSERT(!m_isPagesNull); return m_pages; };
+
+
+		/*!
+		* \return Filter condition of a filtered index. Empty value might be returned.
+		*/
+		std::string GetFilterCondition() const noexcept { return m_filterCondition; };
+
+
+		/*!
+		* \return True if null flag for Schema is not set and Schema Name is not empty.
+		*/
+		bool HasSchema() const noexcept { return !m_isSchemaNull && !m_schemaName.empty(); };
+
+
+		/*!
+		* \return True if null flag for Catalog is not set and Catalog Name is not empty.
+		*/
+		bool HasCatalog() const noexcept { return !m_isCatalogNull && !m_catalogName.empty(); };
+
+
+		/*!
+		* \return True if the cardinality is available.
+		*/
+		bool HasCardinality() const noexcept { return !m_isCardinalityNull; };
+
+
+		/*!
+		* \return True if the number of pages is available.
+		*/
+		bool HasPages() const noexcept { return !m_isPagesNull; };
+
+	private:
+		std::string		m_catalogName;	///< TABLE_CAT [Nullable]. Catalog name.
+		std::string		m_schemaName;	///< TABLE_SCHEM [Nullable]. Schema name.
+		std::string		m_tableName;	///< TABLE_NAME. Table name.
+		SQLSMALLINT		m_nonUnique;	///< NON_UNIQUE [Nullable]. SQL_TRUE if the index allows duplicates. Null for SQL_TABLE_STAT.
+		std::string		m_indexQualifier;	///< INDEX_QUALIFIER [Nullable]. Identifier to qualify the index name.
+		std::string		m_indexName;	///< INDEX_NAME [Nullable]. Index name. Null for SQL_TABLE_STAT.
+		IndexType		m_type;	///< TYPE. Type of information returned.
+		SQLSMALLINT		m_ordinalPosition;	///< ORDINAL_POSITION [Nullable]. Position of the column in the index. Null for SQL_TABLE_STAT.
+		std::string		m_columnName;	///< COLUMN_NAME [Nullable]. Column name. Null for SQL_TABLE_STAT.
+		std::string		m_ascOrDesc;	///< ASC_OR_DESC [Nullable]. Sort sequence of the column.
+		SQLINTEGER		m_cardinality;	///< CARDINALITY [Nullable]. Rows of the table or unique values of the index.
+		SQLINTEGER		m_pages;	///< PAGES [Nullable]. Pages used to store the table or the index.
+		std::string		m_filterCondition;	///< FILTER_CONDITION [Nullable]. Filter condition of a filtered index.
+
+		bool			m_isCatalogNull;	///< True if TABLE_CAT is Null.
+		bool			m_isSchemaNull;	///< True if TABLE_SCHEM is Null.
+		bool			m_isNonUniqueNull;	///< True if NON_UNIQUE is Null.
+		bool			m_isIndexQualifierNull;	///< True if INDEX_QUALIFIER is Null.
+		bool			m_isIndexNameNull;	///< True if INDEX_NAME is Null.
+		bool			m_isOrdinalPositionNull;	///< True if ORDINAL_POSITION is Null.
+		bool			m_isColumnNameNull;	///< True if COLUMN_NAME is Null.
+		bool			m_isAscOrDescNull;	///< True if ASC_OR_DESC is Null.
+		bool			m_isCardinalityNull;	///< True if CARDINALITY is Null.
+		bool			m_isPagesNull;	///< True if PAGES is Null.
+		bool			m_isFilterConditionNull;	///< True if FILTER_CONDITION is Null.
+	};
+
+	/*!
+	* \typedef IndexInfoVector
+	* \brief std::vector of IndexInfo objects.
+	*/
+	typedef std::vector<IndexInfo> IndexInfoVector;
+
+
+	/*!
+	* \class	TableStatistics
+	* \brief	The result of SQLStatistics for one table: The statistics of the table itself
+	*			and the columns of its indexes.
+	* \see		DatabaseCatalog::ReadStatistics()
+	*/
+	class EXODBCAPI TableStatistics
+	{
+	public:
+		/*!
+		* \brief Create empty statistics, without cardinality or pages.
+		*/
+		TableStatistics();
+
+
+		/*!
+		* \brief Create from the rows returned by SQLStatistics. The row of type IndexType::TABLE_STAT
+		*		(if any) is used for the cardinality and pages, all other rows are index columns.
+		*/
+		TableStatistics(const IndexInfoVector& rows);
+
+
+		/*!
+		* \return True if the driver reported the number of rows of the table.
+		*/
+		bool HasCardinality() const noexcept { return m_tableStat.HasCardinality(); };
+
+
+		/*!
+		* \return Number of rows of the table, as reported by the driver. The value might be outdated.
+		* \throw AssertionException If HasCardinality() is false.
+		*/
+		SQLINTEGER GetCardinality() const { return m_tableStat.GetCardinality(); };
+
+
+		/*!
+		* \return True if the driver reported the number of pages of the table.
+		*/
+		bool HasPages() const noexcept { return m_tableStat.HasPages(); };
+
+
+		/*!
+		* \return Number of pages used to store the table.
+		* \throw AssertionException If HasPages() is false.
+		*/
+		SQLINTEGER GetPages() const { return m_tableStat.GetPages(); };
+
+
+		/*!
+		* \return The columns of all indexes, ordered by NON_UNIQUE, TYPE, INDEX_QUALIFIER, INDEX_NAME and ORDINAL_POSITION.
+		*/
+		const IndexInfoVector& GetIndexColumns() const noexcept { return m_indexColumns; };
+
+
+		/*!
+		* \return The names of all indexes, in the order they appear in GetIndexColumns().
+		*/
+		std::vector<std::string> GetIndexNames() const;
+
+
+		/*!
+		* \return The columns of the index indexName, ordered by their ordinal position.
+		*/
+		IndexInfoVector GetIndexColumns(const std::string& indexName) const;
+
+	private:
+		IndexInfo m_tableStat;	///< The row of type IndexType::TABLE_STAT, or a default IndexInfo.
+		IndexInfoVector m_indexColumns;	///< All other rows.
+	};
+}
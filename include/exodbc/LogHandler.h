@@ -12,11 +12,16 @@
 // Same component headers
 #include "exOdbc.h"
 #include "LogManager.h"
+#include "BoundedMpscQueue.h"
 
 // Other headers
 // System headers
 #include <memory>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
 
 // Forward declarations
 // --------------------
@@ -51,6 +56,8 @@ namespace exodbc
 		LogHandlerBase()
 			: m_showFileInfo(true)
 			, m_showLogLevel(true)
+			, m_hasCustomLogLevel(false)
+			, m_customLogLevel(LogLevel::Debug)
 		{};
 
 		virtual ~LogHandlerBase() {};
@@ -214,4 +221,101 @@ namespace exodbc
 	};
 
 	typedef std::shared_ptr<FileLogHandler> FileLogHandlerPtr;
+
+
+	/*!
+	* \class	AsyncFileLogHandler
+	* \brief	A LogHandler that writes all messages nicely formated to a file from a background thread.
+	* \details	OnLogMessage() formats the message on the calling thread and pushes it into a
+	*			bounded lock-free queue, it never waits for the file. A background thread pops
+	*			the messages in batches and writes them to the file, which is opened on the first
+	*			message written and flushed whenever the queue runs empty, or after every batch
+	*			while a thread waits in Flush().
+	*
+	*			If the queue is full, the OverflowPolicy decides: With OverflowPolicy::Drop the
+	*			message is discarded and counted in GetDroppedCount(), with OverflowPolicy::Block the
+	*			calling thread waits until the writer has made room.
+	*
+	*			On destruction, all queued messages are written before the thread is stopped.
+	*/
+	class EXODBCAPI AsyncFileLogHandler
+		: public LogHandler
+		, public LogHandlerBase
+	{
+	public:
+		/*!
+		* \enum	OverflowPolicy
+		* \brief	What to do with a message if the queue is full.
+		*/
+		enum class OverflowPolicy
+		{
+			Drop,	///< Discard the message and increment the dropped counter.
+			Block	///< Wait until the background thread has made room.
+		};
+
+		/*!
+		* \brief	Default number of messages the queue can hold.
+		*/
+		static const size_t DEFAULT_QUEUE_CAPACITY = 8192;
+
+		AsyncFileLogHandler() = delete;
+		AsyncFileLogHandler(const AsyncFileLogHandler& other) = delete;
+
+		/*!
+		* \brief	Start the background thread writing to filepath.
+		* \param	queueCapacity Must be a power of two.
+		*/
+		AsyncFileLogHandler(const std::string& filepath, bool prependTimestamp, OverflowPolicy policy = OverflowPolicy::Drop, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+		/*!
+		* \brief	Writes all queued messages, then stops the background thread.
+		*/
+		virtual ~AsyncFileLogHandler();
+
+		virtual void OnLogMessage(LogLevel level, const std::string& msg, const std::string& filename = u8"", int line = 0, const std::string& functionname = u8"") const override;
+		virtual bool operator==(const LogHandler& other) const override;
+
+
+		/*!
+		* \brief	Block until all messages queued before this call have been written and flushed.
+		*/
+		void Flush() const;
+
+
+		std::string GetFilepath() const noexcept { return m_filepath; };
+		OverflowPolicy GetOverflowPolicy() const noexcept { return m_policy; };
+
+		/*!
+		* \brief	Number of messages discarded because the queue was full.
+		*/
+		unsigned long long GetDroppedCount() const noexcept { return m_droppedCount.load(); };
+
+		/*!
+		* \brief	Number of messages written to the file and flushed.
+		*/
+		unsigned long long GetWrittenCount() const noexcept { return m_writtenCount.load(); };
+
+	private:
+		void Run();
+
+		std::string m_filepath;
+		bool m_prependTimestamp;
+		OverflowPolicy m_policy;
+
+		mutable BoundedMpscQueue<std::string> m_queue;
+		mutable std::atomic<unsigned long long> m_queuedCount;	///< Messages pushed into m_queue.
+		mutable std::atomic<unsigned long long> m_droppedCount;
+		std::atomic<unsigned long long> m_writtenCount;	///< Messages written and flushed.
+		mutable std::atomic<unsigned int> m_flushWaiters;	///< Threads waiting in Flush(), the writer flushes after every batch while set.
+		std::atomic<bool> m_writerIdle;	///< Set by the writer before it waits for new messages.
+		std::atomic<bool> m_stop;
+
+		std::ofstream m_filestream;	///< Only touched by the writer thread.
+		std::thread m_thread;
+		mutable std::mutex m_mutex;	///< Only used for the condition variables, never while pushing.
+		mutable std::condition_variable m_queuedCondition;	///< Wakes up an idle writer.
+		mutable std::condition_variable m_writtenCondition;	///< Signaled after every batch written or flushed.
+	};
+
+	typedef std::shared_ptr<AsyncFileLogHandler> AsyncFileLogHandlerPtr;
 }
@@ -16,6 +16,30 @@
 // System headers
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <memory>
+
+/*!
+* \def EXODBC_MIN_LOG_LEVEL
+* \brief	Log messages with a LogLevel below this value are compiled out by the LOG_* macros:
+*			Their message is never built, no matter what global LogLevel is set at runtime.
+* \details	Defaults to EXODBC_DEFAULT_MIN_LOG_LEVEL. Define it before including any exodbc header
+*			(for the library itself using the cmake variable EXODBC_MIN_LOG_LEVEL) to change it.
+*/
+
+/*!
+* \def EXODBC_DEFAULT_MIN_LOG_LEVEL
+* \brief	The value of LogLevel::Debug (3) if NDEBUG is not defined, as in the Debug
+*			configuration of cmake, and of LogLevel::Info (5) else.
+*/
+#ifdef NDEBUG
+	#define EXODBC_DEFAULT_MIN_LOG_LEVEL 5
+#else
+	#define EXODBC_DEFAULT_MIN_LOG_LEVEL 3
+#endif
+#ifndef EXODBC_MIN_LOG_LEVEL
+	#define EXODBC_MIN_LOG_LEVEL EXODBC_DEFAULT_MIN_LOG_LEVEL
+#endif
 
 // Forward declarations
 // --------------------
@@ -39,6 +63,15 @@ namespace exodbc
 	};
 
 
+	/*!
+	* \brief	True if messages with the passed level are not compiled out by EXODBC_MIN_LOG_LEVEL.
+	*/
+	constexpr bool IsLogLevelCompiledIn(LogLevel level) noexcept
+	{
+		return static_cast<int>(level) >= EXODBC_MIN_LOG_LEVEL;
+	}
+
+
 	/*!
 	* \class	LogLevelSetter
 	* \brief	On construction, remembers the active global LogLevel, then 
@@ -67,6 +100,10 @@ namespace exodbc
 	*			will only forward messages to its registered LogHandlers that
 	*			have a logLevel greater or equal than the currently set 
 	*			global LogLevel.
+	*			The global level is held in an atomic: The LOG_* macros test it
+	*			before the message is built, and only then call LogMessage().
+	*			Messages are dispatched to a snapshot of the registered
+	*			LogHandlers, no lock is taken while logging.
 	*/
 	class EXODBCAPI LogManager
 	{
@@ -147,26 +184,40 @@ namespace exodbc
 		void SetGlobalLogLevel(LogLevel level) noexcept;
 
 		/*!
-		* \brief
+		* \brief Get the global log level.
 		*/
 		LogLevel GetGlobalLogLevel() const noexcept;
 
+		/*!
+		* \brief True if a message with the passed level would be forwarded to the LogHandlers.
+		*/
+		bool IsLogLevelEnabled(LogLevel level) const noexcept { return level >= m_globalLogLevel.load(std::memory_order_relaxed); };
+
 	private:
-		std::vector<LogHandlerPtr> m_logHandlers;
-		mutable std::mutex m_logHandlersMutex;
+		typedef std::shared_ptr<const std::vector<LogHandlerPtr>> LogHandlersPtr;
+
+		LogHandlersPtr GetLogHandlersSnapshot() const noexcept;
 
-		LogLevel m_globalLogLevel;
-		mutable std::mutex m_globalLogLevelMutex;
+		LogHandlersPtr m_pLogHandlers;	///< Replaced as a whole on every change, read using std::atomic_load.
+		mutable std::mutex m_logHandlersMutex;	///< Serializes changes to m_pLogHandlers.
+
+		std::atomic<LogLevel> m_globalLogLevel;
 
 		mutable std::mutex m_stdoutMutex;
 		mutable std::mutex m_stderrMutex;
 	};
 }
 
-// Generic Log-entry
+// True if a message of logLevel would be logged. Use it to guard building expensive messages
+#define EXODBC_LOG_ENABLED(logLevel) \
+	(exodbc::IsLogLevelCompiledIn(logLevel) && exodbc::LogManager::Get().IsLogLevelEnabled(logLevel))
+
+// Generic Log-entry. msg is only evaluated if the message will be logged
 #define LOG_MSG(logLevel, msg) \
 	do { \
-		exodbc::LogManager::Get().LogMessage(logLevel, msg, __FILE__, __LINE__, __FUNCTION__); \
+		if (EXODBC_LOG_ENABLED(logLevel)) { \
+			exodbc::LogManager::Get().LogMessage(logLevel, msg, __FILE__, __LINE__, __FUNCTION__); \
+		} \
 	} while( 0 )
 
 // Generic Log-entry shortcuts
@@ -20,8 +20,10 @@
 // ------------
 #define LOG_ODBC_MSG(hEnv, hDbc, hStmt, hDesc, ret, SqlFunction, msg, logLevel) \
 	do { \
-		std::string logOdbcMsgMsg = exodbc::ErrorHelper::FormatOdbcMessages(hEnv, hDbc, hStmt, hDesc, ret, #SqlFunction, msg); \
-		LOG_MSG(logLevel, logOdbcMsgMsg); \
+		if (EXODBC_LOG_ENABLED(logLevel)) { \
+			std::string logOdbcMsgMsg = exodbc::ErrorHelper::FormatOdbcMessages(hEnv, hDbc, hStmt, hDesc, ret, #SqlFunction, msg); \
+			exodbc::LogManager::Get().LogMessage(logLevel, logOdbcMsgMsg, __FILE__, __LINE__, __FUNCTION__); \
+		} \
 	} while( 0 )
 
 // ODBC-Loggers, with a message
@@ -0,0 +1,338 @@
+﻿/*!
+* \file OdbcTrace.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the OdbcTracer and its latency histograms.
+* \copyright GNU Lesser General Public License Version 3
+*
+* Every call exodbc makes to an ODBC function goes through TRACE_ODBC_CALL.
+* While the OdbcTracer is disabled that is one additional test of an atomic flag.
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct OdbcCallStatistics
+	* \brief The values of the OdbcCallStats of one ODBC function at a given point in time.
+	* \details The percentiles are the upper bounds of the LatencyHistogram buckets they fall into.
+	*/
+	struct EXODBCAPI OdbcCallStatistics
+	{
+		OdbcCallStatistics()
+			: m_callCount(0)
+			, m_errorCount(0)
+			, m_totalTime(0)
+			, m_maxTime(0)
+			, m_p50(0)
+			, m_p90(0)
+			, m_p99(0)
+			, m_p999(0)
+		{ };
+
+		std::string m_functionName;	///< Name of the ODBC function, like "SQLFetch".
+		unsigned long long m_callCount;	///< Number of calls.
+		unsigned long long m_errorCount;	///< Number of calls that returned SQL_ERROR or SQL_INVALID_HANDLE.
+		std::chrono::nanoseconds m_totalTime;	///< Time spent in the driver.
+		std::chrono::nanoseconds m_maxTime;	///< Longest call.
+		std::chrono::nanoseconds m_p50;	///< Median.
+		std::chrono::nanoseconds m_p90;	///< 90th percentile.
+		std::chrono::nanoseconds m_p99;	///< 99th percentile.
+		std::chrono::nanoseconds m_p999;	///< 99.9th percentile.
+	};
+
+
+	/*!
+	* \struct OdbcTraceSample
+	* \brief One call recorded in the sample log of the OdbcTracer.
+	*/
+	struct EXODBCAPI OdbcTraceSample
+	{
+		OdbcTraceSample()
+			: m_ret(SQL_SUCCESS)
+			, m_elapsed(0)
+		{ };
+
+		std::string m_functionName;	///< Name of the ODBC function called.
+		SQLRETURN m_ret;	///< Value returned by the call.
+		std::chrono::system_clock::time_point m_start;	///< Time the call was started.
+		std::chrono::nanoseconds m_elapsed;	///< Duration of the call.
+		std::thread::id m_threadId;	///< Thread that made the call.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class LatencyHistogram
+	*
+	* \brief A lock-free histogram with log-linear buckets, like a HdrHistogram with a
+	*		precision of one significant binary digit plus SUB_BUCKET_BITS bits.
+	* \details	Values below SUB_BUCKET_COUNT are recorded exactly. Above, every power of two
+	*			is split into SUB_BUCKET_COUNT buckets of equal width, so a value is known within
+	*			12.5%. The full range of unsigned long long is covered by BUCKET_COUNT buckets,
+	*			recording is one atomic increment.
+	*/
+	class EXODBCAPI LatencyHistogram
+	{
+	public:
+		static const unsigned SUB_BUCKET_BITS = 3;
+		static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+		static const size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+		LatencyHistogram();
+
+		LatencyHistogram(const LatencyHistogram& other) = delete;
+		LatencyHistogram& operator=(const LatencyHistogram& other) = delete;
+
+
+		/*!
+		* \brief	Record one value.
+		*/
+		void Record(unsigned long long value) noexcept;
+
+
+		/*!
+		* \brief	Number of values recorded.
+		*/
+		unsigned long long GetCount() const noexcept;
+
+
+		/*!
+		* \brief	Number of values recorded in the passed bucket.
+		*/
+		unsigned long long GetBucketCount(size_t bucket) const;
+
+
+		/*!
+		* \brief	Get the upper bound of the bucket holding the value at the passed percentile (0 - 100).
+		* \return	0 if no values have been recorded.
+		*/
+		unsigned long long GetValueAtPercentile(double percentile) const noexcept;
+
+
+		/*!
+		* \brief	Forget all values recorded.
+		*/
+		void Reset() noexcept;
+
+
+		/*!
+		* \brief	Index of the bucket value is recorded in.
+		*/
+		static size_t GetBucketIndex(unsigned long long value) noexcept;
+
+
+		/*!
+		* \brief	Smallest value recorded in the passed bucket.
+		*/
+		static unsigned long long GetBucketLowerBound(size_t bucket) noexcept;
+
+
+		/*!
+		* \brief	Largest value recorded in the passed bucket.
+		*/
+		static unsigned long long GetBucketUpperBound(size_t bucket) noexcept;
+
+	private:
+		std::atomic<unsigned long long> m_buckets[BUCKET_COUNT];
+		std::atomic<unsigned long long> m_count;
+	};
+
+
+	/*!
+	* \class OdbcCallStats
+	*
+	* \brief Counters and the LatencyHistogram (in nanoseconds) of all calls to one ODBC function.
+	* \details Get instances from the OdbcTracer. The class is thread-safe.
+	*/
+	class EXODBCAPI OdbcCallStats
+	{
+	public:
+		OdbcCallStats(const std::string& functionName);
+
+		OdbcCallStats(const OdbcCallStats& other) = delete;
+		OdbcCallStats& operator=(const OdbcCallStats& other) = delete;
+
+
+		/*!
+		* \brief	Record one call that returned ret.
+		*/
+		void Record(std::chrono::nanoseconds elapsed, SQLRETURN ret) noexcept;
+
+
+		/*!
+		* \brief	Get the current values.
+		*/
+		OdbcCallStatistics GetStatistics() const;
+
+
+		/*!
+		* \brief	Get the histogram of the call durations in nanoseconds.
+		*/
+		const LatencyHistogram& GetHistogram() const noexcept { return m_histogram; };
+
+
+		/*!
+		* \brief	Forget all calls recorded.
+		*/
+		void Reset() noexcept;
+
+
+		const std::string& GetFunctionName() const noexcept { return m_functionName; };
+
+	private:
+		const std::string m_functionName;
+		std::atomic<unsigned long long> m_errorCount;
+		std::atomic<long long> m_totalNs;
+		std::atomic<long long> m_maxNs;
+		LatencyHistogram m_histogram;
+	};
+
+
+	/*!
+	* \class OdbcTracer
+	*
+	* \brief Records the duration of the calls exodbc makes to the ODBC functions.
+	* \details	Unlike the trace of the driver manager (see Environment::SetTracefile()),
+	*			the OdbcTracer does not write anything per call: It keeps a call count,
+	*			an error count and a LatencyHistogram per ODBC function. The time spent in
+	*			the driver can be compared with the time spent in exodbc and the application.
+	*
+	*			Optionally, the last calls can be kept in a bounded sample log, see SetSampleLog().
+	*
+	*			Tracing is disabled by default and can be switched on and off at any time.
+	*			The class is thread-safe. Use Get() to get the instance used by exodbc.
+	*/
+	class EXODBCAPI OdbcTracer
+	{
+	public:
+		OdbcTracer();
+
+		OdbcTracer(const OdbcTracer& other) = delete;
+		OdbcTracer& operator=(const OdbcTracer& other) = delete;
+
+
+		/*!
+		* \brief	Get the instance used by exodbc.
+		* \details	The instance is never destroyed, as handles might be freed during static destruction.
+		*/
+		static OdbcTracer& Get();
+
+
+		/*!
+		* \brief	Enable or disable tracing.
+		*/
+		void SetEnabled(bool enable) noexcept { m_enabled.store(enable, std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	True if tracing is enabled.
+		*/
+		bool IsEnabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Get the OdbcCallStats of the passed function, creating them if required.
+		* \details	The returned reference stays valid as long as the OdbcTracer exists.
+		*/
+		OdbcCallStats& GetCallStats(const std::string& functionName);
+
+
+		/*!
+		* \brief	Call call and record its duration and result on stats.
+		*/
+		template<typename TCall>
+		SQLRETURN Trace(OdbcCallStats& stats, TCall call)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			SQLRETURN ret = call();
+			std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+			stats.Record(elapsed, ret);
+			if (m_sampleCapacity.load(std::memory_order_relaxed) > 0)
+			{
+				AddSample(stats, ret, elapsed);
+			}
+			return ret;
+		};
+
+
+		/*!
+		* \brief	Get the values of all functions called so far, ordered by function name.
+		*/
+		std::vector<OdbcCallStatistics> GetStatistics() const;
+
+
+		/*!
+		* \brief	Reset all counters and histograms and clear the sample log.
+		*/
+		void Reset();
+
+
+		/*!
+		* \brief	Keep the last capacity calls that took at least minElapsed in the sample log.
+		* \details	Set capacity to 0 to disable the sample log (the default). Changing the
+		*			settings clears the sample log.
+		*/
+		void SetSampleLog(size_t capacity, std::chrono::nanoseconds minElapsed = std::chrono::nanoseconds(0));
+
+
+		/*!
+		* \brief	Get the calls in the sample log, oldest first.
+		*/
+		std::vector<OdbcTraceSample> GetSamples() const;
+
+	private:
+		void AddSample(const OdbcCallStats& stats, SQLRETURN ret, std::chrono::nanoseconds elapsed);
+
+		std::atomic<bool> m_enabled;
+
+		std::map<std::string, std::unique_ptr<OdbcCallStats>> m_stats;
+		mutable std::mutex m_statsMutex;
+
+		std::atomic<size_t> m_sampleCapacity;
+		std::chrono::nanoseconds m_sampleMinElapsed;
+		std::vector<OdbcTraceSample> m_samples;
+		size_t m_nextSample;
+		mutable std::mutex m_samplesMutex;
+	};
+
+} // namespace exodbc
+
+
+/*!
+* \brief	Call the ODBC function func with the passed arguments and return its SQLRETURN.
+*			If the OdbcTracer is enabled, the call is recorded.
+* \details	The OdbcCallStats of func are looked up once per call site.
+*/
+#define TRACE_ODBC_CALL(func, ...) \
+	(::exodbc::OdbcTracer::Get().IsEnabled() \
+		? ::exodbc::OdbcTracer::Get().Trace( \
+			[]() -> ::exodbc::OdbcCallStats& { static ::exodbc::OdbcCallStats& stats = ::exodbc::OdbcTracer::Get().GetCallStats(#func); return stats; }(), \
+			[&]() -> SQLRETURN { return func(__VA_ARGS__); }) \
+		: func(__VA_ARGS__))
@@ -0,0 +1,244 @@
+﻿/*!
+* \file ParallelTableScan.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the ParallelTableScan class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Database.h"
+#include "Table.h"
+#include "RowRange.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct ScanPartition
+	* \brief A range of the values of the partition column read by one connection of a ParallelTableScan.
+	*/
+	struct EXODBCAPI ScanPartition
+	{
+		ScanPartition()
+			: m_index(0)
+			, m_lowerBound(0)
+			, m_upperBound(0)
+			, m_bounded(false)
+		{ };
+
+		size_t m_index;	///< Zero-based index of the partition. Partitions are ordered by their bounds.
+		SQLBIGINT m_lowerBound;	///< Smallest value of the partition column in this partition.
+		SQLBIGINT m_upperBound;	///< Largest value of the partition column in this partition.
+		bool m_bounded;	///< False if the partition reads all rows, because no values have been found to split.
+		std::string m_whereStatement;	///< The where clause selecting the rows of the partition, without 'WHERE'.
+	};
+
+
+	/*!
+	* \struct ParallelScanResult
+	* \brief Summary of a ParallelTableScan::Run().
+	*/
+	struct EXODBCAPI ParallelScanResult
+	{
+		ParallelScanResult()
+			: m_rows(0)
+			, m_duration(0)
+		{ };
+
+		unsigned long long m_rows;	///< Number of rows passed to the consumer.
+		std::vector<unsigned long long> m_partitionRows;	///< Number of rows read per partition.
+		std::chrono::nanoseconds m_duration;	///< Time from creating the partitions until the last row has been consumed.
+	};
+
+
+	/*!
+	* \typedef ConnectionFactory
+	* \brief Opens a new connection to the data source of a Table.
+	*/
+	typedef std::function<DatabasePtr()> ConnectionFactory;
+
+
+	/*!
+	* \typedef ParallelScanConsumer
+	* \brief Called by a ParallelTableScan for every row read, with the index of the partition the row belongs to.
+	*/
+	typedef std::function<void(size_t partitionIndex, const RowView& row)> ParallelScanConsumer;
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class ParallelTableScan
+	*
+	* \brief Reads all rows of a Table on several connections and threads in parallel.
+	* \details	The values of an integer column, by default the first primary key column,
+	*			are split into GetPartitionCount() ranges of equal width between the
+	*			smallest and the largest value, queried using MIN() and MAX(). Every range
+	*			is read on a connection and a thread of its own, using Table::Rows() with
+	*			the columns of the Table. Without a connection factory, the connections
+	*			are opened using Database::OpenNewConnection() on the Database of the Table.
+	*
+	*			If not ordered, the consumer is called from the threads reading the
+	*			partitions, concurrently, as soon as a row has been fetched. The consumer
+	*			must be thread-safe, the partition index passed can be used to keep state
+	*			per partition. This is the fastest way to read a Table.
+	*
+	*			If ordered, every partition is read ordered by the partition column and
+	*			the consumer is called on the thread calling Run(), with all rows in the
+	*			order of the partition column: First all rows of the first partition, then
+	*			all rows of the second one, and so on. While the consumer processes a
+	*			partition, the following partitions are executed and fetched in parallel,
+	*			up to GetPrefetchBlocks() blocks per partition are buffered.
+	*
+	*			The ranges have equal width, not an equal number of rows: If the values
+	*			are not distributed evenly, some partitions take longer than others.
+	*			Rows where a nullable partition column is NULL belong to the first
+	*			partition, if ordered they are passed first or last within that partition,
+	*			depending on where the database sorts NULL values.
+	*			The Table must be open and must not be modified while the scan runs.
+	*/
+	class EXODBCAPI ParallelTableScan
+	{
+	public:
+		/*!
+		* \brief	Default number of blocks buffered per partition by an ordered scan.
+		*/
+		static const size_t DEFAULT_PREFETCH_BLOCKS = 4;
+
+		ParallelTableScan() = delete;
+
+		/*!
+		* \brief	Create a scan reading table. The table must be kept alive while the scan is used.
+		* \details	The partition count defaults to the number of hardware threads.
+		*/
+		ParallelTableScan(const Table& table);
+
+		ParallelTableScan(const ParallelTableScan& other) = delete;
+		ParallelTableScan& operator=(const ParallelTableScan& other) = delete;
+
+
+		/*!
+		* \brief	Set the number of partitions, and therefore of connections and threads.
+		*/
+		void SetPartitionCount(size_t partitionCount);
+
+
+		/*!
+		* \brief	Get the number of partitions.
+		*/
+		size_t GetPartitionCount() const noexcept { return m_partitionCount; };
+
+
+		/*!
+		* \brief	Set the index of the ColumnBuffer of the Table to split into partitions.
+		* \details	The column must be bound as an integer. Defaults to the first primary key column.
+		* \throw	Exception If the Table has no such ColumnBuffer.
+		*/
+		void SetPartitionColumn(SQLUSMALLINT columnIndex);
+
+
+		/*!
+		* \brief	Get the index of the ColumnBuffer of the Table to split into partitions.
+		* \throw	Exception If no column has been set and the Table has no primary key column.
+		*/
+		SQLUSMALLINT GetPartitionColumn() const;
+
+
+		/*!
+		* \brief	Only read the rows matching whereStatement. Do not include 'WHERE'.
+		*/
+		void SetWhere(const std::string& whereStatement) { m_whereStatement = whereStatement; };
+
+
+		/*!
+		* \brief	If set to true, the consumer is called with all rows ordered by the
+		*			partition column, on the thread calling Run(). Defaults to false.
+		*/
+		void SetOrdered(bool ordered) noexcept { m_ordered = ordered; };
+
+
+		/*!
+		* \brief	True if rows are passed ordered by the partition column.
+		*/
+		bool GetOrdered() const noexcept { return m_ordered; };
+
+
+		/*!
+		* \brief	Set the number of rows fetched with one call to SQLFetch. Defaults to DEFAULT_ROW_BLOCK_SIZE.
+		*/
+		void SetBlockSize(SQLULEN blockSize);
+
+
+		/*!
+		* \brief	Set the maximum number of blocks buffered per partition by an ordered scan.
+		*/
+		void SetPrefetchBlocks(size_t prefetchBlocks);
+
+
+		/*!
+		* \brief	Set the function used to open the connection of every partition.
+		*			The function is called from the threads reading the partitions.
+		*/
+		void SetConnectionFactory(ConnectionFactory factory) { m_connectionFactory = factory; };
+
+
+		/*!
+		* \brief	Query the smallest and largest value of the partition column and split
+		*			them into GetPartitionCount() partitions.
+		* \details	Less partitions are returned if there are less distinct values than
+		*			partitions. If the Table has no matching rows, one unbounded partition
+		*			is returned. If the partition column is ColumnFlag::CF_NULLABLE, the rows
+		*			where it is NULL are read by the first partition.
+		* \throw	Exception If querying fails.
+		* \throw	NotSupportedException If the partition column is not bound as an integer.
+		*/
+		std::vector<ScanPartition> CreatePartitions() const;
+
+
+		/*!
+		* \brief	Read all partitions and pass every row to consumer.
+		* \details	Returns once all partitions have been read. If reading a partition or
+		*			the consumer fails, the remaining partitions are stopped and the first
+		*			exception is rethrown once all threads have ended.
+		* \throw	Exception If reading fails, or whatever the consumer throws.
+		*/
+		ParallelScanResult Run(const ParallelScanConsumer& consumer);
+
+	private:
+		struct ScanState;
+
+		void ReadPartition(const ScanPartition& partition, const ParallelScanConsumer& consumer, ScanState& state) const;
+		void ConsumeOrdered(const ParallelScanConsumer& consumer, ScanState& state) const;
+
+		const Table& m_table;
+		size_t m_partitionCount;
+		SQLUSMALLINT m_partitionColumn;
+		bool m_havePartitionColumn;
+		std::string m_whereStatement;
+		bool m_ordered;
+		SQLULEN m_blockSize;
+		size_t m_prefetchBlocks;
+		ConnectionFactory m_connectionFactory;
+	};
+} // namespace exodbc
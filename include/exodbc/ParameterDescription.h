@@ -23,6 +23,18 @@
 
 namespace exodbc
 {
+	/*!
+	* \enum ParameterDirection
+	* \brief Direction of a parameter, passed as InputOutputType to SQLBindParameter.
+	*/
+	enum class ParameterDirection
+	{
+		INPUT = SQL_PARAM_INPUT,	///< The value is sent to the database.
+		INPUT_OUTPUT = SQL_PARAM_INPUT_OUTPUT,	///< The value is sent to the database and replaced by the value the procedure returns.
+		OUTPUT = SQL_PARAM_OUTPUT	///< The value is returned by the procedure, for example its return value.
+	};
+
+
 	/*!
 	* \class ParameterDescription
 	* \brief Holds the description of a parameter fetched using SQLDescribeParam.
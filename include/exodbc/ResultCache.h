@@ -0,0 +1,349 @@
+﻿/*!
+* \file ResultCache.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the ResultCache class and the CachedResults it holds.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ColumnBuffer.h"
+#include "RowRange.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+namespace exodbc
+{
+	class Database;
+	typedef std::shared_ptr<const Database> ConstDatabasePtr;
+}
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct ResultCacheStatistics
+	* \brief Counters of a ResultCache, see ResultCache::GetStatistics().
+	*/
+	struct EXODBCAPI ResultCacheStatistics
+	{
+		ResultCacheStatistics()
+			: m_hits(0)
+			, m_misses(0)
+			, m_evictions(0)
+			, m_expirations(0)
+			, m_invalidations(0)
+			, m_entries(0)
+			, m_memoryUsage(0)
+		{ };
+
+		unsigned long long m_hits;	///< Number of results returned from the cache.
+		unsigned long long m_misses;	///< Number of results read from the database.
+		unsigned long long m_evictions;	///< Number of entries removed to stay within the memory budget.
+		unsigned long long m_expirations;	///< Number of entries removed because their time to live had passed.
+		unsigned long long m_invalidations;	///< Number of entries removed by Invalidate() or Clear().
+		size_t m_entries;	///< Number of entries currently cached.
+		size_t m_memoryUsage;	///< Bytes currently used by the cached entries.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class CachedResult
+	*
+	* \brief The rows of a result set, stored column by column.
+	* \details	Values of fixed length are stored in one array per column, like a RowBlock
+	*			holds them. Values of SQL_C_CHAR, SQL_C_WCHAR and SQL_C_BINARY columns are
+	*			stored one after the other using only the bytes of the value (plus a
+	*			terminating zero for character columns), not the full buffer length the
+	*			column has been fetched with.
+	*
+	*			A CachedResult is immutable once it has been handed out by a ResultCache
+	*			and can be read from several threads.
+	*/
+	class EXODBCAPI CachedResult
+	{
+	public:
+		/*!
+		* \brief	Create an empty result with the passed columns.
+		*/
+		CachedResult(const std::vector<RowColumnDefinition>& columns);
+
+		CachedResult(const CachedResult& other) = delete;
+		CachedResult& operator=(const CachedResult& other) = delete;
+
+
+		/*!
+		* \brief	Append the rows of the current block of block.
+		* \details	The columns of block must match the columns of this result.
+		*/
+		void Append(const RowBlock& block);
+
+
+		/*!
+		* \brief	Release the memory reserved but not used by Append().
+		*/
+		void ShrinkToFit();
+
+
+		/*!
+		* \brief	Number of rows.
+		*/
+		SQLULEN GetRowCount() const noexcept { return m_rowCount; };
+
+
+		/*!
+		* \brief	Number of columns.
+		*/
+		SQLUSMALLINT GetColumnCount() const noexcept { return (SQLUSMALLINT)m_columns.size(); };
+
+
+		/*!
+		* \brief	Definition of the column at the passed zero-based columnIndex.
+		*/
+		const RowColumnDefinition& GetColumnDefinition(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(columnIndex < m_columns.size());
+			return m_columns[columnIndex].m_definition;
+		};
+
+
+		/*!
+		* \brief	Return the zero-based index of the column with the passed queryName.
+		* \throw	NotFoundException If no such column exists.
+		*/
+		SQLUSMALLINT GetColumnIndex(const std::string& queryName) const;
+
+
+		/*!
+		* \brief	True if the value of column columnIndex in row rowIndex is NULL.
+		*/
+		bool IsNull(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const { return GetLength(columnIndex, rowIndex) == SQL_NULL_DATA; };
+
+
+		/*!
+		* \brief	Length / Indicator value of column columnIndex in row rowIndex, as it has been fetched.
+		*/
+		SQLLEN GetLength(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+		{
+			exASSERT(columnIndex < m_columns.size());
+			exASSERT(rowIndex < m_rowCount);
+			return m_columns[columnIndex].m_indicators[rowIndex];
+		};
+
+
+		/*!
+		* \brief	Raw pointer to the value of column columnIndex in row rowIndex.
+		*/
+		const SQLCHAR* GetData(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Get the value of column columnIndex in row rowIndex as T.
+		* \details	T must match the SQL C Type of the column, see RowValueTraits.
+		* \throw	AssertionException If T does not match.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		template<typename T>
+		const T& Get(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+		{
+			exASSERT(columnIndex < m_columns.size());
+			exASSERT(RowValueTraits<T>::Accepts(m_columns[columnIndex].m_definition.m_sqlCType));
+			ThrowIfNull(columnIndex, rowIndex);
+			return *reinterpret_cast<const T*>(GetData(columnIndex, rowIndex));
+		};
+
+
+		/*!
+		* \brief	Get the value of a SQL_C_CHAR column as a zero-terminated string.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		const SQLCHAR* GetChars(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Get the value of a SQL_C_WCHAR column as a zero-terminated string.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		const SQLWCHAR* GetWChars(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Get the value of a SQL_C_CHAR column as std::string.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		std::string GetString(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Number of bytes stored for the value of a SQL_C_CHAR, SQL_C_WCHAR or
+		*			SQL_C_BINARY column, without the terminating zero.
+		*/
+		SQLLEN GetStoredLength(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+
+		/*!
+		* \brief	Approximate number of bytes used by this result.
+		*/
+		size_t GetMemorySize() const noexcept;
+
+	private:
+		struct CachedColumn
+		{
+			RowColumnDefinition m_definition;
+			SQLLEN m_elementLength;	///< Length of one value as fetched.
+			SQLLEN m_terminatorLength;	///< Bytes of the terminating zero, 0 for binary and fixed length values.
+			bool m_variableLength;	///< If true, m_offsets holds the start of every value in m_data.
+			std::vector<SQLCHAR> m_data;
+			std::vector<size_t> m_offsets;
+			std::vector<SQLLEN> m_indicators;
+		};
+
+		void ThrowIfNull(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const;
+
+		std::vector<CachedColumn> m_columns;
+		SQLULEN m_rowCount;
+	};
+	typedef std::shared_ptr<const CachedResult> CachedResultPtr;
+
+
+	/*!
+	* \class ResultCache
+	*
+	* \brief Caches the results of read-only queries, keyed by their SQL and parameter values.
+	* \details	Select() returns the cached result of a query if the same SQL has been
+	*			selected with the same parameter values and columns before, else it executes
+	*			the query and stores the result as CachedResult. Entries are removed:
+	*			- After the time to live has passed since they have been read from the database.
+	*			- If the least recently used entries exceed the memory budget.
+	*			- If a table the query depends on is written.
+	*
+	*			Set the cache on a Database using Database::SetResultCache(). Inserting,
+	*			updating or deleting through a Table on that Database (or on a connection
+	*			created from it using Database::OpenNewConnection(), which shares the cache)
+	*			then invalidates the entries depending on the table. Committing the
+	*			transaction invalidates them again, as other connections might have cached
+	*			the old rows before the write became visible. Rolling back a transaction
+	*			clears the cache. Writes through Database::ExecSql(), other
+	*			connections or other applications are not seen: Call Invalidate() or rely
+	*			on the time to live.
+	*
+	*			Tables are compared by their name without catalog, schema or quotes,
+	*			ignoring the case. The class is thread-safe.
+	*/
+	class EXODBCAPI ResultCache
+	{
+	public:
+		/*!
+		* \brief	Create a cache using at most memoryBudget bytes.
+		* \details	Entries expire timeToLive after they have been read from the database.
+		*			If timeToLive is zero, entries never expire.
+		*/
+		ResultCache(size_t memoryBudget, std::chrono::milliseconds timeToLive);
+
+		ResultCache(const ResultCache& other) = delete;
+		ResultCache& operator=(const ResultCache& other) = delete;
+
+
+		/*!
+		* \brief	Return the result of sql bound to params from the cache, or execute it on pDb.
+		* \details	The result set is fetched into the passed columns. tables lists the tables
+		*			the result depends on: Writing any of them invalidates the entry. A result
+		*			read while one of its tables is invalidated is returned, but not cached.
+		* \throw	Exception If executing or fetching fails.
+		*/
+		CachedResultPtr Select(ConstDatabasePtr pDb, const std::string& sql, const std::vector<RowColumnDefinition>& columns,
+			const std::vector<std::string>& tables, const std::vector<ColumnBufferPtrVariant>& params = std::vector<ColumnBufferPtrVariant>());
+
+
+		/*!
+		* \brief	Remove all entries depending on tableName.
+		*/
+		void Invalidate(const std::string& tableName);
+
+
+		/*!
+		* \brief	Remove all entries.
+		*/
+		void Clear();
+
+
+		/*!
+		* \brief	Get the counters of this cache.
+		*/
+		ResultCacheStatistics GetStatistics() const;
+
+
+		/*!
+		* \brief	Maximum number of bytes used by the cached entries.
+		*/
+		size_t GetMemoryBudget() const noexcept { return m_memoryBudget; };
+
+
+		/*!
+		* \brief	Time after which entries expire, zero if they never expire.
+		*/
+		std::chrono::milliseconds GetTimeToLive() const noexcept { return m_timeToLive; };
+
+
+		/*!
+		* \brief	Build the key of a query from its SQL, the columns it is fetched into
+		*			and the raw values of its parameters.
+		*/
+		static std::string BuildKey(const std::string& sql, const std::vector<RowColumnDefinition>& columns, const std::vector<ColumnBufferPtrVariant>& params);
+
+
+		/*!
+		* \brief	Name of a table as compared by Invalidate(): Without catalog, schema
+		*			and quotes, in upper case.
+		*/
+		static std::string NormalizeTableName(const std::string& tableName);
+
+	private:
+		typedef std::chrono::steady_clock Clock;
+
+		struct Entry
+		{
+			std::string m_key;
+			CachedResultPtr m_pResult;
+			std::vector<std::string> m_tables;
+			Clock::time_point m_readAt;
+			size_t m_size;
+		};
+		typedef std::list<Entry> EntryList;
+
+		void Erase(EntryList::iterator it);
+
+		size_t m_memoryBudget;
+		std::chrono::milliseconds m_timeToLive;
+
+		EntryList m_lru;	///< Most recently used entry first.
+		std::unordered_map<std::string, EntryList::iterator> m_entries;
+		std::map<std::string, unsigned long long> m_tableEpochs;	///< Incremented on every invalidation of a table.
+		unsigned long long m_clearEpoch;	///< Incremented on every Clear().
+		ResultCacheStatistics m_statistics;
+		mutable std::mutex m_mutex;
+	};
+	typedef std::shared_ptr<ResultCache> ResultCachePtr;
+} // namespace exodbc
@@ -0,0 +1,619 @@
+﻿/*!
+* \file RowRange.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the RowRange class and its helpers.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "SqlHandle.h"
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "ExecutionScope.h"
+#include "ParameterDescription.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+
+// Forward declarations
+// --------------------
+namespace exodbc
+{
+	class ExecutableStatement;
+	typedef std::shared_ptr<ExecutableStatement> ExecutableStatementPtr;
+}
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	/*!
+	* \brief Default number of rows fetched with one call to SQLFetch by a RowRange.
+	*/
+	const SQLULEN DEFAULT_ROW_BLOCK_SIZE = 64;
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct RowColumnDefinition
+	* \brief Describes how a result set column is bound by a RowRange.
+	*/
+	struct EXODBCAPI RowColumnDefinition
+	{
+		RowColumnDefinition()
+			: m_sqlCType(SQL_UNKNOWN_TYPE)
+			, m_nrOfElements(1)
+			, m_columnSize(0)
+			, m_decimalDigits(0)
+		{ };
+
+		RowColumnDefinition(const std::string& queryName, SQLSMALLINT sqlCType, SQLLEN nrOfElements = 1, SQLINTEGER columnSize = 0, SQLSMALLINT decimalDigits = 0)
+			: m_queryName(queryName)
+			, m_sqlCType(sqlCType)
+			, m_nrOfElements(nrOfElements)
+			, m_columnSize(columnSize)
+			, m_decimalDigits(decimalDigits)
+		{ };
+
+		std::string m_queryName;	///< Name of the column, used by RowRange::GetColumnIndex().
+		SQLSMALLINT m_sqlCType;	///< SQL C Type to bind the column as.
+		SQLLEN m_nrOfElements;	///< Number of characters (including the terminating 0) or bytes for SQL_C_CHAR, SQL_C_WCHAR and SQL_C_BINARY. Ignored for other types.
+		SQLINTEGER m_columnSize;	///< Precision, only used for SQL_C_NUMERIC.
+		SQLSMALLINT m_decimalDigits;	///< Scale, only used for SQL_C_NUMERIC.
+	};
+
+
+	/*!
+	* \struct RowValueTraits
+	* \brief Maps the type T read by RowView::Get<T>() to the SQL C Types it may be read from.
+	* \details The value types match the ones used by the ColumnBuffer typedefs: For example
+	*			SQLINTEGER is used for both SQL_C_SLONG and SQL_C_ULONG.
+	*/
+	template<typename T>
+	struct RowValueTraits
+	{
+		static bool Accepts(SQLSMALLINT sqlCType) noexcept { return false; };
+	};
+
+	template<> struct RowValueTraits<SQLSMALLINT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_SSHORT || c == SQL_C_USHORT; }; };
+	template<> struct RowValueTraits<SQLINTEGER> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_SLONG || c == SQL_C_ULONG; }; };
+	template<> struct RowValueTraits<SQLBIGINT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_SBIGINT || c == SQL_C_UBIGINT; }; };
+	template<> struct RowValueTraits<SQLDOUBLE> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_DOUBLE; }; };
+	template<> struct RowValueTraits<SQLREAL> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_FLOAT; }; };
+	template<> struct RowValueTraits<SQL_DATE_STRUCT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_TYPE_DATE || c == SQL_C_DATE; }; };
+	template<> struct RowValueTraits<SQL_TIME_STRUCT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_TYPE_TIME || c == SQL_C_TIME; }; };
+	template<> struct RowValueTraits<SQL_TIMESTAMP_STRUCT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_TYPE_TIMESTAMP || c == SQL_C_TIMESTAMP; }; };
+	template<> struct RowValueTraits<SQL_NUMERIC_STRUCT> { static bool Accepts(SQLSMALLINT c) noexcept { return c == SQL_C_NUMERIC; }; };
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class RowBlock
+	*
+	* \brief Holds the column-wise bound arrays a RowRange fetches blocks of rows into.
+	* \details	On construction, the statement attributes SQL_ATTR_ROW_BIND_TYPE,
+	*			SQL_ATTR_ROW_ARRAY_SIZE and SQL_ATTR_ROWS_FETCHED_PTR are set on the
+	*			passed handle and one array per column is bound. All buffers are allocated
+	*			once, Fetch() only fills them. On destruction, the columns are unbound
+	*			and the attributes are set back to fetch one row at a time.
+	*/
+	class EXODBCAPI RowBlock
+	{
+	public:
+		/*!
+		* \brief	Bind the arrays for the passed columns to the result set open on pHStmt.
+		* \details	If pExecution is set, every call to SQLFetch is reported to it and
+		*			its execution is ended after the last block.
+		* \throw	Exception If binding fails or a SQL C Type is not supported.
+		*/
+		RowBlock(SqlStmtHandlePtr pHStmt, const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize, ExecutionTrackerPtr pExecution = ExecutionTrackerPtr());
+
+		RowBlock(const RowBlock& other) = delete;
+		RowBlock& operator=(const RowBlock& other) = delete;
+
+		~RowBlock();
+
+
+		/*!
+		* \brief	Move to the next row, fetching the next block of rows if the current
+		*			block has been consumed. The first call fetches the first block.
+		* \return	False if no more rows are available.
+		* \throw	SqlResultException If fetching fails.
+		*/
+		bool Next();
+
+
+		/*!
+		* \brief	Skip the remaining rows of the current block and move to the first row
+		*			of the next block. The first call fetches the first block.
+		* \return	False if no more rows are available.
+		* \throw	SqlResultException If fetching fails.
+		*/
+		bool NextBlock();
+
+
+		/*!
+		* \brief	Copy the rows of the current block into a new RowBlock that is not bound
+		*			to any statement.
+		* \details	Next() on the copy iterates the copied rows, starting at the first row
+		*			of the block, and returns false after the last one. Used to hand over
+		*			fetched rows to another thread while this block fetches the next ones.
+		*/
+		std::shared_ptr<RowBlock> CopyCurrentBlock() const;
+
+
+		/*!
+		* \brief	True once Next() has been called.
+		*/
+		bool IsStarted() const noexcept { return m_started; };
+
+
+		/*!
+		* \brief	Zero-based index of the current row within the current block.
+		*/
+		SQLULEN GetCurrentRow() const noexcept { return m_currentRow; };
+
+
+		/*!
+		* \brief	Number of rows fetched into the current block.
+		*/
+		SQLULEN GetRowsFetched() const noexcept { return m_rowsFetched; };
+
+
+		/*!
+		* \brief	True once Next() has returned false.
+		*/
+		bool IsExhausted() const noexcept { return m_exhausted; };
+
+
+		/*!
+		* \brief	Number of rows fetched with one call to SQLFetch.
+		*/
+		SQLULEN GetBlockSize() const noexcept { return m_blockSize; };
+
+
+		/*!
+		* \brief	Number of bound columns.
+		*/
+		SQLUSMALLINT GetColumnCount() const noexcept { return (SQLUSMALLINT)m_columns.size(); };
+
+
+		/*!
+		* \brief	Definition of the column at the passed zero-based columnIndex.
+		*/
+		const RowColumnDefinition& GetColumnDefinition(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(columnIndex < m_columns.size());
+			return m_columns[columnIndex].m_definition;
+		};
+
+
+		/*!
+		* \brief	Return the zero-based index of the column with the passed queryName.
+		* \throw	NotFoundException If no such column exists.
+		*/
+		SQLUSMALLINT GetColumnIndex(const std::string& queryName) const;
+
+
+		/*!
+		* \brief	Pointer to the value of column columnIndex in row rowIndex of the current block.
+		*/
+		const SQLCHAR* GetData(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const noexcept
+		{
+			const BoundColumn& col = m_columns[columnIndex];
+			return &col.m_data[rowIndex * col.m_elementLength];
+		};
+
+
+		/*!
+		* \brief	Length / Indicator of column columnIndex in row rowIndex of the current block.
+		*/
+		SQLLEN GetIndicator(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const noexcept
+		{
+			return m_columns[columnIndex].m_indicators[rowIndex];
+		};
+
+
+		/*!
+		* \brief	Writable pointer to the value of column columnIndex in row rowIndex.
+		* \details	Used to change the values of a rowset before they are sent back to the
+		*			driver by SQLSetPos or SQLBulkOperations, see BulkRowset.
+		*/
+		SQLCHAR* GetDataPtr(SQLUSMALLINT columnIndex, SQLULEN rowIndex) noexcept
+		{
+			BoundColumn& col = m_columns[columnIndex];
+			return &col.m_data[rowIndex * col.m_elementLength];
+		};
+
+
+		/*!
+		* \brief	Writable pointer to the Length / Indicator of column columnIndex in row rowIndex.
+		*/
+		SQLLEN* GetIndicatorPtr(SQLUSMALLINT columnIndex, SQLULEN rowIndex) noexcept
+		{
+			return &m_columns[columnIndex].m_indicators[rowIndex];
+		};
+
+	private:
+		struct BoundColumn
+		{
+			RowColumnDefinition m_definition;
+			SQLLEN m_elementLength;
+			std::vector<SQLCHAR> m_data;
+			std::vector<SQLLEN> m_indicators;
+		};
+
+		friend class ExecutableStatement;
+
+		RowBlock() noexcept;
+
+		void Bind(SQLUSMALLINT columnNr, BoundColumn& column);
+
+		/*!
+		* \brief	True if NextBlock() would call SQLFetch.
+		*/
+		bool IsFetchDue() const noexcept;
+
+		/*!
+		* \brief	Fetch() split into the state reset before SQLFetch is called and the
+		*			evaluation of its return value, used by ExecutableStatement::NextBlockAsync().
+		*/
+		void BeginFetch() noexcept;
+		bool EndFetch(SQLRETURN ret, ExecutionScope& scope);
+		bool Fetch();
+
+		SqlStmtHandlePtr m_pHStmt;
+		ExecutionTrackerPtr m_pExecution;
+		std::vector<BoundColumn> m_columns;
+		SQLULEN m_blockSize;
+		SQLULEN m_rowsFetched;
+		SQLULEN m_currentRow;
+		bool m_started;
+		bool m_exhausted;
+	};
+	typedef std::shared_ptr<RowBlock> RowBlockPtr;
+
+
+	/*!
+	* \class RowView
+	*
+	* \brief A lightweight view on one row of a RowBlock.
+	* \details	A RowView only points into the arrays of the RowBlock, it gets invalid
+	*			once the RowRange it was read from has been advanced to the next block.
+	*			Copy the values you need to keep.
+	*/
+	class EXODBCAPI RowView
+	{
+	public:
+		RowView() noexcept
+			: m_pBlock(NULL)
+			, m_rowIndex(0)
+		{ };
+
+		RowView(const RowBlock* pBlock, SQLULEN rowIndex) noexcept
+			: m_pBlock(pBlock)
+			, m_rowIndex(rowIndex)
+		{ };
+
+
+		/*!
+		* \brief	True if the value of the zero-based column columnIndex is NULL.
+		*/
+		bool IsNull(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(m_pBlock);
+			exASSERT(columnIndex < m_pBlock->GetColumnCount());
+			return m_pBlock->GetIndicator(columnIndex, m_rowIndex) == SQL_NULL_DATA;
+		};
+
+
+		/*!
+		* \brief	Length / Indicator value of the zero-based column columnIndex.
+		*/
+		SQLLEN GetLength(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(m_pBlock);
+			exASSERT(columnIndex < m_pBlock->GetColumnCount());
+			return m_pBlock->GetIndicator(columnIndex, m_rowIndex);
+		};
+
+
+		/*!
+		* \brief	Raw pointer to the value of the zero-based column columnIndex.
+		*/
+		const SQLCHAR* GetData(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(m_pBlock);
+			exASSERT(columnIndex < m_pBlock->GetColumnCount());
+			return m_pBlock->GetData(columnIndex, m_rowIndex);
+		};
+
+
+		/*!
+		* \brief	Get the value of the zero-based column columnIndex as T.
+		* \details	T must match the SQL C Type the column is bound as, see RowValueTraits.
+		* \throw	AssertionException If T does not match.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		template<typename T>
+		const T& Get(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(m_pBlock);
+			exASSERT(columnIndex < m_pBlock->GetColumnCount());
+			exASSERT(RowValueTraits<T>::Accepts(m_pBlock->GetColumnDefinition(columnIndex).m_sqlCType));
+			return GetUnchecked<T>(columnIndex);
+		};
+
+
+		/*!
+		* \brief	Get the value of the zero-based column columnIndex, bound as SQL_C_CHAR,
+		*			as a zero-terminated string pointing into the RowBlock.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		const SQLCHAR* GetChars(SQLUSMALLINT columnIndex) const;
+
+
+		/*!
+		* \brief	Get the value of the zero-based column columnIndex, bound as SQL_C_WCHAR,
+		*			as a zero-terminated string pointing into the RowBlock.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		const SQLWCHAR* GetWChars(SQLUSMALLINT columnIndex) const;
+
+
+		/*!
+		* \brief	Get the value of the zero-based column columnIndex, bound as SQL_C_CHAR,
+		*			as std::string. This copies the value.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		std::string GetString(SQLUSMALLINT columnIndex) const;
+
+
+		/*!
+		* \brief	Same as Get(), but does not check the type of the column.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		template<typename T>
+		const T& GetUnchecked(SQLUSMALLINT columnIndex) const
+		{
+			ThrowIfNull(columnIndex);
+			return *reinterpret_cast<const T*>(m_pBlock->GetData(columnIndex, m_rowIndex));
+		};
+
+
+		/*!
+		* \brief	Zero-based index of the row within the current block.
+		*/
+		SQLULEN GetRowIndex() const noexcept { return m_rowIndex; };
+
+	private:
+		void ThrowIfNull(SQLUSMALLINT columnIndex) const;
+
+		const RowBlock* m_pBlock;
+		SQLULEN m_rowIndex;
+	};
+
+
+	/*!
+	* \class ColumnAccessor
+	*
+	* \brief Typed access to one column of the RowViews of a RowRange.
+	* \details	The column index is resolved and the type is checked once when the
+	*			accessor is created using RowRange::GetAccessor(). Reading a value is
+	*			then only an indicator check and a pointer dereference.
+	*/
+	template<typename T>
+	class ColumnAccessor
+	{
+	public:
+		explicit ColumnAccessor(SQLUSMALLINT columnIndex) noexcept
+			: m_columnIndex(columnIndex)
+		{ };
+
+		/*!
+		* \brief	Get the value of the column in passed row.
+		* \throw	NullValueException If the value is NULL.
+		*/
+		const T& operator()(const RowView& row) const { return row.GetUnchecked<T>(m_columnIndex); };
+
+		/*!
+		* \brief	True if the value of the column in passed row is NULL.
+		*/
+		bool IsNull(const RowView& row) const { return row.IsNull(m_columnIndex); };
+
+		SQLUSMALLINT GetColumnIndex() const noexcept { return m_columnIndex; };
+
+	private:
+		SQLUSMALLINT m_columnIndex;
+	};
+
+
+	/*!
+	* \class RowRange
+	*
+	* \brief An input range over the rows of the result set open on a statement.
+	* \details	The rows are fetched in blocks of GetBlockSize() rows into buffers
+	*			allocated once by the RowBlock, iterating does not allocate per row.
+	*			The iterators model an input iterator and can be used with range-based
+	*			for loops and standard algorithms:
+	*			\code
+	*			RowRange rows = stmt.Rows();
+	*			ColumnAccessor<SQLINTEGER> id = rows.GetAccessor<SQLINTEGER>(u8"idintegertypes");
+	*			for (const RowView& row : rows)
+	*			{
+	*				SQLINTEGER value = id(row);
+	*			}
+	*			\endcode
+	*			Like every input range, the range can be traversed only once: Copies of a
+	*			RowRange share the same position.
+	*			While a RowRange is alive, no other columns must be bound to the statement.
+	*/
+	class EXODBCAPI RowRange
+	{
+	public:
+		/*!
+		* \class iterator
+		* \brief Input iterator over the rows of a RowRange.
+		*/
+		class EXODBCAPI iterator
+		{
+		public:
+			typedef std::input_iterator_tag iterator_category;
+			typedef RowView value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const RowView* pointer;
+			typedef const RowView& reference;
+
+			/*!
+			* \brief	The end iterator.
+			*/
+			iterator() noexcept
+				: m_pBlock(NULL)
+			{ };
+
+			/*!
+			* \brief	Iterator pointing to the current row of pBlock, or the end iterator
+			*			if pBlock is exhausted.
+			*/
+			explicit iterator(RowBlock* pBlock) noexcept;
+
+			reference operator*() const noexcept { return m_row; };
+			pointer operator->() const noexcept { return &m_row; };
+
+			iterator& operator++();
+			iterator operator++(int)
+			{
+				iterator tmp(*this);
+				++(*this);
+				return tmp;
+			};
+
+			bool operator==(const iterator& other) const noexcept { return m_pBlock == other.m_pBlock; };
+			bool operator!=(const iterator& other) const noexcept { return !(*this == other); };
+
+		private:
+			RowBlock* m_pBlock;
+			RowView m_row;
+		};
+
+
+		/*!
+		* \brief	Bind the passed columns to the result set open on pHStmt, fetching blockSize rows at once.
+		* \details	Usually created by ExecutableStatement::Rows() or Table::Rows().
+		*			If pExecution is set, fetching the blocks is reported to it.
+		*/
+		RowRange(SqlStmtHandlePtr pHStmt, const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize = DEFAULT_ROW_BLOCK_SIZE, ExecutionTrackerPtr pExecution = ExecutionTrackerPtr());
+
+
+		/*!
+		* \brief	Fetches the first block on the first call. Later calls return an
+		*			iterator on the current row.
+		*/
+		iterator begin();
+
+
+		/*!
+		* \brief	The end iterator.
+		*/
+		iterator end() noexcept { return iterator(); };
+
+
+		/*!
+		* \brief	Return the zero-based index of the column with the passed queryName.
+		* \throw	NotFoundException If no such column exists.
+		*/
+		SQLUSMALLINT GetColumnIndex(const std::string& queryName) const { return m_pBlock->GetColumnIndex(queryName); };
+
+
+		/*!
+		* \brief	Create an accessor for the zero-based column columnIndex.
+		* \throw	AssertionException If T does not match the SQL C Type of the column.
+		*/
+		template<typename T>
+		ColumnAccessor<T> GetAccessor(SQLUSMALLINT columnIndex) const
+		{
+			exASSERT(columnIndex < m_pBlock->GetColumnCount());
+			exASSERT(RowValueTraits<T>::Accepts(m_pBlock->GetColumnDefinition(columnIndex).m_sqlCType));
+			return ColumnAccessor<T>(columnIndex);
+		};
+
+
+		/*!
+		* \brief	Create an accessor for the column with the passed queryName.
+		* \throw	NotFoundException If no such column exists.
+		* \throw	AssertionException If T does not match the SQL C Type of the column.
+		*/
+		template<typename T>
+		ColumnAccessor<T> GetAccessor(const std::string& queryName) const
+		{
+			return GetAccessor<T>(GetColumnIndex(queryName));
+		};
+
+
+		/*!
+		* \brief	Number of columns bound.
+		*/
+		SQLUSMALLINT GetColumnCount() const noexcept { return m_pBlock->GetColumnCount(); };
+
+
+		/*!
+		* \brief	Number of rows fetched with one call to SQLFetch.
+		*/
+		SQLULEN GetBlockSize() const noexcept { return m_pBlock->GetBlockSize(); };
+
+
+		/*!
+		* \brief	The RowBlock the rows are fetched into, to iterate the range block by block.
+		*/
+		RowBlock& GetBlock() const noexcept { return *m_pBlock; };
+
+
+		/*!
+		* \brief	Keep pStmt alive as long as this range (or a copy of it) is alive.
+		* \details	Used if the range is created on a statement only the range refers to.
+		*/
+		void SetOwnedStatement(ExecutableStatementPtr pStmt) { m_pOwnedStmt = pStmt; };
+
+	private:
+		ExecutableStatementPtr m_pOwnedStmt;	///< Must be released after m_pBlock, is declared first.
+		RowBlockPtr m_pBlock;
+	};
+
+
+	/*!
+	* \brief	Number of bytes required to hold one value of the passed sqlCType.
+	* \details	For SQL_C_CHAR, SQL_C_WCHAR and SQL_C_BINARY nrOfElements characters
+	*			or bytes are required.
+	* \throw	NotSupportedException If sqlCType is not supported.
+	*/
+	extern EXODBCAPI SQLLEN GetRowElementLength(SQLSMALLINT sqlCType, SQLLEN nrOfElements);
+
+
+	/*!
+	* \brief	Largest length / indicator value that fits into an element of elementLength
+	*			bytes of sqlCType, or -1 if values of sqlCType have a fixed length.
+	*/
+	extern EXODBCAPI SQLLEN GetMaxIndicator(SQLSMALLINT sqlCType, SQLLEN elementLength) noexcept;
+
+
+	/*!
+	* \brief	Returns paramDesc, with the size of the column set to fit nrOfElements if it is
+	*			a SQL_C_CHAR, SQL_C_WCHAR or SQL_C_BINARY column of unknown size.
+	* \details	The size of the column is unknown if its ColumnBuffer has been created manually.
+	*			Used to bind the arrays of a RowBlock as parameters.
+	*/
+	extern EXODBCAPI ParameterDescription GetRowParameterDescription(const ParameterDescription& paramDesc, SQLSMALLINT sqlCType, SQLLEN nrOfElements);
+} // namespace exodbc
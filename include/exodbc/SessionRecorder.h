@@ -0,0 +1,302 @@
+﻿/*!
+* \file SessionRecorder.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the SessionRecorder and SessionTracker classes and the events they record.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ColumnBuffer.h"
+#include "ExecutionSink.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iosfwd>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	struct ParameterArray;
+
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \enum SessionEventType
+	* \brief The operations recorded by the SessionRecorder.
+	*/
+	enum class SessionEventType : unsigned char
+	{
+		Prepare = 1,	///< A statement has been prepared.
+		ExecuteDirect = 2,	///< A statement has been executed using SQLExecDirect, including fetching its result set.
+		ExecutePrepared = 3,	///< A prepared statement has been executed, including fetching its result set.
+		ExecutePreparedArray = 4	///< A prepared statement has been executed with arrays of parameters, see ExecutableStatement::ExecutePreparedArray().
+	};
+
+
+	/*!
+	* \struct SessionParameter
+	* \brief The raw value of a parameter bound to a statement when it was executed.
+	*/
+	struct EXODBCAPI SessionParameter
+	{
+		SessionParameter()
+			: m_paramNr(0)
+			, m_sqlCType(SQL_C_DEFAULT)
+			, m_sqlType(SQL_UNKNOWN_TYPE)
+			, m_columnSize(0)
+			, m_decimalDigits(0)
+			, m_cb(SQL_NULL_DATA)
+		{ };
+
+		SQLUSMALLINT m_paramNr;	///< Parameter number, starting at 1.
+		SQLSMALLINT m_sqlCType;	///< SQL C Type of the bound buffer.
+		SQLSMALLINT m_sqlType;	///< SQL Type of the bound buffer.
+		SQLINTEGER m_columnSize;	///< Column size of the bound buffer.
+		SQLSMALLINT m_decimalDigits;	///< Decimal digits of the bound buffer.
+		SQLLEN m_cb;	///< Length indicator, SQL_NULL_DATA if the value was NULL.
+		std::string m_data;	///< The bytes of the value, empty if the value was NULL.
+	};
+
+
+	/*!
+	* \struct SessionEvent
+	* \brief One operation recorded by the SessionRecorder.
+	*/
+	struct EXODBCAPI SessionEvent
+	{
+		SessionEvent()
+			: m_type(SessionEventType::ExecuteDirect)
+			, m_statementId(0)
+			, m_offset(0)
+			, m_duration(0)
+			, m_fetchDuration(0)
+			, m_rowsFetched(0)
+			, m_paramSetSize(1)
+		{ };
+
+		SessionEventType m_type;	///< The operation.
+		unsigned long long m_statementId;	///< Identifies the statement the operation was run on within a recording.
+		std::chrono::nanoseconds m_offset;	///< Time since the recording started when the operation started.
+		std::chrono::nanoseconds m_duration;	///< Time spent preparing or executing.
+		std::chrono::nanoseconds m_fetchDuration;	///< Time spent fetching, only set for executions.
+		unsigned long long m_rowsFetched;	///< Number of rows fetched, only set for executions.
+		std::string m_sql;	///< The SQL prepared or executed.
+		SQLULEN m_paramSetSize;	///< Number of values per parameter, only differs from 1 for SessionEventType::ExecutePreparedArray.
+		std::vector<SessionParameter> m_parameters;	///< The parameters bound, only set for executions. For arrays, all parameters of the first set, then of the second set, and so on.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class SessionRecorder
+	*
+	* \brief Records the statements prepared and executed through exodbc to a binary file.
+	* \details	While recording, ExecutableStatement (and Table, which executes all its SQL through
+	*			ExecutableStatements) and Database::ExecSql() report every prepare and every
+	*			execution. An execution is written once its result set has been fetched
+	*			completely, or when the statement is executed again, closed or destroyed,
+	*			see SessionTracker. It holds the SQL, the raw values of the bound parameters,
+	*			the time spent executing and fetching and the number of rows fetched.
+	*			The values of the result sets are not recorded.
+	*
+	*			The file starts with the FILE_MAGIC followed by the FILE_VERSION, then one
+	*			SessionEvent after the other. Integers are written as variable length
+	*			quantities, see WriteEvent(). Use ReadFile() to read a recording and
+	*			SessionReplayer to replay it.
+	*
+	*			The class is thread-safe. Use Get() to get the instance used by exodbc.
+	*/
+	class EXODBCAPI SessionRecorder
+	{
+	public:
+		/*!
+		* \brief	The first bytes of a recording.
+		*/
+		static const char FILE_MAGIC[8];
+
+		/*!
+		* \brief	Version of the file format written.
+		* \details	Version 2 added SessionEventType::ExecutePreparedArray. Version 1 files can still be read.
+		*/
+		static const unsigned FILE_VERSION = 2;
+
+		SessionRecorder();
+		~SessionRecorder();
+
+		SessionRecorder(const SessionRecorder& other) = delete;
+		SessionRecorder& operator=(const SessionRecorder& other) = delete;
+
+
+		/*!
+		* \brief	Get the instance used by exodbc.
+		* \details	The instance is never destroyed, as statements might be destroyed during static destruction.
+		*/
+		static SessionRecorder& Get();
+
+
+		/*!
+		* \brief	Start recording to the file at path. An existing file is replaced.
+		* \throw	Exception If already recording or if the file cannot be opened.
+		*/
+		void Start(const std::string& path);
+
+
+		/*!
+		* \brief	Stop recording and close the file. Does nothing if not recording.
+		* \details	Executions still pending on a statement are not written.
+		*/
+		void Stop();
+
+
+		/*!
+		* \brief	True if recording.
+		*/
+		bool IsRecording() const noexcept { return m_recording.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Number of events written since recording started.
+		*/
+		unsigned long long GetEventCount() const noexcept { return m_eventCount.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Get a new id to identify a statement in the recordings.
+		*/
+		unsigned long long NextStatementId() noexcept { return ++m_nextStatementId; };
+
+
+		/*!
+		* \brief	Write event, if recording.
+		* \param	start	Time the operation started, converted to SessionEvent::m_offset.
+		*/
+		void Record(std::chrono::steady_clock::time_point start, SessionEvent event);
+
+
+		/*!
+		* \brief	Read all events of the recording at path.
+		* \throw	Exception If the file cannot be read or is not a recording.
+		*/
+		static std::vector<SessionEvent> ReadFile(const std::string& path);
+
+
+		/*!
+		* \brief	Write event to out.
+		* \details	Writes the type as one byte, then the statement id, offset and duration, followed
+		*			by the SQL. Executions add the time spent fetching, the number of rows fetched
+		*			and the parameters. Executions with arrays of parameters write the size of the
+		*			arrays before the parameters. Unsigned integers are written 7 bits per byte, least significant
+		*			first, with the high bit set on all but the last byte. Signed integers are zigzag
+		*			encoded first. Strings are written as their length followed by their bytes.
+		*/
+		static void WriteEvent(std::ostream& out, const SessionEvent& event);
+
+
+		/*!
+		* \brief	Read the next event from in.
+		* \return	False if in is at its end before the event.
+		* \throw	Exception If the event is truncated or invalid.
+		*/
+		static bool ReadEvent(std::istream& in, SessionEvent& event);
+
+	private:
+		std::atomic<bool> m_recording;
+		std::atomic<unsigned long long> m_eventCount;
+		std::atomic<unsigned long long> m_nextStatementId;
+		std::chrono::steady_clock::time_point m_start;
+		std::string m_path;
+		std::ofstream m_out;
+		mutable std::mutex m_mutex;
+	};
+
+
+	/*!
+	* \class SessionTracker
+	*
+	* \brief Collects one prepare or execution and writes it to the SessionRecorder once it ended.
+	* \details The ExecutionSink of the SessionRecorder, see ExecutionTracker. Captures the
+	*			raw values of the bound parameters when an execution begins.
+	*/
+	class EXODBCAPI SessionTracker
+		: public ExecutionSink
+	{
+	public:
+		SessionTracker();
+
+		SessionTracker(const SessionTracker& other) = delete;
+		SessionTracker& operator=(const SessionTracker& other) = delete;
+
+		/*!
+		* \brief	Calls End().
+		*/
+		~SessionTracker();
+
+
+		/*!
+		* \brief	Start collecting a prepare or an execution, if the SessionRecorder is recording.
+		* \return	True if the operation is collected.
+		*/
+		bool Begin(const ExecutionContext& context) override;
+
+
+		/*!
+		* \brief	True if an operation is being collected.
+		*/
+		bool IsActive() const noexcept override { return m_active; };
+
+
+		void AddExecute(std::chrono::nanoseconds elapsed) noexcept override { m_event.m_duration += elapsed; };
+		void AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept override { m_event.m_fetchDuration += elapsed; m_event.m_rowsFetched += rows; };
+
+
+		/*!
+		* \brief	End collecting the current operation and write it to the SessionRecorder.
+		*			Does nothing if no operation is collected.
+		*/
+		void End() noexcept override;
+
+	private:
+		bool m_active;
+		unsigned long long m_statementId;	///< Id of the statement in the SessionRecorder, assigned on first use.
+		std::chrono::steady_clock::time_point m_start;
+		SessionEvent m_event;
+	};
+
+
+	/*!
+	* \brief	Capture the raw value of the ColumnBuffer bound as parameter paramNr.
+	* \details	Character and binary values are captured up to their length indicator,
+	*			or up to the terminating zero for SQL_NTS. The values of SqlCPointerBuffers
+	*			are not captured, they are recorded as NULL.
+	*/
+	extern EXODBCAPI SessionParameter CaptureSessionParameter(SQLUSMALLINT paramNr, const ColumnBufferPtrVariant& param);
+
+
+	/*!
+	* \brief	Capture the raw values of the first paramSetSize elements of the ParameterArrays
+	*			bound as parameters 1 to params.size().
+	* \details	Returns all parameters of the first set, then of the second set, and so on.
+	*			Character and binary values are captured like in CaptureSessionParameter(). If
+	*			a ParameterArray has no indicators, character values are read up to their
+	*			terminating zero and all other values are captured with their element length.
+	*/
+	extern EXODBCAPI std::vector<SessionParameter> CaptureSessionParameterArrays(const std::vector<ParameterArray>& params, SQLULEN paramSetSize);
+} // namespace exodbc
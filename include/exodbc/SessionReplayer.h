@@ -0,0 +1,196 @@
+﻿/*!
+* \file SessionReplayer.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the SessionReplayer class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Database.h"
+#include "ExecutableStatement.h"
+#include "SessionRecorder.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \enum ReplayPacing
+	* \brief How the SessionReplayer schedules the recorded operations.
+	*/
+	enum class ReplayPacing
+	{
+		Original,	///< Start every operation at its recorded offset, divided by the speed.
+		MaximumSpeed	///< Start every operation as soon as the previous one has completed.
+	};
+
+
+	/*!
+	* \struct SessionReplayResult
+	* \brief Summary of a replay, comparing the recorded with the replayed times.
+	*/
+	struct EXODBCAPI SessionReplayResult
+	{
+		SessionReplayResult()
+			: m_prepares(0)
+			, m_executions(0)
+			, m_rowsFetched(0)
+			, m_errors(0)
+			, m_recordedDuration(0)
+			, m_replayDuration(0)
+			, m_recordedPrepareTime(0)
+			, m_replayPrepareTime(0)
+			, m_recordedExecuteTime(0)
+			, m_replayExecuteTime(0)
+			, m_recordedFetchTime(0)
+			, m_replayFetchTime(0)
+		{ };
+
+		unsigned long long m_prepares;	///< Number of statements prepared.
+		unsigned long long m_executions;	///< Number of executions.
+		unsigned long long m_rowsFetched;	///< Number of rows fetched during the replay.
+		unsigned long long m_errors;	///< Number of operations that failed.
+		std::chrono::nanoseconds m_recordedDuration;	///< Time from the start of the recording until the end of its last operation.
+		std::chrono::nanoseconds m_replayDuration;	///< Time the replay took.
+		std::chrono::nanoseconds m_recordedPrepareTime;	///< Time spent preparing while recording.
+		std::chrono::nanoseconds m_replayPrepareTime;	///< Time spent preparing during the replay.
+		std::chrono::nanoseconds m_recordedExecuteTime;	///< Time spent executing while recording.
+		std::chrono::nanoseconds m_replayExecuteTime;	///< Time spent executing during the replay.
+		std::chrono::nanoseconds m_recordedFetchTime;	///< Time spent fetching while recording.
+		std::chrono::nanoseconds m_replayFetchTime;	///< Time spent fetching during the replay.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class SessionReplayer
+	*
+	* \brief Replays the operations recorded by a SessionRecorder against a Database.
+	* \details	Every statement of the recording is replayed on its own ExecutableStatement.
+	*			Statements are prepared and executed like recorded, using the recorded
+	*			parameter values. Executions with arrays of parameters are replayed using
+	*			ExecutableStatement::ExecutePreparedArray(). Of every result set the recorded number of rows is fetched,
+	*			without binding any columns. Operations are run one after the other on the
+	*			calling thread, even if they have been recorded from several threads.
+	*
+	*			The replay can be run against the database the recording has been made on,
+	*			a copy of it or the exodbcmock driver.
+	*/
+	class EXODBCAPI SessionReplayer
+	{
+	public:
+		SessionReplayer() = delete;
+
+		/*!
+		* \brief	Create a SessionReplayer replaying on pDb.
+		*/
+		SessionReplayer(ConstDatabasePtr pDb);
+
+		SessionReplayer(const SessionReplayer& other) = delete;
+		SessionReplayer& operator=(const SessionReplayer& other) = delete;
+
+
+		/*!
+		* \brief	Set how operations are scheduled. Defaults to ReplayPacing::Original.
+		*/
+		void SetPacing(ReplayPacing pacing) noexcept { m_pacing = pacing; };
+
+
+		/*!
+		* \brief	Get how operations are scheduled.
+		*/
+		ReplayPacing GetPacing() const noexcept { return m_pacing; };
+
+
+		/*!
+		* \brief	Set the speed factor used with ReplayPacing::Original: A value of 2 replays
+		*			twice as fast as recorded. Defaults to 1.
+		*/
+		void SetSpeed(double speed);
+
+
+		/*!
+		* \brief	Get the speed factor.
+		*/
+		double GetSpeed() const noexcept { return m_speed; };
+
+
+		/*!
+		* \brief	If set to true, the first failing operation stops the replay by throwing. Else
+		*			failures are logged as warnings and counted. Defaults to false.
+		*/
+		void SetStopOnError(bool stopOnError) noexcept { m_stopOnError = stopOnError; };
+
+
+		/*!
+		* \brief	True if the first failing operation stops the replay.
+		*/
+		bool GetStopOnError() const noexcept { return m_stopOnError; };
+
+
+		/*!
+		* \brief	Replay events.
+		* \throw	Exception If an operation fails and GetStopOnError() is set.
+		*/
+		SessionReplayResult Replay(const std::vector<SessionEvent>& events);
+
+
+		/*!
+		* \brief	Read the recording at path and replay it.
+		* \throw	Exception If the recording cannot be read, or an operation fails and GetStopOnError() is set.
+		*/
+		SessionReplayResult Replay(const std::string& path);
+
+
+		/*!
+		* \brief	Create a ColumnBuffer holding the recorded value of param.
+		* \throw	NotSupportedException If the SQL C Type of param is not supported.
+		*/
+		static ColumnBufferPtrVariant CreateParameterBuffer(const SessionParameter& param);
+
+	private:
+		/*!
+		* \struct ReplayStatement
+		* \brief The statement replaying the operations of one recorded statement.
+		*/
+		struct ReplayStatement
+		{
+			ReplayStatement()
+				: m_boundParams(false)
+			{ };
+
+			ExecutableStatementPtr m_pStmt;
+			std::string m_preparedSql;
+			bool m_boundParams;
+		};
+
+		void Prepare(ReplayStatement& stmt, const std::string& sql, SessionReplayResult& result);
+		void Execute(ReplayStatement& stmt, const SessionEvent& event, SessionReplayResult& result);
+		void ExecuteArray(ReplayStatement& stmt, const SessionEvent& event, SessionReplayResult& result);
+
+		ConstDatabasePtr m_pDb;
+		ReplayPacing m_pacing;
+		double m_speed;
+		bool m_stopOnError;
+	};
+} // namespace exodbc
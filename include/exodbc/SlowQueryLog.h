@@ -0,0 +1,332 @@
+﻿/*!
+* \file SlowQueryLog.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the SlowQueryLog and SlowQueryTracker classes.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ColumnBuffer.h"
+#include "LogManager.h"
+#include "ExecutionSink.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct SlowQueryParameter
+	* \brief The value of a parameter bound to a statement when it was executed.
+	*/
+	struct EXODBCAPI SlowQueryParameter
+	{
+		SlowQueryParameter()
+			: m_paramNr(0)
+			, m_isNull(true)
+		{ };
+
+		SQLUSMALLINT m_paramNr;	///< Parameter number, starting at 1.
+		std::string m_queryName;	///< Query name of the bound ColumnBuffer, if it has one.
+		bool m_isNull;	///< True if the parameter was NULL.
+		std::string m_value;	///< The value formatted as string, empty if m_isNull is true.
+	};
+
+
+	/*!
+	* \struct SlowQueryRecord
+	* \brief One execution of a statement, including fetching its result set.
+	*/
+	struct EXODBCAPI SlowQueryRecord
+	{
+		SlowQueryRecord()
+			: m_executeTime(0)
+			, m_fetchTime(0)
+			, m_rowsReturned(0)
+		{ };
+
+		/*!
+		* \brief	Time spent executing and fetching.
+		*/
+		std::chrono::nanoseconds GetTotalTime() const noexcept { return m_executeTime + m_fetchTime; };
+
+		std::string m_sql;	///< The SQL executed.
+		std::string m_fingerprint;	///< The SQL with literals stripped, see NormalizeSql().
+		std::vector<SlowQueryParameter> m_parameters;	///< The parameters bound, if captured.
+		std::chrono::system_clock::time_point m_start;	///< Time the statement was executed.
+		std::chrono::nanoseconds m_executeTime;	///< Time spent executing.
+		std::chrono::nanoseconds m_fetchTime;	///< Time spent fetching.
+		unsigned long long m_rowsReturned;	///< Number of rows fetched.
+	};
+
+
+	/*!
+	* \struct SlowQueryStatistics
+	* \brief The slow executions of all statements with the same fingerprint.
+	*/
+	struct EXODBCAPI SlowQueryStatistics
+	{
+		SlowQueryStatistics()
+			: m_count(0)
+			, m_totalTime(0)
+			, m_maxTime(0)
+		{ };
+
+		std::string m_fingerprint;	///< The SQL with literals stripped.
+		std::string m_lastSql;	///< The SQL of the last slow execution.
+		unsigned long long m_count;	///< Number of slow executions.
+		std::chrono::nanoseconds m_totalTime;	///< Sum of the total time of all slow executions.
+		std::chrono::nanoseconds m_maxTime;	///< Total time of the slowest execution.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class SlowQueryLog
+	*
+	* \brief Logs executions of statements slower than a threshold as JSON lines.
+	* \details	ExecutableStatement (and Table, which executes all its SQL through
+	*			ExecutableStatements) and Database::ExecSql() report every execution
+	*			to the SlowQueryLog while it is enabled. An execution ends once its result
+	*			set has been fetched completely, or when the statement is executed again,
+	*			closed or destroyed. If it took at least GetThreshold() in total, a
+	*			line like the following is written through the LogManager at GetLogLevel():
+	*			\code
+	*			{"type":"slow_query","start":"2026-10-18T08:15:02.417Z","fingerprint":"SELECT * FROM t WHERE id > ?",
+	*			 "sql":"SELECT * FROM t WHERE id > ?","params":[{"nr":1,"name":"id","value":"12"}],
+	*			 "execute_ms":812.4,"fetch_ms":95.1,"total_ms":907.5,"rows":1200}
+	*			\endcode
+	*			Bound parameter values can be masked using SetParameterRedactor() or not
+	*			be captured at all, see SetCaptureParameters().
+	*
+	*			The slow executions are also aggregated per fingerprint: GetTopStatements()
+	*			returns the fingerprints with the highest total time since the last Reset().
+	*
+	*			Disabled by default. The class is thread-safe. Use Get() to get the instance used by exodbc.
+	*/
+	class EXODBCAPI SlowQueryLog
+	{
+	public:
+		/*!
+		* \brief	Called for every parameter of a slow execution before it is logged.
+		*			Can modify the parameter, for example to replace its value.
+		*/
+		typedef std::function<void(const SlowQueryRecord&, SlowQueryParameter&)> ParameterRedactor;
+
+		/*!
+		* \brief	Default value for SetThreshold().
+		*/
+		static const std::chrono::milliseconds DEFAULT_THRESHOLD;
+
+		/*!
+		* \brief	Default value for SetTopCount().
+		*/
+		static const size_t DEFAULT_TOP_COUNT = 20;
+
+		SlowQueryLog();
+
+		SlowQueryLog(const SlowQueryLog& other) = delete;
+		SlowQueryLog& operator=(const SlowQueryLog& other) = delete;
+
+
+		/*!
+		* \brief	Get the instance used by exodbc.
+		* \details	The instance is never destroyed, as statements might be destroyed during static destruction.
+		*/
+		static SlowQueryLog& Get();
+
+
+		/*!
+		* \brief	Enable or disable the slow query log.
+		*/
+		void SetEnabled(bool enable) noexcept { m_enabled.store(enable, std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	True if the slow query log is enabled.
+		*/
+		bool IsEnabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Executions taking at least threshold in total are logged.
+		*/
+		void SetThreshold(std::chrono::nanoseconds threshold) noexcept { m_thresholdNs.store(threshold.count(), std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Get the threshold.
+		*/
+		std::chrono::nanoseconds GetThreshold() const noexcept { return std::chrono::nanoseconds(m_thresholdNs.load(std::memory_order_relaxed)); };
+
+
+		/*!
+		* \brief	If set to false, no parameter values are captured. Defaults to true.
+		*/
+		void SetCaptureParameters(bool capture) noexcept { m_captureParameters.store(capture, std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	True if parameter values are captured.
+		*/
+		bool GetCaptureParameters() const noexcept { return m_captureParameters.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Set the redactor called for every parameter before it is logged. Pass an
+		*			empty function to log the values unmodified (the default).
+		* \see		RedactAll()
+		*/
+		void SetParameterRedactor(ParameterRedactor redactor);
+
+
+		/*!
+		* \brief	A ParameterRedactor replacing every value that is not NULL by "***".
+		*/
+		static void RedactAll(const SlowQueryRecord& record, SlowQueryParameter& param);
+
+
+		/*!
+		* \brief	Set the LogLevel slow executions are logged with. Defaults to LogLevel::Warning.
+		*/
+		void SetLogLevel(LogLevel level) noexcept { m_logLevel.store(level, std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Get the LogLevel slow executions are logged with.
+		*/
+		LogLevel GetLogLevel() const noexcept { return m_logLevel.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Set the number of fingerprints returned by GetTopStatements().
+		* \details	At most four times as many fingerprints are aggregated: If more show up,
+		*			the one with the lowest total time is dropped.
+		*/
+		void SetTopCount(size_t topCount);
+
+
+		/*!
+		* \brief	Get the number of fingerprints returned by GetTopStatements().
+		*/
+		size_t GetTopCount() const;
+
+
+		/*!
+		* \brief	Get the fingerprints with the highest total time of slow executions, highest first.
+		*/
+		std::vector<SlowQueryStatistics> GetTopStatements() const;
+
+
+		/*!
+		* \brief	Forget all slow executions aggregated for GetTopStatements().
+		*/
+		void Reset();
+
+
+		/*!
+		* \brief	Report a finished execution. It is ignored if it was faster than the threshold.
+		* \details	Sets the fingerprint of record, runs the ParameterRedactor and logs it.
+		*/
+		void Record(SlowQueryRecord record);
+
+
+		/*!
+		* \brief	Format record as one line of JSON.
+		*/
+		static std::string ToJson(const SlowQueryRecord& record);
+
+	private:
+		std::atomic<bool> m_enabled;
+		std::atomic<long long> m_thresholdNs;
+		std::atomic<bool> m_captureParameters;
+		std::atomic<LogLevel> m_logLevel;
+
+		ParameterRedactor m_redactor;
+		size_t m_topCount;
+		std::map<std::string, SlowQueryStatistics> m_statistics;
+		mutable std::mutex m_mutex;
+	};
+
+
+	/*!
+	* \class SlowQueryTracker
+	*
+	* \brief Collects the times of one execution and reports it to the SlowQueryLog once it ended.
+	* \details The ExecutionSink of the SlowQueryLog, see ExecutionTracker. Prepares are ignored.
+	*/
+	class EXODBCAPI SlowQueryTracker
+		: public ExecutionSink
+	{
+	public:
+		SlowQueryTracker();
+
+		SlowQueryTracker(const SlowQueryTracker& other) = delete;
+		SlowQueryTracker& operator=(const SlowQueryTracker& other) = delete;
+
+		/*!
+		* \brief	Calls End().
+		*/
+		~SlowQueryTracker();
+
+
+		/*!
+		* \brief	Start tracking an execution, if the SlowQueryLog is enabled.
+		* \details	Parameters are only captured if the SlowQueryLog captures parameters.
+		* \return	True if the execution is tracked.
+		*/
+		bool Begin(const ExecutionContext& context) override;
+
+
+		/*!
+		* \brief	True if an execution is being tracked.
+		*/
+		bool IsActive() const noexcept override { return m_active; };
+
+
+		void AddExecute(std::chrono::nanoseconds elapsed) noexcept override { m_record.m_executeTime += elapsed; };
+		void AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept override { m_record.m_fetchTime += elapsed; m_record.m_rowsReturned += rows; };
+
+
+		/*!
+		* \brief	End tracking the current execution and report it to the SlowQueryLog.
+		*			Does nothing if no execution is tracked.
+		*/
+		void End() noexcept override;
+
+	private:
+		bool m_active;
+		SlowQueryRecord m_record;
+	};
+
+
+	/*!
+	* \brief	Capture the value of the ColumnBuffer bound as parameter paramNr.
+	* \details	Character values are truncated after 256 characters, binary values are
+	*			written as hex, truncated after 64 bytes.
+	*/
+	extern EXODBCAPI SlowQueryParameter CaptureSlowQueryParameter(SQLUSMALLINT paramNr, const ColumnBufferPtrVariant& param);
+} // namespace exodbc
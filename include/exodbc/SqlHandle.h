@@ -15,6 +15,7 @@
 #include "Exception.h"
 #include "LogManagerOdbcMacros.h"
 #include "Sql2StringHelper.h"
+#include "OdbcTrace.h"
 
 // Other headers
 #include <boost/signals2.hpp>
@@ -124,7 +125,7 @@ namespace exodbc
 
 			// This shall only be allowed for the environment handle so far. All others have a parent
 			exASSERT_MSG(tHandleType == SQL_HANDLE_ENV, u8"Only handles of type SQL_HANDLE_ENV can be Allocated without parent");
-			SQLRETURN ret = SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &m_handle);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLAllocHandle, SQL_HANDLE_ENV, SQL_NULL_HANDLE, &m_handle);
 			if (!SQL_SUCCEEDED(ret))
 			{
 				SqlResultException ex(u8"SQLAllocHandle", ret, u8"Failed to allocated ODBC-Env Handle, no additional error information is available.");
@@ -155,7 +156,7 @@ namespace exodbc
 
 			// The environment handle has no parent handle
 			exASSERT_MSG(tHandleType != SQL_HANDLE_ENV, u8"Handles of type SQL_HANDLE_ENV must be allocated without parent");
-			SQLRETURN ret = SQLAllocHandle(tHandleType, pParentHandle->GetHandle(), &m_handle);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLAllocHandle, tHandleType, pParentHandle->GetHandle(), &m_handle);
 			THROW_IFN_SUCCEEDED(SQLAllocHandle, ret, pParentHandle->GetHandleType(), pParentHandle->GetHandle());
 			// success, remember parent
 			m_pParentHandle = pParentHandle;
@@ -180,7 +181,7 @@ namespace exodbc
 			m_freeSignal(*this);
 
 			// Returns only SQL_SUCCESS, SQL_ERROR, or SQL_INVALID_HANDLE.
-			SQLRETURN ret = SQLFreeHandle(tHandleType, m_handle);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLFreeHandle, tHandleType, m_handle);
 
 			// if SQL_ERROR is returned, the handle is still valid, and error information can be fetched
 			if (ret == SQL_ERROR)
@@ -220,7 +221,7 @@ namespace exodbc
 			exASSERT(m_handle != SQL_NULL_HANDLE);
 			exASSERT(tHandleType == SQL_HANDLE_STMT);
 
-			SQLRETURN ret = SQLFreeStmt(m_handle, SQL_RESET_PARAMS);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLFreeStmt, m_handle, SQL_RESET_PARAMS);
 			THROW_IFN_SUCCEEDED(SQLFreeStmt, ret, SQL_HANDLE_STMT, m_handle);
 
 			// trigger signal
@@ -237,7 +238,7 @@ namespace exodbc
 			exASSERT(m_handle != SQL_NULL_HANDLE);
 			exASSERT(tHandleType == SQL_HANDLE_STMT);
 
-			SQLRETURN ret = SQLFreeStmt(m_handle, SQL_UNBIND);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLFreeStmt, m_handle, SQL_UNBIND);
 			THROW_IFN_SUCCEEDED(SQLFreeStmt, ret, SQL_HANDLE_STMT, m_handle);
 
 			// trigger signal
@@ -389,7 +390,7 @@ namespace exodbc
 			exASSERT(m_handle == SQL_NULL_HANDLE);
 			exASSERT(m_pParentHandle == NULL);
 
-			SQLRETURN ret = SQLGetStmtAttr(pStmtHandle->GetHandle(), (SQLINTEGER)type, &m_handle, 0, NULL);
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLGetStmtAttr, pStmtHandle->GetHandle(), (SQLINTEGER)type, &m_handle, 0, NULL);
 			THROW_IFN_SUCCEEDED(SQLGetStmtAttr, ret, SQL_HANDLE_STMT, pStmtHandle->GetHandle());
 
 			// success, remember parent
@@ -11,6 +11,7 @@
 // Same component headers
 #include "exOdbc.h"
 #include "SqlHandle.h"
+#include "CursorProfile.h"
 
 // Other headers
 #include <boost/variant.hpp>
@@ -259,6 +260,45 @@ namespace exodbc
 		bool GetSupportsCatalogs() const;
 
 
+		/*!
+		* \brief Returns true if property SQL_ASYNC_MODE is set (from ODBC 3.x on) and its value is SQL_AM_STATEMENT.
+		*/
+		bool GetSupportsAsyncStatements() const;
+
+
+		/*!
+		* \brief Returns false if the properties read report that the driver does not support profile.
+		* \details The cursor type is checked against SQL_SCROLL_OPTIONS, the concurrency and sensitivity
+		*		against the SQL_xxx_CURSOR_ATTRIBUTES2 of the cursor type. A CursorSensitivity::INSENSITIVE
+		*		cursor must be read-only and static or forward-only. Properties that have not been read are
+		*		not checked: The driver might still change the attributes when they are set.
+		*/
+		bool GetSupportsCursorProfile(const CursorProfile& profile) const;
+
+
+		/*!
+		* \brief Returns the value of the SQL_xxx_CURSOR_ATTRIBUTES1 property of the passed cursor type,
+		*		or 0 if it has not been read.
+		* \details The SQL_CA1_xxx flags report the fetch orientations, and if SQLSetPos and
+		*		SQLBulkOperations can be used on a cursor of the type.
+		*/
+		SQLUINTEGER GetCursorAttributes1(CursorType type) const;
+
+
+		/*!
+		* \brief Returns true if property SQL_BATCH_SUPPORT reports SQL_BS_ROW_COUNT_EXPLICIT and
+		*		SQL_BATCH_ROW_COUNT reports SQL_BRC_EXPLICIT: Batches of statements can be executed
+		*		and return the row count of every statement.
+		*/
+		bool GetSupportsBatchRowCounts() const;
+
+
+		/*!
+		* \brief Returns true if property SQL_PROCEDURES is set and its value is set to 'Y'.
+		*/
+		bool GetSupportsProcedures() const;
+
+
 		/*!
 		* \brief Returns the value of property SQL_SCHEMA_TERM. Empty value might indicate no support for schemas.
 		*/
@@ -337,6 +377,11 @@ namespace exodbc
 
 		void MarkAsUnsupported(SQLUSMALLINT infoId);
 
+		/*!
+		* \brief Set value to the value of the UInt property infoId and return true, if it is registered and has been read.
+		*/
+		bool TryGetUIntValue(SQLUSMALLINT infoId, SQLUINTEGER& value) const;
+
 		typedef std::map<SQLUSMALLINT, SqlInfoProperty> PropsMap;
 		PropsMap m_props;
 		DatabaseProduct m_dbms;	///< Remember parsed value of dbms.
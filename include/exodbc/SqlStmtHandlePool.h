@@ -0,0 +1,188 @@
+﻿/*!
+* \file SqlStmtHandlePool.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the SqlStmtHandlePool class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "SqlHandle.h"
+
+// Other headers
+// System headers
+#include <vector>
+#include <map>
+#include <mutex>
+#include <memory>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	/*!
+	* \class SqlStmtHandlePool
+	*
+	* \brief A pool of statement handles allocated from one connection handle.
+	* \details	Allocating and freeing statement handles using SQLAllocHandle and
+	*			SQLFreeHandle is expensive with some drivers. The pool keeps
+	*			released statement handles around and hands them out again on
+	*			the next Acquire().
+	*
+	*			Before a handle is put back into the pool it is reset: An open
+	*			cursor is closed, columns are unbound, parameters are reset and
+	*			the statement attributes modified by exodbc are restored to the
+	*			values the driver reported on a freshly allocated handle.
+	*			If resetting fails, the handle is not pooled but freed.
+	*
+	*			The pool is created by the Database during Open() and closed
+	*			during Close(). All methods are thread-safe.
+	*/
+	class EXODBCAPI SqlStmtHandlePool
+	{
+	public:
+		/*!
+		* \brief Default value for the maximum number of handles kept in the pool.
+		*/
+		static const size_t DEFAULT_MAX_POOLED_HANDLES = 16;
+
+
+		/*!
+		* \brief	Create a pool for statement handles allocated from the passed connection handle.
+		* \param	pHDbc				Connection handle, must be allocated and connected.
+		* \param	maxPooledHandles	Maximum number of handles kept in the pool. If 0, released
+		*								handles are always freed.
+		*/
+		SqlStmtHandlePool(ConstSqlDbcHandlePtr pHDbc, size_t maxPooledHandles = DEFAULT_MAX_POOLED_HANDLES);
+
+		// Prevent copies.
+		SqlStmtHandlePool(const SqlStmtHandlePool& other) = delete;
+		SqlStmtHandlePool& operator=(const SqlStmtHandlePool& other) = delete;
+
+		/*!
+		* \brief	Calls Close().
+		*/
+		~SqlStmtHandlePool();
+
+
+		/*!
+		* \brief	Returns a handle from the pool, or allocates a new one if the pool is empty.
+		* \throw	AssertionException If the pool has been closed.
+		* \throw	SqlResultException If allocating a new handle fails.
+		*/
+		SqlStmtHandlePtr Acquire();
+
+
+		/*!
+		* \brief	Reset the passed handle and put it back into the pool.
+		* \details	The handle is only put back into the pool if the pool is not closed,
+		*			not full, resetting the handle succeeds and no one else holds a
+		*			reference to the passed handle: Pass the handle using std::move()
+		*			to not keep a reference. Else the handle is dropped and gets
+		*			freed once the last reference to it goes out of scope.
+		*/
+		void Release(SqlStmtHandlePtr pHStmt);
+
+
+		/*!
+		* \brief	Frees all pooled handles. Handles released after Close() has been
+		*			called are not pooled anymore. Acquire() must not be called after Close().
+		*/
+		void Close();
+
+
+		/*!
+		* \brief	Returns true if Close() has not been called yet.
+		*/
+		bool IsOpen() const;
+
+
+		/*!
+		* \brief	Set the maximum number of handles kept in the pool. If the pool
+		*			currently holds more handles, the surplus handles are freed.
+		*/
+		void SetMaxPooledHandles(size_t maxPooledHandles);
+
+
+		/*!
+		* \brief	Get the maximum number of handles kept in the pool.
+		*/
+		size_t GetMaxPooledHandles() const;
+
+
+		/*!
+		* \brief	Get the number of handles currently available in the pool.
+		*/
+		size_t GetPooledCount() const;
+
+
+		/*!
+		* \brief	Get the number of handles allocated by Acquire() using SQLAllocHandle.
+		*/
+		unsigned long long GetAllocatedCount() const;
+
+
+		/*!
+		* \brief	Get the number of handles returned by Acquire() from the pool: This
+		*			is the number of SQLAllocHandle / SQLFreeHandle pairs avoided.
+		*/
+		unsigned long long GetReusedCount() const;
+
+
+		/*!
+		* \brief	Get the number of handles passed to Release() that have not been
+		*			pooled because the pool was closed or full, the handle was still
+		*			referenced or resetting the handle failed.
+		*/
+		unsigned long long GetDiscardedCount() const;
+
+
+		/*!
+		* \brief	Set all counters to 0.
+		*/
+		void ResetCounters();
+
+	private:
+		/*!
+		* \brief	Read the default values of all attributes we restore from the passed
+		*			freshly allocated handle. Attributes the driver fails to report are
+		*			ignored and will not be restored.
+		*/
+		void ReadDefaultAttributes(ConstSqlStmtHandlePtr pHStmt);
+
+
+		/*!
+		* \brief	Close the cursor, unbind columns, reset params and restore the attributes.
+		* \throw	Exception If any of the operations fails.
+		*/
+		void ResetHandle(ConstSqlStmtHandlePtr pHStmt) const;
+
+		ConstSqlDbcHandlePtr m_pHDbc;
+		std::vector<SqlStmtHandlePtr> m_pooledHandles;
+		size_t m_maxPooledHandles;
+		bool m_isOpen;
+
+		bool m_defaultAttributesRead;
+		std::map<SQLINTEGER, SQLULEN> m_defaultAttributes;	///< Statement attributes restored on Release(), with their default values.
+
+		unsigned long long m_allocatedCount;
+		unsigned long long m_reusedCount;
+		unsigned long long m_discardedCount;
+
+		mutable std::mutex m_poolMutex;
+	};
+
+	typedef std::shared_ptr<SqlStmtHandlePool> SqlStmtHandlePoolPtr;
+} // namespace exodbc
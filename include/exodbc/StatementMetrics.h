@@ -0,0 +1,286 @@
+﻿/*!
+* \file StatementMetrics.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the StatementMetrics and StatementMetricsRegistry classes.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "ExecutionSink.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct StatementMetricsSnapshot
+	* \brief The values of a StatementMetrics at a given point in time.
+	*/
+	struct EXODBCAPI StatementMetricsSnapshot
+	{
+		StatementMetricsSnapshot()
+			: m_prepareCount(0)
+			, m_executeCount(0)
+			, m_fetchCount(0)
+			, m_rowsFetched(0)
+			, m_bytesBound(0)
+			, m_roundTrips(0)
+			, m_prepareTime(0)
+			, m_executeTime(0)
+			, m_executeTimeMax(0)
+			, m_fetchTime(0)
+		{ };
+
+		std::string m_normalizedSql;	///< The SQL the values are aggregated for, see NormalizeSql().
+		unsigned long long m_prepareCount;	///< Number of calls to SQLPrepare.
+		unsigned long long m_executeCount;	///< Number of calls to SQLExecute or SQLExecDirect.
+		unsigned long long m_fetchCount;	///< Number of calls to SQLFetch or SQLFetchScroll.
+		unsigned long long m_rowsFetched;	///< Number of rows fetched.
+		unsigned long long m_bytesBound;	///< Sum of the sizes of the buffers bound to the statement, per execution.
+		unsigned long long m_roundTrips;	///< Number of calls to the driver that usually involve the server.
+		std::chrono::nanoseconds m_prepareTime;	///< Total time spent in SQLPrepare.
+		std::chrono::nanoseconds m_executeTime;	///< Total time spent executing.
+		std::chrono::nanoseconds m_executeTimeMax;	///< Longest single execution.
+		std::chrono::nanoseconds m_fetchTime;	///< Total time spent fetching.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class StatementMetrics
+	*
+	* \brief Thread-safe counters for all executions of one normalized SQL statement.
+	* \details Get instances from the StatementMetricsRegistry.
+	*/
+	class EXODBCAPI StatementMetrics
+	{
+	public:
+		/*!
+		* \brief	Create metrics for the passed normalizedSql.
+		*/
+		StatementMetrics(const std::string& normalizedSql);
+
+		StatementMetrics(const StatementMetrics& other) = delete;
+		StatementMetrics& operator=(const StatementMetrics& other) = delete;
+
+
+		/*!
+		* \brief	Record one call to SQLPrepare.
+		*/
+		void RecordPrepare(std::chrono::nanoseconds elapsed) noexcept;
+
+
+		/*!
+		* \brief	Record one execution with bytesBound bytes of bound column and parameter buffers.
+		*/
+		void RecordExecute(std::chrono::nanoseconds elapsed, unsigned long long bytesBound) noexcept;
+
+
+		/*!
+		* \brief	Record one fetch-call that fetched rows rows.
+		*/
+		void RecordFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept;
+
+
+		/*!
+		* \brief	Get the current values.
+		*/
+		StatementMetricsSnapshot GetSnapshot() const;
+
+
+		const std::string& GetNormalizedSql() const noexcept { return m_normalizedSql; };
+
+	private:
+		const std::string m_normalizedSql;
+		std::atomic<unsigned long long> m_prepareCount;
+		std::atomic<unsigned long long> m_executeCount;
+		std::atomic<unsigned long long> m_fetchCount;
+		std::atomic<unsigned long long> m_rowsFetched;
+		std::atomic<unsigned long long> m_bytesBound;
+		std::atomic<long long> m_prepareNs;
+		std::atomic<long long> m_executeNs;
+		std::atomic<long long> m_executeMaxNs;
+		std::atomic<long long> m_fetchNs;
+	};
+	typedef std::shared_ptr<StatementMetrics> StatementMetricsPtr;
+
+
+	/*!
+	* \class StatementMetricsRegistry
+	*
+	* \brief Aggregates StatementMetrics per normalized SQL text.
+	* \details	Recording is disabled by default: As long as it is disabled, ExecutableStatement,
+	*			Table (through its ExecutableStatements) and Database::ExecSql() only test one
+	*			atomic flag and do not read any clock.
+	*
+	*			The number of distinct statements is limited by GetMaxStatements(): Once the
+	*			limit is reached, new statements are aggregated into one entry with the
+	*			normalized SQL OVERFLOW_SQL.
+	*
+	*			The values can be pulled using GetSnapshots() or written in the Prometheus
+	*			text exposition format using WritePrometheus() and WritePrometheusFile().
+	*			The class is thread-safe. Use Get() to get the instance used by exodbc.
+	*/
+	class EXODBCAPI StatementMetricsRegistry
+	{
+	public:
+		/*!
+		* \brief	Default value for SetMaxStatements().
+		*/
+		static const size_t DEFAULT_MAX_STATEMENTS = 1000;
+
+		/*!
+		* \brief	Normalized SQL of the entry collecting the statements over the limit.
+		*/
+		static const char* const OVERFLOW_SQL;
+
+		StatementMetricsRegistry();
+
+		StatementMetricsRegistry(const StatementMetricsRegistry& other) = delete;
+		StatementMetricsRegistry& operator=(const StatementMetricsRegistry& other) = delete;
+
+
+		/*!
+		* \brief	Get the instance used by exodbc.
+		*/
+		static StatementMetricsRegistry& Get();
+
+
+		/*!
+		* \brief	Enable or disable recording.
+		*/
+		void SetEnabled(bool enable) noexcept { m_enabled.store(enable, std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	True if recording is enabled.
+		*/
+		bool IsEnabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); };
+
+
+		/*!
+		* \brief	Get the StatementMetrics for the passed SQL, creating them if required.
+		* \details	The SQL is normalized using NormalizeSql().
+		*/
+		StatementMetricsPtr GetStatementMetrics(const std::string& sql);
+
+
+		/*!
+		* \brief	Get the values of all statements recorded.
+		*/
+		std::vector<StatementMetricsSnapshot> GetSnapshots() const;
+
+
+		/*!
+		* \brief	Forget all statements recorded so far.
+		* \details	StatementMetrics still held by statements are no longer part of the registry.
+		*/
+		void Reset();
+
+
+		/*!
+		* \brief	Set the maximum number of distinct statements recorded.
+		*/
+		void SetMaxStatements(size_t maxStatements);
+
+
+		/*!
+		* \brief	Get the maximum number of distinct statements recorded.
+		*/
+		size_t GetMaxStatements() const;
+
+
+		/*!
+		* \brief	Write all values in the Prometheus text exposition format to out.
+		*/
+		void WritePrometheus(std::ostream& out) const;
+
+
+		/*!
+		* \brief	Write all values in the Prometheus text exposition format to the file at path.
+		* \details	The values are written to a temporary file which is then renamed, so
+		*			a scraper never reads a half-written file.
+		* \throw	Exception If writing fails.
+		*/
+		void WritePrometheusFile(const std::string& path) const;
+
+	private:
+		std::atomic<bool> m_enabled;
+		std::map<std::string, StatementMetricsPtr> m_statements;
+		size_t m_maxStatements;
+		mutable std::mutex m_mutex;
+	};
+
+
+	/*!
+	* \class StatementMetricsSink
+	*
+	* \brief Records the prepares, executions and fetches of one statement on the StatementMetricsRegistry.
+	* \details	Looks up the StatementMetrics of a prepared statement once, when it is prepared or
+	*			first executed while the StatementMetricsRegistry is enabled. The StatementMetrics
+	*			of the statement executed last stay active after End(), so the fetches of further
+	*			result sets are recorded too.
+	*/
+	class EXODBCAPI StatementMetricsSink
+		: public ExecutionSink
+	{
+	public:
+		StatementMetricsSink();
+
+		StatementMetricsSink(const StatementMetricsSink& other) = delete;
+		StatementMetricsSink& operator=(const StatementMetricsSink& other) = delete;
+
+		bool Begin(const ExecutionContext& context) override;
+		bool IsActive() const noexcept override;
+		void AddExecute(std::chrono::nanoseconds elapsed) noexcept override;
+		void AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept override;
+		void End() noexcept override;
+
+
+		/*!
+		* \brief	Returns the StatementMetrics of the statement executed last, or an
+		*			empty pointer if the StatementMetricsRegistry was disabled during that execution.
+		*/
+		StatementMetricsPtr GetMetrics() const noexcept { return m_pMetrics; };
+
+	private:
+		StatementMetricsPtr m_pPreparedMetrics;	///< Looked up when preparing or on the first execution of the prepared statement while recording.
+		StatementMetricsPtr m_pMetrics;	///< Metrics of the statement executed last, if recording.
+		StatementMetricsPtr m_pPreparing;	///< Set while a statement is being prepared.
+		SQLLEN m_bytesBound;
+	};
+
+
+	/*!
+	* \brief	Normalize the passed SQL so that executions of the same statement with different
+	*			literals are aggregated together.
+	* \details	String literals and numeric literals are replaced by '?', runs of whitespace
+	*			are collapsed into one space and leading and trailing whitespace is removed.
+	*			Identifiers, including quoted ones, are not modified.
+	*/
+	extern EXODBCAPI std::string NormalizeSql(const std::string& sql);
+} // namespace exodbc
@@ -22,6 +22,7 @@
 
 // Other headers
 // System headers
+#include <list>
 
 // Forward declarations
 // --------------------
@@ -40,6 +41,11 @@ namespace exodbc
 	// Consts
 	// ------
 
+	/*!
+	* \brief Default number of statements prepared from where templates a Table keeps.
+	*/
+	const size_t DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS = 32;
+
 	// Structs
 	// -------
 
@@ -213,6 +219,15 @@ namespace exodbc
 		*  - TableOpenFlag::TOF_FORWARD_ONLY_CURSORS:
 		*			If the Database supports Scrollable Cursors, the Table will try to use Scrollable Cursors
 		*			on the Query Statements. If this flag is set, the Table will always use forward-only Cursors.
+		*  - TableOpenFlag::TOF_FORWARD_ONLY_READ_ONLY_CURSORS, TableOpenFlag::TOF_STATIC_CURSORS,
+		*	 TableOpenFlag::TOF_KEYSET_CURSORS, TableOpenFlag::TOF_DYNAMIC_CURSORS:
+		*			Set at most one of them to select the CursorProfile of the SELECT statements, with
+		*			read-only concurrency: The Table never updates through a cursor. They take precedence
+		*			over TableOpenFlag::TOF_SCROLLABLE_CURSORS. Opening fails if the Database reports no
+		*			support for the cursor type.
+		*  - TableOpenFlag::TOF_BOOKMARKS:
+		*			Enables bookmarks on the SELECT statements, see GetBookmark() and SelectBookmark().
+		*			Requires TableOpenFlag::TOF_SCROLLABLE_CURSORS or a scrollable cursor type.
 		* \see		IsOpen()
 		* \see		Close()
 		* \see		SetColumn()
@@ -322,6 +337,39 @@ namespace exodbc
 		SQLUBIGINT	Count() { return Count(u8""); };
 
 
+		/*!
+		* \brief	Counts how many rows would be selected in this table by the passed WHERE template.
+		* \details	whereTemplate may contain parameter markers ('?'), the values of the parameters are
+		*			read from the passed whereParams. The first marker is bound to whereParams[0], etc.\n
+		*			On the first call with a whereTemplate, a statement is prepared and kept on the Table.
+		*			Later calls with the same whereTemplate reuse that prepared statement, only the
+		*			current values of the bound whereParams are sent to the Database.
+		*			If different buffers are passed for an already known whereTemplate, the parameters
+		*			are rebound. At most GetMaxWhereTemplateStatements() statements are kept,
+		*			the least recently used one is freed first. All are freed on Close().
+		* \param	whereTemplate Do not include 'WHERE' in the passed where template. Must not be empty.
+		* \param	whereParams ColumnBuffers holding the values for the parameter markers.
+		* \return	count The result of a 'SELECT COUNT(*) WHERE whereTemplate' on the current table
+		* \throw	Exception If failed.
+		*/
+		SQLUBIGINT	Count(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams);
+
+
+		/*!
+		* \brief	Estimates the number of rows of this table from the statistics of the Database.
+		* \details	Reads the cardinality of the table using DatabaseCatalog::ReadStatistics() with
+		*			SQL_QUICK, so the driver only reports values it has readily available. No rows
+		*			are read, but the value might be outdated.\n
+		*			If the driver does not report a cardinality and countIfUnknown is true, the
+		*			rows are counted using Count(). This requires AccessFlag AF_COUNT_WHERE.
+		* \param	countIfUnknown	If true, fall back to Count() if no cardinality is reported.
+		* \return	The estimated number of rows.
+		* \throw	NotFoundException If no cardinality is reported and countIfUnknown is false.
+		* \throw	Exception If failed.
+		*/
+		SQLUBIGINT	EstimateCount(bool countIfUnknown = true);
+
+
 		/*!
 		* \brief	Executes a 'SELECT col1, col2, .., colN' for the Table using the passed WHERE clause.
 		* \details	The SELECT-Query is built using the column information available to this Table.
@@ -342,6 +390,30 @@ namespace exodbc
 		void		Select(const std::string& whereStatement = u8"", const std::string& orderStatement = u8"");
 
 
+		/*!
+		* \brief	Executes a 'SELECT col1, col2, .., colN' for the Table using the passed WHERE template.
+		* \details	Works like Select(const std::string&, const std::string&), but whereTemplate
+		*			may contain parameter markers ('?'). The values of the parameters are read from the
+		*			passed whereParams, the first marker is bound to whereParams[0], etc.\n
+		*			On the first call with a combination of whereTemplate and orderStatement, a statement
+		*			is prepared and kept on the Table, the selected columns are bound to it.
+		*			Later calls with the same whereTemplate and orderStatement reuse that prepared statement,
+		*			only the current values of the bound whereParams are sent to the Database.
+		*			If different buffers are passed for an already known whereTemplate, the parameters
+		*			are rebound. At most GetMaxWhereTemplateStatements() statements are kept,
+		*			the least recently used one is freed first. All are freed on Close().\n
+		*			Use SelectNext(), SelectPrev(), etc. to iterate the records as usual.
+		*			If a select statement is open, the statement is closed first.
+		* \param	whereTemplate Do not include 'WHERE' in the passed where template. Must not be empty.
+		* \param	whereParams ColumnBuffers holding the values for the parameter markers.
+		* \param	orderStatement Do not include 'ORDER BY' in the passed oder clause
+		* \see		SelectNext()
+		* \see		SelectClose()
+		* \throw	Exception If failed.
+		*/
+		void		Select(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams, const std::string& orderStatement = u8"");
+
+
 		/*!
 		* \brief	Executes a 'SELECT col1, col2, .., colN WHERE PK1 = p1 AND PK2 = p2, ..' for the Table.
 		* \details	All ColumnBuffers that had the flag flag CF_SELECT set during open are included 
@@ -359,6 +431,35 @@ namespace exodbc
 		void		SelectByPkValues();
 
 
+		/*!
+		* \brief	Get an input range over the rows of a 'SELECT col1, col2, .., colN' for the Table.
+		* \details	The SELECT-Query is built the same way as by Select(const std::string&, const std::string&),
+		*			but executed on a statement of its own that is kept alive by the returned RowRange.
+		*			The selected columns are bound as arrays of blockSize elements, using the SQL C Types
+		*			and sizes of the ColumnBuffers of this Table: Column i of the RowRange is the
+		*			i-th ColumnBuffer with CF_SELECT set. The ColumnBuffers of the Table are not
+		*			modified and a Select-Query open on the Table is not affected.
+		* \param	whereStatement Do not include 'WHERE' in the passed where clause
+		* \param	orderStatement Do not include 'ORDER BY' in the passed oder clause
+		* \param	blockSize Number of rows fetched with one call to SQLFetch.
+		* \see		RowRange
+		* \throw	Exception If failed.
+		*/
+		RowRange	Rows(const std::string& whereStatement = u8"", const std::string& orderStatement = u8"", SQLULEN blockSize = DEFAULT_ROW_BLOCK_SIZE) const;
+
+
+		/*!
+		* \brief	Same as Rows(const std::string&, const std::string&, SQLULEN), but the
+		*			query is executed on a connection of pDb.
+		* \details	pDb must be connected to the same data source as the Database of this
+		*			Table, for example using Database::OpenNewConnection(). Used to read
+		*			the Table on several connections in parallel, see ParallelTableScan.
+		*			pDb must be kept alive as long as the returned RowRange is alive.
+		* \throw	Exception If failed.
+		*/
+		RowRange	Rows(ConstDatabasePtr pDb, const std::string& whereStatement, const std::string& orderStatement = u8"", SQLULEN blockSize = DEFAULT_ROW_BLOCK_SIZE) const;
+
+
 		/*!
 		* \brief	Executes the passed SQL statement on the open Table.
 		* \details	Query by passing the complete SQL statement.
@@ -437,6 +538,26 @@ namespace exodbc
 		bool		SelectRelative(SQLLEN offset);
 
 
+		/*!
+		* \brief	Get the bookmark of the current record of the current active Select() recordset.
+		* \see		ExecutableStatement::GetBookmark()
+		* \throw	Exception If the Table has not been opened with TOF_BOOKMARKS, or no record is selected.
+		*/
+		Bookmark	GetBookmark() const;
+
+
+		/*!
+		* \brief	Fetches the record with the passed bookmark, or the record offset records away
+		*			from it, from the current active Select() recordset.
+		* \details	Jumps to a record read before without counting records like SelectAbsolute()
+		*			might, if the driver supports bookmarks.
+		* \see		ExecutableStatement::SelectBookmark()
+		* \return	True if the record has been fetched, false if no record available.
+		* \throw	Exception If no SelectQuery is open, or if TOF_BOOKMARKS is not set.
+		*/
+		bool		SelectBookmark(const Bookmark& bookmark, SQLLEN offset = 0);
+
+
 		/*!
 		* \brief	Closes an eventually open Select-Query.
 		* \details	This function does not fail if no select statement was open.
@@ -496,6 +617,30 @@ namespace exodbc
 		void		Delete(const std::string& where, bool failOnNoData = true) const;
 
 
+		/*!
+		* \brief	Delete the row(s) identified by the passed where template.
+		* \details	Works like Delete(const std::string&, bool), but whereTemplate may contain
+		*			parameter markers ('?'). The values of the parameters are read from the passed
+		*			whereParams, the first marker is bound to whereParams[0], etc.\n
+		*			On the first call with a whereTemplate, a statement is prepared and kept on the Table.
+		*			Later calls with the same whereTemplate reuse that prepared statement.
+		*			If different buffers are passed for an already known whereTemplate, the parameters
+		*			are rebound. At most GetMaxWhereTemplateStatements() statements are kept,
+		*			the least recently used one is freed first. All are freed on Close().\n
+		*			Fails if the table has not been opened using TableAccessFlag::AF_DELETE_WHERE. \n
+		*			This will not commit the transaction.
+		* \param	whereTemplate WHERE clause to be used. Do not include 'WHERE', the Table will add this.
+		*			Not allowed to be empty.
+		* \param	whereParams ColumnBuffers holding the values for the parameter markers.
+		* \param	failOnNoData If set to true the function will return false if the result of
+		*			the DELETE is SQL_NO_DATA.
+		* \see		Database::CommitTrans()
+		* \throw	Exception on failure, or depending on failOnNoData, a SqlResultException if the
+		*			call to SQLExecute fails with SQL_NO_DATA.
+		*/
+		void		Delete(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams, bool failOnNoData = true) const;
+
+
 		/*!
 		* \brief	Updates the row identified by the values of the bound primary key columns with
 		*			the values in bound ColumnBuffers, if the ColumnBuffer has the ColumnFlags::CF_UPDATE
@@ -533,6 +678,108 @@ namespace exodbc
 		void		Update(const std::string& where);
 
 
+		/*!
+		* \brief	Updates the row identified by the passed where template with
+		*			the values in bound ColumnBuffers, if the ColumnBuffer has the ColumnFlags::CF_UPDATE
+		*			set.
+		* \details	Works like Update(const std::string&), but whereTemplate may contain
+		*			parameter markers ('?'). The values of the parameters are read from the passed
+		*			whereParams, the first marker is bound to whereParams[0], etc. The parameters
+		*			of the SET part are bound before the whereParams.\n
+		*			On the first call with a whereTemplate, a statement is prepared and kept on the Table.
+		*			Later calls with the same whereTemplate reuse that prepared statement.
+		*			If different buffers are passed for an already known whereTemplate, the parameters
+		*			are rebound. At most GetMaxWhereTemplateStatements() statements are kept,
+		*			the least recently used one is freed first. All are freed on Close().\n
+		*			Fails if the table has not been opened using TableAccessFlag::AF_UPDATE_WHERE. \n
+		*			This will not commit the transaction.
+		* \param	whereTemplate WHERE clause to be used. Do not include 'WHERE', the Table will add this.
+		* \param	whereParams ColumnBuffers holding the values for the parameter markers.
+		* \see		Database::CommitTrans()
+		* \throw	Exception if failed.
+		*/
+		void		Update(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams);
+
+
+		/*!
+		* \brief	Inserts the current values as a new row, or updates the row with the same
+		*			primary key values if such a row exists.
+		* \details	The values of the ColumnBuffers that have the flag ColumnFlags::CF_INSERT set
+		*			are inserted, these must include all primary key columns. If the row exists,
+		*			the columns with ColumnFlags::CF_UPDATE set are updated, like UpdateByPkValues() does.
+		*			Columns with ColumnFlags::CF_UPDATE must have ColumnFlags::CF_INSERT set too.\n
+		*			On Microsoft SQL Server and DB2 a MERGE statement is used, on PostgreSQL
+		*			INSERT .. ON CONFLICT and on MySQL INSERT .. ON DUPLICATE KEY UPDATE, see
+		*			BuildUpsertSql(). The statement is prepared on the first call. On other
+		*			databases the row is updated using UpdateByPkValues(), and inserted using
+		*			Insert() if no row has been updated. If the driver does not report the number
+		*			of rows updated, the row is only inserted if Count() does not find its primary
+		*			key values, which requires TableAccessFlag::AF_COUNT_WHERE.\n
+		*			Fails if the table has not been opened using TableAccessFlag::AF_INSERT and
+		*			TableAccessFlag::AF_UPDATE_PK. \n
+		*			This will not commit the transaction.
+		* \see		Database::CommitTrans()
+		* \throw	Exception if failed, or if the number of rows updated is unknown and the
+		*			table has not been opened using TableAccessFlag::AF_COUNT_WHERE.
+		*/
+		void		Upsert();
+
+
+		/*!
+		* \brief	Inserts or updates all rows of the current block of rows, identifying rows
+		*			by their primary key values.
+		* \details	Every column of the block is matched to the column of this Table with the same
+		*			query name (ignoring case). The block must contain all primary key columns, the
+		*			other columns of the block are updated if the row exists. The rows are bound as
+		*			parameter arrays, see ExecutableStatement::ExecutePreparedArray(), and sent using
+		*			the statement created by BuildUpsertSql(). \n
+		*			On databases without such a statement, all rows are updated using one UPDATE
+		*			with parameter arrays. If some but not all rows have been updated, every row is
+		*			updated again on its own to find the missing ones. If the driver does not report
+		*			the number of rows updated, the rows whose primary key values are not found by
+		*			a SELECT COUNT(*) are the missing ones. The rows not updated are then
+		*			inserted using one INSERT with parameter arrays.\n
+		*			The statements are kept until a block with different columns is passed or the
+		*			Table is closed. Fails if the table has not been opened using
+		*			TableAccessFlag::AF_INSERT and TableAccessFlag::AF_UPDATE_PK. \n
+		*			This will not commit the transaction.
+		* \param	rows Block holding the rows, for example RowRange::GetBlock() or a copy of it.
+		* \return	Number of rows inserted or updated.
+		* \see		Database::CommitTrans()
+		* \throw	NotFoundException If a column of the block is not a column of this Table.
+		* \throw	Exception if failed.
+		*/
+		SQLULEN		Upsert(const RowBlock& rows);
+
+
+		/*!
+		* \brief	Create the statement inserting a row into tableQueryName, or updating it if a
+		*			row with the same key values exists, for dbms.
+		* \details	The statement has one parameter marker for every column, in the order of
+		*			columns. Microsoft SQL Server and DB2 use MERGE, PostgreSQL uses
+		*			INSERT .. ON CONFLICT and MySQL uses INSERT .. ON DUPLICATE KEY UPDATE.
+		* \param	dbms			Database to create the statement for.
+		* \param	tableQueryName	Name of the table, as used in statements.
+		* \param	columns			Query names of the columns.
+		* \param	keyColumns		Query names of the primary key columns, all of them must be part of columns.
+		* \param	updateColumns	Query names of the columns updated if the row exists, all of them must be part of columns.
+		* \return	An empty string if dbms has no such statement.
+		*/
+		static std::string BuildUpsertSql(DatabaseProduct dbms, const std::string& tableQueryName, const std::vector<std::string>& columns,
+			const std::vector<std::string>& keyColumns, const std::vector<std::string>& updateColumns);
+
+
+		/*!
+		* \brief	Remove the results depending on this table from the ResultCache of the
+		*			Database, if one is set.
+		* \details	Called by Insert(), Update*() and Delete*(). Call it after writing to the
+		*			table by other means.
+		* \see		Database::SetResultCache()
+		* \see		Database::InvalidateResultCache()
+		*/
+		void		InvalidateResultCache() const;
+
+
 		/*!
 		* \brief	Sets the the length-indicator value of the ColumnBuffer
 		*			at columnIndex.
@@ -777,6 +1024,35 @@ namespace exodbc
 		const TableInfo& GetTableInfo() const;
 
 
+		/*!
+		* \brief	Get the Database this Table belongs to.
+		*/
+		ConstDatabasePtr GetDatabase() const noexcept { return m_pDb; };
+
+
+		/*!
+		* \brief	Set the number of statements prepared from where templates that are kept.
+		* \details	If more templates are used, the statement used least recently is freed and
+		*			prepared again on its next use. The statement SelectNext() currently reads
+		*			from is never freed, while it is kept one more statement than maxStatements
+		*			may be kept. Defaults to DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS.
+		*			Statements exceeding a lowered limit are freed immediately.
+		*/
+		void SetMaxWhereTemplateStatements(size_t maxStatements);
+
+
+		/*!
+		* \brief	Get the number of statements prepared from where templates that are kept.
+		*/
+		size_t GetMaxWhereTemplateStatements() const noexcept { return m_maxWhereTemplateStmts; };
+
+
+		/*!
+		* \brief	Get the number of statements prepared from where templates currently kept.
+		*/
+		size_t GetWhereTemplateStatementCount() const noexcept { return m_whereTemplateStmts.size(); };
+
+
 		// Private stuff
 		// -------------
 	private:
@@ -791,7 +1067,15 @@ namespace exodbc
 		*
 		* \throw	Exception If any of the handles to be allocated is not null currently.
 		*/
-		void AllocateStatements(bool scrollableCursors);
+		void AllocateStatements();
+
+
+		/*!
+		* \brief	Init stmt to be used for SELECTs: Sets the CursorProfile selected by the
+		*			TableOpenFlags, or enables scrollable cursors if TOF_SCROLLABLE_CURSORS is set.
+		*			Enables bookmarks if TOF_BOOKMARKS is set.
+		*/
+		void InitSelectStatement(ExecutableStatement& stmt) const;
 
 	
 		/*!
@@ -817,6 +1101,23 @@ namespace exodbc
 		* \throw	Exception If no ColumnBuffers are bound, not opened for writing, etc., or binding fails.
 		*/
 		void		BindInsertParameters();
+
+
+		/*!
+		* \brief	Prepares the statement created by BuildUpsertSql() for the columns with flag CF_INSERT,
+		*			if the Database has one, and binds these columns.
+		* \throw	Exception If a primary key column does not have the flag CF_INSERT set, or binding fails.
+		*/
+		void		BindUpsertParameters();
+
+
+		/*!
+		* \brief	Prepares the statements used by Upsert(const RowBlock&) for the columns of rows,
+		*			unless they have been prepared for the same columns already.
+		* \throw	NotFoundException If a column of the block is not a column of this Table.
+		* \throw	Exception If the block does not contain all primary key columns, or preparing fails.
+		*/
+		void		PrepareUpsertArray(const RowBlock& rows);
 		
 		
 		/*!
@@ -845,6 +1146,49 @@ namespace exodbc
 		void		BindSelectPkParameters();
 
 
+		/*!
+		* \brief	Binds all columns with the flag CF_SELECT set to the passed statement, starting
+		*			with column number 1.
+		* \throw	Exception If binding fails.
+		*/
+		void		BindSelectColumns(ExecutableStatement& stmt) const;
+
+
+		/*!
+		* \brief	Closes the currently active select statement if it is not pStmt and
+		*			sets pStmt as the active select statement.
+		* \details	SelectNext(), SelectPrev(), etc. operate on the active select statement.
+		*/
+		void		ActivateSelectStatement(ExecutableStatement* pStmt);
+
+
+		/*!
+		* \brief	Searches the prepared statements created from where templates for one matching sqlStmt.
+		* \details	If no statement is found, a new statement is allocated and sqlStmt is prepared.
+		*			If selectCursor is true, the statement is initialized using InitSelectStatement(),
+		*			else it uses forward-only cursors.
+		*			If bindSelectColumns is true, all columns with the flag CF_SELECT are bound to the new
+		*			statement. If bindCountBuffer is true, the count result buffer is bound to the new
+		*			statement.\n
+		*			If the parameters bound to the statement differ from leadingParams followed by whereParams,
+		*			those are bound as parameters.
+		* \return	The prepared statement, with the passed parameters bound.
+		* \throw	Exception If allocating, preparing or binding fails.
+		*/
+		ExecutableStatementPtr GetWhereTemplateStatement(const std::string& sqlStmt, bool selectCursor,
+			bool bindSelectColumns, bool bindCountBuffer, const std::vector<ColumnBufferPtrVariant>& leadingParams,
+			const std::vector<ColumnBufferPtrVariant>& whereParams) const;
+
+
+		/*!
+		* \brief	Free the least recently used statements of m_whereTemplateStmts until no more
+		*			than m_maxWhereTemplateStmts are left.
+		* \details	Neither the statement m_pActiveSelectStmt points to nor pKeep are freed, so
+		*			the map may keep one statement more than m_maxWhereTemplateStmts.
+		*/
+		void EvictWhereTemplateStatements(const ExecutableStatement* pKeep) const;
+
+
 		/*!
 		* \brief	Return a defined ColumnBuffer that is not NULL.
 		* \details	Searches the internal map of ColumnBuffers for a ColumnBuffer with
@@ -904,7 +1248,51 @@ namespace exodbc
 		ExecutableStatement m_execStmtInsert;	///< Statement to INSERT. Prepared SQL statement bound to all params with flag CF_INSERT.
 		ExecutableStatement m_execStmtUpdatePk;	///< Statement to UPDATE columns with flag CF_UPDATE. WHERE clause is formed using primary key columns.
 		ExecutableStatement m_execStmtDeletePk; ///< Statement to DELETE. WHERE clause is formed using primary key columns.
+		ExecutableStatement m_execStmtUpsert;	///< Statement to insert or update the columns with flag CF_INSERT, prepared on the first call to Upsert(). Not initialized if the Database has no such statement.
 		UBigIntColumnBufferPtr m_pSelectCountResultBuffer;	///< The buffer used to retrieve the result of a SELECT COUNT operation.
+		ExecutableStatement* m_pActiveSelectStmt;	///< Statement SelectNext(), etc. operate on. Either &m_execStmtSelect or a statement from m_whereTemplateStmts.
+		bool m_upsertPrepared;	///< True once Upsert() has decided whether m_execStmtUpsert is used.
+
+		/*!
+		* \struct	WhereTemplateStatement
+		* \brief	A statement prepared from a where template and the parameters currently bound to it.
+		*/
+		struct WhereTemplateStatement
+		{
+			ExecutableStatementPtr m_pStmt;
+			std::vector<ColumnBufferPtrVariant> m_boundParams;
+			std::list<std::string>::iterator m_lruPos;	///< Position of the key in m_whereTemplateLru.
+		};
+		mutable std::map<std::string, WhereTemplateStatement> m_whereTemplateStmts;	///< Statements prepared from where templates, key is the prepared SQL.
+		mutable std::list<std::string> m_whereTemplateLru;	///< Keys of m_whereTemplateStmts, most recently used first.
+		size_t m_maxWhereTemplateStmts;
+
+		/*!
+		* \struct	UpsertArrayColumn
+		* \brief	A column of the blocks passed to Upsert(const RowBlock&).
+		*/
+		struct UpsertArrayColumn
+		{
+			std::string m_queryName;	///< Query name of the column of this Table.
+			ParameterDescription m_paramDesc;	///< Description of the column of this Table.
+			bool m_isKey;	///< True for primary key columns.
+		};
+
+		/*!
+		* \struct	UpsertArrayStatements
+		* \brief	The statements prepared by Upsert(const RowBlock&) for the columns of the blocks passed.
+		*/
+		struct UpsertArrayStatements
+		{
+			std::vector<std::string> m_blockColumns;	///< Query names of the columns of the block the statements have been prepared for.
+			std::vector<UpsertArrayColumn> m_columns;	///< The matching columns of this Table, in the order of the block.
+			ExecutableStatementPtr m_pUpsert;	///< Statement created by BuildUpsertSql(), or empty if the Database has none.
+			ExecutableStatementPtr m_pUpdate;	///< Fallback: UPDATE, the updated columns first, then the key columns.
+			ExecutableStatementPtr m_pInsert;	///< Fallback: INSERT of all columns.
+			ExecutableStatementPtr m_pCountKey;	///< Fallback if the number of rows updated is unknown: COUNT of the rows with the key columns, prepared on first use.
+			UBigIntColumnBufferPtr m_pKeyCount;	///< Result column of m_pCountKey.
+		};
+		UpsertArrayStatements m_upsertArray;	///< Statements of Upsert(const RowBlock&).
 
 		// Table Information
 		bool				m_haveTableInfo;		///< True if m_tableInfo has been set
@@ -0,0 +1,197 @@
+﻿/*!
+* \file TableCopy.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the TableCopy class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Table.h"
+#include "RowRange.h"
+#include "ParameterDescription.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct TableCopyResult
+	* \brief Summary of a TableCopy::Run().
+	*/
+	struct EXODBCAPI TableCopyResult
+	{
+		TableCopyResult()
+			: m_rows(0)
+			, m_blocks(0)
+			, m_commits(0)
+			, m_truncatedValues(0)
+			, m_duration(0)
+			, m_readTime(0)
+			, m_writeTime(0)
+		{ };
+
+		/*!
+		* \brief	Rows copied per second, or 0 if nothing has been copied.
+		*/
+		double GetRowsPerSecond() const noexcept
+		{
+			return m_duration.count() > 0 ? m_rows * 1e9 / m_duration.count() : 0.0;
+		};
+
+		unsigned long long m_rows;	///< Number of rows inserted into the target.
+		unsigned long long m_blocks;	///< Number of blocks read from the source and inserted into the target.
+		unsigned long long m_commits;	///< Number of transactions committed on the target.
+		unsigned long long m_truncatedValues;	///< Number of character or binary values that did not fit into the columns of the target and have been truncated.
+		std::chrono::nanoseconds m_duration;	///< Time the copy took.
+		std::chrono::nanoseconds m_readTime;	///< Time the reading thread spent fetching from the source.
+		std::chrono::nanoseconds m_writeTime;	///< Time spent inserting into and committing on the target.
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class TableCopy
+	*
+	* \brief Copies the rows of a Table into a Table of another (or the same) Database.
+	* \details	The columns of the target Table are matched by name (case-insensitive)
+	*			to the columns of the source Table, target columns without a matching source
+	*			column are not inserted. The values are read with the SQL C Types of the
+	*			ColumnBuffers of the target Table, which have been created using the
+	*			Sql2BufferTypeMap of the target Database: The source driver converts the
+	*			values while fetching, the target driver receives them in the types it expects.
+	*
+	*			A thread reads blocks of GetBlockSize() rows from the source and hands them
+	*			over a queue of at most GetQueueCapacity() blocks to the thread calling Run(),
+	*			which inserts every block with one execution of a prepared INSERT, using
+	*			ExecutableStatement::ExecutePreparedArray(). Reading and writing overlap.
+	*
+	*			If the target Database is in CommitMode::MANUAL, a transaction is committed
+	*			after at least GetCommitRows() rows and after the last row. If copying fails,
+	*			the current transaction is rolled back, rows committed before are kept.
+	*
+	*			The source Database is used by the reading thread only while Run() executes:
+	*			Do not use the source Database from other threads during the copy. If source
+	*			and target Table share one Database, the rows are read through a connection
+	*			opened using Database::OpenNewConnection() for the duration of Run(), which
+	*			does not see the rows inserted by the uncommitted transaction of the target.
+	*			Source and target Table must be open and stay alive while the copy runs.
+	*/
+	class EXODBCAPI TableCopy
+	{
+	public:
+		/*!
+		* \brief	Default number of blocks queued between the reading and the writing thread.
+		*/
+		static const size_t DEFAULT_QUEUE_CAPACITY = 4;
+
+		/*!
+		* \brief	Default number of rows after which a transaction is committed.
+		*/
+		static const unsigned long long DEFAULT_COMMIT_ROWS = 10000;
+
+		TableCopy() = delete;
+
+		/*!
+		* \brief	Create a copy from source into target.
+		*/
+		TableCopy(const Table& source, const Table& target);
+
+		TableCopy(const TableCopy& other) = delete;
+		TableCopy& operator=(const TableCopy& other) = delete;
+
+
+		/*!
+		* \brief	Only copy the rows of the source matching whereStatement. Do not include 'WHERE'.
+		*/
+		void SetWhere(const std::string& whereStatement) { m_whereStatement = whereStatement; };
+
+
+		/*!
+		* \brief	Set the number of rows fetched and inserted at once. Defaults to DEFAULT_ROW_BLOCK_SIZE.
+		*/
+		void SetBlockSize(SQLULEN blockSize);
+
+
+		/*!
+		* \brief	Get the number of rows fetched and inserted at once.
+		*/
+		SQLULEN GetBlockSize() const noexcept { return m_blockSize; };
+
+
+		/*!
+		* \brief	Set the maximum number of blocks read but not inserted yet. Defaults to DEFAULT_QUEUE_CAPACITY.
+		*/
+		void SetQueueCapacity(size_t queueCapacity);
+
+
+		/*!
+		* \brief	Get the maximum number of blocks read but not inserted yet.
+		*/
+		size_t GetQueueCapacity() const noexcept { return m_queueCapacity; };
+
+
+		/*!
+		* \brief	Set the number of rows after which a transaction is committed, if the
+		*			target Database is in CommitMode::MANUAL. Set to 0 to commit only once
+		*			after the last row. Defaults to DEFAULT_COMMIT_ROWS.
+		*/
+		void SetCommitRows(unsigned long long commitRows) noexcept { m_commitRows = commitRows; };
+
+
+		/*!
+		* \brief	Get the number of rows after which a transaction is committed.
+		*/
+		unsigned long long GetCommitRows() const noexcept { return m_commitRows; };
+
+
+		/*!
+		* \brief	Get the pairs of source and target column names that are copied.
+		* \throw	Exception If no column of the target matches a column of the source.
+		*/
+		std::vector<std::pair<std::string, std::string>> GetColumnMapping() const;
+
+
+		/*!
+		* \brief	Copy the rows.
+		* \throw	Exception If reading or writing fails.
+		*/
+		TableCopyResult Run();
+
+	private:
+		struct CopyColumn
+		{
+			std::string m_sourceName;
+			std::string m_targetName;
+			RowColumnDefinition m_definition;
+			ParameterDescription m_paramDesc;
+		};
+
+		std::vector<CopyColumn> MapColumns() const;
+
+		const Table& m_source;
+		const Table& m_target;
+		std::string m_whereStatement;
+		SQLULEN m_blockSize;
+		size_t m_queueCapacity;
+		unsigned long long m_commitRows;
+	};
+} // namespace exodbc
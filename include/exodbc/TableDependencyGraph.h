@@ -0,0 +1,138 @@
+﻿/*!
+* \file TableDependencyGraph.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the TableDependencyGraph class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Database.h"
+#include "TableInfo.h"
+#include "ForeignKeyInfo.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <set>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+
+	/*!
+	* \class TableDependencyGraph
+	*
+	* \brief The foreign key dependencies between a set of tables.
+	* \details	A table depends on every table its foreign keys reference: The rows of the
+	*			referenced tables must be loaded first. Tables are identified by their index
+	*			in the TableInfoVector the graph has been created with.
+	*
+	*			Foreign keys referencing tables outside of the set are ignored, these tables
+	*			are assumed to be loaded already. A table referencing itself does not depend
+	*			on itself, its rows must be loaded in a valid order by whoever loads it.
+	*
+	*			GetWaves() orders the tables topologically: The tables of a wave only depend
+	*			on tables of earlier waves and can be loaded concurrently, see TableLoadScheduler.
+	*/
+	class EXODBCAPI TableDependencyGraph
+	{
+	public:
+		/*!
+		* \brief	Create a graph holding tables, without any dependencies.
+		*/
+		TableDependencyGraph(const TableInfoVector& tables);
+
+
+		/*!
+		* \brief	Create a graph holding tables, adding a dependency for every foreign key
+		*			read using DatabaseCatalog::ReadForeignKeyInfo().
+		* \throw	Exception If reading the foreign keys fails.
+		*/
+		static TableDependencyGraph Create(ConstDatabasePtr pDb, const TableInfoVector& tables);
+
+
+		/*!
+		* \brief	Get the number of tables.
+		*/
+		size_t GetTableCount() const noexcept { return m_tables.size(); };
+
+
+		/*!
+		* \brief	Get the tables, in the order passed on construction.
+		*/
+		const TableInfoVector& GetTables() const noexcept { return m_tables; };
+
+
+		/*!
+		* \brief	Get the table at index.
+		*/
+		const TableInfo& GetTable(size_t index) const;
+
+
+		/*!
+		* \brief	Find the index of a table. Schema and catalog name are only compared
+		*			if they are not empty and the table has a schema or catalog.
+		* \return	The index of the first matching table.
+		* \throw	NotFoundException If no table matches.
+		*/
+		size_t FindTable(const std::string& tableName, const std::string& schemaName = u8"", const std::string& catalogName = u8"") const;
+
+
+		/*!
+		* \brief	Make table depend on referencedTable. A table cannot depend on itself,
+		*			the call is ignored if both indexes are equal.
+		*/
+		void AddDependency(size_t table, size_t referencedTable);
+
+
+		/*!
+		* \brief	Add a dependency for the foreign key fk, if both its tables are part of the graph.
+		* \return	True if a dependency has been added.
+		*/
+		bool AddDependency(const ForeignKeyInfo& fk);
+
+
+		/*!
+		* \brief	Get the indexes of the tables table depends on.
+		*/
+		const std::set<size_t>& GetDependencies(size_t table) const;
+
+
+		/*!
+		* \brief	Get the indexes of the tables depending on table.
+		*/
+		const std::set<size_t>& GetDependents(size_t table) const;
+
+
+		/*!
+		* \brief	Order the tables topologically in waves.
+		* \details	The first wave holds all tables without dependencies, every following
+		*			wave the tables whose dependencies are all part of earlier waves. Within
+		*			a wave, tables are ordered by their index.
+		* \throw	Exception If the dependencies form a cycle, listing the tables of the cycle.
+		*/
+		std::vector<std::vector<size_t>> GetWaves() const;
+
+	private:
+		bool MatchesTable(size_t index, const std::string& tableName, const std::string& schemaName, const std::string& catalogName) const;
+
+		TableInfoVector m_tables;
+		std::vector<std::set<size_t>> m_dependencies;
+		std::vector<std::set<size_t>> m_dependents;
+	};
+} // namespace exodbc
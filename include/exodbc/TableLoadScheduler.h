@@ -0,0 +1,163 @@
+﻿/*!
+* \file TableLoadScheduler.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the TableLoadScheduler class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Database.h"
+#include "TableInfo.h"
+#include "TableCopy.h"
+#include "TableDependencyGraph.h"
+#include "ParallelTableScan.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct TableLoadResult
+	* \brief Summary of a TableLoadScheduler::Run().
+	*/
+	struct EXODBCAPI TableLoadResult
+	{
+		TableLoadResult()
+			: m_tables(0)
+			, m_rows(0)
+			, m_waves(0)
+			, m_maxConcurrentTables(0)
+			, m_duration(0)
+		{ };
+
+		unsigned long long m_tables;	///< Number of tables loaded.
+		unsigned long long m_rows;	///< Sum of the rows reported by the loads of all tables.
+		size_t m_waves;	///< Number of waves of the TableDependencyGraph.
+		size_t m_maxConcurrentTables;	///< Largest number of tables loaded at the same time.
+		std::vector<unsigned long long> m_tableRows;	///< Rows reported per table, by index in the TableDependencyGraph.
+		std::vector<std::chrono::nanoseconds> m_tableDurations;	///< Time the load took per table, by index in the TableDependencyGraph.
+		std::chrono::nanoseconds m_duration;	///< Time from starting the first until finishing the last table.
+	};
+
+
+	/*!
+	* \typedef TableLoadTask
+	* \brief Loads one table on the connection pDb of the calling thread, returning the number of rows loaded.
+	*/
+	typedef std::function<unsigned long long(const TableInfo& table, DatabasePtr pDb)> TableLoadTask;
+
+
+	/*!
+	* \typedef TableCopySetup
+	* \brief Called by TableLoadScheduler::RunCopy() to configure the TableCopy of a table before it runs.
+	*/
+	typedef std::function<void(const TableInfo& target, TableCopy& copy)> TableCopySetup;
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class TableLoadScheduler
+	*
+	* \brief Loads the tables of a TableDependencyGraph on several connections and threads,
+	*			never loading a table before the tables it depends on.
+	* \details	GetConcurrency() threads are started, each opening a connection of its own
+	*			using the connection factory, or Database::OpenNewConnection() on the Database
+	*			passed on construction. Every thread picks the next table whose dependencies
+	*			have all been loaded, in the order of their index in the graph, and passes it
+	*			to the task with its connection.
+	*
+	*			This respects the waves of TableDependencyGraph::GetWaves(), but does not wait
+	*			for a whole wave to finish: A table starts as soon as the tables it references
+	*			are loaded, so a large table does not hold back unrelated tables of the next wave.
+	*
+	*			If a task fails, no more tables are started. Once the running tasks have
+	*			finished, the first exception is rethrown. Tables loaded before are kept.
+	*/
+	class EXODBCAPI TableLoadScheduler
+	{
+	public:
+		TableLoadScheduler() = delete;
+
+		/*!
+		* \brief	Create a scheduler loading the tables of graph into pDb. The graph must be
+		*			kept alive while the scheduler is used.
+		* \details	The concurrency defaults to the number of hardware threads.
+		*/
+		TableLoadScheduler(const TableDependencyGraph& graph, ConstDatabasePtr pDb);
+
+		TableLoadScheduler(const TableLoadScheduler& other) = delete;
+		TableLoadScheduler& operator=(const TableLoadScheduler& other) = delete;
+
+
+		/*!
+		* \brief	Set the maximum number of tables loaded at the same time, and therefore of
+		*			connections and threads.
+		*/
+		void SetConcurrency(size_t concurrency);
+
+
+		/*!
+		* \brief	Get the maximum number of tables loaded at the same time.
+		*/
+		size_t GetConcurrency() const noexcept { return m_concurrency; };
+
+
+		/*!
+		* \brief	Set the function used to open the connection of every thread. The function
+		*			is called from the loading threads.
+		*/
+		void SetConnectionFactory(ConnectionFactory factory) { m_connectionFactory = factory; };
+
+
+		/*!
+		* \brief	Load all tables by calling task for every table.
+		* \details	task is called concurrently from the loading threads, with the connection
+		*			of the calling thread.
+		* \throw	Exception If the dependencies form a cycle, or whatever task throws.
+		*/
+		TableLoadResult Run(const TableLoadTask& task);
+
+
+		/*!
+		* \brief	Copy sourceTables[i] into the table i of the graph for all tables, using TableCopy.
+		* \details	Every thread opens a connection to the source using sourceFactory. Source
+		*			and target Tables are opened with TableAccessFlag::AF_READ_WITHOUT_PK,
+		*			creating ColumnBuffers for all columns. If setup is set, it is called with
+		*			every TableCopy before it runs.
+		* \throw	Exception If the dependencies form a cycle, or copying a table fails.
+		*/
+		TableLoadResult RunCopy(ConnectionFactory sourceFactory, const TableInfoVector& sourceTables, const TableCopySetup& setup = TableCopySetup());
+
+	private:
+		typedef std::function<unsigned long long(size_t worker, size_t table, DatabasePtr pDb)> WorkerTask;
+		struct LoadState;
+
+		TableLoadResult RunWorkers(const WorkerTask& task);
+		void LoadTables(size_t worker, const WorkerTask& task, LoadState& state) const;
+
+		const TableDependencyGraph& m_graph;
+		ConstDatabasePtr m_pDb;
+		size_t m_concurrency;
+		ConnectionFactory m_connectionFactory;
+	};
+} // namespace exodbc
@@ -0,0 +1,153 @@
+﻿/*!
+* \file TablePaginator.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Header file for the TablePaginator class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbc.h"
+#include "Table.h"
+#include "ExecutableStatement.h"
+#include "RowRange.h"
+
+// Other headers
+// System headers
+#include <string>
+#include <vector>
+
+// Forward declarations
+// --------------------
+
+namespace exodbc
+{
+	// Consts
+	// ------
+
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+
+	/*!
+	* \class TablePaginator
+	*
+	* \brief Pages through the rows of a Table ordered by its primary key, using the seek method.
+	* \details	Instead of skipping the rows of the previous pages using an offset or
+	*			SelectAbsolute(), which gets slower with every page, the next page is selected
+	*			by a prepared statement with a WHERE clause on the primary key columns, bound
+	*			to the key of the last row of the previous page:
+	*			\code
+	*			SELECT TOP 100 id1, id2, value FROM t WHERE id1 > ? OR (id1 = ? AND id2 > ?) ORDER BY id1, id2
+	*			\endcode
+	*			With an index on the primary key, every page costs the same.
+	*
+	*			The row limit is generated per DatabaseProduct: TOP for Microsoft SQL Server,
+	*			Access and Excel, LIMIT for MySQL and PostgreSQL and FETCH FIRST n ROWS ONLY
+	*			for DB2 and unknown databases. MySQL and PostgreSQL compare the keys as row
+	*			values, (id1, id2) > (?, ?).
+	*
+	*			The selected columns of the Table are returned, its primary key columns must
+	*			be selected. Rows inserted or deleted between two pages are seen or skipped
+	*			like any other row with a larger or smaller key.
+	*/
+	class EXODBCAPI TablePaginator
+	{
+	public:
+		TablePaginator() = delete;
+
+		/*!
+		* \brief	Create a TablePaginator on the open table, returning pageSize rows per page.
+		* \details	If whereStatement is not empty, only rows matching it are returned.
+		* \throw	Exception If no primary key column is selected, any primary key column is not selected,
+		*		or preparing the statements fails.
+		*/
+		TablePaginator(const Table& table, SQLULEN pageSize, const std::string& whereStatement = u8"");
+
+		TablePaginator(const TablePaginator& other) = delete;
+		TablePaginator& operator=(const TablePaginator& other) = delete;
+
+
+		/*!
+		* \brief	Select the next page.
+		* \details	The returned RowBlock is not bound to any statement, Next() on it iterates
+		*			its rows. The page after a page with less than GetPageSize() rows is not
+		*			selected.
+		* \return	The rows of the page, or an empty pointer if no more rows are available.
+		* \throw	Exception If executing or fetching fails.
+		*/
+		RowBlockPtr NextPage();
+
+
+		/*!
+		* \brief	Start again at the first page.
+		*/
+		void Reset() noexcept;
+
+
+		/*!
+		* \brief	Number of pages returned since construction or Reset().
+		*/
+		unsigned long long GetPageCount() const noexcept { return m_pageCount; };
+
+
+		/*!
+		* \brief	Number of rows per page.
+		*/
+		SQLULEN GetPageSize() const noexcept { return m_pageSize; };
+
+
+		/*!
+		* \brief	The SQL selecting the first page.
+		*/
+		const std::string& GetFirstPageSql() const noexcept { return m_firstPageSql; };
+
+
+		/*!
+		* \brief	The SQL selecting the page after a key.
+		*/
+		const std::string& GetNextPageSql() const noexcept { return m_nextPageSql; };
+
+
+		/*!
+		* \brief	Build the condition selecting the rows with a key larger than the key bound.
+		* \details	For every parameter marker the index of the key column it must be bound to
+		*			is appended to paramKeys.
+		*/
+		static std::string BuildKeyCondition(DatabaseProduct dbms, const std::vector<std::string>& keyNames, std::vector<size_t>& paramKeys);
+
+
+		/*!
+		* \brief	Build a SELECT of at most pageSize rows, limiting the rows like dbms expects.
+		* \details	whereStatement may be empty, orderStatement must not.
+		*/
+		static std::string BuildPageSql(DatabaseProduct dbms, const std::string& fields, const std::string& tableName,
+			const std::string& whereStatement, const std::string& orderStatement, SQLULEN pageSize);
+
+	private:
+		struct KeyValue
+		{
+			SQLUSMALLINT m_columnIndex;
+			std::vector<SQLCHAR> m_data;
+			SQLLEN m_cb;
+		};
+
+		const Table& m_table;
+		SQLULEN m_pageSize;
+		std::vector<RowColumnDefinition> m_definitions;
+		std::vector<KeyValue> m_keys;
+		std::vector<ParameterArray> m_keyParams;
+
+		std::string m_firstPageSql;
+		std::string m_nextPageSql;
+		ExecutableStatement m_firstPageStmt;
+		ExecutableStatement m_nextPageStmt;
+
+		unsigned long long m_pageCount;
+		bool m_done;
+	};
+} // namespace exodbc
@@ -122,7 +122,10 @@ namespace exodbc
 	const int DB_MAX_LITERAL_SUFFIX_LEN				= 128;
 	const int DB_MAX_CREATE_PARAMS_LIST_LEN			= 512;	
 	const int DB_MAX_PRIMARY_KEY_NAME_LEN			= 128;
+	const int DB_MAX_FOREIGN_KEY_NAME_LEN			= 128;
 	const int DB_MAX_YES_NO_LEN						= 3;
+	const int DB_MAX_INDEX_NAME_LEN					= 128;
+	const int DB_MAX_FILTER_CONDITION_LEN			= 512;
 
     const SQLLEN SQL_NO_TOTAL_BUFFER_LENGTH = 65536;	///< Fall back: If trying to create a buffer with a length value of SQL_NO_TOTAL, this value is used as the buffer size.    
 
@@ -0,0 +1,6 @@
+﻿// the configured options and settings for EXODBC
+#define EXODBC_VERSION_MAJOR 0
+#define EXODBC_VERSION_MINOR 9
+#define EXODBC_VERSION_PATCH 5
+#define EXODBC_VERSION_REV 0
+#define EXODBC_VERSION_STRING		"0.9.5.0\0"
@@ -0,0 +1,624 @@
+﻿/*!
+* \file MockConfig.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the configuration and the table definitions of the exodbcmock driver.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "MockDriver.h"
+
+// Same component headers
+// Other headers
+// System headers
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbcmock
+{
+	const char* const MockConfig::DEFAULT_TABLES =
+		"integertypes:*idintegertypes INTEGER,tsmallint SMALLINT,tint INTEGER,tbigint BIGINT"
+		"|floattypes:*idfloattypes INTEGER,tdouble DOUBLE,tfloat REAL"
+		"|numerictypes:*idnumerictypes INTEGER,tdecimal_18_0 DECIMAL(18,0),tdecimal_18_10 DECIMAL(18,10),tdecimal_5_3 DECIMAL(5,3)"
+		"|chartypes:*idchartypes INTEGER,tvarchar VARCHAR(128),tchar CHAR(128)"
+		"|datetypes:*iddatetypes INTEGER,tdate DATE,ttime TIME,ttimestamp TIMESTAMP"
+		"|blobtypes:*idblobtypes INTEGER,tblob BINARY(16),tvarblob_20 VARBINARY(20)"
+		"|multikey:*id1 INTEGER,*id2 INTEGER,value VARCHAR(10),*id3 INTEGER"
+		"|unicodetable:*idunicodetable INTEGER,content WVARCHAR(255)";
+
+
+	namespace
+	{
+		struct TypeName
+		{
+			const char* m_name;
+			SQLSMALLINT m_sqlType;
+			SQLULEN m_defaultSize;
+			SQLSMALLINT m_defaultDigits;
+		};
+
+		// The first entry of a type is the name reported by SQLGetTypeInfo
+		const TypeName TYPE_NAMES[] = {
+			{ "SMALLINT", SQL_SMALLINT, 5, 0 },
+			{ "INTEGER", SQL_INTEGER, 10, 0 },
+			{ "INT", SQL_INTEGER, 10, 0 },
+			{ "BIGINT", SQL_BIGINT, 19, 0 },
+			{ "REAL", SQL_REAL, 7, 0 },
+			{ "FLOAT", SQL_FLOAT, 15, 0 },
+			{ "DOUBLE", SQL_DOUBLE, 15, 0 },
+			{ "DECIMAL", SQL_DECIMAL, 18, 0 },
+			{ "NUMERIC", SQL_NUMERIC, 18, 0 },
+			{ "CHAR", SQL_CHAR, 1, 0 },
+			{ "VARCHAR", SQL_VARCHAR, 255, 0 },
+			{ "LONGVARCHAR", SQL_LONGVARCHAR, 65535, 0 },
+			{ "WCHAR", SQL_WCHAR, 1, 0 },
+			{ "WVARCHAR", SQL_WVARCHAR, 255, 0 },
+			{ "WLONGVARCHAR", SQL_WLONGVARCHAR, 65535, 0 },
+			{ "BINARY", SQL_BINARY, 1, 0 },
+			{ "VARBINARY", SQL_VARBINARY, 255, 0 },
+			{ "LONGVARBINARY", SQL_LONGVARBINARY, 65535, 0 },
+			{ "DATE", SQL_TYPE_DATE, 10, 0 },
+			{ "TIME", SQL_TYPE_TIME, 8, 0 },
+			{ "TIMESTAMP", SQL_TYPE_TIMESTAMP, 23, 3 }
+		};
+
+
+		string Trim(const string& s)
+		{
+			size_t first = s.find_first_not_of(" \t\r\n");
+			if (first == string::npos)
+			{
+				return string();
+			}
+			size_t last = s.find_last_not_of(" \t\r\n");
+			return s.substr(first, last - first + 1);
+		}
+
+
+		unsigned long long ParseUnsigned(const string& key, const string& value)
+		{
+			string trimmed = Trim(value);
+			if (trimmed.empty() || !all_of(trimmed.begin(), trimmed.end(), [](char c) { return isdigit((unsigned char)c) != 0; }))
+			{
+				throw invalid_argument("Value '" + value + "' of attribute " + key + " is not an unsigned number");
+			}
+			return stoull(trimmed);
+		}
+
+
+		// Split s at separator, but not inside parentheses
+		vector<string> Split(const string& s, char separator)
+		{
+			vector<string> parts;
+			string current;
+			int depth = 0;
+			for (char c : s)
+			{
+				if (c == '(')
+					++depth;
+				else if (c == ')')
+					--depth;
+				if (c == separator && depth == 0)
+				{
+					parts.push_back(current);
+					current.clear();
+				}
+				else
+				{
+					current += c;
+				}
+			}
+			parts.push_back(current);
+			return parts;
+		}
+
+
+		bool MatchesPatternAt(const string& value, size_t v, const string& pattern, size_t p) noexcept
+		{
+			while (p < pattern.length())
+			{
+				char c = pattern[p];
+				if (c == '%')
+				{
+					for (size_t i = v; i <= value.length(); ++i)
+					{
+						if (MatchesPatternAt(value, i, pattern, p + 1))
+						{
+							return true;
+						}
+					}
+					return false;
+				}
+				if (v >= value.length())
+				{
+					return false;
+				}
+				if (c == '\\' && p + 1 < pattern.length())
+				{
+					c = pattern[++p];
+				}
+				else if (c == '_')
+				{
+					++v;
+					++p;
+					continue;
+				}
+				if (toupper((unsigned char)c) != toupper((unsigned char)value[v]))
+				{
+					return false;
+				}
+				++v;
+				++p;
+			}
+			return v == value.length();
+		}
+	}
+
+
+	bool EqualsNoCase(const std::string& a, const std::string& b) noexcept
+	{
+		return a.length() == b.length() && equal(a.begin(), a.end(), b.begin(),
+			[](char x, char y) { return toupper((unsigned char)x) == toupper((unsigned char)y); });
+	}
+
+
+	std::string ToUpper(std::string s)
+	{
+		transform(s.begin(), s.end(), s.begin(), [](char c) { return (char) toupper((unsigned char)c); });
+		return s;
+	}
+
+
+	bool MatchesPattern(const std::string& value, const std::string& pattern) noexcept
+	{
+		return MatchesPatternAt(value, 0, pattern, 0);
+	}
+
+
+	std::map<std::string, std::string> ParseConnectionString(const std::string& connectionString)
+	{
+		map<string, string> attributes;
+		size_t pos = 0;
+		while (pos < connectionString.length())
+		{
+			size_t equals = connectionString.find('=', pos);
+			if (equals == string::npos)
+			{
+				break;
+			}
+			string key = ToUpper(Trim(connectionString.substr(pos, equals - pos)));
+			size_t valueStart = equals + 1;
+			while (valueStart < connectionString.length() && connectionString[valueStart] == ' ')
+			{
+				++valueStart;
+			}
+			string value;
+			if (valueStart < connectionString.length() && connectionString[valueStart] == '{')
+			{
+				size_t close = connectionString.find('}', valueStart);
+				if (close == string::npos)
+				{
+					throw invalid_argument("Missing '}' in value of attribute " + key);
+				}
+				value = connectionString.substr(valueStart + 1, close - valueStart - 1);
+				pos = connectionString.find(';', close);
+			}
+			else
+			{
+				pos = connectionString.find(';', valueStart);
+				value = Trim(connectionString.substr(valueStart, pos == string::npos ? string::npos : pos - valueStart));
+			}
+			if (!key.empty())
+			{
+				attributes[key] = value;
+			}
+			if (pos == string::npos)
+			{
+				break;
+			}
+			++pos;
+		}
+		return attributes;
+	}
+
+
+	void ParseColumnType(const std::string& type, ColumnDef& column)
+	{
+		string name = ToUpper(Trim(type));
+		vector<unsigned long long> args;
+		size_t open = name.find('(');
+		if (open != string::npos)
+		{
+			size_t close = name.find(')', open);
+			if (close == string::npos)
+			{
+				throw invalid_argument("Missing ')' in type '" + type + "'");
+			}
+			for (const string& arg : Split(name.substr(open + 1, close - open - 1), ','))
+			{
+				args.push_back(ParseUnsigned(type, arg));
+			}
+			name = Trim(name.substr(0, open));
+		}
+		for (const TypeName& typeName : TYPE_NAMES)
+		{
+			if (name == typeName.m_name)
+			{
+				column.m_sqlType = typeName.m_sqlType;
+				column.m_columnSize = args.size() > 0 ? (SQLULEN)args[0] : typeName.m_defaultSize;
+				column.m_decimalDigits = args.size() > 1 ? (SQLSMALLINT)args[1] : typeName.m_defaultDigits;
+				if (column.m_columnSize == 0 || (SQLULEN)column.m_decimalDigits > column.m_columnSize)
+				{
+					throw invalid_argument("Invalid size of type '" + type + "'");
+				}
+				return;
+			}
+		}
+		throw invalid_argument("Unknown type '" + type + "'");
+	}
+
+
+	std::vector<TableDef> ParseTables(const std::string& definition, SQLULEN defaultRows)
+	{
+		vector<TableDef> tables;
+		for (const string& tableDefinition : Split(definition, '|'))
+		{
+			if (Trim(tableDefinition).empty())
+			{
+				continue;
+			}
+			size_t colon = tableDefinition.find(':');
+			if (colon == string::npos)
+			{
+				throw invalid_argument("Missing ':' after the name of table '" + tableDefinition + "'");
+			}
+			TableDef table;
+			table.m_name = Trim(tableDefinition.substr(0, colon));
+			table.m_rows = defaultRows;
+			size_t bracket = table.m_name.find('[');
+			if (bracket != string::npos)
+			{
+				size_t close = table.m_name.find(']', bracket);
+				if (close == string::npos)
+				{
+					throw invalid_argument("Missing ']' in table '" + table.m_name + "'");
+				}
+				table.m_rows = (SQLULEN) ParseUnsigned(table.m_name, table.m_name.substr(bracket + 1, close - bracket - 1));
+				table.m_name = Trim(table.m_name.substr(0, bracket));
+			}
+			if (table.m_name.empty())
+			{
+				throw invalid_argument("Missing table name in '" + tableDefinition + "'");
+			}
+
+			bool hasPrimaryKey = false;
+			for (const string& columnDefinition : Split(tableDefinition.substr(colon + 1), ','))
+			{
+				string trimmed = Trim(columnDefinition);
+				ColumnDef column;
+				if (!trimmed.empty() && trimmed[0] == '*')
+				{
+					column.m_primaryKey = true;
+					column.m_nullable = false;
+					hasPrimaryKey = true;
+					trimmed = Trim(trimmed.substr(1));
+				}
+				size_t space = trimmed.find_first_of(" \t");
+				if (space == string::npos)
+				{
+					throw invalid_argument("Missing type of column '" + trimmed + "' in table '" + table.m_name + "'");
+				}
+				column.m_name = trimmed.substr(0, space);
+				ParseColumnType(trimmed.substr(space + 1), column);
+				if (table.FindColumn(column.m_name) >= 0)
+				{
+					throw invalid_argument("Duplicate column '" + column.m_name + "' in table '" + table.m_name + "'");
+				}
+				table.m_columns.push_back(column);
+			}
+			if (!hasPrimaryKey)
+			{
+				table.m_columns.front().m_primaryKey = true;
+				table.m_columns.front().m_nullable = false;
+			}
+			tables.push_back(table);
+		}
+		return tables;
+	}
+
+
+	// ColumnDef
+	// =========
+	ColumnDef::ColumnDef(const std::string& name, SQLSMALLINT sqlType, SQLULEN columnSize, SQLSMALLINT decimalDigits, bool nullable)
+		: m_name(name)
+		, m_sqlType(sqlType)
+		, m_columnSize(columnSize)
+		, m_decimalDigits(decimalDigits)
+		, m_nullable(nullable)
+		, m_primaryKey(false)
+	{ }
+
+
+	std::string ColumnDef::GetTypeName() const
+	{
+		for (const TypeName& typeName : TYPE_NAMES)
+		{
+			if (typeName.m_sqlType == m_sqlType)
+			{
+				return typeName.m_name;
+			}
+		}
+		return "UNKNOWN";
+	}
+
+
+	SQLLEN ColumnDef::GetOctetLength() const
+	{
+		switch (m_sqlType)
+		{
+		case SQL_SMALLINT:
+			return sizeof(SQLSMALLINT);
+		case SQL_INTEGER:
+			return sizeof(SQLINTEGER);
+		case SQL_BIGINT:
+			return sizeof(SQLBIGINT);
+		case SQL_REAL:
+			return sizeof(SQLREAL);
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return sizeof(SQLDOUBLE);
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+			return (SQLLEN)m_columnSize + 2;
+		case SQL_WCHAR:
+		case SQL_WVARCHAR:
+		case SQL_WLONGVARCHAR:
+			return (SQLLEN)m_columnSize * 2;
+		case SQL_TYPE_DATE:
+			return sizeof(SQL_DATE_STRUCT);
+		case SQL_TYPE_TIME:
+			return sizeof(SQL_TIME_STRUCT);
+		case SQL_TYPE_TIMESTAMP:
+			return sizeof(SQL_TIMESTAMP_STRUCT);
+		default:
+			return (SQLLEN)m_columnSize;
+		}
+	}
+
+
+	SQLLEN ColumnDef::GetDisplaySize() const
+	{
+		switch (m_sqlType)
+		{
+		case SQL_SMALLINT:
+			return 6;
+		case SQL_INTEGER:
+			return 11;
+		case SQL_BIGINT:
+			return 20;
+		case SQL_REAL:
+			return 14;
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return 24;
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+			return (SQLLEN)m_columnSize + 2;
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+		case SQL_LONGVARBINARY:
+			return (SQLLEN)m_columnSize * 2;
+		case SQL_TYPE_TIMESTAMP:
+			return 19 + (m_decimalDigits > 0 ? m_decimalDigits + 1 : 0);
+		default:
+			return (SQLLEN)m_columnSize;
+		}
+	}
+
+
+	// TableDef
+	// ========
+	int TableDef::FindColumn(const std::string& name) const
+	{
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			if (EqualsNoCase(m_columns[i].m_name, name))
+			{
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+
+
+	// MockConfig
+	// ==========
+	MockConfig::MockConfig()
+		: m_schema("exodbc")
+		, m_rows(1000)
+		, m_nullEvery(0)
+		, m_connectLatency(0)
+		, m_prepareLatency(0)
+		, m_executeLatency(0)
+		, m_fetchLatency(0)
+		, m_rowLatency(0)
+		, m_catalogLatency(0)
+	{ }
+
+
+	void MockConfig::Set(const std::string& key, const std::string& value)
+	{
+		string upperKey = ToUpper(key);
+		if (upperKey == "SCHEMA")
+			m_schema = Trim(value);
+		else if (upperKey == "ROWS")
+			m_rows = (SQLULEN) ParseUnsigned(key, value);
+		else if (upperKey == "NULLEVERY")
+			m_nullEvery = (unsigned) ParseUnsigned(key, value);
+		else if (upperKey == "TABLES")
+			m_tablesDefinition = value;
+		else if (upperKey == "CONNECTLATENCY")
+			m_connectLatency = chrono::microseconds(ParseUnsigned(key, value));
+		else if (upperKey == "PREPARELATENCY")
+			m_prepareLatency = chrono::microseconds(ParseUnsigned(key, value));
+		else if (upperKey == "EXECUTELATENCY")
+			m_executeLatency = chrono::microseconds(ParseUnsigned(key, value));
+		else if (upperKey == "FETCHLATENCY")
+			m_fetchLatency = chrono::microseconds(ParseUnsigned(key, value));
+		else if (upperKey == "ROWLATENCY")
+			m_rowLatency = chrono::microseconds(ParseUnsigned(key, value));
+		else if (upperKey == "CATALOGLATENCY")
+			m_catalogLatency = chrono::microseconds(ParseUnsigned(key, value));
+	}
+
+
+	void MockConfig::Finish()
+	{
+		if (!Trim(m_tablesDefinition).empty())
+		{
+			m_tables = ParseTables(m_tablesDefinition, m_rows);
+			return;
+		}
+
+		// The default tables, and an empty copy with suffix _tmp of every table to write to
+		m_tables = ParseTables(DEFAULT_TABLES, m_rows);
+		size_t count = m_tables.size();
+		for (size_t i = 0; i < count; ++i)
+		{
+			TableDef tmp = m_tables[i];
+			tmp.m_name += "_tmp";
+			tmp.m_rows = 0;
+			m_tables.push_back(tmp);
+		}
+	}
+
+
+	const TableDef* MockConfig::FindTable(const std::string& name) const
+	{
+		for (const TableDef& table : m_tables)
+		{
+			if (EqualsNoCase(table.m_name, name))
+			{
+				return &table;
+			}
+		}
+		return NULL;
+	}
+
+
+	SQLSMALLINT GetDateTimeSubCode(SQLSMALLINT sqlType) noexcept
+	{
+		switch (sqlType)
+		{
+		case SQL_TYPE_DATE:
+			return SQL_CODE_DATE;
+		case SQL_TYPE_TIME:
+			return SQL_CODE_TIME;
+		case SQL_TYPE_TIMESTAMP:
+			return SQL_CODE_TIMESTAMP;
+		default:
+			return 0;
+		}
+	}
+
+
+	ResultSetPtr CreateTypeInfoResult(SQLSMALLINT dataType)
+	{
+		StaticResultSet* pResult = new StaticResultSet();
+		ResultSetPtr pResultPtr(pResult);
+		const SQLSMALLINT SMALL = SQL_SMALLINT;
+		const SQLSMALLINT TEXT = SQL_VARCHAR;
+		const pair<const char*, SQLSMALLINT> COLUMNS[] = {
+			{ "TYPE_NAME", TEXT }, { "DATA_TYPE", SMALL }, { "COLUMN_SIZE", SQL_INTEGER }, { "LITERAL_PREFIX", TEXT },
+			{ "LITERAL_SUFFIX", TEXT }, { "CREATE_PARAMS", TEXT }, { "NULLABLE", SMALL }, { "CASE_SENSITIVE", SMALL },
+			{ "SEARCHABLE", SMALL }, { "UNSIGNED_ATTRIBUTE", SMALL }, { "FIXED_PREC_SCALE", SMALL }, { "AUTO_UNIQUE_VALUE", SMALL },
+			{ "LOCAL_TYPE_NAME", TEXT }, { "MINIMUM_SCALE", SMALL }, { "MAXIMUM_SCALE", SMALL }, { "SQL_DATA_TYPE", SMALL },
+			{ "SQL_DATETIME_SUB", SMALL }, { "NUM_PREC_RADIX", SQL_INTEGER }, { "INTERVAL_PRECISION", SMALL }
+		};
+		for (const auto& column : COLUMNS)
+		{
+			pResult->AddColumn(ColumnDef(column.first, column.second, column.second == TEXT ? 128 : (column.second == SMALL ? 5 : 10), 0, true));
+		}
+
+		vector<const TypeName*> types;
+		for (const TypeName& typeName : TYPE_NAMES)
+		{
+			bool isAlias = find_if(types.begin(), types.end(), [&](const TypeName* p) { return p->m_sqlType == typeName.m_sqlType; }) != types.end();
+			if (!isAlias && (dataType == SQL_ALL_TYPES || dataType == typeName.m_sqlType))
+			{
+				types.push_back(&typeName);
+			}
+		}
+		stable_sort(types.begin(), types.end(), [](const TypeName* a, const TypeName* b) { return a->m_sqlType < b->m_sqlType; });
+
+		for (const TypeName* pType : types)
+		{
+			SQLSMALLINT sqlType = pType->m_sqlType;
+			bool isText = sqlType == SQL_CHAR || sqlType == SQL_VARCHAR || sqlType == SQL_LONGVARCHAR
+				|| sqlType == SQL_WCHAR || sqlType == SQL_WVARCHAR || sqlType == SQL_WLONGVARCHAR;
+			bool isBinary = sqlType == SQL_BINARY || sqlType == SQL_VARBINARY || sqlType == SQL_LONGVARBINARY;
+			bool isLong = sqlType == SQL_LONGVARCHAR || sqlType == SQL_WLONGVARCHAR || sqlType == SQL_LONGVARBINARY;
+			bool isExact = sqlType == SQL_DECIMAL || sqlType == SQL_NUMERIC;
+			bool isInteger = sqlType == SQL_SMALLINT || sqlType == SQL_INTEGER || sqlType == SQL_BIGINT;
+			bool isApproximate = sqlType == SQL_REAL || sqlType == SQL_FLOAT || sqlType == SQL_DOUBLE;
+			bool isDateTime = sqlType == SQL_TYPE_DATE || sqlType == SQL_TYPE_TIME || sqlType == SQL_TYPE_TIMESTAMP;
+
+			SQLULEN columnSize = pType->m_defaultSize;
+			if (isText || isBinary)
+			{
+				columnSize = isLong ? 2147483647 : 65535;
+			}
+			Value quote = (isText || isDateTime) ? Value::CreateText("'") : Value();
+			Value numericScale = isExact ? Value::CreateInteger(0) : (isInteger ? Value::CreateInteger(0) : Value());
+			vector<Value> row = {
+				Value::CreateText(pType->m_name),
+				Value::CreateInteger(sqlType),
+				Value::CreateInteger((long long)columnSize),
+				quote,
+				quote,
+				isExact ? Value::CreateText("precision,scale") : ((isText || isBinary) && !isLong ? Value::CreateText("length") : Value()),
+				Value::CreateInteger(SQL_NULLABLE),
+				Value::CreateInteger(isText ? SQL_TRUE : SQL_FALSE),
+				Value::CreateInteger(isLong ? SQL_PRED_CHAR : SQL_SEARCHABLE),
+				(isInteger || isExact || isApproximate) ? Value::CreateInteger(SQL_FALSE) : Value(),
+				Value::CreateInteger(SQL_FALSE),
+				(isInteger || isExact || isApproximate) ? Value::CreateInteger(SQL_FALSE) : Value(),
+				Value::CreateText(pType->m_name),
+				numericScale,
+				isExact ? Value::CreateInteger((long long)pType->m_defaultSize) : numericScale,
+				Value::CreateInteger(isDateTime ? SQL_DATETIME : sqlType),
+				isDateTime ? Value::CreateInteger(GetDateTimeSubCode(sqlType)) : Value(),
+				(isInteger || isExact || isApproximate) ? Value::CreateInteger(10) : Value(),
+				Value()
+			};
+			pResult->AddRow(row);
+		}
+		return pResultPtr;
+	}
+
+
+	void SimulateLatency(std::chrono::microseconds latency)
+	{
+		if (latency.count() <= 0)
+		{
+			return;
+		}
+		if (latency >= chrono::milliseconds(1))
+		{
+			this_thread::sleep_for(latency);
+			return;
+		}
+		// Sleeping is far too coarse for short latencies
+		chrono::steady_clock::time_point end = chrono::steady_clock::now() + latency;
+		while (chrono::steady_clock::now() < end)
+		{ }
+	}
+}
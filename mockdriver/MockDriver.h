@@ -0,0 +1,668 @@
+﻿/*!
+* \file MockDriver.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Header file for the internals of the exodbcmock ODBC driver.
+* \copyright GNU Lesser General Public License Version 3
+*
+* exodbcmock is an ODBC driver serving synthetic result sets without any
+* database behind it. See docs/mockdriver.md for how to configure it.
+*/
+
+#pragma once
+
+// Same component headers
+// Other headers
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+// System headers
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <stdexcept>
+
+// Forward declarations
+// --------------------
+
+namespace exodbcmock
+{
+	// Consts
+	// ------
+
+	/*!
+	* \brief	Prefix of all diagnostic messages of the driver.
+	*/
+	extern const char* const MESSAGE_PREFIX;
+
+	// Structs
+	// -------
+
+	/*!
+	* \struct DiagRecord
+	* \brief A diagnostic record as returned by SQLGetDiagRec.
+	*/
+	struct DiagRecord
+	{
+		std::string m_sqlState;
+		SQLINTEGER m_nativeError;
+		std::string m_message;
+	};
+
+
+	/*!
+	* \struct Value
+	* \brief One value of a result set.
+	* \details	Numeric values are stored unscaled in m_integer, with m_scale decimal
+	*			digits. Date, Time and Timestamp values use the matching parts of m_timestamp.
+	*			Text is UTF-8, Binary holds the raw bytes in m_bytes.
+	*/
+	struct Value
+	{
+		enum class Kind
+		{
+			Null,
+			Integer,
+			Real,
+			Numeric,
+			Text,
+			Binary,
+			Date,
+			Time,
+			Timestamp
+		};
+
+		Value()
+			: m_kind(Kind::Null)
+			, m_integer(0)
+			, m_real(0.0)
+			, m_scale(0)
+			, m_timestamp()
+		{ };
+
+		static Value CreateInteger(long long value);
+		static Value CreateReal(double value);
+		static Value CreateNumeric(long long unscaled, SQLSMALLINT scale);
+		static Value CreateText(const std::string& value);
+		static Value CreateBinary(const std::string& bytes);
+		static Value CreateTimestamp(Kind kind, const SQL_TIMESTAMP_STRUCT& timestamp);
+
+		bool IsNull() const noexcept { return m_kind == Kind::Null; };
+
+		Kind m_kind;
+		long long m_integer;
+		double m_real;
+		SQLSMALLINT m_scale;
+		std::string m_bytes;
+		SQL_TIMESTAMP_STRUCT m_timestamp;
+	};
+
+
+	/*!
+	* \struct ColumnDef
+	* \brief A column of a table or of a result set.
+	*/
+	struct ColumnDef
+	{
+		ColumnDef()
+			: m_sqlType(SQL_VARCHAR)
+			, m_columnSize(0)
+			, m_decimalDigits(0)
+			, m_nullable(true)
+			, m_primaryKey(false)
+		{ };
+
+		ColumnDef(const std::string& name, SQLSMALLINT sqlType, SQLULEN columnSize, SQLSMALLINT decimalDigits, bool nullable);
+
+		/*!
+		* \brief	Name of the SQL type, like reported by SQLGetTypeInfo.
+		*/
+		std::string GetTypeName() const;
+
+		/*!
+		* \brief	Maximum length in bytes of a value transferred as its default C type.
+		*/
+		SQLLEN GetOctetLength() const;
+
+		/*!
+		* \brief	Maximum number of characters required to display a value.
+		*/
+		SQLLEN GetDisplaySize() const;
+
+		std::string m_name;
+		SQLSMALLINT m_sqlType;
+		SQLULEN m_columnSize;
+		SQLSMALLINT m_decimalDigits;
+		bool m_nullable;
+		bool m_primaryKey;
+	};
+
+
+	/*!
+	* \struct TableDef
+	* \brief A synthetic table: Its columns and the number of rows it returns.
+	*/
+	struct TableDef
+	{
+		TableDef()
+			: m_rows(0)
+		{ };
+
+		/*!
+		* \brief	Index of the column with the passed name (case-insensitive), or -1.
+		*/
+		int FindColumn(const std::string& name) const;
+
+		std::string m_name;
+		SQLULEN m_rows;
+		std::vector<ColumnDef> m_columns;
+	};
+
+
+	/*!
+	* \struct MockConfig
+	* \brief The settings of a connection, read from the DSN and the connection string.
+	*/
+	struct MockConfig
+	{
+		/*!
+		* \brief	Tables served if the attribute Tables is not set: The tables used by exodbctest.
+		*/
+		static const char* const DEFAULT_TABLES;
+
+		MockConfig();
+
+		/*!
+		* \brief	Set the attribute key (case-insensitive) to value.
+		* \details	Unknown attributes are ignored.
+		* \throw	std::invalid_argument If value is invalid.
+		*/
+		void Set(const std::string& key, const std::string& value);
+
+		/*!
+		* \brief	Parse the table definitions once all attributes are set.
+		* \throw	std::invalid_argument If the table definitions are invalid.
+		*/
+		void Finish();
+
+		/*!
+		* \brief	Find a table by name (case-insensitive). Returns NULL if not found.
+		*/
+		const TableDef* FindTable(const std::string& name) const;
+
+		std::string m_schema;
+		SQLULEN m_rows;
+		unsigned m_nullEvery;
+		std::string m_tablesDefinition;
+		std::vector<TableDef> m_tables;
+		std::chrono::microseconds m_connectLatency;
+		std::chrono::microseconds m_prepareLatency;
+		std::chrono::microseconds m_executeLatency;
+		std::chrono::microseconds m_fetchLatency;
+		std::chrono::microseconds m_rowLatency;
+		std::chrono::microseconds m_catalogLatency;
+	};
+
+
+	// Classes
+	// -------
+
+	/*!
+	* \class ResultSet
+	* \brief The columns and rows produced by executing a statement or a catalog function.
+	*/
+	class ResultSet
+	{
+	public:
+		virtual ~ResultSet() { };
+
+		const std::vector<ColumnDef>& GetColumns() const noexcept { return m_columns; };
+		virtual SQLULEN GetRowCount() const noexcept = 0;
+		virtual Value GetValue(SQLULEN row, size_t column) const = 0;
+
+	protected:
+		std::vector<ColumnDef> m_columns;
+	};
+	typedef std::unique_ptr<ResultSet> ResultSetPtr;
+
+
+	/*!
+	* \class TableResultSet
+	* \brief Generates the values of some columns of a TableDef, see GenerateValue().
+	*/
+	class TableResultSet
+		: public ResultSet
+	{
+	public:
+		TableResultSet(const TableDef& table, const std::vector<size_t>& projection, SQLULEN rowCount, unsigned nullEvery);
+
+		SQLULEN GetRowCount() const noexcept override { return m_rowCount; };
+		Value GetValue(SQLULEN row, size_t column) const override;
+
+	private:
+		std::vector<size_t> m_projection;
+		SQLULEN m_rowCount;
+		unsigned m_nullEvery;
+	};
+
+
+	/*!
+	* \class StaticResultSet
+	* \brief A result set holding all its values, used for catalog functions and constants.
+	*/
+	class StaticResultSet
+		: public ResultSet
+	{
+	public:
+		void AddColumn(const ColumnDef& column) { m_columns.push_back(column); };
+		void AddRow(const std::vector<Value>& row) { m_rows.push_back(row); };
+
+		SQLULEN GetRowCount() const noexcept override { return m_rows.size(); };
+		Value GetValue(SQLULEN row, size_t column) const override { return m_rows.at(row).at(column); };
+
+	private:
+		std::vector<std::vector<Value>> m_rows;
+	};
+
+
+	/*!
+	* \class Handle
+	* \brief Base of all handles: Holds the diagnostic records and a mutex.
+	*/
+	class Handle
+	{
+	public:
+		enum class Type
+		{
+			Env,
+			Dbc,
+			Stmt,
+			Desc
+		};
+
+		Handle(Type type);
+		virtual ~Handle();
+
+		Handle(const Handle& other) = delete;
+		Handle& operator=(const Handle& other) = delete;
+
+		/*!
+		* \brief	Cast handle to T if it is a valid handle of type, else return NULL.
+		*/
+		template<typename T>
+		static T* Cast(SQLHANDLE handle, Type type) noexcept
+		{
+			Handle* pHandle = static_cast<Handle*>(handle);
+			if (pHandle == NULL || pHandle->m_magic != MAGIC || pHandle->m_type != type)
+			{
+				return NULL;
+			}
+			return static_cast<T*>(pHandle);
+		};
+
+		void ClearDiag() noexcept { m_diag.clear(); };
+
+		/*!
+		* \brief	Add a diagnostic record and return ret.
+		*/
+		SQLRETURN AddDiag(const std::string& sqlState, const std::string& message, SQLRETURN ret = SQL_ERROR);
+
+		const std::vector<DiagRecord>& GetDiag() const noexcept { return m_diag; };
+
+		/*!
+		* \brief	The mutex guarding the handle. Descriptors share the mutex of their statement.
+		*/
+		virtual std::recursive_mutex& GetMutex() { return m_mutex; };
+
+	private:
+		static const unsigned MAGIC = 0x6d6f636b;
+
+		unsigned m_magic;
+		Type m_type;
+		std::vector<DiagRecord> m_diag;
+		std::recursive_mutex m_mutex;
+	};
+
+
+	class Connection;
+	class Statement;
+
+
+	/*!
+	* \class Environment
+	* \brief An environment handle.
+	*/
+	class Environment
+		: public Handle
+	{
+	public:
+		Environment();
+
+		SQLINTEGER m_odbcVersion;
+		std::set<Connection*> m_connections;
+	};
+
+
+	/*!
+	* \class Connection
+	* \brief A connection handle and the MockConfig read while connecting.
+	*/
+	class Connection
+		: public Handle
+	{
+	public:
+		Connection(Environment& env);
+
+		Environment& m_env;
+		bool m_connected;
+		MockConfig m_config;
+		std::string m_dsn;
+		std::string m_user;
+		SQLUINTEGER m_autocommit;
+		SQLUINTEGER m_txnIsolation;
+		std::map<SQLINTEGER, SQLULEN> m_attributes;
+		std::set<Statement*> m_statements;
+	};
+
+
+	/*!
+	* \struct DescRecord
+	* \brief A record of a descriptor, describing one bound column or parameter.
+	*/
+	struct DescRecord
+	{
+		DescRecord()
+			: m_conciseType(SQL_C_DEFAULT)
+			, m_pData(NULL)
+			, m_octetLength(0)
+			, m_pOctetLength(NULL)
+			, m_pIndicator(NULL)
+			, m_precision(0)
+			, m_scale(0)
+			, m_parameterType(SQL_PARAM_INPUT)
+			, m_sqlType(SQL_VARCHAR)
+			, m_columnSize(0)
+			, m_decimalDigits(0)
+		{ };
+
+		bool IsBound() const noexcept { return m_pData != NULL || m_pOctetLength != NULL || m_pIndicator != NULL; };
+
+		SQLSMALLINT m_conciseType;
+		SQLPOINTER m_pData;
+		SQLLEN m_octetLength;
+		SQLLEN* m_pOctetLength;
+		SQLLEN* m_pIndicator;
+		SQLSMALLINT m_precision;
+		SQLSMALLINT m_scale;
+
+		// Only used by parameters
+		SQLSMALLINT m_parameterType;
+		SQLSMALLINT m_sqlType;
+		SQLULEN m_columnSize;
+		SQLSMALLINT m_decimalDigits;
+	};
+
+
+	/*!
+	* \class Descriptor
+	* \brief An implicitly allocated descriptor of a statement.
+	* \details	The application descriptors hold the bindings of columns and parameters,
+	*			SQLBindCol and SQLBindParameter only set their records.
+	*/
+	class Descriptor
+		: public Handle
+	{
+	public:
+		Descriptor(Statement& stmt);
+
+		std::recursive_mutex& GetMutex() override;
+
+		/*!
+		* \brief	Address of element index of an array bound at pBase with elementSize bytes per
+		*			element when bound column-wise. Honors bind type and bind offset.
+		*/
+		char* GetElement(void* pBase, SQLULEN index, SQLLEN elementSize) const noexcept;
+
+		/*!
+		* \brief	Highest record number that is bound.
+		*/
+		SQLSMALLINT GetCount() const noexcept;
+
+		Statement& m_stmt;
+		std::map<SQLUSMALLINT, DescRecord> m_records;
+		SQLULEN m_arraySize;
+		SQLULEN m_bindType;
+		SQLLEN* m_pBindOffset;
+		SQLUSMALLINT* m_pArrayStatus;
+		SQLULEN* m_pRowsProcessed;
+	};
+
+
+	/*!
+	* \struct ParsedSql
+	* \brief What the driver understood of an SQL statement.
+	*/
+	struct ParsedSql
+	{
+		enum class Kind
+		{
+			Select,
+			Insert,
+			Update,
+			Delete,
+			Other
+		};
+
+		/*!
+		* \struct SelectItem
+		* \brief One item of the select list.
+		*/
+		struct SelectItem
+		{
+			enum class Kind
+			{
+				All,
+				Count,
+				Column,
+				Constant
+			};
+
+			Kind m_kind;
+			std::string m_name;
+			std::string m_alias;
+			Value m_constant;
+		};
+
+		ParsedSql()
+			: m_kind(Kind::Other)
+			, m_hasWhere(false)
+		{ };
+
+		Kind m_kind;
+		std::string m_tableName;
+		std::vector<SelectItem> m_selectItems;
+		bool m_hasWhere;
+
+		/*!
+		* \brief	Per parameter marker the name of the column it is compared with or assigned to, or empty.
+		*			Markers in the VALUES list of an INSERT without a column list are named '#n', n being the
+		*			index of the column in the table.
+		*/
+		std::vector<std::string> m_parameterColumns;
+
+		/*!
+		* \brief	Values of a comment like '/ *mock rows=10 executeLatency=100* /'.
+		*/
+		std::map<std::string, std::string> m_hints;
+	};
+
+
+	/*!
+	* \class Statement
+	* \brief A statement handle: Prepares, executes and fetches.
+	*/
+	class Statement
+		: public Handle
+	{
+	public:
+		Statement(Connection& dbc);
+
+		/*!
+		* \brief	Close the cursor, fails with 24000 if failIfNotOpen is set and no cursor is open.
+		*/
+		SQLRETURN CloseCursor(bool failIfNotOpen);
+
+		SQLRETURN Prepare(const std::string& sql);
+		SQLRETURN Execute();
+
+		/*!
+		* \brief	Open a cursor on the result of a catalog function.
+		*/
+		SQLRETURN SetCatalogResult(ResultSetPtr pResult);
+
+		SQLRETURN Fetch(SQLSMALLINT orientation, SQLLEN offset);
+		SQLRETURN GetData(SQLUSMALLINT columnNr, SQLSMALLINT cType, SQLPOINTER pTarget, SQLLEN bufferLength, SQLLEN* pStrLenOrInd);
+
+		SQLRETURN SetAttribute(SQLINTEGER attribute, SQLPOINTER value);
+		SQLRETURN GetAttribute(SQLINTEGER attribute, SQLPOINTER value);
+
+		/*!
+		* \brief	Describe parameter paramNr using the column it is compared with, if known.
+		*/
+		ColumnDef DescribeParameter(SQLUSMALLINT paramNr) const;
+
+		bool HasResult() const noexcept { return m_pResult != nullptr; };
+
+		Connection& m_dbc;
+		Descriptor m_ard;
+		Descriptor m_apd;
+		Descriptor m_ird;
+		Descriptor m_ipd;
+
+		std::string m_sql;
+		ParsedSql m_parsed;
+		bool m_prepared;
+		std::vector<ColumnDef> m_resultColumns;
+		ResultSetPtr m_pResult;
+		SQLLEN m_rowCount;
+
+		SQLULEN m_cursorType;
+		SQLULEN m_concurrency;
+		SQLULEN m_maxRows;
+		std::map<SQLINTEGER, SQLULEN> m_attributes;
+
+	private:
+		SQLRETURN ReadParameters();
+		SQLRETURN FetchRowset(SQLLEN start);
+
+		const TableDef* m_pTable;
+		std::vector<size_t> m_projection;
+		SQLULEN m_processedParamsets;
+		size_t m_checksum;
+
+		SQLLEN m_cursorRow;
+		SQLLEN m_lastRowsetSize;
+		SQLUSMALLINT m_getDataColumn;
+		SQLLEN m_getDataOffset;
+	};
+
+
+	// Functions
+	// ---------
+
+	/*!
+	* \brief	Compare a and b case-insensitive.
+	*/
+	bool EqualsNoCase(const std::string& a, const std::string& b) noexcept;
+
+	/*!
+	* \brief	Return s in upper case letters (ASCII only).
+	*/
+	std::string ToUpper(std::string s);
+
+	/*!
+	* \brief	Match value against an ODBC search pattern ('%', '_', escaped by '\'), case-insensitive.
+	*/
+	bool MatchesPattern(const std::string& value, const std::string& pattern) noexcept;
+
+	/*!
+	* \brief	Split a connection string into its attributes, the keys are upper case.
+	* \throw	std::invalid_argument If braces are not closed.
+	*/
+	std::map<std::string, std::string> ParseConnectionString(const std::string& connectionString);
+
+	/*!
+	* \brief	Parse table definitions like 'orders[500]:*id INTEGER,amount DECIMAL(18,2)|items:...'.
+	* \details	Columns marked with '*' form the primary key, if no column is marked the first is used.
+	*			Tables without a row count return defaultRows rows.
+	* \throw	std::invalid_argument If the definition is invalid.
+	*/
+	std::vector<TableDef> ParseTables(const std::string& definition, SQLULEN defaultRows);
+
+	/*!
+	* \brief	Parse a column type like 'VARCHAR(64)' or 'DECIMAL(18,2)' into column.
+	* \throw	std::invalid_argument If the type is unknown.
+	*/
+	void ParseColumnType(const std::string& type, ColumnDef& column);
+
+	/*!
+	* \brief	Parse an SQL statement.
+	* \throw	std::invalid_argument If the statement cannot be understood.
+	*/
+	ParsedSql ParseSql(const std::string& sql);
+
+	/*!
+	* \brief	Generate the value of column columnIndex of row (0-based).
+	* \details	Primary key columns count up from 1. If nullEvery is not 0, every nullEvery-th value
+	*			of a nullable column is NULL. All other values are derived from row and columnIndex.
+	*/
+	Value GenerateValue(const ColumnDef& column, size_t columnIndex, SQLULEN row, unsigned nullEvery);
+
+	/*!
+	* \brief	The C type used for SQL_C_DEFAULT with a column of type sqlType.
+	*/
+	SQLSMALLINT GetDefaultCType(SQLSMALLINT sqlType) noexcept;
+
+	/*!
+	* \brief	Size of a value of the fixed length cType, or 0 for character and binary types.
+	*/
+	SQLLEN GetCTypeSize(SQLSMALLINT cType) noexcept;
+
+	/*!
+	* \brief	Convert value to cType and write it to an application buffer.
+	* \details	Character and binary data is written starting at byte offset, which is advanced
+	*			by the number of bytes written. Diagnostic records are added to diag.
+	* \param	sqlType		Type of the column the value comes from.
+	* \param	pOctetLength	Receives the length of the value, may be NULL.
+	* \param	pIndicator	Receives SQL_NULL_DATA for NULL values, may be NULL if the value is not NULL.
+	*/
+	SQLRETURN WriteValue(Handle& diag, const Value& value, SQLSMALLINT sqlType, SQLSMALLINT cType, SQLSMALLINT precision, SQLSMALLINT scale,
+		SQLPOINTER pTarget, SQLLEN bufferLength, SQLLEN* pOctetLength, SQLLEN* pIndicator, SQLLEN& offset);
+
+	/*!
+	* \brief	Read a parameter value from an application buffer, to simulate transferring it.
+	*/
+	Value ReadValue(SQLSMALLINT cType, const void* pValue, SQLLEN length);
+
+	/*!
+	* \brief	The SQL_DESC_DATETIME_INTERVAL_CODE of a date, time or timestamp type, else 0.
+	*/
+	SQLSMALLINT GetDateTimeSubCode(SQLSMALLINT sqlType) noexcept;
+
+	/*!
+	* \brief	Result set of SQLGetTypeInfo for dataType (SQL_ALL_TYPES for all types).
+	*/
+	ResultSetPtr CreateTypeInfoResult(SQLSMALLINT dataType);
+
+	/*!
+	* \brief	Busy wait (below 1 ms) or sleep for latency.
+	*/
+	void SimulateLatency(std::chrono::microseconds latency);
+}
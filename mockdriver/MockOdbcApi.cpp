@@ -0,0 +1,1614 @@
+﻿/*!
+* \file MockOdbcApi.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the ODBC functions exported by the exodbcmock driver.
+* \copyright GNU Lesser General Public License Version 3
+*
+* Only the ANSI functions are exported, the driver manager maps the Unicode functions.
+*/
+
+// Own header
+#include "MockDriver.h"
+
+// Same component headers
+// Other headers
+#include <odbcinst.h>
+
+// System headers
+#include <cstring>
+#include <algorithm>
+
+// Static consts
+// -------------
+
+using namespace std;
+using namespace exodbcmock;
+
+namespace
+{
+	/*!
+	* \brief	Call func with the handle of type T, locking it and mapping exceptions to diagnostic records.
+	*/
+	template<typename T, typename TFunc>
+	SQLRETURN Call(SQLHANDLE handle, Handle::Type type, TFunc func, bool clearDiag = true)
+	{
+		T* pHandle = Handle::Cast<T>(handle, type);
+		if (pHandle == NULL)
+		{
+			return SQL_INVALID_HANDLE;
+		}
+		lock_guard<recursive_mutex> lock(pHandle->GetMutex());
+		if (clearDiag)
+		{
+			pHandle->ClearDiag();
+		}
+		try
+		{
+			return func(*pHandle);
+		}
+		catch (const bad_alloc&)
+		{
+			return pHandle->AddDiag("HY001", "Memory allocation error");
+		}
+		catch (const exception& ex)
+		{
+			return pHandle->AddDiag("HY000", string("General error: ") + ex.what());
+		}
+	}
+
+
+	Handle* CastAny(SQLSMALLINT handleType, SQLHANDLE handle) noexcept
+	{
+		switch (handleType)
+		{
+		case SQL_HANDLE_ENV:
+			return Handle::Cast<Handle>(handle, Handle::Type::Env);
+		case SQL_HANDLE_DBC:
+			return Handle::Cast<Handle>(handle, Handle::Type::Dbc);
+		case SQL_HANDLE_STMT:
+			return Handle::Cast<Handle>(handle, Handle::Type::Stmt);
+		case SQL_HANDLE_DESC:
+			return Handle::Cast<Handle>(handle, Handle::Type::Desc);
+		default:
+			return NULL;
+		}
+	}
+
+
+	/*!
+	* \brief	Read an input string argument, NULL is read as empty string.
+	*/
+	string ToString(const SQLCHAR* pValue, SQLINTEGER length)
+	{
+		if (pValue == NULL)
+		{
+			return string();
+		}
+		return length == SQL_NTS ? string((const char*)pValue) : string((const char*)pValue, (size_t)max(length, 0));
+	}
+
+
+	/*!
+	* \brief	Write value to an output string buffer of bufferLength bytes, truncating it if required.
+	*/
+	template<typename TLength>
+	SQLRETURN WriteString(Handle& handle, const string& value, SQLPOINTER pTarget, SQLLEN bufferLength, TLength* pLength)
+	{
+		if (pLength)
+		{
+			*pLength = (TLength)value.length();
+		}
+		if (pTarget == NULL)
+		{
+			return SQL_SUCCESS;
+		}
+		if (bufferLength <= 0)
+		{
+			return value.empty() ? SQL_SUCCESS : handle.AddDiag("01004", "String data, right truncated", SQL_SUCCESS_WITH_INFO);
+		}
+		size_t count = min(value.length(), (size_t)bufferLength - 1);
+		memcpy(pTarget, value.data(), count);
+		((char*)pTarget)[count] = '\0';
+		return count < value.length() ? handle.AddDiag("01004", "String data, right truncated", SQL_SUCCESS_WITH_INFO) : SQL_SUCCESS;
+	}
+
+
+	// SQLGetInfo
+	// ----------
+	struct InfoEntry
+	{
+		enum class Type
+		{
+			String,
+			USmallInt,
+			UInt
+		};
+
+		Type m_type;
+		string m_string;
+		SQLUINTEGER m_number;
+	};
+
+
+	map<SQLUSMALLINT, InfoEntry> CreateInfoValues()
+	{
+		map<SQLUSMALLINT, InfoEntry> values;
+		auto text = [&](SQLUSMALLINT id, const char* value) { values[id] = { InfoEntry::Type::String, value, 0 }; };
+		auto usmallint = [&](SQLUSMALLINT id, SQLUSMALLINT value) { values[id] = { InfoEntry::Type::USmallInt, string(), value }; };
+		auto uint = [&](SQLUSMALLINT id, SQLUINTEGER value) { values[id] = { InfoEntry::Type::UInt, string(), value }; };
+
+		// Strings. SQL_DATA_SOURCE_NAME, SQL_DATABASE_NAME, SQL_SERVER_NAME and SQL_USER_NAME depend on the connection.
+		text(SQL_CATALOG_NAME_SEPARATOR, "");
+		text(SQL_CATALOG_TERM, "");
+		text(SQL_COLLATION_SEQ, "");
+		text(SQL_DBMS_NAME, "exodbcmock");
+		text(SQL_DBMS_VER, "01.00.0000");
+		text(SQL_DRIVER_NAME, "libexodbcmock.so");
+		text(SQL_DRIVER_ODBC_VER, "03.80");
+		text(SQL_DRIVER_VER, "01.00.0000");
+		text(SQL_IDENTIFIER_QUOTE_CHAR, "\"");
+		text(SQL_KEYWORDS, "");
+		text(SQL_ODBC_VER, "03.80");
+		text(SQL_PROCEDURE_TERM, "");
+		text(SQL_SCHEMA_TERM, "schema");
+		text(SQL_SEARCH_PATTERN_ESCAPE, "\\");
+		text(SQL_SPECIAL_CHARACTERS, "");
+		text(SQL_TABLE_TERM, "table");
+
+		// Y or N
+		const SQLUSMALLINT YES[] = { SQL_ACCESSIBLE_TABLES, SQL_COLUMN_ALIAS, SQL_DESCRIBE_PARAMETER, SQL_MULTIPLE_ACTIVE_TXN };
+		const SQLUSMALLINT NO[] = { SQL_ACCESSIBLE_PROCEDURES, SQL_CATALOG_NAME, SQL_DATA_SOURCE_READ_ONLY, SQL_EXPRESSIONS_IN_ORDERBY,
+			SQL_INTEGRITY, SQL_LIKE_ESCAPE_CLAUSE, SQL_MAX_ROW_SIZE_INCLUDES_LONG, SQL_NEED_LONG_DATA_LEN, SQL_ORDER_BY_COLUMNS_IN_SELECT,
+			SQL_OUTER_JOINS, SQL_PROCEDURES, SQL_ROW_UPDATES };
+		for (SQLUSMALLINT id : YES)
+		{
+			text(id, "Y");
+		}
+		for (SQLUSMALLINT id : NO)
+		{
+			text(id, "N");
+		}
+
+		// SQLUSMALLINT. All limits are 0, there is no limit.
+		const SQLUSMALLINT NO_LIMIT[] = { SQL_ACTIVE_ENVIRONMENTS, SQL_MAX_CATALOG_NAME_LEN, SQL_MAX_COLUMNS_IN_GROUP_BY, SQL_MAX_COLUMNS_IN_ORDER_BY,
+			SQL_MAX_COLUMNS_IN_SELECT, SQL_MAX_COLUMNS_IN_TABLE, SQL_MAX_COLUMN_NAME_LEN, SQL_MAX_CONCURRENT_ACTIVITIES, SQL_MAX_CURSOR_NAME_LEN,
+			SQL_MAX_DRIVER_CONNECTIONS, SQL_MAX_IDENTIFIER_LEN, SQL_MAX_PROCEDURE_NAME_LEN, SQL_MAX_SCHEMA_NAME_LEN, SQL_MAX_TABLES_IN_SELECT,
+			SQL_MAX_TABLE_NAME_LEN, SQL_MAX_USER_NAME_LEN };
+		for (SQLUSMALLINT id : NO_LIMIT)
+		{
+			usmallint(id, 0);
+		}
+		usmallint(SQL_CATALOG_LOCATION, 0);
+		usmallint(SQL_CORRELATION_NAME, SQL_CN_ANY);
+		usmallint(SQL_GROUP_BY, SQL_GB_NOT_SUPPORTED);
+		usmallint(SQL_IDENTIFIER_CASE, SQL_IC_MIXED);
+		usmallint(SQL_NON_NULLABLE_COLUMNS, SQL_NNC_NON_NULL);
+		usmallint(SQL_NULL_COLLATION, SQL_NC_HIGH);
+		usmallint(SQL_QUOTED_IDENTIFIER_CASE, SQL_IC_MIXED);
+		usmallint(SQL_TXN_CAPABLE, SQL_TC_ALL);
+
+		// SQLUINTEGER bitmasks of unsupported features and limits
+		const SQLUSMALLINT NONE[] = { SQL_ALTER_DOMAIN, SQL_ALTER_SCHEMA, SQL_ALTER_TABLE, SQL_ANSI_SQL_DATETIME_LITERALS, SQL_BATCH_ROW_COUNT,
+			SQL_BATCH_SUPPORT, SQL_BOOKMARK_PERSISTENCE, SQL_CATALOG_USAGE, SQL_CONVERT_BIGINT, SQL_CONVERT_BINARY, SQL_CONVERT_BIT, SQL_CONVERT_CHAR,
+			SQL_CONVERT_DATE, SQL_CONVERT_DECIMAL, SQL_CONVERT_DOUBLE, SQL_CONVERT_FUNCTIONS, SQL_CONVERT_INTEGER, SQL_CONVERT_INTERVAL_DAY_TIME,
+			SQL_CONVERT_INTERVAL_YEAR_MONTH, SQL_CONVERT_LONGVARBINARY, SQL_CONVERT_LONGVARCHAR, SQL_CONVERT_NUMERIC, SQL_CONVERT_REAL,
+			SQL_CONVERT_SMALLINT, SQL_CONVERT_TIME, SQL_CONVERT_TIMESTAMP, SQL_CONVERT_TINYINT, SQL_CONVERT_VARBINARY, SQL_CONVERT_VARCHAR,
+			SQL_CREATE_ASSERTION, SQL_CREATE_CHARACTER_SET, SQL_CREATE_COLLATION, SQL_CREATE_DOMAIN, SQL_CREATE_SCHEMA, SQL_CREATE_TABLE,
+			SQL_CREATE_TRANSLATION, SQL_DDL_INDEX, SQL_DROP_ASSERTION, SQL_DROP_CHARACTER_SET, SQL_DROP_COLLATION, SQL_DROP_DOMAIN, SQL_DROP_SCHEMA,
+			SQL_DROP_TABLE, SQL_DROP_TRANSLATION, SQL_DROP_VIEW, SQL_DYNAMIC_CURSOR_ATTRIBUTES1, SQL_DYNAMIC_CURSOR_ATTRIBUTES2, SQL_INFO_SCHEMA_VIEWS,
+			SQL_KEYSET_CURSOR_ATTRIBUTES1, SQL_KEYSET_CURSOR_ATTRIBUTES2, SQL_MAX_ASYNC_CONCURRENT_STATEMENTS, SQL_MAX_BINARY_LITERAL_LEN,
+			SQL_MAX_CHAR_LITERAL_LEN, SQL_MAX_COLUMNS_IN_INDEX, SQL_MAX_INDEX_SIZE, SQL_MAX_ROW_SIZE, SQL_MAX_STATEMENT_LEN, SQL_NUMERIC_FUNCTIONS,
+			SQL_ODBC_STANDARD_CLI_CONFORMANCE, SQL_OJ_CAPABILITIES, SQL_STRING_FUNCTIONS, SQL_SUBQUERIES, SQL_SYSTEM_FUNCTIONS,
+			SQL_TIMEDATE_ADD_INTERVALS, SQL_TIMEDATE_DIFF_INTERVALS, SQL_TIMEDATE_FUNCTIONS, SQL_UNION };
+		for (SQLUSMALLINT id : NONE)
+		{
+			uint(id, 0);
+		}
+		uint(SQL_AGGREGATE_FUNCTIONS, SQL_AF_COUNT);
+		uint(SQL_ASYNC_DBC_FUNCTIONS, SQL_ASYNC_DBC_NOT_CAPABLE);
+		uint(SQL_ASYNC_MODE, SQL_AM_NONE);
+		uint(SQL_ASYNC_NOTIFICATION, SQL_ASYNC_NOTIFICATION_NOT_CAPABLE);
+		uint(SQL_CONCAT_NULL_BEHAVIOR, SQL_CB_NULL);
+		uint(SQL_CURSOR_COMMIT_BEHAVIOR, SQL_CB_PRESERVE);
+		uint(SQL_CURSOR_ROLLBACK_BEHAVIOR, SQL_CB_PRESERVE);
+		uint(SQL_CURSOR_SENSITIVITY, SQL_INSENSITIVE);
+		uint(SQL_DEFAULT_TXN_ISOLATION, SQL_TXN_READ_COMMITTED);
+		uint(SQL_DRIVER_AWARE_POOLING_SUPPORTED, SQL_DRIVER_AWARE_POOLING_NOT_CAPABLE);
+		uint(SQL_FILE_USAGE, SQL_FILE_NOT_SUPPORTED);
+		uint(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1, SQL_CA1_NEXT);
+		uint(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2, SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT);
+		uint(SQL_GETDATA_EXTENSIONS, SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND | SQL_GD_BLOCK);
+		uint(SQL_INDEX_KEYWORDS, SQL_IK_NONE);
+		uint(SQL_INSERT_STATEMENT, SQL_IS_INSERT_LITERALS);
+		uint(SQL_ODBC_INTERFACE_CONFORMANCE, SQL_OIC_CORE);
+		uint(SQL_PARAM_ARRAY_ROW_COUNTS, SQL_PARC_BATCH);
+		uint(SQL_PARAM_ARRAY_SELECTS, SQL_PAS_NO_SELECT);
+		uint(SQL_SCHEMA_USAGE, SQL_SU_DML_STATEMENTS);
+		uint(SQL_SCROLL_OPTIONS, SQL_SO_FORWARD_ONLY | SQL_SO_STATIC);
+		uint(SQL_SQL_CONFORMANCE, SQL_SC_SQL92_ENTRY);
+		uint(SQL_STATIC_CURSOR_ATTRIBUTES1, SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE);
+		uint(SQL_STATIC_CURSOR_ATTRIBUTES2, SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT);
+		uint(SQL_TXN_ISOLATION_OPTION, SQL_TXN_READ_UNCOMMITTED | SQL_TXN_READ_COMMITTED | SQL_TXN_REPEATABLE_READ | SQL_TXN_SERIALIZABLE);
+		return values;
+	}
+
+
+	// Connecting
+	// ----------
+	const char* const CONFIG_KEYS[] = { "Schema", "Rows", "NullEvery", "Tables", "ConnectLatency", "PrepareLatency",
+		"ExecuteLatency", "FetchLatency", "RowLatency", "CatalogLatency" };
+
+
+	/*!
+	* \brief	Read the configuration from the DSN (if set) and attributes, which override the DSN.
+	*/
+	SQLRETURN Connect(Connection& dbc, const string& dsn, const string& user, const map<string, string>& attributes)
+	{
+		if (dbc.m_connected)
+		{
+			return dbc.AddDiag("08002", "Connection name in use");
+		}
+
+		MockConfig config;
+		try
+		{
+			if (!dsn.empty())
+			{
+				vector<char> buffer(65536);
+				for (const char* key : CONFIG_KEYS)
+				{
+					int length = SQLGetPrivateProfileString(dsn.c_str(), key, "", &buffer[0], (int)buffer.size(), "odbc.ini");
+					if (length > 0)
+					{
+						config.Set(key, string(&buffer[0], (size_t)length));
+					}
+				}
+			}
+			for (auto it = attributes.begin(); it != attributes.end(); ++it)
+			{
+				config.Set(it->first, it->second);
+			}
+			config.Finish();
+		}
+		catch (const invalid_argument& ex)
+		{
+			return dbc.AddDiag("08001", string("Client unable to establish connection: ") + ex.what());
+		}
+
+		SimulateLatency(config.m_connectLatency);
+		dbc.m_config = config;
+		dbc.m_dsn = dsn;
+		dbc.m_user = user;
+		dbc.m_connected = true;
+		return SQL_SUCCESS;
+	}
+
+
+	// Catalog functions
+	// -----------------
+	Value TextOrNull(const string& value)
+	{
+		return value.empty() ? Value() : Value::CreateText(value);
+	}
+
+
+	void AddColumns(StaticResultSet& result, const vector<pair<const char*, SQLSMALLINT>>& columns)
+	{
+		for (const auto& column : columns)
+		{
+			SQLULEN size = column.second == SQL_VARCHAR ? 128 : (column.second == SQL_SMALLINT ? 5 : 10);
+			result.AddColumn(ColumnDef(column.first, column.second, size, 0, true));
+		}
+	}
+
+
+	/*!
+	* \brief	True if the table matches the catalog, schema and table name patterns. NULL patterns match all.
+	*/
+	bool MatchesTable(const Connection& dbc, const TableDef& table, const SQLCHAR* pCatalog, const SQLCHAR* pSchema, const SQLCHAR* pTable,
+		SQLSMALLINT catalogLength, SQLSMALLINT schemaLength, SQLSMALLINT tableLength, bool patterns)
+	{
+		// The tables have no catalog
+		if (pCatalog && !ToString(pCatalog, catalogLength).empty() && !(patterns && MatchesPattern("", ToString(pCatalog, catalogLength))))
+		{
+			return false;
+		}
+		if (pSchema && !(patterns ? MatchesPattern(dbc.m_config.m_schema, ToString(pSchema, schemaLength)) : EqualsNoCase(dbc.m_config.m_schema, ToString(pSchema, schemaLength))))
+		{
+			return false;
+		}
+		return pTable == NULL || (patterns ? MatchesPattern(table.m_name, ToString(pTable, tableLength)) : EqualsNoCase(table.m_name, ToString(pTable, tableLength)));
+	}
+
+
+	vector<Value> TableColumns(const Connection& dbc, const TableDef& table)
+	{
+		return { Value(), TextOrNull(dbc.m_config.m_schema), Value::CreateText(table.m_name) };
+	}
+}
+
+
+extern "C"
+{
+	// Handles
+	// =======
+	SQLRETURN SQL_API SQLAllocHandle(SQLSMALLINT HandleType, SQLHANDLE InputHandle, SQLHANDLE* OutputHandle)
+	{
+		if (OutputHandle == NULL)
+		{
+			return SQL_ERROR;
+		}
+		switch (HandleType)
+		{
+		case SQL_HANDLE_ENV:
+			try
+			{
+				*OutputHandle = new Environment();
+				return SQL_SUCCESS;
+			}
+			catch (const bad_alloc&)
+			{
+				*OutputHandle = SQL_NULL_HENV;
+				return SQL_ERROR;
+			}
+		case SQL_HANDLE_DBC:
+			return Call<Environment>(InputHandle, Handle::Type::Env, [&](Environment& env) -> SQLRETURN
+			{
+				Connection* pDbc = new Connection(env);
+				env.m_connections.insert(pDbc);
+				*OutputHandle = pDbc;
+				return SQL_SUCCESS;
+			});
+		case SQL_HANDLE_STMT:
+			return Call<Connection>(InputHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+			{
+				if (!dbc.m_connected)
+				{
+					return dbc.AddDiag("08003", "Connection not open");
+				}
+				Statement* pStmt = new Statement(dbc);
+				dbc.m_statements.insert(pStmt);
+				*OutputHandle = pStmt;
+				return SQL_SUCCESS;
+			});
+		case SQL_HANDLE_DESC:
+			return Call<Connection>(InputHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+			{
+				return dbc.AddDiag("HYC00", "Optional feature not implemented: Explicitly allocated descriptors are not supported");
+			});
+		default:
+			return SQL_ERROR;
+		}
+	}
+
+
+	SQLRETURN SQL_API SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE ObjectHandle)
+	{
+		switch (HandleType)
+		{
+		case SQL_HANDLE_ENV:
+		{
+			Environment* pEnv = Handle::Cast<Environment>(ObjectHandle, Handle::Type::Env);
+			if (pEnv == NULL)
+			{
+				return SQL_INVALID_HANDLE;
+			}
+			{
+				lock_guard<recursive_mutex> lock(pEnv->GetMutex());
+				if (!pEnv->m_connections.empty())
+				{
+					pEnv->ClearDiag();
+					return pEnv->AddDiag("HY010", "Function sequence error: Connections are still allocated");
+				}
+			}
+			delete pEnv;
+			return SQL_SUCCESS;
+		}
+		case SQL_HANDLE_DBC:
+		{
+			Connection* pDbc = Handle::Cast<Connection>(ObjectHandle, Handle::Type::Dbc);
+			if (pDbc == NULL)
+			{
+				return SQL_INVALID_HANDLE;
+			}
+			{
+				lock_guard<recursive_mutex> lock(pDbc->GetMutex());
+				if (pDbc->m_connected)
+				{
+					pDbc->ClearDiag();
+					return pDbc->AddDiag("HY010", "Function sequence error: The connection is still open");
+				}
+			}
+			{
+				lock_guard<recursive_mutex> lock(pDbc->m_env.GetMutex());
+				pDbc->m_env.m_connections.erase(pDbc);
+			}
+			delete pDbc;
+			return SQL_SUCCESS;
+		}
+		case SQL_HANDLE_STMT:
+		{
+			Statement* pStmt = Handle::Cast<Statement>(ObjectHandle, Handle::Type::Stmt);
+			if (pStmt == NULL)
+			{
+				return SQL_INVALID_HANDLE;
+			}
+			{
+				lock_guard<recursive_mutex> lock(pStmt->m_dbc.GetMutex());
+				pStmt->m_dbc.m_statements.erase(pStmt);
+			}
+			{
+				lock_guard<recursive_mutex> lock(pStmt->GetMutex());
+			}
+			delete pStmt;
+			return SQL_SUCCESS;
+		}
+		default:
+			return SQL_ERROR;
+		}
+	}
+
+
+	SQLRETURN SQL_API SQLSetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength)
+	{
+		return Call<Environment>(EnvironmentHandle, Handle::Type::Env, [&](Environment& env) -> SQLRETURN
+		{
+			if (Attribute == SQL_ATTR_ODBC_VERSION)
+			{
+				env.m_odbcVersion = (SQLINTEGER)(SQLLEN)Value;
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLGetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER BufferLength, SQLINTEGER* StringLength)
+	{
+		return Call<Environment>(EnvironmentHandle, Handle::Type::Env, [&](Environment& env) -> SQLRETURN
+		{
+			if (Value)
+			{
+				*(SQLINTEGER*)Value = Attribute == SQL_ATTR_ODBC_VERSION ? env.m_odbcVersion : 0;
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	// Connections
+	// ===========
+	SQLRETURN SQL_API SQLConnect(SQLHDBC ConnectionHandle, SQLCHAR* ServerName, SQLSMALLINT NameLength1, SQLCHAR* UserName, SQLSMALLINT NameLength2,
+		SQLCHAR* Authentication, SQLSMALLINT NameLength3)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			return Connect(dbc, ToString(ServerName, NameLength1), ToString(UserName, NameLength2), map<string, string>());
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLDriverConnect(SQLHDBC ConnectionHandle, SQLHWND WindowHandle, SQLCHAR* InConnectionString, SQLSMALLINT StringLength1,
+		SQLCHAR* OutConnectionString, SQLSMALLINT BufferLength, SQLSMALLINT* StringLength2Ptr, SQLUSMALLINT DriverCompletion)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			string connectionString = ToString(InConnectionString, StringLength1);
+			map<string, string> attributes;
+			try
+			{
+				attributes = ParseConnectionString(connectionString);
+			}
+			catch (const invalid_argument& ex)
+			{
+				return dbc.AddDiag("08001", string("Client unable to establish connection: ") + ex.what());
+			}
+			string dsn = attributes.count("DSN") ? attributes["DSN"] : string();
+			string user = attributes.count("UID") ? attributes["UID"] : string();
+			SQLRETURN ret = Connect(dbc, dsn, user, attributes);
+			if (!SQL_SUCCEEDED(ret))
+			{
+				return ret;
+			}
+			return WriteString(dbc, connectionString, OutConnectionString, BufferLength, StringLength2Ptr);
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLDisconnect(SQLHDBC ConnectionHandle)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			if (!dbc.m_connected)
+			{
+				return dbc.AddDiag("08003", "Connection not open");
+			}
+			if (!dbc.m_statements.empty())
+			{
+				return dbc.AddDiag("HY010", "Function sequence error: Statements are still allocated");
+			}
+			dbc.m_connected = false;
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			switch (Attribute)
+			{
+			case SQL_ATTR_AUTOCOMMIT:
+				dbc.m_autocommit = (SQLUINTEGER)(SQLULEN)Value;
+				break;
+			case SQL_ATTR_TXN_ISOLATION:
+				dbc.m_txnIsolation = (SQLUINTEGER)(SQLULEN)Value;
+				break;
+			default:
+				dbc.m_attributes[Attribute] = (SQLULEN)Value;
+				break;
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLGetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER BufferLength, SQLINTEGER* StringLength)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			if (Value == NULL)
+			{
+				return dbc.AddDiag("HY009", "Invalid use of null pointer");
+			}
+			switch (Attribute)
+			{
+			case SQL_ATTR_AUTOCOMMIT:
+				*(SQLUINTEGER*)Value = dbc.m_autocommit;
+				break;
+			case SQL_ATTR_TXN_ISOLATION:
+				*(SQLUINTEGER*)Value = dbc.m_txnIsolation;
+				break;
+			case SQL_ATTR_CONNECTION_DEAD:
+				*(SQLUINTEGER*)Value = dbc.m_connected ? SQL_CD_FALSE : SQL_CD_TRUE;
+				break;
+			case SQL_ATTR_CURRENT_CATALOG:
+				return WriteString(dbc, "", Value, BufferLength, StringLength);
+			default:
+			{
+				auto it = dbc.m_attributes.find(Attribute);
+				*(SQLUINTEGER*)Value = it == dbc.m_attributes.end() ? 0 : (SQLUINTEGER)it->second;
+				break;
+			}
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType, SQLPOINTER InfoValue, SQLSMALLINT BufferLength, SQLSMALLINT* StringLengthPtr)
+	{
+		return Call<Connection>(ConnectionHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			switch (InfoType)
+			{
+			case SQL_DATA_SOURCE_NAME:
+				return WriteString(dbc, dbc.m_dsn, InfoValue, BufferLength, StringLengthPtr);
+			case SQL_USER_NAME:
+				return WriteString(dbc, dbc.m_user, InfoValue, BufferLength, StringLengthPtr);
+			case SQL_DATABASE_NAME:
+				return WriteString(dbc, dbc.m_config.m_schema, InfoValue, BufferLength, StringLengthPtr);
+			case SQL_SERVER_NAME:
+				return WriteString(dbc, "exodbcmock", InfoValue, BufferLength, StringLengthPtr);
+			}
+
+			static const map<SQLUSMALLINT, InfoEntry> VALUES = CreateInfoValues();
+			auto it = VALUES.find(InfoType);
+			if (it == VALUES.end())
+			{
+				return dbc.AddDiag("HY096", "Invalid information type: " + to_string(InfoType));
+			}
+			const InfoEntry& value = it->second;
+			switch (value.m_type)
+			{
+			case InfoEntry::Type::String:
+				return WriteString(dbc, value.m_string, InfoValue, BufferLength, StringLengthPtr);
+			case InfoEntry::Type::USmallInt:
+				if (InfoValue)
+				{
+					*(SQLUSMALLINT*)InfoValue = (SQLUSMALLINT)value.m_number;
+				}
+				if (StringLengthPtr)
+				{
+					*StringLengthPtr = sizeof(SQLUSMALLINT);
+				}
+				return SQL_SUCCESS;
+			default:
+				if (InfoValue)
+				{
+					*(SQLUINTEGER*)InfoValue = value.m_number;
+				}
+				if (StringLengthPtr)
+				{
+					*StringLengthPtr = sizeof(SQLUINTEGER);
+				}
+				return SQL_SUCCESS;
+			}
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE ObjectHandle, SQLSMALLINT CompletionType)
+	{
+		if (HandleType == SQL_HANDLE_ENV)
+		{
+			return Call<Environment>(ObjectHandle, Handle::Type::Env, [&](Environment&) -> SQLRETURN { return SQL_SUCCESS; });
+		}
+		return Call<Connection>(ObjectHandle, Handle::Type::Dbc, [&](Connection& dbc) -> SQLRETURN
+		{
+			if (!dbc.m_connected)
+			{
+				return dbc.AddDiag("08003", "Connection not open");
+			}
+			if (CompletionType != SQL_COMMIT && CompletionType != SQL_ROLLBACK)
+			{
+				return dbc.AddDiag("HY012", "Invalid transaction operation code");
+			}
+			// Nothing is stored, and cursors are preserved (SQL_CB_PRESERVE)
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	// Statements
+	// ==========
+	SQLRETURN SQL_API SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER StringLength)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.SetAttribute(Attribute, Value); });
+	}
+
+
+	SQLRETURN SQL_API SQLGetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute, SQLPOINTER Value, SQLINTEGER BufferLength, SQLINTEGER* StringLength)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.GetAttribute(Attribute, Value); });
+	}
+
+
+	SQLRETURN SQL_API SQLPrepare(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.Prepare(ToString(StatementText, TextLength)); });
+	}
+
+
+	SQLRETURN SQL_API SQLExecute(SQLHSTMT StatementHandle)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.Execute(); });
+	}
+
+
+	SQLRETURN SQL_API SQLExecDirect(SQLHSTMT StatementHandle, SQLCHAR* StatementText, SQLINTEGER TextLength)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			SQLRETURN ret = stmt.Prepare(ToString(StatementText, TextLength));
+			return SQL_SUCCEEDED(ret) ? stmt.Execute() : ret;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLNumParams(SQLHSTMT StatementHandle, SQLSMALLINT* ParameterCountPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (!stmt.m_prepared)
+			{
+				return stmt.AddDiag("HY010", "Function sequence error: No statement prepared");
+			}
+			if (ParameterCountPtr)
+			{
+				*ParameterCountPtr = (SQLSMALLINT)stmt.m_parsed.m_parameterColumns.size();
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLDescribeParam(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber, SQLSMALLINT* DataTypePtr, SQLULEN* ParameterSizePtr,
+		SQLSMALLINT* DecimalDigitsPtr, SQLSMALLINT* NullablePtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (!stmt.m_prepared)
+			{
+				return stmt.AddDiag("HY010", "Function sequence error: No statement prepared");
+			}
+			if (ParameterNumber == 0 || ParameterNumber > stmt.m_parsed.m_parameterColumns.size())
+			{
+				return stmt.AddDiag("07009", "Invalid descriptor index: " + to_string(ParameterNumber));
+			}
+			ColumnDef column = stmt.DescribeParameter(ParameterNumber);
+			if (DataTypePtr)
+				*DataTypePtr = column.m_sqlType;
+			if (ParameterSizePtr)
+				*ParameterSizePtr = column.m_columnSize;
+			if (DecimalDigitsPtr)
+				*DecimalDigitsPtr = column.m_decimalDigits;
+			if (NullablePtr)
+				*NullablePtr = column.m_nullable ? SQL_NULLABLE : SQL_NO_NULLS;
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLBindParameter(SQLHSTMT StatementHandle, SQLUSMALLINT ParameterNumber, SQLSMALLINT InputOutputType, SQLSMALLINT ValueType,
+		SQLSMALLINT ParameterType, SQLULEN ColumnSize, SQLSMALLINT DecimalDigits, SQLPOINTER ParameterValuePtr, SQLLEN BufferLength, SQLLEN* StrLen_or_IndPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (ParameterNumber == 0)
+			{
+				return stmt.AddDiag("07009", "Invalid descriptor index: 0");
+			}
+			if (InputOutputType != SQL_PARAM_INPUT)
+			{
+				return stmt.AddDiag("HYC00", "Optional feature not implemented: Only input parameters are supported");
+			}
+			if (BufferLength < 0)
+			{
+				return stmt.AddDiag("HY090", "Invalid string or buffer length");
+			}
+			DescRecord& record = stmt.m_apd.m_records[ParameterNumber];
+			record.m_conciseType = ValueType;
+			record.m_pData = ParameterValuePtr;
+			record.m_octetLength = BufferLength;
+			record.m_pOctetLength = StrLen_or_IndPtr;
+			record.m_pIndicator = StrLen_or_IndPtr;
+			record.m_precision = (SQLSMALLINT)ColumnSize;
+			record.m_scale = DecimalDigits;
+			record.m_parameterType = InputOutputType;
+			record.m_sqlType = ParameterType;
+			record.m_columnSize = ColumnSize;
+			record.m_decimalDigits = DecimalDigits;
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLNumResultCols(SQLHSTMT StatementHandle, SQLSMALLINT* ColumnCountPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (ColumnCountPtr)
+			{
+				*ColumnCountPtr = (SQLSMALLINT)stmt.m_resultColumns.size();
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLDescribeCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLCHAR* ColumnName, SQLSMALLINT BufferLength,
+		SQLSMALLINT* NameLengthPtr, SQLSMALLINT* DataTypePtr, SQLULEN* ColumnSizePtr, SQLSMALLINT* DecimalDigitsPtr, SQLSMALLINT* NullablePtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (ColumnNumber == 0 || ColumnNumber > stmt.m_resultColumns.size())
+			{
+				return stmt.AddDiag("07009", "Invalid descriptor index: " + to_string(ColumnNumber));
+			}
+			const ColumnDef& column = stmt.m_resultColumns[ColumnNumber - 1];
+			if (DataTypePtr)
+				*DataTypePtr = column.m_sqlType;
+			if (ColumnSizePtr)
+				*ColumnSizePtr = column.m_columnSize;
+			if (DecimalDigitsPtr)
+				*DecimalDigitsPtr = column.m_decimalDigits;
+			if (NullablePtr)
+				*NullablePtr = column.m_nullable ? SQL_NULLABLE : SQL_NO_NULLS;
+			return WriteString(stmt, column.m_name, ColumnName, BufferLength, NameLengthPtr);
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLColAttribute(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLUSMALLINT FieldIdentifier, SQLPOINTER CharacterAttributePtr,
+		SQLSMALLINT BufferLength, SQLSMALLINT* StringLengthPtr, SQLLEN* NumericAttributePtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			SQLLEN number = 0;
+			if (FieldIdentifier == SQL_DESC_COUNT)
+			{
+				number = (SQLLEN)stmt.m_resultColumns.size();
+			}
+			else
+			{
+				if (ColumnNumber == 0 || ColumnNumber > stmt.m_resultColumns.size())
+				{
+					return stmt.AddDiag("07009", "Invalid descriptor index: " + to_string(ColumnNumber));
+				}
+				const ColumnDef& column = stmt.m_resultColumns[ColumnNumber - 1];
+				bool isNumber = column.m_sqlType == SQL_SMALLINT || column.m_sqlType == SQL_INTEGER || column.m_sqlType == SQL_BIGINT
+					|| column.m_sqlType == SQL_REAL || column.m_sqlType == SQL_FLOAT || column.m_sqlType == SQL_DOUBLE
+					|| column.m_sqlType == SQL_DECIMAL || column.m_sqlType == SQL_NUMERIC;
+				switch (FieldIdentifier)
+				{
+				case SQL_DESC_NAME:
+				case SQL_DESC_LABEL:
+				case SQL_DESC_BASE_COLUMN_NAME:
+					return WriteString(stmt, column.m_name, CharacterAttributePtr, BufferLength, StringLengthPtr);
+				case SQL_DESC_TYPE_NAME:
+				case SQL_DESC_LOCAL_TYPE_NAME:
+					return WriteString(stmt, column.GetTypeName(), CharacterAttributePtr, BufferLength, StringLengthPtr);
+				case SQL_DESC_TABLE_NAME:
+				case SQL_DESC_BASE_TABLE_NAME:
+					return WriteString(stmt, stmt.m_parsed.m_tableName, CharacterAttributePtr, BufferLength, StringLengthPtr);
+				case SQL_DESC_SCHEMA_NAME:
+					return WriteString(stmt, stmt.m_parsed.m_tableName.empty() ? string() : stmt.m_dbc.m_config.m_schema, CharacterAttributePtr, BufferLength, StringLengthPtr);
+				case SQL_DESC_CATALOG_NAME:
+				case SQL_DESC_LITERAL_PREFIX:
+				case SQL_DESC_LITERAL_SUFFIX:
+					return WriteString(stmt, "", CharacterAttributePtr, BufferLength, StringLengthPtr);
+				case SQL_DESC_CONCISE_TYPE:
+					number = column.m_sqlType;
+					break;
+				case SQL_DESC_TYPE:
+					number = GetDateTimeSubCode(column.m_sqlType) != 0 ? SQL_DATETIME : column.m_sqlType;
+					break;
+				case SQL_DESC_DATETIME_INTERVAL_CODE:
+					number = GetDateTimeSubCode(column.m_sqlType);
+					break;
+				case SQL_DESC_LENGTH:
+				case SQL_DESC_PRECISION:
+					number = (SQLLEN)column.m_columnSize;
+					break;
+				case SQL_DESC_SCALE:
+					number = column.m_decimalDigits;
+					break;
+				case SQL_DESC_OCTET_LENGTH:
+					number = column.GetOctetLength();
+					break;
+				case SQL_DESC_DISPLAY_SIZE:
+					number = column.GetDisplaySize();
+					break;
+				case SQL_DESC_NULLABLE:
+					number = column.m_nullable ? SQL_NULLABLE : SQL_NO_NULLS;
+					break;
+				case SQL_DESC_UNSIGNED:
+					number = isNumber ? SQL_FALSE : SQL_TRUE;
+					break;
+				case SQL_DESC_FIXED_PREC_SCALE:
+				case SQL_DESC_AUTO_UNIQUE_VALUE:
+					number = SQL_FALSE;
+					break;
+				case SQL_DESC_CASE_SENSITIVE:
+					number = isNumber ? SQL_FALSE : SQL_TRUE;
+					break;
+				case SQL_DESC_NUM_PREC_RADIX:
+					number = isNumber ? 10 : 0;
+					break;
+				case SQL_DESC_SEARCHABLE:
+					number = SQL_PRED_SEARCHABLE;
+					break;
+				case SQL_DESC_UNNAMED:
+					number = column.m_name.empty() ? SQL_UNNAMED : SQL_NAMED;
+					break;
+				case SQL_DESC_UPDATABLE:
+					number = SQL_ATTR_READWRITE_UNKNOWN;
+					break;
+				default:
+					return stmt.AddDiag("HY091", "Invalid descriptor field identifier: " + to_string(FieldIdentifier));
+				}
+			}
+			if (NumericAttributePtr)
+			{
+				*NumericAttributePtr = number;
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber, SQLSMALLINT TargetType, SQLPOINTER TargetValuePtr,
+		SQLLEN BufferLength, SQLLEN* StrLen_or_IndPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (ColumnNumber == 0)
+			{
+				return stmt.AddDiag("07009", "Invalid descriptor index: Bookmarks are not supported");
+			}
+			if (BufferLength < 0)
+			{
+				return stmt.AddDiag("HY090", "Invalid string or buffer length");
+			}
+			if (TargetValuePtr == NULL && StrLen_or_IndPtr == NULL)
+			{
+				stmt.m_ard.m_records.erase(ColumnNumber);
+				return SQL_SUCCESS;
+			}
+			DescRecord& record = stmt.m_ard.m_records[ColumnNumber];
+			record.m_conciseType = TargetType;
+			record.m_pData = TargetValuePtr;
+			record.m_octetLength = BufferLength;
+			record.m_pOctetLength = StrLen_or_IndPtr;
+			record.m_pIndicator = StrLen_or_IndPtr;
+			record.m_precision = 0;
+			record.m_scale = 0;
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLFetch(SQLHSTMT StatementHandle)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.Fetch(SQL_FETCH_NEXT, 0); });
+	}
+
+
+	SQLRETURN SQL_API SQLFetchScroll(SQLHSTMT StatementHandle, SQLSMALLINT FetchOrientation, SQLLEN FetchOffset)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.Fetch(FetchOrientation, FetchOffset); });
+	}
+
+
+	SQLRETURN SQL_API SQLGetData(SQLHSTMT StatementHandle, SQLUSMALLINT Col_or_Param_Num, SQLSMALLINT TargetType, SQLPOINTER TargetValuePtr,
+		SQLLEN BufferLength, SQLLEN* StrLen_or_IndPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			return stmt.GetData(Col_or_Param_Num, TargetType, TargetValuePtr, BufferLength, StrLen_or_IndPtr);
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLRowCount(SQLHSTMT StatementHandle, SQLLEN* RowCountPtr)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (RowCountPtr)
+			{
+				*RowCountPtr = stmt.m_rowCount;
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLMoreResults(SQLHSTMT StatementHandle)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			// Every statement returns at most one result
+			stmt.CloseCursor(false);
+			return SQL_NO_DATA;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option)
+	{
+		if (Option == SQL_DROP)
+		{
+			return SQLFreeHandle(SQL_HANDLE_STMT, StatementHandle);
+		}
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			switch (Option)
+			{
+			case SQL_CLOSE:
+				return stmt.CloseCursor(false);
+			case SQL_UNBIND:
+				stmt.m_ard.m_records.clear();
+				return SQL_SUCCESS;
+			case SQL_RESET_PARAMS:
+				stmt.m_apd.m_records.clear();
+				return SQL_SUCCESS;
+			default:
+				return stmt.AddDiag("HY092", "Invalid attribute/option identifier: " + to_string(Option));
+			}
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT StatementHandle)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.CloseCursor(true); });
+	}
+
+
+	SQLRETURN SQL_API SQLCancel(SQLHSTMT StatementHandle)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement&) -> SQLRETURN { return SQL_SUCCESS; });
+	}
+
+
+	// Diagnostics
+	// ===========
+	SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE ObjectHandle, SQLSMALLINT RecNumber, SQLCHAR* SQLState, SQLINTEGER* NativeErrorPtr,
+		SQLCHAR* MessageText, SQLSMALLINT BufferLength, SQLSMALLINT* TextLengthPtr)
+	{
+		Handle* pHandle = CastAny(HandleType, ObjectHandle);
+		if (pHandle == NULL)
+		{
+			return SQL_INVALID_HANDLE;
+		}
+		lock_guard<recursive_mutex> lock(pHandle->GetMutex());
+		if (RecNumber <= 0 || BufferLength < 0)
+		{
+			return SQL_ERROR;
+		}
+		if ((size_t)RecNumber > pHandle->GetDiag().size())
+		{
+			return SQL_NO_DATA;
+		}
+		const DiagRecord& record = pHandle->GetDiag()[RecNumber - 1];
+		if (SQLState)
+		{
+			strncpy((char*)SQLState, record.m_sqlState.c_str(), 6);
+			SQLState[5] = '\0';
+		}
+		if (NativeErrorPtr)
+		{
+			*NativeErrorPtr = record.m_nativeError;
+		}
+		// Do not add a diagnostic record for truncating the message
+		size_t length = record.m_message.length();
+		if (TextLengthPtr)
+		{
+			*TextLengthPtr = (SQLSMALLINT)length;
+		}
+		if (MessageText && BufferLength > 0)
+		{
+			size_t count = min(length, (size_t)BufferLength - 1);
+			memcpy(MessageText, record.m_message.data(), count);
+			MessageText[count] = '\0';
+			return count < length ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+		}
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN SQL_API SQLGetDiagField(SQLSMALLINT HandleType, SQLHANDLE ObjectHandle, SQLSMALLINT RecNumber, SQLSMALLINT DiagIdentifier, SQLPOINTER DiagInfoPtr,
+		SQLSMALLINT BufferLength, SQLSMALLINT* StringLengthPtr)
+	{
+		Handle* pHandle = CastAny(HandleType, ObjectHandle);
+		if (pHandle == NULL)
+		{
+			return SQL_INVALID_HANDLE;
+		}
+		lock_guard<recursive_mutex> lock(pHandle->GetMutex());
+		const vector<DiagRecord>& diag = pHandle->GetDiag();
+
+		// Header fields
+		switch (DiagIdentifier)
+		{
+		case SQL_DIAG_NUMBER:
+			if (DiagInfoPtr)
+				*(SQLINTEGER*)DiagInfoPtr = (SQLINTEGER)diag.size();
+			return SQL_SUCCESS;
+		case SQL_DIAG_ROW_COUNT:
+		{
+			Statement* pStmt = Handle::Cast<Statement>(ObjectHandle, Handle::Type::Stmt);
+			if (pStmt == NULL)
+				return SQL_ERROR;
+			if (DiagInfoPtr)
+				*(SQLLEN*)DiagInfoPtr = pStmt->m_rowCount;
+			return SQL_SUCCESS;
+		}
+		case SQL_DIAG_RETURNCODE:
+		case SQL_DIAG_CURSOR_ROW_COUNT:
+		case SQL_DIAG_DYNAMIC_FUNCTION_CODE:
+			return SQL_ERROR;
+		}
+
+		// Record fields
+		if (RecNumber <= 0)
+		{
+			return SQL_ERROR;
+		}
+		if ((size_t)RecNumber > diag.size())
+		{
+			return SQL_NO_DATA;
+		}
+		const DiagRecord& record = diag[RecNumber - 1];
+		string text;
+		switch (DiagIdentifier)
+		{
+		case SQL_DIAG_SQLSTATE:
+			text = record.m_sqlState;
+			break;
+		case SQL_DIAG_MESSAGE_TEXT:
+			text = record.m_message;
+			break;
+		case SQL_DIAG_CLASS_ORIGIN:
+		case SQL_DIAG_SUBCLASS_ORIGIN:
+			text = record.m_sqlState.compare(0, 2, "IM") == 0 ? "ODBC 3.0" : "ISO 9075";
+			break;
+		case SQL_DIAG_CONNECTION_NAME:
+		case SQL_DIAG_SERVER_NAME:
+			break;
+		case SQL_DIAG_NATIVE:
+			if (DiagInfoPtr)
+				*(SQLINTEGER*)DiagInfoPtr = record.m_nativeError;
+			return SQL_SUCCESS;
+		case SQL_DIAG_COLUMN_NUMBER:
+			if (DiagInfoPtr)
+				*(SQLINTEGER*)DiagInfoPtr = SQL_COLUMN_NUMBER_UNKNOWN;
+			return SQL_SUCCESS;
+		case SQL_DIAG_ROW_NUMBER:
+			if (DiagInfoPtr)
+				*(SQLLEN*)DiagInfoPtr = SQL_ROW_NUMBER_UNKNOWN;
+			return SQL_SUCCESS;
+		default:
+			return SQL_ERROR;
+		}
+		size_t length = text.length();
+		if (StringLengthPtr)
+		{
+			*StringLengthPtr = (SQLSMALLINT)length;
+		}
+		if (DiagInfoPtr && BufferLength > 0)
+		{
+			size_t count = min(length, (size_t)BufferLength - 1);
+			memcpy(DiagInfoPtr, text.data(), count);
+			((char*)DiagInfoPtr)[count] = '\0';
+			return count < length ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+		}
+		return SQL_SUCCESS;
+	}
+
+
+	// Descriptors
+	// ===========
+	SQLRETURN SQL_API SQLSetDescField(SQLHDESC DescriptorHandle, SQLSMALLINT RecNumber, SQLSMALLINT FieldIdentifier, SQLPOINTER Value, SQLINTEGER BufferLength)
+	{
+		return Call<Descriptor>(DescriptorHandle, Handle::Type::Desc, [&](Descriptor& desc) -> SQLRETURN
+		{
+			if (&desc == &desc.m_stmt.m_ird)
+			{
+				return desc.AddDiag("HY016", "Cannot modify an implementation row descriptor");
+			}
+			SQLULEN number = (SQLULEN)Value;
+			switch (FieldIdentifier)
+			{
+			case SQL_DESC_ARRAY_SIZE:
+				desc.m_arraySize = number;
+				return SQL_SUCCESS;
+			case SQL_DESC_BIND_TYPE:
+				desc.m_bindType = number;
+				return SQL_SUCCESS;
+			case SQL_DESC_BIND_OFFSET_PTR:
+				desc.m_pBindOffset = (SQLLEN*)Value;
+				return SQL_SUCCESS;
+			case SQL_DESC_ARRAY_STATUS_PTR:
+				desc.m_pArrayStatus = (SQLUSMALLINT*)Value;
+				return SQL_SUCCESS;
+			case SQL_DESC_ROWS_PROCESSED_PTR:
+				desc.m_pRowsProcessed = (SQLULEN*)Value;
+				return SQL_SUCCESS;
+			case SQL_DESC_COUNT:
+				desc.m_records.erase(desc.m_records.upper_bound((SQLUSMALLINT)number), desc.m_records.end());
+				return SQL_SUCCESS;
+			}
+
+			if (RecNumber <= 0)
+			{
+				return desc.AddDiag("07009", "Invalid descriptor index: " + to_string(RecNumber));
+			}
+			DescRecord& record = desc.m_records[(SQLUSMALLINT)RecNumber];
+			switch (FieldIdentifier)
+			{
+			case SQL_DESC_TYPE:
+			case SQL_DESC_CONCISE_TYPE:
+				record.m_conciseType = (SQLSMALLINT)number;
+				break;
+			case SQL_DESC_DATETIME_INTERVAL_CODE:
+				if (record.m_conciseType == SQL_DATETIME)
+				{
+					record.m_conciseType = number == SQL_CODE_DATE ? SQL_C_TYPE_DATE : (number == SQL_CODE_TIME ? SQL_C_TYPE_TIME : SQL_C_TYPE_TIMESTAMP);
+				}
+				break;
+			case SQL_DESC_PRECISION:
+				record.m_precision = (SQLSMALLINT)number;
+				break;
+			case SQL_DESC_SCALE:
+				record.m_scale = (SQLSMALLINT)number;
+				break;
+			case SQL_DESC_DATA_PTR:
+				record.m_pData = Value;
+				break;
+			case SQL_DESC_INDICATOR_PTR:
+				record.m_pIndicator = (SQLLEN*)Value;
+				break;
+			case SQL_DESC_OCTET_LENGTH_PTR:
+				record.m_pOctetLength = (SQLLEN*)Value;
+				break;
+			case SQL_DESC_OCTET_LENGTH:
+			case SQL_DESC_LENGTH:
+				record.m_octetLength = (SQLLEN)number;
+				break;
+			case SQL_DESC_PARAMETER_TYPE:
+				record.m_parameterType = (SQLSMALLINT)number;
+				break;
+			default:
+				return desc.AddDiag("HY091", "Invalid descriptor field identifier: " + to_string(FieldIdentifier));
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLGetDescField(SQLHDESC DescriptorHandle, SQLSMALLINT RecNumber, SQLSMALLINT FieldIdentifier, SQLPOINTER Value,
+		SQLINTEGER BufferLength, SQLINTEGER* StringLength)
+	{
+		return Call<Descriptor>(DescriptorHandle, Handle::Type::Desc, [&](Descriptor& desc) -> SQLRETURN
+		{
+			if (Value == NULL)
+			{
+				return desc.AddDiag("HY009", "Invalid use of null pointer");
+			}
+			Statement& stmt = desc.m_stmt;
+			bool isIrd = &desc == &stmt.m_ird;
+			bool isIpd = &desc == &stmt.m_ipd;
+			switch (FieldIdentifier)
+			{
+			case SQL_DESC_COUNT:
+				*(SQLSMALLINT*)Value = isIrd ? (SQLSMALLINT)stmt.m_resultColumns.size() : (isIpd ? (SQLSMALLINT)stmt.m_parsed.m_parameterColumns.size() : desc.GetCount());
+				return SQL_SUCCESS;
+			case SQL_DESC_ARRAY_SIZE:
+				*(SQLULEN*)Value = desc.m_arraySize;
+				return SQL_SUCCESS;
+			case SQL_DESC_BIND_TYPE:
+				*(SQLINTEGER*)Value = (SQLINTEGER)desc.m_bindType;
+				return SQL_SUCCESS;
+			case SQL_DESC_BIND_OFFSET_PTR:
+				*(SQLLEN**)Value = desc.m_pBindOffset;
+				return SQL_SUCCESS;
+			case SQL_DESC_ARRAY_STATUS_PTR:
+				*(SQLUSMALLINT**)Value = desc.m_pArrayStatus;
+				return SQL_SUCCESS;
+			case SQL_DESC_ROWS_PROCESSED_PTR:
+				*(SQLULEN**)Value = desc.m_pRowsProcessed;
+				return SQL_SUCCESS;
+			}
+
+			if (RecNumber <= 0)
+			{
+				return desc.AddDiag("07009", "Invalid descriptor index: " + to_string(RecNumber));
+			}
+			if (isIrd || isIpd)
+			{
+				size_t count = isIrd ? stmt.m_resultColumns.size() : stmt.m_parsed.m_parameterColumns.size();
+				if ((size_t)RecNumber > count)
+				{
+					return SQL_NO_DATA;
+				}
+				ColumnDef column = isIrd ? stmt.m_resultColumns[RecNumber - 1] : stmt.DescribeParameter((SQLUSMALLINT)RecNumber);
+				switch (FieldIdentifier)
+				{
+				case SQL_DESC_NAME:
+					return WriteString(desc, column.m_name, Value, BufferLength, StringLength);
+				case SQL_DESC_CONCISE_TYPE:
+					*(SQLSMALLINT*)Value = column.m_sqlType;
+					return SQL_SUCCESS;
+				case SQL_DESC_TYPE:
+					*(SQLSMALLINT*)Value = GetDateTimeSubCode(column.m_sqlType) != 0 ? SQL_DATETIME : column.m_sqlType;
+					return SQL_SUCCESS;
+				case SQL_DESC_DATETIME_INTERVAL_CODE:
+					*(SQLSMALLINT*)Value = GetDateTimeSubCode(column.m_sqlType);
+					return SQL_SUCCESS;
+				case SQL_DESC_LENGTH:
+					*(SQLULEN*)Value = column.m_columnSize;
+					return SQL_SUCCESS;
+				case SQL_DESC_OCTET_LENGTH:
+					*(SQLLEN*)Value = column.GetOctetLength();
+					return SQL_SUCCESS;
+				case SQL_DESC_PRECISION:
+					*(SQLSMALLINT*)Value = (SQLSMALLINT)column.m_columnSize;
+					return SQL_SUCCESS;
+				case SQL_DESC_SCALE:
+					*(SQLSMALLINT*)Value = column.m_decimalDigits;
+					return SQL_SUCCESS;
+				case SQL_DESC_NULLABLE:
+					*(SQLSMALLINT*)Value = column.m_nullable ? SQL_NULLABLE : SQL_NO_NULLS;
+					return SQL_SUCCESS;
+				case SQL_DESC_PARAMETER_TYPE:
+					*(SQLSMALLINT*)Value = SQL_PARAM_INPUT;
+					return SQL_SUCCESS;
+				default:
+					return desc.AddDiag("HY091", "Invalid descriptor field identifier: " + to_string(FieldIdentifier));
+				}
+			}
+
+			auto it = desc.m_records.find((SQLUSMALLINT)RecNumber);
+			if (it == desc.m_records.end())
+			{
+				return SQL_NO_DATA;
+			}
+			const DescRecord& record = it->second;
+			switch (FieldIdentifier)
+			{
+			case SQL_DESC_TYPE:
+			case SQL_DESC_CONCISE_TYPE:
+				*(SQLSMALLINT*)Value = record.m_conciseType;
+				break;
+			case SQL_DESC_PRECISION:
+				*(SQLSMALLINT*)Value = record.m_precision;
+				break;
+			case SQL_DESC_SCALE:
+				*(SQLSMALLINT*)Value = record.m_scale;
+				break;
+			case SQL_DESC_DATA_PTR:
+				*(SQLPOINTER*)Value = record.m_pData;
+				break;
+			case SQL_DESC_INDICATOR_PTR:
+				*(SQLLEN**)Value = record.m_pIndicator;
+				break;
+			case SQL_DESC_OCTET_LENGTH_PTR:
+				*(SQLLEN**)Value = record.m_pOctetLength;
+				break;
+			case SQL_DESC_OCTET_LENGTH:
+			case SQL_DESC_LENGTH:
+				*(SQLLEN*)Value = record.m_octetLength;
+				break;
+			case SQL_DESC_PARAMETER_TYPE:
+				*(SQLSMALLINT*)Value = record.m_parameterType;
+				break;
+			default:
+				return desc.AddDiag("HY091", "Invalid descriptor field identifier: " + to_string(FieldIdentifier));
+			}
+			return SQL_SUCCESS;
+		});
+	}
+
+
+	// Catalog functions
+	// =================
+	SQLRETURN SQL_API SQLTables(SQLHSTMT StatementHandle, SQLCHAR* CatalogName, SQLSMALLINT NameLength1, SQLCHAR* SchemaName, SQLSMALLINT NameLength2,
+		SQLCHAR* TableName, SQLSMALLINT NameLength3, SQLCHAR* TableType, SQLSMALLINT NameLength4)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "TABLE_CAT", SQL_VARCHAR }, { "TABLE_SCHEM", SQL_VARCHAR }, { "TABLE_NAME", SQL_VARCHAR },
+				{ "TABLE_TYPE", SQL_VARCHAR }, { "REMARKS", SQL_VARCHAR } });
+
+			string catalog = ToString(CatalogName, NameLength1);
+			string schema = ToString(SchemaName, NameLength2);
+			string table = ToString(TableName, NameLength3);
+			string types = ToString(TableType, NameLength4);
+			bool allOthersEmpty = TableName && table.empty();
+			if (catalog == SQL_ALL_CATALOGS && SchemaName && schema.empty() && allOthersEmpty)
+			{
+				// There are no catalogs
+			}
+			else if (schema == SQL_ALL_SCHEMAS && CatalogName && catalog.empty() && allOthersEmpty)
+			{
+				pResult->AddRow({ Value(), TextOrNull(stmt.m_dbc.m_config.m_schema), Value(), Value(), Value() });
+			}
+			else if (types == SQL_ALL_TABLE_TYPES && CatalogName && catalog.empty() && SchemaName && schema.empty() && allOthersEmpty)
+			{
+				pResult->AddRow({ Value(), Value(), Value(), Value::CreateText("TABLE"), Value() });
+			}
+			else
+			{
+				// All tables are of type TABLE
+				bool typeMatches = TableType == NULL || types.empty() || types == SQL_ALL_TABLE_TYPES || ToUpper(types).find("TABLE") != string::npos;
+				for (const TableDef& tableDef : stmt.m_dbc.m_config.m_tables)
+				{
+					if (typeMatches && MatchesTable(stmt.m_dbc, tableDef, CatalogName, SchemaName, TableName, NameLength1, NameLength2, NameLength3, true))
+					{
+						vector<Value> row = TableColumns(stmt.m_dbc, tableDef);
+						row.push_back(Value::CreateText("TABLE"));
+						row.push_back(Value());
+						pResult->AddRow(row);
+					}
+				}
+			}
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLColumns(SQLHSTMT StatementHandle, SQLCHAR* CatalogName, SQLSMALLINT NameLength1, SQLCHAR* SchemaName, SQLSMALLINT NameLength2,
+		SQLCHAR* TableName, SQLSMALLINT NameLength3, SQLCHAR* ColumnName, SQLSMALLINT NameLength4)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "TABLE_CAT", SQL_VARCHAR }, { "TABLE_SCHEM", SQL_VARCHAR }, { "TABLE_NAME", SQL_VARCHAR },
+				{ "COLUMN_NAME", SQL_VARCHAR }, { "DATA_TYPE", SQL_SMALLINT }, { "TYPE_NAME", SQL_VARCHAR }, { "COLUMN_SIZE", SQL_INTEGER },
+				{ "BUFFER_LENGTH", SQL_INTEGER }, { "DECIMAL_DIGITS", SQL_SMALLINT }, { "NUM_PREC_RADIX", SQL_SMALLINT }, { "NULLABLE", SQL_SMALLINT },
+				{ "REMARKS", SQL_VARCHAR }, { "COLUMN_DEF", SQL_VARCHAR }, { "SQL_DATA_TYPE", SQL_SMALLINT }, { "SQL_DATETIME_SUB", SQL_SMALLINT },
+				{ "CHAR_OCTET_LENGTH", SQL_INTEGER }, { "ORDINAL_POSITION", SQL_INTEGER }, { "IS_NULLABLE", SQL_VARCHAR } });
+
+			string columnPattern = ToString(ColumnName, NameLength4);
+			for (const TableDef& table : stmt.m_dbc.m_config.m_tables)
+			{
+				if (!MatchesTable(stmt.m_dbc, table, CatalogName, SchemaName, TableName, NameLength1, NameLength2, NameLength3, true))
+				{
+					continue;
+				}
+				for (size_t i = 0; i < table.m_columns.size(); ++i)
+				{
+					const ColumnDef& column = table.m_columns[i];
+					if (ColumnName && !MatchesPattern(column.m_name, columnPattern))
+					{
+						continue;
+					}
+					SQLSMALLINT sqlType = column.m_sqlType;
+					SQLSMALLINT dateTimeSub = GetDateTimeSubCode(sqlType);
+					bool isExact = sqlType == SQL_SMALLINT || sqlType == SQL_INTEGER || sqlType == SQL_BIGINT || sqlType == SQL_DECIMAL || sqlType == SQL_NUMERIC;
+					bool isApproximate = sqlType == SQL_REAL || sqlType == SQL_FLOAT || sqlType == SQL_DOUBLE;
+					bool isCharOrBinary = GetDefaultCType(sqlType) == SQL_C_CHAR || GetDefaultCType(sqlType) == SQL_C_WCHAR || GetDefaultCType(sqlType) == SQL_C_BINARY;
+					vector<Value> row = TableColumns(stmt.m_dbc, table);
+					row.push_back(Value::CreateText(column.m_name));
+					row.push_back(Value::CreateInteger(sqlType));
+					row.push_back(Value::CreateText(column.GetTypeName()));
+					row.push_back(Value::CreateInteger((long long)column.m_columnSize));
+					row.push_back(Value::CreateInteger(column.GetOctetLength()));
+					row.push_back((isExact || dateTimeSub == SQL_CODE_TIMESTAMP) ? Value::CreateInteger(column.m_decimalDigits) : Value());
+					row.push_back(isExact ? Value::CreateInteger(10) : (isApproximate ? Value::CreateInteger(2) : Value()));
+					row.push_back(Value::CreateInteger(column.m_nullable ? SQL_NULLABLE : SQL_NO_NULLS));
+					row.push_back(Value());
+					row.push_back(Value());
+					row.push_back(Value::CreateInteger(dateTimeSub != 0 ? SQL_DATETIME : sqlType));
+					row.push_back(dateTimeSub != 0 ? Value::CreateInteger(dateTimeSub) : Value());
+					row.push_back(isCharOrBinary && !isExact ? Value::CreateInteger(column.GetOctetLength()) : Value());
+					row.push_back(Value::CreateInteger((long long)i + 1));
+					row.push_back(Value::CreateText(column.m_nullable ? "YES" : "NO"));
+					pResult->AddRow(row);
+				}
+			}
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLPrimaryKeys(SQLHSTMT StatementHandle, SQLCHAR* CatalogName, SQLSMALLINT NameLength1, SQLCHAR* SchemaName, SQLSMALLINT NameLength2,
+		SQLCHAR* TableName, SQLSMALLINT NameLength3)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (TableName == NULL)
+			{
+				return stmt.AddDiag("HY009", "Invalid use of null pointer: A table name is required");
+			}
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "TABLE_CAT", SQL_VARCHAR }, { "TABLE_SCHEM", SQL_VARCHAR }, { "TABLE_NAME", SQL_VARCHAR },
+				{ "COLUMN_NAME", SQL_VARCHAR }, { "KEY_SEQ", SQL_SMALLINT }, { "PK_NAME", SQL_VARCHAR } });
+			for (const TableDef& table : stmt.m_dbc.m_config.m_tables)
+			{
+				if (!MatchesTable(stmt.m_dbc, table, CatalogName, SchemaName, TableName, NameLength1, NameLength2, NameLength3, false))
+				{
+					continue;
+				}
+				long long keySequence = 0;
+				for (const ColumnDef& column : table.m_columns)
+				{
+					if (column.m_primaryKey)
+					{
+						vector<Value> row = TableColumns(stmt.m_dbc, table);
+						row.push_back(Value::CreateText(column.m_name));
+						row.push_back(Value::CreateInteger(++keySequence));
+						row.push_back(Value::CreateText(table.m_name + "_pkey"));
+						pResult->AddRow(row);
+					}
+				}
+			}
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLSpecialColumns(SQLHSTMT StatementHandle, SQLUSMALLINT IdentifierType, SQLCHAR* CatalogName, SQLSMALLINT NameLength1,
+		SQLCHAR* SchemaName, SQLSMALLINT NameLength2, SQLCHAR* TableName, SQLSMALLINT NameLength3, SQLUSMALLINT Scope, SQLUSMALLINT Nullable)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (TableName == NULL)
+			{
+				return stmt.AddDiag("HY009", "Invalid use of null pointer: A table name is required");
+			}
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "SCOPE", SQL_SMALLINT }, { "COLUMN_NAME", SQL_VARCHAR }, { "DATA_TYPE", SQL_SMALLINT }, { "TYPE_NAME", SQL_VARCHAR },
+				{ "COLUMN_SIZE", SQL_INTEGER }, { "BUFFER_LENGTH", SQL_INTEGER }, { "DECIMAL_DIGITS", SQL_SMALLINT }, { "PSEUDO_COLUMN", SQL_SMALLINT } });
+			// The primary key identifies a row, there are no row version columns
+			for (const TableDef& table : stmt.m_dbc.m_config.m_tables)
+			{
+				if (IdentifierType != SQL_BEST_ROWID
+					|| !MatchesTable(stmt.m_dbc, table, CatalogName, SchemaName, TableName, NameLength1, NameLength2, NameLength3, false))
+				{
+					continue;
+				}
+				for (const ColumnDef& column : table.m_columns)
+				{
+					if (column.m_primaryKey)
+					{
+						pResult->AddRow({ Value::CreateInteger(SQL_SCOPE_SESSION), Value::CreateText(column.m_name), Value::CreateInteger(column.m_sqlType),
+							Value::CreateText(column.GetTypeName()), Value::CreateInteger((long long)column.m_columnSize), Value::CreateInteger(column.GetOctetLength()),
+							Value::CreateInteger(column.m_decimalDigits), Value::CreateInteger(SQL_PC_NOT_PSEUDO) });
+					}
+				}
+			}
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLStatistics(SQLHSTMT StatementHandle, SQLCHAR* CatalogName, SQLSMALLINT NameLength1, SQLCHAR* SchemaName, SQLSMALLINT NameLength2,
+		SQLCHAR* TableName, SQLSMALLINT NameLength3, SQLUSMALLINT Unique, SQLUSMALLINT Reserved)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (TableName == NULL)
+			{
+				return stmt.AddDiag("HY009", "Invalid use of null pointer: A table name is required");
+			}
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "TABLE_CAT", SQL_VARCHAR }, { "TABLE_SCHEM", SQL_VARCHAR }, { "TABLE_NAME", SQL_VARCHAR },
+				{ "NON_UNIQUE", SQL_SMALLINT }, { "INDEX_QUALIFIER", SQL_VARCHAR }, { "INDEX_NAME", SQL_VARCHAR }, { "TYPE", SQL_SMALLINT },
+				{ "ORDINAL_POSITION", SQL_SMALLINT }, { "COLUMN_NAME", SQL_VARCHAR }, { "ASC_OR_DESC", SQL_CHAR }, { "CARDINALITY", SQL_INTEGER },
+				{ "PAGES", SQL_INTEGER }, { "FILTER_CONDITION", SQL_VARCHAR } });
+			for (const TableDef& table : stmt.m_dbc.m_config.m_tables)
+			{
+				if (!MatchesTable(stmt.m_dbc, table, CatalogName, SchemaName, TableName, NameLength1, NameLength2, NameLength3, false))
+				{
+					continue;
+				}
+				// One row with the statistics of the table, then the unique index of the primary key
+				Value cardinality = Value::CreateInteger((long long)table.m_rows);
+				Value pages = Value::CreateInteger((long long)(table.m_rows / 100 + 1));
+				vector<Value> row = TableColumns(stmt.m_dbc, table);
+				row.insert(row.end(), { Value(), Value(), Value(), Value::CreateInteger(SQL_TABLE_STAT), Value(), Value(), Value(), cardinality, pages, Value() });
+				pResult->AddRow(row);
+				long long ordinal = 0;
+				for (const ColumnDef& column : table.m_columns)
+				{
+					if (column.m_primaryKey)
+					{
+						row = TableColumns(stmt.m_dbc, table);
+						row.insert(row.end(), { Value::CreateInteger(SQL_FALSE), Value(), Value::CreateText(table.m_name + "_pkey"), Value::CreateInteger(SQL_INDEX_OTHER),
+							Value::CreateInteger(++ordinal), Value::CreateText(column.m_name), Value::CreateText("A"), cardinality, pages, Value() });
+						pResult->AddRow(row);
+					}
+				}
+			}
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLForeignKeys(SQLHSTMT StatementHandle, SQLCHAR* PKCatalogName, SQLSMALLINT NameLength1, SQLCHAR* PKSchemaName, SQLSMALLINT NameLength2,
+		SQLCHAR* PKTableName, SQLSMALLINT NameLength3, SQLCHAR* FKCatalogName, SQLSMALLINT NameLength4, SQLCHAR* FKSchemaName, SQLSMALLINT NameLength5,
+		SQLCHAR* FKTableName, SQLSMALLINT NameLength6)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN
+		{
+			if (PKTableName == NULL && FKTableName == NULL)
+			{
+				return stmt.AddDiag("HY009", "Invalid use of null pointer: A primary or foreign key table name is required");
+			}
+			StaticResultSet* pResult = new StaticResultSet();
+			ResultSetPtr pResultPtr(pResult);
+			AddColumns(*pResult, { { "PKTABLE_CAT", SQL_VARCHAR }, { "PKTABLE_SCHEM", SQL_VARCHAR }, { "PKTABLE_NAME", SQL_VARCHAR },
+				{ "PKCOLUMN_NAME", SQL_VARCHAR }, { "FKTABLE_CAT", SQL_VARCHAR }, { "FKTABLE_SCHEM", SQL_VARCHAR }, { "FKTABLE_NAME", SQL_VARCHAR },
+				{ "FKCOLUMN_NAME", SQL_VARCHAR }, { "KEY_SEQ", SQL_SMALLINT }, { "UPDATE_RULE", SQL_SMALLINT }, { "DELETE_RULE", SQL_SMALLINT },
+				{ "FK_NAME", SQL_VARCHAR }, { "PK_NAME", SQL_VARCHAR }, { "DEFERRABILITY", SQL_SMALLINT } });
+			// The table definitions have no foreign keys
+			return stmt.SetCatalogResult(move(pResultPtr));
+		});
+	}
+
+
+	SQLRETURN SQL_API SQLGetTypeInfo(SQLHSTMT StatementHandle, SQLSMALLINT DataType)
+	{
+		return Call<Statement>(StatementHandle, Handle::Type::Stmt, [&](Statement& stmt) -> SQLRETURN { return stmt.SetCatalogResult(CreateTypeInfoResult(DataType)); });
+	}
+}
@@ -0,0 +1,1136 @@
+﻿/*!
+* \file MockStatement.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the handles and the statement of the exodbcmock driver.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "MockDriver.h"
+
+// Same component headers
+// Other headers
+// System headers
+#include <algorithm>
+#include <cctype>
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbcmock
+{
+	const char* const MESSAGE_PREFIX = "[exodbc][MockDriver]";
+
+
+	namespace
+	{
+		struct Token
+		{
+			enum class Kind
+			{
+				Word,
+				Quoted,
+				String,
+				Number,
+				Symbol,
+				Marker
+			};
+
+			Kind m_kind;
+			std::string m_text;
+
+			bool IsWord(const char* word) const { return m_kind == Kind::Word && EqualsNoCase(m_text, word); };
+			bool IsSymbol(const char* symbol) const { return m_kind == Kind::Symbol && m_text == symbol; };
+			bool IsIdentifier() const { return m_kind == Kind::Word || m_kind == Kind::Quoted; };
+		};
+
+
+		void ParseHints(const string& comment, map<string, string>& hints)
+		{
+			size_t pos = comment.find_first_not_of(" \t\r\n");
+			if (pos == string::npos || !EqualsNoCase(comment.substr(pos, 4), "mock"))
+			{
+				return;
+			}
+			pos += 4;
+			while (pos < comment.length())
+			{
+				size_t start = comment.find_first_not_of(" \t\r\n", pos);
+				if (start == string::npos)
+				{
+					break;
+				}
+				size_t end = comment.find_first_of(" \t\r\n", start);
+				string hint = comment.substr(start, end == string::npos ? string::npos : end - start);
+				size_t equals = hint.find('=');
+				if (equals != string::npos)
+				{
+					hints[ToUpper(hint.substr(0, equals))] = hint.substr(equals + 1);
+				}
+				pos = end == string::npos ? comment.length() : end;
+			}
+		}
+
+
+		vector<Token> Tokenize(const string& sql, map<string, string>& hints)
+		{
+			vector<Token> tokens;
+			size_t i = 0;
+			while (i < sql.length())
+			{
+				char c = sql[i];
+				if (isspace((unsigned char)c))
+				{
+					++i;
+				}
+				else if (c == '-' && i + 1 < sql.length() && sql[i + 1] == '-')
+				{
+					size_t end = sql.find('\n', i);
+					i = end == string::npos ? sql.length() : end;
+				}
+				else if (c == '/' && i + 1 < sql.length() && sql[i + 1] == '*')
+				{
+					size_t end = sql.find("*/", i + 2);
+					if (end == string::npos)
+					{
+						throw invalid_argument("Comment is not closed");
+					}
+					ParseHints(sql.substr(i + 2, end - i - 2), hints);
+					i = end + 2;
+				}
+				else if (c == '\'' || c == '"' || c == '`' || c == '[')
+				{
+					char close = c == '[' ? ']' : c;
+					string text;
+					size_t j = i + 1;
+					for (;; ++j)
+					{
+						if (j >= sql.length())
+						{
+							throw invalid_argument("Quoted string or identifier is not closed");
+						}
+						if (sql[j] == close)
+						{
+							// A doubled quote is an escaped quote
+							if (j + 1 < sql.length() && sql[j + 1] == close && close != ']')
+							{
+								text += close;
+								++j;
+								continue;
+							}
+							break;
+						}
+						text += sql[j];
+					}
+					tokens.push_back({ c == '\'' ? Token::Kind::String : Token::Kind::Quoted, text });
+					i = j + 1;
+				}
+				else if (isalpha((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80)
+				{
+					size_t j = i;
+					while (j < sql.length() && (isalnum((unsigned char)sql[j]) || sql[j] == '_' || sql[j] == '$' || (unsigned char)sql[j] >= 0x80))
+					{
+						++j;
+					}
+					tokens.push_back({ Token::Kind::Word, sql.substr(i, j - i) });
+					i = j;
+				}
+				else if (isdigit((unsigned char)c) || (c == '.' && i + 1 < sql.length() && isdigit((unsigned char)sql[i + 1])))
+				{
+					size_t j = i;
+					while (j < sql.length() && (isdigit((unsigned char)sql[j]) || sql[j] == '.'))
+					{
+						++j;
+					}
+					tokens.push_back({ Token::Kind::Number, sql.substr(i, j - i) });
+					i = j;
+				}
+				else if (c == '?')
+				{
+					tokens.push_back({ Token::Kind::Marker, "?" });
+					++i;
+				}
+				else
+				{
+					static const char* const TWO_CHAR_SYMBOLS[] = { "<>", "<=", ">=", "!=" };
+					string symbol(1, c);
+					for (const char* twoChars : TWO_CHAR_SYMBOLS)
+					{
+						if (sql.compare(i, 2, twoChars) == 0)
+						{
+							symbol = twoChars;
+						}
+					}
+					tokens.push_back({ Token::Kind::Symbol, symbol });
+					i += symbol.length();
+				}
+			}
+			return tokens;
+		}
+
+
+		bool IsComparison(const Token& token)
+		{
+			static const char* const OPERATORS[] = { "=", "<>", "<", ">", "<=", ">=", "!=" };
+			for (const char* op : OPERATORS)
+			{
+				if (token.IsSymbol(op))
+				{
+					return true;
+				}
+			}
+			return token.IsWord("LIKE");
+		}
+
+
+		/*!
+		* \brief	Read a possibly qualified identifier starting at pos, return its last part.
+		*/
+		string ReadQualifiedName(const vector<Token>& tokens, size_t& pos)
+		{
+			if (pos >= tokens.size() || !tokens[pos].IsIdentifier())
+			{
+				throw invalid_argument("Identifier expected");
+			}
+			string name = tokens[pos++].m_text;
+			while (pos + 1 < tokens.size() && tokens[pos].IsSymbol(".") && tokens[pos + 1].IsIdentifier())
+			{
+				name = tokens[pos + 1].m_text;
+				pos += 2;
+			}
+			return name;
+		}
+
+
+		ParsedSql::SelectItem ParseSelectItem(const vector<Token>& item)
+		{
+			ParsedSql::SelectItem selectItem;
+			selectItem.m_kind = ParsedSql::SelectItem::Kind::Column;
+			size_t pos = 0;
+			if (item.empty())
+			{
+				throw invalid_argument("Empty select item");
+			}
+			if (item.back().IsSymbol("*"))
+			{
+				selectItem.m_kind = ParsedSql::SelectItem::Kind::All;
+				return selectItem;
+			}
+			if (item.size() >= 4 && item[0].IsWord("COUNT") && item[1].IsSymbol("(") && item[2].IsSymbol("*") && item[3].IsSymbol(")"))
+			{
+				selectItem.m_kind = ParsedSql::SelectItem::Kind::Count;
+				selectItem.m_name = "count";
+				pos = 4;
+			}
+			else if (item[0].m_kind == Token::Kind::Number || item[0].m_kind == Token::Kind::String
+				|| (item.size() > 1 && item[0].IsSymbol("-") && item[1].m_kind == Token::Kind::Number))
+			{
+				selectItem.m_kind = ParsedSql::SelectItem::Kind::Constant;
+				bool negative = item[0].IsSymbol("-");
+				pos = negative ? 2 : 1;
+				const string& text = item[pos - 1].m_text;
+				if (item[pos - 1].m_kind == Token::Kind::String)
+				{
+					selectItem.m_constant = Value::CreateText(text);
+				}
+				else if (text.find('.') == string::npos)
+				{
+					long long value = stoll(text);
+					selectItem.m_constant = Value::CreateInteger(negative ? -value : value);
+				}
+				else
+				{
+					double value = stod(text);
+					selectItem.m_constant = Value::CreateReal(negative ? -value : value);
+				}
+				selectItem.m_name = "expr";
+			}
+			else
+			{
+				selectItem.m_name = ReadQualifiedName(item, pos);
+			}
+			selectItem.m_alias = selectItem.m_name;
+
+			if (pos < item.size() && item[pos].IsWord("AS"))
+			{
+				++pos;
+			}
+			if (pos < item.size() && item[pos].IsIdentifier())
+			{
+				selectItem.m_alias = item[pos++].m_text;
+			}
+			if (pos != item.size())
+			{
+				throw invalid_argument("Unsupported select item starting with '" + item[0].m_text + "': Only columns, literals, * and COUNT(*) are supported");
+			}
+			return selectItem;
+		}
+	}
+
+
+	ParsedSql ParseSql(const std::string& sql)
+	{
+		ParsedSql parsed;
+		vector<Token> tokens = Tokenize(sql, parsed.m_hints);
+		if (tokens.empty())
+		{
+			throw invalid_argument("Empty statement");
+		}
+
+		// Guess the column every parameter marker is assigned to or compared with
+		for (size_t i = 0; i < tokens.size(); ++i)
+		{
+			if (tokens[i].m_kind == Token::Kind::Marker)
+			{
+				string column;
+				if (i >= 2 && IsComparison(tokens[i - 1]) && tokens[i - 2].IsIdentifier())
+				{
+					column = tokens[i - 2].m_text;
+				}
+				parsed.m_parameterColumns.push_back(column);
+			}
+			if (tokens[i].IsWord("WHERE"))
+			{
+				parsed.m_hasWhere = true;
+			}
+		}
+
+		size_t pos = 1;
+		if (tokens[0].IsWord("SELECT"))
+		{
+			parsed.m_kind = ParsedSql::Kind::Select;
+			if (pos < tokens.size() && (tokens[pos].IsWord("DISTINCT") || tokens[pos].IsWord("ALL")))
+			{
+				++pos;
+			}
+			vector<Token> item;
+			int depth = 0;
+			for (; pos < tokens.size(); ++pos)
+			{
+				const Token& token = tokens[pos];
+				if (depth == 0 && (token.IsWord("FROM") || token.IsSymbol(",")))
+				{
+					parsed.m_selectItems.push_back(ParseSelectItem(item));
+					item.clear();
+					if (token.IsWord("FROM"))
+					{
+						break;
+					}
+					continue;
+				}
+				depth += token.IsSymbol("(") ? 1 : (token.IsSymbol(")") ? -1 : 0);
+				item.push_back(token);
+			}
+			if (pos >= tokens.size())
+			{
+				// SELECT without FROM
+				parsed.m_selectItems.push_back(ParseSelectItem(item));
+				return parsed;
+			}
+			++pos;
+			parsed.m_tableName = ReadQualifiedName(tokens, pos);
+			if (pos < tokens.size() && tokens[pos].IsSymbol(","))
+			{
+				throw invalid_argument("Selecting from more than one table is not supported");
+			}
+			if (find_if(tokens.begin() + pos, tokens.end(), [](const Token& t) { return t.IsWord("JOIN"); }) != tokens.end())
+			{
+				throw invalid_argument("JOIN is not supported");
+			}
+		}
+		else if (tokens[0].IsWord("INSERT"))
+		{
+			parsed.m_kind = ParsedSql::Kind::Insert;
+			if (pos < tokens.size() && tokens[pos].IsWord("INTO"))
+			{
+				++pos;
+			}
+			parsed.m_tableName = ReadQualifiedName(tokens, pos);
+			vector<string> columns;
+			if (pos < tokens.size() && tokens[pos].IsSymbol("("))
+			{
+				for (++pos; pos < tokens.size() && !tokens[pos].IsSymbol(")"); ++pos)
+				{
+					if (tokens[pos].IsIdentifier())
+					{
+						columns.push_back(tokens[pos].m_text);
+					}
+				}
+				++pos;
+			}
+			if (pos >= tokens.size() || !tokens[pos].IsWord("VALUES") || pos + 1 >= tokens.size() || !tokens[pos + 1].IsSymbol("("))
+			{
+				throw invalid_argument("INSERT is only supported with a VALUES list");
+			}
+			// Parameters are mapped by their position in the VALUES list
+			size_t valueIndex = 0;
+			size_t markerIndex = 0;
+			int depth = 0;
+			for (pos += 2; pos < tokens.size(); ++pos)
+			{
+				const Token& token = tokens[pos];
+				if (token.IsSymbol("("))
+					++depth;
+				else if (token.IsSymbol(")") && depth-- == 0)
+					break;
+				else if (depth == 0 && token.IsSymbol(","))
+					++valueIndex;
+				else if (token.m_kind == Token::Kind::Marker)
+				{
+					string& column = parsed.m_parameterColumns[markerIndex++];
+					if (depth == 0)
+					{
+						column = columns.empty() ? "#" + to_string(valueIndex) : (valueIndex < columns.size() ? columns[valueIndex] : string());
+					}
+				}
+			}
+		}
+		else if (tokens[0].IsWord("UPDATE"))
+		{
+			parsed.m_kind = ParsedSql::Kind::Update;
+			parsed.m_tableName = ReadQualifiedName(tokens, pos);
+		}
+		else if (tokens[0].IsWord("DELETE"))
+		{
+			parsed.m_kind = ParsedSql::Kind::Delete;
+			if (pos < tokens.size() && tokens[pos].IsWord("FROM"))
+			{
+				++pos;
+			}
+			parsed.m_tableName = ReadQualifiedName(tokens, pos);
+		}
+		return parsed;
+	}
+
+
+	// Handle
+	// ======
+	Handle::Handle(Type type)
+		: m_magic(MAGIC)
+		, m_type(type)
+	{ }
+
+
+	Handle::~Handle()
+	{
+		m_magic = 0;
+	}
+
+
+	SQLRETURN Handle::AddDiag(const std::string& sqlState, const std::string& message, SQLRETURN ret /* = SQL_ERROR */)
+	{
+		m_diag.push_back({ sqlState, 0, string(MESSAGE_PREFIX) + message });
+		return ret;
+	}
+
+
+	// Environment
+	// ===========
+	Environment::Environment()
+		: Handle(Type::Env)
+		, m_odbcVersion(SQL_OV_ODBC3)
+	{ }
+
+
+	// Connection
+	// ==========
+	Connection::Connection(Environment& env)
+		: Handle(Type::Dbc)
+		, m_env(env)
+		, m_connected(false)
+		, m_autocommit(SQL_AUTOCOMMIT_ON)
+		, m_txnIsolation(SQL_TXN_READ_COMMITTED)
+	{ }
+
+
+	// Descriptor
+	// ==========
+	Descriptor::Descriptor(Statement& stmt)
+		: Handle(Type::Desc)
+		, m_stmt(stmt)
+		, m_arraySize(1)
+		, m_bindType(SQL_BIND_BY_COLUMN)
+		, m_pBindOffset(NULL)
+		, m_pArrayStatus(NULL)
+		, m_pRowsProcessed(NULL)
+	{ }
+
+
+	std::recursive_mutex& Descriptor::GetMutex()
+	{
+		return m_stmt.GetMutex();
+	}
+
+
+	char* Descriptor::GetElement(void* pBase, SQLULEN index, SQLLEN elementSize) const noexcept
+	{
+		if (pBase == NULL)
+		{
+			return NULL;
+		}
+		char* p = (char*)pBase;
+		if (m_pBindOffset)
+		{
+			p += *m_pBindOffset;
+		}
+		return p + index * (m_bindType == SQL_BIND_BY_COLUMN ? elementSize : (SQLLEN)m_bindType);
+	}
+
+
+	SQLSMALLINT Descriptor::GetCount() const noexcept
+	{
+		for (auto it = m_records.rbegin(); it != m_records.rend(); ++it)
+		{
+			if (it->second.IsBound())
+			{
+				return (SQLSMALLINT)it->first;
+			}
+		}
+		return 0;
+	}
+
+
+	// TableResultSet
+	// ==============
+	TableResultSet::TableResultSet(const TableDef& table, const std::vector<size_t>& projection, SQLULEN rowCount, unsigned nullEvery)
+		: m_projection(projection)
+		, m_rowCount(rowCount)
+		, m_nullEvery(nullEvery)
+	{
+		for (size_t index : projection)
+		{
+			m_columns.push_back(table.m_columns[index]);
+		}
+	}
+
+
+	Value TableResultSet::GetValue(SQLULEN row, size_t column) const
+	{
+		return GenerateValue(m_columns[column], m_projection[column], row, m_nullEvery);
+	}
+
+
+	// Statement
+	// =========
+	Statement::Statement(Connection& dbc)
+		: Handle(Type::Stmt)
+		, m_dbc(dbc)
+		, m_ard(*this)
+		, m_apd(*this)
+		, m_ird(*this)
+		, m_ipd(*this)
+		, m_prepared(false)
+		, m_rowCount(-1)
+		, m_cursorType(SQL_CURSOR_FORWARD_ONLY)
+		, m_concurrency(SQL_CONCUR_READ_ONLY)
+		, m_maxRows(0)
+		, m_pTable(NULL)
+		, m_processedParamsets(0)
+		, m_checksum(0)
+		, m_cursorRow(-1)
+		, m_lastRowsetSize(0)
+		, m_getDataColumn(0)
+		, m_getDataOffset(0)
+	{ }
+
+
+	SQLRETURN Statement::CloseCursor(bool failIfNotOpen)
+	{
+		if (!m_pResult)
+		{
+			return failIfNotOpen ? AddDiag("24000", "Invalid cursor state: No cursor is open") : SQL_SUCCESS;
+		}
+		m_pResult.reset();
+		m_cursorRow = -1;
+		m_lastRowsetSize = 0;
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::Prepare(const std::string& sql)
+	{
+		CloseCursor(false);
+		m_prepared = false;
+		m_resultColumns.clear();
+		m_projection.clear();
+		m_pTable = NULL;
+		try
+		{
+			m_parsed = ParseSql(sql);
+		}
+		catch (const invalid_argument& ex)
+		{
+			return AddDiag("42000", string("Syntax error or access violation: ") + ex.what());
+		}
+		m_sql = sql;
+		SimulateLatency(m_dbc.m_config.m_prepareLatency);
+
+		if (!m_parsed.m_tableName.empty())
+		{
+			m_pTable = m_dbc.m_config.FindTable(m_parsed.m_tableName);
+			if (m_pTable == NULL)
+			{
+				return AddDiag("42S02", "Base table or view not found: " + m_parsed.m_tableName);
+			}
+		}
+
+		for (const ParsedSql::SelectItem& item : m_parsed.m_selectItems)
+		{
+			switch (item.m_kind)
+			{
+			case ParsedSql::SelectItem::Kind::All:
+				if (m_pTable == NULL)
+				{
+					return AddDiag("42000", "Syntax error or access violation: SELECT * requires a table");
+				}
+				for (size_t i = 0; i < m_pTable->m_columns.size(); ++i)
+				{
+					m_projection.push_back(i);
+					m_resultColumns.push_back(m_pTable->m_columns[i]);
+				}
+				break;
+			case ParsedSql::SelectItem::Kind::Column:
+			{
+				int index = m_pTable ? m_pTable->FindColumn(item.m_name) : -1;
+				if (index < 0)
+				{
+					return AddDiag("42S22", "Column not found: " + item.m_name);
+				}
+				m_projection.push_back((size_t)index);
+				m_resultColumns.push_back(m_pTable->m_columns[index]);
+				m_resultColumns.back().m_name = item.m_alias;
+				break;
+			}
+			case ParsedSql::SelectItem::Kind::Count:
+				m_resultColumns.push_back(ColumnDef(item.m_alias, SQL_BIGINT, 19, 0, false));
+				break;
+			case ParsedSql::SelectItem::Kind::Constant:
+			{
+				const Value& value = item.m_constant;
+				SQLSMALLINT sqlType = value.m_kind == Value::Kind::Integer ? SQL_BIGINT : (value.m_kind == Value::Kind::Real ? SQL_DOUBLE : SQL_VARCHAR);
+				m_resultColumns.push_back(ColumnDef(item.m_alias, sqlType, sqlType == SQL_VARCHAR ? max(value.m_bytes.length(), (size_t)1) : 15, 0, false));
+				break;
+			}
+			}
+		}
+		if (m_pTable && m_projection.size() != m_resultColumns.size())
+		{
+			bool countOnly = m_parsed.m_selectItems.size() == 1 && m_parsed.m_selectItems.front().m_kind == ParsedSql::SelectItem::Kind::Count;
+			if (!countOnly)
+			{
+				return AddDiag("42000", "Syntax error or access violation: COUNT(*) and literals cannot be combined with columns of a table");
+			}
+		}
+
+		m_prepared = true;
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::Execute()
+	{
+		if (!m_prepared)
+		{
+			return AddDiag("HY010", "Function sequence error: No statement prepared");
+		}
+		if (m_pResult)
+		{
+			return AddDiag("24000", "Invalid cursor state: A cursor is still open");
+		}
+
+		auto hint = m_parsed.m_hints.find("ERROR");
+		if (hint != m_parsed.m_hints.end())
+		{
+			return AddDiag(hint->second, "Error requested by a mock hint of the statement");
+		}
+
+		SQLRETURN ret = ReadParameters();
+		if (!SQL_SUCCEEDED(ret))
+		{
+			return ret;
+		}
+
+		hint = m_parsed.m_hints.find("EXECUTELATENCY");
+		SimulateLatency(hint != m_parsed.m_hints.end() ? chrono::microseconds(stoll(hint->second)) : m_dbc.m_config.m_executeLatency);
+
+		SQLULEN tableRows = m_pTable ? m_pTable->m_rows : 0;
+		hint = m_parsed.m_hints.find("ROWS");
+		if (hint != m_parsed.m_hints.end())
+		{
+			tableRows = (SQLULEN)stoull(hint->second);
+		}
+
+		switch (m_parsed.m_kind)
+		{
+		case ParsedSql::Kind::Select:
+		{
+			if (m_pTable && m_projection.size() == m_resultColumns.size())
+			{
+				SQLULEN rowCount = m_maxRows > 0 ? min(tableRows, m_maxRows) : tableRows;
+				m_pResult.reset(new TableResultSet(*m_pTable, m_projection, rowCount, m_dbc.m_config.m_nullEvery));
+			}
+			else
+			{
+				// COUNT(*) or literals only
+				StaticResultSet* pResult = new StaticResultSet();
+				vector<Value> row;
+				for (size_t i = 0; i < m_resultColumns.size(); ++i)
+				{
+					pResult->AddColumn(m_resultColumns[i]);
+					const ParsedSql::SelectItem& item = m_parsed.m_selectItems[i];
+					row.push_back(item.m_kind == ParsedSql::SelectItem::Kind::Count ? Value::CreateInteger((long long)tableRows) : item.m_constant);
+				}
+				pResult->AddRow(row);
+				m_pResult.reset(pResult);
+			}
+			m_rowCount = (SQLLEN)m_pResult->GetRowCount();
+			m_cursorRow = -1;
+			m_lastRowsetSize = 0;
+			return SQL_SUCCESS;
+		}
+		case ParsedSql::Kind::Insert:
+			m_rowCount = (SQLLEN)m_processedParamsets;
+			return SQL_SUCCESS;
+		case ParsedSql::Kind::Update:
+		case ParsedSql::Kind::Delete:
+			// Nothing is stored: Pretend every paramset of a searched statement hits exactly one row
+			m_rowCount = (SQLLEN)(m_parsed.m_hasWhere ? m_processedParamsets : tableRows);
+			return m_rowCount == 0 ? SQL_NO_DATA : SQL_SUCCESS;
+		default:
+			m_rowCount = -1;
+			return SQL_SUCCESS;
+		}
+	}
+
+
+	SQLRETURN Statement::ReadParameters()
+	{
+		SQLULEN paramsetSize = max(m_apd.m_arraySize, (SQLULEN)1);
+		vector<const DescRecord*> records;
+		for (SQLUSMALLINT paramNr = 1; paramNr <= m_parsed.m_parameterColumns.size(); ++paramNr)
+		{
+			auto it = m_apd.m_records.find(paramNr);
+			if (it == m_apd.m_records.end() || !it->second.IsBound())
+			{
+				return AddDiag("07002", "COUNT field incorrect: Parameter " + to_string(paramNr) + " is not bound");
+			}
+			records.push_back(&it->second);
+		}
+
+		// Read all values, like a driver sending them to the database would
+		m_processedParamsets = 0;
+		size_t checksum = 0;
+		for (SQLULEN row = 0; row < paramsetSize; ++row)
+		{
+			SQLUSMALLINT status = SQL_PARAM_SUCCESS;
+			if (m_apd.m_pArrayStatus && m_apd.m_pArrayStatus[row] == SQL_PARAM_IGNORE)
+			{
+				status = SQL_PARAM_UNUSED;
+			}
+			else
+			{
+				for (const DescRecord* pRecord : records)
+				{
+					SQLSMALLINT cType = pRecord->m_conciseType == SQL_C_DEFAULT ? GetDefaultCType(pRecord->m_sqlType) : pRecord->m_conciseType;
+					SQLLEN elementSize = GetCTypeSize(cType);
+					SQLLEN* pIndicator = (SQLLEN*)m_apd.GetElement(pRecord->m_pIndicator, row, sizeof(SQLLEN));
+					SQLLEN* pLength = (SQLLEN*)m_apd.GetElement(pRecord->m_pOctetLength, row, sizeof(SQLLEN));
+					SQLLEN length = pLength ? *pLength : (elementSize > 0 ? elementSize : SQL_NTS);
+					if (pIndicator && *pIndicator == SQL_NULL_DATA)
+					{
+						length = SQL_NULL_DATA;
+					}
+					else if (length == SQL_DATA_AT_EXEC || length <= SQL_LEN_DATA_AT_EXEC_OFFSET)
+					{
+						return AddDiag("HYC00", "Optional feature not implemented: Data at execution parameters are not supported");
+					}
+					Value value = ReadValue(cType, m_apd.GetElement(pRecord->m_pData, row, elementSize > 0 ? elementSize : pRecord->m_octetLength), length);
+					checksum += value.m_bytes.length() + (size_t)value.m_integer;
+				}
+				++m_processedParamsets;
+			}
+			if (m_ipd.m_pArrayStatus)
+			{
+				m_ipd.m_pArrayStatus[row] = status;
+			}
+		}
+		if (m_ipd.m_pRowsProcessed)
+		{
+			*m_ipd.m_pRowsProcessed = paramsetSize;
+		}
+		m_checksum = checksum;
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::SetCatalogResult(ResultSetPtr pResult)
+	{
+		CloseCursor(false);
+		m_prepared = false;
+		m_pTable = NULL;
+		m_projection.clear();
+		m_resultColumns = pResult->GetColumns();
+		m_rowCount = (SQLLEN)pResult->GetRowCount();
+		m_pResult = move(pResult);
+		m_cursorRow = -1;
+		m_lastRowsetSize = 0;
+		SimulateLatency(m_dbc.m_config.m_catalogLatency);
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::Fetch(SQLSMALLINT orientation, SQLLEN offset)
+	{
+		if (!m_pResult)
+		{
+			return AddDiag("24000", "Invalid cursor state: No cursor is open");
+		}
+		if (orientation != SQL_FETCH_NEXT && m_cursorType == SQL_CURSOR_FORWARD_ONLY)
+		{
+			return AddDiag("HY106", "Fetch type out of range: The cursor is forward only");
+		}
+
+		SQLLEN rowCount = (SQLLEN)m_pResult->GetRowCount();
+		SQLLEN rowsetSize = (SQLLEN)max(m_ard.m_arraySize, (SQLULEN)1);
+		SQLLEN start = 0;
+		switch (orientation)
+		{
+		case SQL_FETCH_NEXT:
+			start = m_cursorRow < 0 ? 0 : m_cursorRow + m_lastRowsetSize;
+			break;
+		case SQL_FETCH_PRIOR:
+			start = m_cursorRow < 0 ? -1 : (m_cursorRow > 0 && m_cursorRow < rowsetSize ? 0 : min(m_cursorRow, rowCount) - rowsetSize);
+			break;
+		case SQL_FETCH_FIRST:
+			start = 0;
+			break;
+		case SQL_FETCH_LAST:
+			start = max(rowCount - rowsetSize, (SQLLEN)0);
+			break;
+		case SQL_FETCH_ABSOLUTE:
+			start = offset > 0 ? offset - 1 : (offset < 0 ? max(rowCount + offset, (SQLLEN)0) : -1);
+			break;
+		case SQL_FETCH_RELATIVE:
+			start = (m_cursorRow < 0 ? -1 : m_cursorRow) + offset;
+			break;
+		default:
+			return AddDiag("HY106", "Fetch type out of range: " + to_string(orientation));
+		}
+
+		m_getDataColumn = 0;
+		m_getDataOffset = 0;
+		if (start < 0 || start >= rowCount)
+		{
+			m_cursorRow = start < 0 ? -1 : rowCount;
+			m_lastRowsetSize = 0;
+			if (m_ird.m_pRowsProcessed)
+			{
+				*m_ird.m_pRowsProcessed = 0;
+			}
+			return SQL_NO_DATA;
+		}
+		return FetchRowset(start);
+	}
+
+
+	SQLRETURN Statement::FetchRowset(SQLLEN start)
+	{
+		const vector<ColumnDef>& columns = m_pResult->GetColumns();
+		SQLULEN rowsetSize = max(m_ard.m_arraySize, (SQLULEN)1);
+		SQLULEN count = min(rowsetSize, m_pResult->GetRowCount() - (SQLULEN)start);
+		m_cursorRow = start;
+		m_lastRowsetSize = (SQLLEN)rowsetSize;
+
+		auto hint = m_parsed.m_hints.find("ROWLATENCY");
+		chrono::microseconds rowLatency = hint != m_parsed.m_hints.end() ? chrono::microseconds(stoll(hint->second)) : m_dbc.m_config.m_rowLatency;
+		hint = m_parsed.m_hints.find("FETCHLATENCY");
+		chrono::microseconds fetchLatency = hint != m_parsed.m_hints.end() ? chrono::microseconds(stoll(hint->second)) : m_dbc.m_config.m_fetchLatency;
+		SimulateLatency(fetchLatency + rowLatency * (long long)count);
+
+		bool hasInfo = false;
+		bool hasError = false;
+		for (SQLULEN row = 0; row < rowsetSize; ++row)
+		{
+			SQLUSMALLINT status = SQL_ROW_NOROW;
+			if (row < count)
+			{
+				status = SQL_ROW_SUCCESS;
+				for (auto it = m_ard.m_records.begin(); it != m_ard.m_records.end(); ++it)
+				{
+					const DescRecord& record = it->second;
+					if (!record.IsBound() || it->first == 0 || it->first > columns.size())
+					{
+						continue;
+					}
+					const ColumnDef& column = columns[it->first - 1];
+					SQLSMALLINT cType = record.m_conciseType == SQL_C_DEFAULT ? GetDefaultCType(column.m_sqlType) : record.m_conciseType;
+					SQLLEN elementSize = GetCTypeSize(cType);
+					SQLLEN offset = 0;
+					SQLRETURN ret = WriteValue(*this, m_pResult->GetValue((SQLULEN)start + row, it->first - 1), column.m_sqlType, cType, record.m_precision, record.m_scale,
+						m_ard.GetElement(record.m_pData, row, elementSize > 0 ? elementSize : record.m_octetLength), record.m_octetLength,
+						(SQLLEN*)m_ard.GetElement(record.m_pOctetLength, row, sizeof(SQLLEN)), (SQLLEN*)m_ard.GetElement(record.m_pIndicator, row, sizeof(SQLLEN)), offset);
+					if (ret == SQL_ERROR)
+					{
+						status = SQL_ROW_ERROR;
+						hasError = true;
+					}
+					else if (ret == SQL_SUCCESS_WITH_INFO && status != SQL_ROW_ERROR)
+					{
+						status = SQL_ROW_SUCCESS_WITH_INFO;
+						hasInfo = true;
+					}
+				}
+			}
+			if (m_ird.m_pArrayStatus)
+			{
+				m_ird.m_pArrayStatus[row] = status;
+			}
+		}
+		if (m_ird.m_pRowsProcessed)
+		{
+			*m_ird.m_pRowsProcessed = count;
+		}
+
+		if (hasError)
+		{
+			return rowsetSize == 1 ? SQL_ERROR : SQL_SUCCESS_WITH_INFO;
+		}
+		return hasInfo ? SQL_SUCCESS_WITH_INFO : SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::GetData(SQLUSMALLINT columnNr, SQLSMALLINT cType, SQLPOINTER pTarget, SQLLEN bufferLength, SQLLEN* pStrLenOrInd)
+	{
+		if (!m_pResult || m_cursorRow < 0 || (SQLULEN)m_cursorRow >= m_pResult->GetRowCount())
+		{
+			return AddDiag("24000", "Invalid cursor state: The cursor is not positioned on a row");
+		}
+		const vector<ColumnDef>& columns = m_pResult->GetColumns();
+		if (columnNr == 0 || columnNr > columns.size())
+		{
+			return AddDiag("07009", "Invalid descriptor index: " + to_string(columnNr));
+		}
+		if (columnNr != m_getDataColumn)
+		{
+			m_getDataColumn = columnNr;
+			m_getDataOffset = 0;
+		}
+
+		const ColumnDef& column = columns[columnNr - 1];
+		SQLSMALLINT precision = 0;
+		SQLSMALLINT scale = 0;
+		if (cType == SQL_ARD_TYPE)
+		{
+			const DescRecord& record = m_ard.m_records[columnNr];
+			cType = record.m_conciseType;
+			precision = record.m_precision;
+			scale = record.m_scale;
+		}
+		else if (cType == SQL_C_NUMERIC)
+		{
+			// Default precision and scale of SQL_C_NUMERIC are driver-defined: Use the ones of the column
+			precision = (SQLSMALLINT)column.m_columnSize;
+			scale = column.m_decimalDigits;
+		}
+		return WriteValue(*this, m_pResult->GetValue((SQLULEN)m_cursorRow, columnNr - 1), column.m_sqlType, cType, precision, scale,
+			pTarget, bufferLength, pStrLenOrInd, pStrLenOrInd, m_getDataOffset);
+	}
+
+
+	SQLRETURN Statement::SetAttribute(SQLINTEGER attribute, SQLPOINTER value)
+	{
+		SQLULEN number = (SQLULEN)value;
+		switch (attribute)
+		{
+		case SQL_ATTR_ROW_ARRAY_SIZE:
+		case SQL_ROWSET_SIZE:
+			if (number == 0)
+			{
+				return AddDiag("HY024", "Invalid attribute value: The row array size must not be 0");
+			}
+			m_ard.m_arraySize = number;
+			break;
+		case SQL_ATTR_ROW_BIND_TYPE:
+			m_ard.m_bindType = number;
+			break;
+		case SQL_ATTR_ROW_BIND_OFFSET_PTR:
+			m_ard.m_pBindOffset = (SQLLEN*)value;
+			break;
+		case SQL_ATTR_ROW_OPERATION_PTR:
+			m_ard.m_pArrayStatus = (SQLUSMALLINT*)value;
+			break;
+		case SQL_ATTR_ROW_STATUS_PTR:
+			m_ird.m_pArrayStatus = (SQLUSMALLINT*)value;
+			break;
+		case SQL_ATTR_ROWS_FETCHED_PTR:
+			m_ird.m_pRowsProcessed = (SQLULEN*)value;
+			break;
+		case SQL_ATTR_PARAMSET_SIZE:
+			if (number == 0)
+			{
+				return AddDiag("HY024", "Invalid attribute value: The paramset size must not be 0");
+			}
+			m_apd.m_arraySize = number;
+			break;
+		case SQL_ATTR_PARAM_BIND_TYPE:
+			m_apd.m_bindType = number;
+			break;
+		case SQL_ATTR_PARAM_BIND_OFFSET_PTR:
+			m_apd.m_pBindOffset = (SQLLEN*)value;
+			break;
+		case SQL_ATTR_PARAM_OPERATION_PTR:
+			m_apd.m_pArrayStatus = (SQLUSMALLINT*)value;
+			break;
+		case SQL_ATTR_PARAM_STATUS_PTR:
+			m_ipd.m_pArrayStatus = (SQLUSMALLINT*)value;
+			break;
+		case SQL_ATTR_PARAMS_PROCESSED_PTR:
+			m_ipd.m_pRowsProcessed = (SQLULEN*)value;
+			break;
+		case SQL_ATTR_CURSOR_TYPE:
+			if (m_pResult)
+			{
+				return AddDiag("24000", "Invalid cursor state: Cannot change the cursor type while a cursor is open");
+			}
+			if (number == SQL_CURSOR_KEYSET_DRIVEN || number == SQL_CURSOR_DYNAMIC)
+			{
+				m_cursorType = SQL_CURSOR_STATIC;
+				return AddDiag("01S02", "Option value changed: Only forward only and static cursors are supported, using a static cursor", SQL_SUCCESS_WITH_INFO);
+			}
+			m_cursorType = number;
+			break;
+		case SQL_ATTR_CURSOR_SCROLLABLE:
+			m_cursorType = number == SQL_SCROLLABLE ? SQL_CURSOR_STATIC : SQL_CURSOR_FORWARD_ONLY;
+			break;
+		case SQL_ATTR_CONCURRENCY:
+			m_concurrency = number;
+			break;
+		case SQL_ATTR_MAX_ROWS:
+			m_maxRows = number;
+			break;
+		case SQL_ATTR_APP_ROW_DESC:
+		case SQL_ATTR_APP_PARAM_DESC:
+			if (value != NULL && value != &m_ard && value != &m_apd)
+			{
+				return AddDiag("HYC00", "Optional feature not implemented: Explicitly allocated descriptors are not supported");
+			}
+			break;
+		case SQL_ATTR_IMP_ROW_DESC:
+		case SQL_ATTR_IMP_PARAM_DESC:
+			return AddDiag("HY017", "Invalid use of an automatically allocated descriptor handle");
+		default:
+			m_attributes[attribute] = number;
+			break;
+		}
+		return SQL_SUCCESS;
+	}
+
+
+	SQLRETURN Statement::GetAttribute(SQLINTEGER attribute, SQLPOINTER value)
+	{
+		if (value == NULL)
+		{
+			return AddDiag("HY009", "Invalid use of null pointer");
+		}
+		switch (attribute)
+		{
+		case SQL_ATTR_APP_ROW_DESC:
+			*(SQLHDESC*)value = &m_ard;
+			break;
+		case SQL_ATTR_APP_PARAM_DESC:
+			*(SQLHDESC*)value = &m_apd;
+			break;
+		case SQL_ATTR_IMP_ROW_DESC:
+			*(SQLHDESC*)value = &m_ird;
+			break;
+		case SQL_ATTR_IMP_PARAM_DESC:
+			*(SQLHDESC*)value = &m_ipd;
+			break;
+		case SQL_ATTR_ROW_ARRAY_SIZE:
+		case SQL_ROWSET_SIZE:
+			*(SQLULEN*)value = m_ard.m_arraySize;
+			break;
+		case SQL_ATTR_ROW_BIND_TYPE:
+			*(SQLULEN*)value = m_ard.m_bindType;
+			break;
+		case SQL_ATTR_ROW_BIND_OFFSET_PTR:
+			*(SQLLEN**)value = m_ard.m_pBindOffset;
+			break;
+		case SQL_ATTR_ROW_OPERATION_PTR:
+			*(SQLUSMALLINT**)value = m_ard.m_pArrayStatus;
+			break;
+		case SQL_ATTR_ROW_STATUS_PTR:
+			*(SQLUSMALLINT**)value = m_ird.m_pArrayStatus;
+			break;
+		case SQL_ATTR_ROWS_FETCHED_PTR:
+			*(SQLULEN**)value = m_ird.m_pRowsProcessed;
+			break;
+		case SQL_ATTR_PARAMSET_SIZE:
+			*(SQLULEN*)value = m_apd.m_arraySize;
+			break;
+		case SQL_ATTR_PARAM_BIND_TYPE:
+			*(SQLULEN*)value = m_apd.m_bindType;
+			break;
+		case SQL_ATTR_PARAM_BIND_OFFSET_PTR:
+			*(SQLLEN**)value = m_apd.m_pBindOffset;
+			break;
+		case SQL_ATTR_PARAM_OPERATION_PTR:
+			*(SQLUSMALLINT**)value = m_apd.m_pArrayStatus;
+			break;
+		case SQL_ATTR_PARAM_STATUS_PTR:
+			*(SQLUSMALLINT**)value = m_ipd.m_pArrayStatus;
+			break;
+		case SQL_ATTR_PARAMS_PROCESSED_PTR:
+			*(SQLULEN**)value = m_ipd.m_pRowsProcessed;
+			break;
+		case SQL_ATTR_CURSOR_TYPE:
+			*(SQLULEN*)value = m_cursorType;
+			break;
+		case SQL_ATTR_CURSOR_SCROLLABLE:
+			*(SQLULEN*)value = m_cursorType == SQL_CURSOR_FORWARD_ONLY ? SQL_NONSCROLLABLE : SQL_SCROLLABLE;
+			break;
+		case SQL_ATTR_CONCURRENCY:
+			*(SQLULEN*)value = m_concurrency;
+			break;
+		case SQL_ATTR_MAX_ROWS:
+			*(SQLULEN*)value = m_maxRows;
+			break;
+		case SQL_ATTR_ROW_NUMBER:
+			*(SQLULEN*)value = m_cursorRow < 0 ? 0 : (SQLULEN)m_cursorRow + 1;
+			break;
+		default:
+		{
+			auto it = m_attributes.find(attribute);
+			*(SQLULEN*)value = it == m_attributes.end() ? 0 : it->second;
+			break;
+		}
+		}
+		return SQL_SUCCESS;
+	}
+
+
+	ColumnDef Statement::DescribeParameter(SQLUSMALLINT paramNr) const
+	{
+		ColumnDef unknown("", SQL_VARCHAR, 255, 0, true);
+		if (paramNr == 0 || paramNr > m_parsed.m_parameterColumns.size() || m_pTable == NULL)
+		{
+			return unknown;
+		}
+		const string& name = m_parsed.m_parameterColumns[paramNr - 1];
+		int index = -1;
+		if (!name.empty() && name[0] == '#')
+		{
+			index = stoi(name.substr(1));
+			index = index < (int)m_pTable->m_columns.size() ? index : -1;
+		}
+		else if (!name.empty())
+		{
+			index = m_pTable->FindColumn(name);
+		}
+		return index >= 0 ? m_pTable->m_columns[index] : unknown;
+	}
+}
@@ -0,0 +1,860 @@
+﻿/*!
+* \file MockValues.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for generating values and converting them to C types in the exodbcmock driver.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "MockDriver.h"
+
+// Same component headers
+// Other headers
+// System headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <limits>
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbcmock
+{
+	namespace
+	{
+		// Characters cycled through by the text of wide character columns, in UTF-8
+		const char* const WIDE_PATTERN[] = { u8"ä", u8"ö", u8"ü", u8"€", u8"中", "x" };
+		const size_t WIDE_PATTERN_LENGTH = sizeof(WIDE_PATTERN) / sizeof(WIDE_PATTERN[0]);
+
+		// Values of long columns are limited to this size, in characters or bytes
+		const SQLULEN MAX_GENERATED_LENGTH = 4096;
+
+		const long long POW10[] = {
+			1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+			10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+			1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+		};
+		const SQLSMALLINT MAX_DIGITS = 18;
+
+
+		// Date of the days since 2000-01-01, see http://howardhinnant.github.io/date_algorithms.html
+		void SetDate(long long days, SQL_TIMESTAMP_STRUCT& ts) noexcept
+		{
+			long long z = days + 730425;
+			long long era = (z >= 0 ? z : z - 146096) / 146097;
+			long long doe = z - era * 146097;
+			long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+			long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+			long long mp = (5 * doy + 2) / 153;
+			long long d = doy - (153 * mp + 2) / 5 + 1;
+			long long m = mp < 10 ? mp + 3 : mp - 9;
+			ts.year = (SQLSMALLINT)(yoe + era * 400 + (m <= 2 ? 1 : 0));
+			ts.month = (SQLUSMALLINT)m;
+			ts.day = (SQLUSMALLINT)d;
+		}
+
+
+		void SetTime(long long seconds, SQL_TIMESTAMP_STRUCT& ts) noexcept
+		{
+			ts.hour = (SQLUSMALLINT)(seconds / 3600);
+			ts.minute = (SQLUSMALLINT)(seconds / 60 % 60);
+			ts.second = (SQLUSMALLINT)(seconds % 60);
+		}
+
+
+		bool IsWide(SQLSMALLINT sqlType) noexcept
+		{
+			return sqlType == SQL_WCHAR || sqlType == SQL_WVARCHAR || sqlType == SQL_WLONGVARCHAR;
+		}
+
+
+		std::u16string Utf8ToUtf16(const string& s)
+		{
+			u16string result;
+			result.reserve(s.length());
+			for (size_t i = 0; i < s.length();)
+			{
+				unsigned char c = (unsigned char)s[i];
+				char32_t cp;
+				size_t n;
+				if (c < 0x80) { cp = c; n = 1; }
+				else if ((c & 0xe0) == 0xc0) { cp = c & 0x1f; n = 2; }
+				else if ((c & 0xf0) == 0xe0) { cp = c & 0x0f; n = 3; }
+				else { cp = c & 0x07; n = 4; }
+				for (size_t k = 1; k < n && i + k < s.length(); ++k)
+				{
+					cp = (cp << 6) | ((unsigned char)s[i + k] & 0x3f);
+				}
+				i += n;
+				if (cp >= 0x10000)
+				{
+					cp -= 0x10000;
+					result.push_back((char16_t)(0xd800 + (cp >> 10)));
+					result.push_back((char16_t)(0xdc00 + (cp & 0x3ff)));
+				}
+				else
+				{
+					result.push_back((char16_t)cp);
+				}
+			}
+			return result;
+		}
+
+
+		string Utf16ToUtf8(const SQLWCHAR* p, size_t length)
+		{
+			string result;
+			result.reserve(length);
+			for (size_t i = 0; i < length; ++i)
+			{
+				char32_t cp = (char32_t)p[i];
+				if (cp >= 0xd800 && cp < 0xdc00 && i + 1 < length)
+				{
+					cp = 0x10000 + ((cp - 0xd800) << 10) + ((char32_t)p[++i] - 0xdc00);
+				}
+				if (cp < 0x80)
+				{
+					result += (char)cp;
+				}
+				else if (cp < 0x800)
+				{
+					result += (char)(0xc0 | (cp >> 6));
+					result += (char)(0x80 | (cp & 0x3f));
+				}
+				else if (cp < 0x10000)
+				{
+					result += (char)(0xe0 | (cp >> 12));
+					result += (char)(0x80 | ((cp >> 6) & 0x3f));
+					result += (char)(0x80 | (cp & 0x3f));
+				}
+				else
+				{
+					result += (char)(0xf0 | (cp >> 18));
+					result += (char)(0x80 | ((cp >> 12) & 0x3f));
+					result += (char)(0x80 | ((cp >> 6) & 0x3f));
+					result += (char)(0x80 | (cp & 0x3f));
+				}
+			}
+			return result;
+		}
+
+
+		string FormatNumeric(long long unscaled, SQLSMALLINT scale)
+		{
+			string digits = to_string(unscaled < 0 ? -(unscaled + 1) + 1ULL : (unsigned long long)unscaled);
+			if (scale > 0)
+			{
+				if (digits.length() <= (size_t)scale)
+				{
+					digits.insert(0, scale - digits.length() + 1, '0');
+				}
+				digits.insert(digits.length() - scale, 1, '.');
+			}
+			return unscaled < 0 ? "-" + digits : digits;
+		}
+
+
+		/*!
+		* \brief	Format value the way it is returned as SQL_C_CHAR or SQL_C_WCHAR.
+		*/
+		string FormatText(const Value& value)
+		{
+			char buffer[64];
+			const SQL_TIMESTAMP_STRUCT& ts = value.m_timestamp;
+			switch (value.m_kind)
+			{
+			case Value::Kind::Integer:
+				return to_string(value.m_integer);
+			case Value::Kind::Real:
+				snprintf(buffer, sizeof(buffer), "%.15g", value.m_real);
+				return buffer;
+			case Value::Kind::Numeric:
+				return FormatNumeric(value.m_integer, value.m_scale);
+			case Value::Kind::Date:
+				snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", ts.year, ts.month, ts.day);
+				return buffer;
+			case Value::Kind::Time:
+				snprintf(buffer, sizeof(buffer), "%02u:%02u:%02u", ts.hour, ts.minute, ts.second);
+				return buffer;
+			case Value::Kind::Timestamp:
+				snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02u:%02u:%02u", ts.year, ts.month, ts.day, ts.hour, ts.minute, ts.second);
+				if (ts.fraction > 0)
+				{
+					snprintf(buffer + strlen(buffer), sizeof(buffer) - strlen(buffer), ".%03u", (unsigned)(ts.fraction / 1000000));
+				}
+				return buffer;
+			case Value::Kind::Binary:
+			{
+				static const char* const HEX = "0123456789ABCDEF";
+				string hex;
+				for (unsigned char c : value.m_bytes)
+				{
+					hex += HEX[c >> 4];
+					hex += HEX[c & 0x0f];
+				}
+				return hex;
+			}
+			default:
+				return value.m_bytes;
+			}
+		}
+
+
+		/*!
+		* \brief	Get value as unscaled number with scale decimal digits. Returns false if
+		*			value is not a number, sets truncated if digits were lost.
+		*/
+		bool GetUnscaled(const Value& value, SQLSMALLINT scale, long long& unscaled, bool& truncated)
+		{
+			truncated = false;
+			scale = min(scale, MAX_DIGITS);
+			switch (value.m_kind)
+			{
+			case Value::Kind::Integer:
+				unscaled = value.m_integer * POW10[scale];
+				return true;
+			case Value::Kind::Numeric:
+				if (value.m_scale <= scale)
+				{
+					unscaled = value.m_integer * POW10[scale - value.m_scale];
+				}
+				else
+				{
+					long long divisor = POW10[min((SQLSMALLINT)(value.m_scale - scale), MAX_DIGITS)];
+					unscaled = value.m_integer / divisor;
+					truncated = value.m_integer % divisor != 0;
+				}
+				return true;
+			case Value::Kind::Real:
+			{
+				double scaled = value.m_real * (double)POW10[scale];
+				unscaled = (long long)scaled;
+				truncated = (double)unscaled != scaled;
+				return true;
+			}
+			case Value::Kind::Text:
+			{
+				const string& s = value.m_bytes;
+				size_t pos = s.find_first_not_of(' ');
+				bool negative = false;
+				if (pos != string::npos && (s[pos] == '-' || s[pos] == '+'))
+				{
+					negative = s[pos] == '-';
+					++pos;
+				}
+				bool hasDigits = false;
+				SQLSMALLINT fractionDigits = -1;
+				unscaled = 0;
+				for (; pos < s.length() && s[pos] != ' '; ++pos)
+				{
+					if (s[pos] == '.' && fractionDigits < 0)
+					{
+						fractionDigits = 0;
+						continue;
+					}
+					if (!isdigit((unsigned char)s[pos]))
+					{
+						return false;
+					}
+					hasDigits = true;
+					if (fractionDigits >= 0 && fractionDigits >= scale)
+					{
+						truncated |= s[pos] != '0';
+						continue;
+					}
+					unscaled = unscaled * 10 + (s[pos] - '0');
+					if (fractionDigits >= 0)
+					{
+						++fractionDigits;
+					}
+				}
+				if (!hasDigits || s.find_first_not_of(' ', pos) != string::npos)
+				{
+					return false;
+				}
+				unscaled *= POW10[scale - max(fractionDigits, (SQLSMALLINT)0)];
+				unscaled = negative ? -unscaled : unscaled;
+				return true;
+			}
+			default:
+				return false;
+			}
+		}
+
+
+		/*!
+		* \brief	Write bytes starting at offset to pTarget, with a terminating 0 of terminatorSize bytes.
+		*/
+		SQLRETURN WriteBytes(Handle& diag, const char* pBytes, SQLLEN length, size_t terminatorSize, SQLPOINTER pTarget, SQLLEN bufferLength,
+			SQLLEN* pOctetLength, SQLLEN* pIndicator, SQLLEN& offset)
+		{
+			SQLLEN remaining = length - offset;
+			if (pOctetLength)
+			{
+				*pOctetLength = remaining;
+			}
+			if (pIndicator && pIndicator != pOctetLength)
+			{
+				*pIndicator = 0;
+			}
+			if (pTarget == NULL)
+			{
+				return SQL_SUCCESS;
+			}
+
+			SQLLEN available = bufferLength - (SQLLEN)terminatorSize;
+			if (available < 0)
+			{
+				return diag.AddDiag("01004", "String data, right truncated: Buffer too small", SQL_SUCCESS_WITH_INFO);
+			}
+			// Do not split a character of a wide string
+			available -= available % (SQLLEN)max(terminatorSize, (size_t)1);
+			SQLLEN count = min(remaining, available);
+			memcpy(pTarget, pBytes + offset, count);
+			memset((char*)pTarget + count, 0, terminatorSize);
+			if (count < remaining)
+			{
+				offset += count;
+				return diag.AddDiag("01004", "String data, right truncated", SQL_SUCCESS_WITH_INFO);
+			}
+			offset = -1;
+			return SQL_SUCCESS;
+		}
+
+
+		template<typename T>
+		SQLRETURN WriteFixed(const T& value, SQLPOINTER pTarget, SQLLEN* pOctetLength, SQLLEN* pIndicator, SQLLEN& offset)
+		{
+			if (pTarget)
+			{
+				memcpy(pTarget, &value, sizeof(T));
+			}
+			if (pOctetLength)
+			{
+				*pOctetLength = sizeof(T);
+			}
+			if (pIndicator && pIndicator != pOctetLength)
+			{
+				*pIndicator = 0;
+			}
+			offset = -1;
+			return SQL_SUCCESS;
+		}
+
+
+		template<typename T>
+		SQLRETURN WriteInteger(Handle& diag, const Value& value, SQLPOINTER pTarget, SQLLEN* pOctetLength, SQLLEN* pIndicator, SQLLEN& offset)
+		{
+			long long unscaled = 0;
+			bool truncated = false;
+			if (!GetUnscaled(value, 0, unscaled, truncated))
+			{
+				return value.m_kind == Value::Kind::Text
+					? diag.AddDiag("22018", "Invalid character value for cast specification: '" + value.m_bytes + "'")
+					: diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to an integer type");
+			}
+			if ((numeric_limits<T>::is_signed && (unscaled < (long long)numeric_limits<T>::min() || unscaled >(long long)numeric_limits<T>::max()))
+				|| (!numeric_limits<T>::is_signed && (unscaled < 0 || (unsigned long long)unscaled >(unsigned long long)numeric_limits<T>::max())))
+			{
+				return diag.AddDiag("22003", "Numeric value out of range: " + to_string(unscaled));
+			}
+			SQLRETURN ret = WriteFixed((T)unscaled, pTarget, pOctetLength, pIndicator, offset);
+			return truncated ? diag.AddDiag("01S07", "Fractional truncation", SQL_SUCCESS_WITH_INFO) : ret;
+		}
+
+
+		SQLRETURN WriteDouble(Handle& diag, const Value& value, double& result)
+		{
+			switch (value.m_kind)
+			{
+			case Value::Kind::Integer:
+				result = (double)value.m_integer;
+				return SQL_SUCCESS;
+			case Value::Kind::Real:
+				result = value.m_real;
+				return SQL_SUCCESS;
+			case Value::Kind::Numeric:
+				result = (double)value.m_integer / (double)POW10[min(value.m_scale, MAX_DIGITS)];
+				return SQL_SUCCESS;
+			case Value::Kind::Text:
+			{
+				char* pEnd = NULL;
+				result = strtod(value.m_bytes.c_str(), &pEnd);
+				if (pEnd == value.m_bytes.c_str())
+				{
+					return diag.AddDiag("22018", "Invalid character value for cast specification: '" + value.m_bytes + "'");
+				}
+				return SQL_SUCCESS;
+			}
+			default:
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to a floating point type");
+			}
+		}
+	}
+
+
+	// Value
+	// =====
+	Value Value::CreateInteger(long long value)
+	{
+		Value v;
+		v.m_kind = Kind::Integer;
+		v.m_integer = value;
+		return v;
+	}
+
+
+	Value Value::CreateReal(double value)
+	{
+		Value v;
+		v.m_kind = Kind::Real;
+		v.m_real = value;
+		return v;
+	}
+
+
+	Value Value::CreateNumeric(long long unscaled, SQLSMALLINT scale)
+	{
+		Value v;
+		v.m_kind = Kind::Numeric;
+		v.m_integer = unscaled;
+		v.m_scale = scale;
+		return v;
+	}
+
+
+	Value Value::CreateText(const std::string& value)
+	{
+		Value v;
+		v.m_kind = Kind::Text;
+		v.m_bytes = value;
+		return v;
+	}
+
+
+	Value Value::CreateBinary(const std::string& bytes)
+	{
+		Value v;
+		v.m_kind = Kind::Binary;
+		v.m_bytes = bytes;
+		return v;
+	}
+
+
+	Value Value::CreateTimestamp(Kind kind, const SQL_TIMESTAMP_STRUCT& timestamp)
+	{
+		Value v;
+		v.m_kind = kind;
+		v.m_timestamp = timestamp;
+		return v;
+	}
+
+
+	Value GenerateValue(const ColumnDef& column, size_t columnIndex, SQLULEN row, unsigned nullEvery)
+	{
+		if (nullEvery > 0 && column.m_nullable && !column.m_primaryKey && (row + 1) % nullEvery == 0)
+		{
+			return Value();
+		}
+
+		long long r = (long long)row;
+		long long c = (long long)columnIndex;
+		string rowText = "row" + to_string(row + 1);
+		switch (column.m_sqlType)
+		{
+		case SQL_SMALLINT:
+			return Value::CreateInteger(column.m_primaryKey ? (r % 32767) + 1 : (r * 31 + c) % 60000 - 30000);
+		case SQL_INTEGER:
+			return Value::CreateInteger(column.m_primaryKey ? r + 1 : (r * 7919 + c) % 2000000000 - 1000000000);
+		case SQL_BIGINT:
+			return Value::CreateInteger(column.m_primaryKey ? r + 1 : r * 1000003 + c - 500000);
+		case SQL_REAL:
+			return Value::CreateReal((double)((r + c) % 100000) * 0.25);
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return Value::CreateReal((double)(r * 3 + c) * 0.5 - 1000.125);
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+		{
+			SQLSMALLINT precision = min((SQLSMALLINT)column.m_columnSize, MAX_DIGITS);
+			long long unscaled = column.m_primaryKey ? (r + 1) * POW10[min(column.m_decimalDigits, precision)] : (r * 1000003 + c * 17) % POW10[precision];
+			return Value::CreateNumeric((row % 2 == 1 && !column.m_primaryKey) ? -unscaled : unscaled, column.m_decimalDigits);
+		}
+		case SQL_CHAR:
+		case SQL_WCHAR:
+		{
+			string text = rowText.substr(0, column.m_columnSize);
+			text.append(min(column.m_columnSize, MAX_GENERATED_LENGTH) - text.length(), ' ');
+			return Value::CreateText(text);
+		}
+		case SQL_VARCHAR:
+		case SQL_LONGVARCHAR:
+		case SQL_WVARCHAR:
+		case SQL_WLONGVARCHAR:
+		{
+			SQLULEN length = min(max(column.m_columnSize / 2, (SQLULEN)rowText.length()), min(column.m_columnSize, MAX_GENERATED_LENGTH));
+			string text = rowText.substr(0, length);
+			bool wide = IsWide(column.m_sqlType);
+			for (SQLULEN i = text.length(); i < length; ++i)
+			{
+				text += wide ? WIDE_PATTERN[(row + i) % WIDE_PATTERN_LENGTH] : string(1, (char)('a' + (row + i) % 26));
+			}
+			return Value::CreateText(text);
+		}
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+		case SQL_LONGVARBINARY:
+		{
+			SQLULEN length = column.m_sqlType == SQL_BINARY ? column.m_columnSize : max(column.m_columnSize / 2, (SQLULEN)1);
+			string bytes(min(length, MAX_GENERATED_LENGTH), '\0');
+			for (size_t i = 0; i < bytes.length(); ++i)
+			{
+				bytes[i] = (char)((row + i) & 0xff);
+			}
+			return Value::CreateBinary(bytes);
+		}
+		case SQL_TYPE_DATE:
+		case SQL_DATE:
+		{
+			SQL_TIMESTAMP_STRUCT ts = {};
+			SetDate(r, ts);
+			return Value::CreateTimestamp(Value::Kind::Date, ts);
+		}
+		case SQL_TYPE_TIME:
+		case SQL_TIME:
+		{
+			SQL_TIMESTAMP_STRUCT ts = {};
+			SetTime((r * 61 + c) % 86400, ts);
+			return Value::CreateTimestamp(Value::Kind::Time, ts);
+		}
+		case SQL_TYPE_TIMESTAMP:
+		case SQL_TIMESTAMP:
+		{
+			SQL_TIMESTAMP_STRUCT ts = {};
+			long long seconds = r * 3661 + c;
+			SetDate(seconds / 86400, ts);
+			SetTime(seconds % 86400, ts);
+			ts.fraction = column.m_decimalDigits > 0 ? (SQLUINTEGER)((r % 1000) * 1000000) : 0;
+			return Value::CreateTimestamp(Value::Kind::Timestamp, ts);
+		}
+		default:
+			return Value::CreateText(rowText);
+		}
+	}
+
+
+	SQLSMALLINT GetDefaultCType(SQLSMALLINT sqlType) noexcept
+	{
+		switch (sqlType)
+		{
+		case SQL_SMALLINT:
+			return SQL_C_SSHORT;
+		case SQL_INTEGER:
+			return SQL_C_SLONG;
+		case SQL_BIGINT:
+			return SQL_C_SBIGINT;
+		case SQL_REAL:
+			return SQL_C_FLOAT;
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return SQL_C_DOUBLE;
+		case SQL_WCHAR:
+		case SQL_WVARCHAR:
+		case SQL_WLONGVARCHAR:
+			return SQL_C_WCHAR;
+		case SQL_BINARY:
+		case SQL_VARBINARY:
+		case SQL_LONGVARBINARY:
+			return SQL_C_BINARY;
+		case SQL_TYPE_DATE:
+		case SQL_DATE:
+			return SQL_C_TYPE_DATE;
+		case SQL_TYPE_TIME:
+		case SQL_TIME:
+			return SQL_C_TYPE_TIME;
+		case SQL_TYPE_TIMESTAMP:
+		case SQL_TIMESTAMP:
+			return SQL_C_TYPE_TIMESTAMP;
+		default:
+			return SQL_C_CHAR;
+		}
+	}
+
+
+	SQLLEN GetCTypeSize(SQLSMALLINT cType) noexcept
+	{
+		switch (cType)
+		{
+		case SQL_C_BIT:
+		case SQL_C_TINYINT:
+		case SQL_C_STINYINT:
+		case SQL_C_UTINYINT:
+			return sizeof(SQLCHAR);
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+		case SQL_C_USHORT:
+			return sizeof(SQLSMALLINT);
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+		case SQL_C_ULONG:
+			return sizeof(SQLINTEGER);
+		case SQL_C_SBIGINT:
+		case SQL_C_UBIGINT:
+			return sizeof(SQLBIGINT);
+		case SQL_C_FLOAT:
+			return sizeof(SQLREAL);
+		case SQL_C_DOUBLE:
+			return sizeof(SQLDOUBLE);
+		case SQL_C_NUMERIC:
+			return sizeof(SQL_NUMERIC_STRUCT);
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+			return sizeof(SQL_DATE_STRUCT);
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+			return sizeof(SQL_TIME_STRUCT);
+		case SQL_C_TIMESTAMP:
+		case SQL_C_TYPE_TIMESTAMP:
+			return sizeof(SQL_TIMESTAMP_STRUCT);
+		default:
+			return 0;
+		}
+	}
+
+
+	SQLRETURN WriteValue(Handle& diag, const Value& value, SQLSMALLINT sqlType, SQLSMALLINT cType, SQLSMALLINT precision, SQLSMALLINT scale,
+		SQLPOINTER pTarget, SQLLEN bufferLength, SQLLEN* pOctetLength, SQLLEN* pIndicator, SQLLEN& offset)
+	{
+		if (offset < 0)
+		{
+			return SQL_NO_DATA;
+		}
+		if (value.IsNull())
+		{
+			if (pIndicator == NULL)
+			{
+				return diag.AddDiag("22002", "Indicator variable required but not supplied");
+			}
+			*pIndicator = SQL_NULL_DATA;
+			offset = -1;
+			return SQL_SUCCESS;
+		}
+		if (cType == SQL_C_DEFAULT)
+		{
+			cType = GetDefaultCType(sqlType);
+		}
+
+		switch (cType)
+		{
+		case SQL_C_BIT:
+		case SQL_C_UTINYINT:
+			return WriteInteger<SQLCHAR>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_TINYINT:
+		case SQL_C_STINYINT:
+			return WriteInteger<SQLSCHAR>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+			return WriteInteger<SQLSMALLINT>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_USHORT:
+			return WriteInteger<SQLUSMALLINT>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+			return WriteInteger<SQLINTEGER>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_ULONG:
+			return WriteInteger<SQLUINTEGER>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_SBIGINT:
+			return WriteInteger<SQLBIGINT>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_UBIGINT:
+			return WriteInteger<SQLUBIGINT>(diag, value, pTarget, pOctetLength, pIndicator, offset);
+		case SQL_C_FLOAT:
+		case SQL_C_DOUBLE:
+		{
+			double d = 0.0;
+			SQLRETURN ret = WriteDouble(diag, value, d);
+			if (!SQL_SUCCEEDED(ret))
+			{
+				return ret;
+			}
+			return cType == SQL_C_FLOAT
+				? WriteFixed((SQLREAL)d, pTarget, pOctetLength, pIndicator, offset)
+				: WriteFixed((SQLDOUBLE)d, pTarget, pOctetLength, pIndicator, offset);
+		}
+		case SQL_C_NUMERIC:
+		{
+			if (precision <= 0)
+			{
+				precision = MAX_DIGITS;
+			}
+			long long unscaled = 0;
+			bool truncated = false;
+			if (!GetUnscaled(value, scale, unscaled, truncated))
+			{
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to SQL_C_NUMERIC");
+			}
+			unsigned long long magnitude = unscaled < 0 ? 0ULL - (unsigned long long)unscaled : (unsigned long long)unscaled;
+			if (precision < MAX_DIGITS && magnitude >= (unsigned long long)POW10[precision])
+			{
+				return diag.AddDiag("22003", "Numeric value out of range: " + FormatNumeric(unscaled, scale));
+			}
+			SQL_NUMERIC_STRUCT numeric = {};
+			numeric.precision = (SQLCHAR)precision;
+			numeric.scale = (SQLSCHAR)scale;
+			numeric.sign = unscaled < 0 ? 0 : 1;
+			for (size_t i = 0; i < sizeof(magnitude); ++i)
+			{
+				numeric.val[i] = (SQLCHAR)((magnitude >> (8 * i)) & 0xff);
+			}
+			SQLRETURN ret = WriteFixed(numeric, pTarget, pOctetLength, pIndicator, offset);
+			return truncated ? diag.AddDiag("01S07", "Fractional truncation", SQL_SUCCESS_WITH_INFO) : ret;
+		}
+		case SQL_C_CHAR:
+		{
+			string text = FormatText(value);
+			return WriteBytes(diag, text.data(), (SQLLEN)text.length(), sizeof(SQLCHAR), pTarget, bufferLength, pOctetLength, pIndicator, offset);
+		}
+		case SQL_C_WCHAR:
+		{
+			u16string text16 = Utf8ToUtf16(FormatText(value));
+			vector<SQLWCHAR> text(text16.begin(), text16.end());
+			return WriteBytes(diag, (const char*)text.data(), (SQLLEN)(text.size() * sizeof(SQLWCHAR)), sizeof(SQLWCHAR), pTarget, bufferLength, pOctetLength, pIndicator, offset);
+		}
+		case SQL_C_BINARY:
+			if (value.m_kind != Value::Kind::Binary && value.m_kind != Value::Kind::Text)
+			{
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to SQL_C_BINARY");
+			}
+			return WriteBytes(diag, value.m_bytes.data(), (SQLLEN)value.m_bytes.length(), 0, pTarget, bufferLength, pOctetLength, pIndicator, offset);
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+		{
+			if (value.m_kind != Value::Kind::Date && value.m_kind != Value::Kind::Timestamp)
+			{
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to SQL_C_TYPE_DATE");
+			}
+			SQL_DATE_STRUCT date = { value.m_timestamp.year, value.m_timestamp.month, value.m_timestamp.day };
+			return WriteFixed(date, pTarget, pOctetLength, pIndicator, offset);
+		}
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+		{
+			if (value.m_kind != Value::Kind::Time && value.m_kind != Value::Kind::Timestamp)
+			{
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to SQL_C_TYPE_TIME");
+			}
+			SQL_TIME_STRUCT time = { value.m_timestamp.hour, value.m_timestamp.minute, value.m_timestamp.second };
+			return WriteFixed(time, pTarget, pOctetLength, pIndicator, offset);
+		}
+		case SQL_C_TIMESTAMP:
+		case SQL_C_TYPE_TIMESTAMP:
+			if (value.m_kind != Value::Kind::Timestamp && value.m_kind != Value::Kind::Date)
+			{
+				return diag.AddDiag("07006", "Restricted data type attribute violation: Cannot convert value to SQL_C_TYPE_TIMESTAMP");
+			}
+			return WriteFixed(value.m_timestamp, pTarget, pOctetLength, pIndicator, offset);
+		default:
+			return diag.AddDiag("HYC00", "Optional feature not implemented: C type " + to_string(cType) + " is not supported");
+		}
+	}
+
+
+	Value ReadValue(SQLSMALLINT cType, const void* pValue, SQLLEN length)
+	{
+		if (pValue == NULL || length == SQL_NULL_DATA)
+		{
+			return Value();
+		}
+		switch (cType)
+		{
+		case SQL_C_BIT:
+		case SQL_C_UTINYINT:
+			return Value::CreateInteger(*(const SQLCHAR*)pValue);
+		case SQL_C_TINYINT:
+		case SQL_C_STINYINT:
+			return Value::CreateInteger(*(const SQLSCHAR*)pValue);
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+			return Value::CreateInteger(*(const SQLSMALLINT*)pValue);
+		case SQL_C_USHORT:
+			return Value::CreateInteger(*(const SQLUSMALLINT*)pValue);
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+			return Value::CreateInteger(*(const SQLINTEGER*)pValue);
+		case SQL_C_ULONG:
+			return Value::CreateInteger(*(const SQLUINTEGER*)pValue);
+		case SQL_C_SBIGINT:
+			return Value::CreateInteger(*(const SQLBIGINT*)pValue);
+		case SQL_C_UBIGINT:
+			return Value::CreateInteger((long long)*(const SQLUBIGINT*)pValue);
+		case SQL_C_FLOAT:
+			return Value::CreateReal(*(const SQLREAL*)pValue);
+		case SQL_C_DOUBLE:
+			return Value::CreateReal(*(const SQLDOUBLE*)pValue);
+		case SQL_C_NUMERIC:
+		{
+			const SQL_NUMERIC_STRUCT& numeric = *(const SQL_NUMERIC_STRUCT*)pValue;
+			unsigned long long magnitude = 0;
+			for (size_t i = 0; i < sizeof(magnitude); ++i)
+			{
+				magnitude |= (unsigned long long)numeric.val[i] << (8 * i);
+			}
+			long long unscaled = (long long)magnitude;
+			return Value::CreateNumeric(numeric.sign == 0 ? -unscaled : unscaled, numeric.scale);
+		}
+		case SQL_C_CHAR:
+		{
+			const char* p = (const char*)pValue;
+			return Value::CreateText(length == SQL_NTS ? string(p) : string(p, (size_t)length));
+		}
+		case SQL_C_WCHAR:
+		{
+			const SQLWCHAR* p = (const SQLWCHAR*)pValue;
+			size_t count = 0;
+			if (length == SQL_NTS)
+			{
+				while (p[count] != 0)
+				{
+					++count;
+				}
+			}
+			else
+			{
+				count = (size_t)length / sizeof(SQLWCHAR);
+			}
+			return Value::CreateText(Utf16ToUtf8(p, count));
+		}
+		case SQL_C_BINARY:
+			return Value::CreateBinary(string((const char*)pValue, (size_t)max(length, (SQLLEN)0)));
+		case SQL_C_DATE:
+		case SQL_C_TYPE_DATE:
+		{
+			const SQL_DATE_STRUCT& date = *(const SQL_DATE_STRUCT*)pValue;
+			SQL_TIMESTAMP_STRUCT ts = {};
+			ts.year = date.year;
+			ts.month = date.month;
+			ts.day = date.day;
+			return Value::CreateTimestamp(Value::Kind::Date, ts);
+		}
+		case SQL_C_TIME:
+		case SQL_C_TYPE_TIME:
+		{
+			const SQL_TIME_STRUCT& time = *(const SQL_TIME_STRUCT*)pValue;
+			SQL_TIMESTAMP_STRUCT ts = {};
+			ts.hour = time.hour;
+			ts.minute = time.minute;
+			ts.second = time.second;
+			return Value::CreateTimestamp(Value::Kind::Time, ts);
+		}
+		case SQL_C_TIMESTAMP:
+		case SQL_C_TYPE_TIMESTAMP:
+			return Value::CreateTimestamp(Value::Kind::Timestamp, *(const SQL_TIMESTAMP_STRUCT*)pValue);
+		default:
+			return Value();
+		}
+	}
+}
@@ -0,0 +1,157 @@
+﻿/*!
+* \file AsyncStatementPoller.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the AsyncStatementPoller class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+// Own header
+#include "AsyncStatementPoller.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "LogManager.h"
+
+// Other headers
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	AsyncStatementPoller::AsyncStatementPoller(std::chrono::microseconds pollInterval /* = std::chrono::microseconds(1000) */)
+		: m_pendingCount(0)
+		, m_pollInterval(pollInterval)
+		, m_stop(false)
+	{ }
+
+
+	AsyncStatementPoller::~AsyncStatementPoller()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_submittedCondition.notify_all();
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+
+
+	AsyncStatementPoller& AsyncStatementPoller::Get()
+	{
+		static AsyncStatementPoller instance;
+		return instance;
+	}
+
+
+	void AsyncStatementPoller::Submit(PollFunction pollFunction, CompletionHandler onComplete)
+	{
+		exASSERT(pollFunction);
+		exASSERT(onComplete);
+
+		{
+			lock_guard<mutex> lock(m_mutex);
+			exASSERT_MSG(!m_stop, u8"AsyncStatementPoller is shutting down");
+			Operation op;
+			op.m_pollFunction = pollFunction;
+			op.m_onComplete = onComplete;
+			m_submitted.push_back(op);
+			++m_pendingCount;
+			if (!m_thread.joinable())
+			{
+				m_thread = std::thread(&AsyncStatementPoller::Run, this);
+			}
+		}
+		m_submittedCondition.notify_one();
+	}
+
+
+	size_t AsyncStatementPoller::GetPendingCount() const
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_pendingCount;
+	}
+
+
+	void AsyncStatementPoller::SetPollInterval(std::chrono::microseconds pollInterval)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_pollInterval = pollInterval;
+	}
+
+
+	std::chrono::microseconds AsyncStatementPoller::GetPollInterval() const
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_pollInterval;
+	}
+
+
+	void AsyncStatementPoller::Run()
+	{
+		// Operations in flight, only touched by this thread
+		std::vector<Operation> active;
+		while (true)
+		{
+			{
+				unique_lock<mutex> lock(m_mutex);
+				if (active.empty())
+				{
+					// Nothing to poll, wait for new operations
+					m_submittedCondition.wait(lock, [this] { return m_stop || !m_submitted.empty(); });
+				}
+				else if (m_submitted.empty())
+				{
+					// Everything is still executing, give the driver some time (or pick up new operations)
+					m_submittedCondition.wait_for(lock, m_pollInterval, [this] { return !m_submitted.empty(); });
+				}
+				active.insert(active.end(), m_submitted.begin(), m_submitted.end());
+				m_submitted.clear();
+				if (m_stop && active.empty())
+				{
+					return;
+				}
+			}
+
+			std::vector<Operation>::iterator it = active.begin();
+			while (it != active.end())
+			{
+				SQLRETURN ret = it->m_pollFunction();
+				if (ret == SQL_STILL_EXECUTING)
+				{
+					++it;
+					continue;
+				}
+
+				// No longer pending once the handler gets called
+				CompletionHandler onComplete = it->m_onComplete;
+				it = active.erase(it);
+				{
+					lock_guard<mutex> lock(m_mutex);
+					--m_pendingCount;
+				}
+
+				try
+				{
+					onComplete(ret);
+				}
+				catch (const Exception& ex)
+				{
+					LOG_ERROR(ex.ToString());
+				}
+				catch (const std::exception& ex)
+				{
+					LOG_ERROR(ex.what());
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,514 @@
+﻿/*!
+* \file BulkRowset.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the BulkRowset class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "BulkRowset.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "ColumnBufferVisitors.h"
+#include "TableInfo.h"
+#include "LogManager.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <algorithm>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// Construction
+	// -------------
+	BulkRowset::BulkRowset(const Table& table, SQLULEN rowsetSize /* = DEFAULT_ROW_BLOCK_SIZE */, bool allowPositioned /* = true */, bool allowBookmarks /* = true */)
+		: m_table(table)
+		, m_pDb(table.GetDatabase())
+		, m_rowsetSize(rowsetSize)
+		, m_positioned(false)
+		, m_byBookmark(false)
+		, m_bulkAdd(false)
+		, m_fetched(false)
+		, m_addCount(0)
+		, m_marks(rowsetSize, RowMark::NONE)
+		, m_pendingChanges(false)
+	{
+		exASSERT(m_table.IsOpen());
+		exASSERT(m_rowsetSize > 0);
+
+		for (SQLUSMALLINT index : m_table.GetColumnBufferIndexes())
+		{
+			const ColumnBufferPtrVariant& var = m_table.GetColumnBufferPtrVariant(index);
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), var);
+			if (!pFlags->Test(ColumnFlag::CF_SELECT))
+			{
+				continue;
+			}
+			BulkColumn column;
+			column.m_queryName = boost::apply_visitor(QueryNameVisitor(), var);
+			ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), var);
+			SQLSMALLINT sqlCType = boost::apply_visitor(SqlCTypeVisitor(), var);
+			SQLLEN nrOfElements = boost::apply_visitor(NrOfElementsVisitor(), var);
+			column.m_definition = RowColumnDefinition(column.m_queryName, sqlCType, nrOfElements, pProps->GetColumnSize(), pProps->GetDecimalDigits());
+			column.m_paramDesc = GetRowParameterDescription(boost::apply_visitor(ParamDescVisitor(), var), sqlCType, nrOfElements);
+			column.m_primaryKey = pFlags->Test(ColumnFlag::CF_PRIMARY_KEY);
+			m_columns.push_back(column);
+		}
+		exASSERT(!m_columns.empty());
+
+		// Prefer keyset-driven cursors, they see the updates and deletes made through them
+		if (allowPositioned)
+		{
+			const SQLUINTEGER bookmarkOperations = SQL_CA1_BOOKMARK | SQL_CA1_BULK_UPDATE_BY_BOOKMARK | SQL_CA1_BULK_DELETE_BY_BOOKMARK;
+			const CursorType types[] = { CursorType::KEYSET_DRIVEN, CursorType::STATIC, CursorType::DYNAMIC };
+			const CursorConcurrency concurrencies[] = { CursorConcurrency::ROWVER, CursorConcurrency::VALUES, CursorConcurrency::LOCK };
+			for (size_t t = 0; t < 3 && !m_positioned; ++t)
+			{
+				SQLUINTEGER attributes1 = m_pDb->GetCursorAttributes1(types[t]);
+				if ((attributes1 & (SQL_CA1_POS_UPDATE | SQL_CA1_POS_DELETE)) != (SQL_CA1_POS_UPDATE | SQL_CA1_POS_DELETE))
+				{
+					continue;
+				}
+				for (size_t c = 0; c < 3 && !m_positioned; ++c)
+				{
+					CursorProfile profile(types[t], concurrencies[c]);
+					if (m_pDb->GetSupportsCursorProfile(profile))
+					{
+						m_profile = profile;
+						m_positioned = true;
+						m_byBookmark = allowBookmarks && (attributes1 & bookmarkOperations) == bookmarkOperations;
+						m_bulkAdd = (attributes1 & SQL_CA1_BULK_ADD) != 0;
+					}
+				}
+			}
+		}
+		if (!m_positioned)
+		{
+			m_profile = m_pDb->GetSupportsCursorProfile(CursorProfile::StaticReadOnly()) ? CursorProfile::StaticReadOnly() : CursorProfile::ForwardOnlyReadOnly();
+		}
+
+		m_stmt.Init(m_pDb, m_profile);
+		if (m_positioned && m_stmt.GetCursorProfile().m_concurrency == CursorConcurrency::READ_ONLY)
+		{
+			// The driver substituted a read-only cursor
+			m_positioned = false;
+			m_byBookmark = false;
+			m_bulkAdd = false;
+		}
+		if (m_byBookmark)
+		{
+			try
+			{
+				m_stmt.SetUseBookmarks(true);
+				m_bookmarks.resize(m_rowsetSize * ExecutableStatement::MAX_BOOKMARK_LENGTH);
+				m_bookmarkIndicators.resize(m_rowsetSize, SQL_NULL_DATA);
+			}
+			catch (const Exception& ex)
+			{
+				LOG_WARNING(boost::str(boost::format(u8"Failed to enable bookmarks, changing the rows of '%s' using SQLSetPos: %s") % m_table.GetTableInfo().GetQueryName() % ex.ToString()));
+				m_byBookmark = false;
+			}
+		}
+	}
+
+
+	// Implementation
+	// --------------
+	void BulkRowset::Select(const std::string& whereStatement /* = u8"" */, const std::string& orderStatement /* = u8"" */)
+	{
+		exASSERT_MSG(!m_pendingChanges, u8"Changes are pending, call ApplyChanges() first");
+
+		string fields;
+		std::vector<RowColumnDefinition> definitions;
+		for (const BulkColumn& column : m_columns)
+		{
+			fields += (fields.empty() ? u8"" : u8", ") + column.m_queryName;
+			definitions.push_back(column.m_definition);
+		}
+		string sql = boost::str(boost::format(u8"SELECT %s FROM %s") % fields % m_table.GetTableInfo().GetQueryName());
+		if (!whereStatement.empty())
+		{
+			sql += u8" WHERE " + whereStatement;
+		}
+		if (!orderStatement.empty())
+		{
+			sql += u8" ORDER BY " + orderStatement;
+		}
+
+		m_pRows.reset();
+		m_fetched = false;
+		m_addCount = 0;
+		m_stmt.ExecuteDirect(sql);
+		m_pRows.reset(new RowRange(m_stmt.Rows(definitions, m_rowsetSize)));
+		if (m_byBookmark)
+		{
+			m_stmt.BindBookmarkArray((SQLPOINTER)&m_bookmarks[0], ExecutableStatement::MAX_BOOKMARK_LENGTH, &m_bookmarkIndicators[0]);
+		}
+	}
+
+
+	bool BulkRowset::FetchNext()
+	{
+		exASSERT_MSG(m_pRows, u8"No result set is open, call Select() first");
+		exASSERT_MSG(!m_pendingChanges, u8"Changes are pending, call ApplyChanges() first");
+
+		m_addCount = 0;
+		m_fetched = m_pRows->GetBlock().NextBlock();
+		return m_fetched;
+	}
+
+
+	SQLULEN BulkRowset::GetRowCount() const noexcept
+	{
+		if (m_addCount > 0)
+		{
+			return m_addCount;
+		}
+		return m_fetched ? m_pRows->GetBlock().GetRowsFetched() : 0;
+	}
+
+
+	SQLUSMALLINT BulkRowset::GetColumnIndex(const std::string& queryName) const
+	{
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			if (m_columns[i].m_queryName == queryName)
+			{
+				return (SQLUSMALLINT)i;
+			}
+		}
+		NotFoundException nfe(boost::str(boost::format(u8"No column with name '%s' is selected by the BulkRowset") % queryName));
+		SET_EXCEPTION_SOURCE(nfe);
+		throw nfe;
+	}
+
+
+	RowView BulkRowset::GetRow(SQLULEN rowIndex) const
+	{
+		exASSERT(rowIndex < GetRowCount());
+		return RowView(&m_pRows->GetBlock(), rowIndex);
+	}
+
+
+	void BulkRowset::AssertWritable(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		exASSERT(columnIndex < m_columns.size());
+		exASSERT(rowIndex < GetRowCount());
+		exASSERT_MSG(m_addCount > 0 || !m_columns[columnIndex].m_primaryKey, u8"Values of primary key columns can only be set on rows being added");
+	}
+
+
+	void BulkRowset::SetString(SQLUSMALLINT columnIndex, SQLULEN rowIndex, const std::string& value)
+	{
+		AssertWritable(columnIndex, rowIndex);
+		RowBlock& block = m_pRows->GetBlock();
+		const RowColumnDefinition& def = block.GetColumnDefinition(columnIndex);
+		exASSERT(def.m_sqlCType == SQL_C_CHAR);
+		if ((SQLLEN)value.length() >= def.m_nrOfElements)
+		{
+			Exception ex(boost::str(boost::format(u8"Value of %d characters does not fit into column '%s' of %d characters") % value.length() % def.m_queryName % (def.m_nrOfElements - 1)));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		SQLCHAR* pData = block.GetDataPtr(columnIndex, rowIndex);
+		memcpy(pData, value.c_str(), value.length() + 1);
+		*block.GetIndicatorPtr(columnIndex, rowIndex) = (SQLLEN)value.length();
+	}
+
+
+	void BulkRowset::SetNull(SQLUSMALLINT columnIndex, SQLULEN rowIndex)
+	{
+		AssertWritable(columnIndex, rowIndex);
+		*m_pRows->GetBlock().GetIndicatorPtr(columnIndex, rowIndex) = SQL_NULL_DATA;
+	}
+
+
+	void BulkRowset::MarkUpdated(SQLULEN rowIndex)
+	{
+		exASSERT(m_addCount == 0);
+		exASSERT(rowIndex < GetRowCount());
+		if (m_marks[rowIndex] == RowMark::NONE)
+		{
+			m_marks[rowIndex] = RowMark::UPDATED;
+		}
+		m_pendingChanges = true;
+	}
+
+
+	void BulkRowset::MarkDeleted(SQLULEN rowIndex)
+	{
+		exASSERT(m_addCount == 0);
+		exASSERT(rowIndex < GetRowCount());
+		m_marks[rowIndex] = RowMark::DELETED;
+		m_pendingChanges = true;
+	}
+
+
+	void BulkRowset::ClearMarks()
+	{
+		std::fill(m_marks.begin(), m_marks.end(), RowMark::NONE);
+		m_pendingChanges = false;
+	}
+
+
+	void BulkRowset::ClampIndicators(SQLULEN rowIndex)
+	{
+		// Values truncated while fetching report a length larger than the buffer
+		RowBlock& block = m_pRows->GetBlock();
+		for (SQLUSMALLINT i = 0; i < block.GetColumnCount(); ++i)
+		{
+			const RowColumnDefinition& def = block.GetColumnDefinition(i);
+			SQLLEN maxIndicator = GetMaxIndicator(def.m_sqlCType, GetRowElementLength(def.m_sqlCType, def.m_nrOfElements));
+			SQLLEN* pCb = block.GetIndicatorPtr(i, rowIndex);
+			if (maxIndicator >= 0 && (*pCb == SQL_NO_TOTAL || *pCb > maxIndicator))
+			{
+				*pCb = maxIndicator;
+			}
+		}
+	}
+
+
+	std::vector<SQLULEN> BulkRowset::GetMarkedRows(RowMark mark) const
+	{
+		std::vector<SQLULEN> rows;
+		for (SQLULEN row = 0; row < GetRowCount(); ++row)
+		{
+			if (m_marks[row] == mark)
+			{
+				rows.push_back(row);
+			}
+		}
+		return rows;
+	}
+
+
+	ParameterArray BulkRowset::CompactColumn(SQLUSMALLINT columnIndex, const std::vector<SQLULEN>& rows, size_t paramIndex)
+	{
+		const RowBlock& block = m_pRows->GetBlock();
+		const RowColumnDefinition& def = block.GetColumnDefinition(columnIndex);
+		SQLLEN elementLength = GetRowElementLength(def.m_sqlCType, def.m_nrOfElements);
+		if (m_paramData.size() <= paramIndex)
+		{
+			m_paramData.resize(paramIndex + 1);
+			m_paramIndicators.resize(paramIndex + 1);
+		}
+		std::vector<SQLCHAR>& data = m_paramData[paramIndex];
+		std::vector<SQLLEN>& indicators = m_paramIndicators[paramIndex];
+		data.resize(rows.size() * elementLength);
+		indicators.resize(rows.size());
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			memcpy(&data[i * elementLength], block.GetData(columnIndex, rows[i]), elementLength);
+			indicators[i] = block.GetIndicator(columnIndex, rows[i]);
+		}
+		return ParameterArray(def.m_sqlCType, m_columns[columnIndex].m_paramDesc, (SQLPOINTER)&data[0], elementLength, &indicators[0]);
+	}
+
+
+	ExecutableStatementPtr BulkRowset::PrepareStatement(const std::string& sql)
+	{
+		ExecutableStatementPtr pStmt = std::make_shared<ExecutableStatement>(m_pDb);
+		pStmt->Prepare(sql);
+		return pStmt;
+	}
+
+
+	SQLULEN BulkRowset::ApplyChanges()
+	{
+		exASSERT(m_pRows);
+		if (!m_pendingChanges)
+		{
+			return 0;
+		}
+
+		for (SQLULEN row = 0; row < GetRowCount(); ++row)
+		{
+			if (m_marks[row] == RowMark::UPDATED)
+			{
+				ClampIndicators(row);
+			}
+		}
+		SQLULEN changed = m_positioned ? ApplyPositioned() : ApplyStatements();
+		ClearMarks();
+		m_table.InvalidateResultCache();
+		return changed;
+	}
+
+
+	SQLULEN BulkRowset::ApplyPositioned()
+	{
+		// One operation per row of the rowset, the driver ignores the rows not fetched
+		SQLULEN changed = 0;
+		std::vector<SQLUSMALLINT> operations(m_rowsetSize, SQL_ROW_IGNORE);
+		const RowMark marks[] = { RowMark::UPDATED, RowMark::DELETED };
+		for (RowMark mark : marks)
+		{
+			SQLULEN count = 0;
+			for (SQLULEN row = 0; row < m_rowsetSize; ++row)
+			{
+				bool proceed = row < GetRowCount() && m_marks[row] == mark;
+				operations[row] = proceed ? SQL_ROW_PROCEED : SQL_ROW_IGNORE;
+				count += proceed ? 1 : 0;
+			}
+			if (count > 0 && m_byBookmark)
+			{
+				m_stmt.BulkOperations(mark == RowMark::UPDATED ? SQL_UPDATE_BY_BOOKMARK : SQL_DELETE_BY_BOOKMARK, GetRowCount(), &operations[0]);
+				changed += count;
+			}
+			else if (count > 0)
+			{
+				m_stmt.SetPos(0, mark == RowMark::UPDATED ? SQL_UPDATE : SQL_DELETE, &operations[0]);
+				changed += count;
+			}
+		}
+		return changed;
+	}
+
+
+	SQLULEN BulkRowset::ApplyStatements()
+	{
+		std::vector<SQLUSMALLINT> keyColumns;
+		std::vector<SQLUSMALLINT> valueColumns;
+		for (SQLUSMALLINT i = 0; i < (SQLUSMALLINT)m_columns.size(); ++i)
+		{
+			(m_columns[i].m_primaryKey ? keyColumns : valueColumns).push_back(i);
+		}
+		if (keyColumns.empty())
+		{
+			Exception ex(boost::str(boost::format(u8"No primary key column of '%s' is selected, cannot update or delete rows without an updatable cursor") % m_table.GetTableInfo().GetQueryName()));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+		string where;
+		for (SQLUSMALLINT i : keyColumns)
+		{
+			where += (where.empty() ? u8"" : u8" AND ") + m_columns[i].m_queryName + u8" = ?";
+		}
+
+		SQLULEN changed = 0;
+		std::vector<SQLULEN> rows = GetMarkedRows(RowMark::UPDATED);
+		if (!rows.empty() && !valueColumns.empty())
+		{
+			if (!m_pUpdateStmt)
+			{
+				string set;
+				for (SQLUSMALLINT i : valueColumns)
+				{
+					set += (set.empty() ? u8"" : u8", ") + m_columns[i].m_queryName + u8" = ?";
+				}
+				m_pUpdateStmt = PrepareStatement(boost::str(boost::format(u8"UPDATE %s SET %s WHERE %s") % m_table.GetTableInfo().GetQueryName() % set % where));
+			}
+			std::vector<ParameterArray> params;
+			for (SQLUSMALLINT i : valueColumns)
+			{
+				params.push_back(CompactColumn(i, rows, params.size()));
+			}
+			for (SQLUSMALLINT i : keyColumns)
+			{
+				params.push_back(CompactColumn(i, rows, params.size()));
+			}
+			m_pUpdateStmt->ExecutePreparedArray(params, rows.size());
+			changed += rows.size();
+		}
+
+		rows = GetMarkedRows(RowMark::DELETED);
+		if (!rows.empty())
+		{
+			if (!m_pDeleteStmt)
+			{
+				m_pDeleteStmt = PrepareStatement(boost::str(boost::format(u8"DELETE FROM %s WHERE %s") % m_table.GetTableInfo().GetQueryName() % where));
+			}
+			std::vector<ParameterArray> params;
+			for (SQLUSMALLINT i : keyColumns)
+			{
+				params.push_back(CompactColumn(i, rows, params.size()));
+			}
+			m_pDeleteStmt->ExecutePreparedArray(params, rows.size());
+			changed += rows.size();
+		}
+		return changed;
+	}
+
+
+	void BulkRowset::BeginAdd(SQLULEN rowCount)
+	{
+		exASSERT_MSG(m_pRows, u8"No result set is open, call Select() first");
+		exASSERT_MSG(!m_pendingChanges, u8"Changes are pending, call ApplyChanges() first");
+		exASSERT(rowCount > 0);
+		exASSERT(rowCount <= m_rowsetSize);
+
+		RowBlock& block = m_pRows->GetBlock();
+		for (SQLUSMALLINT i = 0; i < block.GetColumnCount(); ++i)
+		{
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				*block.GetIndicatorPtr(i, row) = SQL_NULL_DATA;
+			}
+		}
+		m_fetched = false;
+		m_addCount = rowCount;
+	}
+
+
+	SQLULEN BulkRowset::AddRows()
+	{
+		exASSERT_MSG(m_addCount > 0, u8"No rows are being added, call BeginAdd() first");
+
+		SQLULEN rowCount = m_addCount;
+		for (SQLULEN row = 0; row < rowCount; ++row)
+		{
+			ClampIndicators(row);
+		}
+
+		if (m_bulkAdd)
+		{
+			m_stmt.BulkOperations(SQL_ADD, rowCount);
+		}
+		else
+		{
+			std::vector<SQLULEN> rows(rowCount);
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				rows[row] = row;
+			}
+			if (!m_pInsertStmt)
+			{
+				string fields;
+				string markers;
+				for (const BulkColumn& column : m_columns)
+				{
+					fields += (fields.empty() ? u8"" : u8", ") + column.m_queryName;
+					markers += markers.empty() ? u8"?" : u8", ?";
+				}
+				m_pInsertStmt = PrepareStatement(boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (%s)") % m_table.GetTableInfo().GetQueryName() % fields % markers));
+			}
+			std::vector<ParameterArray> params;
+			for (SQLUSMALLINT i = 0; i < (SQLUSMALLINT)m_columns.size(); ++i)
+			{
+				params.push_back(CompactColumn(i, rows, params.size()));
+			}
+			m_pInsertStmt->ExecutePreparedArray(params, rowCount);
+		}
+
+		m_table.InvalidateResultCache();
+
+		// The rows added are not part of the result set, it must be selected again
+		m_addCount = 0;
+		m_pRows.reset();
+		m_stmt.SelectClose();
+		return rowCount;
+	}
+} // namespace exodbc
@@ -12,6 +12,7 @@
 
 // Same component headers
 #include "AssertionException.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -38,7 +39,7 @@ namespace exodbc
 
 		SQLUSMALLINT maxColName = props.GetMaxColumnNameLen();
 		std::unique_ptr<SQLAPICHARTYPE[]> nameBuffer(new SQLAPICHARTYPE[maxColName + 1]);
-		SQLRETURN ret = SQLDescribeCol(pStmt->GetHandle(), columnNr, nameBuffer.get(), maxColName + 1, NULL, &m_sqlType, &m_charSize, &m_decimalDigits, &m_nullable);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLDescribeCol, pStmt->GetHandle(), columnNr, nameBuffer.get(), maxColName + 1, NULL, &m_sqlType, &m_charSize, &m_decimalDigits, &m_nullable);
 		THROW_IFN_SUCCEEDED(SQLDescribeCol, ret, SQL_HANDLE_STMT, pStmt->GetHandle());
 
 		m_name = SQLAPICHARPTR_TO_EXODBCSTR(nameBuffer.get());
@@ -0,0 +1,83 @@
+﻿/*!
+* \file CursorProfile.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for CursorProfile.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "CursorProfile.h"
+
+// Same component headers
+// Other headers
+#include "boost/format.hpp"
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	namespace
+	{
+		std::string ToString(CursorType type)
+		{
+			switch (type)
+			{
+			case CursorType::FORWARD_ONLY:
+				return u8"FORWARD_ONLY";
+			case CursorType::STATIC:
+				return u8"STATIC";
+			case CursorType::KEYSET_DRIVEN:
+				return u8"KEYSET_DRIVEN";
+			case CursorType::DYNAMIC:
+				return u8"DYNAMIC";
+			}
+			return boost::str(boost::format(u8"%d") % (int)type);
+		}
+
+
+		std::string ToString(CursorConcurrency concurrency)
+		{
+			switch (concurrency)
+			{
+			case CursorConcurrency::READ_ONLY:
+				return u8"READ_ONLY";
+			case CursorConcurrency::LOCK:
+				return u8"LOCK";
+			case CursorConcurrency::ROWVER:
+				return u8"ROWVER";
+			case CursorConcurrency::VALUES:
+				return u8"VALUES";
+			}
+			return boost::str(boost::format(u8"%d") % (int)concurrency);
+		}
+
+
+		std::string ToString(CursorSensitivity sensitivity)
+		{
+			switch (sensitivity)
+			{
+			case CursorSensitivity::UNSPECIFIED:
+				return u8"UNSPECIFIED";
+			case CursorSensitivity::INSENSITIVE:
+				return u8"INSENSITIVE";
+			case CursorSensitivity::SENSITIVE:
+				return u8"SENSITIVE";
+			}
+			return boost::str(boost::format(u8"%d") % (int)sensitivity);
+		}
+	}
+
+
+	std::string CursorProfile::ToString() const
+	{
+		return boost::str(boost::format(u8"%s / %s / %s") % exodbc::ToString(m_type) % exodbc::ToString(m_concurrency) % exodbc::ToString(m_sensitivity));
+	}
+}
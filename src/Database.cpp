@@ -18,6 +18,8 @@
 #include "SqlStatementCloser.h"
 #include "LogManagerOdbcMacros.h"
 #include "Sql2StringHelper.h"
+#include "ExecutionScope.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -32,6 +34,7 @@ namespace exodbc
 	Database::Database() noexcept
 		: m_pEnv(NULL)
 		, m_pSql2BufferTypeMap(NULL)
+		, m_maxPooledStmtHandles(SqlStmtHandlePool::DEFAULT_MAX_POOLED_HANDLES)
 		, m_pHDbc(std::make_shared<SqlDbcHandle>())
 		, m_pHStmtExecSql(std::make_shared<SqlStmtHandle>())
 		, m_dbIsOpen(false)
@@ -44,6 +47,7 @@ namespace exodbc
 	Database::Database(ConstEnvironmentPtr pEnv)
 		: m_pEnv(NULL)
 		, m_pSql2BufferTypeMap(NULL)
+		, m_maxPooledStmtHandles(SqlStmtHandlePool::DEFAULT_MAX_POOLED_HANDLES)
 		, m_pHDbc(std::make_shared<SqlDbcHandle>())
 		, m_pHStmtExecSql(std::make_shared<SqlStmtHandle>())
 		, m_dbIsOpen(false)
@@ -58,6 +62,7 @@ namespace exodbc
 	Database::Database(const Database& other)
 		: m_pEnv(NULL)
 		, m_pSql2BufferTypeMap(NULL)
+		, m_maxPooledStmtHandles(SqlStmtHandlePool::DEFAULT_MAX_POOLED_HANDLES)
 		, m_pHDbc(std::make_shared<SqlDbcHandle>())
 		, m_pHStmtExecSql(std::make_shared<SqlStmtHandle>())
 		, m_dbIsOpen(false)
@@ -149,6 +154,9 @@ namespace exodbc
 			// Set Connection Options
 			SetConnectionAttributes();
 
+			// Set up the pool for the statement handles
+			m_pStmtHandlePool = std::make_shared<SqlStmtHandlePool>(m_pHDbc, m_maxPooledStmtHandles);
+
 			// Default to manual commit, if the Database is able to set a commit mode. Anyway read the currently active mode, we need to know that
 			m_commitMode = ReadCommitMode();
 			if (m_props.GetSupportsTransactions() && m_commitMode != CommitMode::MANUAL)
@@ -164,6 +172,11 @@ namespace exodbc
 		{
 			HIDE_UNUSED(ex);
 			// Try to free what we've allocated and rethrow
+			if (m_pStmtHandlePool)
+			{
+				m_pStmtHandlePool->Close();
+				m_pStmtHandlePool.reset();
+			}
 			m_pDbCatalog.reset();
 			m_props.Reset();
 			if (m_pHStmtExecSql->IsAllocated())
@@ -199,7 +212,7 @@ namespace exodbc
 		// Note: 
 		// StringLength1: [Input] Length of *InConnectionString, in characters if the string is Unicode, or bytes if string is ANSI or DBCS.
 		// BufferLength: [Input] Length of the *OutConnectionString buffer, in characters.
-		SQLRETURN ret = SQLDriverConnect(m_pHDbc->GetHandle(), parentWnd, 
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLDriverConnect, m_pHDbc->GetHandle(), parentWnd, 
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(m_inConnectionStr).c_str(),
 			(SQLSMALLINT) m_inConnectionStr.length(), 
 			(SQLAPICHARTYPE*) outConnectBuffer, 
@@ -220,7 +233,7 @@ namespace exodbc
 		{
 			HIDE_UNUSED(ex);
 			// Try to disconnect from the data source
-			ret = SQLDisconnect(m_pHDbc->GetHandle());
+			ret = TRACE_ODBC_CALL(SQLDisconnect, m_pHDbc->GetHandle());
 			if (!SQL_SUCCEEDED(ret))
 			{
 				ErrorHelper::SErrorInfoVector errs = ErrorHelper::GetAllErrors(SQL_HANDLE_DBC, m_pHDbc->GetHandle());
@@ -256,7 +269,7 @@ namespace exodbc
 		m_outConnectionStr = u8"";
 
 		// Connect to the data source
-		SQLRETURN ret = SQLConnect(m_pHDbc->GetHandle(),
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLConnect, m_pHDbc->GetHandle(),
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(m_dsn).c_str(), SQL_NTS,
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(m_uid).c_str(), SQL_NTS,
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(m_authStr).c_str(), SQL_NTS);
@@ -275,7 +288,7 @@ namespace exodbc
 		{
 			HIDE_UNUSED(ex);
 			// Try to disconnect from the data source
-			ret = SQLDisconnect(m_pHDbc->GetHandle());
+			ret = TRACE_ODBC_CALL(SQLDisconnect, m_pHDbc->GetHandle());
 			if ( ! SQL_SUCCEEDED(ret))
 			{
 				ErrorHelper::SErrorInfoVector errs = ErrorHelper::GetAllErrors(SQL_HANDLE_DBC, m_pHDbc->GetHandle());
@@ -295,6 +308,31 @@ namespace exodbc
 	}
 
 
+	std::shared_ptr<Database> Database::OpenNewConnection() const
+	{
+		exASSERT(IsOpen());
+		exASSERT(m_pEnv);
+
+		DatabasePtr pDb = Database::Create(m_pEnv);
+		pDb->SetSql2BufferTypeMap(m_pSql2BufferTypeMap);
+		pDb->SetMaxPooledStmtHandles(m_maxPooledStmtHandles);
+		pDb->SetResultCache(m_pResultCache);
+		if (m_dbOpenedWithConnectionString)
+		{
+			pDb->Open(m_inConnectionStr);
+		}
+		else
+		{
+			pDb->Open(m_dsn, m_uid, m_authStr);
+		}
+		if (pDb->GetCommitMode() != m_commitMode)
+		{
+			pDb->SetCommitMode(m_commitMode);
+		}
+		return pDb;
+	}
+
+
 	bool Database::IsSqlTypeSupported(SQLSMALLINT sqlType) const
 	{
 		exASSERT(IsOpen());
@@ -338,6 +376,24 @@ namespace exodbc
 	}
 
 
+	SqlStmtHandlePoolPtr Database::GetStmtHandlePool() const
+	{
+		exASSERT(IsOpen());
+		exASSERT(m_pStmtHandlePool);
+		return m_pStmtHandlePool;
+	}
+
+
+	void Database::SetMaxPooledStmtHandles(size_t maxPooledHandles)
+	{
+		m_maxPooledStmtHandles = maxPooledHandles;
+		if (m_pStmtHandlePool)
+		{
+			m_pStmtHandlePool->SetMaxPooledHandles(maxPooledHandles);
+		}
+	}
+
+
 	bool Database::TestScrollableCursorSupport()
 	{
 		// Do not asser for IsOpen(), this function is called during Opening
@@ -345,7 +401,7 @@ namespace exodbc
 		exASSERT(m_pHDbc);
 		exASSERT(m_pHDbc->IsAllocated());
 		SqlStmtHandle hStmt(m_pHDbc);
-		SQLRETURN ret = SQLSetStmtAttr(hStmt.GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_SCROLLABLE, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt.GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_SCROLLABLE, 0);
 		try
 		{
 			THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt.GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CURSOR_SCROLLABLE to SQL_SCROLLABLE");
@@ -371,7 +427,7 @@ namespace exodbc
 		exASSERT(m_pHDbc);
 		exASSERT(m_pHDbc->IsAllocated());
 
-		SQLRETURN ret = SQLSetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_TRACE, (SQLPOINTER) SQL_OPT_TRACE_OFF, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_TRACE, (SQLPOINTER) SQL_OPT_TRACE_OFF, 0);
 		THROW_IFN_SUCCEEDED_MSG(SQLSetConnectAttr, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), u8"Cannot set SQL_ATTR_TRACE to SQL_OPT_TRACE_OFF");
 
 		// For the moment do nothing here. 
@@ -397,12 +453,16 @@ namespace exodbc
 		// Free statement handles - keep the pointers, but free the handle held
 		m_pHStmtExecSql->Free();
 
+		// Free the pooled statement handles. Handles still in use are freed once released.
+		m_pStmtHandlePool->Close();
+		m_pStmtHandlePool.reset();
+
 		// And also clear all props read and the catalog
 		m_props.Reset();
 		m_pDbCatalog.reset();
 
 		// Try to disconnect from the data source
-		SQLRETURN ret = SQLDisconnect(m_pHDbc->GetHandle());
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLDisconnect, m_pHDbc->GetHandle());
 		THROW_IFN_SUCCEEDED(SQLDisconnect, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle());
 
 		m_dbIsOpen = false;
@@ -416,8 +476,18 @@ namespace exodbc
 		exASSERT(m_pHDbc->IsAllocated());
 
 		// Commit the transaction
-		SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, m_pHDbc->GetHandle(), SQL_COMMIT);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLEndTran, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), SQL_COMMIT);
 		THROW_IFN_SUCCEEDED_MSG(SQLEndTran, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), u8"Failed to Commit Transaction");
+
+		// Other connections might have cached the old rows between the writes and the commit
+		if (m_pResultCache)
+		{
+			for (const string& tableName : m_writtenTables)
+			{
+				m_pResultCache->Invalidate(tableName);
+			}
+		}
+		m_writtenTables.clear();
 	}
 
 
@@ -428,8 +498,29 @@ namespace exodbc
 		exASSERT(m_pHDbc->IsAllocated());
 
 		// Rollback the transaction
-		SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, m_pHDbc->GetHandle(), SQL_ROLLBACK);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLEndTran, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), SQL_ROLLBACK);
 		THROW_IFN_SUCCEEDED_MSG(SQLEndTran, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), u8"Failed to Rollback Transaction");
+
+		// Cached results might have been read after writes that have now been undone
+		if (m_pResultCache)
+		{
+			m_pResultCache->Clear();
+		}
+		m_writtenTables.clear();
+	}
+
+
+	void Database::InvalidateResultCache(const std::string& tableName) const
+	{
+		if (!m_pResultCache)
+		{
+			return;
+		}
+		m_pResultCache->Invalidate(tableName);
+		if (m_commitMode == CommitMode::MANUAL)
+		{
+			m_writtenTables.insert(tableName);
+		}
 	}
 
 
@@ -441,8 +532,14 @@ namespace exodbc
 
 		StatementCloser::CloseStmtHandle(m_pHStmtExecSql, StatementCloser::Mode::IgnoreNotOpen);
 
-		retcode = SQLExecDirect(m_pHStmtExecSql->GetHandle(),  
+		// ExecSql never has bound parameters and does not fetch, the execution ends once it has been executed
+		ExecutionTrackerPtr pExecution = std::make_shared<ExecutionTracker>();
+		pExecution->Begin(ExecutionContext(ExecutionType::ExecuteDirect, sqlStmt));
+		ExecutionScope scope(pExecution, ExecutionScope::Phase::Execute);
+		retcode = TRACE_ODBC_CALL(SQLExecDirect, m_pHStmtExecSql->GetHandle(),  
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(sqlStmt).c_str(), SQL_NTS);
+		scope.Stop();
+		pExecution->End();
 		if ( ! SQL_SUCCEEDED(retcode))
 		{
 			if (!(mode == ExecFailMode::NotFailOnNoData && retcode == SQL_NO_DATA))
@@ -452,6 +549,21 @@ namespace exodbc
 				throw ex;
 			}
 		}
+
+		// Errors of the later statements of a batch are only reported when moving to their results.
+		// The first result set is kept open, callers might fetch it using GetExecSqlHandle()
+		if (GetSupportsBatches())
+		{
+			SQLSMALLINT nrOfCols = 0;
+			retcode = TRACE_ODBC_CALL(SQLNumResultCols, m_pHStmtExecSql->GetHandle(), &nrOfCols);
+			THROW_IFN_SUCCEEDED(SQLNumResultCols, retcode, SQL_HANDLE_STMT, m_pHStmtExecSql->GetHandle());
+			while (nrOfCols == 0 && (retcode = TRACE_ODBC_CALL(SQLMoreResults, m_pHStmtExecSql->GetHandle())) != SQL_NO_DATA)
+			{
+				THROW_IFN_SUCCEEDED_MSG(SQLMoreResults, retcode, SQL_HANDLE_STMT, m_pHStmtExecSql->GetHandle(), (boost::format(u8"Failed to execute Stmt '%s'") % sqlStmt).str());
+				retcode = TRACE_ODBC_CALL(SQLNumResultCols, m_pHStmtExecSql->GetHandle(), &nrOfCols);
+				THROW_IFN_SUCCEEDED(SQLNumResultCols, retcode, SQL_HANDLE_STMT, m_pHStmtExecSql->GetHandle());
+			}
+		}
 	}
 
 
@@ -465,7 +577,7 @@ namespace exodbc
 
 		SQLULEN modeValue = 0;
 		SQLINTEGER cb;
-		SQLRETURN ret = SQLGetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, &modeValue, sizeof(modeValue), &cb);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, &modeValue, sizeof(modeValue), &cb);
 		THROW_IFN_SUCCEEDED_MSG(SQLGetConnectAttr, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), u8"Failed to read Attr SQL_ATTR_AUTOCOMMIT");
 
 		if(modeValue == SQL_AUTOCOMMIT_OFF)
@@ -486,7 +598,7 @@ namespace exodbc
 
 		SQLULEN modeValue = 0;
 		SQLINTEGER cb;
-		SQLRETURN ret = SQLGetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_TXN_ISOLATION, &modeValue, sizeof(modeValue), &cb);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_TXN_ISOLATION, &modeValue, sizeof(modeValue), &cb);
 		THROW_IFN_SUCCEEDED_MSG(SQLGetConnectAttr, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), u8"Failed to read Attr SQL_ATTR_TXN_ISOLATION");
 
 		switch (modeValue)
@@ -521,12 +633,12 @@ namespace exodbc
 		std::string errStringMode;
 		if (mode == CommitMode::MANUAL)
 		{
-			ret = SQLSetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_OFF, 0);
+			ret = TRACE_ODBC_CALL(SQLSetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_OFF, 0);
 			errStringMode = u8"SQL_AUTOCOMMIT_OFF";
 		}
 		else
 		{
-			ret = SQLSetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_ON, 0);
+			ret = TRACE_ODBC_CALL(SQLSetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER) SQL_AUTOCOMMIT_ON, 0);
 			errStringMode = u8"SQL_AUTOCOMMIT_ON";
 		}
 		THROW_IFN_SUCCEEDED_MSG(SQLSetConnectAttr, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), (boost::format(u8"Setting ATTR_AUTOCOMMIT to %s failed") % errStringMode).str());
@@ -552,7 +664,7 @@ namespace exodbc
 
 		SQLRETURN ret;
 		{
-			ret = SQLSetConnectAttr(m_pHDbc->GetHandle(), SQL_ATTR_TXN_ISOLATION, (SQLPOINTER)mode, 0);
+			ret = TRACE_ODBC_CALL(SQLSetConnectAttr, m_pHDbc->GetHandle(), SQL_ATTR_TXN_ISOLATION, (SQLPOINTER)mode, 0);
 		}
 		THROW_IFN_SUCCEEDED_MSG(SQLSetConnectAttr, ret, SQL_HANDLE_DBC, m_pHDbc->GetHandle(), (boost::format(u8"Cannot set SQL_ATTR_TXN_ISOLATION to %d") % (int) mode).str());
 
@@ -13,6 +13,7 @@
 // Same component headers
 #include "SqlStatementCloser.h"
 #include "SpecializedExceptions.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -140,7 +141,7 @@ namespace exodbc
 		// Read SQL_ATTR_METADATA_ID value: We need to init that value, it seems like MySql connector does not
 		// overwrite it completely on 64bit builds..
 		SQLULEN metadataAttr = SQL_FALSE;
-		SQLRETURN ret = SQLGetStmtAttr(m_pHStmt->GetHandle(), SQL_ATTR_METADATA_ID, (SQLPOINTER)&metadataAttr, 0, nullptr);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_METADATA_ID, (SQLPOINTER)&metadataAttr, 0, nullptr);
 		if (!SQL_SUCCEEDED(ret))
 		{
 			SqlResultException sre(u8"SQLGetStmtAttr", ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
@@ -178,7 +179,7 @@ namespace exodbc
 		else
 			newValue = SQL_FALSE;
 
-		SQLRETURN ret = SQLSetStmtAttr(m_pHStmt->GetHandle(), SQL_ATTR_METADATA_ID, (SQLPOINTER)&newValue, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_METADATA_ID, (SQLPOINTER)&newValue, 0);
 		THROW_IFN_SUCCEEDED(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 		
 		if (newValue == SQL_FALSE)
@@ -345,14 +346,14 @@ namespace exodbc
 		TableInfoVector tables;
 
 		// Query db
-		SQLRETURN ret = SQLTables(m_pHStmt->GetHandle(),
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLTables, m_pHStmt->GetHandle(),
 			pCatalogName == nullptr ? NULL : pCatalogName, SQL_NTS,   // catname                 
 			pSchemaName == nullptr ? NULL : pSchemaName, SQL_NTS,   // schema name
 			pTableName == nullptr ? NULL : pTableName, SQL_NTS,	// table name
 			tableType.empty() ? NULL : (SQLAPICHARTYPE*)EXODBCSTR_TO_SQLAPISTR(tableType).c_str(), SQL_NTS);
 		THROW_IFN_SUCCEEDED(SQLTables, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
-		while ((ret = SQLFetch(m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
 		{
 			TableInfo ti(m_pHStmt, m_props);
 			tables.push_back(ti);
@@ -392,17 +393,17 @@ namespace exodbc
 		// Close Statement and make sure it closes upon exit
 		StatementCloser stmtCloser(m_pHStmt, true, true);
 
-		SQLRETURN ret = SQLGetTypeInfo(m_pHStmt->GetHandle(), SQL_ALL_TYPES);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetTypeInfo, m_pHStmt->GetHandle(), SQL_ALL_TYPES);
 		THROW_IFN_SUCCEEDED(SQLGetTypeInfo, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
-		ret = SQLFetch(m_pHStmt->GetHandle());
+		ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle());
 
 		while (ret == SQL_SUCCESS)
 		{
 			SqlTypeInfo typeInfo(m_pHStmt, m_props);
 			types.push_back(typeInfo);
 
-			ret = SQLFetch(m_pHStmt->GetHandle());
+			ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle());
 		}
 		THROW_IFN_NO_DATA(SQLFetch, ret);
 
@@ -432,7 +433,7 @@ namespace exodbc
 
 		// Query columns
 		int colCount = 0;
-		SQLRETURN ret = SQLColumns(m_pHStmt->GetHandle(),
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLColumns, m_pHStmt->GetHandle(),
 			pCatalogName == nullptr ? NULL : pCatalogName, SQL_NTS,	// catalog
 			pSchemaName == nullptr ? NULL : pSchemaName, SQL_NTS,	// schema
 			pTableName == nullptr ? NULL : pTableName, SQL_NTS, // tablename
@@ -442,7 +443,7 @@ namespace exodbc
 
 		ColumnInfoVector columns;
 
-		while ((ret = SQLFetch(m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
 		{
 			// Fetch data from columns
 			ColumnInfo colInfo(m_pHStmt, m_props);
@@ -469,14 +470,14 @@ namespace exodbc
 
 		PrimaryKeyInfoVector primaryKeys;
 
-		SQLRETURN ret = SQLPrimaryKeys(m_pHStmt->GetHandle(),
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLPrimaryKeys, m_pHStmt->GetHandle(),
 			pCatalogName, SQL_NTS,
 			pSchemaName, SQL_NTS,
 			pTableName, SQL_NTS);
 
 		THROW_IFN_SUCCEEDED(SQLPrimaryKeys, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
-		while ((ret = SQLFetch(m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
 		{
 			PrimaryKeyInfo pki(m_pHStmt, m_props);
 			primaryKeys.push_back(pki);
@@ -519,14 +520,14 @@ namespace exodbc
 			nullable = SQL_NULLABLE;
 		}
 
-		SQLRETURN ret = SQLSpecialColumns(m_pHStmt->GetHandle(), (SQLSMALLINT)idType,
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSpecialColumns, m_pHStmt->GetHandle(), (SQLSMALLINT)idType,
 			pCatalogName, SQL_NTS,
 			pSchemaName, SQL_NTS,
 			pTableName, SQL_NTS,
 			(SQLSMALLINT)scope, nullable);
 		THROW_IFN_SUCCEEDED(SQLSpecialColumns, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
-		while ((ret = SQLFetch(m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
 		{
 			SpecialColumnInfo specColInfo(m_pHStmt, m_props, idType);
 			columns.push_back(specColInfo);
@@ -535,4 +536,92 @@ namespace exodbc
 
 		return columns;
 	}
+
+
+	TableStatistics DatabaseCatalog::ReadStatistics(const TableInfo& tableInfo, bool uniqueOnly /* = false */, bool quick /* = true */) const
+	{
+		return TableStatistics(ReadStatistics((SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetName()).c_str(),
+			tableInfo.HasSchema() ? (SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetSchema()).c_str() : nullptr,
+			tableInfo.HasCatalog() ? (SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetCatalog()).c_str() : nullptr,
+			uniqueOnly, quick, MetadataMode::PatternOrOrdinary));
+	}
+
+
+	IndexInfoVector DatabaseCatalog::ReadStatistics(SQLAPICHARTYPE* pTableName, SQLAPICHARTYPE* pSchemaName, SQLAPICHARTYPE* pCatalogName,
+		bool uniqueOnly, bool quick, MetadataMode mode) const
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(pTableName != nullptr);
+
+		if (m_stmtMode != mode)
+			SetMetadataAttribute(mode);
+
+		// Close Statement and make sure it closes upon exit
+		StatementCloser stmtCloser(m_pHStmt, true, true);
+
+		IndexInfoVector rows;
+
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLStatistics, m_pHStmt->GetHandle(),
+			pCatalogName, SQL_NTS,
+			pSchemaName, SQL_NTS,
+			pTableName, SQL_NTS,
+			uniqueOnly ? SQL_INDEX_UNIQUE : SQL_INDEX_ALL,
+			quick ? SQL_QUICK : SQL_ENSURE);
+		THROW_IFN_SUCCEEDED(SQLStatistics, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
+
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		{
+			IndexInfo row(m_pHStmt, m_props);
+			rows.push_back(row);
+		}
+		THROW_IFN_NO_DATA(SQLFetch, ret);
+
+		return rows;
+	}
+
+
+	ForeignKeyInfoVector DatabaseCatalog::ReadForeignKeyInfo(const TableInfo& tableInfo) const
+	{
+		return ReadForeignKeyInfo(nullptr, nullptr, nullptr,
+			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetName()).c_str(),
+			tableInfo.HasSchema() ? (SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetSchema()).c_str() : nullptr,
+			tableInfo.HasCatalog() ? (SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(tableInfo.GetCatalog()).c_str() : nullptr,
+			MetadataMode::PatternOrOrdinary);
+	}
+
+
+	ForeignKeyInfoVector DatabaseCatalog::ReadForeignKeyInfo(SQLAPICHARTYPE* pPkTableName, SQLAPICHARTYPE* pPkSchemaName, SQLAPICHARTYPE* pPkCatalogName,
+		SQLAPICHARTYPE* pFkTableName, SQLAPICHARTYPE* pFkSchemaName, SQLAPICHARTYPE* pFkCatalogName, MetadataMode mode) const
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(pPkTableName != nullptr || pFkTableName != nullptr);
+
+		if (m_stmtMode != mode)
+			SetMetadataAttribute(mode);
+
+		// Close Statement and make sure it closes upon exit
+		StatementCloser stmtCloser(m_pHStmt, true, true);
+
+		ForeignKeyInfoVector foreignKeys;
+
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLForeignKeys, m_pHStmt->GetHandle(),
+			pPkCatalogName, SQL_NTS,
+			pPkSchemaName, SQL_NTS,
+			pPkTableName, SQL_NTS,
+			pFkCatalogName, SQL_NTS,
+			pFkSchemaName, SQL_NTS,
+			pFkTableName, SQL_NTS);
+		THROW_IFN_SUCCEEDED(SQLForeignKeys, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
+
+		while ((ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle())) == SQL_SUCCESS)
+		{
+			ForeignKeyInfo fki(m_pHStmt, m_props);
+			foreignKeys.push_back(fki);
+		}
+		THROW_IFN_NO_DATA(SQLFetch, ret);
+
+		return foreignKeys;
+	}
 }
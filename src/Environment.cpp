@@ -13,6 +13,7 @@
 // Same component headers
 #include "SpecializedExceptions.h"
 #include "LogManagerOdbcMacros.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -77,9 +78,9 @@ namespace exodbc
 		// windows probably wants wchars here.. (?)
 #ifdef _WIN32
 		std::wstring wpath = utf8ToUtf16(path);
-		SQLRETURN ret = SQLSetConnectAttr(NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)wpath.c_str(), ((SQLINTEGER)wpath.length()) * sizeof(SQLWCHAR));
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetConnectAttr, NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)wpath.c_str(), ((SQLINTEGER)wpath.length()) * sizeof(SQLWCHAR));
 #else
-		SQLRETURN ret = SQLSetConnectAttr(NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)path.c_str(), ((SQLINTEGER)path.length()) * sizeof(SQLCHAR));
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetConnectAttr, NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)path.c_str(), ((SQLINTEGER)path.length()) * sizeof(SQLCHAR));
 #endif
 		if (!SQL_SUCCEEDED(ret))
 		{
@@ -98,7 +99,7 @@ namespace exodbc
 		SQLINTEGER byteBuffSize = sizeof(SQLAPICHARTYPE) * charBuffSize;
 		std::unique_ptr<SQLAPICHARTYPE[]> buffer(new SQLAPICHARTYPE[charBuffSize]);
 		memset(buffer.get(), 0, byteBuffSize);
-		SQLRETURN ret = SQLGetConnectAttr(NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)buffer.get(), byteBuffSize, &cb);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetConnectAttr, NULL, SQL_ATTR_TRACEFILE, (SQLPOINTER)buffer.get(), byteBuffSize, &cb);
 		if (!SQL_SUCCEEDED(ret))
 		{
 			Exception ex(u8"Failed to read attribute SQL_ATTR_TRACEFILE");
@@ -115,9 +116,9 @@ namespace exodbc
 	{
 		SQLRETURN ret = 0;
 		if (enable)
-			ret = SQLSetConnectAttr(NULL, SQL_ATTR_TRACE, (SQLPOINTER)SQL_OPT_TRACE_ON, 0);
+			ret = TRACE_ODBC_CALL(SQLSetConnectAttr, NULL, SQL_ATTR_TRACE, (SQLPOINTER)SQL_OPT_TRACE_ON, 0);
 		else
-			ret = SQLSetConnectAttr(NULL, SQL_ATTR_TRACE, (SQLPOINTER)SQL_OPT_TRACE_OFF, 0);
+			ret = TRACE_ODBC_CALL(SQLSetConnectAttr, NULL, SQL_ATTR_TRACE, (SQLPOINTER)SQL_OPT_TRACE_OFF, 0);
 
 		if (!SQL_SUCCEEDED(ret))
 		{
@@ -136,7 +137,7 @@ namespace exodbc
 	bool Environment::GetTrace()
 	{
 		SQLUINTEGER value = 0;
-		SQLRETURN ret = SQLGetConnectAttr(NULL, SQL_ATTR_TRACE, &value, 0, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetConnectAttr, NULL, SQL_ATTR_TRACE, &value, 0, 0);
 		if (!SQL_SUCCEEDED(ret))
 		{
 			Exception ex(u8"Failed to read Attribute SQL_ATTR_TRACE");
@@ -150,7 +151,7 @@ namespace exodbc
 
 	void Environment::EnableConnectionPooling(ConnectionPooling enablePooling)
 	{
-		SQLRETURN ret = SQLSetEnvAttr(SQL_NULL_HENV, SQL_ATTR_CONNECTION_POOLING, (SQLPOINTER)enablePooling, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetEnvAttr, SQL_NULL_HENV, SQL_ATTR_CONNECTION_POOLING, (SQLPOINTER)enablePooling, 0);
 		if (!SQL_SUCCEEDED(ret))
 		{
 			std::string msg = boost::str(boost::format(u8"Failed to set Attribute SQL_ATTR_CONNECTION_POOLING to %d") % (int)enablePooling);
@@ -187,13 +188,13 @@ namespace exodbc
 		switch(version)
 		{
 		case OdbcVersion::V_2:
-			ret = SQLSetEnvAttr(m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC2, 0);
+			ret = TRACE_ODBC_CALL(SQLSetEnvAttr, m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC2, 0);
 			break;
 		case OdbcVersion::V_3:
-			ret = SQLSetEnvAttr(m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC3, 0);
+			ret = TRACE_ODBC_CALL(SQLSetEnvAttr, m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC3, 0);
 			break;
 		case OdbcVersion::V_3_8:
-			ret = SQLSetEnvAttr(m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC3_80, 0);
+			ret = TRACE_ODBC_CALL(SQLSetEnvAttr, m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC3_80, 0);
 			break;
 		default:
 			THROW_WITH_SOURCE(IllegalArgumentException, (boost::format(u8"Unknown ODBC Version value: %d") % (int) version).str());
@@ -210,7 +211,7 @@ namespace exodbc
 		exASSERT(IsEnvHandleAllocated());
 
 		unsigned long value = 0;
-		SQLRETURN ret = SQLGetEnvAttr(m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, &value, 0, NULL);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetEnvAttr, m_pHEnv->GetHandle(), SQL_ATTR_ODBC_VERSION, &value, 0, NULL);
 
 		THROW_IFN_SUCCEEDED_MSG(SQLGetEnvAttr, ret, SQL_HANDLE_ENV, m_pHEnv->GetHandle(), u8"Failed to read SQL_ATTR_ODBC_VERSION");
 
@@ -249,7 +250,7 @@ namespace exodbc
 
 	void Environment::SetConnctionPoolingMatch(ConnectionPoolingMatch matchMode)
 	{
-		SQLRETURN ret = SQLSetEnvAttr(m_pHEnv->GetHandle(), SQL_ATTR_CP_MATCH, (SQLPOINTER)matchMode, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetEnvAttr, m_pHEnv->GetHandle(), SQL_ATTR_CP_MATCH, (SQLPOINTER)matchMode, 0);
 		THROW_IFN_SUCCEEDED(SQLSetEnvAttr, ret, SQL_HANDLE_ENV, m_pHEnv->GetHandle());
 	}
 
@@ -277,7 +278,7 @@ namespace exodbc
 		// Like that we might miss some parts of the descriptions.. 
 		SQLSMALLINT maxDescLength = 0;
 		SQLRETURN ret = SQL_NO_DATA;
-		ret = SQLDataSources(m_pHEnv->GetHandle(), direction, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, NULL, 0, &descBufferLength);
+		ret = TRACE_ODBC_CALL(SQLDataSources, m_pHEnv->GetHandle(), direction, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, NULL, 0, &descBufferLength);
 		if(ret == SQL_NO_DATA)
 		{
 			// no data at all, but succeeded, else we would have an err-state
@@ -293,13 +294,13 @@ namespace exodbc
 				maxDescLength = descBufferLength;
 			}
 			// Go on fetching lengths of descriptions
-			ret = SQLDataSources(m_pHEnv->GetHandle(), SQL_FETCH_NEXT, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, NULL, 0, &descBufferLength);
+			ret = TRACE_ODBC_CALL(SQLDataSources, m_pHEnv->GetHandle(), SQL_FETCH_NEXT, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, NULL, 0, &descBufferLength);
 		}while(ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO);
 		THROW_IFN_NO_DATA(SQLDataSources, ret);
 
 		// Now fetch with description
 		std::unique_ptr<SQLAPICHARTYPE[]> descBuffer(new SQLAPICHARTYPE[maxDescLength + 1]);
-		ret = SQLDataSources(m_pHEnv->GetHandle(), direction, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, descBuffer.get(), maxDescLength + 1, &descBufferLength);
+		ret = TRACE_ODBC_CALL(SQLDataSources, m_pHEnv->GetHandle(), direction, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, descBuffer.get(), maxDescLength + 1, &descBufferLength);
 		if(ret == SQL_NO_DATA)
 		{
 			SqlResultException ex(u8"SQLDataSources", ret, u8"SQL_NO_DATA is not expected to happen here - we've found records in the previous round, they can't be gone now!");
@@ -313,7 +314,7 @@ namespace exodbc
 			ds.m_dsn = SQLAPICHARPTR_TO_EXODBCSTR(nameBuffer);
 			ds.m_description = SQLAPICHARPTR_TO_EXODBCSTR(descBuffer.get());
 			dataSources.push_back(ds);
-			ret = SQLDataSources(m_pHEnv->GetHandle(), SQL_FETCH_NEXT, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, descBuffer.get(), maxDescLength + 1, &descBufferLength);
+			ret = TRACE_ODBC_CALL(SQLDataSources, m_pHEnv->GetHandle(), SQL_FETCH_NEXT, nameBuffer, SQL_MAX_DSN_LENGTH + 1, &nameBufferLength, descBuffer.get(), maxDescLength + 1, &descBufferLength);
 		}while(ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO);
 
 		THROW_IFN_NO_DATA(SQLDataSources, ret);
@@ -14,8 +14,15 @@
 #include "ColumnBufferVisitors.h"
 #include "SqlStatementCloser.h"
 #include "LogManagerOdbcMacros.h"
+#include "AsyncStatementPoller.h"
+#include "OdbcTrace.h"
+#include "SetDescriptionFieldWrapper.h"
 
 // Other headers
+#include <chrono>
+#include <algorithm>
+#include <sstream>
+
 // Debug
 #include "DebugNew.h"
 
@@ -26,12 +33,99 @@ using namespace std;
 
 namespace exodbc
 {
+	namespace
+	{
+		/*!
+		* \brief	Set SQL_ATTR_ASYNC_ENABLE on the passed handle. Logs a warning and returns false if that fails.
+		*/
+		bool SetAsyncEnable(ConstSqlStmtHandlePtr pHStmt, bool enable)
+		{
+			SQLULEN value = enable ? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF;
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, pHStmt->GetHandle(), SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)value, 0);
+			if (!SQL_SUCCEEDED(ret))
+			{
+				LOG_WARNING_STMT(pHStmt->GetHandle(), ret, SQLSetStmtAttr);
+				return false;
+			}
+			return true;
+		}
+
+
+		/*!
+		* \brief	Throws if ret is neither succeeded nor SQL_NO_DATA. Returns true if a record has been fetched.
+		*/
+		bool EvaluateFetch(ConstSqlStmtHandlePtr pHStmt, SQLRETURN ret)
+		{
+			if (!(SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA))
+			{
+				SqlResultException sre(u8"SQLFetch", ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
+				SET_EXCEPTION_SOURCE(sre);
+				throw sre;
+			}
+			if (ret == SQL_SUCCESS_WITH_INFO)
+			{
+				LOG_WARNING_STMT(pHStmt->GetHandle(), ret, SQLFetch);
+			}
+			return SQL_SUCCEEDED(ret);
+		}
+
+
+		/*!
+		* \brief	Enable asynchronous execution on pHStmt if asyncSupported and start call. If the call is
+		*			still executing, it is submitted to the AsyncStatementPoller. Else, or if enabling
+		*			asynchronous execution fails, onComplete is called before this function returns.
+		* \details	The final return value is passed to evaluate before SQL_ATTR_ASYNC_ENABLE is reset,
+		*			as setting an attribute clears the diagnostic records of the handle. onComplete is
+		*			called after the attribute has been reset, with the result of evaluate or the
+		*			exception thrown by evaluate.
+		*/
+		void StartAsync(SqlStmtHandlePtr pHStmt, bool asyncSupported, AsyncStatementPoller::PollFunction call, std::function<bool(SQLRETURN)> evaluate, ExecutableStatement::FetchCompletionHandler onComplete)
+		{
+			exASSERT(onComplete);
+
+			bool asyncEnabled = asyncSupported && SetAsyncEnable(pHStmt, true);
+			auto complete = [pHStmt, evaluate, onComplete, asyncEnabled](SQLRETURN ret)
+			{
+				bool result = false;
+				std::exception_ptr pEx;
+				try
+				{
+					result = evaluate(ret);
+				}
+				catch (...)
+				{
+					pEx = std::current_exception();
+				}
+				if (asyncEnabled)
+				{
+					SetAsyncEnable(pHStmt, false);
+				}
+				onComplete(result, pEx);
+			};
+
+			SQLRETURN ret = call();
+			if (asyncEnabled && ret == SQL_STILL_EXECUTING)
+			{
+				AsyncStatementPoller::Get().Submit(call, complete);
+			}
+			else
+			{
+				complete(ret);
+			}
+		}
+	}
+
+
 	ExecutableStatement::ExecutableStatement()
 		: m_pDb(NULL)
 		, m_isPrepared(false)
 		, m_scrollableCursor(false)
 		, m_boundColumns(false)
 		, m_boundParams(false)
+		, m_boundColumnBytes(0)
+		, m_boundParamBytes(0)
+		, m_useBookmarks(false)
+		, m_bookmarkCb(SQL_NULL_DATA)
 	{ }
 
 
@@ -41,6 +135,10 @@ namespace exodbc
 		, m_scrollableCursor(false)
 		, m_boundColumns(false)
 		, m_boundParams(false)
+		, m_boundColumnBytes(0)
+		, m_boundParamBytes(0)
+		, m_useBookmarks(false)
+		, m_bookmarkCb(SQL_NULL_DATA)
 	{
 		Init(pDb, scrollableCursor);
 	}
@@ -52,15 +150,35 @@ namespace exodbc
 		, m_scrollableCursor(false)
 		, m_boundColumns(false)
 		, m_boundParams(false)
+		, m_boundColumnBytes(0)
+		, m_boundParamBytes(0)
+		, m_useBookmarks(false)
+		, m_bookmarkCb(SQL_NULL_DATA)
 	{
 		Init(pDb, m_scrollableCursor);
 	}
 
 
+	ExecutableStatement::ExecutableStatement(ConstDatabasePtr pDb, const CursorProfile& cursorProfile)
+		: m_pDb(NULL)
+		, m_isPrepared(false)
+		, m_scrollableCursor(false)
+		, m_boundColumns(false)
+		, m_boundParams(false)
+		, m_boundColumnBytes(0)
+		, m_boundParamBytes(0)
+		, m_useBookmarks(false)
+		, m_bookmarkCb(SQL_NULL_DATA)
+	{
+		Init(pDb, cursorProfile);
+	}
+
+
 	ExecutableStatement::~ExecutableStatement()
 	{
-		// We do not free the handle explicitly. Let it go out of scope, it will destroy itself once no one needs it.
-		// but unbind things as long as the ExecutableStatement cannot be copied.
+		// We do not free the handle explicitly. Release it to the pool, or let it go out of scope, it will destroy itself 
+		// once no one needs it. But unbind things as long as the ExecutableStatement cannot be copied.
+		EndExecution();
 		if (m_boundParams)
 		{
 			try
@@ -83,6 +201,17 @@ namespace exodbc
 				LOG_ERROR(ex.ToString());
 			}
 		}
+		if (m_pHStmt && m_pHStmtPool)
+		{
+			try
+			{
+				m_pHStmtPool->Release(std::move(m_pHStmt));
+			}
+			catch (const Exception& ex)
+			{
+				LOG_ERROR(ex.ToString());
+			}
+		}
 	}
 
 
@@ -93,7 +222,8 @@ namespace exodbc
 		exASSERT(pDb->IsOpen());
 
 		m_pDb = pDb;
-		m_pHStmt = std::make_shared<SqlStmtHandle>(m_pDb->GetSqlDbcHandle());
+		m_pHStmtPool = m_pDb->GetStmtHandlePool();
+		m_pHStmt = m_pHStmtPool->Acquire();
 
 		// If we fail during init, go back into state before init was called
 		try
@@ -109,8 +239,34 @@ namespace exodbc
 	}
 
 
+	void ExecutableStatement::Init(ConstDatabasePtr pDb, const CursorProfile& cursorProfile)
+	{
+		exASSERT(m_pDb == NULL);
+		exASSERT(pDb);
+		exASSERT(pDb->IsOpen());
+
+		m_pDb = pDb;
+		m_pHStmtPool = m_pDb->GetStmtHandlePool();
+		m_pHStmt = m_pHStmtPool->Acquire();
+
+		// If we fail during init, go back into state before init was called
+		try
+		{
+			SetCursorProfile(cursorProfile);
+		}
+		catch (const Exception& ex)
+		{
+			HIDE_UNUSED(ex);
+			Reset();
+			throw;
+		}
+	}
+
+
 	void ExecutableStatement::Reset()
 	{
+		EndExecution();
+		m_pExecution.reset();
 		if (m_boundColumns)
 		{
 			m_pHStmt->UnbindColumns();
@@ -121,7 +277,18 @@ namespace exodbc
 			m_pHStmt->ResetParams();
 			m_boundParams = false;
 		}
+		m_boundColumnBytes = 0;
+		m_boundParamBytes = 0;
+		m_boundParamBuffers.clear();
+		m_useBookmarks = false;
+		m_bookmarkCb = SQL_NULL_DATA;
+		m_preparedSql.clear();
+		if (m_pHStmt && m_pHStmtPool)
+		{
+			m_pHStmtPool->Release(std::move(m_pHStmt));
+		}
 		m_pHStmt.reset();
+		m_pHStmtPool.reset();
 		m_pDb.reset();
 	}
 
@@ -138,17 +305,17 @@ namespace exodbc
 			SQLRETURN ret = 0;
 			// Try to read the currently active value first, and only try to change if a change is required:
 			SQLULEN currentValue;
-			ret = SQLGetStmtAttr(m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)&currentValue, sizeof(currentValue), 0);
+			ret = TRACE_ODBC_CALL(SQLGetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)&currentValue, sizeof(currentValue), 0);
 			THROW_IFN_SUCCEEDED_MSG(SQLGetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to get Statement Attr SQL_ATTR_CURSOR_SCROLLABLE");
 			if (!scrollableCursor && currentValue != SQL_NONSCROLLABLE)
 			{
-				ret = SQLSetStmtAttr(m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_NONSCROLLABLE, 0);
+				ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_NONSCROLLABLE, 0);
 				THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CURSOR_SCROLLABLE to SQL_NONSCROLLABLE");
 				m_scrollableCursor = false;
 			}
 			else if(scrollableCursor && currentValue != SQL_SCROLLABLE)
 			{
-				ret = SQLSetStmtAttr(m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_SCROLLABLE, 0);
+				ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)SQL_SCROLLABLE, 0);
 				THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CURSOR_SCROLLABLE to SQL_SCROLLABLE");
 				m_scrollableCursor = true;
 			}
@@ -170,6 +337,66 @@ namespace exodbc
 	}
 
 
+	void ExecutableStatement::SetCursorProfile(const CursorProfile& cursorProfile)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(m_pDb);
+		exASSERT(m_pDb->IsOpen());
+
+		if (!m_pDb->GetSupportsCursorProfile(cursorProfile))
+		{
+			Exception ex(boost::str(boost::format(u8"Database does not support cursor profile %s") % cursorProfile.ToString()));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+		// Attributes cannot be changed while a cursor is open
+		SelectClose();
+
+		// Set the type first: Setting it might change the concurrency
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)(SQLULEN)cursorProfile.m_type, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CURSOR_TYPE");
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CONCURRENCY, (SQLPOINTER)(SQLULEN)cursorProfile.m_concurrency, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CONCURRENCY");
+		if (cursorProfile.m_sensitivity != CursorSensitivity::UNSPECIFIED)
+		{
+			ret = TRACE_ODBC_CALL(SQLSetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SENSITIVITY, (SQLPOINTER)(SQLULEN)cursorProfile.m_sensitivity, 0);
+			THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to set Statement Attr SQL_ATTR_CURSOR_SENSITIVITY");
+		}
+
+		// The driver reports SQL_SUCCESS_WITH_INFO (01S02) if it substituted a value
+		CursorProfile active = GetCursorProfile();
+		if (active.m_type != cursorProfile.m_type || active.m_concurrency != cursorProfile.m_concurrency
+			|| (cursorProfile.m_sensitivity != CursorSensitivity::UNSPECIFIED && active.m_sensitivity != cursorProfile.m_sensitivity))
+		{
+			LOG_WARNING(boost::str(boost::format(u8"Driver changed cursor profile %s to %s") % cursorProfile.ToString() % active.ToString()));
+		}
+		m_scrollableCursor = active.IsScrollable();
+	}
+
+
+	CursorProfile ExecutableStatement::GetCursorProfile() const
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+
+		SQLULEN type = SQL_CURSOR_FORWARD_ONLY;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)&type, sizeof(type), NULL);
+		THROW_IFN_SUCCEEDED_MSG(SQLGetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to get Statement Attr SQL_ATTR_CURSOR_TYPE");
+		SQLULEN concurrency = SQL_CONCUR_READ_ONLY;
+		ret = TRACE_ODBC_CALL(SQLGetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CONCURRENCY, (SQLPOINTER)&concurrency, sizeof(concurrency), NULL);
+		THROW_IFN_SUCCEEDED_MSG(SQLGetStmtAttr, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle(), u8"Failed to get Statement Attr SQL_ATTR_CONCURRENCY");
+		SQLULEN sensitivity = SQL_UNSPECIFIED;
+		ret = TRACE_ODBC_CALL(SQLGetStmtAttr, m_pHStmt->GetHandle(), SQL_ATTR_CURSOR_SENSITIVITY, (SQLPOINTER)&sensitivity, sizeof(sensitivity), NULL);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			sensitivity = SQL_UNSPECIFIED;
+		}
+		return CursorProfile((CursorType)type, (CursorConcurrency)concurrency, (CursorSensitivity)sensitivity);
+	}
+
+
 	void ExecutableStatement::ExecuteDirect(const std::string& sqlstmt)
 	{
 		exASSERT(m_pHStmt);
@@ -178,8 +405,11 @@ namespace exodbc
 		// Always discard pending results first
 		SelectClose();
 
-		SQLRETURN ret = SQLExecDirect(m_pHStmt->GetHandle(),  
+		BeginExecution(ExecutionType::ExecuteDirect, sqlstmt, m_boundColumnBytes + m_boundParamBytes);
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Execute);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLExecDirect, m_pHStmt->GetHandle(),  
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(sqlstmt).c_str(), SQL_NTS);
+		scope.Stop();
 		THROW_IFN_SUCCEEDED(SQLExecDirect, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 	}
 
@@ -190,8 +420,13 @@ namespace exodbc
 		exASSERT(m_pHStmt->IsAllocated());
 		exASSERT(!sqlstmt.empty());
 
-		SQLRETURN ret = SQLPrepare(m_pHStmt->GetHandle(),  
+		m_preparedSql = sqlstmt;
+		BeginExecution(ExecutionType::Prepare, sqlstmt, 0);
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Execute);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLPrepare, m_pHStmt->GetHandle(),  
 			(SQLAPICHARTYPE*) EXODBCSTR_TO_SQLAPISTR(sqlstmt).c_str(), SQL_NTS);
+		scope.Stop();
+		EndExecution();
 		THROW_IFN_SUCCEEDED(SQLPrepare, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
 		m_isPrepared = true;
@@ -227,7 +462,7 @@ namespace exodbc
 		exASSERT(m_pHStmt);
 		exASSERT(m_pHStmt->IsAllocated());
 		SQLSMALLINT columnCount = 0;
-		SQLRETURN ret = SQLNumResultCols(m_pHStmt->GetHandle(), &columnCount);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLNumResultCols, m_pHStmt->GetHandle(), &columnCount);
 		THROW_IFN_SUCCEEDED(SQLNumResultCols, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 
 		return columnCount;
@@ -241,20 +476,332 @@ namespace exodbc
 		// Always discard pending results first
 		SelectClose();
 
-		SQLRETURN ret = SQLExecute(m_pHStmt->GetHandle());
+		BeginExecution(ExecutionType::ExecutePrepared, m_preparedSql, m_boundColumnBytes + m_boundParamBytes);
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Execute);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLExecute, m_pHStmt->GetHandle());
+		scope.Stop();
 		THROW_IFN_SUCCEEDED(SQLExecute, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
 	}
 
 
+	SQLULEN ExecutableStatement::ExecutePreparedArray(const std::vector<ParameterArray>& params, SQLULEN paramSetSize)
+	{
+		exASSERT(m_isPrepared);
+		exASSERT(!params.empty());
+		exASSERT(paramSetSize > 0);
+
+		// Always discard pending results first
+		SelectClose();
+		if (m_boundParams)
+		{
+			UnbindParams();
+		}
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		std::vector<SQLUSMALLINT> status(paramSetSize, SQL_PARAM_UNUSED);
+		SQLULEN processed = 0;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_PARAM_BIND_TYPE to SQL_PARAM_BIND_BY_COLUMN");
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)paramSetSize, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to set Statement Attr SQL_ATTR_PARAMSET_SIZE to %d") % paramSetSize));
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAM_STATUS_PTR, (SQLPOINTER)&status[0], 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_PARAM_STATUS_PTR");
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, (SQLPOINTER)&processed, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_PARAMS_PROCESSED_PTR");
+
+		SQLLEN paramBytes = 0;
+		try
+		{
+			for (size_t i = 0; i < params.size(); ++i)
+			{
+				const ParameterArray& param = params[i];
+				SQLUSMALLINT paramNr = (SQLUSMALLINT)(i + 1);
+				ret = TRACE_ODBC_CALL(SQLBindParameter, hStmt, paramNr, SQL_PARAM_INPUT, param.m_sqlCType, param.m_paramDesc.GetSqlType(), param.m_paramDesc.GetCharSize(),
+					param.m_paramDesc.GetDecimalDigits(), param.m_pData, param.m_elementLength, param.m_pIndicators);
+				THROW_IFN_SUCCEEDED_MSG(SQLBindParameter, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to bind parameter %d as array of %d elements") % paramNr % paramSetSize));
+				if (param.m_sqlCType == SQL_C_NUMERIC)
+				{
+					// Precision and scale can only be set using the descriptor, see ColumnBuffer<SQL_NUMERIC_STRUCT>
+					SqlDescHandle hDesc(m_pHStmt, SqlDescHandle::RowDescriptorType::PARAM);
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_TYPE, (SQLPOINTER)SQL_C_NUMERIC);
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_PRECISION, (SQLPOINTER)((SQLLEN)param.m_paramDesc.GetCharSize()));
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_SCALE, (SQLPOINTER)((SQLLEN)param.m_paramDesc.GetDecimalDigits()));
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_DATA_PTR, param.m_pData);
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_INDICATOR_PTR, (SQLPOINTER)param.m_pIndicators);
+					SetDescriptionFieldWrapper::SetDescriptionField(hDesc, paramNr, SQL_DESC_OCTET_LENGTH_PTR, (SQLPOINTER)param.m_pIndicators);
+				}
+				paramBytes += param.m_elementLength * paramSetSize;
+			}
+			m_boundParams = true;
+
+			BeginExecution(ExecutionType::ExecutePreparedArray, m_preparedSql, m_boundColumnBytes + paramBytes, &params, paramSetSize);
+			ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Execute);
+			ret = TRACE_ODBC_CALL(SQLExecute, hStmt);
+			scope.Stop();
+			THROW_IFN_SUCCEEDED(SQLExecute, ret, SQL_HANDLE_STMT, hStmt);
+		}
+		catch (const Exception&)
+		{
+			ResetParameterArrays();
+			throw;
+		}
+		ResetParameterArrays();
+
+		size_t failed = std::count(status.begin(), status.end(), (SQLUSMALLINT)SQL_PARAM_ERROR);
+		if (failed > 0)
+		{
+			Exception ex(boost::str(boost::format(u8"Executing '%s' failed for %d of %d parameter sets") % m_preparedSql % failed % paramSetSize));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		return processed;
+	}
+
+
+	void ExecutableStatement::SetPos(SQLSETPOSIROW rowNumber, SQLUSMALLINT operation, SQLUSMALLINT* pRowOperations /* = NULL */)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = SQL_SUCCESS;
+		if (pRowOperations)
+		{
+			ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_OPERATION_PTR, (SQLPOINTER)pRowOperations, 0);
+			THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_ROW_OPERATION_PTR");
+		}
+		ret = TRACE_ODBC_CALL(SQLSetPos, hStmt, rowNumber, operation, SQL_LOCK_NO_CHANGE);
+		if (pRowOperations)
+		{
+			SQLRETURN resetRet = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_OPERATION_PTR, (SQLPOINTER)NULL, 0);
+			if (!SQL_SUCCEEDED(resetRet))
+			{
+				LOG_WARNING_STMT(hStmt, resetRet, SQLSetStmtAttr);
+			}
+		}
+		THROW_IFN_SUCCEEDED_MSG(SQLSetPos, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to apply operation %d on row %d") % operation % rowNumber));
+	}
+
+
+	void ExecutableStatement::BulkOperations(SQLUSMALLINT operation, SQLULEN rowCount, SQLUSMALLINT* pRowOperations /* = NULL */)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(rowCount > 0);
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLULEN rowArraySize = 1;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetStmtAttr, hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)&rowArraySize, sizeof(rowArraySize), NULL);
+		THROW_IFN_SUCCEEDED_MSG(SQLGetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to get Statement Attr SQL_ATTR_ROW_ARRAY_SIZE");
+		if (rowArraySize != rowCount)
+		{
+			ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)rowCount, 0);
+			THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to set Statement Attr SQL_ATTR_ROW_ARRAY_SIZE to %d") % rowCount));
+		}
+		if (pRowOperations)
+		{
+			ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_OPERATION_PTR, (SQLPOINTER)pRowOperations, 0);
+			if (SQL_SUCCEEDED(ret))
+			{
+				ret = TRACE_ODBC_CALL(SQLBulkOperations, hStmt, operation);
+				SQLRETURN resetRet = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_OPERATION_PTR, (SQLPOINTER)NULL, 0);
+				if (!SQL_SUCCEEDED(resetRet))
+				{
+					LOG_WARNING_STMT(hStmt, resetRet, SQLSetStmtAttr);
+				}
+			}
+		}
+		else
+		{
+			ret = TRACE_ODBC_CALL(SQLBulkOperations, hStmt, operation);
+		}
+		if (rowArraySize != rowCount)
+		{
+			SQLRETURN resetRet = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)rowArraySize, 0);
+			if (!SQL_SUCCEEDED(resetRet))
+			{
+				LOG_WARNING_STMT(hStmt, resetRet, SQLSetStmtAttr);
+			}
+		}
+		THROW_IFN_SUCCEEDED_MSG(SQLBulkOperations, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to apply bulk operation %d on %d rows") % operation % rowCount));
+	}
+
+
+	bool ExecutableStatement::MoreResults(bool unbindColumns /* = true */)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+
+		if (unbindColumns && m_boundColumns)
+		{
+			UnbindColumns();
+			m_boundColumns = false;
+		}
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLMoreResults, hStmt);
+		if (ret == SQL_NO_DATA)
+		{
+			// The driver has closed the cursor
+			EndExecution();
+			return false;
+		}
+		THROW_IFN_SUCCEEDED_MSG(SQLMoreResults, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to move to the next result");
+		return true;
+	}
+
+
+	SQLLEN ExecutableStatement::GetRowCount() const
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+
+		SQLLEN rowCount = -1;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLRowCount, m_pHStmt->GetHandle(), &rowCount);
+		THROW_IFN_SUCCEEDED(SQLRowCount, ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
+		return rowCount;
+	}
+
+
+	std::vector<SQLLEN> ExecutableStatement::ExecuteBatch(const std::vector<std::string>& statements)
+	{
+		exASSERT(m_pDb);
+		exASSERT(!statements.empty());
+
+		// A searched UPDATE or DELETE that affects no rows returns SQL_NO_DATA
+		auto executeDirect = [this](const std::string& sql) -> SQLLEN
+		{
+			try
+			{
+				ExecuteDirect(sql);
+			}
+			catch (const SqlResultException& ex)
+			{
+				if (ex.GetRet() != SQL_NO_DATA)
+				{
+					throw;
+				}
+				return 0;
+			}
+			return GetRowCount();
+		};
+
+		std::vector<SQLLEN> rowCounts;
+		try
+		{
+			if (statements.size() == 1 || !m_pDb->GetSupportsBatches())
+			{
+				for (const string& sql : statements)
+				{
+					rowCounts.push_back(executeDirect(sql));
+					SelectClose();
+				}
+				return rowCounts;
+			}
+
+			string batch;
+			for (const string& sql : statements)
+			{
+				exASSERT(!sql.empty());
+				batch += (batch.empty() ? u8"" : u8";\n") + sql;
+			}
+			rowCounts.push_back(executeDirect(batch));
+			while (rowCounts.size() < statements.size() && MoreResults())
+			{
+				rowCounts.push_back(GetRowCount());
+			}
+			rowCounts.resize(statements.size(), -1);
+		}
+		catch (const Exception&)
+		{
+			SelectClose();
+			throw;
+		}
+		SelectClose();
+		return rowCounts;
+	}
+
+
+	void ExecutableStatement::FinishResults()
+	{
+		while (MoreResults(false))
+		{
+		}
+	}
+
+
+	std::string ExecutableStatement::CreateCallStatement(const std::string& procedureName, SQLUSMALLINT nrOfParams, bool returnValue /* = false */)
+	{
+		exASSERT(!procedureName.empty());
+
+		stringstream ss;
+		ss << u8"{";
+		if (returnValue)
+		{
+			ss << u8"? = ";
+		}
+		ss << u8"call " << procedureName;
+		if (nrOfParams > 0)
+		{
+			ss << u8"(";
+			for (SQLUSMALLINT i = 0; i < nrOfParams; ++i)
+			{
+				ss << (i == 0 ? u8"?" : u8", ?");
+			}
+			ss << u8")";
+		}
+		ss << u8"}";
+		return ss.str();
+	}
+
+
+	void ExecutableStatement::ResetParameterArrays() noexcept
+	{
+		// Do not let the driver read from the arrays once they are gone
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		try
+		{
+			m_pHStmt->ResetParams();
+		}
+		catch (const Exception& ex)
+		{
+			LOG_WARNING(ex.ToString());
+		}
+		m_boundParams = false;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAM_STATUS_PTR, (SQLPOINTER)NULL, 0);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLSetStmtAttr);
+		}
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAMS_PROCESSED_PTR, (SQLPOINTER)NULL, 0);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLSetStmtAttr);
+		}
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLSetStmtAttr);
+		}
+	}
+
+
 	void ExecutableStatement::BindColumn(ColumnBufferPtrVariant column, SQLUSMALLINT columnNr)
 	{
 		BindColumnVisitor sv(columnNr, m_pHStmt);
 		boost::apply_visitor(sv, column);
 		m_boundColumns = true;
+		m_boundColumnBytes += boost::apply_visitor(BufferLengthVisitor(), column);
 	}
 
 
 	void ExecutableStatement::BindParameter(ColumnBufferPtrVariant column, SQLUSMALLINT paramNr, bool neverQueryParamDesc /* = false */)
+	{
+		BindParameter(column, paramNr, ParameterDirection::INPUT, neverQueryParamDesc);
+	}
+
+
+	void ExecutableStatement::BindParameter(ColumnBufferPtrVariant column, SQLUSMALLINT paramNr, ParameterDirection direction, bool neverQueryParamDesc /* = false */)
 	{
 		exASSERT(m_pDb);
 
@@ -268,9 +815,11 @@ namespace exodbc
 			paramDesc = boost::apply_visitor(ParamDescVisitor(), column);
 		}
 
-		BindParamVisitor pv(paramNr, m_pHStmt, paramDesc);
+		BindParamVisitor pv(paramNr, m_pHStmt, paramDesc, direction);
 		boost::apply_visitor(pv, column);
 		m_boundParams = true;
+		m_boundParamBytes += boost::apply_visitor(BufferLengthVisitor(), column);
+		m_boundParamBuffers[paramNr] = column;
 	}
 
 
@@ -279,6 +828,92 @@ namespace exodbc
 		exASSERT(m_pHStmt);
 
 		m_pHStmt->UnbindColumns();
+		m_boundColumnBytes = 0;
+		m_useBookmarks = false;
+	}
+
+
+	void ExecutableStatement::SetUseBookmarks(bool useBookmarks)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(!m_isPrepared);
+
+		// Attributes cannot be changed while a cursor is open
+		SelectClose();
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLULEN value = useBookmarks ? SQL_UB_VARIABLE : SQL_UB_OFF;
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_USE_BOOKMARKS, (SQLPOINTER)value, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to set Statement Attr SQL_ATTR_USE_BOOKMARKS to %d") % value));
+
+		m_bookmarkCb = SQL_NULL_DATA;
+		if (useBookmarks)
+		{
+			ret = TRACE_ODBC_CALL(SQLBindCol, hStmt, 0, SQL_C_VARBOOKMARK, (SQLPOINTER)m_bookmarkBuffer, MAX_BOOKMARK_LENGTH, &m_bookmarkCb);
+			THROW_IFN_SUCCEEDED_MSG(SQLBindCol, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to bind the bookmark column");
+			m_boundColumns = true;
+		}
+		else if (m_useBookmarks)
+		{
+			ret = TRACE_ODBC_CALL(SQLBindCol, hStmt, 0, SQL_C_VARBOOKMARK, (SQLPOINTER)NULL, 0, (SQLLEN*)NULL);
+			THROW_IFN_SUCCEEDED_MSG(SQLBindCol, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to unbind the bookmark column");
+		}
+		m_useBookmarks = useBookmarks;
+	}
+
+
+	void ExecutableStatement::BindBookmarkArray(SQLPOINTER pBookmarks, SQLLEN elementLength, SQLLEN* pIndicators)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(pBookmarks);
+		exASSERT(elementLength > 0);
+		exASSERT(pIndicators);
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLBindCol, hStmt, 0, SQL_C_VARBOOKMARK, pBookmarks, elementLength, pIndicators);
+		THROW_IFN_SUCCEEDED_MSG(SQLBindCol, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to bind the bookmark column as array");
+		m_boundColumns = true;
+		// The single bookmark buffer is no longer bound
+		m_useBookmarks = false;
+	}
+
+
+	Bookmark ExecutableStatement::GetBookmark() const
+	{
+		if (!m_useBookmarks)
+		{
+			Exception ex(u8"Bookmarks are not enabled on the statement");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		if (m_bookmarkCb == SQL_NULL_DATA || m_bookmarkCb <= 0)
+		{
+			Exception ex(u8"No row with a bookmark is selected");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		if (m_bookmarkCb > MAX_BOOKMARK_LENGTH)
+		{
+			Exception ex(boost::str(boost::format(u8"Bookmark of %d bytes does not fit into the buffer of %d bytes") % m_bookmarkCb % MAX_BOOKMARK_LENGTH));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		return Bookmark(m_bookmarkBuffer, m_bookmarkBuffer + m_bookmarkCb);
+	}
+
+
+	bool ExecutableStatement::SelectBookmark(const Bookmark& bookmark, SQLLEN offset /* = 0 */)
+	{
+		exASSERT(m_useBookmarks);
+		exASSERT(!bookmark.empty());
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_FETCH_BOOKMARK_PTR, (SQLPOINTER)&bookmark[0], 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_FETCH_BOOKMARK_PTR");
+		// The driver only reads the bookmark during SQLFetchScroll with SQL_FETCH_BOOKMARK
+		return SelectFetchScroll(SQL_FETCH_BOOKMARK, offset);
 	}
 
 
@@ -287,11 +922,38 @@ namespace exodbc
 		exASSERT(m_pHStmt);
 
 		m_pHStmt->ResetParams();
+		m_boundParamBytes = 0;
+		m_boundParamBuffers.clear();
+	}
+
+
+	bool ExecutableStatement::BeginExecution(ExecutionType type, const std::string& sql, SQLLEN bytesBound, const std::vector<ParameterArray>* pParamArrays /* = NULL */, SQLULEN paramSetSize /* = 1 */) const
+	{
+		if (!m_pExecution)
+		{
+			m_pExecution = std::make_shared<ExecutionTracker>();
+		}
+		ExecutionContext context(type, sql);
+		context.m_pParams = &m_boundParamBuffers;
+		context.m_pParamArrays = pParamArrays;
+		context.m_paramSetSize = paramSetSize;
+		context.m_bytesBound = bytesBound;
+		return m_pExecution->Begin(context);
+	}
+
+
+	void ExecutableStatement::EndExecution() const noexcept
+	{
+		if (m_pExecution)
+		{
+			m_pExecution->End();
+		}
 	}
 
 
 	void ExecutableStatement::SelectClose() const
 	{
+		EndExecution();
 		StatementCloser::CloseStmtHandle(m_pHStmt, StatementCloser::Mode::IgnoreNotOpen);
 	}
 
@@ -331,19 +993,220 @@ namespace exodbc
 		exASSERT(m_pHStmt);
 		exASSERT(m_pHStmt->IsAllocated());
 
-		SQLRETURN ret = SQLFetch(m_pHStmt->GetHandle());
-		if (!(SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA))
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Fetch);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle());
+		scope.SetFetched(SQL_SUCCEEDED(ret) ? 1 : 0, !SQL_SUCCEEDED(ret));
+		scope.Stop();
+		return EvaluateFetch(m_pHStmt, ret);
+	}
+
+
+	void ExecutableStatement::ExecuteDirectAsync(const std::string& sqlstmt, ExecuteCompletionHandler onComplete)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(!sqlstmt.empty());
+		exASSERT(onComplete);
+		// Always discard pending results first
+		SelectClose();
+
+		// The statement must stay alive until the operation has completed
+		SqlStmtHandlePtr pHStmt = m_pHStmt;
+		BeginExecution(ExecutionType::ExecuteDirect, sqlstmt, m_boundColumnBytes + m_boundParamBytes);
+		std::shared_ptr<ExecutionScope> pScope = std::make_shared<ExecutionScope>(m_pExecution, ExecutionScope::Phase::Execute);
+		auto pSqlstmt = std::make_shared<std::basic_string<SQLAPICHARTYPE>>(reinterpret_cast<const SQLAPICHARTYPE*>(EXODBCSTR_TO_SQLAPISTR(sqlstmt).c_str()));
+		StartAsync(pHStmt, m_pDb->GetSupportsAsyncStatements(),
+			[pHStmt, pSqlstmt]() { return TRACE_ODBC_CALL(SQLExecDirect, pHStmt->GetHandle(), (SQLAPICHARTYPE*) pSqlstmt->c_str(), SQL_NTS); },
+			[pHStmt, pScope](SQLRETURN ret)
+			{
+				pScope->Stop();
+				THROW_IFN_SUCCEEDED(SQLExecDirect, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
+				return true;
+			},
+			[onComplete](bool, std::exception_ptr pEx) { onComplete(pEx); });
+	}
+
+
+	std::future<void> ExecutableStatement::ExecuteDirectAsync(const std::string& sqlstmt)
+	{
+		std::shared_ptr<std::promise<void>> pPromise = std::make_shared<std::promise<void>>();
+		ExecuteDirectAsync(sqlstmt, [pPromise](std::exception_ptr pEx)
 		{
-			SqlResultException sre(u8"SQLFetch", ret, SQL_HANDLE_STMT, m_pHStmt->GetHandle());
-			SET_EXCEPTION_SOURCE(sre);
-			throw sre;
+			if (pEx)
+				pPromise->set_exception(pEx);
+			else
+				pPromise->set_value();
+		});
+		return pPromise->get_future();
+	}
+
+
+	void ExecutableStatement::ExecutePreparedAsync(ExecuteCompletionHandler onComplete)
+	{
+		exASSERT(m_isPrepared);
+		exASSERT(onComplete);
+
+		// Always discard pending results first
+		SelectClose();
+
+		SqlStmtHandlePtr pHStmt = m_pHStmt;
+		BeginExecution(ExecutionType::ExecutePrepared, m_preparedSql, m_boundColumnBytes + m_boundParamBytes);
+		std::shared_ptr<ExecutionScope> pScope = std::make_shared<ExecutionScope>(m_pExecution, ExecutionScope::Phase::Execute);
+		StartAsync(pHStmt, m_pDb->GetSupportsAsyncStatements(),
+			[pHStmt]() { return TRACE_ODBC_CALL(SQLExecute, pHStmt->GetHandle()); },
+			[pHStmt, pScope](SQLRETURN ret)
+			{
+				pScope->Stop();
+				THROW_IFN_SUCCEEDED(SQLExecute, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
+				return true;
+			},
+			[onComplete](bool, std::exception_ptr pEx) { onComplete(pEx); });
+	}
+
+
+	std::future<void> ExecutableStatement::ExecutePreparedAsync()
+	{
+		std::shared_ptr<std::promise<void>> pPromise = std::make_shared<std::promise<void>>();
+		ExecutePreparedAsync([pPromise](std::exception_ptr pEx)
+		{
+			if (pEx)
+				pPromise->set_exception(pEx);
+			else
+				pPromise->set_value();
+		});
+		return pPromise->get_future();
+	}
+
+
+	void ExecutableStatement::SelectNextAsync(FetchCompletionHandler onComplete)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(onComplete);
+
+		SqlStmtHandlePtr pHStmt = m_pHStmt;
+		std::shared_ptr<ExecutionScope> pScope = std::make_shared<ExecutionScope>(m_pExecution, ExecutionScope::Phase::Fetch);
+		StartAsync(pHStmt, m_pDb->GetSupportsAsyncStatements(),
+			[pHStmt]() { return TRACE_ODBC_CALL(SQLFetch, pHStmt->GetHandle()); },
+			[pHStmt, pScope](SQLRETURN ret)
+			{
+				pScope->SetFetched(SQL_SUCCEEDED(ret) ? 1 : 0, !SQL_SUCCEEDED(ret));
+				pScope->Stop();
+				return EvaluateFetch(pHStmt, ret);
+			},
+			onComplete);
+	}
+
+
+	std::future<bool> ExecutableStatement::SelectNextAsync()
+	{
+		std::shared_ptr<std::promise<bool>> pPromise = std::make_shared<std::promise<bool>>();
+		SelectNextAsync([pPromise](bool fetched, std::exception_ptr pEx)
+		{
+			if (pEx)
+				pPromise->set_exception(pEx);
+			else
+				pPromise->set_value(fetched);
+		});
+		return pPromise->get_future();
+	}
+
+
+	void ExecutableStatement::NextBlockAsync(RowBlock& block, FetchCompletionHandler onComplete)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(block.m_pHStmt == m_pHStmt);
+		exASSERT(onComplete);
+
+		if (!block.IsFetchDue())
+		{
+			// The next block is already known to be there or not
+			bool fetched = false;
+			std::exception_ptr pEx;
+			try
+			{
+				fetched = block.NextBlock();
+			}
+			catch (...)
+			{
+				pEx = std::current_exception();
+			}
+			onComplete(fetched, pEx);
+			return;
 		}
-		if (ret == SQL_SUCCESS_WITH_INFO)
+
+		SqlStmtHandlePtr pHStmt = m_pHStmt;
+		RowBlock* pBlock = &block;
+		pBlock->BeginFetch();
+		std::shared_ptr<ExecutionScope> pScope = std::make_shared<ExecutionScope>(pBlock->m_pExecution, ExecutionScope::Phase::Fetch);
+		StartAsync(pHStmt, m_pDb->GetSupportsAsyncStatements(),
+			[pHStmt]() { return TRACE_ODBC_CALL(SQLFetch, pHStmt->GetHandle()); },
+			[pBlock, pScope](SQLRETURN ret) { return pBlock->EndFetch(ret, *pScope); },
+			onComplete);
+	}
+
+
+	std::future<bool> ExecutableStatement::NextBlockAsync(RowBlock& block)
+	{
+		std::shared_ptr<std::promise<bool>> pPromise = std::make_shared<std::promise<bool>>();
+		NextBlockAsync(block, [pPromise](bool fetched, std::exception_ptr pEx)
 		{
-			LOG_WARNING_STMT(m_pHStmt->GetHandle(), ret, SQLFetch);
+			if (pEx)
+				pPromise->set_exception(pEx);
+			else
+				pPromise->set_value(fetched);
+		});
+		return pPromise->get_future();
+	}
+
+
+	RowRange ExecutableStatement::Rows(SQLULEN blockSize /* = DEFAULT_ROW_BLOCK_SIZE */)
+	{
+		exASSERT(m_pDb);
+
+		Sql2BufferTypeMapPtr pSql2BufferTypeMap = m_pDb->GetSql2BufferTypeMap();
+		SQLSMALLINT nrOfColumns = GetNrOfColumns();
+		exASSERT_MSG(nrOfColumns > 0, u8"No result set is open");
+
+		vector<RowColumnDefinition> columns;
+		columns.reserve(nrOfColumns);
+		for (SQLUSMALLINT columnNr = 1; columnNr <= (SQLUSMALLINT)nrOfColumns; ++columnNr)
+		{
+			ColumnDescription colDesc = DescribeColumn(columnNr);
+			SQLSMALLINT sqlCType = pSql2BufferTypeMap->GetBufferType(colDesc.GetSqlType());
+			SQLLEN nrOfElements = 1;
+			if (sqlCType == SQL_C_CHAR || sqlCType == SQL_C_WCHAR || sqlCType == SQL_C_BINARY)
+			{
+				// Character columns need room for the terminating 0. Drivers report 0 or SQL_NO_TOTAL if the size is unknown.
+				// LOB columns report sizes like 4294967295 (MySQL LONGTEXT) or 2^31-1 (Oracle CLOB): Do not allocate
+				// blockSize elements of that size, cap them and let the values be truncated.
+				SQLLEN charSize = (SQLLEN)colDesc.GetCharSize();
+				if (charSize <= 0)
+				{
+					charSize = SQL_NO_TOTAL_BUFFER_LENGTH;
+				}
+				else if (charSize > SQL_NO_TOTAL_BUFFER_LENGTH)
+				{
+					LOG_DEBUG(boost::str(boost::format(u8"Column '%s' reports a size of %d, binding it with a buffer of %d elements. Longer values are truncated, use SQLGetData to read them completely") % colDesc.GetName() % charSize % SQL_NO_TOTAL_BUFFER_LENGTH));
+					charSize = SQL_NO_TOTAL_BUFFER_LENGTH;
+				}
+				nrOfElements = sqlCType == SQL_C_BINARY ? charSize : charSize + 1;
+			}
+			columns.push_back(RowColumnDefinition(colDesc.GetName(), sqlCType, nrOfElements, (SQLINTEGER)colDesc.GetCharSize(), colDesc.GetDecimalDigits()));
 		}
 
-		return SQL_SUCCEEDED(ret);
+		return Rows(columns, blockSize);
+	}
+
+
+	RowRange ExecutableStatement::Rows(const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize /* = DEFAULT_ROW_BLOCK_SIZE */)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+
+		UnbindColumns();
+		return RowRange(m_pHStmt, columns, blockSize, m_pExecution);
 	}
 
 
@@ -353,7 +1216,11 @@ namespace exodbc
 		exASSERT(m_pHStmt);
 		exASSERT(m_pHStmt->IsAllocated());
 
-		SQLRETURN ret = SQLFetchScroll(m_pHStmt->GetHandle(), fetchOrientation, fetchOffset);
+		// A scrollable cursor can be moved back after SQL_NO_DATA, the execution ends on SelectClose()
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Fetch);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLFetchScroll, m_pHStmt->GetHandle(), fetchOrientation, fetchOffset);
+		scope.SetFetched(SQL_SUCCEEDED(ret) ? 1 : 0, false);
+		scope.Stop();
 		if (!(SQL_SUCCEEDED(ret) || ret == SQL_NO_DATA))
 		{
 			std::string msg = boost::str(boost::format(u8"Failed in SQLFetchScroll with FetchOrientation %d") % fetchOrientation);
@@ -0,0 +1,158 @@
+﻿/*!
+* \file ExecutionScope.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the ExecutionTracker and ExecutionScope classes.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "ExecutionScope.h"
+
+// Same component headers
+#include "SlowQueryLog.h"
+#include "SessionRecorder.h"
+
+// Other headers
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// ExecutionTracker
+	// ================
+	ExecutionTracker::ExecutionTracker()
+		: m_pMetricsSink(NULL)
+	{
+		std::unique_ptr<StatementMetricsSink> pMetricsSink(new StatementMetricsSink());
+		m_pMetricsSink = pMetricsSink.get();
+		m_sinks.push_back(std::move(pMetricsSink));
+		m_sinks.push_back(std::unique_ptr<ExecutionSink>(new SlowQueryTracker()));
+		m_sinks.push_back(std::unique_ptr<ExecutionSink>(new SessionTracker()));
+	}
+
+
+	ExecutionTracker::~ExecutionTracker()
+	{
+		End();
+	}
+
+
+	bool ExecutionTracker::Begin(const ExecutionContext& context)
+	{
+		End();
+
+		bool interested = false;
+		for (std::unique_ptr<ExecutionSink>& pSink : m_sinks)
+		{
+			if (pSink->Begin(context))
+			{
+				interested = true;
+			}
+		}
+		return interested;
+	}
+
+
+	bool ExecutionTracker::IsActive() const noexcept
+	{
+		for (const std::unique_ptr<ExecutionSink>& pSink : m_sinks)
+		{
+			if (pSink->IsActive())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	void ExecutionTracker::AddExecute(std::chrono::nanoseconds elapsed) noexcept
+	{
+		for (std::unique_ptr<ExecutionSink>& pSink : m_sinks)
+		{
+			if (pSink->IsActive())
+			{
+				pSink->AddExecute(elapsed);
+			}
+		}
+	}
+
+
+	void ExecutionTracker::AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept
+	{
+		for (std::unique_ptr<ExecutionSink>& pSink : m_sinks)
+		{
+			if (pSink->IsActive())
+			{
+				pSink->AddFetch(elapsed, rows);
+			}
+		}
+	}
+
+
+	void ExecutionTracker::End() noexcept
+	{
+		for (std::unique_ptr<ExecutionSink>& pSink : m_sinks)
+		{
+			pSink->End();
+		}
+	}
+
+
+	StatementMetricsPtr ExecutionTracker::GetMetrics() const noexcept
+	{
+		return m_pMetricsSink->GetMetrics();
+	}
+
+
+	// ExecutionScope
+	// ==============
+	ExecutionScope::ExecutionScope(ExecutionTrackerPtr pExecution, Phase phase)
+		: m_phase(phase)
+		, m_rows(0)
+		, m_endOfResult(false)
+	{
+		if (pExecution && pExecution->IsActive())
+		{
+			m_pExecution = pExecution;
+			m_start = std::chrono::steady_clock::now();
+		}
+	}
+
+
+	ExecutionScope::~ExecutionScope()
+	{
+		Stop();
+	}
+
+
+	void ExecutionScope::Stop() noexcept
+	{
+		if (!m_pExecution)
+		{
+			return;
+		}
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - m_start;
+		if (m_phase == Phase::Execute)
+		{
+			m_pExecution->AddExecute(elapsed);
+		}
+		else
+		{
+			m_pExecution->AddFetch(elapsed, m_rows);
+			if (m_endOfResult)
+			{
+				m_pExecution->End();
+			}
+		}
+		m_pExecution.reset();
+	}
+}
@@ -0,0 +1,81 @@
+﻿/*!
+* \file ForeignKeyInfo.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for ForeignKeyInfo.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "ForeignKeyInfo.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "GetDataWrapper.h"
+
+// Other headers
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// Class ForeignKeyInfo
+	// ====================
+	ForeignKeyInfo::ForeignKeyInfo()
+		: m_keySequence(0)
+		, m_updateRule(0)
+		, m_deleteRule(0)
+		, m_deferrability(0)
+		, m_isPkCatalogNull(true)
+		, m_isPkSchemaNull(true)
+		, m_isFkCatalogNull(true)
+		, m_isFkSchemaNull(true)
+		, m_isUpdateRuleNull(true)
+		, m_isDeleteRuleNull(true)
+		, m_isFkNameNull(true)
+		, m_isPkNameNull(true)
+		, m_isDeferrabilityNull(true)
+	{}
+
+
+	ForeignKeyInfo::ForeignKeyInfo(const std::string& pkTableName, const std::string& pkColumnName, const std::string& fkTableName,
+		const std::string& fkColumnName, SQLSMALLINT keySequence)
+		: ForeignKeyInfo()
+	{
+		m_pkTableName = pkTableName;
+		m_pkColumnName = pkColumnName;
+		m_fkTableName = fkTableName;
+		m_fkColumnName = fkColumnName;
+		m_keySequence = keySequence;
+	}
+
+
+	ForeignKeyInfo::ForeignKeyInfo(ConstSqlStmtHandlePtr pStmt, const SqlInfoProperties& props)
+		: ForeignKeyInfo()
+	{
+		exASSERT(pStmt);
+		exASSERT(pStmt->IsAllocated());
+
+		SQLLEN cb = 0;
+		GetDataWrapper::GetData(pStmt, 1, props.GetMaxCatalogNameLen(), m_pkCatalogName, &m_isPkCatalogNull);
+		GetDataWrapper::GetData(pStmt, 2, props.GetMaxSchemaNameLen(), m_pkSchemaName, &m_isPkSchemaNull);
+		GetDataWrapper::GetData(pStmt, 3, props.GetMaxTableNameLen(), m_pkTableName);
+		GetDataWrapper::GetData(pStmt, 4, props.GetMaxColumnNameLen(), m_pkColumnName);
+		GetDataWrapper::GetData(pStmt, 5, props.GetMaxCatalogNameLen(), m_fkCatalogName, &m_isFkCatalogNull);
+		GetDataWrapper::GetData(pStmt, 6, props.GetMaxSchemaNameLen(), m_fkSchemaName, &m_isFkSchemaNull);
+		GetDataWrapper::GetData(pStmt, 7, props.GetMaxTableNameLen(), m_fkTableName);
+		GetDataWrapper::GetData(pStmt, 8, props.GetMaxColumnNameLen(), m_fkColumnName);
+		GetDataWrapper::GetData(pStmt, 9, SQL_C_SSHORT, &m_keySequence, sizeof(m_keySequence), &cb, nullptr);
+		GetDataWrapper::GetData(pStmt, 10, SQL_C_SSHORT, &m_updateRule, sizeof(m_updateRule), &cb, &m_isUpdateRuleNull);
+		GetDataWrapper::GetData(pStmt, 11, SQL_C_SSHORT, &m_deleteRule, sizeof(m_deleteRule), &cb, &m_isDeleteRuleNull);
+		GetDataWrapper::GetData(pStmt, 12, DB_MAX_FOREIGN_KEY_NAME_LEN, m_fkName, &m_isFkNameNull);
+		GetDataWrapper::GetData(pStmt, 13, DB_MAX_PRIMARY_KEY_NAME_LEN, m_pkName, &m_isPkNameNull);
+		GetDataWrapper::GetData(pStmt, 14, SQL_C_SSHORT, &m_deferrability, sizeof(m_deferrability), &cb, &m_isDeferrabilityNull);
+	}
+}
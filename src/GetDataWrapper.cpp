@@ -11,6 +11,7 @@
 
 // Same component headers
 #include "LogManagerOdbcMacros.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -36,7 +37,7 @@ namespace exodbc
 		exASSERT(strLenOrIndPtr != NULL);
 
 		bool isNull;
-		SQLRETURN ret = SQLGetData(pHStmt->GetHandle(), colOrParamNr, targetType, pTargetValue, bufferLen, strLenOrIndPtr);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetData, pHStmt->GetHandle(), colOrParamNr, targetType, pTargetValue, bufferLen, strLenOrIndPtr);
 		THROW_IFN_SUCCEEDED_MSG(SQLGetData, ret, SQL_HANDLE_STMT, pHStmt->GetHandle(), (boost::format(u8"SGLGetData failed for Column %d") % colOrParamNr).str());
 
 		isNull = (*strLenOrIndPtr == SQL_NULL_DATA);
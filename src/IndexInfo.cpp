@@ -0,0 +1,128 @@
+﻿/*!
+* \file IndexInfo.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for IndexInfo and TableStatistics.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "IndexInfo.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "GetDataWrapper.h"
+
+// Other headers
+#include <algorithm>
+#include <iterator>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// Class IndexInfo
+	// ===============
+	IndexInfo::IndexInfo()
+		: m_nonUnique(SQL_FALSE)
+		, m_type(IndexType::TABLE_STAT)
+		, m_ordinalPosition(0)
+		, m_cardinality(0)
+		, m_pages(0)
+		, m_isCatalogNull(true)
+		, m_isSchemaNull(true)
+		, m_isNonUniqueNull(true)
+		, m_isIndexQualifierNull(true)
+		, m_isIndexNameNull(true)
+		, m_isOrdinalPositionNull(true)
+		, m_isColumnNameNull(true)
+		, m_isAscOrDescNull(true)
+		, m_isCardinalityNull(true)
+		, m_isPagesNull(true)
+		, m_isFilterConditionNull(true)
+	{}
+
+
+	IndexInfo::IndexInfo(ConstSqlStmtHandlePtr pStmt, const SqlInfoProperties& props)
+		: IndexInfo()
+	{
+		exASSERT(pStmt);
+		exASSERT(pStmt->IsAllocated());
+
+		SQLLEN cb = 0;
+		SQLSMALLINT type = 0;
+		GetDataWrapper::GetData(pStmt, 1, props.GetMaxCatalogNameLen(), m_catalogName, &m_isCatalogNull);
+		GetDataWrapper::GetData(pStmt, 2, props.GetMaxSchemaNameLen(), m_schemaName, &m_isSchemaNull);
+		GetDataWrapper::GetData(pStmt, 3, props.GetMaxTableNameLen(), m_tableName);
+		GetDataWrapper::GetData(pStmt, 4, SQL_C_SSHORT, &m_nonUnique, sizeof(m_nonUnique), &cb, &m_isNonUniqueNull);
+		GetDataWrapper::GetData(pStmt, 5, DB_MAX_INDEX_NAME_LEN, m_indexQualifier, &m_isIndexQualifierNull);
+		GetDataWrapper::GetData(pStmt, 6, DB_MAX_INDEX_NAME_LEN, m_indexName, &m_isIndexNameNull);
+		GetDataWrapper::GetData(pStmt, 7, SQL_C_SSHORT, &type, sizeof(type), &cb, nullptr);
+		GetDataWrapper::GetData(pStmt, 8, SQL_C_SSHORT, &m_ordinalPosition, sizeof(m_ordinalPosition), &cb, &m_isOrdinalPositionNull);
+		GetDataWrapper::GetData(pStmt, 9, props.GetMaxColumnNameLen(), m_columnName, &m_isColumnNameNull);
+		GetDataWrapper::GetData(pStmt, 10, DB_MAX_YES_NO_LEN, m_ascOrDesc, &m_isAscOrDescNull);
+		GetDataWrapper::GetData(pStmt, 11, SQL_C_SLONG, &m_cardinality, sizeof(m_cardinality), &cb, &m_isCardinalityNull);
+		GetDataWrapper::GetData(pStmt, 12, SQL_C_SLONG, &m_pages, sizeof(m_pages), &cb, &m_isPagesNull);
+		GetDataWrapper::GetData(pStmt, 13, DB_MAX_FILTER_CONDITION_LEN, m_filterCondition, &m_isFilterConditionNull);
+		m_type = (IndexType)type;
+	}
+
+
+	// Class TableStatistics
+	// =====================
+	TableStatistics::TableStatistics()
+	{}
+
+
+	TableStatistics::TableStatistics(const IndexInfoVector& rows)
+	{
+		for (const IndexInfo& row : rows)
+		{
+			if (row.IsTableStatistics())
+			{
+				m_tableStat = row;
+			}
+			else
+			{
+				m_indexColumns.push_back(row);
+			}
+		}
+	}
+
+
+	std::vector<std::string> TableStatistics::GetIndexNames() const
+	{
+		vector<string> names;
+		for (const IndexInfo& column : m_indexColumns)
+		{
+			string name = column.GetIndexName();
+			if (std::find(names.begin(), names.end(), name) == names.end())
+			{
+				names.push_back(name);
+			}
+		}
+		return names;
+	}
+
+
+	IndexInfoVector TableStatistics::GetIndexColumns(const std::string& indexName) const
+	{
+		IndexInfoVector columns;
+		std::copy_if(m_indexColumns.begin(), m_indexColumns.end(), std::back_inserter(columns), [&indexName](const IndexInfo& column)
+		{
+			return column.GetIndexName() == indexName;
+		});
+		std::stable_sort(columns.begin(), columns.end(), [](const IndexInfo& a, const IndexInfo& b)
+		{
+			return a.GetOrdinalPosition() < b.GetOrdinalPosition();
+		});
+		return columns;
+	}
+}
@@ -27,6 +27,25 @@ using namespace std;
 
 namespace exodbc
 {
+	namespace
+	{
+		/*!
+		* \brief	The current local time. Unlike std::localtime() safe to call from several threads.
+		*/
+		std::tm LocalTimeNow()
+		{
+			std::time_t t = std::time(nullptr);
+			std::tm tm;
+#ifdef _WIN32
+			localtime_s(&tm, &t);
+#else
+			localtime_r(&t, &tm);
+#endif
+			return tm;
+		}
+	}
+
+
 	std::string LogHandlerBase::FormatLogMessage(LogLevel level, const std::string& msg, const std::string& filename /* = u8"" */, int line /* = 0 */, const std::string& functionname /* = u8"" */) const noexcept
 	{
 		std::stringstream ss;
@@ -177,8 +196,7 @@ namespace exodbc
 		{
 			if (m_prependTimestamp)
 			{
-                std::time_t t = std::time(nullptr);
-                std::tm tm = *std::localtime(&t);
+				std::tm tm = LocalTimeNow();
 				m_filestream << std::put_time(&tm, "%d-%m-%Y %H-%M-%S") << u8": ";
 			}
 
@@ -202,4 +220,161 @@ namespace exodbc
 		}
 	}
 
+	AsyncFileLogHandler::AsyncFileLogHandler(const std::string& filepath, bool prependTimestamp, OverflowPolicy policy /* = OverflowPolicy::Drop */, size_t queueCapacity /* = DEFAULT_QUEUE_CAPACITY */)
+		: LogHandlerBase()
+		, m_filepath(filepath)
+		, m_prependTimestamp(prependTimestamp)
+		, m_policy(policy)
+		, m_queue(queueCapacity)
+		, m_queuedCount(0)
+		, m_droppedCount(0)
+		, m_writtenCount(0)
+		, m_flushWaiters(0)
+		, m_writerIdle(false)
+		, m_stop(false)
+	{
+		m_thread = std::thread(&AsyncFileLogHandler::Run, this);
+	}
+
+
+	AsyncFileLogHandler::~AsyncFileLogHandler()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_queuedCondition.notify_one();
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+		if (m_filestream.is_open())
+		{
+			m_filestream.close();
+		}
+	}
+
+
+	void AsyncFileLogHandler::OnLogMessage(LogLevel level, const std::string& msg, const std::string& filename /* = u8"" */, int line /* = 0 */, const std::string& functionname /* = u8"" */) const
+	{
+		if (CustomLogLevelHidesMsg(level))
+			return;
+
+		std::stringstream ss;
+		if (m_prependTimestamp)
+		{
+			std::tm tm = LocalTimeNow();
+			ss << std::put_time(&tm, "%d-%m-%Y %H-%M-%S") << u8": ";
+		}
+		ss << FormatLogMessage(level, msg, filename, line, functionname);
+		std::string record = ss.str();
+
+		while (!m_queue.TryPush(record))
+		{
+			if (m_policy == OverflowPolicy::Drop)
+			{
+				++m_droppedCount;
+				return;
+			}
+			// Wait for the writer to make room, but do not rely on being notified
+			m_queuedCondition.notify_one();
+			unique_lock<mutex> lock(m_mutex);
+			m_writtenCondition.wait_for(lock, std::chrono::milliseconds(1));
+		}
+		++m_queuedCount;
+
+		if (m_writerIdle.load())
+		{
+			m_queuedCondition.notify_one();
+		}
+	}
+
+
+	void AsyncFileLogHandler::Flush() const
+	{
+		unsigned long long queued = m_queuedCount.load();
+		// Without a waiting Flush(), the writer only flushes once the queue runs empty
+		++m_flushWaiters;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			while (m_writtenCount.load() < queued)
+			{
+				m_queuedCondition.notify_one();
+				m_writtenCondition.wait_for(lock, std::chrono::milliseconds(10));
+			}
+		}
+		--m_flushWaiters;
+	}
+
+
+	void AsyncFileLogHandler::Run()
+	{
+		// Limit the batch size so Flush() and blocked producers are served regularly
+		const size_t maxBatchSize = 256;
+		std::string record;
+		unsigned long long unflushed = 0;
+		while (true)
+		{
+			size_t batchSize = 0;
+			while (batchSize < maxBatchSize && m_queue.TryPop(record))
+			{
+				if (!m_filestream.is_open())
+				{
+					m_filestream.open(m_filepath, std::ofstream::out);
+				}
+				m_filestream << record << u8"\n";
+				++batchSize;
+			}
+			unflushed += batchSize;
+
+			// A short batch means the queue has run empty
+			if (unflushed > 0 && (batchSize < maxBatchSize || m_flushWaiters.load() > 0))
+			{
+				m_filestream.flush();
+				m_writtenCount += unflushed;
+				unflushed = 0;
+				{
+					// Make sure a thread about to wait in Flush() does not miss the notification
+					lock_guard<mutex> lock(m_mutex);
+				}
+				m_writtenCondition.notify_all();
+			}
+			else if (batchSize > 0)
+			{
+				// Blocked producers can push again
+				m_writtenCondition.notify_all();
+			}
+			if (batchSize > 0)
+			{
+				continue;
+			}
+
+			// The queue is empty
+			unique_lock<mutex> lock(m_mutex);
+			if (m_stop)
+			{
+				return;
+			}
+			// Producers only notify an idle writer. If a notification is missed, the timeout picks up the messages
+			m_writerIdle = true;
+			m_queuedCondition.wait_for(lock, std::chrono::milliseconds(10), [this] { return m_stop.load() || m_queue.GetSizeApprox() > 0; });
+			m_writerIdle = false;
+		}
+	}
+
+
+	bool AsyncFileLogHandler::operator==(const LogHandler& other) const
+	{
+		try
+		{
+			// equal if the same file
+			auto& otherFileLogger = dynamic_cast<const AsyncFileLogHandler&>(other);
+			return otherFileLogger.GetFilepath() == GetFilepath();
+		}
+		catch (const std::bad_cast& ex)
+		{
+			HIDE_UNUSED(ex);
+			return false;
+		}
+	}
 }
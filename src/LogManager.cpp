@@ -45,10 +45,11 @@ namespace exodbc
 	}
 
 	LogManager::LogManager()
-#ifdef _DEBUG
-		: m_globalLogLevel(LogLevel::Debug)
+		: m_pLogHandlers(std::make_shared<const std::vector<LogHandlerPtr>>())
+#ifdef NDEBUG
+		, m_globalLogLevel(LogLevel::Info)
 #else
-		: m_globalLogLevel(LogLevel::Info)
+		, m_globalLogLevel(LogLevel::Debug)
 #endif
 	{
 		LogHandlerPtr pDefaultHandler = std::make_shared<StdLogHandler>();
@@ -59,7 +60,7 @@ namespace exodbc
 	void LogManager::ClearLogHandlers() noexcept
 	{
 		lock_guard<mutex> lock(m_logHandlersMutex);
-		m_logHandlers.clear();
+		std::atomic_store(&m_pLogHandlers, LogHandlersPtr(std::make_shared<const std::vector<LogHandlerPtr>>()));
 	}
 
 
@@ -69,7 +70,7 @@ namespace exodbc
 		
 		lock_guard<mutex> lock(m_logHandlersMutex);
 		// Only register if not already registerd
-		for (auto it = m_logHandlers.begin(); it != m_logHandlers.end(); ++it)
+		for (auto it = m_pLogHandlers->begin(); it != m_pLogHandlers->end(); ++it)
 		{
 			LogHandlerPtr pLogHanlder = *it;
 			if (*pLogHanlder == *pHandler)
@@ -77,25 +78,35 @@ namespace exodbc
 				return;
 			}
 		}
-		m_logHandlers.push_back(pHandler);
+		std::shared_ptr<std::vector<LogHandlerPtr>> pHandlers = std::make_shared<std::vector<LogHandlerPtr>>(*m_pLogHandlers);
+		pHandlers->push_back(pHandler);
+		std::atomic_store(&m_pLogHandlers, LogHandlersPtr(pHandlers));
 	}
 
 
 	void LogManager::RemoveLogHandler(LogHandlerPtr pHandler)
 	{
 		lock_guard<mutex> lock(m_logHandlersMutex);
-		for (auto it = m_logHandlers.begin(); it != m_logHandlers.end(); ++it)
+		std::shared_ptr<std::vector<LogHandlerPtr>> pHandlers = std::make_shared<std::vector<LogHandlerPtr>>(*m_pLogHandlers);
+		for (auto it = pHandlers->begin(); it != pHandlers->end(); ++it)
 		{
 			LogHandlerPtr pLogHanlder = *it;
 			if (*pLogHanlder == *pHandler)
 			{
-				m_logHandlers.erase(it);
+				pHandlers->erase(it);
+				std::atomic_store(&m_pLogHandlers, LogHandlersPtr(pHandlers));
 				return;
 			}
 		}
 	}
 
 
+	LogManager::LogHandlersPtr LogManager::GetLogHandlersSnapshot() const noexcept
+	{
+		return std::atomic_load(&m_pLogHandlers);
+	}
+
+
 #ifdef _WIN32
 	void LogManager::LogMessage(LogLevel level, const std::wstring& msg, const std::wstring& file /* = L"" */, int line /* = 0 */, const std::wstring& functionName /* = L"" */) const
 	{
@@ -105,15 +116,13 @@ namespace exodbc
 
 	void LogManager::LogMessage(LogLevel level, const std::string& msg, const std::string& file /* = u8"" */, int line /* = 0 */, const std::string& functionName /* = u8"" */) const
 	{
+		if (!IsLogLevelEnabled(level))
 		{
-			lock_guard<mutex> lock(m_globalLogLevelMutex);
-			if (level < m_globalLogLevel)
-			{
-				return;
-			}
+			return;
 		}
-		lock_guard<mutex> lock(m_logHandlersMutex);
-		for (auto it = m_logHandlers.begin(); it != m_logHandlers.end(); ++it)
+		// Handlers removed meanwhile may still get this message, the snapshot keeps them alive
+		LogHandlersPtr pHandlers = GetLogHandlersSnapshot();
+		for (auto it = pHandlers->begin(); it != pHandlers->end(); ++it)
 		{
 			(*it)->OnLogMessage(level, msg, file, line, functionName);
 		}
@@ -152,28 +161,24 @@ namespace exodbc
 
 	size_t LogManager::GetRegisteredLogHandlersCount() const noexcept
 	{
-		lock_guard<mutex> lock(m_logHandlersMutex);
-		return m_logHandlers.size();
+		return GetLogHandlersSnapshot()->size();
 	}
 
 
 	std::vector<LogHandlerPtr> LogManager::GetLogHandlers() const noexcept
 	{
-		lock_guard<mutex> lock(m_logHandlersMutex);
-		return m_logHandlers;
+		return *GetLogHandlersSnapshot();
 	}
 
 
 	void LogManager::SetGlobalLogLevel(LogLevel level) noexcept
 	{
-		lock_guard<mutex> lock(m_globalLogLevelMutex);
-		m_globalLogLevel = level;
+		m_globalLogLevel.store(level);
 	}
 
 
 	LogLevel LogManager::GetGlobalLogLevel() const noexcept
 	{
-		lock_guard<mutex> lock(m_globalLogLevelMutex);
-		return m_globalLogLevel;
+		return m_globalLogLevel.load();
 	}
 }
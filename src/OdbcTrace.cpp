@@ -0,0 +1,325 @@
+﻿/*!
+* \file OdbcTrace.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the OdbcTracer and its latency histograms.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "OdbcTrace.h"
+
+// Same component headers
+#include "AssertionException.h"
+
+// Other headers
+#include <cmath>
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	namespace
+	{
+		/*!
+		* \brief	Position of the highest bit set in value, which must not be 0.
+		*/
+		unsigned HighestBit(unsigned long long value) noexcept
+		{
+#if defined(__GNUC__)
+			return 63 - (unsigned) __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_WIN64)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return (unsigned) index;
+#else
+			unsigned bit = 0;
+			while (value >>= 1)
+			{
+				++bit;
+			}
+			return bit;
+#endif
+		}
+	}
+
+
+	// LatencyHistogram
+	// ================
+	LatencyHistogram::LatencyHistogram()
+		: m_count(0)
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			m_buckets[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+
+	size_t LatencyHistogram::GetBucketIndex(unsigned long long value) noexcept
+	{
+		if (value < SUB_BUCKET_COUNT)
+		{
+			return (size_t) value;
+		}
+		unsigned exponent = HighestBit(value);
+		size_t subBucket = (size_t) (value >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKET_COUNT;
+		return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+	}
+
+
+	unsigned long long LatencyHistogram::GetBucketLowerBound(size_t bucket) noexcept
+	{
+		if (bucket < SUB_BUCKET_COUNT)
+		{
+			return bucket;
+		}
+		unsigned exponent = (unsigned) (bucket / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+		unsigned long long subBucket = bucket % SUB_BUCKET_COUNT;
+		return (SUB_BUCKET_COUNT + subBucket) << (exponent - SUB_BUCKET_BITS);
+	}
+
+
+	unsigned long long LatencyHistogram::GetBucketUpperBound(size_t bucket) noexcept
+	{
+		if (bucket < SUB_BUCKET_COUNT)
+		{
+			return bucket;
+		}
+		unsigned exponent = (unsigned) (bucket / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+		return GetBucketLowerBound(bucket) + ((1ULL << (exponent - SUB_BUCKET_BITS)) - 1);
+	}
+
+
+	void LatencyHistogram::Record(unsigned long long value) noexcept
+	{
+		m_buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+
+	unsigned long long LatencyHistogram::GetCount() const noexcept
+	{
+		return m_count.load(std::memory_order_relaxed);
+	}
+
+
+	unsigned long long LatencyHistogram::GetBucketCount(size_t bucket) const
+	{
+		exASSERT(bucket < BUCKET_COUNT);
+		return m_buckets[bucket].load(std::memory_order_relaxed);
+	}
+
+
+	unsigned long long LatencyHistogram::GetValueAtPercentile(double percentile) const noexcept
+	{
+		// Sum up the buckets instead of reading m_count, they might be updated while we iterate
+		unsigned long long total = 0;
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			total += m_buckets[i].load(std::memory_order_relaxed);
+		}
+		if (total == 0)
+		{
+			return 0;
+		}
+
+		percentile = std::min(std::max(percentile, 0.0), 100.0);
+		unsigned long long target = (unsigned long long) std::ceil(percentile / 100.0 * total);
+		target = std::max(target, 1ULL);
+		unsigned long long seen = 0;
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			seen += m_buckets[i].load(std::memory_order_relaxed);
+			if (seen >= target)
+			{
+				return GetBucketUpperBound(i);
+			}
+		}
+		return GetBucketUpperBound(BUCKET_COUNT - 1);
+	}
+
+
+	void LatencyHistogram::Reset() noexcept
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			m_buckets[i].store(0, std::memory_order_relaxed);
+		}
+		m_count.store(0, std::memory_order_relaxed);
+	}
+
+
+	// OdbcCallStats
+	// =============
+	OdbcCallStats::OdbcCallStats(const std::string& functionName)
+		: m_functionName(functionName)
+		, m_errorCount(0)
+		, m_totalNs(0)
+		, m_maxNs(0)
+	{ }
+
+
+	void OdbcCallStats::Record(std::chrono::nanoseconds elapsed, SQLRETURN ret) noexcept
+	{
+		long long ns = std::max((long long) elapsed.count(), 0LL);
+		m_histogram.Record((unsigned long long) ns);
+		m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+		long long max = m_maxNs.load(std::memory_order_relaxed);
+		while (ns > max && !m_maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+		{ }
+		if (ret == SQL_ERROR || ret == SQL_INVALID_HANDLE)
+		{
+			m_errorCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+
+	OdbcCallStatistics OdbcCallStats::GetStatistics() const
+	{
+		OdbcCallStatistics statistics;
+		statistics.m_functionName = m_functionName;
+		statistics.m_callCount = m_histogram.GetCount();
+		statistics.m_errorCount = m_errorCount.load(std::memory_order_relaxed);
+		statistics.m_totalTime = std::chrono::nanoseconds(m_totalNs.load(std::memory_order_relaxed));
+		statistics.m_maxTime = std::chrono::nanoseconds(m_maxNs.load(std::memory_order_relaxed));
+		statistics.m_p50 = std::chrono::nanoseconds(m_histogram.GetValueAtPercentile(50.0));
+		statistics.m_p90 = std::chrono::nanoseconds(m_histogram.GetValueAtPercentile(90.0));
+		statistics.m_p99 = std::chrono::nanoseconds(m_histogram.GetValueAtPercentile(99.0));
+		statistics.m_p999 = std::chrono::nanoseconds(m_histogram.GetValueAtPercentile(99.9));
+		return statistics;
+	}
+
+
+	void OdbcCallStats::Reset() noexcept
+	{
+		m_histogram.Reset();
+		m_errorCount.store(0, std::memory_order_relaxed);
+		m_totalNs.store(0, std::memory_order_relaxed);
+		m_maxNs.store(0, std::memory_order_relaxed);
+	}
+
+
+	// OdbcTracer
+	// ==========
+	OdbcTracer::OdbcTracer()
+		: m_enabled(false)
+		, m_sampleCapacity(0)
+		, m_sampleMinElapsed(0)
+		, m_nextSample(0)
+	{ }
+
+
+	OdbcTracer& OdbcTracer::Get()
+	{
+		static OdbcTracer* pTracer = new OdbcTracer();
+		return *pTracer;
+	}
+
+
+	OdbcCallStats& OdbcTracer::GetCallStats(const std::string& functionName)
+	{
+		std::lock_guard<std::mutex> lock(m_statsMutex);
+		std::unique_ptr<OdbcCallStats>& pStats = m_stats[functionName];
+		if (!pStats)
+		{
+			pStats.reset(new OdbcCallStats(functionName));
+		}
+		return *pStats;
+	}
+
+
+	std::vector<OdbcCallStatistics> OdbcTracer::GetStatistics() const
+	{
+		std::vector<OdbcCallStatistics> statistics;
+		std::lock_guard<std::mutex> lock(m_statsMutex);
+		for (auto it = m_stats.begin(); it != m_stats.end(); ++it)
+		{
+			if (it->second->GetHistogram().GetCount() > 0)
+			{
+				statistics.push_back(it->second->GetStatistics());
+			}
+		}
+		return statistics;
+	}
+
+
+	void OdbcTracer::Reset()
+	{
+		{
+			// The OdbcCallStats are referenced by the call sites, never remove them
+			std::lock_guard<std::mutex> lock(m_statsMutex);
+			for (auto it = m_stats.begin(); it != m_stats.end(); ++it)
+			{
+				it->second->Reset();
+			}
+		}
+		std::lock_guard<std::mutex> lock(m_samplesMutex);
+		m_samples.clear();
+		m_nextSample = 0;
+	}
+
+
+	void OdbcTracer::SetSampleLog(size_t capacity, std::chrono::nanoseconds minElapsed /* = std::chrono::nanoseconds(0) */)
+	{
+		std::lock_guard<std::mutex> lock(m_samplesMutex);
+		m_samples.clear();
+		m_samples.shrink_to_fit();
+		m_samples.reserve(capacity);
+		m_nextSample = 0;
+		m_sampleMinElapsed = minElapsed;
+		m_sampleCapacity.store(capacity, std::memory_order_relaxed);
+	}
+
+
+	std::vector<OdbcTraceSample> OdbcTracer::GetSamples() const
+	{
+		std::lock_guard<std::mutex> lock(m_samplesMutex);
+		std::vector<OdbcTraceSample> samples;
+		samples.reserve(m_samples.size());
+		// Once the log is full, m_nextSample points to the oldest sample
+		size_t oldest = m_samples.size() < m_sampleCapacity.load(std::memory_order_relaxed) ? 0 : m_nextSample;
+		for (size_t i = 0; i < m_samples.size(); ++i)
+		{
+			samples.push_back(m_samples[(oldest + i) % m_samples.size()]);
+		}
+		return samples;
+	}
+
+
+	void OdbcTracer::AddSample(const OdbcCallStats& stats, SQLRETURN ret, std::chrono::nanoseconds elapsed)
+	{
+		std::lock_guard<std::mutex> lock(m_samplesMutex);
+		size_t capacity = m_sampleCapacity.load(std::memory_order_relaxed);
+		if (capacity == 0 || elapsed < m_sampleMinElapsed)
+		{
+			return;
+		}
+
+		OdbcTraceSample sample;
+		sample.m_functionName = stats.GetFunctionName();
+		sample.m_ret = ret;
+		sample.m_start = std::chrono::system_clock::now() - std::chrono::duration_cast<std::chrono::system_clock::duration>(elapsed);
+		sample.m_elapsed = elapsed;
+		sample.m_threadId = std::this_thread::get_id();
+		if (m_samples.size() < capacity)
+		{
+			m_samples.push_back(sample);
+		}
+		else
+		{
+			m_samples[m_nextSample] = sample;
+		}
+		m_nextSample = (m_nextSample + 1) % capacity;
+	}
+}
@@ -0,0 +1,342 @@
+﻿/*!
+* \file ParallelTableScan.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the ParallelTableScan class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "ParallelTableScan.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "ColumnBufferVisitors.h"
+#include "ExecutableStatement.h"
+#include "TableInfo.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	/*!
+	* \struct ParallelTableScan::ScanState
+	* \brief State shared by the threads of one Run().
+	*/
+	struct ParallelTableScan::ScanState
+	{
+		ScanState(size_t partitionCount)
+			: m_blocks(partitionCount)
+			, m_finished(partitionCount, false)
+			, m_partitionRows(partitionCount, 0)
+			, m_stop(false)
+		{ };
+
+		/*!
+		* \brief	Remember the first error and stop all threads.
+		*/
+		void Fail(std::exception_ptr pError)
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (!m_pError)
+			{
+				m_pError = pError;
+			}
+			m_stop.store(true, std::memory_order_relaxed);
+			m_changed.notify_all();
+		}
+
+		std::mutex m_mutex;	///< Protects m_blocks, m_finished and m_pError.
+		std::condition_variable m_changed;	///< Notified if a block has been added or removed, a partition has finished or the scan stops.
+		std::vector<std::deque<RowBlockPtr>> m_blocks;	///< Blocks read but not consumed yet per partition, only used if ordered.
+		std::vector<bool> m_finished;	///< True once a partition has read all its rows.
+		std::vector<unsigned long long> m_partitionRows;	///< Rows read per partition, every element is only written by the thread of its partition.
+		std::atomic<bool> m_stop;	///< Set if the scan must stop because of an error.
+		std::exception_ptr m_pError;	///< The first error.
+	};
+
+
+	// Construction
+	// -------------
+	ParallelTableScan::ParallelTableScan(const Table& table)
+		: m_table(table)
+		, m_partitionCount(std::max(std::thread::hardware_concurrency(), 1u))
+		, m_partitionColumn(0)
+		, m_havePartitionColumn(false)
+		, m_ordered(false)
+		, m_blockSize(DEFAULT_ROW_BLOCK_SIZE)
+		, m_prefetchBlocks(DEFAULT_PREFETCH_BLOCKS)
+	{ }
+
+
+	// Implementation
+	// --------------
+	void ParallelTableScan::SetPartitionCount(size_t partitionCount)
+	{
+		exASSERT(partitionCount > 0);
+		m_partitionCount = partitionCount;
+	}
+
+
+	void ParallelTableScan::SetPartitionColumn(SQLUSMALLINT columnIndex)
+	{
+		exASSERT_MSG(m_table.ColumnBufferExists(columnIndex), boost::str(boost::format(u8"Table has no ColumnBuffer at index %d") % columnIndex));
+		m_partitionColumn = columnIndex;
+		m_havePartitionColumn = true;
+	}
+
+
+	SQLUSMALLINT ParallelTableScan::GetPartitionColumn() const
+	{
+		if (m_havePartitionColumn)
+		{
+			return m_partitionColumn;
+		}
+		ColumnBufferPtrVariantMap primaryKeys = m_table.GetPrimaryKeyColumnBuffers();
+		if (primaryKeys.empty())
+		{
+			Exception ex(u8"No partition column set and the Table has no primary key column");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		return primaryKeys.begin()->first;
+	}
+
+
+	void ParallelTableScan::SetBlockSize(SQLULEN blockSize)
+	{
+		exASSERT(blockSize > 0);
+		m_blockSize = blockSize;
+	}
+
+
+	void ParallelTableScan::SetPrefetchBlocks(size_t prefetchBlocks)
+	{
+		exASSERT(prefetchBlocks > 0);
+		m_prefetchBlocks = prefetchBlocks;
+	}
+
+
+	std::vector<ScanPartition> ParallelTableScan::CreatePartitions() const
+	{
+		exASSERT(m_table.IsOpen());
+
+		const ColumnBufferPtrVariant& column = m_table.GetColumnBufferPtrVariant(GetPartitionColumn());
+		string columnName = boost::apply_visitor(QueryNameVisitor(), column);
+		SQLSMALLINT sqlCType = boost::apply_visitor(SqlCTypeVisitor(), column);
+		bool nullable = boost::apply_visitor(ColumnFlagsPtrVisitor(), column)->Test(ColumnFlag::CF_NULLABLE);
+		switch (sqlCType)
+		{
+		case SQL_C_SSHORT:
+		case SQL_C_USHORT:
+		case SQL_C_SLONG:
+		case SQL_C_ULONG:
+		case SQL_C_SBIGINT:
+		case SQL_C_UBIGINT:
+			break;
+		default:
+			NotSupportedException nse(NotSupportedException::Type::SQL_C_TYPE, sqlCType, boost::str(boost::format(u8"Partition column '%s' must be bound as an integer") % columnName));
+			SET_EXCEPTION_SOURCE(nse);
+			throw nse;
+		}
+
+		string sqlstmt = boost::str(boost::format(u8"SELECT MIN(%s), MAX(%s) FROM %s") % columnName % columnName % m_table.GetTableInfo().GetQueryName());
+		if (!m_whereStatement.empty())
+		{
+			sqlstmt += u8" WHERE " + m_whereStatement;
+		}
+
+		BigIntColumnBufferPtr pMin = BigIntColumnBuffer::Create(u8"MinValue", SQL_BIGINT, ColumnFlag::CF_NULLABLE);
+		BigIntColumnBufferPtr pMax = BigIntColumnBuffer::Create(u8"MaxValue", SQL_BIGINT, ColumnFlag::CF_NULLABLE);
+		ExecutableStatement stmt(m_table.GetDatabase());
+		stmt.BindColumn(pMin, 1);
+		stmt.BindColumn(pMax, 2);
+		stmt.ExecuteDirect(sqlstmt);
+		bool haveValues = stmt.SelectNext() && !pMin->IsNull() && !pMax->IsNull();
+		stmt.SelectClose();
+
+		vector<ScanPartition> partitions;
+		if (!haveValues)
+		{
+			ScanPartition partition;
+			partition.m_whereStatement = m_whereStatement;
+			partitions.push_back(partition);
+			return partitions;
+		}
+
+		// Split the values evenly, the first partitions get one more value if they do not divide
+		SQLBIGINT minValue = pMin->GetValue();
+		SQLBIGINT maxValue = pMax->GetValue();
+		unsigned long long range = (unsigned long long)maxValue - (unsigned long long)minValue;
+		if (range == std::numeric_limits<unsigned long long>::max())
+		{
+			--range;
+		}
+		unsigned long long values = range + 1;
+		unsigned long long count = std::min((unsigned long long)m_partitionCount, values);
+		unsigned long long width = values / count;
+		unsigned long long remainder = values % count;
+		unsigned long long offset = 0;
+		for (unsigned long long i = 0; i < count; ++i)
+		{
+			unsigned long long partitionValues = width + (i < remainder ? 1 : 0);
+			ScanPartition partition;
+			partition.m_index = (size_t)i;
+			partition.m_bounded = true;
+			partition.m_lowerBound = (SQLBIGINT)((unsigned long long)minValue + offset);
+			partition.m_upperBound = i + 1 == count ? maxValue : (SQLBIGINT)((unsigned long long)minValue + offset + partitionValues - 1);
+			offset += partitionValues;
+
+			string bounds = boost::str(boost::format(u8"%s >= %d AND %s <= %d") % columnName % partition.m_lowerBound % columnName % partition.m_upperBound);
+			if (i == 0 && nullable)
+			{
+				// MIN() and MAX() ignore NULL values, the first partition reads them
+				bounds = boost::str(boost::format(u8"(%s OR %s IS NULL)") % bounds % columnName);
+			}
+			partition.m_whereStatement = m_whereStatement.empty() ? bounds : u8"(" + m_whereStatement + u8") AND " + bounds;
+			partitions.push_back(partition);
+		}
+		return partitions;
+	}
+
+
+	ParallelScanResult ParallelTableScan::Run(const ParallelScanConsumer& consumer)
+	{
+		exASSERT(consumer);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		vector<ScanPartition> partitions = CreatePartitions();
+		ScanState state(partitions.size());
+
+		vector<std::thread> threads;
+		threads.reserve(partitions.size());
+		try
+		{
+			for (const ScanPartition& partition : partitions)
+			{
+				threads.push_back(std::thread(&ParallelTableScan::ReadPartition, this, std::cref(partition), std::cref(consumer), std::ref(state)));
+			}
+			if (m_ordered)
+			{
+				ConsumeOrdered(consumer, state);
+			}
+		}
+		catch (...)
+		{
+			state.Fail(std::current_exception());
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		if (state.m_pError)
+		{
+			std::rethrow_exception(state.m_pError);
+		}
+
+		ParallelScanResult result;
+		result.m_partitionRows = state.m_partitionRows;
+		for (unsigned long long rows : result.m_partitionRows)
+		{
+			result.m_rows += rows;
+		}
+		result.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		return result;
+	}
+
+
+	void ParallelTableScan::ReadPartition(const ScanPartition& partition, const ParallelScanConsumer& consumer, ScanState& state) const
+	{
+		try
+		{
+			DatabasePtr pDb = m_connectionFactory ? m_connectionFactory() : m_table.GetDatabase()->OpenNewConnection();
+			exASSERT(pDb);
+			// Must be released before pDb
+			RowRange rows = m_table.Rows(pDb, partition.m_whereStatement,
+				m_ordered ? boost::apply_visitor(QueryNameVisitor(), m_table.GetColumnBufferPtrVariant(GetPartitionColumn())) : u8"", m_blockSize);
+			RowBlock& block = rows.GetBlock();
+			unsigned long long& rowCount = state.m_partitionRows[partition.m_index];
+			if (!m_ordered)
+			{
+				while (!state.m_stop.load(std::memory_order_relaxed) && block.Next())
+				{
+					consumer(partition.m_index, RowView(&block, block.GetCurrentRow()));
+					++rowCount;
+				}
+			}
+			else
+			{
+				while (!state.m_stop.load(std::memory_order_relaxed) && block.NextBlock())
+				{
+					RowBlockPtr pCopy = block.CopyCurrentBlock();
+					rowCount += block.GetRowsFetched();
+
+					unique_lock<mutex> lock(state.m_mutex);
+					std::deque<RowBlockPtr>& blocks = state.m_blocks[partition.m_index];
+					state.m_changed.wait(lock, [&]() { return state.m_stop.load(std::memory_order_relaxed) || blocks.size() < m_prefetchBlocks; });
+					blocks.push_back(pCopy);
+					state.m_changed.notify_all();
+				}
+			}
+		}
+		catch (...)
+		{
+			state.Fail(std::current_exception());
+		}
+
+		lock_guard<mutex> lock(state.m_mutex);
+		state.m_finished[partition.m_index] = true;
+		state.m_changed.notify_all();
+	}
+
+
+	void ParallelTableScan::ConsumeOrdered(const ParallelScanConsumer& consumer, ScanState& state) const
+	{
+		for (size_t i = 0; i < state.m_blocks.size(); ++i)
+		{
+			while (true)
+			{
+				RowBlockPtr pBlock;
+				{
+					unique_lock<mutex> lock(state.m_mutex);
+					std::deque<RowBlockPtr>& blocks = state.m_blocks[i];
+					state.m_changed.wait(lock, [&]() { return state.m_stop.load(std::memory_order_relaxed) || !blocks.empty() || state.m_finished[i]; });
+					if (state.m_stop.load(std::memory_order_relaxed))
+					{
+						return;
+					}
+					if (blocks.empty())
+					{
+						break;
+					}
+					pBlock = blocks.front();
+					blocks.pop_front();
+					state.m_changed.notify_all();
+				}
+
+				while (pBlock->Next())
+				{
+					consumer(i, RowView(pBlock.get(), pBlock->GetCurrentRow()));
+				}
+			}
+		}
+	}
+}
@@ -12,6 +12,7 @@
 
 // Same component headers
 #include "AssertionException.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -36,7 +37,7 @@ namespace exodbc
 		exASSERT(pStmt->IsAllocated());
 		exASSERT(paramNr >= 1);
 
-		SQLRETURN ret = SQLDescribeParam(pStmt->GetHandle(), paramNr, &m_sqlType, &m_charSize, &m_decimalDigits, &m_nullable);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLDescribeParam, pStmt->GetHandle(), paramNr, &m_sqlType, &m_charSize, &m_decimalDigits, &m_nullable);
 		THROW_IFN_SUCCESS(SQLDescribeParam, ret, SQL_HANDLE_STMT, pStmt->GetHandle());
 	}
 }
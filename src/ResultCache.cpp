@@ -0,0 +1,409 @@
+﻿/*!
+* \file ResultCache.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the ResultCache class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "ResultCache.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "Database.h"
+#include "ExecutableStatement.h"
+#include "SessionRecorder.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include "boost/algorithm/string.hpp"
+#include <algorithm>
+#include <iterator>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// CachedResult
+	// ============
+	CachedResult::CachedResult(const std::vector<RowColumnDefinition>& columns)
+		: m_rowCount(0)
+	{
+		exASSERT(!columns.empty());
+
+		m_columns.resize(columns.size());
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			CachedColumn& col = m_columns[i];
+			col.m_definition = columns[i];
+			col.m_elementLength = GetRowElementLength(col.m_definition.m_sqlCType, col.m_definition.m_nrOfElements);
+			switch (col.m_definition.m_sqlCType)
+			{
+			case SQL_C_CHAR:
+				col.m_terminatorLength = sizeof(SQLCHAR);
+				col.m_variableLength = true;
+				break;
+			case SQL_C_WCHAR:
+				col.m_terminatorLength = sizeof(SQLWCHAR);
+				col.m_variableLength = true;
+				break;
+			case SQL_C_BINARY:
+				col.m_terminatorLength = 0;
+				col.m_variableLength = true;
+				break;
+			default:
+				col.m_terminatorLength = 0;
+				col.m_variableLength = false;
+				break;
+			}
+			if (col.m_variableLength)
+			{
+				col.m_offsets.push_back(0);
+			}
+		}
+	}
+
+
+	void CachedResult::Append(const RowBlock& block)
+	{
+		exASSERT(block.GetColumnCount() == m_columns.size());
+
+		SQLULEN rows = block.GetRowsFetched();
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			CachedColumn& col = m_columns[i];
+			SQLUSMALLINT columnIndex = (SQLUSMALLINT)i;
+			exASSERT(block.GetColumnDefinition(columnIndex).m_sqlCType == col.m_definition.m_sqlCType);
+			for (SQLULEN row = 0; row < rows; ++row)
+			{
+				SQLLEN cb = block.GetIndicator(columnIndex, row);
+				col.m_indicators.push_back(cb);
+				const SQLCHAR* pData = block.GetData(columnIndex, row);
+				if (!col.m_variableLength)
+				{
+					col.m_data.insert(col.m_data.end(), pData, pData + col.m_elementLength);
+					continue;
+				}
+				if (cb != SQL_NULL_DATA)
+				{
+					// Truncated values and SQL_NO_TOTAL fill the whole buffer
+					SQLLEN maxLength = col.m_elementLength - col.m_terminatorLength;
+					SQLLEN length = (cb < 0 || cb > maxLength) ? maxLength : cb;
+					if (col.m_terminatorLength > 0)
+					{
+						length -= length % col.m_terminatorLength;
+					}
+					col.m_data.insert(col.m_data.end(), pData, pData + length);
+					col.m_data.insert(col.m_data.end(), (size_t)col.m_terminatorLength, (SQLCHAR)0);
+				}
+				col.m_offsets.push_back(col.m_data.size());
+			}
+		}
+		m_rowCount += rows;
+	}
+
+
+	void CachedResult::ShrinkToFit()
+	{
+		for (CachedColumn& col : m_columns)
+		{
+			col.m_data.shrink_to_fit();
+			col.m_offsets.shrink_to_fit();
+			col.m_indicators.shrink_to_fit();
+		}
+	}
+
+
+	SQLUSMALLINT CachedResult::GetColumnIndex(const std::string& queryName) const
+	{
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			if (m_columns[i].m_definition.m_queryName == queryName)
+			{
+				return (SQLUSMALLINT)i;
+			}
+		}
+		NotFoundException nfe(boost::str(boost::format(u8"No column with name '%s' is stored in the CachedResult") % queryName));
+		SET_EXCEPTION_SOURCE(nfe);
+		throw nfe;
+	}
+
+
+	const SQLCHAR* CachedResult::GetData(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		exASSERT(columnIndex < m_columns.size());
+		exASSERT(rowIndex < m_rowCount);
+
+		const CachedColumn& col = m_columns[columnIndex];
+		size_t offset = col.m_variableLength ? col.m_offsets[rowIndex] : rowIndex * col.m_elementLength;
+		// The value of an empty binary column at the end has no byte to point to
+		return col.m_data.empty() ? NULL : col.m_data.data() + offset;
+	}
+
+
+	void CachedResult::ThrowIfNull(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		if (IsNull(columnIndex, rowIndex))
+		{
+			NullValueException nve(m_columns[columnIndex].m_definition.m_queryName);
+			SET_EXCEPTION_SOURCE(nve);
+			throw nve;
+		}
+	}
+
+
+	const SQLCHAR* CachedResult::GetChars(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		exASSERT(columnIndex < m_columns.size());
+		exASSERT(m_columns[columnIndex].m_definition.m_sqlCType == SQL_C_CHAR);
+		ThrowIfNull(columnIndex, rowIndex);
+		return GetData(columnIndex, rowIndex);
+	}
+
+
+	const SQLWCHAR* CachedResult::GetWChars(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		exASSERT(columnIndex < m_columns.size());
+		exASSERT(m_columns[columnIndex].m_definition.m_sqlCType == SQL_C_WCHAR);
+		ThrowIfNull(columnIndex, rowIndex);
+		return reinterpret_cast<const SQLWCHAR*>(GetData(columnIndex, rowIndex));
+	}
+
+
+	std::string CachedResult::GetString(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		return reinterpret_cast<const char*>(GetChars(columnIndex, rowIndex));
+	}
+
+
+	SQLLEN CachedResult::GetStoredLength(SQLUSMALLINT columnIndex, SQLULEN rowIndex) const
+	{
+		exASSERT(columnIndex < m_columns.size());
+		exASSERT(rowIndex < m_rowCount);
+
+		const CachedColumn& col = m_columns[columnIndex];
+		exASSERT(col.m_variableLength);
+		if (IsNull(columnIndex, rowIndex))
+		{
+			return 0;
+		}
+		return (SQLLEN)(col.m_offsets[rowIndex + 1] - col.m_offsets[rowIndex]) - col.m_terminatorLength;
+	}
+
+
+	size_t CachedResult::GetMemorySize() const noexcept
+	{
+		size_t size = sizeof(CachedResult);
+		for (const CachedColumn& col : m_columns)
+		{
+			size += sizeof(CachedColumn) + col.m_definition.m_queryName.capacity();
+			size += col.m_data.capacity();
+			size += col.m_offsets.capacity() * sizeof(size_t);
+			size += col.m_indicators.capacity() * sizeof(SQLLEN);
+		}
+		return size;
+	}
+
+
+	// ResultCache
+	// ===========
+	ResultCache::ResultCache(size_t memoryBudget, std::chrono::milliseconds timeToLive)
+		: m_memoryBudget(memoryBudget)
+		, m_timeToLive(timeToLive)
+		, m_clearEpoch(0)
+	{
+		exASSERT(m_memoryBudget > 0);
+		exASSERT(m_timeToLive.count() >= 0);
+	}
+
+
+	std::string ResultCache::BuildKey(const std::string& sql, const std::vector<RowColumnDefinition>& columns, const std::vector<ColumnBufferPtrVariant>& params)
+	{
+		// The SQL goes first and is terminated, so it cannot be confused with the rest
+		string key = sql;
+		key.push_back('\0');
+		for (const RowColumnDefinition& def : columns)
+		{
+			key += boost::str(boost::format(u8"c%d,%d,%d,%d;") % def.m_sqlCType % def.m_nrOfElements % def.m_columnSize % def.m_decimalDigits);
+		}
+		for (size_t i = 0; i < params.size(); ++i)
+		{
+			SessionParameter param = CaptureSessionParameter((SQLUSMALLINT)(i + 1), params[i]);
+			key += boost::str(boost::format(u8"p%d,%d,%d,%d:") % param.m_sqlCType % param.m_sqlType % param.m_cb % param.m_data.length());
+			key += param.m_data;
+		}
+		return key;
+	}
+
+
+	std::string ResultCache::NormalizeTableName(const std::string& tableName)
+	{
+		string name = tableName;
+		size_t dot = name.find_last_of('.');
+		if (dot != string::npos)
+		{
+			name = name.substr(dot + 1);
+		}
+		name.erase(std::remove_if(name.begin(), name.end(), [](char c) { return c == '"' || c == '`' || c == '[' || c == ']'; }), name.end());
+		return boost::algorithm::to_upper_copy(name);
+	}
+
+
+	CachedResultPtr ResultCache::Select(ConstDatabasePtr pDb, const std::string& sql, const std::vector<RowColumnDefinition>& columns,
+		const std::vector<std::string>& tables, const std::vector<ColumnBufferPtrVariant>& params /* = std::vector<ColumnBufferPtrVariant>() */)
+	{
+		exASSERT(pDb);
+		exASSERT(!sql.empty());
+		exASSERT(!columns.empty());
+
+		string key = BuildKey(sql, columns, params);
+		vector<string> tableNames;
+		for (const string& table : tables)
+		{
+			tableNames.push_back(NormalizeTableName(table));
+		}
+
+		// Remember the epochs, to not store the result if a table is written while reading it
+		vector<unsigned long long> tableEpochs;
+		unsigned long long clearEpoch = 0;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			auto it = m_entries.find(key);
+			if (it != m_entries.end())
+			{
+				EntryList::iterator entry = it->second;
+				if (m_timeToLive.count() == 0 || Clock::now() - entry->m_readAt < m_timeToLive)
+				{
+					m_lru.splice(m_lru.begin(), m_lru, entry);
+					++m_statistics.m_hits;
+					return entry->m_pResult;
+				}
+				Erase(entry);
+				++m_statistics.m_expirations;
+			}
+			++m_statistics.m_misses;
+			for (const string& tableName : tableNames)
+			{
+				tableEpochs.push_back(m_tableEpochs[tableName]);
+			}
+			clearEpoch = m_clearEpoch;
+		}
+
+		// Read the result without holding the lock
+		Clock::time_point readAt = Clock::now();
+		std::shared_ptr<CachedResult> pResult = std::make_shared<CachedResult>(columns);
+		ExecutableStatement stmt(pDb);
+		stmt.Prepare(sql);
+		for (size_t i = 0; i < params.size(); ++i)
+		{
+			stmt.BindParameter(params[i], (SQLUSMALLINT)(i + 1));
+		}
+		stmt.ExecutePrepared();
+		{
+			RowRange rows = stmt.Rows(columns);
+			RowBlock& block = rows.GetBlock();
+			while (block.NextBlock())
+			{
+				pResult->Append(block);
+			}
+		}
+		stmt.SelectClose();
+		pResult->ShrinkToFit();
+
+		lock_guard<mutex> lock(m_mutex);
+		if (clearEpoch != m_clearEpoch)
+		{
+			return pResult;
+		}
+		for (size_t i = 0; i < tableNames.size(); ++i)
+		{
+			if (m_tableEpochs[tableNames[i]] != tableEpochs[i])
+			{
+				return pResult;
+			}
+		}
+		size_t size = sizeof(Entry) + key.capacity() + pResult->GetMemorySize();
+		if (size > m_memoryBudget)
+		{
+			return pResult;
+		}
+
+		// Another thread might have stored the same query meanwhile
+		auto it = m_entries.find(key);
+		if (it != m_entries.end())
+		{
+			Erase(it->second);
+		}
+		Entry entry;
+		entry.m_key = key;
+		entry.m_pResult = pResult;
+		entry.m_tables = tableNames;
+		entry.m_readAt = readAt;
+		entry.m_size = size;
+		m_lru.push_front(entry);
+		m_entries[key] = m_lru.begin();
+		m_statistics.m_memoryUsage += size;
+		while (m_statistics.m_memoryUsage > m_memoryBudget)
+		{
+			Erase(std::prev(m_lru.end()));
+			++m_statistics.m_evictions;
+		}
+		return pResult;
+	}
+
+
+	void ResultCache::Erase(EntryList::iterator it)
+	{
+		m_statistics.m_memoryUsage -= it->m_size;
+		m_entries.erase(it->m_key);
+		m_lru.erase(it);
+	}
+
+
+	void ResultCache::Invalidate(const std::string& tableName)
+	{
+		string name = NormalizeTableName(tableName);
+
+		lock_guard<mutex> lock(m_mutex);
+		++m_tableEpochs[name];
+		EntryList::iterator it = m_lru.begin();
+		while (it != m_lru.end())
+		{
+			EntryList::iterator current = it++;
+			if (std::find(current->m_tables.begin(), current->m_tables.end(), name) != current->m_tables.end())
+			{
+				Erase(current);
+				++m_statistics.m_invalidations;
+			}
+		}
+	}
+
+
+	void ResultCache::Clear()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		++m_clearEpoch;
+		m_statistics.m_invalidations += m_lru.size();
+		m_entries.clear();
+		m_lru.clear();
+		m_statistics.m_memoryUsage = 0;
+	}
+
+
+	ResultCacheStatistics ResultCache::GetStatistics() const
+	{
+		lock_guard<mutex> lock(m_mutex);
+		ResultCacheStatistics statistics = m_statistics;
+		statistics.m_entries = m_entries.size();
+		return statistics;
+	}
+}
@@ -0,0 +1,407 @@
+﻿/*!
+* \file RowRange.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the RowRange class and its helpers.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+// Own header
+#include "RowRange.h"
+
+// Same component headers
+#include "ExecutableStatement.h"
+#include "SetDescriptionFieldWrapper.h"
+#include "LogManager.h"
+#include "LogManagerOdbcMacros.h"
+#include "OdbcTrace.h"
+
+// Other headers
+#include <boost/format.hpp>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	SQLLEN GetRowElementLength(SQLSMALLINT sqlCType, SQLLEN nrOfElements)
+	{
+		switch (sqlCType)
+		{
+		case SQL_C_SSHORT:
+		case SQL_C_USHORT:
+			return sizeof(SQLSMALLINT);
+		case SQL_C_SLONG:
+		case SQL_C_ULONG:
+			return sizeof(SQLINTEGER);
+		case SQL_C_SBIGINT:
+		case SQL_C_UBIGINT:
+			return sizeof(SQLBIGINT);
+		case SQL_C_DOUBLE:
+			return sizeof(SQLDOUBLE);
+		case SQL_C_FLOAT:
+			return sizeof(SQLREAL);
+		case SQL_C_TYPE_DATE:
+		case SQL_C_DATE:
+			return sizeof(SQL_DATE_STRUCT);
+		case SQL_C_TYPE_TIME:
+		case SQL_C_TIME:
+			return sizeof(SQL_TIME_STRUCT);
+		case SQL_C_TYPE_TIMESTAMP:
+		case SQL_C_TIMESTAMP:
+			return sizeof(SQL_TIMESTAMP_STRUCT);
+		case SQL_C_NUMERIC:
+			return sizeof(SQL_NUMERIC_STRUCT);
+		case SQL_C_CHAR:
+		case SQL_C_BINARY:
+			exASSERT(nrOfElements > 0);
+			return nrOfElements * sizeof(SQLCHAR);
+		case SQL_C_WCHAR:
+			exASSERT(nrOfElements > 0);
+			return nrOfElements * sizeof(SQLWCHAR);
+		}
+		NotSupportedException nse(NotSupportedException::Type::SQL_C_TYPE, sqlCType);
+		SET_EXCEPTION_SOURCE(nse);
+		throw nse;
+	}
+
+
+	SQLLEN GetMaxIndicator(SQLSMALLINT sqlCType, SQLLEN elementLength) noexcept
+	{
+		switch (sqlCType)
+		{
+		case SQL_C_CHAR:
+			return elementLength - (SQLLEN)sizeof(SQLCHAR);
+		case SQL_C_WCHAR:
+			return elementLength - (SQLLEN)sizeof(SQLWCHAR);
+		case SQL_C_BINARY:
+			return elementLength;
+		}
+		return -1;
+	}
+
+
+	ParameterDescription GetRowParameterDescription(const ParameterDescription& paramDesc, SQLSMALLINT sqlCType, SQLLEN nrOfElements)
+	{
+		if (paramDesc.GetCharSize() != 0 || GetMaxIndicator(sqlCType, nrOfElements) < 0)
+		{
+			return paramDesc;
+		}
+		SQLULEN charSize = sqlCType == SQL_C_BINARY ? nrOfElements : nrOfElements - 1;
+		return ParameterDescription(paramDesc.GetSqlType(), charSize, paramDesc.GetDecimalDigits(), paramDesc.GetNullable());
+	}
+
+
+	// RowBlock
+	// ========
+	RowBlock::RowBlock(SqlStmtHandlePtr pHStmt, const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize, ExecutionTrackerPtr pExecution /* = ExecutionTrackerPtr() */)
+		: m_pHStmt(pHStmt)
+		, m_pExecution(pExecution)
+		, m_blockSize(blockSize)
+		, m_rowsFetched(0)
+		, m_currentRow(0)
+		, m_started(false)
+		, m_exhausted(false)
+	{
+		exASSERT(m_pHStmt);
+		exASSERT(m_pHStmt->IsAllocated());
+		exASSERT(!columns.empty());
+		exASSERT(m_blockSize > 0);
+
+		// Allocate all buffers now, fetching will only fill them
+		m_columns.resize(columns.size());
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			BoundColumn& col = m_columns[i];
+			col.m_definition = columns[i];
+			col.m_elementLength = GetRowElementLength(col.m_definition.m_sqlCType, col.m_definition.m_nrOfElements);
+			col.m_data.resize(col.m_elementLength * m_blockSize);
+			col.m_indicators.resize(m_blockSize, SQL_NULL_DATA);
+		}
+
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_ROW_BIND_TYPE to SQL_BIND_BY_COLUMN");
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)m_blockSize, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to set Statement Attr SQL_ATTR_ROW_ARRAY_SIZE to %d") % m_blockSize));
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROWS_FETCHED_PTR, (SQLPOINTER)&m_rowsFetched, 0);
+		THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, hStmt, u8"Failed to set Statement Attr SQL_ATTR_ROWS_FETCHED_PTR");
+
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			Bind((SQLUSMALLINT)(i + 1), m_columns[i]);
+		}
+	}
+
+
+	RowBlock::RowBlock() noexcept
+		: m_blockSize(0)
+		, m_rowsFetched(0)
+		, m_currentRow(0)
+		, m_started(false)
+		, m_exhausted(false)
+	{ }
+
+
+	RowBlock::~RowBlock()
+	{
+		// Copies of a block are not bound to any statement
+		if (!m_pHStmt || !m_pHStmt->IsAllocated())
+		{
+			return;
+		}
+
+		// Do not let the driver write into our buffers once we are gone
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLFreeStmt, hStmt, SQL_UNBIND);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLFreeStmt);
+		}
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROWS_FETCHED_PTR, (SQLPOINTER)NULL, 0);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLSetStmtAttr);
+		}
+		ret = TRACE_ODBC_CALL(SQLSetStmtAttr, hStmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+		if (!SQL_SUCCEEDED(ret))
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLSetStmtAttr);
+		}
+	}
+
+
+	void RowBlock::Bind(SQLUSMALLINT columnNr, BoundColumn& column)
+	{
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		const RowColumnDefinition& def = column.m_definition;
+		if (def.m_sqlCType == SQL_C_NUMERIC)
+		{
+			// Precision and scale can only be set using the descriptor, see ColumnBuffer<SQL_NUMERIC_STRUCT>
+			SqlDescHandle hDesc(m_pHStmt, SqlDescHandle::RowDescriptorType::ROW);
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_TYPE, (SQLPOINTER)SQL_C_NUMERIC);
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_PRECISION, (SQLPOINTER)((SQLLEN)def.m_columnSize));
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_SCALE, (SQLPOINTER)((SQLLEN)def.m_decimalDigits));
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_OCTET_LENGTH, (SQLPOINTER)column.m_elementLength);
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_DATA_PTR, (SQLPOINTER)&column.m_data[0]);
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_INDICATOR_PTR, (SQLPOINTER)&column.m_indicators[0]);
+			SetDescriptionFieldWrapper::SetDescriptionField(hDesc, columnNr, SQL_DESC_OCTET_LENGTH_PTR, (SQLPOINTER)&column.m_indicators[0]);
+			return;
+		}
+
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLBindCol, hStmt, columnNr, def.m_sqlCType, (SQLPOINTER)&column.m_data[0], column.m_elementLength, &column.m_indicators[0]);
+		THROW_IFN_SUCCEEDED_MSG(SQLBindCol, ret, SQL_HANDLE_STMT, hStmt, boost::str(boost::format(u8"Failed to bind column %d ('%s') as array of %d elements") % columnNr % def.m_queryName % m_blockSize));
+	}
+
+
+	bool RowBlock::IsFetchDue() const noexcept
+	{
+		return m_pHStmt && !m_exhausted && (!m_started || m_rowsFetched == m_blockSize);
+	}
+
+
+	void RowBlock::BeginFetch() noexcept
+	{
+		m_started = true;
+		m_rowsFetched = 0;
+		m_currentRow = 0;
+	}
+
+
+	bool RowBlock::Fetch()
+	{
+		BeginFetch();
+		ExecutionScope scope(m_pExecution, ExecutionScope::Phase::Fetch);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLFetch, m_pHStmt->GetHandle());
+		return EndFetch(ret, scope);
+	}
+
+
+	bool RowBlock::EndFetch(SQLRETURN ret, ExecutionScope& scope)
+	{
+		SQLHSTMT hStmt = m_pHStmt->GetHandle();
+		// The result set is done after SQL_NO_DATA or a short block
+		SQLULEN rows = SQL_SUCCEEDED(ret) ? m_rowsFetched : 0;
+		scope.SetFetched(rows, !SQL_SUCCEEDED(ret) || rows < m_blockSize);
+		scope.Stop();
+		if (ret == SQL_NO_DATA)
+		{
+			m_exhausted = true;
+			return false;
+		}
+		THROW_IFN_SUCCEEDED(SQLFetch, ret, SQL_HANDLE_STMT, hStmt);
+		if (ret == SQL_SUCCESS_WITH_INFO)
+		{
+			LOG_WARNING_STMT(hStmt, ret, SQLFetch);
+		}
+
+		if (m_rowsFetched == 0)
+		{
+			m_exhausted = true;
+			return false;
+		}
+		return true;
+	}
+
+
+	bool RowBlock::Next()
+	{
+		if (m_exhausted)
+		{
+			return false;
+		}
+
+		if (!m_started)
+		{
+			m_started = true;
+			if (!m_pHStmt)
+			{
+				m_exhausted = m_rowsFetched == 0;
+				return !m_exhausted;
+			}
+			return Fetch();
+		}
+
+		++m_currentRow;
+		if (m_currentRow < m_rowsFetched)
+		{
+			return true;
+		}
+
+		// A short block is the last one, a copy holds only one block
+		if (m_rowsFetched < m_blockSize || !m_pHStmt)
+		{
+			m_exhausted = true;
+			return false;
+		}
+		return Fetch();
+	}
+
+
+	bool RowBlock::NextBlock()
+	{
+		if (m_started && m_rowsFetched > 0)
+		{
+			m_currentRow = m_rowsFetched - 1;
+		}
+		return Next();
+	}
+
+
+	RowBlockPtr RowBlock::CopyCurrentBlock() const
+	{
+		exASSERT(m_started);
+
+		// The default constructor is private, cannot use make_shared
+		RowBlockPtr pCopy(new RowBlock());
+		pCopy->m_columns = m_columns;
+		pCopy->m_blockSize = m_blockSize;
+		pCopy->m_rowsFetched = m_exhausted ? 0 : m_rowsFetched;
+		return pCopy;
+	}
+
+
+	SQLUSMALLINT RowBlock::GetColumnIndex(const std::string& queryName) const
+	{
+		for (size_t i = 0; i < m_columns.size(); ++i)
+		{
+			if (m_columns[i].m_definition.m_queryName == queryName)
+			{
+				return (SQLUSMALLINT)i;
+			}
+		}
+		NotFoundException nfe(boost::str(boost::format(u8"No column with name '%s' is bound to the RowRange") % queryName));
+		SET_EXCEPTION_SOURCE(nfe);
+		throw nfe;
+	}
+
+
+	// RowView
+	// =======
+	void RowView::ThrowIfNull(SQLUSMALLINT columnIndex) const
+	{
+		if (m_pBlock->GetIndicator(columnIndex, m_rowIndex) == SQL_NULL_DATA)
+		{
+			NullValueException nve(m_pBlock->GetColumnDefinition(columnIndex).m_queryName);
+			SET_EXCEPTION_SOURCE(nve);
+			throw nve;
+		}
+	}
+
+
+	const SQLCHAR* RowView::GetChars(SQLUSMALLINT columnIndex) const
+	{
+		exASSERT(m_pBlock);
+		exASSERT(columnIndex < m_pBlock->GetColumnCount());
+		exASSERT(m_pBlock->GetColumnDefinition(columnIndex).m_sqlCType == SQL_C_CHAR);
+		ThrowIfNull(columnIndex);
+		return m_pBlock->GetData(columnIndex, m_rowIndex);
+	}
+
+
+	const SQLWCHAR* RowView::GetWChars(SQLUSMALLINT columnIndex) const
+	{
+		exASSERT(m_pBlock);
+		exASSERT(columnIndex < m_pBlock->GetColumnCount());
+		exASSERT(m_pBlock->GetColumnDefinition(columnIndex).m_sqlCType == SQL_C_WCHAR);
+		ThrowIfNull(columnIndex);
+		return reinterpret_cast<const SQLWCHAR*>(m_pBlock->GetData(columnIndex, m_rowIndex));
+	}
+
+
+	std::string RowView::GetString(SQLUSMALLINT columnIndex) const
+	{
+		return reinterpret_cast<const char*>(GetChars(columnIndex));
+	}
+
+
+	// RowRange::iterator
+	// ==================
+	RowRange::iterator::iterator(RowBlock* pBlock) noexcept
+		: m_pBlock(NULL)
+	{
+		if (pBlock && pBlock->IsStarted() && !pBlock->IsExhausted())
+		{
+			m_pBlock = pBlock;
+			m_row = RowView(m_pBlock, m_pBlock->GetCurrentRow());
+		}
+	}
+
+
+	RowRange::iterator& RowRange::iterator::operator++()
+	{
+		exASSERT(m_pBlock);
+		if (m_pBlock->Next())
+		{
+			m_row = RowView(m_pBlock, m_pBlock->GetCurrentRow());
+		}
+		else
+		{
+			m_pBlock = NULL;
+			m_row = RowView();
+		}
+		return *this;
+	}
+
+
+	// RowRange
+	// ========
+	RowRange::RowRange(SqlStmtHandlePtr pHStmt, const std::vector<RowColumnDefinition>& columns, SQLULEN blockSize /* = DEFAULT_ROW_BLOCK_SIZE */, ExecutionTrackerPtr pExecution /* = ExecutionTrackerPtr() */)
+		: m_pBlock(std::make_shared<RowBlock>(pHStmt, columns, blockSize, pExecution))
+	{ }
+
+
+	RowRange::iterator RowRange::begin()
+	{
+		if (!m_pBlock->IsStarted())
+		{
+			m_pBlock->Next();
+		}
+		return iterator(m_pBlock.get());
+	}
+}
@@ -0,0 +1,552 @@
+﻿/*!
+* \file SessionRecorder.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the SessionRecorder and SessionTracker classes.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "SessionRecorder.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "ColumnBufferVisitors.h"
+#include "LogManager.h"
+#include "ExecutableStatement.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	const char SessionRecorder::FILE_MAGIC[8] = { 'e', 'x', 'o', 'd', 'b', 'c', 'S', 'R' };
+
+	namespace
+	{
+		// Refuse to allocate absurd strings if a file is corrupt
+		const unsigned long long MAX_STRING_LENGTH = 256ull * 1024ull * 1024ull;
+
+
+		void WriteUnsigned(std::ostream& out, unsigned long long value)
+		{
+			char bytes[10];
+			size_t count = 0;
+			do
+			{
+				char byte = (char)(value & 0x7f);
+				value >>= 7;
+				bytes[count++] = value != 0 ? (char)(byte | 0x80) : byte;
+			} while (value != 0);
+			out.write(bytes, count);
+		}
+
+
+		void WriteSigned(std::ostream& out, long long value)
+		{
+			WriteUnsigned(out, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+		}
+
+
+		void WriteString(std::ostream& out, const std::string& value)
+		{
+			WriteUnsigned(out, value.length());
+			out.write(value.data(), value.length());
+		}
+
+
+		void ThrowInvalid(const std::string& what)
+		{
+			Exception ex(u8"Invalid session recording: " + what);
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+
+		unsigned long long ReadUnsigned(std::istream& in)
+		{
+			unsigned long long value = 0;
+			for (unsigned shift = 0; shift < 64; shift += 7)
+			{
+				int byte = in.get();
+				if (byte == std::char_traits<char>::eof())
+				{
+					ThrowInvalid(u8"Unexpected end of file");
+				}
+				value |= (unsigned long long)(byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+			ThrowInvalid(u8"Integer too long");
+			return 0;
+		}
+
+
+		long long ReadSigned(std::istream& in)
+		{
+			unsigned long long value = ReadUnsigned(in);
+			return (long long)(value >> 1) ^ -(long long)(value & 1);
+		}
+
+
+		std::string ReadString(std::istream& in)
+		{
+			unsigned long long length = ReadUnsigned(in);
+			if (length > MAX_STRING_LENGTH)
+			{
+				ThrowInvalid(boost::str(boost::format(u8"String of %d bytes") % length));
+			}
+			std::string value((size_t)length, '\0');
+			if (length > 0 && !in.read(&value[0], (std::streamsize)length))
+			{
+				ThrowInvalid(u8"Unexpected end of file");
+			}
+			return value;
+		}
+
+
+		/*!
+		* \brief	Number of elements of buffer before the terminating zero, or all of them if there is none.
+		*/
+		template<typename T>
+		typename std::enable_if<std::is_arithmetic<T>::value, size_t>::type CountUntilTerminator(const std::vector<T>& buffer)
+		{
+			return (size_t)(std::find(buffer.begin(), buffer.end(), (T)0) - buffer.begin());
+		}
+
+
+		/*!
+		* \brief	Structs are never terminated.
+		*/
+		template<typename T>
+		typename std::enable_if<!std::is_arithmetic<T>::value, size_t>::type CountUntilTerminator(const std::vector<T>& buffer)
+		{
+			return buffer.size();
+		}
+
+
+		/*!
+		* \class RawValueVisitor
+		* \brief Visitor to copy the bytes of the value of a ColumnBuffer.
+		*/
+		class RawValueVisitor
+			: public boost::static_visitor<std::string>
+		{
+		public:
+			template<typename T>
+			std::string operator()(const T& pBuffer) const
+			{
+				typedef typename std::decay<decltype(pBuffer->GetBuffer()[0])>::type ElementType;
+				const auto& buffer = pBuffer->GetBuffer();
+				SQLLEN cb = pBuffer->GetCb();
+				size_t bytes = buffer.size() * sizeof(ElementType);
+				if (cb == SQL_NULL_DATA)
+				{
+					return std::string();
+				}
+				if (cb == SQL_NTS)
+				{
+					bytes = CountUntilTerminator(buffer) * sizeof(ElementType);
+				}
+				else if (cb >= 0 && pBuffer->GetNrOfElements() > 1)
+				{
+					bytes = std::min(bytes, (size_t)cb);
+				}
+				return std::string(reinterpret_cast<const char*>(buffer.data()), bytes);
+			}
+
+			std::string operator()(const SqlCPointerBufferPtr& pBuffer) const { return std::string(); };
+		};
+
+
+		/*!
+		* \brief	Number of bytes of the value at pValue of at most maxBytes before its terminating zero of charSize bytes.
+		*/
+		size_t CountBytesUntilTerminator(const char* pValue, size_t maxBytes, size_t charSize)
+		{
+			static const char zeros[sizeof(SQLWCHAR)] = {};
+			size_t bytes = 0;
+			while (bytes + charSize <= maxBytes && memcmp(pValue + bytes, zeros, charSize) != 0)
+			{
+				bytes += charSize;
+			}
+			return bytes;
+		}
+	}
+
+
+	SessionParameter CaptureSessionParameter(SQLUSMALLINT paramNr, const ColumnBufferPtrVariant& param)
+	{
+		SessionParameter captured;
+		captured.m_paramNr = paramNr;
+		captured.m_sqlCType = boost::apply_visitor(SqlCTypeVisitor(), param);
+		ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), param);
+		captured.m_sqlType = pProps->GetSqlType();
+		captured.m_columnSize = pProps->GetColumnSize();
+		captured.m_decimalDigits = pProps->GetDecimalDigits();
+		if (param.type() == typeid(SqlCPointerBufferPtr))
+		{
+			captured.m_cb = SQL_NULL_DATA;
+			return captured;
+		}
+		captured.m_cb = boost::apply_visitor(LengthIndicatorPtrVisitor(), param)->GetCb();
+		captured.m_data = boost::apply_visitor(RawValueVisitor(), param);
+		return captured;
+	}
+
+
+	std::vector<SessionParameter> CaptureSessionParameterArrays(const std::vector<ParameterArray>& params, SQLULEN paramSetSize)
+	{
+		std::vector<SessionParameter> captured;
+		captured.reserve(params.size() * paramSetSize);
+		for (SQLULEN row = 0; row < paramSetSize; ++row)
+		{
+			for (size_t i = 0; i < params.size(); ++i)
+			{
+				const ParameterArray& array = params[i];
+				bool isChar = array.m_sqlCType == SQL_C_CHAR || array.m_sqlCType == SQL_C_WCHAR;
+				bool isVariable = isChar || array.m_sqlCType == SQL_C_BINARY;
+
+				SessionParameter param;
+				param.m_paramNr = (SQLUSMALLINT)(i + 1);
+				param.m_sqlCType = array.m_sqlCType;
+				param.m_sqlType = array.m_paramDesc.GetSqlType();
+				param.m_columnSize = (SQLINTEGER)array.m_paramDesc.GetCharSize();
+				param.m_decimalDigits = array.m_paramDesc.GetDecimalDigits();
+				if (array.m_pIndicators)
+				{
+					param.m_cb = array.m_pIndicators[row];
+				}
+				else
+				{
+					param.m_cb = isChar ? SQL_NTS : array.m_elementLength;
+				}
+				if (param.m_cb != SQL_NULL_DATA && array.m_pData)
+				{
+					const char* pValue = (const char*)array.m_pData + row * array.m_elementLength;
+					size_t bytes = (size_t)array.m_elementLength;
+					if (param.m_cb == SQL_NTS)
+					{
+						bytes = CountBytesUntilTerminator(pValue, bytes, array.m_sqlCType == SQL_C_WCHAR ? sizeof(SQLWCHAR) : sizeof(SQLCHAR));
+					}
+					else if (isVariable && param.m_cb >= 0)
+					{
+						bytes = std::min(bytes, (size_t)param.m_cb);
+					}
+					param.m_data.assign(pValue, bytes);
+				}
+				captured.push_back(param);
+			}
+		}
+		return captured;
+	}
+
+
+	// SessionRecorder
+	// ===============
+	SessionRecorder::SessionRecorder()
+		: m_recording(false)
+		, m_eventCount(0)
+		, m_nextStatementId(0)
+	{ }
+
+
+	SessionRecorder::~SessionRecorder()
+	{
+		try
+		{
+			Stop();
+		}
+		catch (const Exception& ex)
+		{
+			LOG_WARNING(ex.ToString());
+		}
+	}
+
+
+	SessionRecorder& SessionRecorder::Get()
+	{
+		static SessionRecorder* pSessionRecorder = new SessionRecorder();
+		return *pSessionRecorder;
+	}
+
+
+	void SessionRecorder::Start(const std::string& path)
+	{
+		exASSERT(!path.empty());
+
+		lock_guard<mutex> lock(m_mutex);
+		if (m_recording.load(std::memory_order_relaxed))
+		{
+			Exception ex(u8"Already recording to '" + m_path + u8"'");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		m_out.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+		if (m_out.good())
+		{
+			m_out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+			WriteUnsigned(m_out, FILE_VERSION);
+		}
+		if (!m_out.good())
+		{
+			m_out.close();
+			m_out.clear();
+			Exception ex(u8"Failed to open session recording '" + path + u8"'");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		m_path = path;
+		m_start = std::chrono::steady_clock::now();
+		m_eventCount.store(0, std::memory_order_relaxed);
+		m_recording.store(true, std::memory_order_relaxed);
+	}
+
+
+	void SessionRecorder::Stop()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_recording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		m_recording.store(false, std::memory_order_relaxed);
+		m_out.close();
+		bool failed = m_out.fail();
+		m_out.clear();
+		if (failed)
+		{
+			Exception ex(u8"Failed to write session recording '" + m_path + u8"'");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+	}
+
+
+	void SessionRecorder::Record(std::chrono::steady_clock::time_point start, SessionEvent event)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_recording.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		// Operations started before the recording are written at its beginning
+		event.m_offset = std::max(std::chrono::nanoseconds(0), std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_start));
+		WriteEvent(m_out, event);
+		++m_eventCount;
+	}
+
+
+	void SessionRecorder::WriteEvent(std::ostream& out, const SessionEvent& event)
+	{
+		out.put((char)event.m_type);
+		WriteUnsigned(out, event.m_statementId);
+		WriteUnsigned(out, (unsigned long long)event.m_offset.count());
+		WriteUnsigned(out, (unsigned long long)event.m_duration.count());
+		WriteString(out, event.m_sql);
+		if (event.m_type == SessionEventType::Prepare)
+		{
+			return;
+		}
+		WriteUnsigned(out, (unsigned long long)event.m_fetchDuration.count());
+		WriteUnsigned(out, event.m_rowsFetched);
+		if (event.m_type == SessionEventType::ExecutePreparedArray)
+		{
+			WriteUnsigned(out, event.m_paramSetSize);
+		}
+		WriteUnsigned(out, event.m_parameters.size());
+		for (const SessionParameter& param : event.m_parameters)
+		{
+			WriteUnsigned(out, param.m_paramNr);
+			WriteSigned(out, param.m_sqlCType);
+			WriteSigned(out, param.m_sqlType);
+			WriteSigned(out, param.m_columnSize);
+			WriteSigned(out, param.m_decimalDigits);
+			WriteSigned(out, param.m_cb);
+			WriteString(out, param.m_data);
+		}
+	}
+
+
+	bool SessionRecorder::ReadEvent(std::istream& in, SessionEvent& event)
+	{
+		int type = in.get();
+		if (type == std::char_traits<char>::eof())
+		{
+			return false;
+		}
+		if (type < (int)SessionEventType::Prepare || type > (int)SessionEventType::ExecutePreparedArray)
+		{
+			ThrowInvalid(boost::str(boost::format(u8"Unknown event type %d") % type));
+		}
+
+		event = SessionEvent();
+		event.m_type = (SessionEventType)type;
+		event.m_statementId = ReadUnsigned(in);
+		event.m_offset = std::chrono::nanoseconds((long long)ReadUnsigned(in));
+		event.m_duration = std::chrono::nanoseconds((long long)ReadUnsigned(in));
+		event.m_sql = ReadString(in);
+		if (event.m_type == SessionEventType::Prepare)
+		{
+			return true;
+		}
+		event.m_fetchDuration = std::chrono::nanoseconds((long long)ReadUnsigned(in));
+		event.m_rowsFetched = ReadUnsigned(in);
+		if (event.m_type == SessionEventType::ExecutePreparedArray)
+		{
+			event.m_paramSetSize = (SQLULEN)ReadUnsigned(in);
+			if (event.m_paramSetSize == 0)
+			{
+				ThrowInvalid(u8"Parameter arrays of size 0");
+			}
+		}
+		unsigned long long paramCount = ReadUnsigned(in);
+		if (paramCount > std::numeric_limits<SQLUSMALLINT>::max() * (unsigned long long)event.m_paramSetSize)
+		{
+			ThrowInvalid(boost::str(boost::format(u8"%d parameters") % paramCount));
+		}
+		for (unsigned long long i = 0; i < paramCount; ++i)
+		{
+			SessionParameter param;
+			param.m_paramNr = (SQLUSMALLINT)ReadUnsigned(in);
+			param.m_sqlCType = (SQLSMALLINT)ReadSigned(in);
+			param.m_sqlType = (SQLSMALLINT)ReadSigned(in);
+			param.m_columnSize = (SQLINTEGER)ReadSigned(in);
+			param.m_decimalDigits = (SQLSMALLINT)ReadSigned(in);
+			param.m_cb = (SQLLEN)ReadSigned(in);
+			param.m_data = ReadString(in);
+			event.m_parameters.push_back(param);
+		}
+		return true;
+	}
+
+
+	std::vector<SessionEvent> SessionRecorder::ReadFile(const std::string& path)
+	{
+		std::ifstream in(path, std::ifstream::in | std::ifstream::binary);
+		if (!in.good())
+		{
+			Exception ex(u8"Failed to open session recording '" + path + u8"'");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+		char magic[sizeof(FILE_MAGIC)];
+		if (!in.read(magic, sizeof(magic)) || memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0)
+		{
+			ThrowInvalid(u8"'" + path + u8"' is not a session recording");
+		}
+		unsigned long long version = ReadUnsigned(in);
+		if (version < 1 || version > FILE_VERSION)
+		{
+			ThrowInvalid(boost::str(boost::format(u8"Unsupported version %d of '%s'") % version % path));
+		}
+
+		std::vector<SessionEvent> events;
+		SessionEvent event;
+		while (ReadEvent(in, event))
+		{
+			events.push_back(std::move(event));
+		}
+		return events;
+	}
+
+	// SessionTracker
+	// ==============
+	SessionTracker::SessionTracker()
+		: m_active(false)
+		, m_statementId(0)
+	{ }
+
+
+	SessionTracker::~SessionTracker()
+	{
+		End();
+	}
+
+
+	bool SessionTracker::Begin(const ExecutionContext& context)
+	{
+		End();
+
+		SessionRecorder& recorder = SessionRecorder::Get();
+		if (!recorder.IsRecording())
+		{
+			return false;
+		}
+		if (m_statementId == 0)
+		{
+			m_statementId = recorder.NextStatementId();
+		}
+
+		m_event = SessionEvent();
+		switch (context.m_type)
+		{
+		case ExecutionType::Prepare:
+			m_event.m_type = SessionEventType::Prepare;
+			break;
+		case ExecutionType::ExecuteDirect:
+			m_event.m_type = SessionEventType::ExecuteDirect;
+			break;
+		case ExecutionType::ExecutePrepared:
+			m_event.m_type = SessionEventType::ExecutePrepared;
+			break;
+		case ExecutionType::ExecutePreparedArray:
+			m_event.m_type = SessionEventType::ExecutePreparedArray;
+			break;
+		}
+		m_event.m_statementId = m_statementId;
+		m_event.m_sql = context.m_sql;
+		if (context.m_pParamArrays)
+		{
+			m_event.m_paramSetSize = context.m_paramSetSize;
+			m_event.m_parameters = CaptureSessionParameterArrays(*context.m_pParamArrays, context.m_paramSetSize);
+		}
+		else if (context.m_pParams)
+		{
+			for (auto it = context.m_pParams->begin(); it != context.m_pParams->end(); ++it)
+			{
+				m_event.m_parameters.push_back(CaptureSessionParameter(it->first, it->second));
+			}
+		}
+		m_start = std::chrono::steady_clock::now();
+		m_active = true;
+		return true;
+	}
+
+
+	void SessionTracker::End() noexcept
+	{
+		if (!m_active)
+		{
+			return;
+		}
+		m_active = false;
+		try
+		{
+			SessionRecorder::Get().Record(m_start, std::move(m_event));
+		}
+		catch (const std::exception& ex)
+		{
+			LOG_WARNING(boost::str(boost::format(u8"Failed to write execution to the SessionRecorder: %s") % ex.what()));
+		}
+		m_event = SessionEvent();
+	}
+}
@@ -0,0 +1,397 @@
+﻿/*!
+* \file SessionReplayer.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the SessionReplayer class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "SessionReplayer.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "ColumnBufferVisitors.h"
+#include "LogManager.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	namespace
+	{
+		typedef std::chrono::steady_clock ReplayClock;
+
+
+		/*!
+		* \class SetRawValueVisitor
+		* \brief Visitor to set the value of a ColumnBuffer holding a single element from recorded bytes.
+		*/
+		class SetRawValueVisitor
+			: public boost::static_visitor<void>
+		{
+		public:
+			SetRawValueVisitor(const SessionParameter& param)
+				: m_param(param)
+			{ };
+
+			template<typename T>
+			void operator()(T& pBuffer) const
+			{
+				typedef typename std::decay<decltype(pBuffer->GetBuffer()[0])>::type ElementType;
+				if (m_param.m_cb == SQL_NULL_DATA)
+				{
+					return;
+				}
+				if (m_param.m_data.size() != sizeof(ElementType))
+				{
+					NotSupportedException nse(NotSupportedException::Type::SQL_C_TYPE, m_param.m_sqlCType, boost::str(boost::format(u8"Recorded value of parameter %d has %d bytes, expected %d")
+						% m_param.m_paramNr % m_param.m_data.size() % sizeof(ElementType)));
+					SET_EXCEPTION_SOURCE(nse);
+					throw nse;
+				}
+				ElementType value;
+				memcpy(&value, m_param.m_data.data(), sizeof(ElementType));
+				pBuffer->SetValue(value, m_param.m_cb);
+			}
+
+			void operator()(SqlCPointerBufferPtr& pBuffer) const
+			{
+				exASSERT(false);
+			}
+
+		private:
+			const SessionParameter& m_param;
+		};
+
+
+		/*!
+		* \brief	Create an array buffer of type TBuffer holding the recorded bytes of param.
+		*/
+		template<typename TBuffer>
+		std::shared_ptr<TBuffer> CreateArrayBuffer(const SessionParameter& param, const std::string& queryName, bool nullTerminate)
+		{
+			typedef typename std::decay<decltype(std::declval<TBuffer>().GetBuffer()[0])>::type ElementType;
+			std::vector<ElementType> value(param.m_data.size() / sizeof(ElementType));
+			if (!value.empty())
+			{
+				memcpy(value.data(), param.m_data.data(), value.size() * sizeof(ElementType));
+			}
+			if (nullTerminate)
+			{
+				value.push_back(0);
+			}
+			std::shared_ptr<TBuffer> pBuffer = TBuffer::Create((SQLLEN)std::max(value.size(), (size_t)1), queryName, param.m_sqlType);
+			if (param.m_cb != SQL_NULL_DATA && !value.empty())
+			{
+				pBuffer->SetValue(value, param.m_cb == SQL_NTS ? SQL_NTS : (SQLLEN)param.m_data.size());
+			}
+			return pBuffer;
+		}
+
+
+		/*!
+		* \struct ReplayParameterArray
+		* \brief The contiguous values and indicators of one parameter of a recorded array execution.
+		*/
+		struct ReplayParameterArray
+		{
+			std::vector<char> m_data;
+			std::vector<SQLLEN> m_indicators;
+			SQLLEN m_elementLength = 0;
+		};
+
+
+		std::chrono::nanoseconds Elapsed(ReplayClock::time_point start)
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(ReplayClock::now() - start);
+		}
+	}
+
+
+	SessionReplayer::SessionReplayer(ConstDatabasePtr pDb)
+		: m_pDb(pDb)
+		, m_pacing(ReplayPacing::Original)
+		, m_speed(1.0)
+		, m_stopOnError(false)
+	{
+		exASSERT(m_pDb);
+		exASSERT(m_pDb->IsOpen());
+	}
+
+
+	void SessionReplayer::SetSpeed(double speed)
+	{
+		exASSERT(speed > 0.0);
+		m_speed = speed;
+	}
+
+
+	ColumnBufferPtrVariant SessionReplayer::CreateParameterBuffer(const SessionParameter& param)
+	{
+		std::string queryName = boost::str(boost::format(u8"Param%d") % param.m_paramNr);
+		ColumnBufferPtrVariant buffer;
+		switch (param.m_sqlCType)
+		{
+		case SQL_C_CHAR:
+			buffer = CreateArrayBuffer<CharColumnBuffer>(param, queryName, true);
+			break;
+		case SQL_C_WCHAR:
+			buffer = CreateArrayBuffer<WCharColumnBuffer>(param, queryName, true);
+			break;
+		case SQL_C_BINARY:
+			buffer = CreateArrayBuffer<BinaryColumnBuffer>(param, queryName, false);
+			break;
+		default:
+			buffer = CreateColumnBufferPtr(param.m_sqlCType, queryName);
+			boost::apply_visitor(SetRawValueVisitor(param), buffer);
+			break;
+		}
+
+		ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), buffer);
+		pProps->SetSqlType(param.m_sqlType);
+		pProps->SetColumnSize(param.m_columnSize);
+		pProps->SetDecimalDigits(param.m_decimalDigits);
+		boost::apply_visitor(ColumnFlagsPtrVisitor(), buffer)->Set(ColumnFlag::CF_NULLABLE);
+		return buffer;
+	}
+
+
+	SessionReplayResult SessionReplayer::Replay(const std::string& path)
+	{
+		return Replay(SessionRecorder::ReadFile(path));
+	}
+
+
+	SessionReplayResult SessionReplayer::Replay(const std::vector<SessionEvent>& events)
+	{
+		SessionReplayResult result;
+		std::map<unsigned long long, ReplayStatement> statements;
+		ReplayClock::time_point replayStart = ReplayClock::now();
+		for (const SessionEvent& event : events)
+		{
+			std::chrono::nanoseconds end = event.m_offset + event.m_duration + event.m_fetchDuration;
+			result.m_recordedDuration = std::max(result.m_recordedDuration, end);
+
+			if (m_pacing == ReplayPacing::Original)
+			{
+				std::chrono::nanoseconds offset((long long)(event.m_offset.count() / m_speed));
+				std::this_thread::sleep_until(replayStart + offset);
+			}
+
+			ReplayStatement& stmt = statements[event.m_statementId];
+			try
+			{
+				if (!stmt.m_pStmt)
+				{
+					stmt.m_pStmt = std::make_shared<ExecutableStatement>(m_pDb);
+				}
+				if (event.m_type == SessionEventType::Prepare)
+				{
+					result.m_recordedPrepareTime += event.m_duration;
+					Prepare(stmt, event.m_sql, result);
+				}
+				else
+				{
+					result.m_recordedExecuteTime += event.m_duration;
+					result.m_recordedFetchTime += event.m_fetchDuration;
+					if (event.m_type == SessionEventType::ExecutePreparedArray)
+					{
+						ExecuteArray(stmt, event, result);
+					}
+					else
+					{
+						Execute(stmt, event, result);
+					}
+				}
+			}
+			catch (const Exception& ex)
+			{
+				++result.m_errors;
+				if (m_stopOnError)
+				{
+					throw;
+				}
+				LOG_WARNING(boost::str(boost::format(u8"Failed to replay operation on statement %d at %d ms: %s") % event.m_statementId
+					% std::chrono::duration_cast<std::chrono::milliseconds>(event.m_offset).count() % ex.ToString()));
+				try
+				{
+					if (stmt.m_pStmt)
+						stmt.m_pStmt->SelectClose();
+				}
+				catch (const Exception& closeEx)
+				{
+					HIDE_UNUSED(closeEx);
+				}
+			}
+		}
+		result.m_replayDuration = Elapsed(replayStart);
+		return result;
+	}
+
+
+	void SessionReplayer::Prepare(ReplayStatement& stmt, const std::string& sql, SessionReplayResult& result)
+	{
+		stmt.m_preparedSql.clear();
+		ReplayClock::time_point start = ReplayClock::now();
+		stmt.m_pStmt->Prepare(sql);
+		result.m_replayPrepareTime += Elapsed(start);
+		++result.m_prepares;
+		stmt.m_preparedSql = sql;
+	}
+
+
+	void SessionReplayer::Execute(ReplayStatement& stmt, const SessionEvent& event, SessionReplayResult& result)
+	{
+		ExecutableStatement& executable = *stmt.m_pStmt;
+		bool prepared = event.m_type == SessionEventType::ExecutePrepared;
+		if (prepared && stmt.m_preparedSql != event.m_sql)
+		{
+			// The recording started after the statement had been prepared
+			Prepare(stmt, event.m_sql, result);
+		}
+
+		if (stmt.m_boundParams)
+		{
+			executable.UnbindParams();
+			stmt.m_boundParams = false;
+		}
+		for (const SessionParameter& param : event.m_parameters)
+		{
+			executable.BindParameter(CreateParameterBuffer(param), param.m_paramNr);
+			stmt.m_boundParams = true;
+		}
+
+		ReplayClock::time_point start = ReplayClock::now();
+		if (prepared)
+		{
+			executable.ExecutePrepared();
+		}
+		else
+		{
+			stmt.m_preparedSql.clear();
+			executable.ExecuteDirect(event.m_sql);
+		}
+		result.m_replayExecuteTime += Elapsed(start);
+		++result.m_executions;
+
+		if (event.m_rowsFetched > 0)
+		{
+			start = ReplayClock::now();
+			unsigned long long rows = 0;
+			while (rows < event.m_rowsFetched && executable.SelectNext())
+			{
+				++rows;
+			}
+			result.m_replayFetchTime += Elapsed(start);
+			result.m_rowsFetched += rows;
+		}
+		executable.SelectClose();
+	}
+
+
+	void SessionReplayer::ExecuteArray(ReplayStatement& stmt, const SessionEvent& event, SessionReplayResult& result)
+	{
+		SQLULEN paramSetSize = event.m_paramSetSize;
+		if (paramSetSize == 0 || event.m_parameters.empty() || event.m_parameters.size() % paramSetSize != 0)
+		{
+			Exception ex(boost::str(boost::format(u8"%d recorded parameters do not form %d parameter sets") % event.m_parameters.size() % paramSetSize));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		size_t nrOfParams = event.m_parameters.size() / paramSetSize;
+
+		// Lay the recorded values out column-wise, every value using the length of the longest one
+		std::vector<ReplayParameterArray> arrays(nrOfParams);
+		std::vector<ParameterArray> params(nrOfParams);
+		for (size_t i = 0; i < nrOfParams; ++i)
+		{
+			const SessionParameter& first = event.m_parameters[i];
+			ReplayParameterArray& array = arrays[i];
+			size_t terminatorLength = 0;
+			switch (first.m_sqlCType)
+			{
+			case SQL_C_CHAR:
+				terminatorLength = sizeof(SQLCHAR);
+				break;
+			case SQL_C_WCHAR:
+				terminatorLength = sizeof(SQLWCHAR);
+				break;
+			case SQL_C_BINARY:
+				break;
+			default:
+			{
+				// Values of fixed length types are always bound with the length of their type
+				ColumnBufferPtrVariant buffer = CreateColumnBufferPtr(first.m_sqlCType, boost::str(boost::format(u8"Param%d") % (i + 1)));
+				array.m_elementLength = boost::apply_visitor(BufferLengthVisitor(), buffer);
+				break;
+			}
+			}
+			for (SQLULEN row = 0; row < paramSetSize; ++row)
+			{
+				const SessionParameter& param = event.m_parameters[row * nrOfParams + i];
+				if (param.m_paramNr != i + 1 || param.m_sqlCType != first.m_sqlCType)
+				{
+					Exception ex(boost::str(boost::format(u8"Recorded parameter %d of parameter set %d does not match parameter %d of the first set") % param.m_paramNr % row % (i + 1)));
+					SET_EXCEPTION_SOURCE(ex);
+					throw ex;
+				}
+				if (terminatorLength > 0 || first.m_sqlCType == SQL_C_BINARY)
+				{
+					array.m_elementLength = std::max(array.m_elementLength, (SQLLEN)(param.m_data.size() + terminatorLength));
+				}
+				else if (param.m_cb != SQL_NULL_DATA && (SQLLEN)param.m_data.size() != array.m_elementLength)
+				{
+					NotSupportedException nse(NotSupportedException::Type::SQL_C_TYPE, param.m_sqlCType, boost::str(boost::format(u8"Recorded value of parameter %d has %d bytes, expected %d")
+						% param.m_paramNr % param.m_data.size() % array.m_elementLength));
+					SET_EXCEPTION_SOURCE(nse);
+					throw nse;
+				}
+			}
+			array.m_elementLength = std::max(array.m_elementLength, (SQLLEN)1);
+			array.m_data.assign((size_t)array.m_elementLength * paramSetSize, 0);
+			array.m_indicators.assign(paramSetSize, SQL_NULL_DATA);
+			for (SQLULEN row = 0; row < paramSetSize; ++row)
+			{
+				const SessionParameter& param = event.m_parameters[row * nrOfParams + i];
+				if (!param.m_data.empty())
+				{
+					memcpy(&array.m_data[(size_t)(row * array.m_elementLength)], param.m_data.data(), param.m_data.size());
+				}
+				array.m_indicators[row] = param.m_cb;
+			}
+			params[i] = ParameterArray(first.m_sqlCType, ParameterDescription(first.m_sqlType, (SQLULEN)first.m_columnSize, first.m_decimalDigits, SQL_NULLABLE_UNKNOWN),
+				&array.m_data[0], array.m_elementLength, &array.m_indicators[0]);
+		}
+
+		if (stmt.m_preparedSql != event.m_sql)
+		{
+			// The recording started after the statement had been prepared
+			Prepare(stmt, event.m_sql, result);
+		}
+
+		// ExecutePreparedArray() unbinds the parameters bound and resets the arrays it binds
+		stmt.m_boundParams = false;
+		ReplayClock::time_point start = ReplayClock::now();
+		stmt.m_pStmt->ExecutePreparedArray(params, paramSetSize);
+		result.m_replayExecuteTime += Elapsed(start);
+		++result.m_executions;
+		stmt.m_pStmt->SelectClose();
+	}
+}
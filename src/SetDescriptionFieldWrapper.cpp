@@ -11,6 +11,7 @@
 
 // Same component headers
 #include "LogManagerOdbcMacros.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -33,7 +34,7 @@ namespace exodbc
 	{
 		exASSERT(hDesc != SQL_NULL_HDESC);
 		exASSERT(recordNumber > 0);
-		SQLRETURN ret = SQLSetDescField(hDesc, recordNumber, descriptionField, value, 0);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLSetDescField, hDesc, recordNumber, descriptionField, value, 0);
 		THROW_IFN_SUCCEEDED(SQLSetDescField, ret, SQL_HANDLE_DESC, hDesc);
 	}
 
@@ -0,0 +1,449 @@
+﻿/*!
+* \file SlowQueryLog.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the SlowQueryLog and SlowQueryTracker classes.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "SlowQueryLog.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "StatementMetrics.h"
+#include "SqlStructHelper.h"
+#include "ColumnBufferVisitors.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <algorithm>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	const std::chrono::milliseconds SlowQueryLog::DEFAULT_THRESHOLD(500);
+
+	namespace
+	{
+		const size_t MAX_CHAR_PARAM_LENGTH = 256;
+		const size_t MAX_BINARY_PARAM_LENGTH = 64;
+
+
+		void WriteJsonString(std::ostream& out, const std::string& value)
+		{
+			out << '"';
+			for (char c : value)
+			{
+				switch (c)
+				{
+				case '\\': out << u8"\\\\"; break;
+				case '"': out << u8"\\\""; break;
+				case '\n': out << u8"\\n"; break;
+				case '\r': out << u8"\\r"; break;
+				case '\t': out << u8"\\t"; break;
+				default:
+					if ((unsigned char)c < 0x20)
+					{
+						out << boost::format(u8"\\u%04x") % (unsigned)(unsigned char)c;
+					}
+					else
+					{
+						out << c;
+					}
+				}
+			}
+			out << '"';
+		}
+
+
+		double ToMilliseconds(std::chrono::nanoseconds ns)
+		{
+			return std::chrono::duration<double, std::milli>(ns).count();
+		}
+
+
+		std::string ToIsoUtcString(std::chrono::system_clock::time_point tp)
+		{
+			std::time_t t = std::chrono::system_clock::to_time_t(tp);
+			std::tm tm;
+#ifdef _WIN32
+			gmtime_s(&tm, &t);
+#else
+			gmtime_r(&t, &tm);
+#endif
+			long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() % 1000;
+			std::stringstream ss;
+			ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S") << u8"." << std::setw(3) << std::setfill('0') << (ms < 0 ? ms + 1000 : ms) << u8"Z";
+			return ss.str();
+		}
+
+
+		std::string NumericToString(const SQL_NUMERIC_STRUCT& numeric)
+		{
+			for (size_t i = sizeof(unsigned long long); i < SQL_MAX_NUMERIC_LEN; ++i)
+			{
+				if (numeric.val[i] != 0)
+				{
+					return u8"<numeric>";
+				}
+			}
+			unsigned long long value = 0;
+			for (size_t i = sizeof(unsigned long long); i > 0; --i)
+			{
+				value = (value << 8) | numeric.val[i - 1];
+			}
+			std::string digits = boost::lexical_cast<std::string>(value);
+			if (numeric.scale > 0)
+			{
+				size_t scale = (size_t)numeric.scale;
+				if (digits.length() <= scale)
+				{
+					digits.insert(0, scale - digits.length() + 1, '0');
+				}
+				digits.insert(digits.length() - scale, u8".");
+			}
+			if (numeric.sign == 0 && value != 0)
+			{
+				digits.insert(0, u8"-");
+			}
+			return digits;
+		}
+
+
+		/*!
+		* \class ParameterValueVisitor
+		* \brief Visitor to format the value of a ColumnBuffer that is not NULL.
+		*/
+		class ParameterValueVisitor
+			: public boost::static_visitor<std::string>
+		{
+		public:
+			template<typename T>
+			std::string operator()(T& t) const
+			{
+				return boost::lexical_cast<std::string>(t->GetValue());
+			}
+
+			std::string operator()(const TypeTimeColumnBufferPtr& pBuffer) const { return TimeToString(pBuffer->GetValue()); };
+			std::string operator()(const TimeColumnBufferPtr& pBuffer) const { return TimeToString(pBuffer->GetValue()); };
+			std::string operator()(const TypeDateColumnBufferPtr& pBuffer) const { return DateToString(pBuffer->GetValue()); };
+			std::string operator()(const DateColumnBufferPtr& pBuffer) const { return DateToString(pBuffer->GetValue()); };
+			std::string operator()(const TypeTimestampColumnBufferPtr& pBuffer) const { return SqlStructHelper::TimestampToSqlString(pBuffer->GetValue(), true); };
+			std::string operator()(const TimestampColumnBufferPtr& pBuffer) const { return SqlStructHelper::TimestampToSqlString(pBuffer->GetValue(), true); };
+			std::string operator()(const NumericColumnBufferPtr& pBuffer) const { return NumericToString(pBuffer->GetValue()); };
+			std::string operator()(const SqlCPointerBufferPtr& pBuffer) const { return u8"<pointer>"; };
+
+			std::string operator()(const CharColumnBufferPtr& pBuffer) const
+			{
+				const std::vector<SQLCHAR>& buffer = pBuffer->GetBuffer();
+				std::string s(buffer.begin(), std::find(buffer.begin(), buffer.end(), 0));
+				return Truncate(s, MAX_CHAR_PARAM_LENGTH);
+			}
+
+			std::string operator()(const WCharColumnBufferPtr& pBuffer) const
+			{
+				const std::vector<SQLWCHAR>& buffer = pBuffer->GetBuffer();
+				std::vector<SQLWCHAR> ws(buffer.begin(), std::find(buffer.begin(), buffer.end(), 0));
+				if (ws.size() > MAX_CHAR_PARAM_LENGTH)
+				{
+					ws.resize(MAX_CHAR_PARAM_LENGTH);
+					ws.push_back(0);
+					return utf16ToUtf8(ws.data()) + u8"...";
+				}
+				ws.push_back(0);
+				return utf16ToUtf8(ws.data());
+			}
+
+			std::string operator()(const BinaryColumnBufferPtr& pBuffer) const
+			{
+				const std::vector<SQLCHAR>& buffer = pBuffer->GetBuffer();
+				SQLLEN cb = pBuffer->GetCb();
+				size_t length = cb >= 0 ? std::min((size_t)cb, buffer.size()) : buffer.size();
+				std::stringstream ss;
+				ss << u8"0x" << std::hex << std::setfill('0');
+				for (size_t i = 0; i < std::min(length, MAX_BINARY_PARAM_LENGTH); ++i)
+				{
+					ss << std::setw(2) << (unsigned)buffer[i];
+				}
+				if (length > MAX_BINARY_PARAM_LENGTH)
+				{
+					ss << u8"...";
+				}
+				return ss.str();
+			}
+
+		private:
+			static std::string TimeToString(const SQL_TIME_STRUCT& time)
+			{
+				return boost::str(boost::format(u8"%02d:%02d:%02d") % time.hour % time.minute % time.second);
+			}
+
+			static std::string DateToString(const SQL_DATE_STRUCT& date)
+			{
+				return boost::str(boost::format(u8"%04d-%02d-%02d") % date.year % date.month % date.day);
+			}
+
+			static std::string Truncate(const std::string& s, size_t maxLength)
+			{
+				if (s.length() <= maxLength)
+				{
+					return s;
+				}
+				return s.substr(0, maxLength) + u8"...";
+			}
+		};
+	}
+
+
+	SlowQueryParameter CaptureSlowQueryParameter(SQLUSMALLINT paramNr, const ColumnBufferPtrVariant& param)
+	{
+		SlowQueryParameter captured;
+		captured.m_paramNr = paramNr;
+		captured.m_queryName = boost::apply_visitor(QueryNameVisitor(), param);
+		captured.m_isNull = boost::apply_visitor(IsNullVisitor(), param);
+		if (!captured.m_isNull)
+		{
+			captured.m_value = boost::apply_visitor(ParameterValueVisitor(), param);
+		}
+		return captured;
+	}
+
+
+	// SlowQueryLog
+	// ============
+	SlowQueryLog::SlowQueryLog()
+		: m_enabled(false)
+		, m_thresholdNs(std::chrono::duration_cast<std::chrono::nanoseconds>(DEFAULT_THRESHOLD).count())
+		, m_captureParameters(true)
+		, m_logLevel(LogLevel::Warning)
+		, m_topCount(DEFAULT_TOP_COUNT)
+	{ }
+
+
+	SlowQueryLog& SlowQueryLog::Get()
+	{
+		static SlowQueryLog* pSlowQueryLog = new SlowQueryLog();
+		return *pSlowQueryLog;
+	}
+
+
+	void SlowQueryLog::SetParameterRedactor(ParameterRedactor redactor)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_redactor = redactor;
+	}
+
+
+	void SlowQueryLog::RedactAll(const SlowQueryRecord& record, SlowQueryParameter& param)
+	{
+		if (!param.m_isNull)
+		{
+			param.m_value = u8"***";
+		}
+	}
+
+
+	void SlowQueryLog::SetTopCount(size_t topCount)
+	{
+		exASSERT(topCount > 0);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_topCount = topCount;
+	}
+
+
+	size_t SlowQueryLog::GetTopCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_topCount;
+	}
+
+
+	std::vector<SlowQueryStatistics> SlowQueryLog::GetTopStatements() const
+	{
+		std::vector<SlowQueryStatistics> statements;
+		size_t topCount;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (auto it = m_statistics.begin(); it != m_statistics.end(); ++it)
+			{
+				statements.push_back(it->second);
+			}
+			topCount = m_topCount;
+		}
+		std::sort(statements.begin(), statements.end(), [](const SlowQueryStatistics& a, const SlowQueryStatistics& b)
+		{
+			return a.m_totalTime > b.m_totalTime;
+		});
+		if (statements.size() > topCount)
+		{
+			statements.resize(topCount);
+		}
+		return statements;
+	}
+
+
+	void SlowQueryLog::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_statistics.clear();
+	}
+
+
+	void SlowQueryLog::Record(SlowQueryRecord record)
+	{
+		std::chrono::nanoseconds total = record.GetTotalTime();
+		if (total < GetThreshold())
+		{
+			return;
+		}
+
+		record.m_fingerprint = NormalizeSql(record.m_sql);
+
+		ParameterRedactor redactor;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			redactor = m_redactor;
+		}
+		if (redactor)
+		{
+			for (SlowQueryParameter& param : record.m_parameters)
+			{
+				redactor(record, param);
+			}
+		}
+
+		LogLevel level = GetLogLevel();
+		LOG_MSG(level, ToJson(record));
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_statistics.find(record.m_fingerprint);
+		if (it == m_statistics.end())
+		{
+			// Keep some more fingerprints than reported, so a new one has a chance to climb up
+			if (m_statistics.size() >= 4 * m_topCount)
+			{
+				auto smallest = std::min_element(m_statistics.begin(), m_statistics.end(), [](const std::pair<const std::string, SlowQueryStatistics>& a, const std::pair<const std::string, SlowQueryStatistics>& b)
+				{
+					return a.second.m_totalTime < b.second.m_totalTime;
+				});
+				m_statistics.erase(smallest);
+			}
+			it = m_statistics.insert(std::make_pair(record.m_fingerprint, SlowQueryStatistics())).first;
+			it->second.m_fingerprint = record.m_fingerprint;
+		}
+		SlowQueryStatistics& statistics = it->second;
+		statistics.m_lastSql = record.m_sql;
+		statistics.m_count++;
+		statistics.m_totalTime += total;
+		statistics.m_maxTime = std::max(statistics.m_maxTime, total);
+	}
+
+
+	std::string SlowQueryLog::ToJson(const SlowQueryRecord& record)
+	{
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(3);
+		ss << u8"{\"type\":\"slow_query\",\"start\":";
+		WriteJsonString(ss, ToIsoUtcString(record.m_start));
+		ss << u8",\"fingerprint\":";
+		WriteJsonString(ss, record.m_fingerprint);
+		ss << u8",\"sql\":";
+		WriteJsonString(ss, record.m_sql);
+		ss << u8",\"params\":[";
+		for (size_t i = 0; i < record.m_parameters.size(); ++i)
+		{
+			const SlowQueryParameter& param = record.m_parameters[i];
+			if (i > 0)
+			{
+				ss << u8",";
+			}
+			ss << u8"{\"nr\":" << param.m_paramNr << u8",\"name\":";
+			WriteJsonString(ss, param.m_queryName);
+			ss << u8",\"value\":";
+			if (param.m_isNull)
+			{
+				ss << u8"null";
+			}
+			else
+			{
+				WriteJsonString(ss, param.m_value);
+			}
+			ss << u8"}";
+		}
+		ss << u8"],\"execute_ms\":" << ToMilliseconds(record.m_executeTime);
+		ss << u8",\"fetch_ms\":" << ToMilliseconds(record.m_fetchTime);
+		ss << u8",\"total_ms\":" << ToMilliseconds(record.GetTotalTime());
+		ss << u8",\"rows\":" << record.m_rowsReturned << u8"}";
+		return ss.str();
+	}
+
+
+	// SlowQueryTracker
+	// ================
+	SlowQueryTracker::SlowQueryTracker()
+		: m_active(false)
+	{ }
+
+
+	SlowQueryTracker::~SlowQueryTracker()
+	{
+		End();
+	}
+
+
+	bool SlowQueryTracker::Begin(const ExecutionContext& context)
+	{
+		End();
+
+		SlowQueryLog& log = SlowQueryLog::Get();
+		if (context.m_type == ExecutionType::Prepare || !log.IsEnabled())
+		{
+			return false;
+		}
+
+		m_record = SlowQueryRecord();
+		m_record.m_sql = context.m_sql;
+		m_record.m_start = std::chrono::system_clock::now();
+		if (context.m_pParams && log.GetCaptureParameters())
+		{
+			for (auto it = context.m_pParams->begin(); it != context.m_pParams->end(); ++it)
+			{
+				m_record.m_parameters.push_back(CaptureSlowQueryParameter(it->first, it->second));
+			}
+		}
+		m_active = true;
+		return true;
+	}
+
+
+	void SlowQueryTracker::End() noexcept
+	{
+		if (!m_active)
+		{
+			return;
+		}
+		m_active = false;
+		try
+		{
+			SlowQueryLog::Get().Record(std::move(m_record));
+		}
+		catch (const std::exception& ex)
+		{
+			LOG_WARNING(boost::str(boost::format(u8"Failed to report execution to the SlowQueryLog: %s") % ex.what()));
+		}
+		m_record = SlowQueryRecord();
+	}
+}
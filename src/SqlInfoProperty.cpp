@@ -11,6 +11,7 @@
 #include "SqlInfoProperty.h"
 
 // Same component headers
+#include "OdbcTrace.h"
 // Other headers
 #include <sstream>
 
@@ -89,7 +90,7 @@ namespace exodbc
 	{
 		exASSERT(pHDbc);
 		exASSERT(pHDbc->IsAllocated());
-		SQLRETURN ret = SQLGetInfo(pHDbc->GetHandle(), fInfoType, rgbInfoValue, cbInfoValueMax, pcbInfoValue);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetInfo, pHDbc->GetHandle(), fInfoType, rgbInfoValue, cbInfoValueMax, pcbInfoValue);
 		THROW_IFN_SUCCEEDED_MSG(SQLGetInfo, ret, SQL_HANDLE_DBC, pHDbc->GetHandle(), (boost::format(u8"Failed to read property %s (%d)") % GetName() % GetInfoId()).str());
 	}
 
@@ -100,7 +101,7 @@ namespace exodbc
 		exASSERT(pHDbc);
 		exASSERT(pHDbc->IsAllocated());
 		SQLSMALLINT bufferSize = 0;
-		SQLRETURN ret = SQLGetInfo(pHDbc->GetHandle(), fInfoType, NULL, 0, &bufferSize);
+		SQLRETURN ret = TRACE_ODBC_CALL(SQLGetInfo, pHDbc->GetHandle(), fInfoType, NULL, 0, &bufferSize);
 		{
 			// \note: DB2 will here always return SQL_SUCCESS_WITH_INFO to report that data got truncated, although we didnt even feed in a buffer.
 			// To avoid having tons of warning with the (wrong) info that data has been truncated, we just hide those messages here
@@ -502,6 +503,19 @@ namespace exodbc
 	}
 
 
+	bool SqlInfoProperties::TryGetUIntValue(SQLUSMALLINT infoId, SQLUINTEGER& value) const
+	{
+		PropsMap::const_iterator it = m_props.find(infoId);
+		if (it == m_props.end() || !it->second.GetValueRead() || it->second.GetIsUnsupported()
+			|| it->second.GetValueType() != SqlInfoProperty::ValueType::UInt)
+		{
+			return false;
+		}
+		value = boost::get<SQLUINTEGER>(it->second.GetValue());
+		return true;
+	}
+
+
 	void SqlInfoProperties::RegisterProperty(SQLUSMALLINT id, const std::string& name, SqlInfoProperty::InfoType infoType, SqlInfoProperty::ValueType valueType)
 	{
 		SqlInfoProperty prop(id, name, infoType, valueType);
@@ -688,6 +702,148 @@ namespace exodbc
 	}
 
 
+	bool SqlInfoProperties::GetSupportsAsyncStatements() const
+	{
+		if (!IsPropertyRegistered(SQL_ASYNC_MODE))
+			return false;
+
+		SqlInfoProperty prop = GetProperty(SQL_ASYNC_MODE);
+		if (!prop.GetValueRead() || prop.GetIsUnsupported())
+			return false;
+
+		SQLUINTEGER v = boost::get<SQLUINTEGER>(prop.GetValue());
+		return v == SQL_AM_STATEMENT;
+	}
+
+
+	bool SqlInfoProperties::GetSupportsCursorProfile(const CursorProfile& profile) const
+	{
+		SQLUINTEGER scrollOption = 0;
+		SQLUSMALLINT attributes2Id = 0;
+		switch (profile.m_type)
+		{
+		case CursorType::FORWARD_ONLY:
+			scrollOption = SQL_SO_FORWARD_ONLY;
+			attributes2Id = SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2;
+			break;
+		case CursorType::STATIC:
+			scrollOption = SQL_SO_STATIC;
+			attributes2Id = SQL_STATIC_CURSOR_ATTRIBUTES2;
+			break;
+		case CursorType::KEYSET_DRIVEN:
+			scrollOption = SQL_SO_KEYSET_DRIVEN;
+			attributes2Id = SQL_KEYSET_CURSOR_ATTRIBUTES2;
+			break;
+		case CursorType::DYNAMIC:
+			scrollOption = SQL_SO_DYNAMIC;
+			attributes2Id = SQL_DYNAMIC_CURSOR_ATTRIBUTES2;
+			break;
+		}
+
+		SQLUINTEGER concurrencyFlag = 0;
+		switch (profile.m_concurrency)
+		{
+		case CursorConcurrency::READ_ONLY:
+			concurrencyFlag = SQL_CA2_READ_ONLY_CONCURRENCY;
+			break;
+		case CursorConcurrency::LOCK:
+			concurrencyFlag = SQL_CA2_LOCK_CONCURRENCY;
+			break;
+		case CursorConcurrency::ROWVER:
+			concurrencyFlag = SQL_CA2_OPT_ROWVER_CONCURRENCY;
+			break;
+		case CursorConcurrency::VALUES:
+			concurrencyFlag = SQL_CA2_OPT_VALUES_CONCURRENCY;
+			break;
+		}
+
+		if (profile.m_sensitivity == CursorSensitivity::INSENSITIVE
+			&& (profile.m_concurrency != CursorConcurrency::READ_ONLY || profile.m_type == CursorType::KEYSET_DRIVEN || profile.m_type == CursorType::DYNAMIC))
+		{
+			return false;
+		}
+
+		// Forward-only, read-only is the default every driver must support
+		if (profile.m_type == CursorType::FORWARD_ONLY && profile.m_concurrency == CursorConcurrency::READ_ONLY
+			&& profile.m_sensitivity != CursorSensitivity::SENSITIVE)
+		{
+			return true;
+		}
+
+		SQLUINTEGER v = 0;
+		if (TryGetUIntValue(SQL_SCROLL_OPTIONS, v) && (v & scrollOption) == 0)
+		{
+			return false;
+		}
+		if (TryGetUIntValue(attributes2Id, v))
+		{
+			if ((v & concurrencyFlag) == 0)
+			{
+				return false;
+			}
+			if (profile.m_sensitivity == CursorSensitivity::SENSITIVE
+				&& (v & (SQL_CA2_SENSITIVITY_ADDITIONS | SQL_CA2_SENSITIVITY_DELETIONS | SQL_CA2_SENSITIVITY_UPDATES)) == 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	SQLUINTEGER SqlInfoProperties::GetCursorAttributes1(CursorType type) const
+	{
+		SQLUSMALLINT attributes1Id = SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1;
+		switch (type)
+		{
+		case CursorType::FORWARD_ONLY:
+			attributes1Id = SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1;
+			break;
+		case CursorType::STATIC:
+			attributes1Id = SQL_STATIC_CURSOR_ATTRIBUTES1;
+			break;
+		case CursorType::KEYSET_DRIVEN:
+			attributes1Id = SQL_KEYSET_CURSOR_ATTRIBUTES1;
+			break;
+		case CursorType::DYNAMIC:
+			attributes1Id = SQL_DYNAMIC_CURSOR_ATTRIBUTES1;
+			break;
+		}
+
+		SQLUINTEGER v = 0;
+		if (!TryGetUIntValue(attributes1Id, v))
+		{
+			return 0;
+		}
+		return v;
+	}
+
+
+	bool SqlInfoProperties::GetSupportsBatchRowCounts() const
+	{
+		SQLUINTEGER batchSupport = 0;
+		SQLUINTEGER batchRowCount = 0;
+		if (!TryGetUIntValue(SQL_BATCH_SUPPORT, batchSupport) || !TryGetUIntValue(SQL_BATCH_ROW_COUNT, batchRowCount))
+		{
+			return false;
+		}
+		return (batchSupport & SQL_BS_ROW_COUNT_EXPLICIT) != 0 && (batchRowCount & SQL_BRC_EXPLICIT) != 0;
+	}
+
+
+	bool SqlInfoProperties::GetSupportsProcedures() const
+	{
+		if (!IsPropertyRegistered(SQL_PROCEDURES))
+			return false;
+
+		SqlInfoProperty prop = GetProperty(SQL_PROCEDURES);
+		if (!prop.GetValueRead() || prop.GetIsUnsupported())
+			return false;
+
+		return prop.GetStringValue() == u8"Y";
+	}
+
+
 	string SqlInfoProperties::GetSchemaTerm() const
 	{
 		SqlInfoProperty prop = GetProperty(SQL_SCHEMA_TERM);
@@ -11,6 +11,7 @@
 #include "LogManagerOdbcMacros.h"
 
 // Same component headers
+#include "OdbcTrace.h"
 // Other headers
 // Debug
 #include "DebugNew.h"
@@ -28,13 +29,13 @@ namespace exodbc
 		if (mode == Mode::IgnoreNotOpen)
 		{
 			//  calling SQLFreeStmt with the SQL_CLOSE option has no effect on the application if no cursor is open on the statement
-			ret = SQLFreeStmt(pHStmt->GetHandle(), SQL_CLOSE);
+			ret = TRACE_ODBC_CALL(SQLFreeStmt, pHStmt->GetHandle(), SQL_CLOSE);
 			THROW_IFN_SUCCEEDED(SQLFreeStmt, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
 		}
 		else
 		{
 			// SQLCloseCursor returns SQLSTATE 24000 (Invalid cursor state) if no cursor is open. 
-			ret = SQLCloseCursor(pHStmt->GetHandle());
+			ret = TRACE_ODBC_CALL(SQLCloseCursor, pHStmt->GetHandle());
 			THROW_IFN_SUCCEEDED(SQLCloseCursor, ret, SQL_HANDLE_STMT, pHStmt->GetHandle());
 		}
 	}
@@ -0,0 +1,253 @@
+﻿/*!
+* \file SqlStmtHandlePool.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the SqlStmtHandlePool class.
+* \copyright GNU Lesser General Public License Version 3
+*/
+
+// Own header
+#include "SqlStmtHandlePool.h"
+
+// Same component headers
+#include "SqlStatementCloser.h"
+#include "LogManagerOdbcMacros.h"
+#include "OdbcTrace.h"
+
+// Other headers
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+namespace
+{
+	// Statement attributes modified by exodbc that get restored before a handle is put back into the pool.
+	// Restored in the order of their ids, which sets the cursor type after the cursor characteristics.
+	const SQLINTEGER RESTORE_ATTRIBUTES[] = { SQL_ATTR_CURSOR_SCROLLABLE, SQL_ATTR_CURSOR_SENSITIVITY, SQL_ATTR_CURSOR_TYPE, SQL_ATTR_CONCURRENCY,
+		SQL_ATTR_ASYNC_ENABLE, SQL_ATTR_ROW_BIND_TYPE, SQL_ATTR_ROW_ARRAY_SIZE, SQL_ATTR_ROWS_FETCHED_PTR,
+		SQL_ATTR_USE_BOOKMARKS, SQL_ATTR_FETCH_BOOKMARK_PTR };
+}
+
+using namespace std;
+
+namespace exodbc
+{
+	SqlStmtHandlePool::SqlStmtHandlePool(ConstSqlDbcHandlePtr pHDbc, size_t maxPooledHandles /* = DEFAULT_MAX_POOLED_HANDLES */)
+		: m_pHDbc(pHDbc)
+		, m_maxPooledHandles(maxPooledHandles)
+		, m_isOpen(true)
+		, m_defaultAttributesRead(false)
+		, m_allocatedCount(0)
+		, m_reusedCount(0)
+		, m_discardedCount(0)
+	{
+		exASSERT(m_pHDbc);
+		exASSERT(m_pHDbc->IsAllocated());
+	}
+
+
+	SqlStmtHandlePool::~SqlStmtHandlePool()
+	{
+		try
+		{
+			Close();
+		}
+		catch (const Exception& ex)
+		{
+			LOG_ERROR(ex.ToString());
+		}
+	}
+
+
+	SqlStmtHandlePtr SqlStmtHandlePool::Acquire()
+	{
+		{
+			lock_guard<mutex> lock(m_poolMutex);
+			exASSERT_MSG(m_isOpen, u8"Cannot acquire a statement handle from a closed SqlStmtHandlePool");
+			if (!m_pooledHandles.empty())
+			{
+				SqlStmtHandlePtr pHStmt = m_pooledHandles.back();
+				m_pooledHandles.pop_back();
+				++m_reusedCount;
+				return pHStmt;
+			}
+		}
+
+		// Nothing pooled, allocate a new one. Do not hold the lock while talking to the driver
+		SqlStmtHandlePtr pHStmt = std::make_shared<SqlStmtHandle>(m_pHDbc);
+
+		lock_guard<mutex> lock(m_poolMutex);
+		++m_allocatedCount;
+		if (!m_defaultAttributesRead)
+		{
+			ReadDefaultAttributes(pHStmt);
+			m_defaultAttributesRead = true;
+		}
+		return pHStmt;
+	}
+
+
+	void SqlStmtHandlePool::Release(SqlStmtHandlePtr pHStmt)
+	{
+		exASSERT(pHStmt);
+
+		// If someone else still holds a reference (for example an asynchronous operation still in flight),
+		// do not touch the handle at all.
+		bool pool = false;
+		{
+			lock_guard<mutex> lock(m_poolMutex);
+			pool = m_isOpen && m_pooledHandles.size() < m_maxPooledHandles && pHStmt->IsAllocated() && pHStmt.use_count() == 1;
+		}
+
+		if (pool)
+		{
+			try
+			{
+				ResetHandle(pHStmt);
+			}
+			catch (const Exception& ex)
+			{
+				LOG_WARNING(boost::str(boost::format(u8"Failed to reset statement handle, it will not be pooled: %s") % ex.ToString()));
+				pool = false;
+			}
+		}
+
+		lock_guard<mutex> lock(m_poolMutex);
+		// Check again, the pool might have been closed or filled up in the meantime
+		if (pool && m_isOpen && m_pooledHandles.size() < m_maxPooledHandles && pHStmt.use_count() == 1)
+		{
+			m_pooledHandles.push_back(pHStmt);
+		}
+		else
+		{
+			++m_discardedCount;
+		}
+	}
+
+
+	void SqlStmtHandlePool::Close()
+	{
+		std::vector<SqlStmtHandlePtr> handles;
+		{
+			lock_guard<mutex> lock(m_poolMutex);
+			m_isOpen = false;
+			handles.swap(m_pooledHandles);
+		}
+
+		// Free the handles outside the lock, only we hold a reference to them.
+		for (SqlStmtHandlePtr pHStmt : handles)
+		{
+			if (pHStmt->IsAllocated())
+			{
+				pHStmt->Free();
+			}
+		}
+	}
+
+
+	bool SqlStmtHandlePool::IsOpen() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_isOpen;
+	}
+
+
+	void SqlStmtHandlePool::SetMaxPooledHandles(size_t maxPooledHandles)
+	{
+		std::vector<SqlStmtHandlePtr> surplus;
+		{
+			lock_guard<mutex> lock(m_poolMutex);
+			m_maxPooledHandles = maxPooledHandles;
+			while (m_pooledHandles.size() > m_maxPooledHandles)
+			{
+				surplus.push_back(m_pooledHandles.back());
+				m_pooledHandles.pop_back();
+			}
+		}
+		// surplus handles are freed when going out of scope
+	}
+
+
+	size_t SqlStmtHandlePool::GetMaxPooledHandles() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_maxPooledHandles;
+	}
+
+
+	size_t SqlStmtHandlePool::GetPooledCount() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_pooledHandles.size();
+	}
+
+
+	unsigned long long SqlStmtHandlePool::GetAllocatedCount() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_allocatedCount;
+	}
+
+
+	unsigned long long SqlStmtHandlePool::GetReusedCount() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_reusedCount;
+	}
+
+
+	unsigned long long SqlStmtHandlePool::GetDiscardedCount() const
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		return m_discardedCount;
+	}
+
+
+	void SqlStmtHandlePool::ResetCounters()
+	{
+		lock_guard<mutex> lock(m_poolMutex);
+		m_allocatedCount = 0;
+		m_reusedCount = 0;
+		m_discardedCount = 0;
+	}
+
+
+	void SqlStmtHandlePool::ReadDefaultAttributes(ConstSqlStmtHandlePtr pHStmt)
+	{
+		exASSERT(pHStmt);
+		exASSERT(pHStmt->IsAllocated());
+
+		for (SQLINTEGER attr : RESTORE_ATTRIBUTES)
+		{
+			SQLULEN value = 0;
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLGetStmtAttr, pHStmt->GetHandle(), attr, (SQLPOINTER)&value, sizeof(value), NULL);
+			if (SQL_SUCCEEDED(ret))
+			{
+				m_defaultAttributes[attr] = value;
+			}
+			else
+			{
+				LOG_DEBUG(boost::str(boost::format(u8"Failed to read default value of Statement Attr %d, it will not be restored on pooled handles") % attr));
+			}
+		}
+	}
+
+
+	void SqlStmtHandlePool::ResetHandle(ConstSqlStmtHandlePtr pHStmt) const
+	{
+		exASSERT(pHStmt);
+		exASSERT(pHStmt->IsAllocated());
+
+		StatementCloser::CloseStmtHandle(pHStmt, StatementCloser::Mode::IgnoreNotOpen);
+		pHStmt->UnbindColumns();
+		pHStmt->ResetParams();
+
+		// m_defaultAttributes is only written once during the first Acquire(), before any handle can be released.
+		for (std::map<SQLINTEGER, SQLULEN>::const_iterator it = m_defaultAttributes.begin(); it != m_defaultAttributes.end(); ++it)
+		{
+			SQLRETURN ret = TRACE_ODBC_CALL(SQLSetStmtAttr, pHStmt->GetHandle(), it->first, (SQLPOINTER)it->second, 0);
+			THROW_IFN_SUCCEEDED_MSG(SQLSetStmtAttr, ret, SQL_HANDLE_STMT, pHStmt->GetHandle(), boost::str(boost::format(u8"Failed to restore Statement Attr %d") % it->first));
+		}
+	}
+}
@@ -0,0 +1,418 @@
+﻿/*!
+* \file StatementMetrics.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \brief Source file for the StatementMetrics and StatementMetricsRegistry classes.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "StatementMetrics.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "Exception.h"
+
+// Other headers
+#include <fstream>
+#include <cstdio>
+#include <cctype>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	const char* const StatementMetricsRegistry::OVERFLOW_SQL = u8"<other>";
+
+	namespace
+	{
+		bool IsIdentifierChar(char c)
+		{
+			return isalnum((unsigned char)c) || c == '_' || c == '$' || c == '#' || c == '@' || (unsigned char)c >= 0x80;
+		}
+
+
+		void WriteLabelValue(std::ostream& out, const std::string& value)
+		{
+			for (char c : value)
+			{
+				switch (c)
+				{
+				case '\\': out << u8"\\\\"; break;
+				case '"': out << u8"\\\""; break;
+				case '\n': out << u8"\\n"; break;
+				default: out << c;
+				}
+			}
+		}
+
+
+		template<typename TGetter>
+		void WriteMetric(std::ostream& out, const std::vector<StatementMetricsSnapshot>& snapshots, const char* name, const char* type, const char* help, TGetter getter)
+		{
+			out << u8"# HELP " << name << u8" " << help << u8"\n";
+			out << u8"# TYPE " << name << u8" " << type << u8"\n";
+			for (const StatementMetricsSnapshot& snapshot : snapshots)
+			{
+				out << name << u8"{sql=\"";
+				WriteLabelValue(out, snapshot.m_normalizedSql);
+				out << u8"\"} ";
+				getter(out, snapshot);
+				out << u8"\n";
+			}
+		}
+
+
+		void WriteSeconds(std::ostream& out, std::chrono::nanoseconds ns)
+		{
+			out << std::chrono::duration<double>(ns).count();
+		}
+	}
+
+
+	std::string NormalizeSql(const std::string& sql)
+	{
+		std::string normalized;
+		normalized.reserve(sql.length());
+		bool pendingSpace = false;
+		size_t i = 0;
+		while (i < sql.length())
+		{
+			char c = sql[i];
+			if (isspace((unsigned char)c))
+			{
+				pendingSpace = !normalized.empty();
+				++i;
+				continue;
+			}
+			if (pendingSpace)
+			{
+				normalized += ' ';
+				pendingSpace = false;
+			}
+
+			if (c == '\'')
+			{
+				// String literal, a quote inside is escaped by doubling it
+				++i;
+				while (i < sql.length())
+				{
+					if (sql[i] == '\'' && i + 1 < sql.length() && sql[i + 1] == '\'')
+						i += 2;
+					else if (sql[i] == '\'')
+						break;
+					else
+						++i;
+				}
+				++i;
+				normalized += '?';
+			}
+			else if (c == '"' || c == '[' || c == '`')
+			{
+				// Quoted identifier, copy as is
+				char closing = c == '[' ? ']' : c;
+				size_t end = sql.find(closing, i + 1);
+				end = end == std::string::npos ? sql.length() : end + 1;
+				normalized.append(sql, i, end - i);
+				i = end;
+			}
+			else if ((isdigit((unsigned char)c) || (c == '.' && i + 1 < sql.length() && isdigit((unsigned char)sql[i + 1])))
+				&& (normalized.empty() || !IsIdentifierChar(normalized.back())))
+			{
+				// Numeric literal, including decimals and exponents
+				while (i < sql.length() && (isdigit((unsigned char)sql[i]) || sql[i] == '.'))
+					++i;
+				if (i < sql.length() && (sql[i] == 'e' || sql[i] == 'E'))
+				{
+					size_t exp = i + 1;
+					if (exp < sql.length() && (sql[exp] == '+' || sql[exp] == '-'))
+						++exp;
+					if (exp < sql.length() && isdigit((unsigned char)sql[exp]))
+					{
+						i = exp;
+						while (i < sql.length() && isdigit((unsigned char)sql[i]))
+							++i;
+					}
+				}
+				normalized += '?';
+			}
+			else
+			{
+				normalized += c;
+				++i;
+			}
+		}
+		return normalized;
+	}
+
+
+	StatementMetrics::StatementMetrics(const std::string& normalizedSql)
+		: m_normalizedSql(normalizedSql)
+		, m_prepareCount(0)
+		, m_executeCount(0)
+		, m_fetchCount(0)
+		, m_rowsFetched(0)
+		, m_bytesBound(0)
+		, m_prepareNs(0)
+		, m_executeNs(0)
+		, m_executeMaxNs(0)
+		, m_fetchNs(0)
+	{ }
+
+
+	void StatementMetrics::RecordPrepare(std::chrono::nanoseconds elapsed) noexcept
+	{
+		m_prepareCount.fetch_add(1, std::memory_order_relaxed);
+		m_prepareNs.fetch_add(elapsed.count(), std::memory_order_relaxed);
+	}
+
+
+	void StatementMetrics::RecordExecute(std::chrono::nanoseconds elapsed, unsigned long long bytesBound) noexcept
+	{
+		m_executeCount.fetch_add(1, std::memory_order_relaxed);
+		m_bytesBound.fetch_add(bytesBound, std::memory_order_relaxed);
+		long long ns = elapsed.count();
+		m_executeNs.fetch_add(ns, std::memory_order_relaxed);
+		long long max = m_executeMaxNs.load(std::memory_order_relaxed);
+		while (ns > max && !m_executeMaxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+		{ }
+	}
+
+
+	void StatementMetrics::RecordFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept
+	{
+		m_fetchCount.fetch_add(1, std::memory_order_relaxed);
+		m_rowsFetched.fetch_add(rows, std::memory_order_relaxed);
+		m_fetchNs.fetch_add(elapsed.count(), std::memory_order_relaxed);
+	}
+
+
+	StatementMetricsSnapshot StatementMetrics::GetSnapshot() const
+	{
+		StatementMetricsSnapshot snapshot;
+		snapshot.m_normalizedSql = m_normalizedSql;
+		snapshot.m_prepareCount = m_prepareCount.load(std::memory_order_relaxed);
+		snapshot.m_executeCount = m_executeCount.load(std::memory_order_relaxed);
+		snapshot.m_fetchCount = m_fetchCount.load(std::memory_order_relaxed);
+		snapshot.m_rowsFetched = m_rowsFetched.load(std::memory_order_relaxed);
+		snapshot.m_bytesBound = m_bytesBound.load(std::memory_order_relaxed);
+		snapshot.m_roundTrips = snapshot.m_prepareCount + snapshot.m_executeCount + snapshot.m_fetchCount;
+		snapshot.m_prepareTime = std::chrono::nanoseconds(m_prepareNs.load(std::memory_order_relaxed));
+		snapshot.m_executeTime = std::chrono::nanoseconds(m_executeNs.load(std::memory_order_relaxed));
+		snapshot.m_executeTimeMax = std::chrono::nanoseconds(m_executeMaxNs.load(std::memory_order_relaxed));
+		snapshot.m_fetchTime = std::chrono::nanoseconds(m_fetchNs.load(std::memory_order_relaxed));
+		return snapshot;
+	}
+
+
+	StatementMetricsRegistry::StatementMetricsRegistry()
+		: m_enabled(false)
+		, m_maxStatements(DEFAULT_MAX_STATEMENTS)
+	{ }
+
+
+	StatementMetricsRegistry& StatementMetricsRegistry::Get()
+	{
+		static StatementMetricsRegistry registry;
+		return registry;
+	}
+
+
+	StatementMetricsPtr StatementMetricsRegistry::GetStatementMetrics(const std::string& sql)
+	{
+		std::string normalizedSql = NormalizeSql(sql);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_statements.find(normalizedSql);
+		if (it != m_statements.end())
+		{
+			return it->second;
+		}
+		if (m_statements.size() >= m_maxStatements)
+		{
+			normalizedSql = OVERFLOW_SQL;
+			it = m_statements.find(normalizedSql);
+			if (it != m_statements.end())
+			{
+				return it->second;
+			}
+		}
+		StatementMetricsPtr pMetrics = std::make_shared<StatementMetrics>(normalizedSql);
+		m_statements[normalizedSql] = pMetrics;
+		return pMetrics;
+	}
+
+
+	std::vector<StatementMetricsSnapshot> StatementMetricsRegistry::GetSnapshots() const
+	{
+		std::vector<StatementMetricsSnapshot> snapshots;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		snapshots.reserve(m_statements.size());
+		for (auto it = m_statements.begin(); it != m_statements.end(); ++it)
+		{
+			snapshots.push_back(it->second->GetSnapshot());
+		}
+		return snapshots;
+	}
+
+
+	void StatementMetricsRegistry::Reset()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_statements.clear();
+	}
+
+
+	void StatementMetricsRegistry::SetMaxStatements(size_t maxStatements)
+	{
+		exASSERT(maxStatements > 0);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_maxStatements = maxStatements;
+	}
+
+
+	size_t StatementMetricsRegistry::GetMaxStatements() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_maxStatements;
+	}
+
+
+	void StatementMetricsRegistry::WritePrometheus(std::ostream& out) const
+	{
+		std::vector<StatementMetricsSnapshot> snapshots = GetSnapshots();
+
+		WriteMetric(out, snapshots, u8"exodbc_statement_prepares_total", u8"counter", u8"Number of times the statement was prepared.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_prepareCount; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_executions_total", u8"counter", u8"Number of times the statement was executed.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_executeCount; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_fetches_total", u8"counter", u8"Number of fetch calls on the result sets of the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_fetchCount; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_rows_fetched_total", u8"counter", u8"Number of rows fetched from the result sets of the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_rowsFetched; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_bound_bytes_total", u8"counter", u8"Bytes of column and parameter buffers bound, summed over all executions.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_bytesBound; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_round_trips_total", u8"counter", u8"Number of prepare, execute and fetch calls to the driver.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { o << s.m_roundTrips; });
+		WriteMetric(out, snapshots, u8"exodbc_statement_prepare_seconds_total", u8"counter", u8"Time spent preparing the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { WriteSeconds(o, s.m_prepareTime); });
+		WriteMetric(out, snapshots, u8"exodbc_statement_execute_seconds_total", u8"counter", u8"Time spent executing the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { WriteSeconds(o, s.m_executeTime); });
+		WriteMetric(out, snapshots, u8"exodbc_statement_execute_seconds_max", u8"gauge", u8"Longest single execution of the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { WriteSeconds(o, s.m_executeTimeMax); });
+		WriteMetric(out, snapshots, u8"exodbc_statement_fetch_seconds_total", u8"counter", u8"Time spent fetching from the result sets of the statement.",
+			[](std::ostream& o, const StatementMetricsSnapshot& s) { WriteSeconds(o, s.m_fetchTime); });
+	}
+
+
+	void StatementMetricsRegistry::WritePrometheusFile(const std::string& path) const
+	{
+		exASSERT(!path.empty());
+
+		std::string tmpPath = path + u8".tmp";
+		{
+			std::ofstream out(tmpPath, std::ofstream::out | std::ofstream::trunc);
+			if (out.good())
+			{
+				WritePrometheus(out);
+				out.flush();
+			}
+			if (!out.good())
+			{
+				Exception ex(u8"Failed to write metrics to '" + tmpPath + u8"'");
+				SET_EXCEPTION_SOURCE(ex);
+				throw ex;
+			}
+		}
+#ifdef _WIN32
+		// rename does not replace an existing file on windows
+		std::remove(path.c_str());
+#endif
+		if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+		{
+			std::remove(tmpPath.c_str());
+			Exception ex(u8"Failed to rename '" + tmpPath + u8"' to '" + path + u8"'");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+	}
+
+	// StatementMetricsSink
+	// ====================
+	StatementMetricsSink::StatementMetricsSink()
+		: m_bytesBound(0)
+	{ }
+
+
+	bool StatementMetricsSink::Begin(const ExecutionContext& context)
+	{
+		StatementMetricsRegistry& registry = StatementMetricsRegistry::Get();
+		bool enabled = registry.IsEnabled();
+		switch (context.m_type)
+		{
+		case ExecutionType::Prepare:
+			m_pPreparedMetrics = enabled ? registry.GetStatementMetrics(context.m_sql) : StatementMetricsPtr();
+			m_pPreparing = m_pPreparedMetrics;
+			return (bool)m_pPreparing;
+		case ExecutionType::ExecutePrepared:
+		case ExecutionType::ExecutePreparedArray:
+			// Recording might have been enabled after the statement has been prepared
+			if (enabled && !m_pPreparedMetrics)
+			{
+				m_pPreparedMetrics = registry.GetStatementMetrics(context.m_sql);
+			}
+			m_pMetrics = enabled ? m_pPreparedMetrics : StatementMetricsPtr();
+			break;
+		case ExecutionType::ExecuteDirect:
+			m_pMetrics = enabled ? registry.GetStatementMetrics(context.m_sql) : StatementMetricsPtr();
+			break;
+		}
+		m_bytesBound = context.m_bytesBound;
+		return (bool)m_pMetrics;
+	}
+
+
+	bool StatementMetricsSink::IsActive() const noexcept
+	{
+		if (m_pPreparing)
+		{
+			return true;
+		}
+		return m_pMetrics && StatementMetricsRegistry::Get().IsEnabled();
+	}
+
+
+	void StatementMetricsSink::AddExecute(std::chrono::nanoseconds elapsed) noexcept
+	{
+		if (m_pPreparing)
+		{
+			m_pPreparing->RecordPrepare(elapsed);
+		}
+		else if (m_pMetrics)
+		{
+			m_pMetrics->RecordExecute(elapsed, m_bytesBound);
+		}
+	}
+
+
+	void StatementMetricsSink::AddFetch(std::chrono::nanoseconds elapsed, unsigned long long rows) noexcept
+	{
+		if (m_pMetrics)
+		{
+			m_pMetrics->RecordFetch(elapsed, rows);
+		}
+	}
+
+
+	void StatementMetricsSink::End() noexcept
+	{
+		m_pPreparing.reset();
+	}
+}
@@ -21,8 +21,12 @@
 #include "ExecutableStatement.h"
 #include "DatabaseCatalog.h"
 #include "Sql2StringHelper.h"
+#include "RowRange.h"
 
 // Other headers
+#include <algorithm>
+#include <cstring>
+
 // Debug
 #include "DebugNew.h"
 
@@ -40,6 +44,9 @@ namespace exodbc
 		, m_isOpen(false)
 		, m_tableAccessFlags(TableAccessFlag::AF_NONE)
 		, m_openFlags(TableOpenFlag::TOF_NONE)
+		, m_pActiveSelectStmt(&m_execStmtSelect)
+		, m_upsertPrepared(false)
+		, m_maxWhereTemplateStmts(DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS)
 	{ }
 
 
@@ -51,6 +58,9 @@ namespace exodbc
 		, m_isOpen(false)
 		, m_tableAccessFlags(TableAccessFlag::AF_NONE)
 		, m_openFlags(TableOpenFlag::TOF_NONE)
+		, m_pActiveSelectStmt(&m_execStmtSelect)
+		, m_upsertPrepared(false)
+		, m_maxWhereTemplateStmts(DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS)
 	{
 		Init(pDb, afs, tableName, schemaName, catalogName, tableType);
 	}
@@ -64,6 +74,9 @@ namespace exodbc
 		, m_isOpen(false)
 		, m_tableAccessFlags(TableAccessFlag::AF_NONE)
 		, m_openFlags(TableOpenFlag::TOF_NONE)
+		, m_pActiveSelectStmt(&m_execStmtSelect)
+		, m_upsertPrepared(false)
+		, m_maxWhereTemplateStmts(DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS)
 	{
 		Init(pDb, afs, tableInfo);
 	}
@@ -77,6 +90,9 @@ namespace exodbc
 		, m_isOpen(false)
 		, m_tableAccessFlags(TableAccessFlag::AF_NONE)
 		, m_openFlags(TableOpenFlag::TOF_NONE)
+		, m_pActiveSelectStmt(&m_execStmtSelect)
+		, m_upsertPrepared(false)
+		, m_maxWhereTemplateStmts(other.m_maxWhereTemplateStmts)
 	{
 		// note: This constructor will always copy the search-names. Maybe they were set on other,
 		// and then the TableInfo was searched. Do not loose the information about the search-names.
@@ -158,7 +174,7 @@ namespace exodbc
 	}
 
 
-	void Table::AllocateStatements(bool scrollableCursors)
+	void Table::AllocateStatements()
 	{
 		exASSERT(!IsOpen());
 		exASSERT(m_pDb->IsOpen());
@@ -170,7 +186,7 @@ namespace exodbc
 		{
 			if (TestAccessFlag(TableAccessFlag::AF_SELECT_WHERE) || TestAccessFlag(TableAccessFlag::AF_SELECT_PK))
 			{
-				m_execStmtSelect.Init(m_pDb, scrollableCursors);
+				InitSelectStatement(m_execStmtSelect);
 			}
 			if (TestAccessFlag(TableAccessFlag::AF_COUNT_WHERE))
 			{
@@ -210,6 +226,35 @@ namespace exodbc
 	}
 
 
+	void Table::InitSelectStatement(ExecutableStatement& stmt) const
+	{
+		if (TestOpenFlag(TableOpenFlag::TOF_FORWARD_ONLY_READ_ONLY_CURSORS))
+		{
+			stmt.Init(m_pDb, CursorProfile::ForwardOnlyReadOnly());
+		}
+		else if (TestOpenFlag(TableOpenFlag::TOF_STATIC_CURSORS))
+		{
+			stmt.Init(m_pDb, CursorProfile::StaticReadOnly());
+		}
+		else if (TestOpenFlag(TableOpenFlag::TOF_KEYSET_CURSORS))
+		{
+			stmt.Init(m_pDb, CursorProfile(CursorType::KEYSET_DRIVEN, CursorConcurrency::READ_ONLY));
+		}
+		else if (TestOpenFlag(TableOpenFlag::TOF_DYNAMIC_CURSORS))
+		{
+			stmt.Init(m_pDb, CursorProfile(CursorType::DYNAMIC, CursorConcurrency::READ_ONLY));
+		}
+		else
+		{
+			stmt.Init(m_pDb, TestOpenFlag(TableOpenFlag::TOF_SCROLLABLE_CURSORS));
+		}
+		if (TestOpenFlag(TableOpenFlag::TOF_BOOKMARKS))
+		{
+			stmt.SetUseBookmarks(true);
+		}
+	}
+
+
 	std::vector<ColumnBufferPtrVariant> Table::CreateAutoColumnBufferPtrs(bool skipUnsupportedColumns, bool setAsTableColumns, bool queryPrimaryKeys)
 	{
 		exASSERT(m_pDb->IsOpen());
@@ -378,11 +423,18 @@ namespace exodbc
 
 		m_pSelectCountResultBuffer.reset();
 
+		m_whereTemplateStmts.clear();
+		m_whereTemplateLru.clear();
+		m_pActiveSelectStmt = &m_execStmtSelect;
+
 		m_execStmtCountWhere.Reset();
 		m_execStmtSelect.Reset();
 		m_execStmtInsert.Reset();
 		m_execStmtUpdatePk.Reset();
 		m_execStmtDeletePk.Reset();
+		m_execStmtUpsert.Reset();
+		m_upsertPrepared = false;
+		m_upsertArray = UpsertArrayStatements();
 	}
 
 
@@ -554,6 +606,143 @@ namespace exodbc
 	}
 
 
+	void Table::BindUpsertParameters()
+	{
+		exASSERT(!m_columns.empty());
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_INSERT));
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_UPDATE_PK));
+		exASSERT(!m_upsertPrepared);
+
+		// All columns inserted are passed, the key columns must be part of them
+		vector<ColumnBufferPtrVariant> colsToBind;
+		vector<string> columns;
+		vector<string> keyColumns;
+		vector<string> updateColumns;
+		for (auto it = m_columns.begin(); it != m_columns.end(); ++it)
+		{
+			ColumnBufferPtrVariant pVar = it->second;
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), pVar);
+			string queryName = boost::apply_visitor(QueryNameVisitor(), pVar);
+			if (pFlags->Test(ColumnFlag::CF_PRIMARY_KEY))
+			{
+				exASSERT_MSG(pFlags->Test(ColumnFlag::CF_INSERT), boost::str(boost::format(u8"Primary key column '%s' is not flaged for INSERTing") % queryName));
+				keyColumns.push_back(queryName);
+			}
+			else if (pFlags->Test(ColumnFlag::CF_UPDATE))
+			{
+				exASSERT_MSG(pFlags->Test(ColumnFlag::CF_INSERT), boost::str(boost::format(u8"Column '%s' is flaged for UPDATEing but not for INSERTing") % queryName));
+				updateColumns.push_back(queryName);
+			}
+			if (pFlags->Test(ColumnFlag::CF_INSERT))
+			{
+				columns.push_back(queryName);
+				colsToBind.push_back(pVar);
+			}
+		}
+
+		m_upsertPrepared = true;
+		string stmt = BuildUpsertSql(m_pDb->GetDbms(), m_tableInfo.GetQueryName(), columns, keyColumns, updateColumns);
+		if (stmt.empty())
+		{
+			// Upsert() will update and insert
+			return;
+		}
+
+		try
+		{
+			m_execStmtUpsert.Init(m_pDb, false);
+			m_execStmtUpsert.Prepare(stmt);
+			for (size_t i = 0; i < colsToBind.size(); ++i)
+			{
+				m_execStmtUpsert.BindParameter(colsToBind[i], (SQLSMALLINT)(i + 1));
+			}
+		}
+		catch (const Exception& ex)
+		{
+			HIDE_UNUSED(ex);
+			m_execStmtUpsert.Reset();
+			m_upsertPrepared = false;
+			throw;
+		}
+	}
+
+
+	void Table::PrepareUpsertArray(const RowBlock& rows)
+	{
+		exASSERT(IsOpen());
+		exASSERT(rows.GetColumnCount() > 0);
+
+		vector<string> blockColumns;
+		for (SQLUSMALLINT i = 0; i < rows.GetColumnCount(); ++i)
+		{
+			blockColumns.push_back(rows.GetColumnDefinition(i).m_queryName);
+		}
+		if (!m_upsertArray.m_columns.empty() && m_upsertArray.m_blockColumns == blockColumns)
+		{
+			return;
+		}
+		m_upsertArray = UpsertArrayStatements();
+
+		UpsertArrayStatements statements;
+		vector<string> columns;
+		vector<string> keyColumns;
+		vector<string> updateColumns;
+		for (const string& blockColumn : blockColumns)
+		{
+			const ColumnBufferPtrVariant& column = GetColumnBufferPtrVariant(GetColumnBufferIndex(blockColumn, false));
+			UpsertArrayColumn upsertColumn;
+			upsertColumn.m_queryName = boost::apply_visitor(QueryNameVisitor(), column);
+			upsertColumn.m_paramDesc = boost::apply_visitor(ParamDescVisitor(), column);
+			upsertColumn.m_isKey = boost::apply_visitor(ColumnFlagsPtrVisitor(), column)->Test(ColumnFlag::CF_PRIMARY_KEY);
+			columns.push_back(upsertColumn.m_queryName);
+			(upsertColumn.m_isKey ? keyColumns : updateColumns).push_back(upsertColumn.m_queryName);
+			statements.m_columns.push_back(upsertColumn);
+		}
+		if (keyColumns.empty() || keyColumns.size() != GetPrimaryKeyColumnBuffers().size())
+		{
+			Exception ex(boost::str(boost::format(u8"The rows to upsert into table '%s' must contain all primary key columns") % m_tableInfo.GetQueryName()));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+		string stmt = BuildUpsertSql(m_pDb->GetDbms(), m_tableInfo.GetQueryName(), columns, keyColumns, updateColumns);
+		if (!stmt.empty())
+		{
+			statements.m_pUpsert = std::make_shared<ExecutableStatement>(m_pDb);
+			statements.m_pUpsert->Prepare(stmt);
+		}
+		else
+		{
+			// Without other columns, set the keys to their values to find the existing rows
+			const vector<string>& setColumns = updateColumns.empty() ? keyColumns : updateColumns;
+			string setMarkers;
+			for (const string& column : setColumns)
+			{
+				setMarkers += (setMarkers.empty() ? u8"" : u8", ") + column + u8" = ?";
+			}
+			string whereMarkers;
+			for (const string& column : keyColumns)
+			{
+				whereMarkers += (whereMarkers.empty() ? u8"" : u8" AND ") + column + u8" = ?";
+			}
+			statements.m_pUpdate = std::make_shared<ExecutableStatement>(m_pDb);
+			statements.m_pUpdate->Prepare(boost::str(boost::format(u8"UPDATE %s SET %s WHERE %s") % m_tableInfo.GetQueryName() % setMarkers % whereMarkers));
+
+			string fields;
+			string markers;
+			for (const string& column : columns)
+			{
+				fields += (fields.empty() ? u8"" : u8", ") + column;
+				markers += markers.empty() ? u8"?" : u8", ?";
+			}
+			statements.m_pInsert = std::make_shared<ExecutableStatement>(m_pDb);
+			statements.m_pInsert->Prepare(boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES(%s)") % m_tableInfo.GetQueryName() % fields % markers));
+		}
+		statements.m_blockColumns = blockColumns;
+		m_upsertArray = statements;
+	}
+
+
 	void Table::BindSelectPkParameters()
 	{
 		exASSERT(!m_columns.empty());
@@ -596,6 +785,131 @@ namespace exodbc
 	}
 
 
+	void Table::BindSelectColumns(ExecutableStatement& stmt) const
+	{
+		SQLSMALLINT boundColumnNumber = 1;
+		for (ColumnBufferPtrVariantMap::const_iterator it = m_columns.begin(); it != m_columns.end(); it++)
+		{
+			ColumnBufferPtrVariant columnBuffer = it->second;
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), columnBuffer);
+			if (pFlags->Test(ColumnFlag::CF_SELECT))
+			{
+				stmt.BindColumn(columnBuffer, boundColumnNumber);
+				boundColumnNumber++;
+			}
+		}
+	}
+
+
+	void Table::ActivateSelectStatement(ExecutableStatement* pStmt)
+	{
+		exASSERT(pStmt);
+
+		if (m_pActiveSelectStmt != pStmt)
+		{
+			// Discard pending results of the previously used statement
+			if (m_pActiveSelectStmt->IsInitialized())
+			{
+				m_pActiveSelectStmt->SelectClose();
+			}
+			m_pActiveSelectStmt = pStmt;
+		}
+	}
+
+
+	ExecutableStatementPtr Table::GetWhereTemplateStatement(const std::string& sqlStmt, bool selectCursor,
+		bool bindSelectColumns, bool bindCountBuffer, const std::vector<ColumnBufferPtrVariant>& leadingParams,
+		const std::vector<ColumnBufferPtrVariant>& whereParams) const
+	{
+		exASSERT(!sqlStmt.empty());
+
+		auto it = m_whereTemplateStmts.find(sqlStmt);
+		if (it == m_whereTemplateStmts.end())
+		{
+			// First time we see this statement: Allocate, bind the result columns and prepare
+			WhereTemplateStatement wts;
+			wts.m_pStmt = std::make_shared<ExecutableStatement>();
+			if (selectCursor)
+			{
+				InitSelectStatement(*wts.m_pStmt);
+			}
+			else
+			{
+				wts.m_pStmt->Init(m_pDb, false);
+			}
+			if (bindSelectColumns)
+			{
+				BindSelectColumns(*wts.m_pStmt);
+			}
+			if (bindCountBuffer)
+			{
+				exASSERT(m_pSelectCountResultBuffer);
+				wts.m_pStmt->BindColumn(m_pSelectCountResultBuffer, 1);
+			}
+			wts.m_pStmt->Prepare(sqlStmt);
+			m_whereTemplateLru.push_front(sqlStmt);
+			wts.m_lruPos = m_whereTemplateLru.begin();
+			it = m_whereTemplateStmts.insert(std::make_pair(sqlStmt, wts)).first;
+			EvictWhereTemplateStatements(wts.m_pStmt.get());
+		}
+		else
+		{
+			m_whereTemplateLru.splice(m_whereTemplateLru.begin(), m_whereTemplateLru, it->second.m_lruPos);
+		}
+
+		// Only (re-)bind the parameters if they are not bound already
+		vector<ColumnBufferPtrVariant> params(leadingParams);
+		params.insert(params.end(), whereParams.begin(), whereParams.end());
+		WhereTemplateStatement& wts = it->second;
+		if (wts.m_boundParams != params)
+		{
+			if (!wts.m_boundParams.empty())
+			{
+				wts.m_pStmt->UnbindParams();
+				wts.m_boundParams.clear();
+			}
+			// we must do that after calling Prepare - or not use SqlDescribeParam during Bind
+			SQLSMALLINT paramNr = 1;
+			for (auto itParam = params.begin(); itParam != params.end(); ++itParam)
+			{
+				wts.m_pStmt->BindParameter(*itParam, paramNr);
+				++paramNr;
+			}
+			wts.m_boundParams = params;
+		}
+
+		return wts.m_pStmt;
+	}
+
+
+	void Table::EvictWhereTemplateStatements(const ExecutableStatement* pKeep) const
+	{
+		auto itLru = m_whereTemplateLru.end();
+		while (m_whereTemplateStmts.size() > m_maxWhereTemplateStmts && itLru != m_whereTemplateLru.begin())
+		{
+			--itLru;
+			auto it = m_whereTemplateStmts.find(*itLru);
+			exASSERT(it != m_whereTemplateStmts.end());
+			const ExecutableStatement* pStmt = it->second.m_pStmt.get();
+			if (pStmt == m_pActiveSelectStmt || pStmt == pKeep)
+			{
+				// SelectNext() still reads from it, or it is about to be returned
+				continue;
+			}
+			m_whereTemplateStmts.erase(it);
+			itLru = m_whereTemplateLru.erase(itLru);
+		}
+	}
+
+
+	void Table::SetMaxWhereTemplateStatements(size_t maxStatements)
+	{
+		exASSERT(maxStatements > 0);
+		m_maxWhereTemplateStmts = maxStatements;
+		EvictWhereTemplateStatements(NULL);
+	}
+
+
 	bool Table::ColumnBufferExists(SQLSMALLINT columnIndex) const noexcept
 	{
 		ColumnBufferPtrVariantMap::const_iterator it = m_columns.find(columnIndex);
@@ -792,6 +1106,47 @@ namespace exodbc
 	}
 
 
+	SQLUBIGINT Table::Count(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams)
+	{
+		exASSERT(IsOpen());
+		exASSERT(m_tableAccessFlags.Test(TableAccessFlag::AF_COUNT_WHERE));
+		exASSERT(m_pSelectCountResultBuffer);
+		exASSERT(!whereTemplate.empty());
+
+		// note: The count statements never needs scrollable cursors, see AllocateStatements()
+		string sqlstmt = boost::str(boost::format(u8"SELECT COUNT(*) FROM %s WHERE %s") % m_tableInfo.GetQueryName() % whereTemplate);
+		ExecutableStatementPtr pStmt = GetWhereTemplateStatement(sqlstmt, false, false, true, vector<ColumnBufferPtrVariant>(), whereParams);
+
+		pStmt->ExecutePrepared();
+		exASSERT(pStmt->SelectNext());
+
+		pStmt->SelectClose();
+
+		return *m_pSelectCountResultBuffer;
+	}
+
+
+	SQLUBIGINT Table::EstimateCount(bool countIfUnknown /* = true */)
+	{
+		exASSERT(IsOpen());
+
+		DatabaseCatalogPtr pDbCat = m_pDb->GetDbCatalog();
+		TableStatistics stats = pDbCat->ReadStatistics(m_tableInfo, false, true);
+		if (stats.HasCardinality() && stats.GetCardinality() >= 0)
+		{
+			return (SQLUBIGINT) stats.GetCardinality();
+		}
+
+		if (!countIfUnknown)
+		{
+			NotFoundException nfe(boost::str(boost::format(u8"No cardinality is reported for table '%s'") % m_tableInfo.GetQueryName()));
+			SET_EXCEPTION_SOURCE(nfe);
+			throw nfe;
+		}
+		return Count();
+	}
+
+
 	void Table::Select(const std::string& whereStatement /* = u8"" */, const std::string& orderStatement /* = u8"" */)
 	{
 		exASSERT(IsOpen());
@@ -813,10 +1168,82 @@ namespace exodbc
 	}
 
 
+	RowRange Table::Rows(const std::string& whereStatement /* = u8"" */, const std::string& orderStatement /* = u8"" */, SQLULEN blockSize /* = DEFAULT_ROW_BLOCK_SIZE */) const
+	{
+		return Rows(m_pDb, whereStatement, orderStatement, blockSize);
+	}
+
+
+	RowRange Table::Rows(ConstDatabasePtr pDb, const std::string& whereStatement, const std::string& orderStatement /* = u8"" */, SQLULEN blockSize /* = DEFAULT_ROW_BLOCK_SIZE */) const
+	{
+		exASSERT(IsOpen());
+		exASSERT(pDb);
+		exASSERT(pDb->IsOpen());
+
+		vector<RowColumnDefinition> columns;
+		ColumnBufferPtrVariantMap::const_iterator it = m_columns.begin();
+		while (it != m_columns.end())
+		{
+			const ColumnBufferPtrVariant& var = it->second;
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), var);
+			if (pFlags->Test(ColumnFlag::CF_SELECT))
+			{
+				ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), var);
+				columns.push_back(RowColumnDefinition(boost::apply_visitor(QueryNameVisitor(), var),
+					boost::apply_visitor(SqlCTypeVisitor(), var), boost::apply_visitor(NrOfElementsVisitor(), var),
+					pProps->GetColumnSize(), pProps->GetDecimalDigits()));
+			}
+			++it;
+		}
+
+		stringstream ws;
+		ws << u8"SELECT " << BuildSelectFieldsStatement() << u8" FROM " << m_tableInfo.GetQueryName();
+
+		if (!whereStatement.empty())
+		{
+			ws << u8" WHERE " << whereStatement;
+		}
+
+		if (!orderStatement.empty())
+		{
+			ws << u8" ORDER BY " << orderStatement;
+		}
+
+		ExecutableStatementPtr pStmt = std::make_shared<ExecutableStatement>(pDb, false);
+		pStmt->ExecuteDirect(ws.str());
+		RowRange rows = pStmt->Rows(columns, blockSize);
+		rows.SetOwnedStatement(pStmt);
+		return rows;
+	}
+
+
+	void Table::Select(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams, const std::string& orderStatement /* = u8"" */)
+	{
+		exASSERT(IsOpen());
+		exASSERT(m_tableAccessFlags.Test(TableAccessFlag::AF_SELECT_WHERE));
+		exASSERT(!whereTemplate.empty());
+
+		stringstream ws;
+		ws << u8"SELECT " << BuildSelectFieldsStatement() << u8" FROM " << m_tableInfo.GetQueryName();
+		ws << u8" WHERE " << whereTemplate;
+
+		if (!orderStatement.empty())
+		{
+			ws << u8" ORDER BY " << orderStatement;
+		}
+
+		ExecutableStatementPtr pStmt = GetWhereTemplateStatement(ws.str(), true,
+			true, false, vector<ColumnBufferPtrVariant>(), whereParams);
+		ActivateSelectStatement(pStmt.get());
+		pStmt->ExecutePrepared();
+	}
+
+
 	void Table::SelectByPkValues()
 	{
 		exASSERT(IsOpen());
 
+		ActivateSelectStatement(&m_execStmtSelect);
 		m_execStmtSelect.ExecutePrepared();
 	}
 
@@ -827,49 +1254,64 @@ namespace exodbc
 		exASSERT(m_tableAccessFlags.Test(TableAccessFlag::AF_SELECT_WHERE));
 		exASSERT(!sqlStmt.empty());
 
+		ActivateSelectStatement(&m_execStmtSelect);
 		m_execStmtSelect.ExecuteDirect(sqlStmt);
 	}
 
 
 	bool Table::SelectPrev()
 	{
-		return m_execStmtSelect.SelectPrev();
+		return m_pActiveSelectStmt->SelectPrev();
 	}
 
 
 	bool Table::SelectFirst()
 	{
-		return m_execStmtSelect.SelectFirst();
+		return m_pActiveSelectStmt->SelectFirst();
 	}
 
 
 	bool Table::SelectLast()
 	{
-		return m_execStmtSelect.SelectLast();
+		return m_pActiveSelectStmt->SelectLast();
 	}
 
 
 	bool Table::SelectAbsolute(SQLLEN position)
 	{
-		return m_execStmtSelect.SelectAbsolute(position);
+		return m_pActiveSelectStmt->SelectAbsolute(position);
 	}
 
 
 	bool Table::SelectRelative(SQLLEN offset)
 	{
-		return m_execStmtSelect.SelectRelative(offset);
+		return m_pActiveSelectStmt->SelectRelative(offset);
+	}
+
+
+	Bookmark Table::GetBookmark() const
+	{
+		exASSERT(m_pActiveSelectStmt);
+		return m_pActiveSelectStmt->GetBookmark();
+	}
+
+
+	bool Table::SelectBookmark(const Bookmark& bookmark, SQLLEN offset /* = 0 */)
+	{
+		exASSERT(m_pActiveSelectStmt);
+		return m_pActiveSelectStmt->SelectBookmark(bookmark, offset);
 	}
 
 
 	bool Table::SelectNext()
 	{
-		return m_execStmtSelect.SelectNext();
+		return m_pActiveSelectStmt->SelectNext();
 	}
 
 	
 	void Table::SelectClose()
 	{
-		m_execStmtSelect.SelectClose();
+		m_pActiveSelectStmt->SelectClose();
 	}
 
 
@@ -878,6 +1320,7 @@ namespace exodbc
 		exASSERT(IsOpen());
 		exASSERT(TestAccessFlag(TableAccessFlag::AF_INSERT));
 		m_execStmtInsert.ExecutePrepared();
+		InvalidateResultCache();
 	}
 
 
@@ -889,6 +1332,7 @@ namespace exodbc
 		try
 		{
 			m_execStmtDeletePk.ExecutePrepared();
+			InvalidateResultCache();
 		}
 		catch (const SqlResultException& ex)
 		{
@@ -917,6 +1361,34 @@ namespace exodbc
 		try
 		{
 			execStmtDelete.ExecuteDirect(stmt);
+			InvalidateResultCache();
+		}
+		catch (const SqlResultException& ex)
+		{
+			HIDE_UNUSED(ex);
+			if (!failOnNoData && ex.GetRet() == SQL_NO_DATA)
+			{
+				return;
+			}
+			throw;
+		}
+	}
+
+
+	void Table::Delete(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams, bool failOnNoData /* = true */) const
+	{
+		exASSERT(IsOpen());
+		exASSERT(!m_columns.empty());
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_DELETE_WHERE));
+		exASSERT(!whereTemplate.empty());
+
+		string stmt = boost::str(boost::format(u8"DELETE FROM %s WHERE %s") % m_tableInfo.GetQueryName() % whereTemplate);
+		ExecutableStatementPtr pStmt = GetWhereTemplateStatement(stmt, false, false, false, vector<ColumnBufferPtrVariant>(), whereParams);
+
+		try
+		{
+			pStmt->ExecutePrepared();
+			InvalidateResultCache();
 		}
 		catch (const SqlResultException& ex)
 		{
@@ -935,6 +1407,7 @@ namespace exodbc
 		exASSERT(IsOpen());
 		exASSERT(TestAccessFlag(TableAccessFlag::AF_UPDATE_PK));
 		m_execStmtUpdatePk.ExecutePrepared();
+		InvalidateResultCache();
 	}
 
 
@@ -984,6 +1457,374 @@ namespace exodbc
 
 		// And do the update
 		execStmtUpdate.ExecutePrepared();
+		InvalidateResultCache();
+	}
+
+
+	void Table::Update(const std::string& whereTemplate, const std::vector<ColumnBufferPtrVariant>& whereParams)
+	{
+		exASSERT(IsOpen());
+		exASSERT(!m_columns.empty());
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_UPDATE_WHERE));
+		exASSERT(!whereTemplate.empty());
+
+		// Build a statement with parameter-markers, the set params come first
+		vector<ColumnBufferPtrVariant> setParamsToBind;
+		string setMarkers;
+		auto it = m_columns.begin();
+		while (it != m_columns.end())
+		{
+			ColumnBufferPtrVariant pVar = it->second;
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), pVar);
+			if (pFlags->Test(ColumnFlag::CF_UPDATE))
+			{
+				setMarkers += boost::apply_visitor(QueryNameVisitor(), pVar);
+				setMarkers += u8" = ?, ";
+				setParamsToBind.push_back(pVar);
+			}
+			++it;
+		}
+		boost::erase_last(setMarkers, u8", ");
+		exASSERT_MSG(!setParamsToBind.empty(), u8"No Columns flaged for UPDATEing");
+
+		string stmt = boost::str(boost::format(u8"UPDATE %s SET %s WHERE %s") % m_tableInfo.GetQueryName() % setMarkers % whereTemplate);
+		ExecutableStatementPtr pStmt = GetWhereTemplateStatement(stmt, false, false, false, setParamsToBind, whereParams);
+
+		pStmt->ExecutePrepared();
+		InvalidateResultCache();
+	}
+
+
+	void Table::Upsert()
+	{
+		exASSERT(IsOpen());
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_INSERT));
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_UPDATE_PK));
+
+		if (!m_upsertPrepared)
+		{
+			BindUpsertParameters();
+		}
+		if (m_execStmtUpsert.IsInitialized())
+		{
+			m_execStmtUpsert.ExecutePrepared();
+			InvalidateResultCache();
+			return;
+		}
+
+		// No statement to do it at once: Insert if no row has been updated
+		SQLLEN updated = 0;
+		try
+		{
+			m_execStmtUpdatePk.ExecutePrepared();
+			updated = m_execStmtUpdatePk.GetRowCount();
+		}
+		catch (const SqlResultException& ex)
+		{
+			if (ex.GetRet() != SQL_NO_DATA)
+			{
+				throw;
+			}
+		}
+		if (updated < 0)
+		{
+			// The driver does not know the number of rows updated: Find out if the row exists
+			if (!TestAccessFlag(TableAccessFlag::AF_COUNT_WHERE))
+			{
+				Exception ex(boost::str(boost::format(u8"The driver does not report the number of rows updated in table '%s', AF_COUNT_WHERE is required to find out if the row exists") % m_tableInfo.GetQueryName()));
+				SET_EXCEPTION_SOURCE(ex);
+				throw ex;
+			}
+			string whereTemplate;
+			vector<ColumnBufferPtrVariant> whereParams;
+			ColumnBufferPtrVariantMap primaryKeys = GetPrimaryKeyColumnBuffers();
+			for (auto it = primaryKeys.begin(); it != primaryKeys.end(); ++it)
+			{
+				whereTemplate += (whereTemplate.empty() ? u8"" : u8" AND ") + boost::apply_visitor(QueryNameVisitor(), it->second) + u8" = ?";
+				whereParams.push_back(it->second);
+			}
+			updated = (SQLLEN)Count(whereTemplate, whereParams);
+		}
+		if (updated == 0)
+		{
+			m_execStmtInsert.ExecutePrepared();
+		}
+		InvalidateResultCache();
+	}
+
+
+	SQLULEN Table::Upsert(const RowBlock& rows)
+	{
+		exASSERT(IsOpen());
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_INSERT));
+		exASSERT(TestAccessFlag(TableAccessFlag::AF_UPDATE_PK));
+
+		SQLULEN rowCount = rows.GetRowsFetched();
+		if (rowCount == 0)
+		{
+			return 0;
+		}
+		PrepareUpsertArray(rows);
+
+		// Copy the indicators, as values truncated while fetching report a length larger than the buffer
+		SQLUSMALLINT columnCount = rows.GetColumnCount();
+		vector<SQLLEN> elementLengths(columnCount);
+		vector<vector<SQLLEN>> indicators(columnCount);
+		for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+		{
+			const RowColumnDefinition& def = rows.GetColumnDefinition(i);
+			elementLengths[i] = GetRowElementLength(def.m_sqlCType, def.m_nrOfElements);
+			SQLLEN maxIndicator = GetMaxIndicator(def.m_sqlCType, elementLengths[i]);
+			indicators[i].resize(rowCount);
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				SQLLEN cb = rows.GetIndicator(i, row);
+				if (maxIndicator >= 0 && (cb == SQL_NO_TOTAL || cb > maxIndicator))
+				{
+					cb = maxIndicator;
+				}
+				indicators[i][row] = cb;
+			}
+		}
+		auto createParam = [&](SQLUSMALLINT columnIndex, SQLULEN firstRow) -> ParameterArray
+		{
+			return ParameterArray(rows.GetColumnDefinition(columnIndex).m_sqlCType, m_upsertArray.m_columns[columnIndex].m_paramDesc,
+				(SQLPOINTER)rows.GetData(columnIndex, firstRow), elementLengths[columnIndex], &indicators[columnIndex][firstRow]);
+		};
+
+		if (m_upsertArray.m_pUpsert)
+		{
+			vector<ParameterArray> params;
+			for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+			{
+				params.push_back(createParam(i, 0));
+			}
+			m_upsertArray.m_pUpsert->ExecutePreparedArray(params, rowCount);
+			InvalidateResultCache();
+			return rowCount;
+		}
+
+		// Update: first the columns set, then the keys
+		vector<SQLUSMALLINT> updateOrder;
+		bool haveUpdateColumns = std::any_of(m_upsertArray.m_columns.begin(), m_upsertArray.m_columns.end(), [](const UpsertArrayColumn& c) { return !c.m_isKey; });
+		for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+		{
+			bool isKey = m_upsertArray.m_columns[i].m_isKey;
+			if (haveUpdateColumns ? !isKey : isKey)
+			{
+				updateOrder.push_back(i);
+			}
+		}
+		for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+		{
+			if (m_upsertArray.m_columns[i].m_isKey)
+			{
+				updateOrder.push_back(i);
+			}
+		}
+		auto update = [&](SQLULEN firstRow, SQLULEN nrOfRows) -> SQLLEN
+		{
+			vector<ParameterArray> params;
+			for (SQLUSMALLINT columnIndex : updateOrder)
+			{
+				params.push_back(createParam(columnIndex, firstRow));
+			}
+			try
+			{
+				m_upsertArray.m_pUpdate->ExecutePreparedArray(params, nrOfRows);
+			}
+			catch (const SqlResultException& ex)
+			{
+				if (ex.GetRet() != SQL_NO_DATA)
+				{
+					throw;
+				}
+				return 0;
+			}
+			return m_upsertArray.m_pUpdate->GetRowCount();
+		};
+		auto keyExists = [&](SQLULEN row) -> bool
+		{
+			if (!m_upsertArray.m_pCountKey)
+			{
+				string whereMarkers;
+				for (const UpsertArrayColumn& column : m_upsertArray.m_columns)
+				{
+					if (column.m_isKey)
+					{
+						whereMarkers += (whereMarkers.empty() ? u8"" : u8" AND ") + column.m_queryName + u8" = ?";
+					}
+				}
+				ExecutableStatementPtr pCountKey = std::make_shared<ExecutableStatement>(m_pDb);
+				pCountKey->Prepare(boost::str(boost::format(u8"SELECT COUNT(*) FROM %s WHERE %s") % m_tableInfo.GetQueryName() % whereMarkers));
+				UBigIntColumnBufferPtr pKeyCount = UBigIntColumnBuffer::Create(u8"", SQL_UNKNOWN_TYPE, ColumnFlag::CF_SELECT);
+				pCountKey->BindColumn(pKeyCount, 1);
+				m_upsertArray.m_pKeyCount = pKeyCount;
+				m_upsertArray.m_pCountKey = pCountKey;
+			}
+			vector<ParameterArray> params;
+			for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+			{
+				if (m_upsertArray.m_columns[i].m_isKey)
+				{
+					params.push_back(createParam(i, row));
+				}
+			}
+			m_upsertArray.m_pCountKey->ExecutePreparedArray(params, 1);
+			exASSERT(m_upsertArray.m_pCountKey->SelectNext());
+			m_upsertArray.m_pCountKey->SelectClose();
+			return *m_upsertArray.m_pKeyCount > 0;
+		};
+
+		// Try all rows at once, find the missing rows one by one only if some rows exist
+		vector<SQLULEN> missingRows;
+		SQLLEN updated = update(0, rowCount);
+		if (updated < 0)
+		{
+			// The driver does not know the number of rows updated: The existing rows have
+			// been updated, the rows whose keys are not found are missing
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				if (!keyExists(row))
+				{
+					missingRows.push_back(row);
+				}
+			}
+		}
+		else if (updated > 0 && (SQLULEN)updated < rowCount)
+		{
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				if (update(row, 1) <= 0)
+				{
+					missingRows.push_back(row);
+				}
+			}
+		}
+		else if (updated == 0)
+		{
+			for (SQLULEN row = 0; row < rowCount; ++row)
+			{
+				missingRows.push_back(row);
+			}
+		}
+
+		if (!missingRows.empty())
+		{
+			vector<ParameterArray> params;
+			vector<vector<SQLCHAR>> missingData(columnCount);
+			vector<vector<SQLLEN>> missingIndicators(columnCount);
+			for (SQLUSMALLINT i = 0; i < columnCount; ++i)
+			{
+				if (missingRows.size() == rowCount)
+				{
+					params.push_back(createParam(i, 0));
+					continue;
+				}
+				missingData[i].resize(missingRows.size() * elementLengths[i]);
+				for (size_t j = 0; j < missingRows.size(); ++j)
+				{
+					memcpy(&missingData[i][j * elementLengths[i]], rows.GetData(i, missingRows[j]), elementLengths[i]);
+					missingIndicators[i].push_back(indicators[i][missingRows[j]]);
+				}
+				params.push_back(ParameterArray(rows.GetColumnDefinition(i).m_sqlCType, m_upsertArray.m_columns[i].m_paramDesc,
+					(SQLPOINTER)&missingData[i][0], elementLengths[i], &missingIndicators[i][0]));
+			}
+			m_upsertArray.m_pInsert->ExecutePreparedArray(params, missingRows.size());
+		}
+		InvalidateResultCache();
+		return rowCount;
+	}
+
+
+	std::string Table::BuildUpsertSql(DatabaseProduct dbms, const std::string& tableQueryName, const std::vector<std::string>& columns, const std::vector<std::string>& keyColumns, const std::vector<std::string>& updateColumns)
+	{
+		exASSERT(!tableQueryName.empty());
+		exASSERT(!columns.empty());
+		exASSERT(!keyColumns.empty());
+
+		string fields;
+		string markers;
+		for (const string& column : columns)
+		{
+			fields += (fields.empty() ? u8"" : u8", ") + column;
+			markers += markers.empty() ? u8"?" : u8", ?";
+		}
+
+		switch (dbms)
+		{
+		case DatabaseProduct::MS_SQL_SERVER:
+		case DatabaseProduct::DB2:
+		{
+			string on;
+			for (const string& column : keyColumns)
+			{
+				on += string(on.empty() ? u8"" : u8" AND ") + u8"target." + column + u8" = source." + column;
+			}
+			string set;
+			for (const string& column : updateColumns)
+			{
+				set += (set.empty() ? u8"" : u8", ") + column + u8" = source." + column;
+			}
+			string values;
+			for (const string& column : columns)
+			{
+				values += string(values.empty() ? u8"" : u8", ") + u8"source." + column;
+			}
+			// Without HOLDLOCK, concurrent merges of the same new key on ms sql server fail with a key violation
+			bool isSqlServer = dbms == DatabaseProduct::MS_SQL_SERVER;
+			string sql = boost::str(boost::format(u8"MERGE INTO %s %sAS target USING (VALUES (%s)) AS source (%s) ON %s")
+				% tableQueryName % (isSqlServer ? u8"WITH (HOLDLOCK) " : u8"") % markers % fields % on);
+			if (!set.empty())
+			{
+				sql += u8" WHEN MATCHED THEN UPDATE SET " + set;
+			}
+			sql += boost::str(boost::format(u8" WHEN NOT MATCHED THEN INSERT (%s) VALUES (%s)") % fields % values);
+			if (isSqlServer)
+			{
+				// ms sql server requires MERGE to be terminated
+				sql += u8";";
+			}
+			return sql;
+		}
+		case DatabaseProduct::POSTGRESQL:
+		{
+			string keys;
+			for (const string& column : keyColumns)
+			{
+				keys += (keys.empty() ? u8"" : u8", ") + column;
+			}
+			string set;
+			for (const string& column : updateColumns)
+			{
+				set += (set.empty() ? u8"" : u8", ") + column + u8" = EXCLUDED." + column;
+			}
+			return boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (%s) ON CONFLICT (%s) DO %s")
+				% tableQueryName % fields % markers % keys % (set.empty() ? u8"NOTHING" : u8"UPDATE SET " + set));
+		}
+		case DatabaseProduct::MY_SQL:
+		{
+			string set;
+			for (const string& column : updateColumns)
+			{
+				set += (set.empty() ? u8"" : u8", ") + column + u8" = VALUES(" + column + u8")";
+			}
+			if (set.empty())
+			{
+				// Nothing to update, but the statement requires an assignment
+				set = keyColumns.front() + u8" = " + keyColumns.front();
+			}
+			return boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (%s) ON DUPLICATE KEY UPDATE %s") % tableQueryName % fields % markers % set);
+		}
+		default:
+			return u8"";
+		}
+	}
+
+
+	void Table::InvalidateResultCache() const
+	{
+		m_pDb->InvalidateResultCache(m_tableInfo.GetName());
 	}
 
 
@@ -1079,8 +1920,14 @@ namespace exodbc
 			m_openFlags.Set(TableOpenFlag::TOF_DO_NOT_QUERY_PRIMARY_KEYS);
 		}
 
+		int cursorFlags = (int)m_openFlags.Test(TableOpenFlag::TOF_FORWARD_ONLY_READ_ONLY_CURSORS) + (int)m_openFlags.Test(TableOpenFlag::TOF_STATIC_CURSORS)
+			+ (int)m_openFlags.Test(TableOpenFlag::TOF_KEYSET_CURSORS) + (int)m_openFlags.Test(TableOpenFlag::TOF_DYNAMIC_CURSORS);
+		exASSERT_MSG(cursorFlags <= 1, u8"At most one of the TableOpenFlags selecting a cursor type can be set");
+		exASSERT_MSG(!m_openFlags.Test(TableOpenFlag::TOF_BOOKMARKS) || m_openFlags.Test(TableOpenFlag::TOF_SCROLLABLE_CURSORS)
+			|| (cursorFlags == 1 && !m_openFlags.Test(TableOpenFlag::TOF_FORWARD_ONLY_READ_ONLY_CURSORS)), u8"TOF_BOOKMARKS requires a scrollable cursor");
+
 		// Allocate all statements we need
-		AllocateStatements(m_openFlags.Test(TableOpenFlag::TOF_SCROLLABLE_CURSORS));
+		AllocateStatements();
 
 		// Nest try/catch the free the buffers created in here if we fail somewhere
 		// and to unbind all handles that were bound
@@ -1164,17 +2011,7 @@ namespace exodbc
 			// Bind all columns with flag CF_SELECT set to the Select-where and/or Select-pk statement:
 			if (TestAccessFlag(TableAccessFlag::AF_SELECT_WHERE) || TestAccessFlag(TableAccessFlag::AF_SELECT_PK))
 			{
-				SQLSMALLINT boundColumnNumber = 1;
-				for (ColumnBufferPtrVariantMap::iterator it = m_columns.begin(); it != m_columns.end(); it++)
-				{
-					ColumnBufferPtrVariant columnBuffer = it->second;
-					ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), columnBuffer);
-					if (pFlags->Test(ColumnFlag::CF_SELECT))
-					{
-						m_execStmtSelect.BindColumn( columnBuffer, boundColumnNumber);
-						boundColumnNumber++;
-					}
-				}
+				BindSelectColumns(m_execStmtSelect);
 			}
 
 			// Create additional CF_UPDATE and DELETE statement-handles to be used with the pk-columns
@@ -0,0 +1,302 @@
+﻿/*!
+* \file TableCopy.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the TableCopy class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "TableCopy.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "ColumnBufferVisitors.h"
+#include "ExecutableStatement.h"
+#include "TableInfo.h"
+#include "LogManager.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include "boost/algorithm/string.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	namespace
+	{
+		typedef std::chrono::steady_clock CopyClock;
+	}
+
+
+	// Construction
+	// -------------
+	TableCopy::TableCopy(const Table& source, const Table& target)
+		: m_source(source)
+		, m_target(target)
+		, m_blockSize(DEFAULT_ROW_BLOCK_SIZE)
+		, m_queueCapacity(DEFAULT_QUEUE_CAPACITY)
+		, m_commitRows(DEFAULT_COMMIT_ROWS)
+	{ }
+
+
+	// Implementation
+	// --------------
+	void TableCopy::SetBlockSize(SQLULEN blockSize)
+	{
+		exASSERT(blockSize > 0);
+		m_blockSize = blockSize;
+	}
+
+
+	void TableCopy::SetQueueCapacity(size_t queueCapacity)
+	{
+		exASSERT(queueCapacity > 0);
+		m_queueCapacity = queueCapacity;
+	}
+
+
+	std::vector<TableCopy::CopyColumn> TableCopy::MapColumns() const
+	{
+		exASSERT(m_source.IsOpen());
+		exASSERT(m_target.IsOpen());
+
+		std::set<SQLUSMALLINT> sourceIndexes = m_source.GetColumnBufferIndexes();
+		std::vector<CopyColumn> columns;
+		for (SQLUSMALLINT targetIndex : m_target.GetColumnBufferIndexes())
+		{
+			ColumnBufferPtrVariant target = m_target.GetColumnBufferPtrVariant(targetIndex);
+			string targetName = boost::apply_visitor(QueryNameVisitor(), target);
+			for (SQLUSMALLINT sourceIndex : sourceIndexes)
+			{
+				string sourceName = boost::apply_visitor(QueryNameVisitor(), m_source.GetColumnBufferPtrVariant(sourceIndex));
+				if (!boost::algorithm::iequals(sourceName, targetName))
+				{
+					continue;
+				}
+
+				CopyColumn column;
+				column.m_sourceName = sourceName;
+				column.m_targetName = targetName;
+				ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), target);
+				SQLSMALLINT sqlCType = boost::apply_visitor(SqlCTypeVisitor(), target);
+				SQLLEN nrOfElements = boost::apply_visitor(NrOfElementsVisitor(), target);
+				column.m_definition = RowColumnDefinition(sourceName, sqlCType, nrOfElements, pProps->GetColumnSize(), pProps->GetDecimalDigits());
+				column.m_paramDesc = GetRowParameterDescription(boost::apply_visitor(ParamDescVisitor(), target), sqlCType, nrOfElements);
+				columns.push_back(column);
+				break;
+			}
+		}
+
+		if (columns.empty())
+		{
+			Exception ex(boost::str(boost::format(u8"No column of '%s' matches a column of '%s'") % m_target.GetTableInfo().GetQueryName() % m_source.GetTableInfo().GetQueryName()));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		return columns;
+	}
+
+
+	std::vector<std::pair<std::string, std::string>> TableCopy::GetColumnMapping() const
+	{
+		std::vector<std::pair<std::string, std::string>> mapping;
+		for (const CopyColumn& column : MapColumns())
+		{
+			mapping.push_back(std::make_pair(column.m_sourceName, column.m_targetName));
+		}
+		return mapping;
+	}
+
+
+	TableCopyResult TableCopy::Run()
+	{
+		CopyClock::time_point start = CopyClock::now();
+		std::vector<CopyColumn> columns = MapColumns();
+
+		// Build the statements
+		string selectFields;
+		string insertFields;
+		string markers;
+		std::vector<RowColumnDefinition> definitions;
+		for (const CopyColumn& column : columns)
+		{
+			selectFields += (selectFields.empty() ? u8"" : u8", ") + column.m_sourceName;
+			insertFields += (insertFields.empty() ? u8"" : u8", ") + column.m_targetName;
+			markers += markers.empty() ? u8"?" : u8", ?";
+			definitions.push_back(column.m_definition);
+		}
+		string selectSql = boost::str(boost::format(u8"SELECT %s FROM %s") % selectFields % m_source.GetTableInfo().GetQueryName());
+		if (!m_whereStatement.empty())
+		{
+			selectSql += u8" WHERE " + m_whereStatement;
+		}
+		string insertSql = boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (%s)") % m_target.GetTableInfo().GetQueryName() % insertFields % markers);
+
+		ConstDatabasePtr pTargetDb = m_target.GetDatabase();
+		ExecutableStatement insert(pTargetDb);
+		insert.Prepare(insertSql);
+
+		// One connection must not be used by the reading and the writing thread at once
+		ConstDatabasePtr pSourceDb = m_source.GetDatabase();
+		if (pSourceDb == pTargetDb)
+		{
+			pSourceDb = pTargetDb->OpenNewConnection();
+		}
+
+		// State shared with the reading thread
+		mutex queueMutex;
+		condition_variable queueChanged;
+		std::deque<RowBlockPtr> queue;
+		bool readerFinished = false;
+		std::atomic<bool> stop(false);
+		std::exception_ptr pReadError;
+		std::chrono::nanoseconds readTime(0);
+
+		std::thread reader([&]()
+		{
+			try
+			{
+				ExecutableStatement select(pSourceDb);
+				CopyClock::time_point readStart = CopyClock::now();
+				select.ExecuteDirect(selectSql);
+				RowRange rows = select.Rows(definitions, m_blockSize);
+				RowBlock& block = rows.GetBlock();
+				while (!stop.load(std::memory_order_relaxed) && block.NextBlock())
+				{
+					RowBlockPtr pCopy = block.CopyCurrentBlock();
+					readTime += CopyClock::now() - readStart;
+
+					unique_lock<mutex> lock(queueMutex);
+					queueChanged.wait(lock, [&]() { return stop.load(std::memory_order_relaxed) || queue.size() < m_queueCapacity; });
+					queue.push_back(pCopy);
+					queueChanged.notify_all();
+					lock.unlock();
+					readStart = CopyClock::now();
+				}
+			}
+			catch (...)
+			{
+				pReadError = std::current_exception();
+			}
+			lock_guard<mutex> lock(queueMutex);
+			readerFinished = true;
+			queueChanged.notify_all();
+		});
+
+		TableCopyResult result;
+		bool manualCommit = pTargetDb->GetCommitMode() == Database::CommitMode::MANUAL;
+		unsigned long long uncommittedRows = 0;
+		std::exception_ptr pWriteError;
+		try
+		{
+			std::vector<std::vector<SQLLEN>> indicators(columns.size());
+			std::vector<ParameterArray> params(columns.size());
+			while (true)
+			{
+				RowBlockPtr pBlock;
+				{
+					unique_lock<mutex> lock(queueMutex);
+					queueChanged.wait(lock, [&]() { return !queue.empty() || readerFinished; });
+					if (queue.empty())
+					{
+						break;
+					}
+					pBlock = queue.front();
+					queue.pop_front();
+					queueChanged.notify_all();
+				}
+
+				// Bind the arrays of the block. The indicators are copied, as values truncated
+				// while fetching report a length larger than the buffer
+				SQLULEN rowCount = pBlock->GetRowsFetched();
+				for (SQLUSMALLINT i = 0; i < (SQLUSMALLINT)columns.size(); ++i)
+				{
+					const RowColumnDefinition& def = pBlock->GetColumnDefinition(i);
+					SQLLEN elementLength = GetRowElementLength(def.m_sqlCType, def.m_nrOfElements);
+					SQLLEN maxIndicator = GetMaxIndicator(def.m_sqlCType, elementLength);
+					std::vector<SQLLEN>& columnIndicators = indicators[i];
+					columnIndicators.resize(rowCount);
+					for (SQLULEN row = 0; row < rowCount; ++row)
+					{
+						SQLLEN cb = pBlock->GetIndicator(i, row);
+						if (maxIndicator >= 0 && (cb == SQL_NO_TOTAL || cb > maxIndicator))
+						{
+							cb = maxIndicator;
+							++result.m_truncatedValues;
+						}
+						columnIndicators[row] = cb;
+					}
+					params[i] = ParameterArray(def.m_sqlCType, columns[i].m_paramDesc, (SQLPOINTER)pBlock->GetData(i, 0), elementLength, &columnIndicators[0]);
+				}
+
+				CopyClock::time_point writeStart = CopyClock::now();
+				insert.ExecutePreparedArray(params, rowCount);
+				result.m_rows += rowCount;
+				++result.m_blocks;
+				uncommittedRows += rowCount;
+				if (manualCommit && m_commitRows > 0 && uncommittedRows >= m_commitRows)
+				{
+					pTargetDb->CommitTrans();
+					++result.m_commits;
+					uncommittedRows = 0;
+				}
+				result.m_writeTime += CopyClock::now() - writeStart;
+			}
+
+			if (!pReadError && manualCommit && uncommittedRows > 0)
+			{
+				CopyClock::time_point writeStart = CopyClock::now();
+				pTargetDb->CommitTrans();
+				++result.m_commits;
+				result.m_writeTime += CopyClock::now() - writeStart;
+			}
+		}
+		catch (...)
+		{
+			pWriteError = std::current_exception();
+			lock_guard<mutex> lock(queueMutex);
+			stop.store(true, std::memory_order_relaxed);
+			queueChanged.notify_all();
+		}
+		reader.join();
+		m_target.InvalidateResultCache();
+
+		if (pReadError || pWriteError)
+		{
+			if (manualCommit)
+			{
+				try
+				{
+					pTargetDb->RollbackTrans();
+				}
+				catch (const Exception& ex)
+				{
+					LOG_WARNING(boost::str(boost::format(u8"Failed to roll back the copy into '%s': %s") % m_target.GetTableInfo().GetQueryName() % ex.ToString()));
+				}
+			}
+			std::rethrow_exception(pWriteError ? pWriteError : pReadError);
+		}
+
+		result.m_readTime = readTime;
+		result.m_duration = CopyClock::now() - start;
+		LOG_INFO(boost::str(boost::format(u8"Copied %d rows from '%s' to '%s' in %.3f s (%.0f rows/s)") % result.m_rows % m_source.GetTableInfo().GetQueryName()
+			% m_target.GetTableInfo().GetQueryName() % (result.m_duration.count() / 1e9) % result.GetRowsPerSecond()));
+		return result;
+	}
+}
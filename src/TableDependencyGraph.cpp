@@ -0,0 +1,203 @@
+﻿/*!
+* \file TableDependencyGraph.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the TableDependencyGraph class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "TableDependencyGraph.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "SpecializedExceptions.h"
+#include "DatabaseCatalog.h"
+
+// Other headers
+#include "boost/format.hpp"
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// Construction
+	// -------------
+	TableDependencyGraph::TableDependencyGraph(const TableInfoVector& tables)
+		: m_tables(tables)
+		, m_dependencies(tables.size())
+		, m_dependents(tables.size())
+	{ }
+
+
+	TableDependencyGraph TableDependencyGraph::Create(ConstDatabasePtr pDb, const TableInfoVector& tables)
+	{
+		exASSERT(pDb);
+		exASSERT(pDb->IsOpen());
+
+		TableDependencyGraph graph(tables);
+		DatabaseCatalogPtr pDbCat = pDb->GetDbCatalog();
+		for (const TableInfo& table : tables)
+		{
+			for (const ForeignKeyInfo& fk : pDbCat->ReadForeignKeyInfo(table))
+			{
+				graph.AddDependency(fk);
+			}
+		}
+		return graph;
+	}
+
+
+	// Implementation
+	// --------------
+	const TableInfo& TableDependencyGraph::GetTable(size_t index) const
+	{
+		exASSERT(index < m_tables.size());
+		return m_tables[index];
+	}
+
+
+	bool TableDependencyGraph::MatchesTable(size_t index, const std::string& tableName, const std::string& schemaName, const std::string& catalogName) const
+	{
+		const TableInfo& table = m_tables[index];
+		if (table.GetName() != tableName)
+		{
+			return false;
+		}
+		if (!schemaName.empty() && table.HasSchema() && table.GetSchema() != schemaName)
+		{
+			return false;
+		}
+		if (!catalogName.empty() && table.HasCatalog() && table.GetCatalog() != catalogName)
+		{
+			return false;
+		}
+		return true;
+	}
+
+
+	size_t TableDependencyGraph::FindTable(const std::string& tableName, const std::string& schemaName /* = u8"" */, const std::string& catalogName /* = u8"" */) const
+	{
+		for (size_t i = 0; i < m_tables.size(); ++i)
+		{
+			if (MatchesTable(i, tableName, schemaName, catalogName))
+			{
+				return i;
+			}
+		}
+		NotFoundException nfe(boost::str(boost::format(u8"No table matching tableName '%s', schemaName '%s', catalogName '%s' is part of the graph")
+			% tableName % schemaName % catalogName));
+		SET_EXCEPTION_SOURCE(nfe);
+		throw nfe;
+	}
+
+
+	void TableDependencyGraph::AddDependency(size_t table, size_t referencedTable)
+	{
+		exASSERT(table < m_tables.size());
+		exASSERT(referencedTable < m_tables.size());
+
+		if (table == referencedTable)
+		{
+			return;
+		}
+		m_dependencies[table].insert(referencedTable);
+		m_dependents[referencedTable].insert(table);
+	}
+
+
+	bool TableDependencyGraph::AddDependency(const ForeignKeyInfo& fk)
+	{
+		size_t fkTable = m_tables.size();
+		size_t pkTable = m_tables.size();
+		for (size_t i = 0; i < m_tables.size(); ++i)
+		{
+			if (fkTable == m_tables.size() && MatchesTable(i, fk.GetFkTable(), fk.GetFkSchema(), fk.GetFkCatalog()))
+			{
+				fkTable = i;
+			}
+			if (pkTable == m_tables.size() && MatchesTable(i, fk.GetPkTable(), fk.GetPkSchema(), fk.GetPkCatalog()))
+			{
+				pkTable = i;
+			}
+		}
+		if (fkTable == m_tables.size() || pkTable == m_tables.size())
+		{
+			return false;
+		}
+		AddDependency(fkTable, pkTable);
+		return true;
+	}
+
+
+	const std::set<size_t>& TableDependencyGraph::GetDependencies(size_t table) const
+	{
+		exASSERT(table < m_tables.size());
+		return m_dependencies[table];
+	}
+
+
+	const std::set<size_t>& TableDependencyGraph::GetDependents(size_t table) const
+	{
+		exASSERT(table < m_tables.size());
+		return m_dependents[table];
+	}
+
+
+	std::vector<std::vector<size_t>> TableDependencyGraph::GetWaves() const
+	{
+		vector<size_t> remaining(m_tables.size());
+		vector<size_t> wave;
+		for (size_t i = 0; i < m_tables.size(); ++i)
+		{
+			remaining[i] = m_dependencies[i].size();
+			if (remaining[i] == 0)
+			{
+				wave.push_back(i);
+			}
+		}
+
+		vector<vector<size_t>> waves;
+		size_t ordered = 0;
+		while (!wave.empty())
+		{
+			set<size_t> next;
+			for (size_t table : wave)
+			{
+				for (size_t dependent : m_dependents[table])
+				{
+					if (--remaining[dependent] == 0)
+					{
+						next.insert(dependent);
+					}
+				}
+			}
+			ordered += wave.size();
+			waves.push_back(wave);
+			wave.assign(next.begin(), next.end());
+		}
+
+		if (ordered < m_tables.size())
+		{
+			string tables;
+			for (size_t i = 0; i < m_tables.size(); ++i)
+			{
+				if (remaining[i] > 0)
+				{
+					tables += (tables.empty() ? u8"'" : u8", '") + m_tables[i].GetQueryName() + u8"'";
+				}
+			}
+			Exception ex(boost::str(boost::format(u8"The foreign keys form a cycle, the following tables depend on each other or on a cycle: %s") % tables));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+		return waves;
+	}
+}
@@ -0,0 +1,251 @@
+﻿/*!
+* \file TableLoadScheduler.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the TableLoadScheduler class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "TableLoadScheduler.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "Table.h"
+#include "LogManager.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	namespace
+	{
+		typedef std::chrono::steady_clock LoadClock;
+	}
+
+
+	/*!
+	* \struct TableLoadScheduler::LoadState
+	* \brief State shared by the threads of one Run().
+	*/
+	struct TableLoadScheduler::LoadState
+	{
+		LoadState(const TableDependencyGraph& graph)
+			: m_remainingDependencies(graph.GetTableCount())
+			, m_loaded(0)
+			, m_running(0)
+			, m_maxRunning(0)
+			, m_stop(false)
+			, m_tableRows(graph.GetTableCount(), 0)
+			, m_tableDurations(graph.GetTableCount(), std::chrono::nanoseconds(0))
+		{
+			for (size_t i = 0; i < graph.GetTableCount(); ++i)
+			{
+				m_remainingDependencies[i] = graph.GetDependencies(i).size();
+				if (m_remainingDependencies[i] == 0)
+				{
+					m_ready.push_back(i);
+				}
+			}
+		};
+
+		/*!
+		* \brief	Remember the first error and stop starting tables.
+		*/
+		void Fail(std::exception_ptr pError)
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (!m_pError)
+			{
+				m_pError = pError;
+			}
+			m_stop = true;
+			m_changed.notify_all();
+		}
+
+		std::mutex m_mutex;	///< Protects all members.
+		std::condition_variable m_changed;	///< Notified if a table has become ready, all tables are loaded or the load stops.
+		std::vector<size_t> m_remainingDependencies;	///< Number of dependencies not loaded yet per table.
+		std::deque<size_t> m_ready;	///< Tables whose dependencies are loaded, but that have not been started.
+		size_t m_loaded;	///< Number of tables loaded.
+		size_t m_running;	///< Number of tables loading right now.
+		size_t m_maxRunning;	///< Largest value m_running had.
+		bool m_stop;	///< Set if the load must stop because of an error.
+		std::vector<unsigned long long> m_tableRows;	///< Rows reported per table.
+		std::vector<std::chrono::nanoseconds> m_tableDurations;	///< Time spent loading per table.
+		std::exception_ptr m_pError;	///< The first error.
+	};
+
+
+	// Construction
+	// -------------
+	TableLoadScheduler::TableLoadScheduler(const TableDependencyGraph& graph, ConstDatabasePtr pDb)
+		: m_graph(graph)
+		, m_pDb(pDb)
+		, m_concurrency(std::max(std::thread::hardware_concurrency(), 1u))
+	{
+		exASSERT(m_pDb);
+	}
+
+
+	// Implementation
+	// --------------
+	void TableLoadScheduler::SetConcurrency(size_t concurrency)
+	{
+		exASSERT(concurrency > 0);
+		m_concurrency = concurrency;
+	}
+
+
+	TableLoadResult TableLoadScheduler::Run(const TableLoadTask& task)
+	{
+		exASSERT(task);
+
+		return RunWorkers([this, &task](size_t, size_t table, DatabasePtr pDb)
+		{
+			return task(m_graph.GetTable(table), pDb);
+		});
+	}
+
+
+	TableLoadResult TableLoadScheduler::RunCopy(ConnectionFactory sourceFactory, const TableInfoVector& sourceTables, const TableCopySetup& setup /* = TableCopySetup() */)
+	{
+		exASSERT(sourceFactory);
+		exASSERT_MSG(sourceTables.size() == m_graph.GetTableCount(), boost::str(boost::format(u8"%d source tables passed to copy into %d tables") % sourceTables.size() % m_graph.GetTableCount()));
+
+		// Every element is only used by the thread of its worker
+		vector<DatabasePtr> sourceDbs(std::min(m_concurrency, m_graph.GetTableCount()));
+		return RunWorkers([&](size_t worker, size_t table, DatabasePtr pDb)
+		{
+			DatabasePtr& pSourceDb = sourceDbs[worker];
+			if (!pSourceDb)
+			{
+				pSourceDb = sourceFactory();
+				exASSERT(pSourceDb);
+			}
+
+			const TableInfo& targetInfo = m_graph.GetTable(table);
+			Table source(pSourceDb, TableAccessFlag::AF_READ_WITHOUT_PK, sourceTables[table]);
+			source.Open();
+			Table target(pDb, TableAccessFlag::AF_READ_WITHOUT_PK, targetInfo);
+			target.Open();
+
+			TableCopy copy(source, target);
+			if (setup)
+			{
+				setup(targetInfo, copy);
+			}
+			return copy.Run().m_rows;
+		});
+	}
+
+
+	TableLoadResult TableLoadScheduler::RunWorkers(const WorkerTask& task)
+	{
+		LoadClock::time_point start = LoadClock::now();
+		TableLoadResult result;
+		result.m_waves = m_graph.GetWaves().size();
+
+		LoadState state(m_graph);
+		size_t workerCount = std::min(m_concurrency, m_graph.GetTableCount());
+		vector<std::thread> threads;
+		threads.reserve(workerCount);
+		try
+		{
+			for (size_t i = 0; i < workerCount; ++i)
+			{
+				threads.push_back(std::thread(&TableLoadScheduler::LoadTables, this, i, std::cref(task), std::ref(state)));
+			}
+		}
+		catch (...)
+		{
+			state.Fail(std::current_exception());
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		if (state.m_pError)
+		{
+			std::rethrow_exception(state.m_pError);
+		}
+
+		result.m_tables = state.m_loaded;
+		result.m_maxConcurrentTables = state.m_maxRunning;
+		result.m_tableRows = state.m_tableRows;
+		result.m_tableDurations = state.m_tableDurations;
+		for (unsigned long long rows : result.m_tableRows)
+		{
+			result.m_rows += rows;
+		}
+		result.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(LoadClock::now() - start);
+		LOG_INFO(boost::str(boost::format(u8"Loaded %d tables in %d waves with up to %d concurrent tables in %.3f s") % result.m_tables % result.m_waves
+			% result.m_maxConcurrentTables % (result.m_duration.count() / 1e9)));
+		return result;
+	}
+
+
+	void TableLoadScheduler::LoadTables(size_t worker, const WorkerTask& task, LoadState& state) const
+	{
+		try
+		{
+			DatabasePtr pDb = m_connectionFactory ? m_connectionFactory() : m_pDb->OpenNewConnection();
+			exASSERT(pDb);
+
+			while (true)
+			{
+				size_t table = 0;
+				{
+					unique_lock<mutex> lock(state.m_mutex);
+					state.m_changed.wait(lock, [&]() { return state.m_stop || !state.m_ready.empty() || state.m_loaded == m_graph.GetTableCount(); });
+					if (state.m_stop || state.m_ready.empty())
+					{
+						return;
+					}
+					table = state.m_ready.front();
+					state.m_ready.pop_front();
+					++state.m_running;
+					state.m_maxRunning = std::max(state.m_maxRunning, state.m_running);
+				}
+
+				LoadClock::time_point tableStart = LoadClock::now();
+				unsigned long long rows = task(worker, table, pDb);
+				std::chrono::nanoseconds duration = std::chrono::duration_cast<std::chrono::nanoseconds>(LoadClock::now() - tableStart);
+
+				lock_guard<mutex> lock(state.m_mutex);
+				--state.m_running;
+				++state.m_loaded;
+				state.m_tableRows[table] = rows;
+				state.m_tableDurations[table] = duration;
+				for (size_t dependent : m_graph.GetDependents(table))
+				{
+					if (--state.m_remainingDependencies[dependent] == 0)
+					{
+						state.m_ready.push_back(dependent);
+					}
+				}
+				state.m_changed.notify_all();
+			}
+		}
+		catch (...)
+		{
+			state.Fail(std::current_exception());
+		}
+	}
+}
@@ -0,0 +1,230 @@
+﻿/*!
+* \file TablePaginator.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \brief Source file for the TablePaginator class.
+* \copyright GNU Lesser General Public License Version 3
+*
+*/
+
+// Own header
+#include "TablePaginator.h"
+
+// Same component headers
+#include "AssertionException.h"
+#include "ColumnBufferVisitors.h"
+#include "TableInfo.h"
+
+// Other headers
+#include "boost/format.hpp"
+#include <cstring>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+using namespace std;
+
+namespace exodbc
+{
+	// Construction
+	// -------------
+	TablePaginator::TablePaginator(const Table& table, SQLULEN pageSize, const std::string& whereStatement /* = u8"" */)
+		: m_table(table)
+		, m_pageSize(pageSize)
+		, m_pageCount(0)
+		, m_done(false)
+	{
+		exASSERT(m_table.IsOpen());
+		exASSERT(m_pageSize > 0);
+
+		string fields;
+		std::vector<string> keyNames;
+		std::vector<ParameterDescription> keyDescs;
+		for (SQLUSMALLINT index : m_table.GetColumnBufferIndexes())
+		{
+			const ColumnBufferPtrVariant& var = m_table.GetColumnBufferPtrVariant(index);
+			ColumnFlagsPtr pFlags = boost::apply_visitor(ColumnFlagsPtrVisitor(), var);
+			if (!pFlags->Test(ColumnFlag::CF_SELECT))
+			{
+				if (pFlags->Test(ColumnFlag::CF_PRIMARY_KEY))
+				{
+					// Seeking on only a part of the key would skip or repeat rows
+					Exception ex(boost::str(boost::format(u8"Primary key column '%s' of '%s' is not selected, cannot page through it") % boost::apply_visitor(QueryNameVisitor(), var) % m_table.GetTableInfo().GetQueryName()));
+					SET_EXCEPTION_SOURCE(ex);
+					throw ex;
+				}
+				continue;
+			}
+			string queryName = boost::apply_visitor(QueryNameVisitor(), var);
+			ColumnPropertiesPtr pProps = boost::apply_visitor(ColumnPropertiesPtrVisitor(), var);
+			SQLSMALLINT sqlCType = boost::apply_visitor(SqlCTypeVisitor(), var);
+			SQLLEN nrOfElements = boost::apply_visitor(NrOfElementsVisitor(), var);
+			fields += (fields.empty() ? u8"" : u8", ") + queryName;
+			if (pFlags->Test(ColumnFlag::CF_PRIMARY_KEY))
+			{
+				KeyValue key;
+				key.m_columnIndex = (SQLUSMALLINT)m_definitions.size();
+				key.m_data.resize(GetRowElementLength(sqlCType, nrOfElements));
+				key.m_cb = SQL_NULL_DATA;
+				m_keys.push_back(key);
+				keyNames.push_back(queryName);
+				keyDescs.push_back(GetRowParameterDescription(boost::apply_visitor(ParamDescVisitor(), var), sqlCType, nrOfElements));
+			}
+			m_definitions.push_back(RowColumnDefinition(queryName, sqlCType, nrOfElements, pProps->GetColumnSize(), pProps->GetDecimalDigits()));
+		}
+
+		const string& tableName = m_table.GetTableInfo().GetQueryName();
+		if (m_keys.empty())
+		{
+			Exception ex(boost::str(boost::format(u8"No primary key column of '%s' is selected, cannot page through it") % tableName));
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}
+
+		string orderStatement;
+		for (const string& keyName : keyNames)
+		{
+			orderStatement += (orderStatement.empty() ? u8"" : u8", ") + keyName;
+		}
+		DatabaseProduct dbms = m_table.GetDatabase()->GetDbms();
+		std::vector<size_t> paramKeys;
+		string keyCondition = BuildKeyCondition(dbms, keyNames, paramKeys);
+		string nextWhere = whereStatement.empty() ? keyCondition : boost::str(boost::format(u8"(%s) AND (%s)") % whereStatement % keyCondition);
+		m_firstPageSql = BuildPageSql(dbms, fields, tableName, whereStatement, orderStatement, m_pageSize);
+		m_nextPageSql = BuildPageSql(dbms, fields, tableName, nextWhere, orderStatement, m_pageSize);
+
+		// m_keys does not change anymore, the parameters can point to its values
+		for (size_t keyIndex : paramKeys)
+		{
+			KeyValue& key = m_keys[keyIndex];
+			const RowColumnDefinition& def = m_definitions[key.m_columnIndex];
+			m_keyParams.push_back(ParameterArray(def.m_sqlCType, keyDescs[keyIndex], (SQLPOINTER)&key.m_data[0], (SQLLEN)key.m_data.size(), &key.m_cb));
+		}
+
+		m_firstPageStmt.Init(m_table.GetDatabase(), false);
+		m_firstPageStmt.Prepare(m_firstPageSql);
+		m_nextPageStmt.Init(m_table.GetDatabase(), false);
+		m_nextPageStmt.Prepare(m_nextPageSql);
+	}
+
+
+	// Implementation
+	// --------------
+	std::string TablePaginator::BuildKeyCondition(DatabaseProduct dbms, const std::vector<std::string>& keyNames, std::vector<size_t>& paramKeys)
+	{
+		exASSERT(!keyNames.empty());
+
+		if (keyNames.size() > 1 && (dbms == DatabaseProduct::POSTGRESQL || dbms == DatabaseProduct::MY_SQL))
+		{
+			string names;
+			string markers;
+			for (size_t i = 0; i < keyNames.size(); ++i)
+			{
+				names += (names.empty() ? u8"" : u8", ") + keyNames[i];
+				markers += markers.empty() ? u8"?" : u8", ?";
+				paramKeys.push_back(i);
+			}
+			return boost::str(boost::format(u8"(%s) > (%s)") % names % markers);
+		}
+
+		// Expand (k1, k2, k3) > (?, ?, ?) to k1 > ? OR (k1 = ? AND k2 > ?) OR (k1 = ? AND k2 = ? AND k3 > ?)
+		string condition;
+		for (size_t i = 0; i < keyNames.size(); ++i)
+		{
+			string term;
+			for (size_t j = 0; j < i; ++j)
+			{
+				term += keyNames[j] + u8" = ? AND ";
+				paramKeys.push_back(j);
+			}
+			term += keyNames[i] + u8" > ?";
+			paramKeys.push_back(i);
+			if (i > 0)
+			{
+				condition += u8" OR (" + term + u8")";
+			}
+			else
+			{
+				condition = term;
+			}
+		}
+		return condition;
+	}
+
+
+	std::string TablePaginator::BuildPageSql(DatabaseProduct dbms, const std::string& fields, const std::string& tableName,
+		const std::string& whereStatement, const std::string& orderStatement, SQLULEN pageSize)
+	{
+		exASSERT(!orderStatement.empty());
+
+		string where = whereStatement.empty() ? u8"" : u8" WHERE " + whereStatement;
+		switch (dbms)
+		{
+		case DatabaseProduct::MS_SQL_SERVER:
+		case DatabaseProduct::ACCESS:
+		case DatabaseProduct::EXCEL:
+			return boost::str(boost::format(u8"SELECT TOP %d %s FROM %s%s ORDER BY %s") % pageSize % fields % tableName % where % orderStatement);
+		case DatabaseProduct::MY_SQL:
+		case DatabaseProduct::POSTGRESQL:
+			return boost::str(boost::format(u8"SELECT %s FROM %s%s ORDER BY %s LIMIT %d") % fields % tableName % where % orderStatement % pageSize);
+		default:
+			return boost::str(boost::format(u8"SELECT %s FROM %s%s ORDER BY %s FETCH FIRST %d ROWS ONLY") % fields % tableName % where % orderStatement % pageSize);
+		}
+	}
+
+
+	RowBlockPtr TablePaginator::NextPage()
+	{
+		if (m_done)
+		{
+			return RowBlockPtr();
+		}
+
+		ExecutableStatement& stmt = m_pageCount == 0 ? m_firstPageStmt : m_nextPageStmt;
+		if (m_pageCount == 0)
+		{
+			m_firstPageStmt.ExecutePrepared();
+		}
+		else
+		{
+			m_nextPageStmt.ExecutePreparedArray(m_keyParams, 1);
+		}
+
+		// The whole page is fetched with one call to SQLFetch
+		RowBlockPtr pPage;
+		{
+			RowRange rows = stmt.Rows(m_definitions, m_pageSize);
+			RowBlock& block = rows.GetBlock();
+			if (block.NextBlock())
+			{
+				pPage = block.CopyCurrentBlock();
+			}
+		}
+		stmt.SelectClose();
+
+		if (!pPage)
+		{
+			m_done = true;
+			return pPage;
+		}
+		SQLULEN lastRow = pPage->GetRowsFetched() - 1;
+		for (KeyValue& key : m_keys)
+		{
+			memcpy(&key.m_data[0], pPage->GetData(key.m_columnIndex, lastRow), key.m_data.size());
+			key.m_cb = pPage->GetIndicator(key.m_columnIndex, lastRow);
+		}
+		m_done = pPage->GetRowsFetched() < m_pageSize;
+		++m_pageCount;
+		return pPage;
+	}
+
+
+	void TablePaginator::Reset() noexcept
+	{
+		m_pageCount = 0;
+		m_done = false;
+	}
+} // namespace exodbc
@@ -14,6 +14,7 @@
 #include "SpecializedExceptions.h"
 #include "AssertionException.h"
 #include "Sql2StringHelper.h"
+#include "OdbcTrace.h"
 
 // Other headers
 // Debug
@@ -122,7 +123,7 @@ namespace exodbc {
 				errMsg[0] = '\0';
                 sqlState[0] = '\0';
 				SQLSMALLINT cb = 0;
-				ret = SQLGetDiagRec(handleType, handle, recNr, sqlState, &errInfo.NativeError, errMsg, SQL_MAX_MESSAGE_LENGTH + 1, &cb);
+				ret = TRACE_ODBC_CALL(SQLGetDiagRec, handleType, handle, recNr, sqlState, &errInfo.NativeError, errMsg, SQL_MAX_MESSAGE_LENGTH + 1, &cb);
 				if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
 				{
                     std::string ssqlState = SQLAPICHARPTR_TO_EXODBCSTR(sqlState);
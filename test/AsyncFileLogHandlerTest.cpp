@@ -0,0 +1,253 @@
+﻿/*!
+* \file AsyncFileLogHandlerTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "AsyncFileLogHandlerTest.h"
+
+// Same component headers
+// Other headers
+#include "exodbc/LogHandler.h"
+#include "exodbc/BoundedMpscQueue.h"
+
+// System headers
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+// Construction
+// -------------
+
+// Destructor
+// -----------
+
+// Implementation
+// --------------
+using namespace std;
+using namespace exodbc;
+
+namespace exodbctest
+{
+	// BoundedMpscQueue
+	// ================
+	TEST_F(BoundedMpscQueueTest, PushAndPop)
+	{
+		BoundedMpscQueue<int> queue(4);
+		EXPECT_EQ(4, queue.GetCapacity());
+
+		int value = 0;
+		EXPECT_FALSE(queue.TryPop(value));
+		for (int i = 1; i <= 4; ++i)
+		{
+			value = i;
+			EXPECT_TRUE(queue.TryPush(value));
+		}
+		EXPECT_EQ(4, queue.GetSizeApprox());
+
+		// full
+		value = 5;
+		EXPECT_FALSE(queue.TryPush(value));
+		EXPECT_EQ(5, value);
+
+		// in order
+		for (int i = 1; i <= 4; ++i)
+		{
+			EXPECT_TRUE(queue.TryPop(value));
+			EXPECT_EQ(i, value);
+		}
+		EXPECT_FALSE(queue.TryPop(value));
+	}
+
+
+	TEST_F(BoundedMpscQueueTest, InvalidCapacity)
+	{
+		LogLevelSetter ll(LogLevel::None);
+		EXPECT_THROW(BoundedMpscQueue<int>(3), AssertionException);
+	}
+
+
+	TEST_F(BoundedMpscQueueTest, ManyProducers)
+	{
+		const int nrOfProducers = 4;
+		const int nrOfValues = 10000;
+		BoundedMpscQueue<int> queue(64);
+
+		vector<thread> producers;
+		for (int p = 0; p < nrOfProducers; ++p)
+		{
+			producers.push_back(thread([&queue, nrOfValues]()
+			{
+				for (int i = 1; i <= nrOfValues; ++i)
+				{
+					int value = i;
+					while (!queue.TryPush(value))
+					{
+						this_thread::yield();
+					}
+				}
+			}));
+		}
+
+		long long sum = 0;
+		int popped = 0;
+		int value = 0;
+		while (popped < nrOfProducers * nrOfValues)
+		{
+			if (queue.TryPop(value))
+			{
+				sum += value;
+				++popped;
+			}
+			else
+			{
+				this_thread::yield();
+			}
+		}
+		for (thread& t : producers)
+		{
+			t.join();
+		}
+
+		EXPECT_EQ((long long)nrOfProducers * nrOfValues * (nrOfValues + 1) / 2, sum);
+		EXPECT_FALSE(queue.TryPop(value));
+	}
+
+
+	// AsyncFileLogHandler
+	// ===================
+	void AsyncFileLogHandlerTest::SetUp()
+	{
+		m_logFile = u8"AsyncFileLogHandlerTest.log";
+		std::remove(m_logFile.c_str());
+	}
+
+
+	void AsyncFileLogHandlerTest::TearDown()
+	{
+		std::remove(m_logFile.c_str());
+	}
+
+
+	size_t AsyncFileLogHandlerTest::CountLines() const
+	{
+		ifstream in(m_logFile);
+		size_t lines = 0;
+		string line;
+		while (getline(in, line))
+		{
+			++lines;
+		}
+		return lines;
+	}
+
+
+	TEST_F(AsyncFileLogHandlerTest, WriteMessages)
+	{
+		AsyncFileLogHandler handler(m_logFile, true);
+		EXPECT_EQ(AsyncFileLogHandler::OverflowPolicy::Drop, handler.GetOverflowPolicy());
+		for (int i = 0; i < 100; ++i)
+		{
+			handler.OnLogMessage(LogLevel::Info, u8"Hello", __FILE__, __LINE__, __FUNCTION__);
+		}
+		handler.Flush();
+
+		EXPECT_EQ(100, handler.GetWrittenCount());
+		EXPECT_EQ(0, handler.GetDroppedCount());
+		EXPECT_EQ(100, CountLines());
+	}
+
+
+	TEST_F(AsyncFileLogHandlerTest, DestructorWritesPending)
+	{
+		{
+			AsyncFileLogHandler handler(m_logFile, false);
+			for (int i = 0; i < 100; ++i)
+			{
+				handler.OnLogMessage(LogLevel::Warning, u8"Hello");
+			}
+		}
+		EXPECT_EQ(100, CountLines());
+	}
+
+
+	TEST_F(AsyncFileLogHandlerTest, DropOnOverflow)
+	{
+		const int nrOfMessages = 10000;
+		AsyncFileLogHandler handler(m_logFile, false, AsyncFileLogHandler::OverflowPolicy::Drop, 2);
+		for (int i = 0; i < nrOfMessages; ++i)
+		{
+			handler.OnLogMessage(LogLevel::Info, u8"Hello");
+		}
+		handler.Flush();
+
+		// Whatever has not been dropped has been written
+		EXPECT_EQ(nrOfMessages, handler.GetWrittenCount() + handler.GetDroppedCount());
+		EXPECT_EQ(handler.GetWrittenCount(), CountLines());
+	}
+
+
+	TEST_F(AsyncFileLogHandlerTest, BlockOnOverflow)
+	{
+		const int nrOfProducers = 4;
+		const int nrOfMessages = 2500;
+		AsyncFileLogHandler handler(m_logFile, false, AsyncFileLogHandler::OverflowPolicy::Block, 2);
+
+		vector<thread> producers;
+		for (int p = 0; p < nrOfProducers; ++p)
+		{
+			producers.push_back(thread([&handler, nrOfMessages]()
+			{
+				for (int i = 0; i < nrOfMessages; ++i)
+				{
+					handler.OnLogMessage(LogLevel::Info, u8"Hello");
+				}
+			}));
+		}
+		for (thread& t : producers)
+		{
+			t.join();
+		}
+		handler.Flush();
+
+		EXPECT_EQ(0, handler.GetDroppedCount());
+		EXPECT_EQ(nrOfProducers * nrOfMessages, handler.GetWrittenCount());
+		EXPECT_EQ(nrOfProducers * nrOfMessages, CountLines());
+	}
+
+
+	TEST_F(AsyncFileLogHandlerTest, FlushWhileQueueNeverRunsEmpty)
+	{
+		AsyncFileLogHandler handler(m_logFile, false, AsyncFileLogHandler::OverflowPolicy::Block, 2);
+		for (int i = 0; i < 100; ++i)
+		{
+			handler.OnLogMessage(LogLevel::Info, u8"Hello");
+		}
+
+		// Keep the queue full, Flush() must not wait for it to run empty
+		std::atomic<bool> stop(false);
+		thread producer([&handler, &stop]()
+		{
+			while (!stop)
+			{
+				handler.OnLogMessage(LogLevel::Info, u8"Hello");
+			}
+		});
+		handler.Flush();
+		EXPECT_LE(100, handler.GetWrittenCount());
+		stop = true;
+		producer.join();
+	}
+} // namespace exodbctest
@@ -0,0 +1,47 @@
+﻿/*!
+* \file AsyncFileLogHandlerTest.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief Header-file description]
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTest.h"
+
+// Other headers
+#include "gtest/gtest.h"
+
+// System headers
+#include <string>
+
+// Forward declarations
+// --------------------
+
+namespace exodbctest
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	class BoundedMpscQueueTest : public ::testing::Test
+	{
+	};
+
+
+	class AsyncFileLogHandlerTest : public ::testing::Test
+	{
+	protected:
+		virtual void SetUp();
+		virtual void TearDown();
+
+		size_t CountLines() const;
+
+		std::string m_logFile;
+	};
+
+} // namespace exodbctest
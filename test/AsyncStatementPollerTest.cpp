@@ -0,0 +1,99 @@
+﻿/*!
+* \file AsyncStatementPollerTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "AsyncStatementPollerTest.h"
+
+// Same component headers
+// Other headers
+#include "exodbc/AsyncStatementPoller.h"
+
+// System headers
+#include <future>
+#include <atomic>
+
+// Debug
+#include "DebugNew.h"
+
+// Static consts
+// -------------
+
+// Construction
+// -------------
+
+// Destructor
+// -----------
+
+// Implementation
+// --------------
+using namespace std;
+using namespace exodbc;
+
+namespace exodbctest
+{
+
+	TEST_F(AsyncStatementPollerTest, CompleteOperations)
+	{
+		AsyncStatementPoller poller(std::chrono::microseconds(100));
+
+		// Submit some operations that need a different number of polls to complete
+		const int nrOfOperations = 10;
+		std::vector<std::shared_ptr<std::promise<SQLRETURN>>> promises;
+		std::vector<std::shared_ptr<std::atomic<int>>> pollCounts;
+		for (int i = 0; i < nrOfOperations; ++i)
+		{
+			auto pPromise = std::make_shared<std::promise<SQLRETURN>>();
+			auto pPollCount = std::make_shared<std::atomic<int>>(0);
+			promises.push_back(pPromise);
+			pollCounts.push_back(pPollCount);
+			poller.Submit([pPollCount, i]() -> SQLRETURN
+			{
+				int count = ++(*pPollCount);
+				if (count <= i)
+					return SQL_STILL_EXECUTING;
+				return i % 2 == 0 ? SQL_SUCCESS : SQL_NO_DATA;
+			},
+			[pPromise](SQLRETURN ret) { pPromise->set_value(ret); });
+		}
+
+		for (int i = 0; i < nrOfOperations; ++i)
+		{
+			SQLRETURN ret = promises[i]->get_future().get();
+			EXPECT_EQ(i % 2 == 0 ? SQL_SUCCESS : SQL_NO_DATA, ret);
+			EXPECT_EQ(i + 1, pollCounts[i]->load());
+		}
+		EXPECT_EQ(0, poller.GetPendingCount());
+	}
+
+
+	TEST_F(AsyncStatementPollerTest, DestructorCompletesPending)
+	{
+		std::atomic<bool> completed(false);
+		{
+			AsyncStatementPoller poller;
+			auto pPollCount = std::make_shared<std::atomic<int>>(0);
+			poller.Submit([pPollCount]() -> SQLRETURN
+			{
+				return ++(*pPollCount) < 5 ? SQL_STILL_EXECUTING : SQL_SUCCESS;
+			},
+			[&completed](SQLRETURN) { completed = true; });
+		}
+		EXPECT_TRUE(completed);
+	}
+
+
+	TEST_F(AsyncStatementPollerTest, PollInterval)
+	{
+		AsyncStatementPoller poller;
+		EXPECT_EQ(std::chrono::microseconds(1000), poller.GetPollInterval());
+		poller.SetPollInterval(std::chrono::microseconds(50));
+		EXPECT_EQ(std::chrono::microseconds(50), poller.GetPollInterval());
+	}
+
+} // namespace exodbctest
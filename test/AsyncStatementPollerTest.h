@@ -0,0 +1,42 @@
+﻿/*!
+* \file AsyncStatementPollerTest.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief Header-file description]
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTest.h"
+
+// Other headers
+#include "gtest/gtest.h"
+
+// System headers
+
+// Forward declarations
+// --------------------
+
+namespace exodbctest
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	class AsyncStatementPollerTest : public ::testing::Test
+	{
+
+	public:
+		//static void SetUpTestCase() {};
+		//static void TearDownTestCase() {};
+
+	protected:
+		//virtual void SetUp();
+		//virtual void TearDown();
+	};
+
+} // namespace exodbctest
@@ -0,0 +1,173 @@
+﻿/*!
+* \file BulkRowsetTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "BulkRowsetTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/LogManager.h"
+
+// System headers
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void BulkRowsetTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	void BulkRowsetTest::ModifyRows(bool allowPositioned, bool allowBookmarks)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		Table table(m_pDb, TableAccessFlag::AF_READ_WRITE, GetTableName(TableId::INTEGERTYPES_TMP));
+		if (m_pDb->GetDbms() == DatabaseProduct::ACCESS)
+		{
+			table.SetColumnPrimaryKeyIndexes({ 0 });
+		}
+		ASSERT_NO_THROW(table.Open());
+
+		BulkRowset rowset(table, 3, allowPositioned, allowBookmarks);
+		if (!allowPositioned)
+		{
+			EXPECT_FALSE(rowset.IsPositioned());
+		}
+		if (!allowBookmarks)
+		{
+			EXPECT_FALSE(rowset.IsByBookmark());
+		}
+		SQLUSMALLINT idCol = 0;
+		SQLUSMALLINT intCol = 2;
+
+		// Add ids 1 to 5 with two calls, the rowset holds three rows
+		SQLINTEGER id = 1;
+		for (SQLULEN rowCount : { 3, 2 })
+		{
+			ASSERT_NO_THROW(rowset.Select(u8"1 = 0"));
+			ASSERT_NO_THROW(rowset.BeginAdd(rowCount));
+			EXPECT_EQ(rowCount, rowset.GetRowCount());
+			for (SQLULEN row = 0; row < rowCount; ++row, ++id)
+			{
+				EXPECT_TRUE(rowset.GetRow(row).IsNull(intCol));
+				rowset.SetValue<SQLINTEGER>(idCol, row, id);
+				rowset.SetValue<SQLINTEGER>(intCol, row, id * 10);
+			}
+			EXPECT_EQ(rowCount, rowset.AddRows());
+		}
+		m_pDb->CommitTrans();
+		EXPECT_EQ(5, table.Count());
+
+		// Update the odd ids, delete the even ones
+		SQLULEN changed = 0;
+		ASSERT_NO_THROW(rowset.Select());
+		while (rowset.FetchNext())
+		{
+			if (changed == 0)
+			{
+				// Primary key values can only be set when adding
+				LogLevelSetter ll(LogLevel::None);
+				EXPECT_THROW(rowset.SetNull(idCol, 0), AssertionException);
+			}
+			for (SQLULEN row = 0; row < rowset.GetRowCount(); ++row)
+			{
+				RowView view = rowset.GetRow(row);
+				SQLINTEGER rowId = view.Get<SQLINTEGER>(idCol);
+				EXPECT_EQ(rowId * 10, view.Get<SQLINTEGER>(intCol));
+				if (rowId % 2 == 0)
+				{
+					rowset.MarkDeleted(row);
+				}
+				else
+				{
+					rowset.SetValue<SQLINTEGER>(intCol, row, rowId * 100);
+					rowset.MarkUpdated(row);
+				}
+			}
+			EXPECT_TRUE(rowset.HasPendingChanges());
+			changed += rowset.ApplyChanges();
+			EXPECT_FALSE(rowset.HasPendingChanges());
+		}
+		EXPECT_EQ(5, changed);
+		rowset.Select(u8"1 = 0");
+		m_pDb->CommitTrans();
+
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		EXPECT_EQ(3, table.Count());
+		RowRange rows = table.Rows(u8"", idColName);
+		SQLINTEGER expected = 1;
+		for (const RowView& row : rows)
+		{
+			EXPECT_EQ(expected, row.Get<SQLINTEGER>(0));
+			EXPECT_EQ(expected * 100, row.Get<SQLINTEGER>(2));
+			expected += 2;
+		}
+		EXPECT_EQ(7, expected);
+	}
+
+
+	TEST_F(BulkRowsetTest, ModifyRowsPositioned)
+	{
+		ModifyRows(true, false);
+	}
+
+
+	TEST_F(BulkRowsetTest, ModifyRowsByBookmark)
+	{
+		ModifyRows(true, true);
+	}
+
+
+	TEST_F(BulkRowsetTest, ModifyRowsUsingStatements)
+	{
+		ModifyRows(false, false);
+	}
+
+
+	TEST_F(BulkRowsetTest, NoPrimaryKey)
+	{
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(table.Open());
+
+		BulkRowset rowset(table, 4, false);
+		ASSERT_NO_THROW(rowset.Select());
+		ASSERT_TRUE(rowset.FetchNext());
+		EXPECT_EQ(4, rowset.GetRowCount());
+
+		// Without a primary key the rows cannot be identified
+		LogLevelSetter ll(LogLevel::None);
+		rowset.MarkDeleted(1);
+		EXPECT_THROW(rowset.ApplyChanges(), Exception);
+	}
+} // namespace exodbctest
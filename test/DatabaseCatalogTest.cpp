@@ -475,4 +475,58 @@ namespace exodbctest
 
 	}
 
+
+	TEST_F(DatabaseCatalogTest, ReadForeignKeyInfo)
+	{
+		DatabaseCatalog dbCat(m_pDb->GetSqlDbcHandle(), m_pDb->GetProperties());
+		TableInfo intTableInfo = dbCat.FindOneTable(GetTableName(TableId::INTEGERTYPES));
+
+		// The test tables do not reference each other
+		ForeignKeyInfoVector fks;
+		ASSERT_NO_THROW(fks = dbCat.ReadForeignKeyInfo(intTableInfo));
+		EXPECT_TRUE(fks.empty());
+	}
+
+
+	TEST_F(DatabaseCatalogTest, ReadStatistics)
+	{
+		DatabaseCatalog dbCat(m_pDb->GetSqlDbcHandle(), m_pDb->GetProperties());
+		TableInfo intTableInfo = dbCat.FindOneTable(GetTableName(TableId::INTEGERTYPES));
+
+		// The primary key of integertypes is backed by a unique index on the id column
+		TableStatistics stats;
+		ASSERT_NO_THROW(stats = dbCat.ReadStatistics(intTableInfo, true));
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		bool foundId = false;
+		for (const IndexInfo& column : stats.GetIndexColumns())
+		{
+			EXPECT_FALSE(column.IsTableStatistics());
+			EXPECT_TRUE(column.IsUnique());
+			if (column.GetColumnName() == idColName)
+			{
+				foundId = true;
+			}
+		}
+		EXPECT_TRUE(foundId);
+
+		// Every index has its columns numbered starting at 1
+		for (const string& indexName : stats.GetIndexNames())
+		{
+			IndexInfoVector columns = stats.GetIndexColumns(indexName);
+			ASSERT_FALSE(columns.empty());
+			EXPECT_EQ(1, columns.front().GetOrdinalPosition());
+		}
+
+		// Cardinalities are estimates on some databases, only check they are sane
+		ASSERT_NO_THROW(stats = dbCat.ReadStatistics(intTableInfo, false, false));
+		if (stats.HasCardinality())
+		{
+			EXPECT_GE(stats.GetCardinality(), 0);
+		}
+		else
+		{
+			LOG_INFO(u8"Driver does not report the cardinality of a table");
+		}
+	}
+
 } //namespace exodbc
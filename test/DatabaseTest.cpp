@@ -408,6 +408,33 @@ namespace exodbctest
 	}
 
 
+	TEST_F(DatabaseTest, ExecSqlBatchKeepsLaterResultSet)
+	{
+		DatabasePtr pDb = OpenTestDb();
+		if (!pDb->GetSupportsBatches())
+		{
+			LOG_WARNING(u8"Skipping test because database does not support batches");
+			return;
+		}
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		string tableName = PrependSchemaOrCatalogName(pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES_TMP));
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string sqlBatch = boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (101); SELECT COUNT(*) FROM %s") % tableName % idColName % tableName);
+
+		// The result set of the SELECT following the INSERT is kept open
+		pDb->ExecSql(sqlBatch);
+		SQLRETURN ret = SQLFetch(pDb->GetExecSqlHandle()->GetHandle());
+		ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+		SQLINTEGER count;
+		SQLLEN cb;
+		GetDataWrapper::GetData(pDb->GetExecSqlHandle(), 1, SQL_C_SLONG, &count, sizeof(count), &cb, NULL);
+		EXPECT_EQ(1, count);
+		pDb->RollbackTrans();
+	}
+
+
 	TEST_F(DatabaseTest, TestScrollableCursorSupport)
 	{
 		// Test that for Database where we think no support is built-in, false is returned
@@ -15,9 +15,13 @@
 
 // Other headers
 #include "exodbc/ExecutableStatement.h"
+#include "exodbc/ExecutableStatementCoroutines.h"
 #include "exodbc/ColumnBufferVisitors.h"
 #include "exodbc/Table.h"
 
+// System headers
+#include <algorithm>
+
 // Debug
 #include "DebugNew.h"
 
@@ -37,6 +41,68 @@ namespace exodbctest
 
 	// Implementation
 	// --------------
+#if EXODBC_HAS_COROUTINES
+	namespace
+	{
+		// Minimal eagerly started coroutine type, results are delivered through a std::promise
+		struct TestCoroutine
+		{
+			struct promise_type
+			{
+				TestCoroutine get_return_object() { return TestCoroutine(); }
+				std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+				std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+			};
+		};
+
+
+		TestCoroutine SelectIds(ExecutableStatement& stmt, std::string sqlstmt, LongColumnBufferPtr pIdCol, std::promise<std::vector<SQLINTEGER>>& result)
+		{
+			try
+			{
+				co_await AsyncExecuteDirect(stmt, sqlstmt);
+				std::vector<SQLINTEGER> ids;
+				AsyncRowStream<> rows(stmt);
+				while (co_await rows.Next())
+				{
+					ids.push_back(*pIdCol);
+				}
+				result.set_value(ids);
+			}
+			catch (...)
+			{
+				result.set_exception(std::current_exception());
+			}
+		}
+
+
+		TestCoroutine SelectIdBlocks(ExecutableStatement& stmt, std::string sqlstmt, std::string idColName, std::promise<std::vector<SQLINTEGER>>& result)
+		{
+			try
+			{
+				co_await AsyncExecuteDirect(stmt, sqlstmt);
+				std::vector<SQLINTEGER> ids;
+				AsyncBlockStream<> blocks(stmt, stmt.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, 3));
+				ColumnAccessor<SQLINTEGER> id = blocks.GetRange().GetAccessor<SQLINTEGER>(0);
+				while (co_await blocks.Next())
+				{
+					const RowBlock& block = blocks.GetBlock();
+					for (SQLULEN i = 0; i < block.GetRowsFetched(); ++i)
+					{
+						ids.push_back(id(RowView(&block, i)));
+					}
+				}
+				result.set_value(ids);
+			}
+			catch (...)
+			{
+				result.set_exception(std::current_exception());
+			}
+		}
+	}
+#endif
 
 	void ExecutableStatementTest::SetUp()
 	{
@@ -389,6 +455,103 @@ namespace exodbctest
 	}
 
 
+	TEST_F(ExecutableStatementTest, CursorProfile)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string tableQueryName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string idName = GetIdColumnName(TableId::INTEGERTYPES);
+		string sqlsmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s >= 2 ORDER BY %s ASC") % idName %tableQueryName %idName %idName);
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idName, SQL_UNKNOWN_TYPE);
+
+		// Forward-only read-only is always supported
+		{
+			ExecutableStatement ds(m_pDb, CursorProfile::ForwardOnlyReadOnly());
+			CursorProfile profile = ds.GetCursorProfile();
+			EXPECT_EQ(CursorType::FORWARD_ONLY, profile.m_type);
+			EXPECT_EQ(CursorConcurrency::READ_ONLY, profile.m_concurrency);
+			ds.BindColumn(pIdCol, 1);
+			ds.ExecuteDirect(sqlsmt);
+			EXPECT_TRUE(ds.SelectNext());
+			EXPECT_EQ(2, *pIdCol);
+		}
+
+		// An insensitive cursor cannot be locking
+		{
+			LogLevelSetter ll(LogLevel::None);
+			EXPECT_THROW(ExecutableStatement ds(m_pDb, CursorProfile(CursorType::STATIC, CursorConcurrency::LOCK, CursorSensitivity::INSENSITIVE)), Exception);
+		}
+
+		if (!m_pDb->GetSupportsCursorProfile(CursorProfile::StaticReadOnly()))
+		{
+			LOG_WARNING(u8"Skipping remaining test because Database does not support static cursors");
+			return;
+		}
+		{
+			ExecutableStatement ds(m_pDb, CursorProfile::StaticReadOnly());
+			CursorProfile profile = ds.GetCursorProfile();
+			EXPECT_EQ(CursorType::STATIC, profile.m_type);
+			EXPECT_EQ(CursorConcurrency::READ_ONLY, profile.m_concurrency);
+			ds.BindColumn(pIdCol, 1);
+			ds.ExecuteDirect(sqlsmt);
+			EXPECT_TRUE(ds.SelectLast());
+			EXPECT_EQ(7, *pIdCol);
+			EXPECT_TRUE(ds.SelectFirst());
+			EXPECT_EQ(2, *pIdCol);
+		}
+
+		// The handle released to the pool has been reset to the default cursor
+		ExecutableStatement ds(m_pDb);
+		EXPECT_EQ(CursorType::FORWARD_ONLY, ds.GetCursorProfile().m_type);
+	}
+
+
+	TEST_F(ExecutableStatementTest, Bookmarks)
+	{
+		if (!m_pDb->GetSupportsCursorProfile(CursorProfile::StaticReadOnly()) || !m_pDb->GetSupportsBookmarks(CursorType::STATIC))
+		{
+			LOG_WARNING(u8"Skipping test because Database does not support bookmarks on static cursors");
+			return;
+		}
+
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string tableQueryName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string idName = GetIdColumnName(TableId::INTEGERTYPES);
+		string sqlsmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s ASC") % idName %tableQueryName %idName);
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idName, SQL_UNKNOWN_TYPE);
+
+		ExecutableStatement ds(m_pDb, CursorProfile::StaticReadOnly());
+		ASSERT_NO_THROW(ds.SetUseBookmarks(true));
+		EXPECT_TRUE(ds.GetUseBookmarks());
+		ds.BindColumn(pIdCol, 1);
+		ds.ExecuteDirect(sqlsmt);
+
+		// Remember the rows 2 and 5
+		EXPECT_TRUE(ds.SelectAbsolute(2));
+		EXPECT_EQ(2, *pIdCol);
+		Bookmark second = ds.GetBookmark();
+		EXPECT_FALSE(second.empty());
+		EXPECT_TRUE(ds.SelectAbsolute(5));
+		Bookmark fifth = ds.GetBookmark();
+
+		// And jump between them
+		EXPECT_TRUE(ds.SelectLast());
+		EXPECT_EQ(7, *pIdCol);
+		EXPECT_TRUE(ds.SelectBookmark(second));
+		EXPECT_EQ(2, *pIdCol);
+		EXPECT_TRUE(ds.SelectBookmark(fifth));
+		EXPECT_EQ(5, *pIdCol);
+		EXPECT_TRUE(ds.SelectBookmark(second, 1));
+		EXPECT_EQ(3, *pIdCol);
+
+		// Without bookmarks there is nothing to read
+		ds.SelectClose();
+		ds.UnbindColumns();
+		EXPECT_FALSE(ds.GetUseBookmarks());
+		LogLevelSetter ll(LogLevel::None);
+		EXPECT_THROW(ds.GetBookmark(), Exception);
+	}
+
+
 	TEST_F(ExecutableStatementTest, WriteValues)
 	{
 		// Prepare to insert some values
@@ -439,4 +602,355 @@ namespace exodbctest
 		iTable.Open();
 		EXPECT_EQ(10, iTable.Count());
 	}
+
+
+	TEST_F(ExecutableStatementTest, ExecuteDirectAsync)
+	{
+		if (!m_pDb->GetSupportsAsyncStatements())
+		{
+			LOG_WARNING(u8"Database does not support asynchronous execution on statement level, testing the blocking fallback");
+		}
+
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		ExecutableStatement ds(m_pDb);
+		ds.BindColumn(pIdCol, 1);
+
+		std::future<void> execFuture = ds.ExecuteDirectAsync(sqlstmt);
+		EXPECT_NO_THROW(execFuture.get());
+
+		// Fetch all 7 records async
+		for (int i = 1; i <= 7; ++i)
+		{
+			std::future<bool> fetchFuture = ds.SelectNextAsync();
+			EXPECT_TRUE(fetchFuture.get());
+			EXPECT_EQ(i, *pIdCol);
+		}
+		EXPECT_FALSE(ds.SelectNextAsync().get());
+
+		// Once completed, the statement can be used blocking again
+		ds.ExecuteDirect(sqlstmt);
+		EXPECT_TRUE(ds.SelectNext());
+		EXPECT_EQ(1, *pIdCol);
+
+		// Failures are reported through the future
+		execFuture = ds.ExecuteDirectAsync(u8"SELECT FOO FROM NOT_EXISTING_TABLE");
+		{
+			LogLevelSetter ll(LogLevel::None);
+			EXPECT_THROW(execFuture.get(), SqlResultException);
+		}
+	}
+
+
+	TEST_F(ExecutableStatementTest, ExecutePreparedAsync)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s = ?") % idColName % queryTableName % idColName);
+
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		ExecutableStatement ps(m_pDb);
+		ps.Prepare(sqlstmt);
+		ps.BindColumn(pIdCol, 1);
+		ps.BindParameter(pIdParam, 1);
+
+		// Run several executions in a row on the same statement
+		for (int i = 1; i <= 3; ++i)
+		{
+			pIdParam->SetValue(i);
+			EXPECT_NO_THROW(ps.ExecutePreparedAsync().get());
+			EXPECT_TRUE(ps.SelectNextAsync().get());
+			EXPECT_EQ(i, *pIdCol);
+			EXPECT_FALSE(ps.SelectNextAsync().get());
+		}
+	}
+
+
+	TEST_F(ExecutableStatementTest, ExecuteDirectAsyncCallback)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s = 3") % idColName % queryTableName % idColName);
+
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		ExecutableStatement ds(m_pDb);
+		ds.BindColumn(pIdCol, 1);
+
+		std::promise<void> executed;
+		ds.ExecuteDirectAsync(sqlstmt, [&executed](std::exception_ptr pEx)
+		{
+			if (pEx)
+				executed.set_exception(pEx);
+			else
+				executed.set_value();
+		});
+		EXPECT_NO_THROW(executed.get_future().get());
+
+		std::promise<bool> fetched;
+		ds.SelectNextAsync([&fetched](bool hasRecord, std::exception_ptr pEx)
+		{
+			if (pEx)
+				fetched.set_exception(pEx);
+			else
+				fetched.set_value(hasRecord);
+		});
+		EXPECT_TRUE(fetched.get_future().get());
+		EXPECT_EQ(3, *pIdCol);
+	}
+
+
+	TEST_F(ExecutableStatementTest, NextBlockAsync)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		ExecutableStatement ds(m_pDb);
+		ds.ExecuteDirect(sqlstmt);
+		RowRange rows = ds.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, 2);
+		ColumnAccessor<SQLINTEGER> id = rows.GetAccessor<SQLINTEGER>(0);
+		RowBlock& block = rows.GetBlock();
+
+		// 7 records in blocks of 2, the last block is a short one
+		SQLINTEGER expected = 1;
+		for (SQLULEN expectedRows : { 2, 2, 2, 1 })
+		{
+			EXPECT_TRUE(ds.NextBlockAsync(block).get());
+			ASSERT_EQ(expectedRows, block.GetRowsFetched());
+			for (SQLULEN i = 0; i < block.GetRowsFetched(); ++i)
+			{
+				EXPECT_EQ(expected++, id(RowView(&block, i)));
+			}
+		}
+		// Known to be exhausted after the short block, completes without fetching
+		EXPECT_FALSE(ds.NextBlockAsync(block).get());
+		EXPECT_TRUE(block.IsExhausted());
+	}
+
+
+	TEST_F(ExecutableStatementTest, Rows)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		ExecutableStatement ds(m_pDb);
+		ds.ExecuteDirect(sqlstmt);
+
+		// Fetch in blocks of 2 rows, the last block is a short one
+		RowRange rows = ds.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, 2);
+		EXPECT_EQ(1, rows.GetColumnCount());
+		EXPECT_EQ(2, rows.GetBlockSize());
+		EXPECT_EQ(0, rows.GetColumnIndex(idColName));
+		EXPECT_THROW(rows.GetColumnIndex(u8"NotExisting"), NotFoundException);
+
+		SQLINTEGER expected = 1;
+		for (const RowView& row : rows)
+		{
+			EXPECT_FALSE(row.IsNull(0));
+			EXPECT_EQ(expected, row.Get<SQLINTEGER>(0));
+			++expected;
+		}
+		EXPECT_EQ(8, expected);
+		// input range: it stays consumed
+		EXPECT_TRUE(rows.begin() == rows.end());
+	}
+
+
+	TEST_F(ExecutableStatementTest, RowsDescribed)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s > 3 ORDER BY %s") % idColName % queryTableName % idColName % idColName);
+
+		ExecutableStatement ds(m_pDb);
+		ds.ExecuteDirect(sqlstmt);
+
+		// Types are taken from the Sql2BufferTypeMap, we only count
+		{
+			RowRange rows = ds.Rows();
+			EXPECT_EQ(1, rows.GetColumnCount());
+			EXPECT_EQ(4, std::count_if(rows.begin(), rows.end(), [](const RowView& row) { return !row.IsNull(0); }));
+		}
+
+		// The statement can be used as usual once the range is gone
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		ds.BindColumn(pIdCol, 1);
+		ds.ExecuteDirect(sqlstmt);
+		EXPECT_TRUE(ds.SelectNext());
+		EXPECT_TRUE(ds.SelectNext());
+		EXPECT_EQ(5, *pIdCol);
+	}
+
+
+	TEST_F(ExecutableStatementTest, MoreResults)
+	{
+		if (!m_pDb->GetSupportsBatches())
+		{
+			LOG_WARNING(u8"Skipping test because database does not support batches");
+			return;
+		}
+
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s <= 2; SELECT %s, tint FROM %s WHERE %s = 3")
+			% idColName % queryTableName % idColName % idColName % queryTableName % idColName);
+
+		ExecutableStatement ds(m_pDb);
+		ds.ExecuteDirect(sqlstmt);
+		{
+			RowRange rows = ds.Rows();
+			EXPECT_EQ(1, rows.GetColumnCount());
+			EXPECT_EQ(2, std::count_if(rows.begin(), rows.end(), [](const RowView& row) { return !row.IsNull(0); }));
+		}
+
+		EXPECT_TRUE(ds.MoreResults());
+		EXPECT_EQ(2, ds.GetNrOfColumns());
+		{
+			RowRange rows = ds.Rows();
+			EXPECT_EQ(1, std::count_if(rows.begin(), rows.end(), [](const RowView& row) { return !row.IsNull(0); }));
+		}
+
+		EXPECT_FALSE(ds.MoreResults());
+	}
+
+
+	TEST_F(ExecutableStatementTest, ExecuteBatch)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+
+		std::vector<string> statements;
+		for (int i = 1; i <= 3; ++i)
+		{
+			statements.push_back(boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES(%d)") % queryTableName % idColName % i));
+		}
+		statements.push_back(boost::str(boost::format(u8"DELETE FROM %s WHERE %s >= 2") % queryTableName % idColName));
+
+		ExecutableStatement ds(m_pDb);
+		std::vector<SQLLEN> rowCounts = ds.ExecuteBatch(statements);
+		m_pDb->CommitTrans();
+		ASSERT_EQ(4, rowCounts.size());
+		EXPECT_EQ(1, rowCounts[0]);
+		EXPECT_EQ(1, rowCounts[1]);
+		EXPECT_EQ(1, rowCounts[2]);
+		EXPECT_EQ(2, rowCounts[3]);
+
+		// the statement can be used again
+		ds.ExecuteDirect(boost::str(boost::format(u8"DELETE FROM %s") % queryTableName));
+		EXPECT_EQ(1, ds.GetRowCount());
+		m_pDb->CommitTrans();
+	}
+
+
+	TEST_F(ExecutableStatementTest, CallProcedure)
+	{
+		if (m_pDb->GetDbms() != DatabaseProduct::MS_SQL_SERVER || !m_pDb->GetSupportsProcedures())
+		{
+			LOG_WARNING(u8"Skipping test because the test procedure is only created on Microsoft SQL Server");
+			return;
+		}
+
+		m_pDb->ExecSql(u8"IF OBJECT_ID('exodbc_tmp_proc', 'P') IS NOT NULL DROP PROCEDURE exodbc_tmp_proc");
+		m_pDb->ExecSql(u8"CREATE PROCEDURE exodbc_tmp_proc @a INT, @b INT OUTPUT, @c INT OUTPUT AS BEGIN SET NOCOUNT ON; SELECT @a AS a; SET @c = @a * @b; SET @b = @b + 1; RETURN @a + 100; END");
+		m_pDb->CommitTrans();
+
+		LongColumnBufferPtr pRet = LongColumnBuffer::Create(u8"ret", SQL_INTEGER);
+		LongColumnBufferPtr pA = LongColumnBuffer::Create(u8"a", SQL_INTEGER);
+		LongColumnBufferPtr pB = LongColumnBuffer::Create(u8"b", SQL_INTEGER);
+		LongColumnBufferPtr pC = LongColumnBuffer::Create(u8"c", SQL_INTEGER);
+		pA->SetValue(3);
+		pB->SetValue(4);
+		pC->SetNull();
+
+		ExecutableStatement ds(m_pDb);
+		ds.Prepare(ExecutableStatement::CreateCallStatement(u8"exodbc_tmp_proc", 3, true));
+		ds.BindParameter(pRet, 1, ParameterDirection::OUTPUT, true);
+		ds.BindParameter(pA, 2, ParameterDirection::INPUT, true);
+		ds.BindParameter(pB, 3, ParameterDirection::INPUT_OUTPUT, true);
+		ds.BindParameter(pC, 4, ParameterDirection::OUTPUT, true);
+		ds.ExecutePrepared();
+
+		// Read the result set, output parameters are written once all results are processed
+		LongColumnBufferPtr pCol = LongColumnBuffer::Create(u8"a", SQL_INTEGER);
+		ds.BindColumn(pCol, 1);
+		EXPECT_TRUE(ds.SelectNext());
+		EXPECT_EQ(3, *pCol);
+		ds.FinishResults();
+
+		EXPECT_EQ(103, *pRet);
+		EXPECT_EQ(5, *pB);
+		EXPECT_FALSE(pC->IsNull());
+		EXPECT_EQ(12, *pC);
+
+		ds.Reset();
+		m_pDb->ExecSql(u8"DROP PROCEDURE exodbc_tmp_proc");
+		m_pDb->CommitTrans();
+	}
+
+
+	TEST(ExecutableStatement, CreateCallStatement)
+	{
+		EXPECT_EQ(u8"{call p}", ExecutableStatement::CreateCallStatement(u8"p", 0));
+		EXPECT_EQ(u8"{call s.p(?, ?)}", ExecutableStatement::CreateCallStatement(u8"s.p", 2));
+		EXPECT_EQ(u8"{? = call p}", ExecutableStatement::CreateCallStatement(u8"p", 0, true));
+		EXPECT_EQ(u8"{? = call p(?)}", ExecutableStatement::CreateCallStatement(u8"p", 1, true));
+	}
+
+
+#if EXODBC_HAS_COROUTINES
+	TEST_F(ExecutableStatementTest, CoroutineSelectRows)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		LongColumnBufferPtr pIdCol = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		ExecutableStatement ds(m_pDb);
+		ds.BindColumn(pIdCol, 1);
+
+		std::promise<std::vector<SQLINTEGER>> result;
+		SelectIds(ds, sqlstmt, pIdCol, result);
+		std::vector<SQLINTEGER> ids = result.get_future().get();
+		ASSERT_EQ(7, ids.size());
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			EXPECT_EQ((SQLINTEGER) i + 1, ids[i]);
+		}
+	}
+
+
+	TEST_F(ExecutableStatementTest, CoroutineSelectBlocks)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		ExecutableStatement ds(m_pDb);
+
+		std::promise<std::vector<SQLINTEGER>> result;
+		SelectIdBlocks(ds, sqlstmt, idColName, result);
+		std::vector<SQLINTEGER> ids = result.get_future().get();
+		ASSERT_EQ(7, ids.size());
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			EXPECT_EQ((SQLINTEGER) i + 1, ids[i]);
+		}
+	}
+#endif
 } // namespace exodbctest
@@ -15,12 +15,45 @@
 #include "exodbc/LogManager.h"
 #include "exodbc/LogHandler.h"
 
+// System headers
+#include <atomic>
+
 // Debug
 #include "DebugNew.h"
 
 using namespace exodbc;
 using namespace std;
 
+namespace
+{
+	// Counts the messages it receives
+	class CountingLogHandler
+		: public LogHandler
+	{
+	public:
+		CountingLogHandler()
+			: m_count(0)
+		{ };
+
+		void OnLogMessage(LogLevel level, const std::string& msg, const std::string& filename = u8"", int line = 0, const std::string& functionname = u8"") const override
+		{
+			++m_count;
+		};
+
+		bool operator==(const LogHandler& other) const override { return this == &other; };
+
+		mutable std::atomic<int> m_count;
+	};
+
+
+	// Builds a message and counts how often it was called
+	std::string CountedMessage(int& count)
+	{
+		++count;
+		return u8"Message";
+	}
+}
+
 namespace exodbctest
 {
 	TEST_F(LogManagerTest, Construction)
@@ -45,4 +78,52 @@ namespace exodbctest
 		mg.ClearLogHandlers();
 		EXPECT_EQ(0, mg.GetRegisteredLogHandlersCount());
 	}
+
+
+	TEST_F(LogManagerTest, LazyFormatting)
+	{
+		LogManager& mg = LogManager::Get();
+		std::shared_ptr<CountingLogHandler> pHandler = std::make_shared<CountingLogHandler>();
+		mg.RegisterLogHandler(pHandler);
+
+		int formatted = 0;
+		{
+			// Messages below the global level are not even built
+			LogLevelSetter ll(LogLevel::Warning);
+			EXPECT_FALSE(mg.IsLogLevelEnabled(LogLevel::Info));
+			LOG_INFO(CountedMessage(formatted));
+			EXPECT_EQ(0, formatted);
+			EXPECT_EQ(0, pHandler->m_count);
+
+			LOG_ERROR(CountedMessage(formatted));
+			EXPECT_EQ(1, formatted);
+			EXPECT_EQ(1, pHandler->m_count);
+		}
+
+		{
+			// Debug messages are only built if compiled in
+			LogLevelSetter ll(LogLevel::Debug);
+			formatted = 0;
+			LOG_DEBUG(CountedMessage(formatted));
+			int expected = IsLogLevelCompiledIn(LogLevel::Debug) ? 1 : 0;
+			EXPECT_EQ(expected, formatted);
+			EXPECT_EQ(1 + expected, pHandler->m_count);
+		}
+
+		mg.RemoveLogHandler(pHandler);
+	}
+
+
+	TEST_F(LogManagerTest, DebugCompiledInDebugBuilds)
+	{
+		// Unless the cmake variable EXODBC_MIN_LOG_LEVEL has been set
+#if EXODBC_MIN_LOG_LEVEL == EXODBC_DEFAULT_MIN_LOG_LEVEL
+#ifdef NDEBUG
+		EXPECT_FALSE(IsLogLevelCompiledIn(LogLevel::Debug));
+#else
+		EXPECT_TRUE(IsLogLevelCompiledIn(LogLevel::Debug));
+#endif
+		EXPECT_TRUE(IsLogLevelCompiledIn(LogLevel::Info));
+#endif
+	}
 } // namespace exodbctest
\ No newline at end of file
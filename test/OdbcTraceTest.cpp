@@ -0,0 +1,210 @@
+﻿/*!
+* \file OdbcTraceTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "OdbcTraceTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+
+// System headers
+#include <algorithm>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+
+	// LatencyHistogramTest
+	// ====================
+	TEST_F(LatencyHistogramTest, Buckets)
+	{
+		// Small values are exact
+		for (unsigned long long v = 0; v < LatencyHistogram::SUB_BUCKET_COUNT * 2; ++v)
+		{
+			size_t bucket = LatencyHistogram::GetBucketIndex(v);
+			EXPECT_EQ(v, LatencyHistogram::GetBucketLowerBound(bucket));
+			EXPECT_EQ(v, LatencyHistogram::GetBucketUpperBound(bucket));
+		}
+
+		// Every value is within the bounds of its bucket, and buckets do not overlap
+		for (size_t bucket = 1; bucket < LatencyHistogram::BUCKET_COUNT; ++bucket)
+		{
+			EXPECT_EQ(LatencyHistogram::GetBucketUpperBound(bucket - 1) + 1, LatencyHistogram::GetBucketLowerBound(bucket));
+		}
+		for (unsigned long long v : { 100ULL, 1000ULL, 123456789ULL, 1ULL << 40, ~0ULL })
+		{
+			size_t bucket = LatencyHistogram::GetBucketIndex(v);
+			EXPECT_LE(LatencyHistogram::GetBucketLowerBound(bucket), v);
+			EXPECT_GE(LatencyHistogram::GetBucketUpperBound(bucket), v);
+		}
+		EXPECT_EQ(LatencyHistogram::BUCKET_COUNT - 1, LatencyHistogram::GetBucketIndex(~0ULL));
+	}
+
+
+	TEST_F(LatencyHistogramTest, Percentiles)
+	{
+		LatencyHistogram histogram;
+		EXPECT_EQ(0, histogram.GetValueAtPercentile(50.0));
+
+		// 1 .. 1000
+		for (unsigned long long v = 1; v <= 1000; ++v)
+		{
+			histogram.Record(v);
+		}
+		EXPECT_EQ(1000, histogram.GetCount());
+
+		// Values are known within 12.5%
+		unsigned long long p50 = histogram.GetValueAtPercentile(50.0);
+		EXPECT_GE(p50, 500);
+		EXPECT_LE(p50, 500 * 1.125);
+		unsigned long long p99 = histogram.GetValueAtPercentile(99.0);
+		EXPECT_GE(p99, 990);
+		EXPECT_LE(p99, 990 * 1.125);
+		EXPECT_EQ(1, histogram.GetValueAtPercentile(0.0));
+		EXPECT_GE(histogram.GetValueAtPercentile(100.0), 1000);
+
+		histogram.Reset();
+		EXPECT_EQ(0, histogram.GetCount());
+		EXPECT_EQ(0, histogram.GetValueAtPercentile(50.0));
+	}
+
+
+	// OdbcTracerTest
+	// ==============
+	TEST_F(OdbcTracerTest, Trace)
+	{
+		OdbcTracer tracer;
+		OdbcCallStats& stats = tracer.GetCallStats(u8"SQLFetch");
+		EXPECT_EQ(&stats, &tracer.GetCallStats(u8"SQLFetch"));
+		// Functions never called are not reported
+		tracer.GetCallStats(u8"SQLExecute");
+
+		int calls = 0;
+		EXPECT_EQ(SQL_SUCCESS, tracer.Trace(stats, [&]() { ++calls; return (SQLRETURN) SQL_SUCCESS; }));
+		EXPECT_EQ(SQL_ERROR, tracer.Trace(stats, [&]() { ++calls; return (SQLRETURN) SQL_ERROR; }));
+		EXPECT_EQ(2, calls);
+
+		vector<OdbcCallStatistics> statistics = tracer.GetStatistics();
+		ASSERT_EQ(1, statistics.size());
+		EXPECT_EQ(u8"SQLFetch", statistics.front().m_functionName);
+		EXPECT_EQ(2, statistics.front().m_callCount);
+		EXPECT_EQ(1, statistics.front().m_errorCount);
+		EXPECT_LE(statistics.front().m_maxTime, statistics.front().m_totalTime);
+
+		// Reset keeps the stats referenced
+		tracer.Reset();
+		EXPECT_TRUE(tracer.GetStatistics().empty());
+		EXPECT_EQ(&stats, &tracer.GetCallStats(u8"SQLFetch"));
+	}
+
+
+	TEST_F(OdbcTracerTest, SampleLog)
+	{
+		OdbcTracer tracer;
+		OdbcCallStats& stats = tracer.GetCallStats(u8"SQLFetch");
+
+		// Disabled by default
+		tracer.Trace(stats, []() { return (SQLRETURN) SQL_SUCCESS; });
+		EXPECT_TRUE(tracer.GetSamples().empty());
+
+		// Keep the last 3 calls
+		tracer.SetSampleLog(3);
+		for (SQLRETURN ret = 0; ret < 5; ++ret)
+		{
+			tracer.Trace(stats, [ret]() { return ret; });
+		}
+		vector<OdbcTraceSample> samples = tracer.GetSamples();
+		ASSERT_EQ(3, samples.size());
+		EXPECT_EQ(2, samples[0].m_ret);
+		EXPECT_EQ(3, samples[1].m_ret);
+		EXPECT_EQ(4, samples[2].m_ret);
+		EXPECT_EQ(u8"SQLFetch", samples[0].m_functionName);
+		EXPECT_EQ(std::this_thread::get_id(), samples[0].m_threadId);
+
+		// Only slow calls
+		tracer.SetSampleLog(3, std::chrono::hours(1));
+		tracer.Trace(stats, []() { return (SQLRETURN) SQL_SUCCESS; });
+		EXPECT_TRUE(tracer.GetSamples().empty());
+	}
+
+
+	// OdbcTracerDbTest
+	// ================
+	void OdbcTracerDbTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+
+		OdbcTracer::Get().Reset();
+		OdbcTracer::Get().SetEnabled(true);
+	}
+
+
+	void OdbcTracerDbTest::TearDown()
+	{
+		OdbcTracer::Get().SetEnabled(false);
+		OdbcTracer::Get().Reset();
+	}
+
+
+	TEST_F(OdbcTracerDbTest, TraceStatement)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+
+		ExecutableStatement stmt(m_pDb);
+		stmt.ExecuteDirect(sqlstmt);
+		while (stmt.SelectNext())
+		{ }
+
+		vector<OdbcCallStatistics> statistics = OdbcTracer::Get().GetStatistics();
+		auto find = [&statistics](const string& name)
+		{
+			return std::find_if(statistics.begin(), statistics.end(), [&name](const OdbcCallStatistics& s) { return s.m_functionName == name; });
+		};
+		auto itExec = find(u8"SQLExecDirect");
+		ASSERT_TRUE(itExec != statistics.end());
+		EXPECT_EQ(1, itExec->m_callCount);
+		EXPECT_EQ(0, itExec->m_errorCount);
+		auto itFetch = find(u8"SQLFetch");
+		ASSERT_TRUE(itFetch != statistics.end());
+		// 7 records and SQL_NO_DATA
+		EXPECT_EQ(8, itFetch->m_callCount);
+
+		// Nothing is recorded while disabled
+		OdbcTracer::Get().SetEnabled(false);
+		stmt.ExecuteDirect(sqlstmt);
+		EXPECT_EQ(1, OdbcTracer::Get().GetCallStats(u8"SQLExecDirect").GetHistogram().GetCount());
+	}
+
+} // namespace exodbctest
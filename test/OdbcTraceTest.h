@@ -0,0 +1,54 @@
+﻿/*!
+* \file OdbcTraceTest.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief Header-file description]
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTest.h"
+#include "TestParams.h"
+
+// Other headers
+#include "gtest/gtest.h"
+#include "exodbc/Environment.h"
+#include "exodbc/Database.h"
+#include "exodbc/OdbcTrace.h"
+
+// System headers
+
+// Forward declarations
+// --------------------
+
+namespace exodbctest
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	class LatencyHistogramTest : public ::testing::Test
+	{
+	};
+
+
+	class OdbcTracerTest : public ::testing::Test
+	{
+	};
+
+
+	class OdbcTracerDbTest : public ::testing::Test
+	{
+	protected:
+		virtual void SetUp();
+		virtual void TearDown();
+
+		exodbc::EnvironmentPtr m_pEnv = std::make_shared<exodbc::Environment>();
+		exodbc::DatabasePtr m_pDb = std::make_shared<exodbc::Database>();
+	};
+
+} // namespace exodbctest
@@ -0,0 +1,234 @@
+﻿/*!
+* \file ParallelTableScanTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "ParallelTableScanTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/ColumnBufferVisitors.h"
+#include "exodbc/LogManager.h"
+
+// System headers
+#include <mutex>
+#include <set>
+#include <vector>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void ParallelTableScanTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	TEST_F(ParallelTableScanTest, OpenNewConnection)
+	{
+		DatabasePtr pDb = m_pDb->OpenNewConnection();
+		ASSERT_TRUE(pDb != NULL);
+		EXPECT_TRUE(pDb->IsOpen());
+		EXPECT_NE(m_pDb.get(), pDb.get());
+		EXPECT_EQ(m_pDb->GetDbms(), pDb->GetDbms());
+		EXPECT_EQ(m_pDb->GetCommitMode(), pDb->GetCommitMode());
+	}
+
+
+	TEST_F(ParallelTableScanTest, CreatePartitions)
+	{
+		Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(iTable.Open());
+		string idColName = boost::apply_visitor(QueryNameVisitor(), iTable.GetColumnBufferPtrVariant(0));
+
+		ParallelTableScan scan(iTable);
+		// There is no primary key set on the Table
+		EXPECT_THROW(scan.GetPartitionColumn(), Exception);
+		scan.SetPartitionColumn(0);
+
+		// Ids 1 - 7
+		scan.SetPartitionCount(3);
+		vector<ScanPartition> partitions = scan.CreatePartitions();
+		ASSERT_EQ(3, partitions.size());
+		EXPECT_EQ(1, partitions[0].m_lowerBound);
+		EXPECT_EQ(3, partitions[0].m_upperBound);
+		EXPECT_EQ(4, partitions[1].m_lowerBound);
+		EXPECT_EQ(5, partitions[1].m_upperBound);
+		EXPECT_EQ(6, partitions[2].m_lowerBound);
+		EXPECT_EQ(7, partitions[2].m_upperBound);
+		EXPECT_EQ(2, partitions[2].m_index);
+		EXPECT_TRUE(partitions[2].m_bounded);
+		EXPECT_EQ(boost::str(boost::format(u8"%s >= 6 AND %s <= 7") % idColName % idColName), partitions[2].m_whereStatement);
+
+		// No more partitions than values
+		scan.SetPartitionCount(20);
+		partitions = scan.CreatePartitions();
+		ASSERT_EQ(7, partitions.size());
+		EXPECT_EQ(7, partitions[6].m_lowerBound);
+		EXPECT_EQ(7, partitions[6].m_upperBound);
+
+		// The where clause is applied to the bounds and the partitions
+		scan.SetWhere(boost::str(boost::format(u8"%s > 4") % idColName));
+		scan.SetPartitionCount(2);
+		partitions = scan.CreatePartitions();
+		ASSERT_EQ(2, partitions.size());
+		EXPECT_EQ(5, partitions[0].m_lowerBound);
+		EXPECT_EQ(6, partitions[0].m_upperBound);
+		EXPECT_EQ(7, partitions[1].m_lowerBound);
+		EXPECT_EQ(boost::str(boost::format(u8"(%s > 4) AND %s >= 7 AND %s <= 7") % idColName % idColName % idColName), partitions[1].m_whereStatement);
+
+		// One unbounded partition if nothing matches
+		scan.SetWhere(boost::str(boost::format(u8"%s > 100") % idColName));
+		partitions = scan.CreatePartitions();
+		ASSERT_EQ(1, partitions.size());
+		EXPECT_FALSE(partitions[0].m_bounded);
+	}
+
+
+	TEST_F(ParallelTableScanTest, RunUnordered)
+	{
+		Table iTable(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(iTable.Open());
+
+		ParallelTableScan scan(iTable);
+		scan.SetPartitionCount(3);
+		scan.SetBlockSize(2);
+
+		mutex m;
+		set<SQLINTEGER> ids;
+		vector<size_t> rowsPerPartition(3, 0);
+		ParallelScanResult result = scan.Run([&](size_t partitionIndex, const RowView& row)
+		{
+			lock_guard<mutex> lock(m);
+			ids.insert(row.Get<SQLINTEGER>(0));
+			++rowsPerPartition[partitionIndex];
+		});
+
+		EXPECT_EQ(7, result.m_rows);
+		ASSERT_EQ(3, result.m_partitionRows.size());
+		EXPECT_EQ(3, result.m_partitionRows[0]);
+		EXPECT_EQ(2, result.m_partitionRows[1]);
+		EXPECT_EQ(2, result.m_partitionRows[2]);
+		EXPECT_EQ(3, rowsPerPartition[0]);
+		EXPECT_EQ(set<SQLINTEGER>({ 1, 2, 3, 4, 5, 6, 7 }), ids);
+	}
+
+
+	TEST_F(ParallelTableScanTest, RunNullablePartitionColumn)
+	{
+		Table iTable(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(iTable.Open());
+		string smallIntColName = boost::apply_visitor(QueryNameVisitor(), iTable.GetColumnBufferPtrVariant(1));
+
+		// tsmallint holds -32768, 32767, -13 and four NULL values
+		ParallelTableScan scan(iTable);
+		scan.SetPartitionColumn(1);
+		scan.SetPartitionCount(2);
+		vector<ScanPartition> partitions = scan.CreatePartitions();
+		ASSERT_EQ(2, partitions.size());
+		EXPECT_EQ(boost::str(boost::format(u8"(%s >= -32768 AND %s <= -1 OR %s IS NULL)") % smallIntColName % smallIntColName % smallIntColName), partitions[0].m_whereStatement);
+		EXPECT_EQ(boost::str(boost::format(u8"%s >= 0 AND %s <= 32767") % smallIntColName % smallIntColName), partitions[1].m_whereStatement);
+
+		mutex m;
+		set<SQLINTEGER> ids;
+		ParallelScanResult result = scan.Run([&](size_t partitionIndex, const RowView& row)
+		{
+			lock_guard<mutex> lock(m);
+			ids.insert(row.Get<SQLINTEGER>(0));
+		});
+
+		// The rows with NULL values are not lost
+		EXPECT_EQ(7, result.m_rows);
+		ASSERT_EQ(2, result.m_partitionRows.size());
+		EXPECT_EQ(6, result.m_partitionRows[0]);
+		EXPECT_EQ(1, result.m_partitionRows[1]);
+		EXPECT_EQ(set<SQLINTEGER>({ 1, 2, 3, 4, 5, 6, 7 }), ids);
+	}
+
+
+	TEST_F(ParallelTableScanTest, RunOrdered)
+	{
+		Table iTable(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(iTable.Open());
+
+		// Use blocks that do not divide the partitions and buffer only one of them
+		ParallelTableScan scan(iTable);
+		scan.SetPartitionCount(3);
+		scan.SetOrdered(true);
+		scan.SetBlockSize(2);
+		scan.SetPrefetchBlocks(1);
+
+		vector<SQLINTEGER> ids;
+		vector<size_t> partitionIndexes;
+		ParallelScanResult result = scan.Run([&](size_t partitionIndex, const RowView& row)
+		{
+			ids.push_back(row.Get<SQLINTEGER>(0));
+			partitionIndexes.push_back(partitionIndex);
+		});
+
+		EXPECT_EQ(7, result.m_rows);
+		EXPECT_EQ(vector<SQLINTEGER>({ 1, 2, 3, 4, 5, 6, 7 }), ids);
+		EXPECT_EQ(vector<size_t>({ 0, 0, 0, 1, 1, 2, 2 }), partitionIndexes);
+	}
+
+
+	TEST_F(ParallelTableScanTest, RunStopsOnError)
+	{
+		Table iTable(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(iTable.Open());
+
+		ParallelTableScan scan(iTable);
+		scan.SetPartitionCount(3);
+		auto consumer = [](size_t partitionIndex, const RowView& row)
+		{
+			if (row.Get<SQLINTEGER>(0) == 4)
+			{
+				Exception ex(u8"Failing on 4");
+				SET_EXCEPTION_SOURCE(ex);
+				throw ex;
+			}
+		};
+		EXPECT_THROW(scan.Run(consumer), Exception);
+
+		scan.SetOrdered(true);
+		EXPECT_THROW(scan.Run(consumer), Exception);
+
+		// Failing to connect is reported too
+		scan.SetConnectionFactory([]() -> DatabasePtr
+		{
+			Exception ex(u8"No connection");
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		});
+		EXPECT_THROW(scan.Run(consumer), Exception);
+	}
+
+} // namespace exodbctest
@@ -0,0 +1,43 @@
+﻿/*!
+* \file ParallelTableScanTest.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief Header-file description]
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTest.h"
+#include "TestParams.h"
+
+// Other headers
+#include "gtest/gtest.h"
+#include "exodbc/Environment.h"
+#include "exodbc/Database.h"
+#include "exodbc/ParallelTableScan.h"
+
+// System headers
+
+// Forward declarations
+// --------------------
+
+namespace exodbctest
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	class ParallelTableScanTest : public ::testing::Test
+	{
+	protected:
+		virtual void SetUp();
+
+		exodbc::EnvironmentPtr m_pEnv = std::make_shared<exodbc::Environment>();
+		exodbc::DatabasePtr m_pDb = std::make_shared<exodbc::Database>();
+	};
+
+} // namespace exodbctest
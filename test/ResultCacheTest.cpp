@@ -0,0 +1,197 @@
+﻿/*!
+* \file ResultCacheTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "ResultCacheTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/LogManager.h"
+#include "boost/format.hpp"
+
+// System headers
+#include <thread>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void ResultCacheTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	TEST_F(ResultCacheTest, Select)
+	{
+		ResultCache cache(1024 * 1024, std::chrono::milliseconds(0));
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sql = boost::str(boost::format(u8"SELECT %s, tint FROM %s WHERE %s > ? ORDER BY %s") % idColName % queryTableName % idColName % idColName);
+		vector<RowColumnDefinition> columns = { RowColumnDefinition(idColName, SQL_C_SLONG), RowColumnDefinition(u8"tint", SQL_C_SLONG) };
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		pIdParam->SetValue(4);
+
+		CachedResultPtr pResult = cache.Select(m_pDb, sql, columns, { tableName }, { pIdParam });
+		ASSERT_EQ(3, pResult->GetRowCount());
+		EXPECT_EQ(5, pResult->Get<SQLINTEGER>(0, 0));
+		EXPECT_EQ(7, pResult->Get<SQLINTEGER>(0, 2));
+		EXPECT_EQ(1, pResult->GetColumnIndex(u8"tint"));
+
+		// The same parameter value is read from the cache, another one from the database
+		EXPECT_EQ(pResult, cache.Select(m_pDb, sql, columns, { tableName }, { pIdParam }));
+		pIdParam->SetValue(5);
+		CachedResultPtr pOther = cache.Select(m_pDb, sql, columns, { tableName }, { pIdParam });
+		EXPECT_NE(pResult, pOther);
+		EXPECT_EQ(2, pOther->GetRowCount());
+
+		ResultCacheStatistics statistics = cache.GetStatistics();
+		EXPECT_EQ(1, statistics.m_hits);
+		EXPECT_EQ(2, statistics.m_misses);
+		EXPECT_EQ(2, statistics.m_entries);
+		EXPECT_LT(0, statistics.m_memoryUsage);
+	}
+
+
+	TEST_F(ResultCacheTest, InvalidateOnTableWrite)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		ResultCachePtr pCache = std::make_shared<ResultCache>(1024 * 1024, std::chrono::milliseconds(0));
+		m_pDb->SetResultCache(pCache);
+
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sql = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+		vector<RowColumnDefinition> columns = { RowColumnDefinition(idColName, SQL_C_SLONG) };
+		EXPECT_EQ(0, pCache->Select(m_pDb, sql, columns, { tableName })->GetRowCount());
+		EXPECT_EQ(1, pCache->GetStatistics().m_entries);
+
+		Table iTable(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+		ASSERT_NO_THROW(iTable.Open());
+		iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0)->SetValue(1);
+		iTable.Insert();
+		m_pDb->CommitTrans();
+
+		EXPECT_EQ(0, pCache->GetStatistics().m_entries);
+		EXPECT_EQ(1, pCache->GetStatistics().m_invalidations);
+		EXPECT_EQ(1, pCache->Select(m_pDb, sql, columns, { tableName })->GetRowCount());
+
+		// Writing another table does not invalidate the entry
+		pCache->Invalidate(GetTableName(TableId::INTEGERTYPES));
+		EXPECT_EQ(1, pCache->GetStatistics().m_entries);
+
+		m_pDb->SetResultCache(ResultCachePtr());
+	}
+
+
+	TEST_F(ResultCacheTest, InvalidateOnCommit)
+	{
+		if (m_pDb->GetCommitMode() != Database::CommitMode::MANUAL)
+		{
+			LOG_WARNING(u8"Skipping test because the Database is not in CommitMode::MANUAL");
+			return;
+		}
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		ResultCachePtr pCache = std::make_shared<ResultCache>(1024 * 1024, std::chrono::milliseconds(0));
+		m_pDb->SetResultCache(pCache);
+
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sql = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+		vector<RowColumnDefinition> columns = { RowColumnDefinition(idColName, SQL_C_SLONG) };
+
+		Table iTable(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+		ASSERT_NO_THROW(iTable.Open());
+		iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0)->SetValue(1);
+		iTable.Insert();
+
+		// Results read between the write and the commit are removed again on commit
+		EXPECT_EQ(1, pCache->Select(m_pDb, sql, columns, { tableName })->GetRowCount());
+		EXPECT_EQ(1, pCache->GetStatistics().m_entries);
+		m_pDb->CommitTrans();
+		EXPECT_EQ(0, pCache->GetStatistics().m_entries);
+
+		// Nothing is written in the next transaction
+		EXPECT_EQ(1, pCache->Select(m_pDb, sql, columns, { tableName })->GetRowCount());
+		m_pDb->CommitTrans();
+		EXPECT_EQ(1, pCache->GetStatistics().m_entries);
+
+		m_pDb->SetResultCache(ResultCachePtr());
+	}
+
+
+	TEST_F(ResultCacheTest, MemoryBudgetAndTimeToLive)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		vector<RowColumnDefinition> columns = { RowColumnDefinition(idColName, SQL_C_SLONG) };
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sql1 = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s < 3") % idColName % queryTableName % idColName);
+		string sql2 = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s > 3") % idColName % queryTableName % idColName);
+
+		// Measure one entry, then only allow one
+		size_t entrySize = 0;
+		{
+			ResultCache cache(1024 * 1024, std::chrono::milliseconds(0));
+			cache.Select(m_pDb, sql1, columns, { tableName });
+			entrySize = cache.GetStatistics().m_memoryUsage;
+		}
+		ResultCache cache(entrySize + entrySize / 2, std::chrono::milliseconds(0));
+		cache.Select(m_pDb, sql1, columns, { tableName });
+		cache.Select(m_pDb, sql2, columns, { tableName });
+		ResultCacheStatistics statistics = cache.GetStatistics();
+		EXPECT_EQ(1, statistics.m_entries);
+		EXPECT_EQ(1, statistics.m_evictions);
+		EXPECT_LE(statistics.m_memoryUsage, cache.GetMemoryBudget());
+
+		ResultCache expiring(1024 * 1024, std::chrono::milliseconds(1));
+		expiring.Select(m_pDb, sql1, columns, { tableName });
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		expiring.Select(m_pDb, sql1, columns, { tableName });
+		EXPECT_EQ(1, expiring.GetStatistics().m_expirations);
+		EXPECT_EQ(0, expiring.GetStatistics().m_hits);
+	}
+
+
+	TEST(ResultCache, NormalizeTableName)
+	{
+		EXPECT_EQ(u8"INTEGERTYPES", ResultCache::NormalizeTableName(u8"integertypes"));
+		EXPECT_EQ(u8"INTEGERTYPES", ResultCache::NormalizeTableName(u8"exodbc.IntegerTypes"));
+		EXPECT_EQ(u8"INTEGERTYPES", ResultCache::NormalizeTableName(u8"\"exodbc\".\"integertypes\""));
+		EXPECT_EQ(u8"INTEGERTYPES", ResultCache::NormalizeTableName(u8"[dbo].[integertypes]"));
+	}
+
+} // namespace exodbctest
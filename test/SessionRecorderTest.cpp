@@ -0,0 +1,393 @@
+﻿/*!
+* \file SessionRecorderTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "SessionRecorderTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/ColumnBuffer.h"
+#include "exodbc/ColumnBufferVisitors.h"
+#include "exodbc/LogManager.h"
+#include "exodbc/Table.h"
+
+// System headers
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+
+	// SessionRecorderTest
+	// ===================
+	TEST_F(SessionRecorderTest, WriteAndReadEvents)
+	{
+		SessionEvent prepare;
+		prepare.m_type = SessionEventType::Prepare;
+		prepare.m_statementId = 3;
+		prepare.m_offset = std::chrono::microseconds(12);
+		prepare.m_duration = std::chrono::nanoseconds(400);
+		prepare.m_sql = u8"SELECT * FROM t WHERE id > ?";
+
+		SessionEvent execute;
+		execute.m_type = SessionEventType::ExecutePrepared;
+		execute.m_statementId = 3;
+		execute.m_offset = std::chrono::seconds(5000);
+		execute.m_duration = std::chrono::milliseconds(7);
+		execute.m_fetchDuration = std::chrono::milliseconds(2);
+		execute.m_rowsFetched = 123456;
+		execute.m_sql = prepare.m_sql;
+		SessionParameter param;
+		param.m_paramNr = 1;
+		param.m_sqlCType = SQL_C_SLONG;
+		param.m_sqlType = SQL_INTEGER;
+		param.m_columnSize = 10;
+		param.m_cb = sizeof(SQLINTEGER);
+		param.m_data = string("\x01\x00\x80\xff", 4);
+		execute.m_parameters.push_back(param);
+		param.m_paramNr = 2;
+		param.m_sqlCType = SQL_C_CHAR;
+		param.m_sqlType = SQL_VARCHAR;
+		param.m_cb = SQL_NULL_DATA;
+		param.m_data.clear();
+		execute.m_parameters.push_back(param);
+
+		stringstream ss;
+		SessionRecorder::WriteEvent(ss, prepare);
+		SessionRecorder::WriteEvent(ss, execute);
+
+		SessionEvent read;
+		ASSERT_TRUE(SessionRecorder::ReadEvent(ss, read));
+		EXPECT_EQ(SessionEventType::Prepare, read.m_type);
+		EXPECT_EQ(3, read.m_statementId);
+		EXPECT_EQ(prepare.m_offset, read.m_offset);
+		EXPECT_EQ(prepare.m_duration, read.m_duration);
+		EXPECT_EQ(prepare.m_sql, read.m_sql);
+		EXPECT_TRUE(read.m_parameters.empty());
+
+		ASSERT_TRUE(SessionRecorder::ReadEvent(ss, read));
+		EXPECT_EQ(SessionEventType::ExecutePrepared, read.m_type);
+		EXPECT_EQ(execute.m_offset, read.m_offset);
+		EXPECT_EQ(execute.m_duration, read.m_duration);
+		EXPECT_EQ(execute.m_fetchDuration, read.m_fetchDuration);
+		EXPECT_EQ(123456, read.m_rowsFetched);
+		ASSERT_EQ(2, read.m_parameters.size());
+		EXPECT_EQ(1, read.m_parameters[0].m_paramNr);
+		EXPECT_EQ(SQL_C_SLONG, read.m_parameters[0].m_sqlCType);
+		EXPECT_EQ(SQL_INTEGER, read.m_parameters[0].m_sqlType);
+		EXPECT_EQ(10, read.m_parameters[0].m_columnSize);
+		EXPECT_EQ((SQLLEN)sizeof(SQLINTEGER), read.m_parameters[0].m_cb);
+		EXPECT_EQ(execute.m_parameters[0].m_data, read.m_parameters[0].m_data);
+		EXPECT_EQ(SQL_NULL_DATA, read.m_parameters[1].m_cb);
+
+		EXPECT_FALSE(SessionRecorder::ReadEvent(ss, read));
+	}
+
+
+	TEST_F(SessionRecorderTest, WriteAndReadArrayEvent)
+	{
+		SessionEvent execute;
+		execute.m_type = SessionEventType::ExecutePreparedArray;
+		execute.m_statementId = 4;
+		execute.m_sql = u8"INSERT INTO t (id) VALUES (?)";
+		execute.m_paramSetSize = 2;
+		SessionParameter param;
+		param.m_paramNr = 1;
+		param.m_sqlCType = SQL_C_SLONG;
+		param.m_sqlType = SQL_INTEGER;
+		param.m_cb = sizeof(SQLINTEGER);
+		param.m_data = string("\x01\x00\x00\x00", 4);
+		execute.m_parameters.push_back(param);
+		param.m_data = string("\x02\x00\x00\x00", 4);
+		execute.m_parameters.push_back(param);
+
+		stringstream ss;
+		SessionRecorder::WriteEvent(ss, execute);
+
+		SessionEvent read;
+		ASSERT_TRUE(SessionRecorder::ReadEvent(ss, read));
+		EXPECT_EQ(SessionEventType::ExecutePreparedArray, read.m_type);
+		EXPECT_EQ(2, read.m_paramSetSize);
+		ASSERT_EQ(2, read.m_parameters.size());
+		EXPECT_EQ(execute.m_parameters[1].m_data, read.m_parameters[1].m_data);
+		EXPECT_FALSE(SessionRecorder::ReadEvent(ss, read));
+	}
+
+
+	TEST_F(SessionRecorderTest, CaptureParameterArrays)
+	{
+		SQLINTEGER ids[3] = { 7, 8, 9 };
+		SQLLEN idIndicators[3] = { sizeof(SQLINTEGER), SQL_NULL_DATA, sizeof(SQLINTEGER) };
+		SQLCHAR names[3][8] = { "ab", "", "cdef" };
+		SQLLEN nameIndicators[3] = { 2, SQL_NULL_DATA, SQL_NTS };
+		vector<ParameterArray> params;
+		params.push_back(ParameterArray(SQL_C_SLONG, ParameterDescription(SQL_INTEGER, 10, 0, SQL_NULLABLE), ids, sizeof(SQLINTEGER), idIndicators));
+		params.push_back(ParameterArray(SQL_C_CHAR, ParameterDescription(SQL_VARCHAR, 7, 0, SQL_NULLABLE), names, 8, nameIndicators));
+
+		// Only the first two sets are captured, parameter after parameter
+		vector<SessionParameter> captured = CaptureSessionParameterArrays(params, 2);
+		ASSERT_EQ(4, captured.size());
+		EXPECT_EQ(1, captured[0].m_paramNr);
+		EXPECT_EQ(SQL_INTEGER, captured[0].m_sqlType);
+		EXPECT_EQ(string((const char*)&ids[0], sizeof(SQLINTEGER)), captured[0].m_data);
+		EXPECT_EQ(2, captured[1].m_paramNr);
+		EXPECT_EQ(SQL_VARCHAR, captured[1].m_sqlType);
+		EXPECT_EQ(7, captured[1].m_columnSize);
+		EXPECT_EQ(u8"ab", captured[1].m_data);
+		EXPECT_EQ(SQL_NULL_DATA, captured[2].m_cb);
+		EXPECT_TRUE(captured[2].m_data.empty());
+		EXPECT_EQ(SQL_NULL_DATA, captured[3].m_cb);
+
+		// Without indicators characters are read up to the terminating zero
+		params[0].m_pIndicators = NULL;
+		params[1].m_pIndicators = NULL;
+		captured = CaptureSessionParameterArrays(params, 3);
+		ASSERT_EQ(6, captured.size());
+		EXPECT_EQ((SQLLEN)sizeof(SQLINTEGER), captured[2].m_cb);
+		EXPECT_EQ(string((const char*)&ids[1], sizeof(SQLINTEGER)), captured[2].m_data);
+		EXPECT_EQ(SQL_NTS, captured[5].m_cb);
+		EXPECT_EQ(u8"cdef", captured[5].m_data);
+	}
+
+
+	TEST_F(SessionRecorderTest, ReadTruncatedEvent)
+	{
+		SessionEvent event;
+		event.m_sql = u8"SELECT 1";
+		stringstream ss;
+		SessionRecorder::WriteEvent(ss, event);
+		string bytes = ss.str();
+
+		stringstream truncated(bytes.substr(0, bytes.length() - 2));
+		EXPECT_THROW(SessionRecorder::ReadEvent(truncated, event), Exception);
+
+		stringstream invalid(string(1, '\x7f'));
+		EXPECT_THROW(SessionRecorder::ReadEvent(invalid, event), Exception);
+	}
+
+
+	TEST_F(SessionRecorderTest, ReadFileFailsOnOtherFiles)
+	{
+		string path = u8"SessionRecorderTest.txt";
+		{
+			ofstream out(path);
+			out << u8"no recording";
+		}
+		EXPECT_THROW(SessionRecorder::ReadFile(path), Exception);
+		std::remove(path.c_str());
+		EXPECT_THROW(SessionRecorder::ReadFile(path), Exception);
+	}
+
+
+	TEST_F(SessionRecorderTest, CaptureAndCreateParameter)
+	{
+		LongColumnBufferPtr pLong = LongColumnBuffer::Create(u8"id", SQL_INTEGER, ColumnFlag::CF_NULLABLE);
+		pLong->SetValue(-13);
+		SessionParameter param = CaptureSessionParameter(1, pLong);
+		EXPECT_EQ(SQL_C_SLONG, param.m_sqlCType);
+		EXPECT_EQ(SQL_INTEGER, param.m_sqlType);
+		EXPECT_EQ(sizeof(SQLINTEGER), param.m_data.size());
+		ColumnBufferPtrVariant buffer = SessionReplayer::CreateParameterBuffer(param);
+		LongColumnBufferPtr pLongCopy = boost::get<LongColumnBufferPtr>(buffer);
+		EXPECT_EQ(-13, pLongCopy->GetValue());
+		EXPECT_EQ(SQL_INTEGER, pLongCopy->GetSqlType());
+
+		pLong->SetNull();
+		param = CaptureSessionParameter(1, pLong);
+		EXPECT_EQ(SQL_NULL_DATA, param.m_cb);
+		EXPECT_TRUE(param.m_data.empty());
+		buffer = SessionReplayer::CreateParameterBuffer(param);
+		EXPECT_TRUE(boost::apply_visitor(IsNullVisitor(), buffer));
+
+		// Only the characters up to the terminating zero are captured
+		CharColumnBufferPtr pChar = CharColumnBuffer::Create(600, u8"name", SQL_VARCHAR);
+		pChar->SetString(u8"hello");
+		param = CaptureSessionParameter(2, pChar);
+		EXPECT_EQ(u8"hello", param.m_data);
+		EXPECT_EQ(SQL_NTS, param.m_cb);
+		buffer = SessionReplayer::CreateParameterBuffer(param);
+		EXPECT_EQ(u8"hello", boost::get<CharColumnBufferPtr>(buffer)->GetString());
+
+		BinaryColumnBufferPtr pBinary = BinaryColumnBuffer::Create(16, u8"blob", SQL_VARBINARY);
+		pBinary->SetValue(vector<SQLCHAR>({ 0x00, 0xab, 0xcd }));
+		param = CaptureSessionParameter(3, pBinary);
+		EXPECT_EQ(string("\x00\xab\xcd", 3), param.m_data);
+		buffer = SessionReplayer::CreateParameterBuffer(param);
+		BinaryColumnBufferPtr pBinaryCopy = boost::get<BinaryColumnBufferPtr>(buffer);
+		EXPECT_EQ(3, pBinaryCopy->GetCb());
+		EXPECT_EQ(0xcd, pBinaryCopy->GetBuffer()[2]);
+	}
+
+
+	// SessionRecorderDbTest
+	// =====================
+	void SessionRecorderDbTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+
+		m_path = u8"SessionRecorderTest.rec";
+	}
+
+
+	void SessionRecorderDbTest::TearDown()
+	{
+		SessionRecorder::Get().Stop();
+		std::remove(m_path.c_str());
+	}
+
+
+	TEST_F(SessionRecorderDbTest, RecordAndReplay)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string preparedSql = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s >= ?") % idColName % queryTableName % idColName);
+		string directSql = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+
+		SessionRecorder& recorder = SessionRecorder::Get();
+		recorder.Start(m_path);
+		EXPECT_TRUE(recorder.IsRecording());
+		EXPECT_THROW(recorder.Start(m_path), Exception);
+		{
+			ExecutableStatement stmt(m_pDb);
+			stmt.Prepare(preparedSql);
+			LongColumnBufferPtr pParam = LongColumnBuffer::Create(u8"Param", SQL_INTEGER);
+			LongColumnBufferPtr pId = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			stmt.BindParameter(pParam, 1);
+			stmt.BindColumn(pId, 1);
+
+			// Ids 1 - 7: Fetch 3 rows
+			pParam->SetValue(5);
+			stmt.ExecutePrepared();
+			while (stmt.SelectNext())
+			{ }
+
+			ExecutableStatement direct(m_pDb);
+			direct.ExecuteDirect(directSql);
+			EXPECT_TRUE(direct.SelectNext());
+			direct.SelectClose();
+		}
+		EXPECT_EQ(3, recorder.GetEventCount());
+		recorder.Stop();
+		EXPECT_FALSE(recorder.IsRecording());
+
+		vector<SessionEvent> events = SessionRecorder::ReadFile(m_path);
+		ASSERT_EQ(3, events.size());
+		EXPECT_EQ(SessionEventType::Prepare, events[0].m_type);
+		EXPECT_EQ(preparedSql, events[0].m_sql);
+		EXPECT_EQ(SessionEventType::ExecutePrepared, events[1].m_type);
+		EXPECT_EQ(events[0].m_statementId, events[1].m_statementId);
+		EXPECT_EQ(3, events[1].m_rowsFetched);
+		ASSERT_EQ(1, events[1].m_parameters.size());
+		EXPECT_EQ(SQL_C_SLONG, events[1].m_parameters[0].m_sqlCType);
+		EXPECT_LE(events[0].m_offset, events[1].m_offset);
+		EXPECT_EQ(SessionEventType::ExecuteDirect, events[2].m_type);
+		EXPECT_NE(events[1].m_statementId, events[2].m_statementId);
+		EXPECT_EQ(directSql, events[2].m_sql);
+		EXPECT_EQ(1, events[2].m_rowsFetched);
+
+		SessionReplayer replayer(m_pDb);
+		replayer.SetPacing(ReplayPacing::MaximumSpeed);
+		replayer.SetStopOnError(true);
+		SessionReplayResult result = replayer.Replay(m_path);
+		EXPECT_EQ(1, result.m_prepares);
+		EXPECT_EQ(2, result.m_executions);
+		EXPECT_EQ(4, result.m_rowsFetched);
+		EXPECT_EQ(0, result.m_errors);
+		EXPECT_EQ(events[1].m_duration + events[2].m_duration, result.m_recordedExecuteTime);
+	}
+
+
+	TEST_F(SessionRecorderDbTest, RecordAndReplayArray)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string insertSql = boost::str(boost::format(u8"INSERT INTO %s (%s) VALUES (?)") % queryTableName % idColName);
+
+		SessionRecorder& recorder = SessionRecorder::Get();
+		recorder.Start(m_path);
+		{
+			ExecutableStatement stmt(m_pDb);
+			stmt.Prepare(insertSql);
+			SQLINTEGER ids[3] = { 301, 302, 303 };
+			SQLLEN indicators[3] = { sizeof(SQLINTEGER), sizeof(SQLINTEGER), sizeof(SQLINTEGER) };
+			vector<ParameterArray> params;
+			params.push_back(ParameterArray(SQL_C_SLONG, ParameterDescription(SQL_INTEGER, 10, 0, SQL_NO_NULLS), ids, sizeof(SQLINTEGER), indicators));
+			EXPECT_EQ(3, stmt.ExecutePreparedArray(params, 3));
+		}
+		recorder.Stop();
+		m_pDb->CommitTrans();
+
+		vector<SessionEvent> events = SessionRecorder::ReadFile(m_path);
+		ASSERT_EQ(2, events.size());
+		EXPECT_EQ(SessionEventType::ExecutePreparedArray, events[1].m_type);
+		EXPECT_EQ(3, events[1].m_paramSetSize);
+		ASSERT_EQ(3, events[1].m_parameters.size());
+
+		// Replaying inserts the same rows again
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+		SessionReplayer replayer(m_pDb);
+		replayer.SetPacing(ReplayPacing::MaximumSpeed);
+		replayer.SetStopOnError(true);
+		SessionReplayResult result = replayer.Replay(events);
+		EXPECT_EQ(1, result.m_executions);
+		EXPECT_EQ(0, result.m_errors);
+		m_pDb->CommitTrans();
+
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		table.Open();
+		EXPECT_EQ(3, table.Count());
+	}
+
+
+	TEST_F(SessionRecorderDbTest, ReplayCountsErrors)
+	{
+		SessionEvent event;
+		event.m_type = SessionEventType::ExecuteDirect;
+		event.m_statementId = 1;
+		event.m_sql = u8"SELECT * FROM not_existing_table_exodbc";
+
+		LogLevelSetter ll(LogLevel::None);
+		SessionReplayer replayer(m_pDb);
+		SessionReplayResult result = replayer.Replay(vector<SessionEvent>({ event }));
+		EXPECT_EQ(1, result.m_errors);
+		EXPECT_EQ(0, result.m_executions);
+
+		replayer.SetStopOnError(true);
+		EXPECT_THROW(replayer.Replay(vector<SessionEvent>({ event })), Exception);
+	}
+
+} // namespace exodbctest
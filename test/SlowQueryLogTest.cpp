@@ -0,0 +1,318 @@
+﻿/*!
+* \file SlowQueryLogTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "SlowQueryLogTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/ColumnBuffer.h"
+#include "exodbc/SqlStructHelper.h"
+
+// System headers
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+
+	// SlowQueryLogTest
+	// ================
+	TEST_F(SlowQueryLogTest, ToJson)
+	{
+		SlowQueryRecord record;
+		record.m_sql = u8"SELECT * FROM t WHERE name = 'a \"b\"'\n AND id = ?";
+		record.m_fingerprint = u8"SELECT * FROM t WHERE name = ? AND id = ?";
+		record.m_start = std::chrono::system_clock::from_time_t(0) + std::chrono::milliseconds(1500);
+		record.m_executeTime = std::chrono::microseconds(2500);
+		record.m_fetchTime = std::chrono::milliseconds(1);
+		record.m_rowsReturned = 3;
+		SlowQueryParameter param;
+		param.m_paramNr = 1;
+		param.m_queryName = u8"id";
+		param.m_isNull = false;
+		param.m_value = u8"42";
+		record.m_parameters.push_back(param);
+		param.m_paramNr = 2;
+		param.m_queryName = u8"";
+		param.m_isNull = true;
+		param.m_value = u8"";
+		record.m_parameters.push_back(param);
+
+		EXPECT_EQ(u8"{\"type\":\"slow_query\",\"start\":\"1970-01-01T00:00:01.500Z\","
+			u8"\"fingerprint\":\"SELECT * FROM t WHERE name = ? AND id = ?\","
+			u8"\"sql\":\"SELECT * FROM t WHERE name = 'a \\\"b\\\"'\\n AND id = ?\","
+			u8"\"params\":[{\"nr\":1,\"name\":\"id\",\"value\":\"42\"},{\"nr\":2,\"name\":\"\",\"value\":null}],"
+			u8"\"execute_ms\":2.500,\"fetch_ms\":1.000,\"total_ms\":3.500,\"rows\":3}", SlowQueryLog::ToJson(record));
+	}
+
+
+	TEST_F(SlowQueryLogTest, CaptureParameter)
+	{
+		LongColumnBufferPtr pLong = LongColumnBuffer::Create(u8"id", SQL_INTEGER, ColumnFlag::CF_NULLABLE);
+		SlowQueryParameter param = CaptureSlowQueryParameter(1, pLong);
+		EXPECT_EQ(1, param.m_paramNr);
+		EXPECT_EQ(u8"id", param.m_queryName);
+		EXPECT_TRUE(param.m_isNull);
+		pLong->SetValue(-13);
+		param = CaptureSlowQueryParameter(1, pLong);
+		EXPECT_FALSE(param.m_isNull);
+		EXPECT_EQ(u8"-13", param.m_value);
+
+		CharColumnBufferPtr pChar = CharColumnBuffer::Create(600, u8"name", SQL_VARCHAR);
+		pChar->SetString(u8"hello");
+		EXPECT_EQ(u8"hello", CaptureSlowQueryParameter(2, pChar).m_value);
+		pChar->SetString(string(300, 'x'));
+		EXPECT_EQ(string(256, 'x') + u8"...", CaptureSlowQueryParameter(2, pChar).m_value);
+
+		TypeTimestampColumnBufferPtr pTs = TypeTimestampColumnBuffer::Create(u8"ts", SQL_TYPE_TIMESTAMP);
+		pTs->SetValue(SqlStructHelper::InitTimestamp(13, 55, 56, 0, 26, 1, 1983));
+		EXPECT_EQ(SqlStructHelper::TimestampToSqlString(pTs->GetValue(), true), CaptureSlowQueryParameter(3, pTs).m_value);
+	}
+
+
+	TEST_F(SlowQueryLogTest, Threshold)
+	{
+		SlowQueryLog log;
+		log.SetLogLevel(LogLevel::Debug);
+		log.SetThreshold(std::chrono::milliseconds(10));
+
+		SlowQueryRecord record;
+		record.m_sql = u8"SELECT * FROM t WHERE id = 1";
+		record.m_executeTime = std::chrono::milliseconds(4);
+		record.m_fetchTime = std::chrono::milliseconds(5);
+		log.Record(record);
+		EXPECT_TRUE(log.GetTopStatements().empty());
+
+		// Execute and fetch time are summed up
+		record.m_fetchTime = std::chrono::milliseconds(6);
+		log.Record(record);
+		vector<SlowQueryStatistics> top = log.GetTopStatements();
+		ASSERT_EQ(1, top.size());
+		EXPECT_EQ(u8"SELECT * FROM t WHERE id = ?", top.front().m_fingerprint);
+		EXPECT_EQ(record.m_sql, top.front().m_lastSql);
+		EXPECT_EQ(1, top.front().m_count);
+		EXPECT_EQ(std::chrono::milliseconds(10), top.front().m_totalTime);
+
+		log.Reset();
+		EXPECT_TRUE(log.GetTopStatements().empty());
+	}
+
+
+	TEST_F(SlowQueryLogTest, Redactor)
+	{
+		SlowQueryLog log;
+		log.SetLogLevel(LogLevel::Debug);
+		log.SetThreshold(std::chrono::nanoseconds(0));
+
+		vector<SlowQueryParameter> redacted;
+		log.SetParameterRedactor([&redacted](const SlowQueryRecord& record, SlowQueryParameter& param)
+		{
+			SlowQueryLog::RedactAll(record, param);
+			redacted.push_back(param);
+		});
+
+		SlowQueryRecord record;
+		record.m_sql = u8"UPDATE users SET password = ? WHERE id = ?";
+		SlowQueryParameter param;
+		param.m_paramNr = 1;
+		param.m_isNull = false;
+		param.m_value = u8"secret";
+		record.m_parameters.push_back(param);
+		param.m_paramNr = 2;
+		param.m_isNull = true;
+		param.m_value = u8"";
+		record.m_parameters.push_back(param);
+		log.Record(record);
+
+		ASSERT_EQ(2, redacted.size());
+		EXPECT_EQ(u8"***", redacted[0].m_value);
+		EXPECT_TRUE(redacted[1].m_isNull);
+		EXPECT_EQ(u8"", redacted[1].m_value);
+	}
+
+
+	TEST_F(SlowQueryLogTest, TopStatements)
+	{
+		SlowQueryLog log;
+		log.SetLogLevel(LogLevel::Debug);
+		log.SetThreshold(std::chrono::nanoseconds(0));
+		log.SetTopCount(2);
+
+		// Aggregates up to 8 fingerprints: Record 9, the one with the lowest total time is dropped
+		for (int i = 1; i <= 9; ++i)
+		{
+			SlowQueryRecord record;
+			record.m_sql = boost::str(boost::format(u8"SELECT * FROM t%d WHERE id = %d") % i % i);
+			record.m_executeTime = std::chrono::milliseconds(i == 9 ? 100 : i);
+			log.Record(record);
+		}
+		SlowQueryRecord record;
+		record.m_sql = u8"SELECT * FROM t8 WHERE id = 80";
+		record.m_executeTime = std::chrono::milliseconds(8);
+		log.Record(record);
+
+		vector<SlowQueryStatistics> top = log.GetTopStatements();
+		ASSERT_EQ(2, top.size());
+		EXPECT_EQ(u8"SELECT * FROM t9 WHERE id = ?", top[0].m_fingerprint);
+		EXPECT_EQ(std::chrono::milliseconds(100), top[0].m_totalTime);
+		EXPECT_EQ(u8"SELECT * FROM t8 WHERE id = ?", top[1].m_fingerprint);
+		EXPECT_EQ(2, top[1].m_count);
+		EXPECT_EQ(std::chrono::milliseconds(16), top[1].m_totalTime);
+		EXPECT_EQ(std::chrono::milliseconds(8), top[1].m_maxTime);
+
+		log.SetTopCount(10);
+		top = log.GetTopStatements();
+		ASSERT_EQ(8, top.size());
+		EXPECT_EQ(u8"SELECT * FROM t2 WHERE id = ?", top.back().m_fingerprint);
+	}
+
+
+	// SlowQueryLogDbTest
+	// ==================
+	void SlowQueryLogDbTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+
+		SlowQueryLog& log = SlowQueryLog::Get();
+		log.Reset();
+		log.SetThreshold(std::chrono::nanoseconds(0));
+		log.SetLogLevel(LogLevel::Debug);
+		log.SetEnabled(true);
+	}
+
+
+	void SlowQueryLogDbTest::TearDown()
+	{
+		SlowQueryLog& log = SlowQueryLog::Get();
+		log.SetEnabled(false);
+		log.SetThreshold(SlowQueryLog::DEFAULT_THRESHOLD);
+		log.SetLogLevel(LogLevel::Warning);
+		log.SetParameterRedactor(SlowQueryLog::ParameterRedactor());
+		log.Reset();
+	}
+
+
+	TEST_F(SlowQueryLogDbTest, RecordPreparedStatement)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s >= ?") % idColName % queryTableName % idColName);
+
+		vector<SlowQueryRecord> records;
+		SlowQueryLog::Get().SetParameterRedactor([&records](const SlowQueryRecord& record, SlowQueryParameter& param)
+		{
+			records.push_back(record);
+		});
+
+		{
+			ExecutableStatement stmt(m_pDb);
+			stmt.Prepare(sqlstmt);
+			LongColumnBufferPtr pParam = LongColumnBuffer::Create(u8"Param", SQL_INTEGER);
+			LongColumnBufferPtr pId = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			stmt.BindParameter(pParam, 1);
+			stmt.BindColumn(pId, 1);
+
+			// Ids 1 - 7: Fetch 3 rows. The execution ends on SQL_NO_DATA
+			pParam->SetValue(5);
+			stmt.ExecutePrepared();
+			while (stmt.SelectNext())
+			{ }
+			ASSERT_EQ(1, records.size());
+
+			// Executing again ends the pending execution
+			pParam->SetValue(7);
+			stmt.ExecutePrepared();
+			EXPECT_TRUE(stmt.SelectNext());
+			pParam->SetValue(1);
+			stmt.ExecutePrepared();
+			ASSERT_EQ(2, records.size());
+		}
+		// Destruction ends the last execution
+		ASSERT_EQ(3, records.size());
+
+		EXPECT_EQ(sqlstmt, records[0].m_sql);
+		EXPECT_EQ(3, records[0].m_rowsReturned);
+		ASSERT_EQ(1, records[0].m_parameters.size());
+		EXPECT_EQ(u8"5", records[0].m_parameters[0].m_value);
+		EXPECT_EQ(1, records[1].m_rowsReturned);
+		EXPECT_EQ(u8"7", records[1].m_parameters[0].m_value);
+		EXPECT_EQ(0, records[2].m_rowsReturned);
+
+		vector<SlowQueryStatistics> top = SlowQueryLog::Get().GetTopStatements();
+		ASSERT_EQ(1, top.size());
+		EXPECT_EQ(NormalizeSql(sqlstmt), top.front().m_fingerprint);
+		EXPECT_EQ(3, top.front().m_count);
+	}
+
+
+	TEST_F(SlowQueryLogDbTest, RecordRows)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+
+		ExecutableStatement stmt(m_pDb);
+		stmt.ExecuteDirect(sqlstmt);
+		for (const RowView& row : stmt.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, 4))
+		{
+			HIDE_UNUSED(row);
+		}
+
+		// The short block ended the execution
+		vector<SlowQueryStatistics> top = SlowQueryLog::Get().GetTopStatements();
+		ASSERT_EQ(1, top.size());
+		EXPECT_EQ(sqlstmt, top.front().m_lastSql);
+		EXPECT_EQ(1, top.front().m_count);
+	}
+
+
+	TEST_F(SlowQueryLogDbTest, RecordExecSql)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT * FROM %s") % queryTableName);
+
+		m_pDb->ExecSql(sqlstmt);
+
+		vector<SlowQueryStatistics> top = SlowQueryLog::Get().GetTopStatements();
+		ASSERT_EQ(1, top.size());
+		EXPECT_EQ(sqlstmt, top.front().m_lastSql);
+
+		// Nothing is recorded while disabled
+		SlowQueryLog::Get().SetEnabled(false);
+		m_pDb->ExecSql(sqlstmt);
+		EXPECT_EQ(1, SlowQueryLog::Get().GetTopStatements().front().m_count);
+	}
+
+} // namespace exodbctest
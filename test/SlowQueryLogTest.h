@@ -0,0 +1,49 @@
+﻿/*!
+* \file SlowQueryLogTest.h
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief Header-file description]
+*/
+
+#pragma once
+
+// Same component headers
+#include "exOdbcTest.h"
+#include "TestParams.h"
+
+// Other headers
+#include "gtest/gtest.h"
+#include "exodbc/Environment.h"
+#include "exodbc/Database.h"
+#include "exodbc/SlowQueryLog.h"
+
+// System headers
+
+// Forward declarations
+// --------------------
+
+namespace exodbctest
+{
+	// Structs
+	// -------
+
+	// Classes
+	// -------
+	class SlowQueryLogTest : public ::testing::Test
+	{
+	};
+
+
+	class SlowQueryLogDbTest : public ::testing::Test
+	{
+	protected:
+		virtual void SetUp();
+		virtual void TearDown();
+
+		exodbc::EnvironmentPtr m_pEnv = std::make_shared<exodbc::Environment>();
+		exodbc::DatabasePtr m_pDb = std::make_shared<exodbc::Database>();
+	};
+
+} // namespace exodbctest
@@ -0,0 +1,215 @@
+﻿/*!
+* \file SqlStmtHandlePoolTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "SqlStmtHandlePoolTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/ColumnBuffer.h"
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+
+	// SqlStmtHandlePoolTest
+	// =====================
+	void SqlStmtHandlePoolTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, AcquireAndRelease)
+	{
+		SqlStmtHandlePool pool(m_pDb->GetSqlDbcHandle());
+
+		// First one must be allocated
+		SqlStmtHandlePtr pHStmt = pool.Acquire();
+		ASSERT_TRUE(pHStmt);
+		EXPECT_TRUE(pHStmt->IsAllocated());
+		EXPECT_EQ(1, pool.GetAllocatedCount());
+		EXPECT_EQ(0, pool.GetReusedCount());
+		SQLHSTMT hStmt = pHStmt->GetHandle();
+
+		// Release it and we get the same handle back
+		pool.Release(std::move(pHStmt));
+		EXPECT_EQ(1, pool.GetPooledCount());
+		EXPECT_EQ(0, pool.GetDiscardedCount());
+
+		pHStmt = pool.Acquire();
+		EXPECT_EQ(hStmt, pHStmt->GetHandle());
+		EXPECT_EQ(1, pool.GetAllocatedCount());
+		EXPECT_EQ(1, pool.GetReusedCount());
+		EXPECT_EQ(0, pool.GetPooledCount());
+
+		// Counters can be reset
+		pool.ResetCounters();
+		EXPECT_EQ(0, pool.GetAllocatedCount());
+		EXPECT_EQ(0, pool.GetReusedCount());
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, ReleaseReferencedHandle)
+	{
+		SqlStmtHandlePool pool(m_pDb->GetSqlDbcHandle());
+
+		// If someone still holds a reference the handle must not be pooled
+		SqlStmtHandlePtr pHStmt = pool.Acquire();
+		pool.Release(pHStmt);
+		EXPECT_EQ(0, pool.GetPooledCount());
+		EXPECT_EQ(1, pool.GetDiscardedCount());
+		EXPECT_TRUE(pHStmt->IsAllocated());
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, MaxPooledHandles)
+	{
+		SqlStmtHandlePool pool(m_pDb->GetSqlDbcHandle(), 1);
+		EXPECT_EQ(1, pool.GetMaxPooledHandles());
+
+		SqlStmtHandlePtr pHStmt1 = pool.Acquire();
+		SqlStmtHandlePtr pHStmt2 = pool.Acquire();
+		EXPECT_EQ(2, pool.GetAllocatedCount());
+
+		pool.Release(std::move(pHStmt1));
+		pool.Release(std::move(pHStmt2));
+		EXPECT_EQ(1, pool.GetPooledCount());
+		EXPECT_EQ(1, pool.GetDiscardedCount());
+
+		// Lowering the limit frees the surplus
+		pool.SetMaxPooledHandles(0);
+		EXPECT_EQ(0, pool.GetPooledCount());
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, Close)
+	{
+		SqlStmtHandlePool pool(m_pDb->GetSqlDbcHandle());
+		SqlStmtHandlePtr pHStmt1 = pool.Acquire();
+		SqlStmtHandlePtr pHStmt2 = pool.Acquire();
+		pool.Release(std::move(pHStmt1));
+		EXPECT_EQ(1, pool.GetPooledCount());
+
+		EXPECT_TRUE(pool.IsOpen());
+		EXPECT_NO_THROW(pool.Close());
+		EXPECT_FALSE(pool.IsOpen());
+		EXPECT_EQ(0, pool.GetPooledCount());
+
+		// Releasing to a closed pool will not pool the handle
+		pool.Release(std::move(pHStmt2));
+		EXPECT_EQ(0, pool.GetPooledCount());
+		EXPECT_EQ(1, pool.GetDiscardedCount());
+
+		// And we cannot acquire anymore
+		{
+			LogLevelSetter ll(LogLevel::None);
+			EXPECT_THROW(pool.Acquire(), AssertionException);
+		}
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, ReleaseRestoresAttributes)
+	{
+		if (!m_pDb->TestScrollableCursorSupport())
+		{
+			LOG_WARNING(u8"Skipping test because Database does not support scrollable cursors");
+			return;
+		}
+
+		SqlStmtHandlePool pool(m_pDb->GetSqlDbcHandle());
+		SqlStmtHandlePtr pHStmt = pool.Acquire();
+		SQLULEN defaultValue = 0;
+		SQLRETURN ret = SQLGetStmtAttr(pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)&defaultValue, sizeof(defaultValue), NULL);
+		ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+		SQLULEN changedValue = defaultValue == SQL_SCROLLABLE ? SQL_NONSCROLLABLE : SQL_SCROLLABLE;
+		ret = SQLSetStmtAttr(pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)changedValue, 0);
+		ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+		pool.Release(std::move(pHStmt));
+		ASSERT_EQ(1, pool.GetPooledCount());
+
+		pHStmt = pool.Acquire();
+		SQLULEN value = 0;
+		ret = SQLGetStmtAttr(pHStmt->GetHandle(), SQL_ATTR_CURSOR_SCROLLABLE, (SQLPOINTER)&value, sizeof(value), NULL);
+		ASSERT_TRUE(SQL_SUCCEEDED(ret));
+		EXPECT_EQ(defaultValue, value);
+	}
+
+
+	TEST_F(SqlStmtHandlePoolTest, ExecutableStatementReusesHandles)
+	{
+		SqlStmtHandlePoolPtr pPool = m_pDb->GetStmtHandlePool();
+		ASSERT_TRUE(pPool);
+		pPool->ResetCounters();
+
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s ORDER BY %s") % idColName % queryTableName % idColName);
+
+		// Leave the first statement with an open cursor and bound columns
+		{
+			LongColumnBufferPtr pId = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			ExecutableStatement stmt(m_pDb);
+			stmt.BindColumn(pId, 1);
+			stmt.ExecuteDirect(sqlstmt);
+			EXPECT_TRUE(stmt.SelectNext());
+			EXPECT_EQ(1, *pId);
+		}
+
+		// The next statement gets the same handle, with the cursor closed
+		{
+			LongColumnBufferPtr pId = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			ExecutableStatement stmt(m_pDb);
+			stmt.BindColumn(pId, 1);
+			stmt.ExecuteDirect(sqlstmt);
+			EXPECT_TRUE(stmt.SelectNext());
+			EXPECT_EQ(1, *pId);
+			EXPECT_TRUE(stmt.SelectNext());
+			EXPECT_EQ(2, *pId);
+		}
+
+		EXPECT_EQ(1, pPool->GetReusedCount());
+		EXPECT_EQ(1, pPool->GetPooledCount());
+
+		// Disable pooling
+		m_pDb->SetMaxPooledStmtHandles(0);
+		EXPECT_EQ(0, pPool->GetPooledCount());
+		{
+			ExecutableStatement stmt(m_pDb);
+		}
+		EXPECT_EQ(0, pPool->GetPooledCount());
+	}
+
+} //namespace exodbctest
@@ -0,0 +1,226 @@
+﻿/*!
+* \file StatementMetricsTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 18.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "StatementMetricsTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/ColumnBuffer.h"
+
+// System headers
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+
+	// StatementMetricsTest
+	// ====================
+	TEST_F(StatementMetricsTest, NormalizeSql)
+	{
+		EXPECT_EQ(u8"SELECT * FROM t WHERE id = ?", NormalizeSql(u8"  SELECT *\r\n  FROM t\tWHERE id = 42  "));
+		EXPECT_EQ(u8"SELECT * FROM t WHERE a = ? AND b = ?", NormalizeSql(u8"SELECT * FROM t WHERE a = 'it''s' AND b = 1.5E+3"));
+		EXPECT_EQ(u8"SELECT * FROM t WHERE id IN (?, ?)", NormalizeSql(u8"SELECT * FROM t WHERE id IN (1, .5)"));
+		// identifiers are not touched, even if quoted or containing digits
+		EXPECT_EQ(u8"SELECT col1 FROM \"Table 2\" WHERE [x 3] = ?", NormalizeSql(u8"SELECT col1 FROM \"Table 2\" WHERE [x 3] = ?"));
+		EXPECT_EQ(u8"", NormalizeSql(u8" \n "));
+	}
+
+
+	TEST_F(StatementMetricsTest, Aggregate)
+	{
+		StatementMetricsRegistry registry;
+		EXPECT_FALSE(registry.IsEnabled());
+
+		StatementMetricsPtr pMetrics1 = registry.GetStatementMetrics(u8"SELECT * FROM t WHERE id = 1");
+		StatementMetricsPtr pMetrics2 = registry.GetStatementMetrics(u8"SELECT * FROM t WHERE id = 2");
+		EXPECT_EQ(pMetrics1, pMetrics2);
+
+		pMetrics1->RecordPrepare(std::chrono::nanoseconds(10));
+		pMetrics1->RecordExecute(std::chrono::nanoseconds(100), 8);
+		pMetrics2->RecordExecute(std::chrono::nanoseconds(300), 8);
+		pMetrics2->RecordFetch(std::chrono::nanoseconds(5), 1);
+		pMetrics2->RecordFetch(std::chrono::nanoseconds(5), 0);
+
+		vector<StatementMetricsSnapshot> snapshots = registry.GetSnapshots();
+		ASSERT_EQ(1, snapshots.size());
+		const StatementMetricsSnapshot& s = snapshots.front();
+		EXPECT_EQ(u8"SELECT * FROM t WHERE id = ?", s.m_normalizedSql);
+		EXPECT_EQ(1, s.m_prepareCount);
+		EXPECT_EQ(2, s.m_executeCount);
+		EXPECT_EQ(2, s.m_fetchCount);
+		EXPECT_EQ(1, s.m_rowsFetched);
+		EXPECT_EQ(16, s.m_bytesBound);
+		EXPECT_EQ(5, s.m_roundTrips);
+		EXPECT_EQ(10, s.m_prepareTime.count());
+		EXPECT_EQ(400, s.m_executeTime.count());
+		EXPECT_EQ(300, s.m_executeTimeMax.count());
+		EXPECT_EQ(10, s.m_fetchTime.count());
+
+		registry.Reset();
+		EXPECT_TRUE(registry.GetSnapshots().empty());
+	}
+
+
+	TEST_F(StatementMetricsTest, MaxStatements)
+	{
+		StatementMetricsRegistry registry;
+		registry.SetMaxStatements(2);
+		StatementMetricsPtr pA = registry.GetStatementMetrics(u8"SELECT a FROM t");
+		StatementMetricsPtr pB = registry.GetStatementMetrics(u8"SELECT b FROM t");
+		EXPECT_NE(pA, pB);
+
+		// Everything over the limit ends up in the same entry
+		StatementMetricsPtr pC = registry.GetStatementMetrics(u8"SELECT c FROM t");
+		StatementMetricsPtr pD = registry.GetStatementMetrics(u8"SELECT d FROM t");
+		EXPECT_EQ(pC, pD);
+		EXPECT_EQ(StatementMetricsRegistry::OVERFLOW_SQL, pC->GetNormalizedSql());
+		EXPECT_EQ(pA, registry.GetStatementMetrics(u8"SELECT a FROM t"));
+		EXPECT_EQ(3, registry.GetSnapshots().size());
+	}
+
+
+	TEST_F(StatementMetricsTest, WritePrometheus)
+	{
+		StatementMetricsRegistry registry;
+		StatementMetricsPtr pMetrics = registry.GetStatementMetrics(u8"SELECT \"a\\b\" FROM t");
+		pMetrics->RecordExecute(std::chrono::milliseconds(1500), 4);
+
+		stringstream ss;
+		registry.WritePrometheus(ss);
+		string text = ss.str();
+		EXPECT_NE(string::npos, text.find(u8"# TYPE exodbc_statement_executions_total counter\n"));
+		EXPECT_NE(string::npos, text.find(u8"exodbc_statement_executions_total{sql=\"SELECT \\\"a\\\\b\\\" FROM t\"} 1\n"));
+		EXPECT_NE(string::npos, text.find(u8"exodbc_statement_execute_seconds_total{sql=\"SELECT \\\"a\\\\b\\\" FROM t\"} 1.5\n"));
+		EXPECT_NE(string::npos, text.find(u8"exodbc_statement_bound_bytes_total{sql=\"SELECT \\\"a\\\\b\\\" FROM t\"} 4\n"));
+
+		string path = u8"StatementMetricsTest.prom";
+		registry.WritePrometheusFile(path);
+		ifstream in(path);
+		stringstream fileContent;
+		fileContent << in.rdbuf();
+		in.close();
+		EXPECT_EQ(text, fileContent.str());
+		std::remove(path.c_str());
+	}
+
+
+	// StatementMetricsDbTest
+	// ======================
+	void StatementMetricsDbTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+
+		StatementMetricsRegistry::Get().Reset();
+		StatementMetricsRegistry::Get().SetEnabled(true);
+	}
+
+
+	void StatementMetricsDbTest::TearDown()
+	{
+		StatementMetricsRegistry::Get().SetEnabled(false);
+		StatementMetricsRegistry::Get().Reset();
+	}
+
+
+	TEST_F(StatementMetricsDbTest, RecordPreparedStatement)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s WHERE %s >= ?") % idColName % queryTableName % idColName);
+
+		ExecutableStatement stmt(m_pDb);
+		stmt.Prepare(sqlstmt);
+		LongColumnBufferPtr pParam = LongColumnBuffer::Create(u8"Param", SQL_INTEGER);
+		LongColumnBufferPtr pId = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		stmt.BindParameter(pParam, 1);
+		stmt.BindColumn(pId, 1);
+
+		// Ids 1 - 7: Fetch 3 rows, then 7 rows
+		for (int minId : { 5, 1 })
+		{
+			pParam->SetValue(minId);
+			stmt.ExecutePrepared();
+			while (stmt.SelectNext())
+			{ }
+		}
+
+		StatementMetricsPtr pMetrics = stmt.GetMetrics();
+		ASSERT_TRUE(pMetrics != NULL);
+		StatementMetricsSnapshot s = pMetrics->GetSnapshot();
+		EXPECT_EQ(NormalizeSql(sqlstmt), s.m_normalizedSql);
+		EXPECT_EQ(1, s.m_prepareCount);
+		EXPECT_EQ(2, s.m_executeCount);
+		EXPECT_EQ(10, s.m_rowsFetched);
+		// One call returning SQL_NO_DATA per execution
+		EXPECT_EQ(12, s.m_fetchCount);
+		EXPECT_EQ(2 * (pParam->GetBufferLength() + pId->GetBufferLength()), (SQLLEN) s.m_bytesBound);
+		EXPECT_EQ(15, s.m_roundTrips);
+
+		// Nothing is recorded while disabled
+		StatementMetricsRegistry::Get().SetEnabled(false);
+		stmt.ExecutePrepared();
+		EXPECT_TRUE(stmt.GetMetrics() == NULL);
+		EXPECT_EQ(2, pMetrics->GetSnapshot().m_executeCount);
+	}
+
+
+	TEST_F(StatementMetricsDbTest, RecordRows)
+	{
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		string tableName = GetTableName(TableId::INTEGERTYPES);
+		string queryTableName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), tableName);
+		string sqlstmt = boost::str(boost::format(u8"SELECT %s FROM %s") % idColName % queryTableName);
+
+		ExecutableStatement stmt(m_pDb);
+		stmt.ExecuteDirect(sqlstmt);
+		size_t count = 0;
+		for (const RowView& row : stmt.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG) }, 4))
+		{
+			HIDE_UNUSED(row);
+			++count;
+		}
+		EXPECT_EQ(7, count);
+
+		vector<StatementMetricsSnapshot> snapshots = StatementMetricsRegistry::Get().GetSnapshots();
+		ASSERT_EQ(1, snapshots.size());
+		EXPECT_EQ(1, snapshots.front().m_executeCount);
+		EXPECT_EQ(7, snapshots.front().m_rowsFetched);
+		// Blocks of 4 and 3 rows, the short block is the last one
+		EXPECT_EQ(2, snapshots.front().m_fetchCount);
+	}
+
+} // namespace exodbctest
@@ -0,0 +1,142 @@
+﻿/*!
+* \file TableCopyTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "TableCopyTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/ExecutableStatement.h"
+#include "exodbc/LogManager.h"
+
+// System headers
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void TableCopyTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+		ASSERT_NO_THROW(m_pTargetDb = m_pDb->OpenNewConnection());
+	}
+
+
+	TEST_F(TableCopyTest, ColumnMapping)
+	{
+		Table source(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::CHARTYPES));
+		ASSERT_NO_THROW(source.Open());
+		Table target(m_pTargetDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::CHARTYPES_TMP));
+		ASSERT_NO_THROW(target.Open());
+
+		// The additional columns of the tmp table are not copied
+		TableCopy copy(source, target);
+		vector<pair<string, string>> mapping = copy.GetColumnMapping();
+		ASSERT_EQ(3, mapping.size());
+		EXPECT_TRUE(boost::algorithm::iequals(GetIdColumnName(TableId::CHARTYPES), mapping[0].first));
+		EXPECT_TRUE(boost::algorithm::iequals(u8"tvarchar", mapping[1].second));
+		EXPECT_TRUE(boost::algorithm::iequals(u8"tchar", mapping[2].second));
+
+		// The id columns are named after the table, no column matches
+		Table floats(m_pTargetDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::FLOATTYPES_TMP));
+		ASSERT_NO_THROW(floats.Open());
+		TableCopy noMatch(source, floats);
+		EXPECT_THROW(noMatch.GetColumnMapping(), Exception);
+	}
+
+
+	TEST_F(TableCopyTest, CopyIntegers)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		Table source(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(source.Open());
+		Table target(m_pTargetDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES_TMP));
+		ASSERT_NO_THROW(target.Open());
+
+		// Blocks that do not divide the 7 rows, commit after the second and the last block
+		TableCopy copy(source, target);
+		copy.SetBlockSize(2);
+		copy.SetQueueCapacity(1);
+		copy.SetCommitRows(3);
+		TableCopyResult result = copy.Run();
+		EXPECT_EQ(7, result.m_rows);
+		EXPECT_EQ(4, result.m_blocks);
+		EXPECT_EQ(2, result.m_commits);
+		EXPECT_EQ(0, result.m_truncatedValues);
+		EXPECT_LT(0, result.GetRowsPerSecond());
+
+		// Verify on a connection of its own that all rows have been committed
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		Table check(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES_TMP));
+		ASSERT_NO_THROW(check.Open());
+		EXPECT_EQ(7, check.Count());
+		RowRange rows = check.Rows(u8"", idColName);
+		SQLINTEGER expected = 1;
+		for (const RowView& row : rows)
+		{
+			EXPECT_EQ(expected, row.Get<SQLINTEGER>(0));
+			++expected;
+		}
+
+		// Copying again violates the primary key and rolls back
+		LogLevelSetter ll(LogLevel::None);
+		copy.SetWhere(boost::str(boost::format(u8"%s > 5") % GetIdColumnName(TableId::INTEGERTYPES)));
+		EXPECT_THROW(copy.Run(), Exception);
+	}
+
+
+	TEST_F(TableCopyTest, CopyChars)
+	{
+		ClearTmpTable(TableId::CHARTYPES_TMP);
+
+		Table source(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::CHARTYPES));
+		ASSERT_NO_THROW(source.Open());
+		Table target(m_pTargetDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::CHARTYPES_TMP));
+		ASSERT_NO_THROW(target.Open());
+
+		TableCopy copy(source, target);
+		TableCopyResult result = copy.Run();
+		EXPECT_EQ(4, result.m_rows);
+		EXPECT_EQ(1, result.m_blocks);
+		EXPECT_EQ(1, result.m_commits);
+
+		string idColName = GetIdColumnName(TableId::CHARTYPES_TMP);
+		Table check(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::CHARTYPES_TMP));
+		ASSERT_NO_THROW(check.Open());
+		RowRange rows = check.Rows(boost::str(boost::format(u8"%s = 3") % idColName));
+		RowRange::iterator it = rows.begin();
+		ASSERT_TRUE(it != rows.end());
+		EXPECT_EQ(u8"abcdef", boost::trim_right_copy(it->GetString(1)));
+		EXPECT_TRUE(it->IsNull(2));
+	}
+
+} // namespace exodbctest
@@ -0,0 +1,180 @@
+﻿/*!
+* \file TableLoadSchedulerTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "TableLoadSchedulerTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/DatabaseCatalog.h"
+#include "exodbc/LogManager.h"
+
+// System headers
+#include <mutex>
+#include <set>
+#include <vector>
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void TableLoadSchedulerTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	TEST(TableDependencyGraph, Waves)
+	{
+		// orders references customers and products, lines references orders and products
+		TableInfoVector tables = {
+			TableInfo(u8"lines", u8"TABLE", u8"", u8"", u8"shop"),
+			TableInfo(u8"orders", u8"TABLE", u8"", u8"", u8"shop"),
+			TableInfo(u8"customers", u8"TABLE", u8"", u8"", u8"shop"),
+			TableInfo(u8"products", u8"TABLE", u8"", u8"", u8"shop"),
+			TableInfo(u8"log", u8"TABLE", u8"", u8"", u8"shop")
+		};
+		TableDependencyGraph graph(tables);
+		EXPECT_TRUE(graph.AddDependency(ForeignKeyInfo(u8"customers", u8"id", u8"orders", u8"customer", 1)));
+		EXPECT_TRUE(graph.AddDependency(ForeignKeyInfo(u8"products", u8"id", u8"orders", u8"product", 1)));
+		EXPECT_TRUE(graph.AddDependency(ForeignKeyInfo(u8"orders", u8"id", u8"lines", u8"order", 1)));
+		graph.AddDependency(0, 3);
+
+		// Referencing a table outside of the graph or itself adds no dependency
+		EXPECT_FALSE(graph.AddDependency(ForeignKeyInfo(u8"users", u8"id", u8"log", u8"user", 1)));
+		EXPECT_TRUE(graph.AddDependency(ForeignKeyInfo(u8"log", u8"id", u8"log", u8"parent", 1)));
+		EXPECT_TRUE(graph.GetDependencies(4).empty());
+
+		EXPECT_EQ(1, graph.FindTable(u8"orders"));
+		EXPECT_EQ(1, graph.FindTable(u8"orders", u8"shop"));
+		EXPECT_THROW(graph.FindTable(u8"orders", u8"other"), NotFoundException);
+		EXPECT_EQ(set<size_t>({ 0 }), graph.GetDependents(1));
+
+		vector<vector<size_t>> waves = graph.GetWaves();
+		ASSERT_EQ(3, waves.size());
+		EXPECT_EQ(vector<size_t>({ 2, 3, 4 }), waves[0]);
+		EXPECT_EQ(vector<size_t>({ 1 }), waves[1]);
+		EXPECT_EQ(vector<size_t>({ 0 }), waves[2]);
+
+		// A cycle cannot be ordered
+		graph.AddDependency(2, 0);
+		EXPECT_THROW(graph.GetWaves(), Exception);
+	}
+
+
+	TEST_F(TableLoadSchedulerTest, Run)
+	{
+		DatabaseCatalogPtr pDbCat = m_pDb->GetDbCatalog();
+		TableInfoVector tables = {
+			pDbCat->FindOneTable(GetTableName(TableId::INTEGERTYPES)),
+			pDbCat->FindOneTable(GetTableName(TableId::FLOATTYPES)),
+			pDbCat->FindOneTable(GetTableName(TableId::CHARTYPES)),
+			pDbCat->FindOneTable(GetTableName(TableId::DATETYPES))
+		};
+
+		// The test tables have no foreign keys, add some
+		TableDependencyGraph graph = TableDependencyGraph::Create(m_pDb, tables);
+		for (size_t i = 0; i < tables.size(); ++i)
+		{
+			EXPECT_TRUE(graph.GetDependencies(i).empty());
+		}
+		graph.AddDependency(0, 1);
+		graph.AddDependency(0, 2);
+		graph.AddDependency(3, 0);
+
+		TableLoadScheduler scheduler(graph, m_pDb);
+		scheduler.SetConcurrency(3);
+		mutex loadedMutex;
+		set<string> loaded;
+		TableLoadResult result = scheduler.Run([&](const TableInfo& table, DatabasePtr pDb)
+		{
+			EXPECT_NE(m_pDb.get(), pDb.get());
+			size_t index = graph.FindTable(table.GetName());
+			{
+				lock_guard<mutex> lock(loadedMutex);
+				for (size_t dependency : graph.GetDependencies(index))
+				{
+					EXPECT_EQ(1, loaded.count(graph.GetTable(dependency).GetName()));
+				}
+			}
+
+			Table t(pDb, TableAccessFlag::AF_READ_WITHOUT_PK, table);
+			t.Open();
+			unsigned long long rows = t.Count();
+
+			lock_guard<mutex> lock(loadedMutex);
+			loaded.insert(table.GetName());
+			return rows;
+		});
+
+		EXPECT_EQ(4, result.m_tables);
+		EXPECT_EQ(3, result.m_waves);
+		EXPECT_LE(1, result.m_maxConcurrentTables);
+		EXPECT_GE(2, result.m_maxConcurrentTables);
+		ASSERT_EQ(4, result.m_tableRows.size());
+		EXPECT_EQ(7, result.m_tableRows[0]);
+		EXPECT_EQ(6, result.m_tableRows[1]);
+		EXPECT_EQ(result.m_tableRows[0] + result.m_tableRows[1] + result.m_tableRows[2] + result.m_tableRows[3], result.m_rows);
+
+		// The first error stops loading further tables
+		LogLevelSetter ll(LogLevel::None);
+		EXPECT_THROW(scheduler.Run([](const TableInfo& table, DatabasePtr pDb) -> unsigned long long
+		{
+			Exception ex(u8"Failed to load " + table.GetName());
+			SET_EXCEPTION_SOURCE(ex);
+			throw ex;
+		}), Exception);
+	}
+
+
+	TEST_F(TableLoadSchedulerTest, RunCopy)
+	{
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		DatabaseCatalogPtr pDbCat = m_pDb->GetDbCatalog();
+		TableInfoVector targets = { pDbCat->FindOneTable(GetTableName(TableId::INTEGERTYPES_TMP)) };
+		TableInfoVector sources = { pDbCat->FindOneTable(GetTableName(TableId::INTEGERTYPES)) };
+		TableDependencyGraph graph(targets);
+
+		TableLoadScheduler scheduler(graph, m_pDb);
+		TableLoadResult result = scheduler.RunCopy([&]() { return m_pDb->OpenNewConnection(); }, sources, [](const TableInfo& target, TableCopy& copy)
+		{
+			copy.SetBlockSize(3);
+		});
+		EXPECT_EQ(1, result.m_tables);
+		EXPECT_EQ(7, result.m_rows);
+
+		Table check(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES_TMP));
+		ASSERT_NO_THROW(check.Open());
+		EXPECT_EQ(7, check.Count());
+	}
+
+} // namespace exodbctest
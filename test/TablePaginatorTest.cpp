@@ -0,0 +1,168 @@
+﻿/*!
+* \file TablePaginatorTest.cpp
+* \author Elias Gerber <eg@elisium.ch>
+* \date 19.10.2026
+* \copyright GNU Lesser General Public License Version 3
+*
+* [Brief CPP-file description]
+*/
+
+// Own header
+#include "TablePaginatorTest.h"
+
+// Same component headers
+#include "exOdbcTestHelpers.h"
+
+// Other headers
+#include "exodbc/Table.h"
+#include "exodbc/LogManager.h"
+
+// System headers
+
+// Debug
+#include "DebugNew.h"
+
+using namespace exodbc;
+using namespace std;
+
+namespace exodbctest
+{
+	// Static consts
+	// -------------
+
+	// Construction
+	// -------------
+
+	// Destructor
+	// -----------
+
+	// Implementation
+	// --------------
+	void TablePaginatorTest::SetUp()
+	{
+		ASSERT_TRUE(g_odbcInfo.IsUsable());
+
+		m_pEnv->Init(OdbcVersion::V_3);
+
+		ASSERT_NO_THROW(m_pDb = OpenTestDb(m_pEnv));
+	}
+
+
+	TEST_F(TablePaginatorTest, NextPage)
+	{
+		Table table(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		if (m_pDb->GetDbms() == DatabaseProduct::ACCESS)
+		{
+			table.SetColumnPrimaryKeyIndexes({ 0 });
+		}
+		ASSERT_NO_THROW(table.Open());
+
+		TablePaginator paginator(table, 3);
+		SQLINTEGER expected = 1;
+		RowBlockPtr pPage;
+		while ((pPage = paginator.NextPage()))
+		{
+			EXPECT_LE(pPage->GetRowsFetched(), (SQLULEN)3);
+			for (SQLULEN i = 0; i < pPage->GetRowsFetched(); ++i)
+			{
+				EXPECT_EQ(expected, RowView(pPage.get(), i).Get<SQLINTEGER>(0));
+				++expected;
+			}
+		}
+		EXPECT_EQ(8, expected);
+		EXPECT_EQ(3, paginator.GetPageCount());
+
+		// Start again with the first page
+		paginator.Reset();
+		pPage = paginator.NextPage();
+		ASSERT_TRUE(pPage != NULL);
+		EXPECT_EQ(3, pPage->GetRowsFetched());
+		EXPECT_EQ(1, RowView(pPage.get(), 0).Get<SQLINTEGER>(0));
+	}
+
+
+	TEST_F(TablePaginatorTest, NextPageWhere)
+	{
+		Table table(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::INTEGERTYPES));
+		if (m_pDb->GetDbms() == DatabaseProduct::ACCESS)
+		{
+			table.SetColumnPrimaryKeyIndexes({ 0 });
+		}
+		ASSERT_NO_THROW(table.Open());
+
+		// Ids 2 to 7 fill two pages, the third page is empty
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		TablePaginator paginator(table, 3, idColName + u8" > 1");
+		RowBlockPtr pPage = paginator.NextPage();
+		ASSERT_TRUE(pPage != NULL);
+		EXPECT_EQ(3, pPage->GetRowsFetched());
+		EXPECT_EQ(2, RowView(pPage.get(), 0).Get<SQLINTEGER>(0));
+		pPage = paginator.NextPage();
+		ASSERT_TRUE(pPage != NULL);
+		EXPECT_EQ(3, pPage->GetRowsFetched());
+		EXPECT_EQ(5, RowView(pPage.get(), 0).Get<SQLINTEGER>(0));
+		EXPECT_EQ(7, RowView(pPage.get(), 2).Get<SQLINTEGER>(0));
+		EXPECT_FALSE(paginator.NextPage());
+		EXPECT_EQ(2, paginator.GetPageCount());
+	}
+
+
+	TEST_F(TablePaginatorTest, NoPrimaryKey)
+	{
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(table.Open());
+
+		LogLevelSetter ll(LogLevel::None);
+		EXPECT_THROW(TablePaginator(table, 3), Exception);
+	}
+
+
+	TEST_F(TablePaginatorTest, PrimaryKeyColumnNotSelected)
+	{
+		// Exclude id3, the last part of the key (id1, id2, id3), from the select
+		Table table(m_pDb, TableAccessFlag::AF_READ, GetTableName(TableId::MULTIKEY));
+		table.CreateAutoColumnBufferPtrs(false, true, false);
+		table.ClearColumnFlag(3, ColumnFlag::CF_SELECT);
+		if (m_pDb->GetDbms() == DatabaseProduct::ACCESS)
+		{
+			table.SetColumnPrimaryKeyIndexes({ 0, 1, 3 });
+		}
+		ASSERT_NO_THROW(table.Open());
+
+		LogLevelSetter ll(LogLevel::None);
+		EXPECT_THROW(TablePaginator(table, 3), Exception);
+	}
+
+
+	TEST(TablePaginator, BuildPageSql)
+	{
+		EXPECT_EQ(u8"SELECT TOP 10 id, v FROM t WHERE id > ? ORDER BY id",
+			TablePaginator::BuildPageSql(DatabaseProduct::MS_SQL_SERVER, u8"id, v", u8"t", u8"id > ?", u8"id", 10));
+		EXPECT_EQ(u8"SELECT TOP 10 id, v FROM t ORDER BY id",
+			TablePaginator::BuildPageSql(DatabaseProduct::ACCESS, u8"id, v", u8"t", u8"", u8"id", 10));
+		EXPECT_EQ(u8"SELECT id, v FROM t WHERE id > ? ORDER BY id LIMIT 10",
+			TablePaginator::BuildPageSql(DatabaseProduct::POSTGRESQL, u8"id, v", u8"t", u8"id > ?", u8"id", 10));
+		EXPECT_EQ(u8"SELECT id, v FROM t ORDER BY id LIMIT 10",
+			TablePaginator::BuildPageSql(DatabaseProduct::MY_SQL, u8"id, v", u8"t", u8"", u8"id", 10));
+		EXPECT_EQ(u8"SELECT id, v FROM t WHERE id > ? ORDER BY id FETCH FIRST 10 ROWS ONLY",
+			TablePaginator::BuildPageSql(DatabaseProduct::DB2, u8"id, v", u8"t", u8"id > ?", u8"id", 10));
+	}
+
+
+	TEST(TablePaginator, BuildKeyCondition)
+	{
+		vector<size_t> paramKeys;
+		EXPECT_EQ(u8"id > ?", TablePaginator::BuildKeyCondition(DatabaseProduct::POSTGRESQL, { u8"id" }, paramKeys));
+		EXPECT_EQ(vector<size_t>({ 0 }), paramKeys);
+
+		paramKeys.clear();
+		EXPECT_EQ(u8"(id1, id2) > (?, ?)", TablePaginator::BuildKeyCondition(DatabaseProduct::POSTGRESQL, { u8"id1", u8"id2" }, paramKeys));
+		EXPECT_EQ(vector<size_t>({ 0, 1 }), paramKeys);
+
+		paramKeys.clear();
+		EXPECT_EQ(u8"id1 > ? OR (id1 = ? AND id2 > ?) OR (id1 = ? AND id2 = ? AND id3 > ?)",
+			TablePaginator::BuildKeyCondition(DatabaseProduct::MS_SQL_SERVER, { u8"id1", u8"id2", u8"id3" }, paramKeys));
+		EXPECT_EQ(vector<size_t>({ 0, 0, 1, 0, 1, 2 }), paramKeys);
+	}
+
+} // namespace exodbctest
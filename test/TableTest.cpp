@@ -667,6 +667,68 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, SelectStaticCursor)
+	{
+		if (!m_pDb->GetSupportsCursorProfile(CursorProfile::StaticReadOnly()))
+		{
+			LOG_WARNING(u8"Skipping test because Database does not support static cursors");
+			return;
+		}
+
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idName = GetIdColumnName(TableId::INTEGERTYPES);
+		exodbc::Table iTable(m_pDb, TableAccessFlag::AF_READ, tableName);
+		ASSERT_NO_THROW(iTable.Open(TableOpenFlag::TOF_STATIC_CURSORS));
+
+		LongColumnBufferPtr pIdCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+
+		std::string sqlWhere = boost::str(boost::format(u8"%s >= 2 ORDER BY %s ASC") % idName % idName);
+		ASSERT_NO_THROW(iTable.Select(sqlWhere));
+		EXPECT_TRUE(iTable.SelectLast());
+		EXPECT_EQ(7, *pIdCol);
+		EXPECT_TRUE(iTable.SelectFirst());
+		EXPECT_EQ(2, *pIdCol);
+
+		// Selecting two cursor types is an error
+		exodbc::Table iTable2(m_pDb, TableAccessFlag::AF_READ, tableName);
+		EXPECT_THROW(iTable2.Open(TableOpenFlag::TOF_STATIC_CURSORS | TableOpenFlag::TOF_DYNAMIC_CURSORS), AssertionException);
+	}
+
+
+	TEST_F(TableTest, SelectBookmark)
+	{
+		if (!m_pDb->GetSupportsCursorProfile(CursorProfile::StaticReadOnly()) || !m_pDb->GetSupportsBookmarks(CursorType::STATIC))
+		{
+			LOG_WARNING(u8"Skipping test because Database does not support bookmarks on static cursors");
+			return;
+		}
+
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idName = GetIdColumnName(TableId::INTEGERTYPES);
+		exodbc::Table iTable(m_pDb, TableAccessFlag::AF_READ, tableName);
+		ASSERT_NO_THROW(iTable.Open(TableOpenFlag::TOF_STATIC_CURSORS | TableOpenFlag::TOF_BOOKMARKS));
+
+		LongColumnBufferPtr pIdCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+
+		std::string sqlWhere = boost::str(boost::format(u8"%s >= 2 ORDER BY %s ASC") % idName % idName);
+		ASSERT_NO_THROW(iTable.Select(sqlWhere));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(3, *pIdCol);
+		Bookmark third = iTable.GetBookmark();
+		EXPECT_TRUE(iTable.SelectLast());
+		EXPECT_EQ(7, *pIdCol);
+		EXPECT_TRUE(iTable.SelectBookmark(third));
+		EXPECT_EQ(3, *pIdCol);
+		EXPECT_TRUE(iTable.SelectBookmark(third, -1));
+		EXPECT_EQ(2, *pIdCol);
+
+		// Bookmarks require a scrollable cursor
+		exodbc::Table iTable2(m_pDb, TableAccessFlag::AF_READ, tableName);
+		EXPECT_THROW(iTable2.Open(TableOpenFlag::TOF_BOOKMARKS), AssertionException);
+	}
+
+
 	TEST_F(TableTest, SelectAbsolute)
 	{
 		std::string tableName = GetTableName(TableId::INTEGERTYPES);
@@ -800,6 +862,85 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, SelectWhereTemplate)
+	{
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		exodbc::Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		ASSERT_NO_THROW(iTable.Open());
+
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		string whereTemplate = boost::str(boost::format(u8"%s = ?") % idColName);
+		auto pIdCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		auto pIntCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+
+		// The same template is executed with different values
+		pIdParam->SetValue(2);
+		EXPECT_NO_THROW(iTable.Select(whereTemplate, { pIdParam }));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(2, pIdCol->GetValue());
+		EXPECT_TRUE(pIntCol->IsNull());
+		EXPECT_FALSE(iTable.SelectNext());
+
+		pIdParam->SetValue(7);
+		EXPECT_NO_THROW(iTable.Select(whereTemplate, { pIdParam }));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(7, pIdCol->GetValue());
+		EXPECT_EQ(26, pIntCol->GetValue());
+		EXPECT_FALSE(iTable.SelectNext());
+
+		// Passing a different buffer for the same template rebinds the parameter
+		LongColumnBufferPtr pOtherIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		pOtherIdParam->SetValue(3);
+		EXPECT_NO_THROW(iTable.Select(whereTemplate, { pOtherIdParam }));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(3, pIdCol->GetValue());
+
+		// And mixing with a plain Select() switches back to the ordinary select statement
+		EXPECT_NO_THROW(iTable.Select(boost::str(boost::format(u8"%s = 4") % idColName)));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(4, pIdCol->GetValue());
+		EXPECT_FALSE(iTable.SelectNext());
+
+		// Templates with an order
+		pIdParam->SetValue(5);
+		EXPECT_NO_THROW(iTable.Select(boost::str(boost::format(u8"%s >= ?") % idColName), { pIdParam }, boost::str(boost::format(u8"%s ASC") % idColName)));
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(5, pIdCol->GetValue());
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(6, pIdCol->GetValue());
+		EXPECT_NO_THROW(iTable.SelectClose());
+	}
+
+
+	TEST_F(TableTest, Rows)
+	{
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		exodbc::Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		ASSERT_NO_THROW(iTable.Open());
+
+		// Use a block size that does not divide the 7 records
+		RowRange rows = iTable.Rows(u8"", boost::str(boost::format(u8"%s ASC") % idColName), 3);
+		EXPECT_EQ(iTable.GetColumnBufferCount(), rows.GetColumnCount());
+		ColumnAccessor<SQLINTEGER> id = rows.GetAccessor<SQLINTEGER>(0);
+		SQLINTEGER expected = 1;
+		for (const RowView& row : rows)
+		{
+			EXPECT_EQ(expected, id(row));
+			++expected;
+		}
+		EXPECT_EQ(8, expected);
+
+		// Works with a where clause and standard algorithms, and leaves the buffers of the table alone
+		LongColumnBufferPtr pIdCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		pIdCol->SetValue(42);
+		RowRange filtered = iTable.Rows(boost::str(boost::format(u8"%s > 4") % idColName));
+		EXPECT_EQ(3, std::distance(filtered.begin(), filtered.end()));
+		EXPECT_EQ(42, pIdCol->GetValue());
+	}
+
+
 	TEST_F(TableTest, SelectClose)
 	{
 		std::string tableName = GetTableName(TableId::INTEGERTYPES);
@@ -845,6 +986,142 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, CountWhereTemplate)
+	{
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		ASSERT_NO_THROW(table.Open());
+
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		string whereTemplate = boost::str(boost::format(u8"%s >= ?") % idColName);
+
+		SQLUBIGINT count = 0;
+		pIdParam->SetValue(1);
+		EXPECT_NO_THROW(count = table.Count(whereTemplate, { pIdParam }));
+		EXPECT_EQ(7, count);
+		pIdParam->SetValue(5);
+		EXPECT_NO_THROW(count = table.Count(whereTemplate, { pIdParam }));
+		EXPECT_EQ(3, count);
+		pIdParam->SetValue(100);
+		EXPECT_NO_THROW(count = table.Count(whereTemplate, { pIdParam }));
+		EXPECT_EQ(0, count);
+	}
+
+
+	TEST_F(TableTest, WhereTemplateStatementsAreLimited)
+	{
+		std::string tableName = GetTableName(TableId::INTEGERTYPES);
+		std::string idColName = GetIdColumnName(TableId::INTEGERTYPES);
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		ASSERT_NO_THROW(table.Open());
+		EXPECT_EQ(DEFAULT_MAX_WHERE_TEMPLATE_STATEMENTS, table.GetMaxWhereTemplateStatements());
+		table.SetMaxWhereTemplateStatements(2);
+
+		// Every template is a statement of its own, only the two used last are kept
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		pIdParam->SetValue(3);
+		string geTemplate = boost::str(boost::format(u8"%s >= ?") % idColName);
+		string leTemplate = boost::str(boost::format(u8"%s <= ?") % idColName);
+		string eqTemplate = boost::str(boost::format(u8"%s = ?") % idColName);
+		EXPECT_EQ(5, table.Count(geTemplate, { pIdParam }));
+		EXPECT_EQ(3, table.Count(leTemplate, { pIdParam }));
+		EXPECT_EQ(2, table.GetWhereTemplateStatementCount());
+		EXPECT_EQ(1, table.Count(eqTemplate, { pIdParam }));
+		EXPECT_EQ(2, table.GetWhereTemplateStatementCount());
+
+		// An evicted template is prepared again
+		EXPECT_EQ(5, table.Count(geTemplate, { pIdParam }));
+		EXPECT_EQ(2, table.GetWhereTemplateStatementCount());
+
+		// The statement SelectNext() reads from is not evicted, even if used least recently
+		auto pIdCol = table.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		table.Select(eqTemplate, { pIdParam });
+		EXPECT_EQ(3, table.Count(leTemplate, { pIdParam }));
+		EXPECT_EQ(4, table.Count(boost::str(boost::format(u8"%s > ?") % idColName), { pIdParam }));
+		EXPECT_EQ(2, table.GetWhereTemplateStatementCount());
+		table.SetMaxWhereTemplateStatements(1);
+		EXPECT_EQ(1, table.GetWhereTemplateStatementCount());
+		ASSERT_TRUE(table.SelectNext());
+		EXPECT_EQ(3, pIdCol->GetValue());
+		EXPECT_FALSE(table.SelectNext());
+	}
+
+
+	TEST_F(TableTest, WhereTemplateStatementsLimitKeepsActiveSelect)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		{
+			Table iTable(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+			iTable.Open();
+			auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			for (SQLINTEGER id = 6100; id <= 6102; ++id)
+			{
+				pId->SetValue(id);
+				iTable.Insert();
+			}
+			m_pDb->CommitTrans();
+		}
+
+		Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK | TableAccessFlag::AF_DELETE_WHERE, tableName);
+		ASSERT_NO_THROW(iTable.Open());
+		iTable.SetMaxWhereTemplateStatements(1);
+		auto pIdCol = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+
+		LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+		pIdParam->SetValue(6100);
+		string eqTemplate = boost::str(boost::format(u8"%s = ?") % idColName);
+		string geTemplate = boost::str(boost::format(u8"%s >= ?") % idColName);
+		string gtTemplate = boost::str(boost::format(u8"%s > ?") % idColName);
+
+		// While the select is active, the cache keeps it and the statement just used
+		iTable.Select(eqTemplate, { pIdParam });
+		EXPECT_EQ(3, iTable.Count(geTemplate, { pIdParam }));
+		EXPECT_EQ(2, iTable.GetWhereTemplateStatementCount());
+		ASSERT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(6100, pIdCol->GetValue());
+		EXPECT_FALSE(iTable.SelectNext());
+
+		EXPECT_NO_THROW(iTable.Delete(gtTemplate, { pIdParam }));
+		EXPECT_EQ(2, iTable.GetWhereTemplateStatementCount());
+		m_pDb->CommitTrans();
+		EXPECT_EQ(1, iTable.Count(geTemplate, { pIdParam }));
+
+		// The active select is still usable
+		iTable.Select(eqTemplate, { pIdParam });
+		ASSERT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(6100, pIdCol->GetValue());
+		EXPECT_FALSE(iTable.SelectNext());
+	}
+
+
+	TEST_F(TableTest, EstimateCount)
+	{
+		Table table(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, GetTableName(TableId::INTEGERTYPES));
+		ASSERT_NO_THROW(table.Open());
+
+		// Statistics might be outdated, but falling back to counting never fails
+		SQLUBIGINT estimate = 0;
+		EXPECT_NO_THROW(estimate = table.EstimateCount());
+
+		DatabaseCatalogPtr pDbCat = m_pDb->GetDbCatalog();
+		TableStatistics stats = pDbCat->ReadStatistics(table.GetTableInfo());
+		if (stats.HasCardinality() && stats.GetCardinality() >= 0)
+		{
+			EXPECT_EQ((SQLUBIGINT) stats.GetCardinality(), estimate);
+			EXPECT_EQ(estimate, table.EstimateCount(false));
+		}
+		else
+		{
+			EXPECT_EQ(7, estimate);
+			EXPECT_THROW(table.EstimateCount(false), NotFoundException);
+		}
+	}
+
+
 	// Insert rows
 	// ---------
 	TEST_F(TableTest, Insert)
@@ -997,6 +1274,122 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, Upsert)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		{
+			Table iTable(m_pDb, TableAccessFlag::AF_WRITE, tableName);
+			iTable.Open();
+			auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+
+			// Insert two rows, then update the first one
+			pId->SetValue(300);
+			pInt->SetValue(400);
+			iTable.Upsert();
+			pId->SetValue(301);
+			pInt->SetValue(401);
+			iTable.Upsert();
+			pId->SetValue(300);
+			pInt->SetValue(500);
+			iTable.Upsert();
+			m_pDb->CommitTrans();
+		}
+
+		// Read back values
+		Table iTable(m_pDb, TableAccessFlag::AF_READ, tableName);
+		iTable.Open();
+		auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+
+		EXPECT_EQ(2, iTable.Count());
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		string sqlWhere = boost::str(boost::format(u8"%s = 300 OR %s = 301 ORDER by %s") % idColName %idColName %idColName);
+		iTable.Select(sqlWhere);
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(300, *pId);
+		EXPECT_EQ(500, *pInt);
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(301, *pId);
+		EXPECT_EQ(401, *pInt);
+	}
+
+
+	TEST_F(TableTest, UpsertRows)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		Table iTable(m_pDb, TableAccessFlag::AF_READ_WRITE, tableName);
+		iTable.Open();
+		auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+
+		// One of the rows exists already
+		pId->SetValue(2);
+		pInt->SetValue(999);
+		iTable.Insert();
+		m_pDb->CommitTrans();
+
+		// Read the rows to upsert from integertypes, using the column names of the tmp table
+		string sourceQueryName = PrependSchemaOrCatalogName(m_pDb->GetDbms(), GetTableName(TableId::INTEGERTYPES));
+		string sourceIdColName = GetIdColumnName(TableId::INTEGERTYPES);
+		RowBlockPtr pBlock;
+		{
+			ExecutableStatement source(m_pDb);
+			source.ExecuteDirect(boost::str(boost::format(u8"SELECT %s, tint FROM %s ORDER BY %s") % sourceIdColName % sourceQueryName % sourceIdColName));
+			RowRange rows = source.Rows({ RowColumnDefinition(idColName, SQL_C_SLONG), RowColumnDefinition(u8"tint", SQL_C_SLONG) }, 10);
+			ASSERT_TRUE(rows.GetBlock().NextBlock());
+			pBlock = rows.GetBlock().CopyCurrentBlock();
+		}
+		ASSERT_EQ(7, pBlock->GetRowsFetched());
+
+		EXPECT_EQ(7, iTable.Upsert(*pBlock));
+		m_pDb->CommitTrans();
+
+		// The tmp table now holds the same values as the source
+		EXPECT_EQ(7, iTable.Count());
+		iTable.Select(boost::str(boost::format(u8"%s > 0 ORDER BY %s") % idColName % idColName));
+		for (SQLULEN i = 0; i < 7; ++i)
+		{
+			RowView sourceRow(pBlock.get(), i);
+			ASSERT_TRUE(iTable.SelectNext());
+			EXPECT_EQ(sourceRow.Get<SQLINTEGER>(0), *pId);
+			EXPECT_EQ(sourceRow.IsNull(1), pInt->IsNull());
+			if (!sourceRow.IsNull(1))
+			{
+				EXPECT_EQ(sourceRow.Get<SQLINTEGER>(1), *pInt);
+			}
+		}
+		EXPECT_FALSE(iTable.SelectNext());
+	}
+
+
+	TEST(Table, BuildUpsertSql)
+	{
+		vector<string> columns = { u8"id", u8"a", u8"b" };
+		vector<string> keys = { u8"id" };
+		vector<string> updates = { u8"a", u8"b" };
+
+		EXPECT_EQ(u8"MERGE INTO t WITH (HOLDLOCK) AS target USING (VALUES (?, ?, ?)) AS source (id, a, b) ON target.id = source.id"
+			u8" WHEN MATCHED THEN UPDATE SET a = source.a, b = source.b WHEN NOT MATCHED THEN INSERT (id, a, b) VALUES (source.id, source.a, source.b);",
+			Table::BuildUpsertSql(DatabaseProduct::MS_SQL_SERVER, u8"t", columns, keys, updates));
+		EXPECT_EQ(u8"MERGE INTO t AS target USING (VALUES (?, ?, ?)) AS source (id, a, b) ON target.id = source.id"
+			u8" WHEN NOT MATCHED THEN INSERT (id, a, b) VALUES (source.id, source.a, source.b)",
+			Table::BuildUpsertSql(DatabaseProduct::DB2, u8"t", columns, keys, vector<string>()));
+		EXPECT_EQ(u8"INSERT INTO t (id, a, b) VALUES (?, ?, ?) ON CONFLICT (id) DO UPDATE SET a = EXCLUDED.a, b = EXCLUDED.b",
+			Table::BuildUpsertSql(DatabaseProduct::POSTGRESQL, u8"t", columns, keys, updates));
+		EXPECT_EQ(u8"INSERT INTO t (id, a, b) VALUES (?, ?, ?) ON CONFLICT (id) DO NOTHING",
+			Table::BuildUpsertSql(DatabaseProduct::POSTGRESQL, u8"t", columns, keys, vector<string>()));
+		EXPECT_EQ(u8"INSERT INTO t (id, a, b) VALUES (?, ?, ?) ON DUPLICATE KEY UPDATE a = VALUES(a), b = VALUES(b)",
+			Table::BuildUpsertSql(DatabaseProduct::MY_SQL, u8"t", columns, keys, updates));
+		EXPECT_EQ(u8"", Table::BuildUpsertSql(DatabaseProduct::ACCESS, u8"t", columns, keys, updates));
+	}
+
+
 	TEST_F(TableTest, UpdateFlag)
 	{
 		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
@@ -1121,6 +1514,71 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, UpdateWhereTemplate)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		{
+			// Insert some rows
+			Table iTable(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+			iTable.Open();
+
+			// Set some values
+			auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+			pId->SetValue(310);
+			pInt->SetValue(410);
+			iTable.Insert();
+
+			pId->SetValue(311);
+			pInt->SetValue(411);
+			iTable.Insert();
+
+			m_pDb->CommitTrans();
+		}
+		{
+			// And update, using the same template for both rows
+			Table iTable(m_pDb, TableAccessFlag::AF_UPDATE_WHERE, tableName);
+			iTable.Open();
+
+			// note: The id column is part of the SET clause too, keep its value
+			auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+			LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			string whereTemplate = boost::str(boost::format(u8"%s = ?") % idColName);
+
+			pId->SetValue(310);
+			pIdParam->SetValue(310);
+			pInt->SetValue(5010);
+			iTable.Update(whereTemplate, { pIdParam });
+
+			pId->SetValue(311);
+			pIdParam->SetValue(311);
+			pInt->SetValue(5011);
+			iTable.Update(whereTemplate, { pIdParam });
+
+			m_pDb->CommitTrans();
+		}
+
+		// Read back values
+		Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		iTable.Open();
+		auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+		auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+
+		string sqlWhere = boost::str(boost::format(u8"%s = 310 OR %s = 311 ORDER by %s") % idColName %idColName %idColName);
+		iTable.Select(sqlWhere);
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(310, *pId);
+		EXPECT_EQ(5010, *pInt);
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(311, *pId);
+		EXPECT_EQ(5011, *pInt);
+	}
+
+
 	// Delete rows
 	// ---------
 	TEST_F(TableTest, DeletePk)
@@ -1251,6 +1709,66 @@ namespace exodbctest
 	}
 
 
+	TEST_F(TableTest, DeleteWhereTemplate)
+	{
+		string tableName = GetTableName(TableId::INTEGERTYPES_TMP);
+		string idColName = GetIdColumnName(TableId::INTEGERTYPES_TMP);
+		ClearTmpTable(TableId::INTEGERTYPES_TMP);
+
+		{
+			// Insert some rows
+			Table iTable(m_pDb, TableAccessFlag::AF_INSERT, tableName);
+			iTable.Open();
+
+			auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+			auto pInt = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(2);
+			pId->SetValue(6100);
+			pInt->SetValue(7100);
+			iTable.Insert();
+
+			pId->SetValue(6101);
+			pInt->SetValue(7101);
+			iTable.Insert();
+
+			pId->SetValue(6102);
+			pInt->SetValue(7102);
+			iTable.Insert();
+
+			m_pDb->CommitTrans();
+		}
+		{
+			// And delete two of them using the same template
+			Table iTable(m_pDb, TableAccessFlag::AF_DELETE_WHERE, tableName);
+			iTable.Open();
+
+			LongColumnBufferPtr pIdParam = LongColumnBuffer::Create(idColName, SQL_INTEGER);
+			string whereTemplate = boost::str(boost::format(u8"%s = ?") % idColName);
+
+			pIdParam->SetValue(6101);
+			EXPECT_NO_THROW(iTable.Delete(whereTemplate, { pIdParam }));
+			pIdParam->SetValue(6102);
+			EXPECT_NO_THROW(iTable.Delete(whereTemplate, { pIdParam }));
+
+			// Nothing left to delete
+			EXPECT_THROW(iTable.Delete(whereTemplate, { pIdParam }, true), SqlResultException);
+			EXPECT_NO_THROW(iTable.Delete(whereTemplate, { pIdParam }, false));
+
+			m_pDb->CommitTrans();
+		}
+
+		// Read back values
+		Table iTable(m_pDb, TableAccessFlag::AF_READ_WITHOUT_PK, tableName);
+		iTable.Open();
+		auto pId = iTable.GetColumnBufferPtr<LongColumnBufferPtr>(0);
+
+		string sqlWhere = boost::str(boost::format(u8"%s >= 6100 ORDER by %s") % idColName %idColName);
+		iTable.Select(sqlWhere);
+		EXPECT_TRUE(iTable.SelectNext());
+		EXPECT_EQ(6100, *pId);
+		EXPECT_FALSE(iTable.SelectNext());
+	}
+
+
 	TEST_F(TableTest, GetColumnBufferIndex)
 	{
 		std::string intTypesTableName = GetTableName(TableId::INTEGERTYPES);